@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Definition of the Zigbee simulation
+ *
+ */
+#define ESP_ZB_SIM_DEVICE_MAX           8192    /*!< The maximum number of the virtual devices */
+#define ESP_ZB_SIM_ENDPOINT             1       /*!< The endpoint of every virtual device */
+
+/**
+ * @brief The configuration of the simulated network on the Linux target.
+ *
+ * @note The model is deterministic, the same seed and configuration replay the same events in the same order.
+ */
+typedef struct esp_zb_sim_config_s {
+    uint32_t seed;                  /*!< The seed of the model */
+    uint16_t device_count;          /*!< The number of the virtual devices joining after the network formation */
+    uint16_t join_interval_ms;      /*!< The time between two devices joining, 0 joins all of them at once */
+    uint32_t report_interval_ms;    /*!< The mean time between two attribute reports of a device, 0 disables the reports */
+    uint32_t aps_interval_ms;       /*!< The mean time between two APS data indications of a device, 0 disables them */
+    uint16_t latency_ms;            /*!< The mean time a device takes to answer a request */
+    uint8_t loss_percent;           /*!< The percentage of the frames lost on the air, in both directions */
+} esp_zb_sim_config_t;
+
+/**
+ * @brief The counters of the simulated network.
+ *
+ */
+typedef struct esp_zb_sim_stats_s {
+    uint32_t joined;                /*!< The number of the devices joined */
+    uint32_t reports;               /*!< The number of the attribute reports delivered */
+    uint32_t aps_indications;       /*!< The number of the APS data indications delivered */
+    uint32_t requests;              /*!< The number of the requests sent to the virtual devices */
+    uint32_t responses;             /*!< The number of the responses and confirms delivered */
+    uint32_t lost;                  /*!< The number of the frames lost on the air */
+    uint32_t pending;               /*!< The number of the events waiting in the model */
+} esp_zb_sim_stats_t;
+
+/**
+ * @brief Configure the simulated network.
+ *
+ * @note Takes effect on the next network formation, the default comes from menuconfig.
+ *
+ * @param[in] config The configuration of the simulation @ref esp_zb_sim_config_s
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_INVALID_ARG: the device count exceeds ESP_ZB_SIM_DEVICE_MAX or the loss exceeds 100
+ */
+esp_err_t esp_zb_sim_config(const esp_zb_sim_config_t *config);
+
+/**
+ * @brief Get the counters of the simulated network.
+ *
+ * @param[out] stats The counters of the simulation @ref esp_zb_sim_stats_s
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_INVALID_ARG: stats is NULL
+ */
+esp_err_t esp_zb_sim_stats_get(esp_zb_sim_stats_t *stats);
+
+/**
+ * @brief Get the time of the simulation.
+ *
+ * @note It is the FreeRTOS tick count extended to 64 bits, with CONFIG_ZB_SIM_VIRTUAL_TIME it runs ahead of the
+ *       wall clock, the components timing with esp_timer use it instead in that mode.
+ *
+ * @return The time since the start in microseconds
+ */
+int64_t esp_zb_sim_time_us(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -229,6 +229,26 @@ typedef struct esp_zb_zdo_signal_device_authorized_params_s {
     uint8_t authorization_status; /*!< Status of the authorization procedure which depends on authorization_type */
 } esp_zb_zdo_signal_device_authorized_params_t;
 
+/**
+ * @brief Network status indication signal parameters
+ *
+ * @note Stack passes this parameter to application upon receipt of the NLME-NWK-STATUS.indication primitive.
+ */
+typedef struct esp_zb_zdo_signal_nwk_status_indication_params_s {
+    uint8_t status;                 /*!< Error code associated with the failure */
+    uint16_t network_addr;          /*!< Network device address associated with the status information */
+    uint8_t unknown_command_id;     /*!< Unknown command ID, meaningful for the unknown command status only */
+} ESP_ZB_PACKED_STRUCT esp_zb_zdo_signal_nwk_status_indication_params_t;
+
+/**
+ * @brief PAN ID conflict detected signal parameters
+ *
+ * @note Stack passes this parameter to application when another network is found using the PAN ID of the device.
+ */
+typedef struct esp_zb_nwk_signal_panid_conflict_detected_params_s {
+    uint16_t panid;                 /*!< The PAN ID found in conflict */
+} ESP_ZB_PACKED_STRUCT esp_zb_nwk_signal_panid_conflict_detected_params_t;
+
 #ifdef CONFIG_ZB_GP_ENABLED
 /**
  * @brief ZGP approve commissioning parameters
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The clock of the simulation. With the virtual clock a task of the idle priority takes the next tick as soon as
+ * every other task is blocked, nothing can happen before that tick anyway, so the timeouts and the alarms expire
+ * as fast as the host runs them and a day of traffic plays in minutes. The soak reports follow the heap and the
+ * queues of the stack over such a run.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "esp_zigbee_core.h"
+#include "esp_zigbee_sim.h"
+#include "esp_zigbee_stub.h"
+
+static const char *TAG = "ESP_ZIGBEE_CLOCK";
+
+#define ESP_ZB_SIM_CLOCK_STACK      2048        /*!< The stack size of the clock task */
+
+_Static_assert(sizeof(TickType_t) == sizeof(uint32_t), "The clock extends a 32-bit tick count");
+
+typedef struct {
+    bool                    started;            /*!< The clock is started */
+    TickType_t              last;               /*!< The tick count of the last reading */
+    uint32_t                wraps;              /*!< The number of times the tick count wrapped */
+    int64_t                 wall_start_us;      /*!< The wall clock at the start */
+    size_t                  heap;               /*!< The heap in use at the previous report */
+} esp_zb_sim_clock_t;
+
+static esp_zb_sim_clock_t s_clock;
+
+int64_t esp_zb_sim_time_us(void)
+{
+    uint64_t ticks = 0;
+
+    vTaskSuspendAll();
+    TickType_t now = xTaskGetTickCount();
+    if (now < s_clock.last) {
+        s_clock.wraps ++;
+    }
+    s_clock.last = now;
+    ticks = ((uint64_t)s_clock.wraps << 32) | now;
+    xTaskResumeAll();
+
+    return (int64_t)(ticks * 1000000 / configTICK_RATE_HZ);
+}
+
+static int64_t esp_zb_sim_wall_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static size_t esp_zb_sim_heap_used(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+    return (size_t)mallinfo().uordblks;
+#elif defined(__APPLE__)
+    return mstats().bytes_used;
+#else
+    return 0;
+#endif
+}
+
+#if CONFIG_ZB_SIM_VIRTUAL_TIME
+static void esp_zb_sim_clock_task(void *arg)
+{
+    while (true) {
+        /* Only the idle task shares this priority, running here means every other task waits for a tick */
+        xTaskCatchUpTicks(1);
+        esp_zb_sim_time_us();
+        taskYIELD();
+    }
+}
+#endif
+
+static void esp_zb_sim_soak_report(uint8_t param)
+{
+    esp_zb_sim_stats_t stats = { 0 };
+    int64_t now_us = esp_zb_sim_time_us();
+    int64_t wall_us = esp_zb_sim_wall_us() - s_clock.wall_start_us;
+    uint32_t secs = (uint32_t)(now_us / 1000000);
+    size_t heap = esp_zb_sim_heap_used();
+    uint32_t end_s = CONFIG_ZB_SIM_SOAK_DURATION_S;
+    uint32_t next_s = CONFIG_ZB_SIM_SOAK_REPORT_S;
+
+    esp_zb_sim_stats_get(&stats);
+    ESP_LOGI(TAG, "%02" PRIu32 ":%02" PRIu32 ":%02" PRIu32 " x%.1f: heap %zu (%+" PRId64 "), alarms %" PRIu32 ", events %" PRIu32
+             ", tasks %" PRIu32 ", joined %" PRIu32 ", reports %" PRIu32 ", aps %" PRIu32 ", requests %" PRIu32
+             ", responses %" PRIu32 ", lost %" PRIu32,
+             secs / 3600, secs / 60 % 60, secs % 60, wall_us ? (double)now_us / wall_us : 0.0, heap,
+             (int64_t)heap - (int64_t)s_clock.heap, esp_zb_stub_alarm_pending(), stats.pending,
+             (uint32_t)uxTaskGetNumberOfTasks(), stats.joined, stats.reports, stats.aps_indications, stats.requests,
+             stats.responses, stats.lost);
+    s_clock.heap = heap;
+
+    if (end_s && secs >= end_s) {
+        ESP_LOGI(TAG, "Soak of %" PRIu32 " s done in %.1f s", end_s, wall_us / 1e6);
+        exit(EXIT_SUCCESS);
+    }
+
+    if (end_s && (!next_s || secs + next_s > end_s)) {
+        next_s = end_s - secs;
+    }
+    esp_zb_scheduler_alarm(esp_zb_sim_soak_report, 0, next_s * 1000);
+}
+
+void esp_zb_sim_clock_start(void)
+{
+    if (s_clock.started) {
+        return;
+    }
+    s_clock.started = true;
+    s_clock.wall_start_us = esp_zb_sim_wall_us();
+    s_clock.heap = esp_zb_sim_heap_used();
+
+#if CONFIG_ZB_SIM_VIRTUAL_TIME
+    if (xTaskCreate(esp_zb_sim_clock_task, "zb_clock", ESP_ZB_SIM_CLOCK_STACK, NULL, tskIDLE_PRIORITY, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Create the clock task error, the clock runs in real time");
+    } else {
+        ESP_LOGI(TAG, "Virtual clock, seed %" PRIu32, (uint32_t)CONFIG_ZB_SIM_SEED);
+    }
+#endif
+
+    if (CONFIG_ZB_SIM_SOAK_REPORT_S || CONFIG_ZB_SIM_SOAK_DURATION_S) {
+        uint32_t first_s = CONFIG_ZB_SIM_SOAK_REPORT_S ? CONFIG_ZB_SIM_SOAK_REPORT_S : CONFIG_ZB_SIM_SOAK_DURATION_S;
+
+        if (CONFIG_ZB_SIM_SOAK_DURATION_S && first_s > CONFIG_ZB_SIM_SOAK_DURATION_S) {
+            first_s = CONFIG_ZB_SIM_SOAK_DURATION_S;
+        }
+        esp_zb_scheduler_alarm(esp_zb_sim_soak_report, 0, first_s * 1000);
+    }
+}
@@ -0,0 +1,1034 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The simulated network behind the Zigbee stack stub. The virtual devices join once the network is formed,
+ * report their attributes, send APS data and answer the requests, all driven by a seeded pseudo random
+ * generator from the main loop, so the same seed gives the same sequence of events.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_log.h"
+
+#include "esp_zigbee_core.h"
+#include "esp_zigbee_sim.h"
+#include "esp_zigbee_stub.h"
+
+static const char *TAG = "ESP_ZIGBEE_SIM";
+
+#define ESP_ZB_SIM_EVENT_BURST      64          /*!< The number of events run in a row before the alarms get a turn */
+#define ESP_ZB_SIM_ATTR_MAX         8           /*!< The number of attributes answered in one response */
+#define ESP_ZB_SIM_IEEE_TAG         0x5a        /*!< Marks the long address of a virtual device */
+#define ESP_ZB_SIM_APS_CLUSTER      0xfc00      /*!< The cluster of the APS data sent by the devices */
+#define ESP_ZB_SIM_APS_LEN          8           /*!< The length of the APS data sent by the devices */
+#define ESP_ZB_SIM_MAC_NO_ACK       0xe9        /*!< The confirm status of a lost APS frame */
+#define ESP_ZB_SIM_ZDO_TIMEOUT_MS   3000        /*!< The time after which a ZDO request without an answer completes with a timeout */
+#define ESP_ZB_SIM_MANUF_CODE       0x131b      /*!< The manufacturer code in the node descriptor of the devices */
+
+#define ESP_ZB_SIM_CMD_READ_ATTR_RESP       0x01    /*!< The ZCL general command ID of the read attributes response */
+#define ESP_ZB_SIM_CMD_WRITE_ATTR_RESP      0x04    /*!< The ZCL general command ID of the write attributes response */
+#define ESP_ZB_SIM_CMD_CONFIG_REPORT_RESP   0x07    /*!< The ZCL general command ID of the configure reporting response */
+#define ESP_ZB_SIM_CMD_DEFAULT_RESP         0x0b    /*!< The ZCL general command ID of the default response */
+
+typedef enum {
+    ESP_ZB_SIM_EVENT_JOIN,                      /*!< The device joins and announces itself */
+    ESP_ZB_SIM_EVENT_REPORT,                    /*!< The device reports an attribute */
+    ESP_ZB_SIM_EVENT_APS,                       /*!< The device sends APS data */
+    ESP_ZB_SIM_EVENT_RESPONSE,                  /*!< The response to a request reaches the stack */
+} esp_zb_sim_event_type_t;
+
+typedef struct {
+    TickType_t              time;               /*!< The tick count the event happens at */
+    uint32_t                seq;                /*!< Orders the events of the same tick by their creation */
+    uint8_t                 type;               /*!< The event type, refer to esp_zb_sim_event_type_t */
+    uint16_t                dev;                /*!< The index of the device */
+    void                    *data;              /*!< The pending response of a response event */
+} esp_zb_sim_event_t;
+
+typedef struct {
+    uint16_t                short_addr;         /*!< The short address of the device */
+    bool                    joined;             /*!< The device is in the network */
+    uint8_t                 on_off;             /*!< The OnOff attribute */
+    uint8_t                 level;              /*!< The CurrentLevel attribute */
+    int16_t                 temperature;        /*!< The MeasuredValue attribute of the temperature measurement */
+} esp_zb_sim_device_t;
+
+typedef struct {
+    uint16_t                cluster_id;         /*!< The cluster of the attribute */
+    uint16_t                attr_id;            /*!< The attribute identifier */
+    uint8_t                 type;               /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+    uint8_t                 size;               /*!< The value size */
+    uint8_t                 offset;             /*!< The offset of the value in esp_zb_sim_device_t */
+} esp_zb_sim_attr_desc_t;
+
+typedef struct {
+    uint16_t                id;                 /*!< The attribute identifier */
+    uint8_t                 status;             /*!< The status of the attribute, refer to esp_zb_zcl_status_t */
+    uint8_t                 type;               /*!< The attribute type */
+    uint8_t                 size;               /*!< The value size */
+    uint8_t                 value[4];           /*!< The attribute value */
+} esp_zb_sim_resp_attr_t;
+
+typedef enum {
+    ESP_ZB_SIM_RESP_ZCL,                        /*!< A ZCL response to the action handler */
+    ESP_ZB_SIM_RESP_APS,                        /*!< An APS data confirm */
+    ESP_ZB_SIM_RESP_ZDO,                        /*!< A ZDO response to the callback of the request */
+} esp_zb_sim_resp_type_t;
+
+typedef struct {
+    uint8_t                 type;               /*!< The response type, refer to esp_zb_sim_resp_type_t */
+    esp_zb_core_action_callback_id_t callback_id; /*!< The ZCL response type, refer to esp_zb_core_action_callback_id_t */
+    uint8_t                 command_id;         /*!< The ZCL command ID of the response */
+    bool                    is_common;          /*!< The ZCL response is a general command */
+    uint8_t                 status;             /*!< The status of a default, group or ZDO response */
+    uint8_t                 resp_to_cmd;        /*!< The command answered by a default response */
+    uint16_t                group_id;           /*!< The group of a group response */
+    uint8_t                 zdo;                /*!< The ZDO request, refer to esp_zb_sim_zdo_t */
+    uint16_t                addr;               /*!< The address of interest of the ZDO request */
+    void                    *user_cb;           /*!< The callback of the ZDO request */
+    void                    *user_ctx;          /*!< The context of the ZDO request callback */
+    uint8_t                 tsn;                /*!< The transaction sequence number of the request */
+    uint16_t                cluster_id;         /*!< The cluster of the request */
+    uint8_t                 src_endpoint;       /*!< The endpoint of the requester */
+    uint8_t                 dst_endpoint;       /*!< The endpoint of the device */
+    esp_zb_apsde_data_confirm_t confirm;        /*!< The APS confirm, the ASDU follows the attributes */
+    uint8_t                 count;              /*!< The number of attributes */
+    esp_zb_sim_resp_attr_t  attr[];             /*!< The attributes of the response */
+} esp_zb_sim_resp_t;
+
+typedef struct {
+    esp_zb_sim_config_t     config;             /*!< The configuration of the model */
+    uint64_t                rand;               /*!< The state of the pseudo random generator */
+    uint32_t                seq;                /*!< The sequence number of the next event */
+    esp_zb_sim_device_t     *device;            /*!< The virtual devices */
+    uint16_t                *short_to_dev;      /*!< The device index plus one of every short address */
+    esp_zb_sim_event_t      *heap;              /*!< The pending events, a binary heap ordered by time */
+    uint32_t                heap_len;           /*!< The number of the pending events */
+    uint32_t                heap_size;          /*!< The capacity of the heap */
+    esp_zb_sim_stats_t      stats;              /*!< The counters of the simulation */
+} esp_zb_sim_t;
+
+/* The server clusters on the endpoint of every device, the simple descriptor and the match descriptor answer with them */
+static const uint16_t s_sim_cluster[] = {
+    ESP_ZB_ZCL_CLUSTER_ID_BASIC,
+    ESP_ZB_ZCL_CLUSTER_ID_GROUPS,
+    ESP_ZB_ZCL_CLUSTER_ID_ON_OFF,
+    ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+    ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT,
+};
+
+static const esp_zb_sim_attr_desc_t s_sim_attr[] = {
+    { ESP_ZB_ZCL_CLUSTER_ID_ON_OFF, ESP_ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID, ESP_ZB_ZCL_ATTR_TYPE_BOOL, sizeof(uint8_t), offsetof(esp_zb_sim_device_t, on_off) },
+    { ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL, ESP_ZB_ZCL_ATTR_LEVEL_CONTROL_CURRENT_LEVEL_ID, ESP_ZB_ZCL_ATTR_TYPE_U8, sizeof(uint8_t), offsetof(esp_zb_sim_device_t, level) },
+    { ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT, ESP_ZB_ZCL_ATTR_TEMP_MEASUREMENT_VALUE_ID, ESP_ZB_ZCL_ATTR_TYPE_S16, sizeof(int16_t), offsetof(esp_zb_sim_device_t, temperature) },
+};
+
+static esp_zb_sim_t s_sim = {
+    .config = {
+        .seed = CONFIG_ZB_SIM_SEED,
+        .device_count = CONFIG_ZB_SIM_DEVICE_COUNT,
+        .join_interval_ms = CONFIG_ZB_SIM_JOIN_INTERVAL_MS,
+        .report_interval_ms = CONFIG_ZB_SIM_REPORT_INTERVAL_MS,
+        .aps_interval_ms = CONFIG_ZB_SIM_APS_INTERVAL_MS,
+        .latency_ms = CONFIG_ZB_SIM_LATENCY_MS,
+        .loss_percent = CONFIG_ZB_SIM_LOSS_PERCENT,
+    },
+};
+
+/* splitmix64, every draw depends on the seed and the number of draws before it only */
+static uint32_t esp_zb_sim_rand(void)
+{
+    uint64_t z = (s_sim.rand += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+static bool esp_zb_sim_lost(void)
+{
+    bool lost = (esp_zb_sim_rand() % 100) < s_sim.config.loss_percent;
+
+    s_sim.stats.lost += lost ? 1 : 0;
+
+    return lost;
+}
+
+/* Exponentially distributed, the events of a device form a Poisson process of the configured mean */
+static TickType_t esp_zb_sim_interval(uint32_t mean_ms)
+{
+    double u = (esp_zb_sim_rand() + 1.0) / 4294967296.0;
+
+    return pdMS_TO_TICKS((uint32_t)(-log(u) * mean_ms)) + 1;
+}
+
+static TickType_t esp_zb_sim_latency(void)
+{
+    uint32_t latency = s_sim.config.latency_ms;
+
+    return pdMS_TO_TICKS(latency / 2 + (latency ? esp_zb_sim_rand() % (latency + 1) : 0));
+}
+
+static bool esp_zb_sim_event_before(const esp_zb_sim_event_t *a, const esp_zb_sim_event_t *b)
+{
+    int32_t diff = (int32_t)(a->time - b->time);
+
+    return diff < 0 || (diff == 0 && (int32_t)(a->seq - b->seq) < 0);
+}
+
+static esp_err_t esp_zb_sim_event_push(TickType_t time, uint8_t type, uint16_t dev, void *data)
+{
+    uint32_t i = s_sim.heap_len;
+
+    if (s_sim.heap_len == s_sim.heap_size) {
+        uint32_t size = s_sim.heap_size ? s_sim.heap_size * 2 : 256;
+        esp_zb_sim_event_t *heap = realloc(s_sim.heap, size * sizeof(esp_zb_sim_event_t));
+        ESP_RETURN_ON_FALSE(heap, ESP_ERR_NO_MEM, TAG, "No memory for %" PRIu32 " events", size);
+        s_sim.heap = heap;
+        s_sim.heap_size = size;
+    }
+
+    esp_zb_sim_event_t event = {
+        .time = time,
+        .seq = s_sim.seq ++,
+        .type = type,
+        .dev = dev,
+        .data = data,
+    };
+
+    while (i > 0 && esp_zb_sim_event_before(&event, &s_sim.heap[(i - 1) / 2])) {
+        s_sim.heap[i] = s_sim.heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    s_sim.heap[i] = event;
+    s_sim.heap_len ++;
+    esp_zb_stub_wake();
+
+    return ESP_OK;
+}
+
+static esp_zb_sim_event_t esp_zb_sim_event_pop(void)
+{
+    esp_zb_sim_event_t top = s_sim.heap[0];
+    esp_zb_sim_event_t last = s_sim.heap[-- s_sim.heap_len];
+    uint32_t i = 0;
+
+    while (2 * i + 1 < s_sim.heap_len) {
+        uint32_t child = 2 * i + 1;
+        if (child + 1 < s_sim.heap_len && esp_zb_sim_event_before(&s_sim.heap[child + 1], &s_sim.heap[child])) {
+            child ++;
+        }
+        if (!esp_zb_sim_event_before(&s_sim.heap[child], &last)) {
+            break;
+        }
+        s_sim.heap[i] = s_sim.heap[child];
+        i = child;
+    }
+    s_sim.heap[i] = last;
+
+    return top;
+}
+
+static void esp_zb_sim_ieee_addr(uint16_t dev, esp_zb_ieee_addr_t ieee_addr)
+{
+    const uint8_t oui[] = {0x00, 0x4b, 0x12, 0x00};
+
+    ieee_addr[0] = dev & 0xff;
+    ieee_addr[1] = dev >> 8;
+    ieee_addr[2] = ESP_ZB_SIM_IEEE_TAG;
+    ieee_addr[3] = 0xff;
+    memcpy(&ieee_addr[4], oui, sizeof(oui));
+}
+
+static esp_zb_sim_device_t *esp_zb_sim_device_get(uint16_t short_addr)
+{
+    uint16_t index = s_sim.short_to_dev ? s_sim.short_to_dev[short_addr] : 0;
+
+    return (index && s_sim.device[index - 1].joined) ? &s_sim.device[index - 1] : NULL;
+}
+
+static const esp_zb_sim_attr_desc_t *esp_zb_sim_attr_find(uint16_t cluster_id, uint16_t attr_id)
+{
+    for (int i = 0; i < sizeof(s_sim_attr) / sizeof(s_sim_attr[0]); i ++) {
+        if (s_sim_attr[i].cluster_id == cluster_id && s_sim_attr[i].attr_id == attr_id) {
+            return &s_sim_attr[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void esp_zb_sim_join(TickType_t time, uint16_t dev)
+{
+    esp_zb_sim_device_t *device = &s_sim.device[dev];
+    esp_zb_zdo_signal_device_annce_params_t params = {
+        .device_short_addr = device->short_addr,
+        .capability = 0x8e,
+    };
+
+    device->joined = true;
+    s_sim.stats.joined ++;
+    esp_zb_sim_ieee_addr(dev, params.ieee_addr);
+    esp_zb_stub_signal_dispatch(ESP_ZB_ZDO_SIGNAL_DEVICE_ANNCE, ESP_OK, &params, sizeof(params));
+
+    if (s_sim.config.report_interval_ms) {
+        esp_zb_sim_event_push(time + esp_zb_sim_interval(s_sim.config.report_interval_ms), ESP_ZB_SIM_EVENT_REPORT, dev, NULL);
+    }
+
+    if (s_sim.config.aps_interval_ms) {
+        esp_zb_sim_event_push(time + esp_zb_sim_interval(s_sim.config.aps_interval_ms), ESP_ZB_SIM_EVENT_APS, dev, NULL);
+    }
+}
+
+/* Mostly temperature drifting by up to half a degree, now and then a switch toggled by hand */
+static void esp_zb_sim_report(TickType_t time, uint16_t dev)
+{
+    esp_zb_sim_device_t *device = &s_sim.device[dev];
+    const esp_zb_sim_attr_desc_t *desc = &s_sim_attr[2];
+    uint32_t draw = esp_zb_sim_rand();
+
+    if (draw % 5 == 0) {
+        device->on_off = !device->on_off;
+        desc = &s_sim_attr[0];
+    } else {
+        device->temperature += (int16_t)(draw % 101) - 50;
+    }
+
+    esp_zb_sim_event_push(time + esp_zb_sim_interval(s_sim.config.report_interval_ms), ESP_ZB_SIM_EVENT_REPORT, dev, NULL);
+    if (esp_zb_sim_lost()) {
+        return;
+    }
+
+    esp_zb_zcl_report_attr_message_t message = {
+        .status = ESP_ZB_ZCL_STATUS_SUCCESS,
+        .src_address = {
+            .addr_type = ESP_ZB_ZCL_ADDR_TYPE_SHORT,
+            .u.short_addr = device->short_addr,
+        },
+        .src_endpoint = ESP_ZB_SIM_ENDPOINT,
+        .dst_endpoint = ESP_ZB_SIM_ENDPOINT,
+        .cluster = desc->cluster_id,
+        .attribute = {
+            .id = desc->attr_id,
+            .data = {
+                .type = desc->type,
+                .size = desc->size,
+                .value = (uint8_t *)device + desc->offset,
+            },
+        },
+    };
+
+    s_sim.stats.reports ++;
+    esp_zb_stub_action(ESP_ZB_CORE_REPORT_ATTR_CB_ID, &message);
+}
+
+static void esp_zb_sim_aps(TickType_t time, uint16_t dev)
+{
+    uint8_t asdu[ESP_ZB_SIM_APS_LEN];
+
+    for (int i = 0; i < sizeof(asdu); i ++) {
+        asdu[i] = esp_zb_sim_rand();
+    }
+
+    esp_zb_sim_event_push(time + esp_zb_sim_interval(s_sim.config.aps_interval_ms), ESP_ZB_SIM_EVENT_APS, dev, NULL);
+    if (esp_zb_sim_lost()) {
+        return;
+    }
+
+    esp_zb_apsde_data_ind_t ind = {
+        .status = 0,
+        .dst_addr_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+        .dst_short_addr = esp_zb_get_short_address(),
+        .dst_endpoint = ESP_ZB_SIM_ENDPOINT,
+        .src_short_addr = s_sim.device[dev].short_addr,
+        .src_endpoint = ESP_ZB_SIM_ENDPOINT,
+        .profile_id = ESP_ZB_AF_HA_PROFILE_ID,
+        .cluster_id = ESP_ZB_SIM_APS_CLUSTER,
+        .asdu_length = sizeof(asdu),
+        .asdu = asdu,
+        .lqi = 200 + dev % 56,
+    };
+
+    s_sim.stats.aps_indications ++;
+    esp_zb_stub_aps_indication(ind);
+}
+
+static bool esp_zb_sim_cluster_find(uint16_t cluster_id)
+{
+    for (int i = 0; i < sizeof(s_sim_cluster) / sizeof(s_sim_cluster[0]); i ++) {
+        if (s_sim_cluster[i] == cluster_id) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void esp_zb_sim_zdo_respond(esp_zb_sim_resp_t *resp)
+{
+    bool success = (resp->status == ESP_ZB_ZDP_STATUS_SUCCESS);
+
+    if (!resp->user_cb) {
+        return;
+    }
+
+    switch (resp->zdo) {
+        case ESP_ZB_SIM_ZDO_ACTIVE_EP: {
+            uint8_t endpoint = ESP_ZB_SIM_ENDPOINT;
+            ((esp_zb_zdo_active_ep_callback_t)resp->user_cb)(resp->status, success ? 1 : 0, success ? &endpoint : NULL, resp->user_ctx);
+            break;
+        }
+        case ESP_ZB_SIM_ZDO_SIMPLE_DESC: {
+            uint8_t buf[sizeof(esp_zb_af_simple_desc_1_1_t) + sizeof(s_sim_cluster)] = {0};
+            esp_zb_af_simple_desc_1_1_t *simple_desc = (esp_zb_af_simple_desc_1_1_t *)buf;
+
+            simple_desc->endpoint = ESP_ZB_SIM_ENDPOINT;
+            simple_desc->app_profile_id = ESP_ZB_AF_HA_PROFILE_ID;
+            simple_desc->app_device_id = ESP_ZB_HA_DIMMABLE_LIGHT_DEVICE_ID;
+            simple_desc->app_input_cluster_count = sizeof(s_sim_cluster) / sizeof(s_sim_cluster[0]);
+            memcpy(simple_desc->app_cluster_list, s_sim_cluster, sizeof(s_sim_cluster));
+            ((esp_zb_zdo_simple_desc_callback_t)resp->user_cb)(resp->status, success ? simple_desc : NULL, resp->user_ctx);
+            break;
+        }
+        case ESP_ZB_SIM_ZDO_NODE_DESC: {
+            /* An end device, receiver on when idle, allocated address */
+            esp_zb_af_node_desc_t node_desc = {
+                .node_desc_flags = ESP_ZB_DEVICE_TYPE_ED,
+                .mac_capability_flags = 0x8c,
+                .manufacturer_code = ESP_ZB_SIM_MANUF_CODE,
+                .max_buf_size = 80,
+                .max_incoming_transfer_size = 160,
+                .max_outgoing_transfer_size = 160,
+            };
+            ((esp_zb_zdo_node_desc_callback_t)resp->user_cb)(resp->status, resp->addr, success ? &node_desc : NULL, resp->user_ctx);
+            break;
+        }
+        case ESP_ZB_SIM_ZDO_BIND:
+            ((esp_zb_zdo_bind_callback_t)resp->user_cb)(resp->status, resp->user_ctx);
+            break;
+        case ESP_ZB_SIM_ZDO_MATCH_DESC:
+            ((esp_zb_zdo_match_desc_callback_t)resp->user_cb)(resp->status, resp->addr, success ? ESP_ZB_SIM_ENDPOINT : 0, resp->user_ctx);
+            break;
+        default:
+            break;
+    }
+}
+
+static void esp_zb_sim_respond(uint16_t dev, esp_zb_sim_resp_t *resp)
+{
+    s_sim.stats.responses ++;
+
+    if (resp->type == ESP_ZB_SIM_RESP_APS) {
+        esp_zb_stub_aps_confirm(resp->confirm);
+        return;
+    }
+
+    if (resp->type == ESP_ZB_SIM_RESP_ZDO) {
+        esp_zb_sim_zdo_respond(resp);
+        return;
+    }
+
+    esp_zb_zcl_cmd_info_t info = {
+        .status = ESP_ZB_ZCL_STATUS_SUCCESS,
+        .header = {
+            .tsn = resp->tsn,
+            .rssi = -40 - dev % 40,
+        },
+        .src_address = {
+            .addr_type = ESP_ZB_ZCL_ADDR_TYPE_SHORT,
+            .u.short_addr = s_sim.device[dev].short_addr,
+        },
+        .dst_address = esp_zb_get_short_address(),
+        .src_endpoint = resp->dst_endpoint,
+        .dst_endpoint = resp->src_endpoint,
+        .cluster = resp->cluster_id,
+        .profile = ESP_ZB_AF_HA_PROFILE_ID,
+        .command = {
+            .id = resp->command_id,
+            .direction = 1,
+            .is_common = resp->is_common,
+        },
+    };
+
+    switch (resp->callback_id) {
+        case ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID: {
+            esp_zb_zcl_read_attr_resp_variable_t variables[ESP_ZB_SIM_ATTR_MAX];
+            esp_zb_zcl_cmd_read_attr_resp_message_t message = {
+                .info = info,
+                .variables = resp->count ? variables : NULL,
+            };
+
+            for (int i = 0; i < resp->count; i ++) {
+                variables[i] = (esp_zb_zcl_read_attr_resp_variable_t) {
+                    .status = resp->attr[i].status,
+                    .attribute = {
+                        .id = resp->attr[i].id,
+                        .data = {
+                            .type = resp->attr[i].type,
+                            .size = resp->attr[i].size,
+                            .value = resp->attr[i].size ? resp->attr[i].value : NULL,
+                        },
+                    },
+                    .next = (i + 1 < resp->count) ? &variables[i + 1] : NULL,
+                };
+            }
+            esp_zb_stub_action(ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID, &message);
+            break;
+        }
+        case ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID: {
+            esp_zb_zcl_write_attr_resp_variable_t variables[ESP_ZB_SIM_ATTR_MAX];
+            esp_zb_zcl_cmd_write_attr_resp_message_t message = {
+                .info = info,
+                .variables = resp->count ? variables : NULL,
+            };
+
+            for (int i = 0; i < resp->count; i ++) {
+                variables[i] = (esp_zb_zcl_write_attr_resp_variable_t) {
+                    .status = resp->attr[i].status,
+                    .attribute_id = resp->attr[i].id,
+                    .next = (i + 1 < resp->count) ? &variables[i + 1] : NULL,
+                };
+            }
+            esp_zb_stub_action(ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID, &message);
+            break;
+        }
+        case ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID: {
+            esp_zb_zcl_config_report_resp_variable_t variables[ESP_ZB_SIM_ATTR_MAX];
+            esp_zb_zcl_cmd_config_report_resp_message_t message = {
+                .info = info,
+                .variables = resp->count ? variables : NULL,
+            };
+
+            for (int i = 0; i < resp->count; i ++) {
+                variables[i] = (esp_zb_zcl_config_report_resp_variable_t) {
+                    .status = resp->attr[i].status,
+                    .direction = ESP_ZB_ZCL_REPORT_DIRECTION_SEND,
+                    .attribute_id = resp->attr[i].id,
+                    .next = (i + 1 < resp->count) ? &variables[i + 1] : NULL,
+                };
+            }
+            esp_zb_stub_action(ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID, &message);
+            break;
+        }
+        case ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID: {
+            esp_zb_zcl_cmd_default_resp_message_t message = {
+                .info = info,
+                .resp_to_cmd = resp->resp_to_cmd,
+                .status_code = resp->status,
+            };
+
+            esp_zb_stub_action(ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID, &message);
+            break;
+        }
+        case ESP_ZB_CORE_CMD_OPERATE_GROUP_RESP_CB_ID: {
+            esp_zb_zcl_groups_operate_group_resp_message_t message = {
+                .info = info,
+                .group_id = resp->group_id,
+            };
+
+            message.info.status = resp->status;
+            esp_zb_stub_action(ESP_ZB_CORE_CMD_OPERATE_GROUP_RESP_CB_ID, &message);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/* Returns the device a unicast request is for, or NULL when the request never gets an answer */
+static esp_zb_sim_device_t *esp_zb_sim_request(uint8_t address_mode, uint16_t short_addr)
+{
+    esp_zb_sim_device_t *device = NULL;
+
+    if (address_mode != ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT) {
+        return NULL;
+    }
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    device = esp_zb_sim_device_get(short_addr);
+    if (device) {
+        s_sim.stats.requests ++;
+        device = esp_zb_sim_lost() ? NULL : device;
+    }
+    esp_zb_lock_release();
+
+    return device;
+}
+
+/* A ZDO request without a device to answer completes with a timeout, the ZCL requests are not answered at all */
+static void esp_zb_sim_response_push(esp_zb_sim_device_t *device, esp_zb_sim_resp_t *resp)
+{
+    esp_zb_lock_acquire(portMAX_DELAY);
+    TickType_t delay = device ? esp_zb_sim_latency() : pdMS_TO_TICKS(ESP_ZB_SIM_ZDO_TIMEOUT_MS);
+    if (esp_zb_sim_event_push(xTaskGetTickCount() + delay, ESP_ZB_SIM_EVENT_RESPONSE, device ? device - s_sim.device : 0, resp) != ESP_OK) {
+        free(resp);
+    }
+    esp_zb_lock_release();
+}
+
+void esp_zb_sim_read_attr(const esp_zb_zcl_read_attr_cmd_t *cmd_req, uint8_t tsn)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(cmd_req->address_mode, cmd_req->zcl_basic_cmd.dst_addr_u.addr_short);
+    uint8_t count = (cmd_req->attr_number < ESP_ZB_SIM_ATTR_MAX) ? cmd_req->attr_number : ESP_ZB_SIM_ATTR_MAX;
+    esp_zb_sim_resp_t *resp = device ? calloc(1, sizeof(esp_zb_sim_resp_t) + count * sizeof(esp_zb_sim_resp_attr_t)) : NULL;
+
+    if (!resp) {
+        return;
+    }
+
+    resp->callback_id = ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID;
+    resp->command_id = ESP_ZB_SIM_CMD_READ_ATTR_RESP;
+    resp->is_common = true;
+    resp->tsn = tsn;
+    resp->cluster_id = cmd_req->clusterID;
+    resp->src_endpoint = cmd_req->zcl_basic_cmd.src_endpoint;
+    resp->dst_endpoint = cmd_req->zcl_basic_cmd.dst_endpoint;
+    resp->count = count;
+    for (int i = 0; i < count; i ++) {
+        const esp_zb_sim_attr_desc_t *desc = esp_zb_sim_attr_find(cmd_req->clusterID, cmd_req->attr_field[i]);
+        resp->attr[i].id = cmd_req->attr_field[i];
+        resp->attr[i].status = desc ? ESP_ZB_ZCL_STATUS_SUCCESS : ESP_ZB_ZCL_STATUS_UNSUP_ATTRIB;
+        if (desc) {
+            resp->attr[i].type = desc->type;
+            resp->attr[i].size = desc->size;
+            memcpy(resp->attr[i].value, (uint8_t *)device + desc->offset, desc->size);
+        }
+    }
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+void esp_zb_sim_write_attr(const esp_zb_zcl_write_attr_cmd_t *cmd_req, uint8_t tsn)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(cmd_req->address_mode, cmd_req->zcl_basic_cmd.dst_addr_u.addr_short);
+    uint8_t count = (cmd_req->attr_number < ESP_ZB_SIM_ATTR_MAX) ? cmd_req->attr_number : ESP_ZB_SIM_ATTR_MAX;
+    esp_zb_sim_resp_t *resp = device ? calloc(1, sizeof(esp_zb_sim_resp_t) + count * sizeof(esp_zb_sim_resp_attr_t)) : NULL;
+
+    if (!resp) {
+        return;
+    }
+
+    resp->callback_id = ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID;
+    resp->command_id = ESP_ZB_SIM_CMD_WRITE_ATTR_RESP;
+    resp->is_common = true;
+    resp->tsn = tsn;
+    resp->cluster_id = cmd_req->clusterID;
+    resp->src_endpoint = cmd_req->zcl_basic_cmd.src_endpoint;
+    resp->dst_endpoint = cmd_req->zcl_basic_cmd.dst_endpoint;
+    resp->count = count;
+    for (int i = 0; i < count; i ++) {
+        const esp_zb_zcl_attribute_t *attr = &cmd_req->attr_field[i];
+        const esp_zb_sim_attr_desc_t *desc = esp_zb_sim_attr_find(cmd_req->clusterID, attr->id);
+        resp->attr[i].id = attr->id;
+        if (!desc) {
+            resp->attr[i].status = ESP_ZB_ZCL_STATUS_UNSUP_ATTRIB;
+        } else if (attr->data.type != desc->type || !attr->data.value) {
+            resp->attr[i].status = ESP_ZB_ZCL_STATUS_INVALID_TYPE;
+        } else {
+            resp->attr[i].status = ESP_ZB_ZCL_STATUS_SUCCESS;
+            esp_zb_lock_acquire(portMAX_DELAY);
+            memcpy((uint8_t *)device + desc->offset, attr->data.value, desc->size);
+            esp_zb_lock_release();
+        }
+    }
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+void esp_zb_sim_config_report(const esp_zb_zcl_config_report_cmd_t *cmd_req, uint8_t tsn)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(cmd_req->address_mode, cmd_req->zcl_basic_cmd.dst_addr_u.addr_short);
+    esp_zb_sim_resp_t *resp = device ? calloc(1, sizeof(esp_zb_sim_resp_t) + ESP_ZB_SIM_ATTR_MAX * sizeof(esp_zb_sim_resp_attr_t)) : NULL;
+
+    if (!resp) {
+        return;
+    }
+
+    resp->callback_id = ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID;
+    resp->command_id = ESP_ZB_SIM_CMD_CONFIG_REPORT_RESP;
+    resp->is_common = true;
+    resp->tsn = tsn;
+    resp->cluster_id = cmd_req->clusterID;
+    resp->src_endpoint = cmd_req->zcl_basic_cmd.src_endpoint;
+    resp->dst_endpoint = cmd_req->zcl_basic_cmd.dst_endpoint;
+    /* The devices report the attributes they have, the response lists the records which failed only */
+    for (int i = 0; i < cmd_req->record_number && resp->count < ESP_ZB_SIM_ATTR_MAX; i ++) {
+        uint16_t attr_id = cmd_req->record_field[i].attributeID;
+        if (!esp_zb_sim_attr_find(cmd_req->clusterID, attr_id)) {
+            resp->attr[resp->count].id = attr_id;
+            resp->attr[resp->count].status = ESP_ZB_ZCL_STATUS_UNSUP_ATTRIB;
+            resp->count ++;
+        }
+    }
+    if (!resp->count) {
+        resp->attr[0].id = 0xffff;
+        resp->attr[0].status = ESP_ZB_ZCL_STATUS_SUCCESS;
+        resp->count = 1;
+    }
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+void esp_zb_sim_custom_cmd(const esp_zb_zcl_custom_cluster_cmd_t *cmd_req, uint8_t tsn)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(cmd_req->address_mode, cmd_req->zcl_basic_cmd.dst_addr_u.addr_short);
+    const uint8_t *value = cmd_req->data.value;
+    uint8_t status = ESP_ZB_ZCL_STATUS_SUCCESS;
+    esp_zb_sim_resp_t *resp = NULL;
+
+    if (!device) {
+        return;
+    }
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    if (cmd_req->cluster_id == ESP_ZB_ZCL_CLUSTER_ID_ON_OFF) {
+        switch (cmd_req->custom_cmd_id) {
+            case ESP_ZB_ZCL_CMD_ON_OFF_OFF_ID:
+                device->on_off = 0;
+                break;
+            case ESP_ZB_ZCL_CMD_ON_OFF_ON_ID:
+                device->on_off = 1;
+                break;
+            case ESP_ZB_ZCL_CMD_ON_OFF_TOGGLE_ID:
+                device->on_off = !device->on_off;
+                break;
+            default:
+                status = ESP_ZB_ZCL_STATUS_UNSUP_CLUST_CMD;
+                break;
+        }
+    } else if (cmd_req->cluster_id == ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL) {
+        switch (cmd_req->custom_cmd_id) {
+            case ESP_ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL:
+            case ESP_ZB_ZCL_CMD_LEVEL_CONTROL_MOVE_TO_LEVEL_WITH_ON_OFF:
+                if (value) {
+                    device->level = value[0];
+                } else {
+                    status = ESP_ZB_ZCL_STATUS_INVALID_VALUE;
+                }
+                break;
+            default:
+                status = ESP_ZB_ZCL_STATUS_UNSUP_CLUST_CMD;
+                break;
+        }
+    } else {
+        status = esp_zb_sim_cluster_find(cmd_req->cluster_id) ? ESP_ZB_ZCL_STATUS_UNSUP_CLUST_CMD : ESP_ZB_ZCL_STATUS_UNSUP_CLUST;
+    }
+    esp_zb_lock_release();
+
+    /* A failure is answered even when the default response is disabled */
+    if (status == ESP_ZB_ZCL_STATUS_SUCCESS && cmd_req->dis_defalut_resp) {
+        return;
+    }
+
+    resp = calloc(1, sizeof(esp_zb_sim_resp_t));
+    if (!resp) {
+        return;
+    }
+
+    resp->callback_id = ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID;
+    resp->command_id = ESP_ZB_SIM_CMD_DEFAULT_RESP;
+    resp->is_common = true;
+    resp->status = status;
+    resp->resp_to_cmd = cmd_req->custom_cmd_id;
+    resp->tsn = tsn;
+    resp->cluster_id = cmd_req->cluster_id;
+    resp->src_endpoint = cmd_req->zcl_basic_cmd.src_endpoint;
+    resp->dst_endpoint = cmd_req->zcl_basic_cmd.dst_endpoint;
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+void esp_zb_sim_group(const esp_zb_zcl_groups_add_group_cmd_t *cmd_req, bool add, uint8_t tsn)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(cmd_req->address_mode, cmd_req->zcl_basic_cmd.dst_addr_u.addr_short);
+    esp_zb_sim_resp_t *resp = device ? calloc(1, sizeof(esp_zb_sim_resp_t)) : NULL;
+
+    if (!resp) {
+        return;
+    }
+
+    resp->callback_id = ESP_ZB_CORE_CMD_OPERATE_GROUP_RESP_CB_ID;
+    resp->command_id = add ? ESP_ZB_ZCL_CMD_GROUPS_ADD_GROUP : ESP_ZB_ZCL_CMD_GROUPS_REMOVE_GROUP;
+    resp->is_common = false;
+    resp->status = (cmd_req->group_id == 0 || cmd_req->group_id > 0xfff7) ? ESP_ZB_ZCL_STATUS_INVALID_VALUE : ESP_ZB_ZCL_STATUS_SUCCESS;
+    resp->group_id = cmd_req->group_id;
+    resp->tsn = tsn;
+    resp->cluster_id = ESP_ZB_ZCL_CLUSTER_ID_GROUPS;
+    resp->src_endpoint = cmd_req->zcl_basic_cmd.src_endpoint;
+    resp->dst_endpoint = cmd_req->zcl_basic_cmd.dst_endpoint;
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+void esp_zb_sim_zdo_request(esp_zb_sim_zdo_t zdo, uint16_t addr, uint8_t endpoint, void *user_cb, void *user_ctx)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_request(ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT, addr);
+    esp_zb_sim_resp_t *resp = user_cb ? calloc(1, sizeof(esp_zb_sim_resp_t)) : NULL;
+
+    if (!resp) {
+        return;
+    }
+
+    resp->type = ESP_ZB_SIM_RESP_ZDO;
+    resp->zdo = zdo;
+    resp->addr = addr;
+    resp->user_cb = user_cb;
+    resp->user_ctx = user_ctx;
+    if (!device) {
+        resp->status = ESP_ZB_ZDP_STATUS_TIMEOUT;
+    } else if (zdo == ESP_ZB_SIM_ZDO_SIMPLE_DESC && endpoint != ESP_ZB_SIM_ENDPOINT) {
+        resp->status = (endpoint == 0 || endpoint > 240) ? ESP_ZB_ZDP_STATUS_INVALID_EP : ESP_ZB_ZDP_STATUS_NOT_ACTIVE;
+    } else {
+        resp->status = ESP_ZB_ZDP_STATUS_SUCCESS;
+    }
+
+    esp_zb_sim_response_push(device, resp);
+}
+
+static bool esp_zb_sim_match(const esp_zb_zdo_match_desc_req_param_t *param)
+{
+    if (param->profile_id != ESP_ZB_AF_HA_PROFILE_ID || !param->cluster_list) {
+        return false;
+    }
+
+    /* The devices have no client clusters, only the input clusters can match */
+    for (int i = 0; i < param->num_in_clusters; i ++) {
+        if (esp_zb_sim_cluster_find(param->cluster_list[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+esp_err_t esp_zb_sim_match_desc(const esp_zb_zdo_match_desc_req_param_t *param, esp_zb_zdo_match_desc_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_device_t *device = NULL;
+    esp_zb_sim_resp_t *resp = calloc(1, sizeof(esp_zb_sim_resp_t));
+
+    ESP_RETURN_ON_FALSE(resp, ESP_ERR_NO_MEM, TAG, "No memory for the match descriptor response");
+
+    resp->type = ESP_ZB_SIM_RESP_ZDO;
+    resp->zdo = ESP_ZB_SIM_ZDO_MATCH_DESC;
+    resp->user_cb = user_cb;
+    resp->user_ctx = user_ctx;
+    resp->status = ESP_ZB_ZDP_STATUS_TIMEOUT;
+    if (param->dst_nwk_addr < 0xfff8) {
+        device = esp_zb_sim_request(ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT, param->dst_nwk_addr);
+        if (device) {
+            resp->status = esp_zb_sim_match(param) ? ESP_ZB_ZDP_STATUS_SUCCESS : ESP_ZB_ZDP_STATUS_NO_MATCH;
+        }
+    } else if (esp_zb_sim_match(param)) {
+        /* Every device matches alike, the callback is called once with the first one which answers */
+        esp_zb_lock_acquire(portMAX_DELAY);
+        for (uint16_t dev = 0; s_sim.device && dev < s_sim.config.device_count && !device; dev ++) {
+            if (s_sim.device[dev].joined && !esp_zb_sim_lost()) {
+                device = &s_sim.device[dev];
+                resp->status = ESP_ZB_ZDP_STATUS_SUCCESS;
+            }
+        }
+        esp_zb_lock_release();
+    }
+    resp->addr = device ? device->short_addr : param->dst_nwk_addr;
+
+    esp_zb_sim_response_push(device, resp);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_sim_aps_data_request(const esp_zb_apsde_data_req_t *req)
+{
+    esp_zb_sim_device_t *device = NULL;
+    esp_zb_sim_resp_t *resp = NULL;
+    bool lost = false;
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    if (req->dst_addr_mode == ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT) {
+        device = esp_zb_sim_device_get(req->dst_addr.addr_short);
+    }
+    if (device) {
+        s_sim.stats.requests ++;
+        lost = esp_zb_sim_lost();
+    }
+    esp_zb_lock_release();
+
+    /* Frames to unknown devices, groups or broadcasts are sent and confirmed without anyone to answer */
+    resp = calloc(1, sizeof(esp_zb_sim_resp_t) + req->asdu_length);
+    ESP_RETURN_ON_FALSE(resp, ESP_ERR_NO_MEM, TAG, "No memory for the APS confirm");
+
+    resp->type = ESP_ZB_SIM_RESP_APS;
+    resp->confirm.status = lost ? ESP_ZB_SIM_MAC_NO_ACK : 0;
+    resp->confirm.dst_addr_mode = req->dst_addr_mode;
+    resp->confirm.dst_addr = req->dst_addr;
+    resp->confirm.dst_endpoint = req->dst_endpoint;
+    resp->confirm.src_endpoint = req->src_endpoint;
+    resp->confirm.asdu_length = req->asdu_length;
+    resp->confirm.asdu = (uint8_t *)resp->attr;
+    if (req->asdu_length) {
+        memcpy(resp->confirm.asdu, req->asdu, req->asdu_length);
+    }
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    if (esp_zb_sim_event_push(xTaskGetTickCount() + esp_zb_sim_latency(), ESP_ZB_SIM_EVENT_RESPONSE, device ? device - s_sim.device : 0, resp) != ESP_OK) {
+        free(resp);
+        resp = NULL;
+    }
+    esp_zb_lock_release();
+
+    return resp ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+uint16_t esp_zb_sim_short_by_ieee(const esp_zb_ieee_addr_t ieee_addr)
+{
+    uint16_t dev = ieee_addr[0] | (ieee_addr[1] << 8);
+
+    if (ieee_addr[2] != ESP_ZB_SIM_IEEE_TAG || ieee_addr[3] != 0xff || dev >= s_sim.config.device_count
+        || !s_sim.device || !s_sim.device[dev].joined) {
+        return 0xffff;
+    }
+
+    return s_sim.device[dev].short_addr;
+}
+
+esp_err_t esp_zb_sim_ieee_by_short(uint16_t short_addr, esp_zb_ieee_addr_t ieee_addr)
+{
+    esp_zb_sim_device_t *device = esp_zb_sim_device_get(short_addr);
+
+    if (!device) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_zb_sim_ieee_addr(device - s_sim.device, ieee_addr);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_sim_neighbor_get(esp_zb_nwk_info_iterator_t *iterator, esp_zb_nwk_neighbor_info_t *nbr_info)
+{
+    while (s_sim.device && *iterator < s_sim.config.device_count) {
+        uint16_t dev = (*iterator) ++;
+        if (s_sim.device[dev].joined) {
+            memset(nbr_info, 0, sizeof(esp_zb_nwk_neighbor_info_t));
+            esp_zb_sim_ieee_addr(dev, nbr_info->ieee_addr);
+            nbr_info->short_addr = s_sim.device[dev].short_addr;
+            nbr_info->device_type = ESP_ZB_DEVICE_TYPE_ED;
+            nbr_info->depth = 1;
+            nbr_info->rx_on_when_idle = 1;
+            nbr_info->relationship = ESP_ZB_NWK_RELATIONSHIP_CHILD;
+            nbr_info->lqi = 200 + dev % 56;
+            nbr_info->rssi = -40 - dev % 40;
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+void esp_zb_sim_network_formed(void)
+{
+    uint16_t count = s_sim.config.device_count;
+    TickType_t now = xTaskGetTickCount();
+
+    free(s_sim.device);
+    s_sim.device = count ? calloc(count, sizeof(esp_zb_sim_device_t)) : NULL;
+    if (!s_sim.short_to_dev) {
+        s_sim.short_to_dev = calloc(UINT16_MAX + 1, sizeof(uint16_t));
+    }
+    if ((count && !s_sim.device) || !s_sim.short_to_dev) {
+        ESP_LOGE(TAG, "No memory for %d virtual devices", count);
+        return;
+    }
+
+    for (uint32_t i = 0; i < s_sim.heap_len; i ++) {
+        free(s_sim.heap[i].data);
+    }
+    s_sim.heap_len = 0;
+    s_sim.rand = s_sim.config.seed;
+    memset(s_sim.short_to_dev, 0, (UINT16_MAX + 1) * sizeof(uint16_t));
+    memset(&s_sim.stats, 0, sizeof(s_sim.stats));
+
+    /* Short addresses are random as the stack assigns them, excluding the coordinator and the reserved range */
+    for (uint16_t dev = 0; dev < count; dev ++) {
+        uint16_t short_addr = 0;
+        do {
+            short_addr = esp_zb_sim_rand() % 0xfff7;
+        } while (!short_addr || s_sim.short_to_dev[short_addr]);
+        s_sim.short_to_dev[short_addr] = dev + 1;
+        s_sim.device[dev].short_addr = short_addr;
+        s_sim.device[dev].level = 0xfe;
+        s_sim.device[dev].temperature = 2000 + esp_zb_sim_rand() % 500;
+        esp_zb_sim_event_push(now + pdMS_TO_TICKS((uint32_t)dev * s_sim.config.join_interval_ms), ESP_ZB_SIM_EVENT_JOIN, dev, NULL);
+    }
+
+    ESP_LOGI(TAG, "Simulating %d devices, seed %" PRIu32, count, s_sim.config.seed);
+}
+
+TickType_t esp_zb_sim_process(TickType_t now)
+{
+    for (int i = 0; i < ESP_ZB_SIM_EVENT_BURST; i ++) {
+        if (!s_sim.heap_len) {
+            return portMAX_DELAY;
+        }
+
+        if ((int32_t)(s_sim.heap[0].time - now) > 0) {
+            return s_sim.heap[0].time - now;
+        }
+
+        esp_zb_sim_event_t event = esp_zb_sim_event_pop();
+        switch (event.type) {
+            case ESP_ZB_SIM_EVENT_JOIN:
+                esp_zb_sim_join(event.time, event.dev);
+                break;
+            case ESP_ZB_SIM_EVENT_REPORT:
+                esp_zb_sim_report(event.time, event.dev);
+                break;
+            case ESP_ZB_SIM_EVENT_APS:
+                esp_zb_sim_aps(event.time, event.dev);
+                break;
+            case ESP_ZB_SIM_EVENT_RESPONSE:
+                esp_zb_sim_respond(event.dev, (esp_zb_sim_resp_t *)event.data);
+                free(event.data);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+esp_err_t esp_zb_sim_config(const esp_zb_sim_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "Invalid configuration");
+    ESP_RETURN_ON_FALSE(config->device_count <= ESP_ZB_SIM_DEVICE_MAX && config->loss_percent <= 100, ESP_ERR_INVALID_ARG,
+                        TAG, "Invalid device count %d or loss %d", config->device_count, config->loss_percent);
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    s_sim.config = *config;
+    esp_zb_lock_release();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_sim_stats_get(esp_zb_sim_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "Invalid statistics");
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    *stats = s_sim.stats;
+    stats->pending = s_sim.heap_len;
+    esp_zb_lock_release();
+
+    return ESP_OK;
+}
@@ -0,0 +1,689 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The Zigbee stack for the Linux target, so the applications on top of the stack build and run on a host.
+ * It keeps the network parameters, runs the alarms and the commissioning signals, the radio is not emulated,
+ * the remote devices are the virtual devices of the simulated network in esp_zigbee_sim.c.
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "esp_zigbee_core.h"
+#include "esp_zigbee_stub.h"
+
+static const char *TAG = "ESP_ZIGBEE_STUB";
+
+#define ESP_ZB_STUB_ALARM_MAX       64      /*!< The number of the pending alarms, the handle of a user alarm is its index plus one */
+
+typedef struct {
+    bool                    used;           /*!< The slot holds a pending alarm */
+    bool                    user;           /*!< The alarm is a user alarm with a pointer parameter */
+    TickType_t              deadline;       /*!< The tick count the alarm fires at */
+    union {
+        esp_zb_callback_t       cb;         /*!< The callback of the scheduler alarm */
+        esp_zb_user_callback_t  user_cb;    /*!< The callback of the user alarm */
+    };
+    union {
+        uint8_t             param;          /*!< The parameter of the scheduler alarm */
+        void                *user_param;    /*!< The parameter of the user alarm */
+    };
+} esp_zb_stub_alarm_t;
+
+typedef struct {
+    esp_err_t               status;         /*!< The status of the signal */
+    uint32_t                signal;         /*!< The signal type, the parameters follow right after it */
+    uint8_t                 params[];       /*!< The parameters of the signal */
+} esp_zb_stub_signal_t;
+
+typedef struct {
+    SemaphoreHandle_t       lock;           /*!< The stack lock, the main loop holds it while calling back */
+    SemaphoreHandle_t       wake;           /*!< Wakes the main loop for a new alarm */
+    esp_zb_core_action_callback_t action_cb;                /*!< The ZCL action handler of the application */
+    esp_zb_apsde_data_indication_callback_t aps_ind_cb;     /*!< The APS data indication handler of the application */
+    esp_zb_apsde_data_confirm_callback_t aps_cfm_cb;        /*!< The APS data confirm handler of the application */
+    esp_zb_nwk_device_type_t role;          /*!< The device type of the local device */
+    esp_zb_ieee_addr_t      long_addr;      /*!< The long address of the local device */
+    esp_zb_ieee_addr_t      ext_pan_id;     /*!< The extended PAN ID of the network */
+    uint16_t                short_addr;     /*!< The short address of the local device */
+    uint16_t                pan_id;         /*!< The PAN ID of the network */
+    uint8_t                 channel;        /*!< The current channel of the network */
+    uint32_t                channel_mask;   /*!< The channel mask of the commissioning */
+    int8_t                  tx_power;       /*!< The TX power in dBm */
+    uint8_t                 nwk_key[16];    /*!< The primary network key */
+    uint8_t                 tsn;            /*!< The ZCL transaction sequence number */
+    esp_zb_stub_alarm_t     alarm[ESP_ZB_STUB_ALARM_MAX]; /*!< The pending alarms */
+} esp_zb_stub_t;
+
+static esp_zb_stub_t s_zb_stub = {
+    .long_addr = {0x01, 0x00, 0x00, 0xff, 0xfe, 0x00, 0xef, 0x60},
+    .short_addr = 0xfffe,
+    .pan_id = 0xffff,
+    .channel = 11,
+    .channel_mask = ESP_ZB_TRANSCEIVER_ALL_CHANNELS_MASK,
+};
+
+static void esp_zb_stub_init(void)
+{
+    if (!s_zb_stub.lock) {
+        s_zb_stub.lock = xSemaphoreCreateRecursiveMutex();
+        s_zb_stub.wake = xSemaphoreCreateBinary();
+    }
+}
+
+static esp_zb_user_cb_handle_t esp_zb_stub_alarm_add(bool user, void *cb, void *user_param, uint8_t param, uint32_t time)
+{
+    esp_zb_user_cb_handle_t handle = ESP_ZB_USER_CB_HANDLE_INVALID;
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    for (int i = 0; i < ESP_ZB_STUB_ALARM_MAX; i ++) {
+        esp_zb_stub_alarm_t *alarm = &s_zb_stub.alarm[i];
+        if (!alarm->used) {
+            alarm->used = true;
+            alarm->user = user;
+            alarm->deadline = xTaskGetTickCount() + pdMS_TO_TICKS(time);
+            if (user) {
+                alarm->user_cb = (esp_zb_user_callback_t)cb;
+                alarm->user_param = user_param;
+            } else {
+                alarm->cb = (esp_zb_callback_t)cb;
+                alarm->param = param;
+            }
+            handle = i + 1;
+            break;
+        }
+    }
+    esp_zb_lock_release();
+
+    if (handle == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        ESP_LOGE(TAG, "No free alarm, %d alarms pending", ESP_ZB_STUB_ALARM_MAX);
+    } else {
+        xSemaphoreGive(s_zb_stub.wake);
+    }
+
+    return handle;
+}
+
+static void esp_zb_stub_signal_cb(void *param)
+{
+    esp_zb_stub_signal_t *sig = (esp_zb_stub_signal_t *)param;
+    esp_zb_app_signal_t signal_s = {
+        .p_app_signal = &sig->signal,
+        .esp_err_status = sig->status,
+    };
+
+    esp_zb_app_signal_handler(&signal_s);
+    free(sig);
+}
+
+void esp_zb_stub_signal_dispatch(esp_zb_app_signal_type_t signal, esp_err_t status, const void *params, uint16_t len)
+{
+    esp_zb_stub_signal_t *sig = calloc(1, sizeof(esp_zb_stub_signal_t) + len);
+
+    if (!sig) {
+        ESP_LOGE(TAG, "No memory for the signal %s", esp_zb_zdo_signal_to_string(signal));
+        return;
+    }
+
+    sig->status = status;
+    sig->signal = signal;
+    if (params && len) {
+        memcpy(sig->params, params, len);
+    }
+    esp_zb_stub_signal_cb(sig);
+}
+
+esp_err_t esp_zb_stub_action(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    return s_zb_stub.action_cb ? s_zb_stub.action_cb(callback_id, message) : ESP_ERR_INVALID_STATE;
+}
+
+bool esp_zb_stub_aps_indication(esp_zb_apsde_data_ind_t ind)
+{
+    return s_zb_stub.aps_ind_cb ? s_zb_stub.aps_ind_cb(ind) : false;
+}
+
+void esp_zb_stub_aps_confirm(esp_zb_apsde_data_confirm_t confirm)
+{
+    if (s_zb_stub.aps_cfm_cb) {
+        s_zb_stub.aps_cfm_cb(confirm);
+    }
+}
+
+void esp_zb_stub_wake(void)
+{
+    xSemaphoreGive(s_zb_stub.wake);
+}
+
+uint32_t esp_zb_stub_alarm_pending(void)
+{
+    uint32_t pending = 0;
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    for (int i = 0; i < ESP_ZB_STUB_ALARM_MAX; i ++) {
+        pending += s_zb_stub.alarm[i].used ? 1 : 0;
+    }
+    esp_zb_lock_release();
+
+    return pending;
+}
+
+/* Signals reach the application from the main loop, as the stack raises them */
+static void esp_zb_stub_signal_raise(esp_zb_app_signal_type_t signal, esp_err_t status, const void *params, uint16_t len)
+{
+    esp_zb_stub_signal_t *sig = calloc(1, sizeof(esp_zb_stub_signal_t) + len);
+
+    if (!sig) {
+        ESP_LOGE(TAG, "No memory for the signal %s", esp_zb_zdo_signal_to_string(signal));
+        return;
+    }
+
+    sig->status = status;
+    sig->signal = signal;
+    if (params && len) {
+        memcpy(sig->params, params, len);
+    }
+
+    if (esp_zb_stub_alarm_add(true, esp_zb_stub_signal_cb, sig, 0, 0) == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        free(sig);
+    }
+}
+
+esp_err_t esp_zb_platform_config(esp_zb_platform_config_t *config)
+{
+    esp_zb_stub_init();
+
+    return ESP_OK;
+}
+
+void esp_zb_init(esp_zb_cfg_t *nwk_cfg)
+{
+    esp_zb_stub_init();
+    s_zb_stub.role = nwk_cfg ? nwk_cfg->esp_zb_role : ESP_ZB_DEVICE_TYPE_COORDINATOR;
+}
+
+esp_err_t esp_zb_start(bool autostart)
+{
+    esp_zb_stub_signal_raise(autostart ? ESP_ZB_BDB_SIGNAL_DEVICE_FIRST_START : ESP_ZB_ZDO_SIGNAL_SKIP_STARTUP, ESP_OK, NULL, 0);
+
+    return ESP_OK;
+}
+
+void esp_zb_stack_main_loop(void)
+{
+    esp_zb_stub_init();
+    esp_zb_sim_clock_start();
+
+    while (true) {
+        esp_zb_stub_alarm_t *next = NULL;
+        TickType_t now = 0;
+        TickType_t wait = portMAX_DELAY;
+
+        esp_zb_lock_acquire(portMAX_DELAY);
+        now = xTaskGetTickCount();
+        for (int i = 0; i < ESP_ZB_STUB_ALARM_MAX; i ++) {
+            esp_zb_stub_alarm_t *alarm = &s_zb_stub.alarm[i];
+            if (alarm->used && (!next || (int32_t)(alarm->deadline - next->deadline) < 0)) {
+                next = alarm;
+            }
+        }
+
+        /* Alarms go first, a signal raised in the same tick reaches the application before the network events */
+        if (next && (int32_t)(next->deadline - now) <= 0) {
+            esp_zb_stub_alarm_t fired = *next;
+            next->used = false;
+            if (fired.user) {
+                fired.user_cb(fired.user_param);
+            } else {
+                fired.cb(fired.param);
+            }
+            esp_zb_lock_release();
+            continue;
+        }
+
+        wait = esp_zb_sim_process(now);
+        if (next && next->deadline - now < wait) {
+            wait = next->deadline - now;
+        }
+        esp_zb_lock_release();
+        if (wait) {
+            xSemaphoreTake(s_zb_stub.wake, wait);
+        }
+    }
+}
+
+bool esp_zb_lock_acquire(TickType_t block_ticks)
+{
+    esp_zb_stub_init();
+
+    return xSemaphoreTakeRecursive(s_zb_stub.lock, block_ticks) == pdTRUE;
+}
+
+void esp_zb_lock_release(void)
+{
+    xSemaphoreGiveRecursive(s_zb_stub.lock);
+}
+
+void esp_zb_scheduler_alarm(esp_zb_callback_t cb, uint8_t param, uint32_t time)
+{
+    esp_zb_stub_alarm_add(false, cb, NULL, param, time);
+}
+
+esp_zb_user_cb_handle_t esp_zb_scheduler_user_alarm(esp_zb_user_callback_t cb, void *param, uint32_t time)
+{
+    return esp_zb_stub_alarm_add(true, cb, param, 0, time);
+}
+
+esp_err_t esp_zb_scheduler_user_alarm_cancel(esp_zb_user_cb_handle_t handle)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+
+    if (handle == ESP_ZB_USER_CB_HANDLE_INVALID || handle > ESP_ZB_STUB_ALARM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_zb_lock_acquire(portMAX_DELAY);
+    if (s_zb_stub.alarm[handle - 1].used && s_zb_stub.alarm[handle - 1].user) {
+        s_zb_stub.alarm[handle - 1].used = false;
+        ret = ESP_OK;
+    }
+    esp_zb_lock_release();
+
+    return ret;
+}
+
+void *esp_zb_app_signal_get_params(uint32_t *signal_p)
+{
+    return signal_p + 1;
+}
+
+const char *esp_zb_zdo_signal_to_string(esp_zb_app_signal_type_t signal)
+{
+    switch (signal) {
+        case ESP_ZB_ZDO_SIGNAL_SKIP_STARTUP:
+            return "ZDO_SIGNAL_SKIP_STARTUP";
+        case ESP_ZB_BDB_SIGNAL_DEVICE_FIRST_START:
+            return "BDB_SIGNAL_DEVICE_FIRST_START";
+        case ESP_ZB_BDB_SIGNAL_FORMATION:
+            return "BDB_SIGNAL_FORMATION";
+        case ESP_ZB_BDB_SIGNAL_STEERING:
+            return "BDB_SIGNAL_STEERING";
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_ANNCE:
+            return "ZDO_SIGNAL_DEVICE_ANNCE";
+        case ESP_ZB_ZDO_SIGNAL_LEAVE_INDICATION:
+            return "ZDO_SIGNAL_LEAVE_INDICATION";
+        default:
+            return "ZDO_SIGNAL_UNKNOWN";
+    }
+}
+
+esp_err_t esp_zb_bdb_start_top_level_commissioning(uint8_t mode_mask)
+{
+    switch (mode_mask) {
+        case ESP_ZB_BDB_MODE_INITIALIZATION:
+            esp_zb_stub_signal_raise(ESP_ZB_BDB_SIGNAL_DEVICE_FIRST_START, ESP_OK, NULL, 0);
+            break;
+        case ESP_ZB_BDB_MODE_NETWORK_FORMATION:
+            s_zb_stub.short_addr = 0x0000;
+            if (s_zb_stub.pan_id == 0xffff) {
+                s_zb_stub.pan_id = 0x1a62;
+            }
+            for (uint8_t channel = 11; channel <= 26; channel ++) {
+                if (s_zb_stub.channel_mask & (1UL << channel)) {
+                    s_zb_stub.channel = channel;
+                    break;
+                }
+            }
+            esp_zb_stub_signal_raise(ESP_ZB_BDB_SIGNAL_FORMATION, ESP_OK, NULL, 0);
+            esp_zb_sim_network_formed();
+            break;
+        case ESP_ZB_BDB_MODE_NETWORK_STEERING:
+            esp_zb_stub_signal_raise(ESP_ZB_BDB_SIGNAL_STEERING, ESP_OK, NULL, 0);
+            break;
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    return ESP_OK;
+}
+
+void esp_zb_core_action_handler_register(esp_zb_core_action_callback_t cb)
+{
+    s_zb_stub.action_cb = cb;
+}
+
+void esp_zb_aps_data_indication_handler_register(esp_zb_apsde_data_indication_callback_t cb)
+{
+    s_zb_stub.aps_ind_cb = cb;
+}
+
+void esp_zb_aps_data_confirm_handler_register(esp_zb_apsde_data_confirm_callback_t cb)
+{
+    s_zb_stub.aps_cfm_cb = cb;
+}
+
+esp_err_t esp_zb_aps_data_request(esp_zb_apsde_data_req_t *req)
+{
+    return req ? esp_zb_sim_aps_data_request(req) : ESP_ERR_INVALID_ARG;
+}
+
+uint8_t esp_zb_get_current_channel(void)
+{
+    return s_zb_stub.channel;
+}
+
+void esp_zb_get_extended_pan_id(esp_zb_ieee_addr_t ext_pan_id)
+{
+    memcpy(ext_pan_id, s_zb_stub.ext_pan_id, sizeof(esp_zb_ieee_addr_t));
+}
+
+void esp_zb_set_extended_pan_id(const esp_zb_ieee_addr_t ext_pan_id)
+{
+    memcpy(s_zb_stub.ext_pan_id, ext_pan_id, sizeof(esp_zb_ieee_addr_t));
+}
+
+void esp_zb_get_long_address(esp_zb_ieee_addr_t addr)
+{
+    memcpy(addr, s_zb_stub.long_addr, sizeof(esp_zb_ieee_addr_t));
+}
+
+esp_err_t esp_zb_set_long_address(esp_zb_ieee_addr_t addr)
+{
+    memcpy(s_zb_stub.long_addr, addr, sizeof(esp_zb_ieee_addr_t));
+
+    return ESP_OK;
+}
+
+uint16_t esp_zb_get_pan_id(void)
+{
+    return s_zb_stub.pan_id;
+}
+
+void esp_zb_set_pan_id(uint16_t pan_id)
+{
+    s_zb_stub.pan_id = pan_id;
+}
+
+uint16_t esp_zb_get_short_address(void)
+{
+    return s_zb_stub.short_addr;
+}
+
+esp_err_t esp_zb_set_channel_mask(uint32_t channel_mask)
+{
+    s_zb_stub.channel_mask = channel_mask;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_set_primary_network_channel_set(uint32_t channel_mask)
+{
+    s_zb_stub.channel_mask = channel_mask;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_set_secondary_network_channel_set(uint32_t channel_mask)
+{
+    return ESP_OK;
+}
+
+void esp_zb_set_tx_power(int8_t power)
+{
+    s_zb_stub.tx_power = power;
+}
+
+uint16_t esp_zb_address_short_by_ieee(esp_zb_ieee_addr_t address)
+{
+    return memcmp(address, s_zb_stub.long_addr, sizeof(esp_zb_ieee_addr_t)) ? esp_zb_sim_short_by_ieee(address) : s_zb_stub.short_addr;
+}
+
+esp_err_t esp_zb_ieee_address_by_short(uint16_t short_addr, uint8_t *ieee_addr)
+{
+    if (short_addr != s_zb_stub.short_addr) {
+        return esp_zb_sim_ieee_by_short(short_addr, ieee_addr);
+    }
+
+    memcpy(ieee_addr, s_zb_stub.long_addr, sizeof(esp_zb_ieee_addr_t));
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_nwk_get_next_neighbor(esp_zb_nwk_info_iterator_t *iterator, esp_zb_nwk_neighbor_info_t *nbr_info)
+{
+    return esp_zb_sim_neighbor_get(iterator, nbr_info);
+}
+
+esp_err_t esp_zb_nwk_get_next_route(esp_zb_nwk_info_iterator_t *iterator, esp_zb_nwk_route_info_t *route_info)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_zb_nwk_get_next_route_record(esp_zb_nwk_info_iterator_t *iterator, esp_zb_nwk_route_record_info_t *route_record_info)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_zb_secur_ic_add(esp_zb_ieee_addr_t address, uint8_t ic_type, uint8_t *ic)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_secur_ic_remove_req(esp_zb_ieee_addr_t address)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_secur_network_key_set(uint8_t *key)
+{
+    memcpy(s_zb_stub.nwk_key, key, sizeof(s_zb_stub.nwk_key));
+
+    return ESP_OK;
+}
+
+esp_err_t esp_zb_secur_primary_network_key_get(uint8_t *key)
+{
+    memcpy(key, s_zb_stub.nwk_key, sizeof(s_zb_stub.nwk_key));
+
+    return ESP_OK;
+}
+
+/* The data model is not kept, the lists only live until they are handed to the stack */
+esp_zb_attribute_list_t *esp_zb_zcl_attr_list_create(uint16_t cluster_id)
+{
+    esp_zb_attribute_list_t *attr_list = calloc(1, sizeof(esp_zb_attribute_list_t));
+
+    if (attr_list) {
+        attr_list->cluster_id = cluster_id;
+    }
+
+    return attr_list;
+}
+
+esp_zb_cluster_list_t *esp_zb_zcl_cluster_list_create(void)
+{
+    return calloc(1, sizeof(esp_zb_cluster_list_t));
+}
+
+esp_zb_ep_list_t *esp_zb_ep_list_create(void)
+{
+    return calloc(1, sizeof(esp_zb_ep_list_t));
+}
+
+esp_err_t esp_zb_ep_list_add_ep(esp_zb_ep_list_t *ep_list, esp_zb_cluster_list_t *cluster_list, esp_zb_endpoint_config_t endpoint_config)
+{
+    free(cluster_list);
+
+    return ep_list ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_zb_device_register(esp_zb_ep_list_t *ep_list)
+{
+    free(ep_list);
+
+    return ESP_OK;
+}
+
+#define ESP_ZB_STUB_CLUSTER_ADD(name)                                                                                   \
+    esp_err_t esp_zb_cluster_list_add_##name##_cluster(esp_zb_cluster_list_t *cluster_list,                             \
+                                                       esp_zb_attribute_list_t *attr_list, uint8_t role_mask)          \
+    {                                                                                                                   \
+        free(attr_list);                                                                                                \
+        return cluster_list ? ESP_OK : ESP_ERR_INVALID_ARG;                                                             \
+    }
+
+ESP_ZB_STUB_CLUSTER_ADD(basic)
+ESP_ZB_STUB_CLUSTER_ADD(power_config)
+ESP_ZB_STUB_CLUSTER_ADD(identify)
+ESP_ZB_STUB_CLUSTER_ADD(groups)
+ESP_ZB_STUB_CLUSTER_ADD(scenes)
+ESP_ZB_STUB_CLUSTER_ADD(on_off)
+ESP_ZB_STUB_CLUSTER_ADD(on_off_switch_config)
+ESP_ZB_STUB_CLUSTER_ADD(level)
+ESP_ZB_STUB_CLUSTER_ADD(time)
+ESP_ZB_STUB_CLUSTER_ADD(analog_input)
+ESP_ZB_STUB_CLUSTER_ADD(analog_output)
+ESP_ZB_STUB_CLUSTER_ADD(analog_value)
+ESP_ZB_STUB_CLUSTER_ADD(binary_input)
+ESP_ZB_STUB_CLUSTER_ADD(multistate_value)
+ESP_ZB_STUB_CLUSTER_ADD(touchlink_commissioning)
+ESP_ZB_STUB_CLUSTER_ADD(ota)
+ESP_ZB_STUB_CLUSTER_ADD(shade_config)
+ESP_ZB_STUB_CLUSTER_ADD(door_lock)
+ESP_ZB_STUB_CLUSTER_ADD(window_covering)
+ESP_ZB_STUB_CLUSTER_ADD(thermostat)
+ESP_ZB_STUB_CLUSTER_ADD(fan_control)
+ESP_ZB_STUB_CLUSTER_ADD(dehumidification_control)
+ESP_ZB_STUB_CLUSTER_ADD(thermostat_ui_config)
+ESP_ZB_STUB_CLUSTER_ADD(color_control)
+ESP_ZB_STUB_CLUSTER_ADD(illuminance_meas)
+ESP_ZB_STUB_CLUSTER_ADD(temperature_meas)
+ESP_ZB_STUB_CLUSTER_ADD(pressure_meas)
+ESP_ZB_STUB_CLUSTER_ADD(humidity_meas)
+ESP_ZB_STUB_CLUSTER_ADD(occupancy_sensing)
+ESP_ZB_STUB_CLUSTER_ADD(carbon_dioxide_measurement)
+ESP_ZB_STUB_CLUSTER_ADD(pm2_5_measurement)
+ESP_ZB_STUB_CLUSTER_ADD(ias_zone)
+ESP_ZB_STUB_CLUSTER_ADD(electrical_meas)
+ESP_ZB_STUB_CLUSTER_ADD(metering)
+ESP_ZB_STUB_CLUSTER_ADD(custom)
+
+uint8_t esp_zb_zcl_read_attr_cmd_req(esp_zb_zcl_read_attr_cmd_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_read_attr(cmd_req, tsn);
+
+    return tsn;
+}
+
+uint8_t esp_zb_zcl_write_attr_cmd_req(esp_zb_zcl_write_attr_cmd_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_write_attr(cmd_req, tsn);
+
+    return tsn;
+}
+
+uint8_t esp_zb_zcl_config_report_cmd_req(esp_zb_zcl_config_report_cmd_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_config_report(cmd_req, tsn);
+
+    return tsn;
+}
+
+uint8_t esp_zb_zcl_disc_attr_cmd_req(esp_zb_zcl_disc_attr_cmd_t *cmd_req)
+{
+    return s_zb_stub.tsn ++;
+}
+
+uint8_t esp_zb_zcl_custom_cluster_cmd_req(esp_zb_zcl_custom_cluster_cmd_req_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_custom_cmd(cmd_req, tsn);
+
+    return tsn;
+}
+
+uint8_t esp_zb_zcl_groups_add_group_cmd_req(esp_zb_zcl_groups_add_group_cmd_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_group(cmd_req, true, tsn);
+
+    return tsn;
+}
+
+uint8_t esp_zb_zcl_groups_remove_group_cmd_req(esp_zb_zcl_groups_add_group_cmd_t *cmd_req)
+{
+    uint8_t tsn = s_zb_stub.tsn ++;
+
+    esp_zb_sim_group(cmd_req, false, tsn);
+
+    return tsn;
+}
+
+esp_err_t esp_zb_zcl_report_attr_cmd_req(esp_zb_zcl_report_attr_cmd_t *cmd_req)
+{
+    return ESP_OK;
+}
+
+static void esp_zb_stub_scan_done(void *param)
+{
+    /* The simulated devices join the local network only, the scan finds no other network */
+    ((esp_zb_zdo_scan_complete_callback_t)param)(ESP_ZB_ZDP_STATUS_SUCCESS, 0, NULL);
+}
+
+void esp_zb_zdo_active_scan_request(uint32_t channel_mask, uint8_t scan_duration, esp_zb_zdo_scan_complete_callback_t user_cb)
+{
+    /* A beacon request waits (2^duration + 1) superframes of 15.36 ms on each channel */
+    uint32_t channels = __builtin_popcount(channel_mask & ESP_ZB_TRANSCEIVER_ALL_CHANNELS_MASK);
+    uint32_t time = channels * ((1U << (scan_duration & 0x0f)) + 1) * 1536 / 100;
+
+    if (user_cb && esp_zb_stub_alarm_add(true, esp_zb_stub_scan_done, user_cb, 0, time) == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        user_cb(ESP_ZB_ZDP_STATUS_TIMEOUT, 0, NULL);
+    }
+}
+
+void esp_zb_zdo_active_ep_req(esp_zb_zdo_active_ep_req_param_t *cmd_req, esp_zb_zdo_active_ep_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_zdo_request(ESP_ZB_SIM_ZDO_ACTIVE_EP, cmd_req->addr_of_interest, 0, user_cb, user_ctx);
+}
+
+void esp_zb_zdo_simple_desc_req(esp_zb_zdo_simple_desc_req_param_t *cmd_req, esp_zb_zdo_simple_desc_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_zdo_request(ESP_ZB_SIM_ZDO_SIMPLE_DESC, cmd_req->addr_of_interest, cmd_req->endpoint, user_cb, user_ctx);
+}
+
+void esp_zb_zdo_node_desc_req(esp_zb_zdo_node_desc_req_param_t *cmd_req, esp_zb_zdo_node_desc_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_zdo_request(ESP_ZB_SIM_ZDO_NODE_DESC, cmd_req->dst_nwk_addr, 0, user_cb, user_ctx);
+}
+
+void esp_zb_zdo_device_bind_req(esp_zb_zdo_bind_req_param_t *cmd_req, esp_zb_zdo_bind_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_zdo_request(ESP_ZB_SIM_ZDO_BIND, cmd_req->req_dst_addr, 0, user_cb, user_ctx);
+}
+
+void esp_zb_zdo_device_unbind_req(esp_zb_zdo_bind_req_param_t *cmd_req, esp_zb_zdo_bind_callback_t user_cb, void *user_ctx)
+{
+    esp_zb_sim_zdo_request(ESP_ZB_SIM_ZDO_BIND, cmd_req->req_dst_addr, 0, user_cb, user_ctx);
+}
+
+esp_err_t esp_zb_zdo_match_cluster(esp_zb_zdo_match_desc_req_param_t *param, esp_zb_zdo_match_desc_callback_t user_cb,
+                                     void *user_ctx)
+{
+    return esp_zb_sim_match_desc(param, user_cb, user_ctx);
+}
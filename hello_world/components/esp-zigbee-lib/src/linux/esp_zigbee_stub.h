@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_zigbee_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The ZDO requests answered by the virtual devices
+ *
+ */
+typedef enum {
+    ESP_ZB_SIM_ZDO_ACTIVE_EP,           /*!< Active endpoint request, the callback is esp_zb_zdo_active_ep_callback_t */
+    ESP_ZB_SIM_ZDO_SIMPLE_DESC,         /*!< Simple descriptor request, the callback is esp_zb_zdo_simple_desc_callback_t */
+    ESP_ZB_SIM_ZDO_NODE_DESC,           /*!< Node descriptor request, the callback is esp_zb_zdo_node_desc_callback_t */
+    ESP_ZB_SIM_ZDO_BIND,                /*!< Bind or unbind request, the callback is esp_zb_zdo_bind_callback_t */
+    ESP_ZB_SIM_ZDO_MATCH_DESC,          /*!< Match descriptor request, the callback is esp_zb_zdo_match_desc_callback_t */
+} esp_zb_sim_zdo_t;
+
+/**
+ * @brief Pass the signal to the application right away, the caller runs in the main loop.
+ *
+ * @param[in] signal The signal type, refer to esp_zb_app_signal_type_t
+ * @param[in] status The status of the signal
+ * @param[in] params The parameters of the signal, may be NULL
+ * @param[in] len    The length of the parameters
+ */
+void esp_zb_stub_signal_dispatch(esp_zb_app_signal_type_t signal, esp_err_t status, const void *params, uint16_t len);
+
+/**
+ * @brief Pass the ZCL message to the action handler of the application, the caller runs in the main loop.
+ *
+ * @param[in] callback_id The message type, refer to esp_zb_core_action_callback_id_t
+ * @param[in] message     The message, the type depends on the callback_id
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_INVALID_STATE: no action handler registered
+ *      - others: the result of the action handler
+ */
+esp_err_t esp_zb_stub_action(esp_zb_core_action_callback_id_t callback_id, const void *message);
+
+/**
+ * @brief Pass the APS data indication to the application, the caller runs in the main loop.
+ *
+ * @param[in] ind The APS data indication
+ *
+ * @return
+ *      - true: the application handled the indication
+ *      - false: the application did not handle it or registered no handler
+ */
+bool esp_zb_stub_aps_indication(esp_zb_apsde_data_ind_t ind);
+
+/**
+ * @brief Pass the APS data confirm to the application, the caller runs in the main loop.
+ *
+ * @param[in] confirm The APS data confirm
+ */
+void esp_zb_stub_aps_confirm(esp_zb_apsde_data_confirm_t confirm);
+
+/**
+ * @brief Wake the main loop for a new event of the simulation.
+ *
+ */
+void esp_zb_stub_wake(void);
+
+/**
+ * @brief Get the number of the pending alarms, user alarms and signals included.
+ *
+ * @return The number of the used slots of the alarm table
+ */
+uint32_t esp_zb_stub_alarm_pending(void);
+
+/**
+ * @brief Start the clock of the simulation, the virtual clock and the soak reports as configured.
+ *
+ */
+void esp_zb_sim_clock_start(void);
+
+/**
+ * @brief Start the simulated network, called once the network is formed.
+ *
+ */
+void esp_zb_sim_network_formed(void);
+
+/**
+ * @brief Run the events of the simulation which are due, called by the main loop holding the stack lock.
+ *
+ * @param[in] now The current tick count
+ *
+ * @return The ticks until the next event, portMAX_DELAY if there is none
+ */
+TickType_t esp_zb_sim_process(TickType_t now);
+
+/**
+ * @brief Send the read attribute request to the virtual device.
+ *
+ * @param[in] cmd_req The read attribute request
+ * @param[in] tsn     The transaction sequence number of the request
+ */
+void esp_zb_sim_read_attr(const esp_zb_zcl_read_attr_cmd_t *cmd_req, uint8_t tsn);
+
+/**
+ * @brief Send the write attribute request to the virtual device.
+ *
+ * @param[in] cmd_req The write attribute request
+ * @param[in] tsn     The transaction sequence number of the request
+ */
+void esp_zb_sim_write_attr(const esp_zb_zcl_write_attr_cmd_t *cmd_req, uint8_t tsn);
+
+/**
+ * @brief Send the configure reporting request to the virtual device, the response lists the attributes it does not have.
+ *
+ * @param[in] cmd_req The configure reporting request
+ * @param[in] tsn     The transaction sequence number of the request
+ */
+void esp_zb_sim_config_report(const esp_zb_zcl_config_report_cmd_t *cmd_req, uint8_t tsn);
+
+/**
+ * @brief Send the cluster specific command to the virtual device, the on/off and move to level commands change its attributes.
+ *
+ * @param[in] cmd_req The custom cluster command
+ * @param[in] tsn     The transaction sequence number of the request
+ */
+void esp_zb_sim_custom_cmd(const esp_zb_zcl_custom_cluster_cmd_t *cmd_req, uint8_t tsn);
+
+/**
+ * @brief Send the add or remove group command to the virtual device.
+ *
+ * @param[in] cmd_req The group command
+ * @param[in] add     Add the group, remove it otherwise
+ * @param[in] tsn     The transaction sequence number of the request
+ */
+void esp_zb_sim_group(const esp_zb_zcl_groups_add_group_cmd_t *cmd_req, bool add, uint8_t tsn);
+
+/**
+ * @brief Send the ZDO request to the virtual device, the callback is called once from the main loop,
+ *        with ESP_ZB_ZDP_STATUS_TIMEOUT when the device is unknown or the request is lost.
+ *
+ * @param[in] zdo      The request, refer to esp_zb_sim_zdo_t
+ * @param[in] addr     The short address of the device
+ * @param[in] endpoint The endpoint of interest of the simple descriptor request
+ * @param[in] user_cb  The callback of the request, the type depends on the request
+ * @param[in] user_ctx The context of the callback
+ */
+void esp_zb_sim_zdo_request(esp_zb_sim_zdo_t zdo, uint16_t addr, uint8_t endpoint, void *user_cb, void *user_ctx);
+
+/**
+ * @brief Send the match descriptor request, the callback is called once from the main loop, with the first
+ *        device which matches a broadcast request.
+ *
+ * @param[in] param    The match descriptor request
+ * @param[in] user_cb  The callback of the request
+ * @param[in] user_ctx The context of the callback
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_NO_MEM: no memory for the response
+ */
+esp_err_t esp_zb_sim_match_desc(const esp_zb_zdo_match_desc_req_param_t *param, esp_zb_zdo_match_desc_callback_t user_cb, void *user_ctx);
+
+/**
+ * @brief Send the APS data request to the virtual device, the confirm follows after the latency.
+ *
+ * @param[in] req The APS data request
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_NO_MEM: no memory for the confirm
+ */
+esp_err_t esp_zb_sim_aps_data_request(const esp_zb_apsde_data_req_t *req);
+
+/**
+ * @brief Get the short address of the virtual device.
+ *
+ * @param[in] ieee_addr The long address of the device
+ *
+ * @return The short address, 0xffff if the device is unknown
+ */
+uint16_t esp_zb_sim_short_by_ieee(const esp_zb_ieee_addr_t ieee_addr);
+
+/**
+ * @brief Get the long address of the virtual device.
+ *
+ * @param[in]  short_addr The short address of the device
+ * @param[out] ieee_addr  The long address of the device
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_NOT_FOUND: the device is unknown
+ */
+esp_err_t esp_zb_sim_ieee_by_short(uint16_t short_addr, esp_zb_ieee_addr_t ieee_addr);
+
+/**
+ * @brief Get the neighbor table entry of the joined virtual device at the iterator, the iterator moves to the next device.
+ *
+ * @param[in, out] iterator The position in the neighbor table
+ * @param[out]     nbr_info The neighbor table entry
+ *
+ * @return
+ *      - ESP_OK: on success
+ *      - ESP_ERR_NOT_FOUND: no more devices
+ */
+esp_err_t esp_zb_sim_neighbor_get(esp_zb_nwk_info_iterator_t *iterator, esp_zb_nwk_neighbor_info_t *nbr_info);
+
+#ifdef __cplusplus
+}
+#endif
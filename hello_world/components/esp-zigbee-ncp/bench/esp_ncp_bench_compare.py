@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Compares the BENCH lines of esp_ncp_bench.elf with a baseline:
+#
+#   ./build/esp_ncp_bench.elf | python esp_ncp_bench_compare.py --baseline baseline.txt --save
+#   ./build/esp_ncp_bench.elf | python esp_ncp_bench_compare.py --baseline baseline.txt --threshold 10
+#
+# The first records the baseline, the second exits 1 when the ns/frame of a case grew by more than the
+# threshold. Run both on the same host, the figures of two machines do not compare.
+
+import argparse
+import sys
+
+FIELDS = ('frames', 'ns', 'bytes', 'bytes_per_cycle')
+
+
+def parse(lines):
+    cases = {}
+    for line in lines:
+        words = line.split()
+        if len(words) != 2 + len(FIELDS) or words[0] != 'BENCH':
+            continue
+        try:
+            cases[words[1]] = dict(zip(FIELDS, (float(word) for word in words[2:])))
+        except ValueError:
+            continue
+    return cases
+
+
+def read(path):
+    with open(path) as f:
+        return parse(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare the NCP benchmarks with a baseline')
+    parser.add_argument('input', nargs='?', help='the output of esp_ncp_bench.elf, stdin by default')
+    parser.add_argument('--baseline', required=True, help='the baseline, the BENCH lines of an earlier run')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='the ns/frame growth in percent counted as a regression, 10 by default')
+    parser.add_argument('--save', action='store_true', help='write the input to the baseline instead of comparing')
+    args = parser.parse_args()
+
+    lines = open(args.input).readlines() if args.input else sys.stdin.readlines()
+    current = parse(lines)
+    if not current:
+        print('No BENCH lines in the input', file=sys.stderr)
+        return 2
+
+    if args.save:
+        with open(args.baseline, 'w') as f:
+            f.writelines(line for line in lines if line.startswith('BENCH ') or line.startswith('# BENCH '))
+        print('Saved %d cases to %s' % (len(current), args.baseline))
+        return 0
+
+    baseline = read(args.baseline)
+    regressions = 0
+    print('%-20s %12s %12s %8s' % ('case', 'base ns', 'ns', 'delta'))
+    for name, case in current.items():
+        base = baseline.get(name)
+        if not base:
+            print('%-20s %12s %12.1f %8s' % (name, '-', case['ns'], 'new'))
+            continue
+        delta = (case['ns'] - base['ns']) * 100.0 / base['ns'] if base['ns'] else 0.0
+        mark = ''
+        if delta > args.threshold:
+            mark = '  REGRESSION'
+            regressions += 1
+        print('%-20s %12.1f %12.1f %+7.1f%%%s' % (name, base['ns'], case['ns'], delta, mark))
+    for name in baseline.keys() - current.keys():
+        print('%-20s %12.1f %12s %8s' % (name, baseline[name]['ns'], '-', 'gone'))
+
+    if regressions:
+        print('%d cases regressed by more than %.1f%%' % (regressions, args.threshold), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,447 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Microbenchmarks of the NCP frame path, built for the Linux target against the stack stub:
+ *
+ *   idf.py --preview set-target linux build
+ *   ./build/esp_ncp_bench.elf | python esp_ncp_bench_compare.py --baseline baseline.txt
+ *
+ * Every case runs the NCP functions over a small corpus of frames the host really sends, or of messages the
+ * stack really delivers, until ESP_NCP_BENCH_CASE_US passed. The frames handed to the bus end in a counting
+ * sink, esp_ncp_bus_input() is wrapped at link time, so the figures hold the NCP work only.
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "esp_crc.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_frame.h"
+#include "esp_ncp_wire.h"
+#include "esp_ncp_zb.h"
+#include "slip.h"
+
+#if !CONFIG_IDF_TARGET_LINUX
+#error "The NCP benchmarks run on the linux target"
+#endif
+
+#define ESP_NCP_BENCH_CASE_US       200000      /*!< The minimum run time of one case */
+#define ESP_NCP_BENCH_SEED          0x5eed      /*!< The seed of the payload bytes */
+#define ESP_NCP_BENCH_DST_ADDR      0x1234      /*!< A device no request reaches, nothing queues up behind the requests */
+
+typedef struct {
+    esp_ncp_header_t        header;             /*!< The header of the frame */
+    uint8_t                 *payload;           /*!< The payload, in raw right after the header */
+    uint8_t                 *raw;               /*!< The header, the payload and the CRC */
+    uint16_t                raw_len;            /*!< The length of raw */
+    uint8_t                 *slip;              /*!< The SLIP encoded raw, as on the wire */
+    uint16_t                slip_len;           /*!< The length of slip */
+} esp_ncp_bench_frame_t;
+
+typedef struct {
+    const char              *name;              /*!< The name of the case */
+    size_t                  (*run)(size_t index); /*!< Runs the item of the corpus, returns the bytes it processed */
+    size_t                  count;              /*!< The number of items in the corpus */
+} esp_ncp_bench_case_t;
+
+typedef struct {
+    uint64_t                frames;             /*!< The frames handed to the bus */
+    uint64_t                bytes;              /*!< The bytes handed to the bus */
+} esp_ncp_bench_sink_t;
+
+static esp_ncp_bench_frame_t s_requests[6];     /*!< The requests of the host */
+static esp_ncp_bench_frame_t s_replies[5];      /*!< The responses and notifications of the NCP */
+static esp_ncp_bench_sink_t s_sink;
+static uint32_t s_rand = ESP_NCP_BENCH_SEED;
+
+esp_err_t __wrap_esp_ncp_bus_input(const void *buffer, uint16_t len);
+
+esp_err_t __wrap_esp_ncp_bus_input(const void *buffer, uint16_t len)
+{
+    if (!buffer) {
+        return ESP_FAIL;
+    }
+
+    s_sink.frames ++;
+    s_sink.bytes += len;
+
+    return ESP_OK;
+}
+
+static uint64_t esp_ncp_bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/* xorshift32, the same payloads on every run */
+static uint8_t esp_ncp_bench_rand(void)
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+
+    return (uint8_t)s_rand;
+}
+
+static void esp_ncp_bench_frame_make(esp_ncp_bench_frame_t *frame, uint16_t id, uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    uint16_t head_len = sizeof(esp_ncp_header_t);
+
+    frame->header = (esp_ncp_header_t) {
+        .id = id,
+        .sn = esp_ncp_bench_rand(),
+        .len = len,
+    };
+    frame->header.flags.type = type;
+    frame->raw_len = head_len + len + sizeof(uint16_t);
+    frame->raw = calloc(1, frame->raw_len);
+    assert(frame->raw);
+    memcpy(frame->raw, &frame->header, head_len);
+    if (len) {
+        memcpy(frame->raw + head_len, payload, len);
+    }
+    frame->payload = frame->raw + head_len;
+
+    uint16_t crc = esp_crc16_le(UINT16_MAX, frame->raw, head_len + len);
+    memcpy(frame->raw + head_len + len, &crc, sizeof(uint16_t));
+    slip_encode(frame->raw, frame->raw_len, &frame->slip, &frame->slip_len);
+    assert(frame->slip);
+}
+
+static void esp_ncp_bench_corpus_init(void)
+{
+    uint8_t payload[160];
+    size_t len = 0;
+    esp_ncp_wire_zcl_basic_cmd_t basic_cmd = {
+        .dst_endpoint = 1,
+        .src_endpoint = 1,
+    };
+
+    esp_ncp_wire_addr_set_short(&basic_cmd.dst_addr, ESP_NCP_BENCH_DST_ADDR);
+
+    /* The polls of a host keeping its view of the network fresh */
+    esp_ncp_bench_frame_make(&s_requests[0], ESP_NCP_NETWORK_PAN_ID_GET, 0, NULL, 0);
+    esp_ncp_bench_frame_make(&s_requests[1], ESP_NCP_NETWORK_SHORT_ADDRESS_GET, 0, NULL, 0);
+    esp_ncp_bench_frame_make(&s_requests[2], ESP_NCP_NETWORK_LONG_ADDRESS_GET, 0, NULL, 0);
+
+    /* One on/off read, a read of the whole basic cluster and a level write */
+    const uint8_t on_off[] = { 0x00, 0x00 };
+    esp_ncp_wire_zcl_attr_read_t read_one = {
+        .zcl_basic_cmd = basic_cmd,
+        .address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+        .cluster_id = ESP_ZB_ZCL_CLUSTER_ID_ON_OFF,
+        .attr_number = 1,
+        .attr_field = on_off,
+    };
+    len = esp_ncp_wire_zcl_attr_read_encode(&read_one, payload, sizeof(payload));
+    esp_ncp_bench_frame_make(&s_requests[3], ESP_NCP_ZCL_ATTR_READ, 0, payload, len);
+
+    const uint8_t basic[] = { 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0x07, 0x00 };
+    esp_ncp_wire_zcl_attr_read_t read_basic = read_one;
+    read_basic.cluster_id = ESP_ZB_ZCL_CLUSTER_ID_BASIC;
+    read_basic.attr_number = sizeof(basic) / sizeof(uint16_t);
+    read_basic.attr_field = basic;
+    len = esp_ncp_wire_zcl_attr_read_encode(&read_basic, payload, sizeof(payload));
+    esp_ncp_bench_frame_make(&s_requests[4], ESP_NCP_ZCL_ATTR_READ, 0, payload, len);
+
+    const uint8_t level[] = { 0x00, 0x00, ESP_ZB_ZCL_ATTR_TYPE_U8, 1, 0x80, 0x10, 0x00, ESP_ZB_ZCL_ATTR_TYPE_U16, 2, 0x0a, 0x00 };
+    esp_ncp_wire_zcl_attr_write_t write = {
+        .zcl_basic_cmd = basic_cmd,
+        .address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+        .cluster_id = ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL,
+        .attr_number = 2,
+        .attr_field = level,
+        .attr_field_len = sizeof(level),
+    };
+    len = esp_ncp_wire_zcl_attr_write_encode(&write, payload, sizeof(payload));
+    esp_ncp_bench_frame_make(&s_requests[5], ESP_NCP_ZCL_ATTR_WRITE, 0, payload, len);
+
+    /* A status, a status with TSN, and APS data indications with 8, 32 and 100 bytes of ASDU, random bytes escape in SLIP */
+    const uint16_t reply_len[] = { 1, 2, ESP_NCP_WIRE_APS_DATA_INDICATION_FIXED_SIZE + 8, ESP_NCP_WIRE_APS_DATA_INDICATION_FIXED_SIZE + 32,
+                                   ESP_NCP_WIRE_APS_DATA_INDICATION_FIXED_SIZE + 100 };
+    for (size_t i = 0; i < sizeof(s_replies) / sizeof(s_replies[0]); i ++) {
+        for (size_t j = 0; j < reply_len[i]; j ++) {
+            payload[j] = esp_ncp_bench_rand();
+        }
+        esp_ncp_bench_frame_make(&s_replies[i], (i < 2) ? ESP_NCP_ZCL_ATTR_READ : ESP_NCP_APS_DATA_INDICATION, (i < 2) ? 1 : 2,
+                                 payload, reply_len[i]);
+    }
+}
+
+#define ESP_NCP_BENCH_FRAME_COUNT   (sizeof(s_requests) / sizeof(s_requests[0]) + sizeof(s_replies) / sizeof(s_replies[0]))
+
+static esp_ncp_bench_frame_t *esp_ncp_bench_frame_get(size_t index)
+{
+    size_t requests = sizeof(s_requests) / sizeof(s_requests[0]);
+
+    return (index < requests) ? &s_requests[index] : &s_replies[index - requests];
+}
+
+static size_t esp_ncp_bench_slip_encode(size_t index)
+{
+    esp_ncp_bench_frame_t *frame = esp_ncp_bench_frame_get(index);
+    uint8_t *output = NULL;
+    uint16_t outlen = 0;
+
+    slip_encode(frame->raw, frame->raw_len, &output, &outlen);
+    free(output);
+
+    return frame->raw_len;
+}
+
+static size_t esp_ncp_bench_slip_decode(size_t index)
+{
+    esp_ncp_bench_frame_t *frame = esp_ncp_bench_frame_get(index);
+    uint8_t *output = NULL;
+    uint16_t outlen = 0;
+
+    slip_decode(frame->slip, frame->slip_len, &output, &outlen);
+    free(output);
+
+    return frame->slip_len;
+}
+
+static volatile uint16_t s_crc;
+
+static size_t esp_ncp_bench_crc16(size_t index)
+{
+    esp_ncp_bench_frame_t *frame = esp_ncp_bench_frame_get(index);
+
+    s_crc = esp_crc16_le(UINT16_MAX, frame->raw, frame->raw_len - sizeof(uint16_t));
+
+    return frame->raw_len - sizeof(uint16_t);
+}
+
+static size_t esp_ncp_bench_frame_output(size_t index)
+{
+    esp_ncp_frame_output(s_requests[index].slip, s_requests[index].slip_len);
+
+    return s_requests[index].slip_len;
+}
+
+static size_t esp_ncp_bench_zb_output(size_t index)
+{
+    esp_ncp_bench_frame_t *frame = &s_requests[index];
+    esp_ncp_header_t header = frame->header;
+
+    esp_ncp_zb_output(&header, frame->header.len ? frame->payload : NULL, frame->header.len);
+
+    return frame->header.len;
+}
+
+static size_t esp_ncp_bench_frame_input(size_t index)
+{
+    esp_ncp_bench_frame_t *frame = &s_replies[index];
+    esp_ncp_header_t header = frame->header;
+
+    if (frame->header.flags.type == 1) {
+        esp_ncp_resp_input(&header, frame->payload, frame->header.len);
+    } else {
+        esp_ncp_noti_input(&header, frame->payload, frame->header.len);
+    }
+
+    return frame->header.len;
+}
+
+/* The messages of the stack, as the ZCL layer delivers them to the action handler */
+static esp_zb_zcl_cmd_info_t esp_ncp_bench_cmd_info(uint16_t cluster)
+{
+    return (esp_zb_zcl_cmd_info_t) {
+        .status = ESP_ZB_ZCL_STATUS_SUCCESS,
+        .header = { .tsn = esp_ncp_bench_rand(), .rssi = -60 },
+        .src_address = { .addr_type = ESP_ZB_ZCL_ADDR_TYPE_SHORT, .u.short_addr = ESP_NCP_BENCH_DST_ADDR },
+        .dst_address = 0x0000,
+        .src_endpoint = 1,
+        .dst_endpoint = 1,
+        .cluster = cluster,
+        .profile = ESP_ZB_AF_HA_PROFILE_ID,
+    };
+}
+
+static uint64_t esp_ncp_bench_action(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    uint64_t bytes = s_sink.bytes;
+
+    esp_ncp_zb_action(callback_id, message);
+
+    return s_sink.bytes - bytes;
+}
+
+static size_t esp_ncp_bench_read_attr_resp(size_t index)
+{
+    uint8_t on_off = 1, level = 0x80;
+    int16_t temperature = 2150;
+    char model[] = "\x0c" "esp-zb-light";
+    esp_zb_zcl_read_attr_resp_variable_t variables[] = {
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute = { 0x0000, { ESP_ZB_ZCL_ATTR_TYPE_BOOL, 1, &on_off } } },
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute = { 0x0000, { ESP_ZB_ZCL_ATTR_TYPE_U8, 1, &level } } },
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute = { 0x0000, { ESP_ZB_ZCL_ATTR_TYPE_S16, 2, &temperature } } },
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute = { 0x0005, { ESP_ZB_ZCL_ATTR_TYPE_CHAR_STRING, sizeof(model) - 1, model } } },
+    };
+    esp_zb_zcl_cmd_read_attr_resp_message_t message = {
+        .info = esp_ncp_bench_cmd_info(ESP_ZB_ZCL_CLUSTER_ID_BASIC),
+        .variables = variables,
+    };
+
+    /* One attribute, or the four of them chained */
+    if (index) {
+        for (size_t i = 0; i + 1 < sizeof(variables) / sizeof(variables[0]); i ++) {
+            variables[i].next = &variables[i + 1];
+        }
+    }
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID, &message);
+}
+
+static size_t esp_ncp_bench_write_attr_resp(size_t index)
+{
+    esp_zb_zcl_write_attr_resp_variable_t variables[2] = {
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute_id = 0x0000, .next = &variables[1] },
+        { .status = ESP_ZB_ZCL_STATUS_READ_ONLY, .attribute_id = 0x0010 },
+    };
+    esp_zb_zcl_cmd_write_attr_resp_message_t message = {
+        .info = esp_ncp_bench_cmd_info(ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL),
+        .variables = variables,
+    };
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID, &message);
+}
+
+static size_t esp_ncp_bench_report_config_resp(size_t index)
+{
+    esp_zb_zcl_config_report_resp_variable_t variables[2] = {
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute_id = 0x0000, .next = &variables[1] },
+        { .status = ESP_ZB_ZCL_STATUS_SUCCESS, .attribute_id = 0x0001 },
+    };
+    esp_zb_zcl_cmd_config_report_resp_message_t message = {
+        .info = esp_ncp_bench_cmd_info(ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT),
+        .variables = variables,
+    };
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID, &message);
+}
+
+static size_t esp_ncp_bench_disc_attr_resp(size_t index)
+{
+    esp_zb_zcl_disc_attr_variable_t variables[8];
+    esp_zb_zcl_cmd_discover_attributes_resp_message_t message = {
+        .info = esp_ncp_bench_cmd_info(ESP_ZB_ZCL_CLUSTER_ID_BASIC),
+        .is_completed = 1,
+        .variables = variables,
+    };
+
+    for (size_t i = 0; i < sizeof(variables) / sizeof(variables[0]); i ++) {
+        variables[i] = (esp_zb_zcl_disc_attr_variable_t) {
+            .attr_id = i,
+            .data_type = (i < 4) ? ESP_ZB_ZCL_ATTR_TYPE_U8 : ESP_ZB_ZCL_ATTR_TYPE_CHAR_STRING,
+            .next = (i + 1 < sizeof(variables) / sizeof(variables[0])) ? &variables[i + 1] : NULL,
+        };
+    }
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_CMD_DISC_ATTR_RESP_CB_ID, &message);
+}
+
+static size_t esp_ncp_bench_default_resp(size_t index)
+{
+    esp_zb_zcl_cmd_default_resp_message_t message = {
+        .info = esp_ncp_bench_cmd_info(ESP_ZB_ZCL_CLUSTER_ID_ON_OFF),
+        .resp_to_cmd = 0x02,
+        .status_code = ESP_ZB_ZCL_STATUS_SUCCESS,
+    };
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID, &message);
+}
+
+static size_t esp_ncp_bench_report_attr(size_t index)
+{
+    int16_t temperature = 2150;
+    esp_zb_zcl_report_attr_message_t message = {
+        .status = ESP_ZB_ZCL_STATUS_SUCCESS,
+        .src_address = { .addr_type = ESP_ZB_ZCL_ADDR_TYPE_SHORT, .u.short_addr = ESP_NCP_BENCH_DST_ADDR },
+        .src_endpoint = 1,
+        .dst_endpoint = 1,
+        .cluster = ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT,
+        .attribute = { 0x0000, { ESP_ZB_ZCL_ATTR_TYPE_S16, sizeof(temperature), &temperature } },
+    };
+
+    return esp_ncp_bench_action(ESP_ZB_CORE_REPORT_ATTR_CB_ID, &message);
+}
+
+static const esp_ncp_bench_case_t s_cases[] = {
+    { "slip_encode", esp_ncp_bench_slip_encode, ESP_NCP_BENCH_FRAME_COUNT },
+    { "slip_decode", esp_ncp_bench_slip_decode, ESP_NCP_BENCH_FRAME_COUNT },
+    { "crc16", esp_ncp_bench_crc16, ESP_NCP_BENCH_FRAME_COUNT },
+    { "frame_output", esp_ncp_bench_frame_output, sizeof(s_requests) / sizeof(s_requests[0]) },
+    { "frame_input", esp_ncp_bench_frame_input, sizeof(s_replies) / sizeof(s_replies[0]) },
+    { "zb_output", esp_ncp_bench_zb_output, sizeof(s_requests) / sizeof(s_requests[0]) },
+    { "read_attr_resp", esp_ncp_bench_read_attr_resp, 2 },
+    { "write_attr_resp", esp_ncp_bench_write_attr_resp, 1 },
+    { "report_config_resp", esp_ncp_bench_report_config_resp, 1 },
+    { "disc_attr_resp", esp_ncp_bench_disc_attr_resp, 1 },
+    { "default_resp", esp_ncp_bench_default_resp, 1 },
+    { "report_attr", esp_ncp_bench_report_attr, 1 },
+};
+
+/* The bytes are those read for the codecs and the dispatch, and those handed to the bus for the response builders */
+static void esp_ncp_bench_run(const esp_ncp_bench_case_t *bench)
+{
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    int64_t elapsed_us = 0;
+
+    for (size_t i = 0; i < bench->count; i ++) {
+        bench->run(i);
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    uint64_t start_cycles = esp_ncp_bench_cycles();
+    do {
+        for (size_t i = 0; i < bench->count; i ++) {
+            bytes += bench->run(i);
+        }
+        frames += bench->count;
+        elapsed_us = esp_timer_get_time() - start_us;
+    } while (elapsed_us < ESP_NCP_BENCH_CASE_US);
+    uint64_t cycles = esp_ncp_bench_cycles() - start_cycles;
+
+    printf("BENCH %-20s %10" PRIu64 " %12.1f %12.1f %12.4f\n", bench->name, frames, elapsed_us * 1000.0 / frames,
+           (double)bytes / frames, cycles ? (double)bytes / cycles : 0.0);
+}
+
+void app_main(void)
+{
+    esp_zb_cfg_t zb_cfg = {
+        .esp_zb_role = ESP_ZB_DEVICE_TYPE_COORDINATOR,
+    };
+
+    /* The hex dumps and the request logs of the NCP would be all the benchmark measures */
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_zb_init(&zb_cfg);
+    esp_ncp_bench_corpus_init();
+
+    printf("# BENCH %-20s %10s %12s %12s %12s\n", "case", "frames", "ns/frame", "bytes/frame", "bytes/cycle");
+    for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i ++) {
+        esp_ncp_bench_run(&s_cases[i]);
+    }
+    printf("# BENCH %" PRIu64 " frames handed to the bus\n", s_sink.frames);
+    fflush(stdout);
+
+    exit(EXIT_SUCCESS);
+}
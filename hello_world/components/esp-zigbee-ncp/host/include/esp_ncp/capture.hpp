@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace esp_ncp {
+
+/** Definition of the capture file, refer to esp_ncp_capture.h on the NCP which writes the same format
+ *
+ * All fields are little endian.
+ *
+ * File header, 24 bytes:
+ *   magic (4) "NCPC", version (2), origin (2), start time (8, ns since the Unix epoch), index offset (8, 0 if there is no index)
+ *
+ * Record, 12 bytes followed by the raw SLIP frame with both SLIP_END:
+ *   length and direction (4, bit 31 is the direction, bits 0..30 the length), time (8, ns since the start time)
+ *
+ * Index, at the index offset, one entry every CAPTURE_INDEX_INTERVAL records:
+ *   magic (4) "NCPI", count (4), then per entry: record number (8), file offset (8), time (8)
+ *
+ * A capture which was not closed has no index, the reader scans it and stops at the first truncated record.
+ */
+constexpr uint32_t CAPTURE_MAGIC = 0x4350434E;          /*!< "NCPC" */
+constexpr uint32_t CAPTURE_INDEX_MAGIC = 0x4950434E;    /*!< "NCPI" */
+constexpr uint16_t CAPTURE_VERSION = 1;
+constexpr size_t CAPTURE_HEADER_SIZE = 24;
+constexpr size_t CAPTURE_RECORD_HEADER_SIZE = 12;
+constexpr uint64_t CAPTURE_INDEX_INTERVAL = 256;
+
+/**
+ * @brief The side which wrote the capture.
+ *
+ */
+enum class CaptureOrigin : uint16_t {
+    Host = 0,                                   /*!< The host library or esp_ncp_muxd */
+    Ncp = 1,                                    /*!< The bus task of the NCP */
+};
+
+/**
+ * @brief The direction of a captured frame.
+ *
+ */
+enum class CaptureDirection : uint8_t {
+    ToNcp = 0,                                  /*!< From the host to the NCP */
+    FromNcp = 1,                                /*!< From the NCP to the host */
+};
+
+/**
+ * @brief A captured frame.
+ *
+ */
+struct CaptureRecord {
+    uint64_t number = 0;                        /*!< The record number from 0 */
+    CaptureDirection direction = CaptureDirection::ToNcp;
+    uint64_t time_ns = 0;                       /*!< Since the start of the capture */
+    std::vector<uint8_t> data;                  /*!< The raw SLIP frame */
+};
+
+/**
+ * @brief An index entry of a capture.
+ *
+ */
+struct CaptureIndexEntry {
+    uint64_t number;                            /*!< The record number */
+    uint64_t offset;                            /*!< The file offset of the record */
+    uint64_t time_ns;                           /*!< The time of the record */
+};
+
+/**
+ * @brief Writes a capture file.
+ *
+ * @note Not thread safe, the client and the daemon write from their own thread only.
+ */
+class CaptureWriter {
+public:
+    /** Create the file, throws std::system_error on failure */
+    CaptureWriter(const std::string &path, CaptureOrigin origin = CaptureOrigin::Host);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter &) = delete;
+    CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+    void write(CaptureDirection direction, std::chrono::steady_clock::time_point when, const uint8_t *data, size_t len);
+
+    /** Write the index and close the file, done by the destructor too */
+    void close();
+
+    uint64_t records() const { return records_; }
+
+private:
+    FILE *file_ = nullptr;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t records_ = 0;
+    uint64_t offset_ = 0;
+    std::vector<CaptureIndexEntry> index_;
+};
+
+/**
+ * @brief Reads a capture file.
+ *
+ */
+class CaptureReader {
+public:
+    /** Open the file, throws std::runtime_error if it is not a capture */
+    explicit CaptureReader(const std::string &path);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader &) = delete;
+    CaptureReader &operator=(const CaptureReader &) = delete;
+
+    CaptureOrigin origin() const { return origin_; }
+    uint64_t start_unix_ns() const { return start_unix_ns_; }
+
+    /** The index, empty if the capture was not closed */
+    const std::vector<CaptureIndexEntry> &index() const { return index_; }
+
+    /** Read the next record, false at the end of the capture */
+    bool next(CaptureRecord &record);
+
+    /** Seek to the first record at or after the time, through the index if there is one */
+    void seek_time(uint64_t time_ns);
+
+    /** Seek to the record number, through the index if there is one */
+    void seek_record(uint64_t number);
+
+private:
+    void seek_entry(const CaptureIndexEntry &entry);
+
+    FILE *file_ = nullptr;
+    CaptureOrigin origin_ = CaptureOrigin::Host;
+    uint64_t start_unix_ns_ = 0;
+    uint64_t end_ = 0;                          /*!< The end of the records, the index offset or the file size */
+    uint64_t offset_ = CAPTURE_HEADER_SIZE;
+    uint64_t number_ = 0;
+    std::vector<CaptureIndexEntry> index_;
+};
+
+} // namespace esp_ncp
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "esp_ncp/capture.hpp"
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/request.hpp"
+#include "esp_ncp/transport.hpp"
+
+namespace esp_ncp {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Why a request completed without a response.
+ *
+ */
+enum class Error : uint8_t {
+    None = 0,                                   /*!< The response arrived */
+    Timeout,                                    /*!< No response within the timeout, the sn is released */
+    Disconnected,                               /*!< The transport closed or failed, or the client is closed */
+};
+
+const char *error_name(Error error);
+
+/**
+ * @brief The response of a request, the payload is copied out of the receive buffer.
+ *
+ */
+struct Response {
+    Error error = Error::None;                  /*!< Error::None if the response arrived */
+    Header header;                              /*!< The response header */
+    Bytes payload;                              /*!< The response payload */
+    Clock::duration latency{};                  /*!< From the request written to the transport to the response decoded */
+
+    bool ok() const { return error == Error::None; }
+
+    /** The status byte which starts most responses, refer to esp_ncp_status_t, 0xFF if there is none */
+    uint8_t status() const { return payload.empty() ? 0xFF : payload[0]; }
+
+    Reader reader() const { return Reader(payload.data(), payload.size()); }
+};
+
+/**
+ * @brief The response callback, frame is nullptr unless error is Error::None.
+ *
+ * @note The callbacks run on the thread of the client, they must not block.
+ */
+using ResponseCallback = std::function<void(Error error, const FrameView *frame, Clock::duration latency)>;
+
+/**
+ * @brief The notification callback, also called for the error frames (frame_id::ERROR) of the NCP.
+ *
+ */
+using NotifyCallback = std::function<void(const FrameView &frame)>;
+
+/**
+ * @brief The options of the client.
+ *
+ */
+struct ClientOptions {
+    size_t window = 32;                         /*!< The maximum requests in flight, at most 256 as the sn is 8 bits */
+    std::chrono::milliseconds timeout{3000};    /*!< The default response timeout */
+    uint8_t version = 0;                        /*!< The protocol version of the request headers */
+    std::shared_ptr<CaptureWriter> capture;     /*!< Records every frame sent and received if set, written by the client thread */
+};
+
+/**
+ * @brief An asynchronous client of the NCP.
+ *
+ * Any thread may submit requests, the client thread assigns the sn, writes them to the transport
+ * back to back up to the window, matches the responses by sn and completes them as they arrive,
+ * in any order. The requests over the window wait in a queue in submission order.
+ */
+class Client {
+public:
+    /**
+     * @brief The counters of the client.
+     *
+     */
+    struct Stats {
+        uint64_t requests = 0;                  /*!< The requests written */
+        uint64_t responses = 0;                 /*!< The responses matched to a request */
+        uint64_t timeouts = 0;                  /*!< The requests timed out */
+        uint64_t notifications = 0;             /*!< The notifications received, error frames included */
+        uint64_t unmatched = 0;                 /*!< The responses with no request of that sn and id in flight */
+        uint64_t tx_bytes = 0;                  /*!< The bytes written to the transport */
+        FrameDecoder::Stats rx;                 /*!< The counters of the decoder */
+    };
+
+    static constexpr uint16_t ANY_ID = 0xFFFE;  /*!< Subscribes to all notifications */
+
+    explicit Client(std::unique_ptr<Transport> transport, const ClientOptions &options = {});
+    ~Client();
+
+    Client(const Client &) = delete;
+    Client &operator=(const Client &) = delete;
+
+    /**
+     * @brief Submit a request and complete the callback with its response.
+     *
+     * @param[in] req      The request
+     * @param[in] callback Called once with the response or the error
+     * @param[in] timeout  The response timeout, zero for the default of the options
+     */
+    void request(Request req, ResponseCallback callback, std::chrono::milliseconds timeout = {});
+
+    /**
+     * @brief Submit a request and return the future of its response.
+     *
+     * @note The future never throws, a failed request has the error set in the response.
+     */
+    std::future<Response> request(Request req, std::chrono::milliseconds timeout = {});
+
+    /** Submit a request and wait for its response */
+    Response call(Request req, std::chrono::milliseconds timeout = {});
+
+    /**
+     * @brief Subscribe to the notifications of a frame ID, ANY_ID for all of them.
+     *
+     * @return The handle to unsubscribe
+     */
+    int subscribe(uint16_t id, NotifyCallback callback);
+    void unsubscribe(int handle);
+
+    /** The requests submitted and not completed yet */
+    size_t outstanding() const { return outstanding_.load(std::memory_order_relaxed); }
+
+    bool connected() const { return !closed_.load(std::memory_order_relaxed); }
+
+    Stats stats() const;
+
+    /** Stop the client thread and fail the outstanding requests with Error::Disconnected */
+    void close();
+
+private:
+    struct Pending {
+        Request req;
+        ResponseCallback callback;
+        std::chrono::milliseconds timeout;
+    };
+
+    struct Slot {
+        bool busy = false;
+        uint16_t id = 0;
+        uint32_t generation = 0;
+        Clock::time_point sent;
+        ResponseCallback callback;
+    };
+
+    struct Deadline {
+        Clock::time_point when;
+        uint8_t sn;
+        uint32_t generation;
+
+        bool operator>(const Deadline &other) const { return when > other.when; }
+    };
+
+    void run();
+    void wake();
+    void send_pending();
+    bool flush();
+    bool receive();
+    void expire(Clock::time_point now);
+    int wait_ms(Clock::time_point now) const;
+    void dispatch(const FrameView &frame);
+    void notify(const FrameView &frame);
+    void fail_all();
+
+    std::unique_ptr<Transport> transport_;
+    ClientOptions options_;
+    int epoll_fd_ = -1;
+    int event_fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> woken_{false};
+    std::atomic<size_t> outstanding_{0};
+
+    /* Shared with the submitting threads */
+    std::mutex submit_lock_;
+    std::deque<Pending> submitted_;
+
+    /* Copied on write, the client thread calls the callbacks of a snapshot without holding the lock */
+    using Subscribers = std::multimap<uint16_t, std::pair<int, NotifyCallback>>;
+    std::mutex notify_lock_;
+    std::shared_ptr<const Subscribers> subscribers_;
+    int next_handle_ = 1;
+
+    /* Owned by the client thread */
+    std::deque<Pending> waiting_;
+    Slot slots_[256];
+    size_t in_flight_ = 0;
+    uint8_t next_sn_ = 0;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    std::vector<uint8_t> tx_;
+    size_t tx_offset_ = 0;
+    bool tx_blocked_ = false;
+    FrameDecoder decoder_;
+    Bytes capture_buf_;                         /*!< The received frame encoded again for the capture */
+
+    Stats counters_;                            /*!< Updated by the client thread */
+    mutable std::mutex stats_lock_;
+    Stats stats_;                               /*!< A copy of the counters taken once per loop */
+};
+
+} // namespace esp_ncp
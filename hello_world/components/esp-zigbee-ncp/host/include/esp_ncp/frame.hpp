@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace esp_ncp {
+
+/** Definition of the frame layout, refer to esp_ncp_header_t and esp_ncp_frame.c on the NCP
+ *
+ */
+constexpr size_t HEADER_SIZE = 7;               /*!< flags (2), id (2), sn (1), len (2), little endian and packed */
+constexpr size_t CRC_SIZE = 2;                  /*!< The CRC16 following the payload */
+constexpr size_t PAYLOAD_MAX = 0xFFFF;          /*!< The length field of the header is 16 bits */
+
+constexpr uint8_t SLIP_END = 0xC0;              /*!< Start and end of every frame */
+constexpr uint8_t SLIP_ESC = 0xDB;              /*!< Escape start, one byte escaped data follows */
+constexpr uint8_t SLIP_ESC_END = 0xDC;          /*!< Following escape: the original byte is SLIP_END */
+constexpr uint8_t SLIP_ESC_ESC = 0xDD;          /*!< Following escape: the original byte is SLIP_ESC */
+
+/**
+ * @brief The frame type in the flags of the header.
+ *
+ */
+enum class FrameType : uint8_t {
+    Request = 0,                                /*!< From the host to the NCP */
+    Response = 1,                               /*!< From the NCP, answers the request with the same id and sn */
+    Notify = 2,                                 /*!< From the NCP, unsolicited or following a request */
+};
+
+/**
+ * @brief The decoded frame header.
+ *
+ */
+struct Header {
+    uint8_t version = 0;                        /*!< The protocol version */
+    FrameType type = FrameType::Request;        /*!< The frame type */
+    uint16_t id = 0;                            /*!< The frame ID, refer to frame_id.hpp */
+    uint8_t sn = 0;                             /*!< The transaction sequence number */
+    uint16_t len = 0;                           /*!< The payload length */
+};
+
+/**
+ * @brief The CRC16 of the NCP frames, same as esp_crc16_le() of ESP-IDF.
+ *
+ * @param[in] crc  The initial value, the NCP starts with UINT16_MAX
+ * @param[in] data The data
+ * @param[in] len  The length of the data
+ *
+ * @return The CRC16
+ */
+uint16_t crc16_le(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief A bounds checked little endian reader over a payload.
+ *
+ * @note A read past the end returns zero and clears ok(), the caller checks it once after parsing.
+ */
+class Reader {
+public:
+    Reader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    T get()
+    {
+        T value = 0;
+        if (!need(sizeof(T))) {
+            return value;
+        }
+        for (size_t i = 0; i < sizeof(T); i ++) {
+            value |= static_cast<T>(static_cast<uint64_t>(data_[offset_ + i]) << (8 * i));
+        }
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    /** Returns the next len bytes without copying them, nullptr on underrun */
+    const uint8_t *bytes(size_t len)
+    {
+        if (!need(len)) {
+            return nullptr;
+        }
+        const uint8_t *ptr = data_ + offset_;
+        offset_ += len;
+        return ptr;
+    }
+
+    bool ok() const { return ok_; }
+    size_t remaining() const { return size_ - offset_; }
+
+private:
+    bool need(size_t len)
+    {
+        ok_ = ok_ && (size_ - offset_ >= len);
+        return ok_;
+    }
+
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+};
+
+/**
+ * @brief A little endian writer appending to a payload.
+ *
+ */
+class Writer {
+public:
+    explicit Writer(std::vector<uint8_t> &out) : out_(out) {}
+
+    template <typename T>
+    Writer &put(T value)
+    {
+        for (size_t i = 0; i < sizeof(T); i ++) {
+            out_.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+        }
+        return *this;
+    }
+
+    Writer &bytes(const void *data, size_t len)
+    {
+        const uint8_t *ptr = static_cast<const uint8_t *>(data);
+        out_.insert(out_.end(), ptr, ptr + len);
+        return *this;
+    }
+
+    Writer &zeros(size_t len)
+    {
+        out_.insert(out_.end(), len, 0);
+        return *this;
+    }
+
+private:
+    std::vector<uint8_t> &out_;
+};
+
+/**
+ * @brief A frame decoded in place in the receive buffer.
+ *
+ * @note The view is valid until the callback it is passed to returns, copy the payload to keep it.
+ */
+struct FrameView {
+    Header header;                              /*!< The header */
+    const uint8_t *payload = nullptr;           /*!< The payload, header.len bytes */
+
+    Reader reader() const { return Reader(payload, header.len); }
+};
+
+/**
+ * @brief Append a SLIP encoded frame to the output buffer.
+ *
+ * @param[out] out     The buffer the frame is appended to, several frames may be queued in one buffer
+ * @param[in]  header  The header, the len field is taken from the payload length
+ * @param[in]  payload The payload, may be nullptr if len is 0
+ * @param[in]  len     The payload length
+ */
+void frame_encode(std::vector<uint8_t> &out, const Header &header, const uint8_t *payload, size_t len);
+
+/**
+ * @brief A streaming SLIP frame decoder.
+ *
+ * The transport reads straight into the buffer returned by prepare(), the escapes are removed in
+ * place and every complete frame is handed out as a view into the same buffer, no byte is copied.
+ */
+class FrameDecoder {
+public:
+    /**
+     * @brief The counters of the decoder.
+     *
+     */
+    struct Stats {
+        uint64_t frames = 0;                    /*!< The frames decoded */
+        uint64_t bytes = 0;                     /*!< The bytes received, SLIP escapes included */
+        uint64_t crc_errors = 0;                /*!< The frames dropped by a wrong CRC */
+        uint64_t format_errors = 0;             /*!< The frames dropped by a wrong length */
+        uint64_t oversize = 0;                  /*!< The frames dropped by exceeding the buffer */
+    };
+
+    explicit FrameDecoder(size_t capacity = 2 * (HEADER_SIZE + PAYLOAD_MAX + CRC_SIZE));
+
+    /** Returns where the next read goes and how many bytes it may take */
+    uint8_t *prepare(size_t *len);
+
+    /**
+     * @brief Decode the len bytes written at prepare(), calling on_frame(const FrameView &) for every complete frame.
+     *
+     */
+    template <typename F>
+    void commit(size_t len, F &&on_frame)
+    {
+        size_t end = tail_ + len;
+
+        stats_.bytes += len;
+        for (size_t scan = tail_; scan < end; scan ++) {
+            uint8_t c = buf_[scan];
+
+            if (c == SLIP_END) {
+                if (out_ > start_ && !drop_) {
+                    FrameView frame;
+                    if (parse(&buf_[start_], out_ - start_, &frame)) {
+                        on_frame(static_cast<const FrameView &>(frame));
+                    }
+                }
+                start_ = out_ = scan + 1;
+                drop_ = false;
+                esc_ = false;
+            } else if (drop_) {
+                continue;
+            } else if (c == SLIP_ESC) {
+                esc_ = true;
+            } else {
+                if (esc_) {
+                    c = (c == SLIP_ESC_END) ? SLIP_END : (c == SLIP_ESC_ESC) ? SLIP_ESC : c;
+                    esc_ = false;
+                }
+                buf_[out_ ++] = c;
+            }
+        }
+        tail_ = end;
+        compact();
+    }
+
+    const Stats &stats() const { return stats_; }
+
+    /** Drops the partial frame, such as after the transport reconnects */
+    void reset();
+
+private:
+    bool parse(const uint8_t *data, size_t size, FrameView *frame);
+    void compact();
+
+    std::vector<uint8_t> buf_;
+    size_t start_ = 0;                          /*!< The start of the frame being decoded */
+    size_t out_ = 0;                            /*!< The end of the unescaped bytes of the frame */
+    size_t tail_ = 0;                           /*!< The end of the received bytes */
+    bool esc_ = false;
+    bool drop_ = false;
+    Stats stats_;
+};
+
+/**
+ * @brief Format a frame as one line of text for the logs.
+ *
+ */
+std::string frame_to_string(const FrameView &frame);
+
+} // namespace esp_ncp
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esp_ncp {
+
+/** Definition of the frame ID, same values as the ESP_NCP_* frame IDs in esp_ncp_zb.h on the NCP
+ *
+ */
+namespace frame_id {
+constexpr uint16_t NETWORK_INIT = 0x0000;                    /*!< Resume network operation after a reboot */
+constexpr uint16_t NETWORK_START = 0x0001;                   /*!< Start the commissioning process */
+constexpr uint16_t NETWORK_STATE = 0x0002;                   /*!< Returns a value indicating whether the node is joining, joined to, or leaving a network */
+constexpr uint16_t NETWORK_STACK_STATUS_HANDLER = 0x0003;    /*!< Notify it when the status of the stack changes */
+constexpr uint16_t NETWORK_FORMNETWORK = 0x0004;             /*!< Forms a new network by becoming the coordinator */
+constexpr uint16_t NETWORK_PERMIT_JOINING = 0x0005;          /*!< Allow other nodes to join the network with this node as their parent */
+constexpr uint16_t NETWORK_JOINNETWORK = 0x0006;             /*!< Associate with the network using the specified network parameters */
+constexpr uint16_t NETWORK_LEAVENETWORK = 0x0007;            /*!< Causes the stack to leave the current network */
+constexpr uint16_t NETWORK_START_SCAN = 0x0008;              /*!< Active scan available network */
+constexpr uint16_t NETWORK_SCAN_COMPLETE_HANDLER = 0x0009;   /*!< Signals that the scan has completed */
+constexpr uint16_t NETWORK_STOP_SCAN = 0x000A;               /*!< Terminates a scan in progress */
+constexpr uint16_t NETWORK_PAN_ID_GET = 0x000B;              /*!< Get the Zigbee network PAN ID */
+constexpr uint16_t NETWORK_PAN_ID_SET = 0x000C;              /*!< Set the Zigbee network PAN ID */
+constexpr uint16_t NETWORK_EXTENDED_PAN_ID_GET = 0x000D;     /*!< Get the Zigbee network extended PAN ID */
+constexpr uint16_t NETWORK_EXTENDED_PAN_ID_SET = 0x000E;     /*!< Set the Zigbee network extended PAN ID */
+constexpr uint16_t NETWORK_PRIMARY_CHANNEL_GET = 0x000F;     /*!< Get the primary channel mask */
+constexpr uint16_t NETWORK_PRIMARY_CHANNEL_SET = 0x0010;     /*!< Set the primary channel mask */
+constexpr uint16_t NETWORK_SECONDARY_CHANNEL_GET = 0x0011;   /*!< Get the secondary channel mask */
+constexpr uint16_t NETWORK_SECONDARY_CHANNEL_SET = 0x0012;   /*!< Set the secondary channel mask */
+constexpr uint16_t NETWORK_CHANNEL_GET = 0x0013;             /*!< Get the 2.4G channel */
+constexpr uint16_t NETWORK_CHANNEL_SET = 0x0014;             /*!< Set the 2.4G channel mask */
+constexpr uint16_t NETWORK_TXPOWER_GET = 0x0015;             /*!< Get the tx power */
+constexpr uint16_t NETWORK_TXPOWER_SET = 0x0016;             /*!< Set the tx power */
+constexpr uint16_t NETWORK_PRIMARY_KEY_GET = 0x0017;         /*!< Get the primary security network key */
+constexpr uint16_t NETWORK_PRIMARY_KEY_SET = 0x0018;         /*!< Set the primary security network key */
+constexpr uint16_t NETWORK_FRAME_COUNT_GET = 0x0019;         /*!< Get the network frame counter */
+constexpr uint16_t NETWORK_FRAME_COUNT_SET = 0x001A;         /*!< Set the network frame counter */
+constexpr uint16_t NETWORK_ROLE_GET = 0x001B;                /*!< Get the network role 0: Coordinator, 1: Router */
+constexpr uint16_t NETWORK_ROLE_SET = 0x001C;                /*!< Set the network role 0: Coordinator, 1: Router */
+constexpr uint16_t NETWORK_SHORT_ADDRESS_GET = 0x001D;       /*!< Get the Zigbee device short address */
+constexpr uint16_t NETWORK_SHORT_ADDRESS_SET = 0x001E;       /*!< Set the Zigbee device short address */
+constexpr uint16_t NETWORK_LONG_ADDRESS_GET = 0x001F;        /*!< Get the Zigbee device long address */
+constexpr uint16_t NETWORK_LONG_ADDRESS_SET = 0x0020;        /*!< Set the Zigbee device long address */
+constexpr uint16_t NETWORK_CHANNEL_MASKS_GET = 0x0021;       /*!< Get the channel masks */
+constexpr uint16_t NETWORK_CHANNEL_MASKS_SET = 0x0022;       /*!< Set the channel masks */
+constexpr uint16_t NETWORK_UPDATE_ID_GET = 0x0023;           /*!< Get the network update ID */
+constexpr uint16_t NETWORK_UPDATE_ID_SET = 0x0024;           /*!< Set the network update ID */
+constexpr uint16_t NETWORK_TRUST_CENTER_ADDR_GET = 0x0025;   /*!< Get the network trust center address */
+constexpr uint16_t NETWORK_TRUST_CENTER_ADDR_SET = 0x0026;   /*!< Set the network trust center address */
+constexpr uint16_t NETWORK_LINK_KEY_GET = 0x0027;            /*!< Get the network link key */
+constexpr uint16_t NETWORK_LINK_KEY_SET = 0x0028;            /*!< Set the network link key */
+constexpr uint16_t NETWORK_SECURE_MODE_GET = 0x0029;         /*!< Get the network security mode */
+constexpr uint16_t NETWORK_SECURE_MODE_SET = 0x002A;         /*!< Set the network security mode */
+constexpr uint16_t NETWORK_PREDEFINED_PANID = 0x002B;        /*!< Enable or disable predefined network panid */
+constexpr uint16_t NETWORK_SHORT_TO_IEEE = 0x002C;           /*!< Get the network IEEE address by the short address */
+constexpr uint16_t NETWORK_IEEE_TO_SHORT = 0x002D;           /*!< Get the network short address by the IEEE address */
+constexpr uint16_t NETWORK_SCAN_RESULT = 0x002E;             /*!< The networks found on one channel of a streamed scan */
+constexpr uint16_t NETWORK_NEIGHBOR_TABLE_GET = 0x002F;      /*!< Export the network neighbor table */
+constexpr uint16_t NETWORK_ROUTE_TABLE_GET = 0x0030;         /*!< Export the network routing table */
+constexpr uint16_t NETWORK_ROUTE_RECORD_TABLE_GET = 0x0031;  /*!< Export the network route record table */
+constexpr uint16_t NETWORK_SIGNAL_SUBSCRIBE = 0x0032;        /*!< Set the bitmap of the stack signals forwarded to the host */
+constexpr uint16_t NETWORK_SIGNAL = 0x0033;                  /*!< Notify the host of a subscribed stack signal with its raw parameters */
+constexpr uint16_t NETWORK_JOIN_BATCH = 0x0034;              /*!< Notify the host of a deduplicated batch of device announce and leave events */
+constexpr uint16_t NETWORK_JOIN_BATCH_CONFIG = 0x0035;       /*!< Configure the batching of the device announce and leave events */
+constexpr uint16_t NETWORK_IC_ADD_BULK = 0x0036;             /*!< Add the install codes of a list of devices */
+constexpr uint16_t NETWORK_IC_REMOVE_BULK = 0x0037;          /*!< Remove the install codes of a list of devices */
+constexpr uint16_t ZCL_ENDPOINT_ADD = 0x0100;                /*!< Configures endpoint information on the NCP */
+constexpr uint16_t ZCL_ENDPOINT_DEL = 0x0101;                /*!< Remove endpoint information on the NCP */
+constexpr uint16_t ZCL_ATTR_READ = 0x0102;                   /*!< Read attribute data on NCP endpoints */
+constexpr uint16_t ZCL_ATTR_WRITE = 0x0103;                  /*!< Write attribute data on NCP endpoints */
+constexpr uint16_t ZCL_ATTR_REPORT = 0x0104;                 /*!< Report attribute data on NCP endpoints */
+constexpr uint16_t ZCL_ATTR_DISC = 0x0105;                   /*!< Discover attribute data on NCP endpoints */
+constexpr uint16_t ZCL_READ = 0x0106;                        /*!< Read APS on NCP endpoints */
+constexpr uint16_t ZCL_WRITE = 0x0107;                       /*!< Write APS on NCP endpoints */
+constexpr uint16_t ZCL_REPORT_CONFIG = 0x0108;               /*!< Report configure on NCP endpoints */
+constexpr uint16_t ZCL_ATTR_READ_BULK = 0x0109;              /*!< Read the same attributes from a list of devices */
+constexpr uint16_t ZCL_SCHED_CONFIG = 0x010A;                /*!< Configure the air-time scheduler of the ZCL requests */
+constexpr uint16_t ZCL_SCHED_STATS = 0x010B;                 /*!< Get the queue depth and drop statistics of the air-time scheduler */
+constexpr uint16_t ZCL_WRITE_MULTI = 0x010C;                 /*!< Send the same cluster command to a list of devices, consolidated into a groupcast */
+constexpr uint16_t ZCL_GROUPCAST_STATS = 0x010D;             /*!< Get the air-time saved by the groupcast consolidation */
+constexpr uint16_t ZCL_RULE_ADD = 0x010E;                    /*!< Install or replace a local automation rule */
+constexpr uint16_t ZCL_RULE_DEL = 0x010F;                    /*!< Remove a local automation rule */
+constexpr uint16_t ZCL_RULE_STATS = 0x0110;                  /*!< Get the execution counters and latency histogram of a rule */
+constexpr uint16_t ZCL_RULE_FIRED = 0x0111;                  /*!< Notify the host a rule ran its action */
+constexpr uint16_t ZCL_TIMER_ADD = 0x0112;                   /*!< Queue a command until a relative or absolute deadline */
+constexpr uint16_t ZCL_TIMER_CANCEL = 0x0113;                /*!< Cancel a queued command */
+constexpr uint16_t ZCL_TIMER_LIST = 0x0114;                  /*!< List the queued commands */
+constexpr uint16_t ZCL_TIMER_STATS = 0x0115;                 /*!< Get the firing jitter statistics of the queued commands */
+constexpr uint16_t ZDO_BIND_SET = 0x0200;                    /*!< Create a binding between two endpoints on two nodes */
+constexpr uint16_t ZDO_UNBIND_SET = 0x0201;                  /*!< Remove a binding between two endpoints on two nodes */
+constexpr uint16_t ZDO_FIND_MATCH = 0x0202;                  /*!< Send match desc request to find matched Zigbee device */
+constexpr uint16_t ZDO_INTERROGATE_CONFIG = 0x0203;          /*!< Configure the device interrogation on the NCP */
+constexpr uint16_t ZDO_INTERROGATE = 0x0204;                 /*!< Interrogate the node, active endpoint and simple descriptors of a list of devices */
+constexpr uint16_t ZDO_DEVICE_PROFILE = 0x0205;              /*!< The consolidated descriptors of one interrogated device */
+constexpr uint16_t APS_DATA_REQUEST = 0x0300;                /*!< Request the aps data */
+constexpr uint16_t APS_DATA_INDICATION = 0x0301;             /*!< Indication the aps data */
+constexpr uint16_t APS_DATA_CONFIRM = 0x0302;                /*!< Confirm the aps data */
+constexpr uint16_t APS_DATA_REQUEST_BULK = 0x0303;           /*!< Request the same aps data to a list of destinations and confirm them in one frame */
+constexpr uint16_t ERROR = 0xFFFF;                           /*!< The response to a frame the NCP failed to decode, the sn is random */
+
+/* Handled by esp_ncp_muxd itself, never sent to the NCP */
+constexpr uint16_t MUX_FILTER_SET = 0xFF00;                  /*!< Set the notifications the daemon forwards to this client */
+constexpr uint16_t MUX_STATS = 0xFF01;                       /*!< Get the counters of the daemon and of this client */
+constexpr uint16_t MUX_DROPPED = 0xFF02;                     /*!< Notify the client its queue overflowed and notifications were dropped */
+} // namespace frame_id
+
+/** The status byte which starts the responses, same values as esp_ncp_status_t */
+namespace status {
+constexpr uint8_t SUCCESS = 0x00;                            /*!< The generic 'no error' */
+constexpr uint8_t ERR_FATAL = 0x01;                          /*!< The generic 'fatal error' */
+constexpr uint8_t BAD_ARGUMENT = 0x02;                       /*!< An invalid value was passed as an argument */
+constexpr uint8_t ERR_NO_MEM = 0x03;                         /*!< Out of memory */
+} // namespace status
+
+/**
+ * @brief Get the name of a frame ID, such as "ZCL_ATTR_READ".
+ *
+ * @param[in] id The frame ID
+ *
+ * @return The name, "UNKNOWN" for an unknown ID
+ */
+const char *frame_id_name(uint16_t id);
+
+} // namespace esp_ncp
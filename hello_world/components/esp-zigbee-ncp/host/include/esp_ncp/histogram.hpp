@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace esp_ncp {
+
+/**
+ * @brief A latency histogram with the bucket layout of HdrHistogram.
+ *
+ * The values are kept to the given number of significant decimal digits over the whole range, the
+ * buckets double in size and each holds the same number of linear sub-buckets. Recording is a
+ * couple of shifts and an increment, so it is cheap enough for every response.
+ */
+class Histogram {
+public:
+    /**
+     * @param[in] highest             The highest value recorded, the higher ones are clamped to it
+     * @param[in] significant_digits  The decimal digits of precision, 1 to 5
+     */
+    explicit Histogram(uint64_t highest = 60000000000ULL, int significant_digits = 3);
+
+    void record(uint64_t value, uint64_t count = 1);
+    void merge(const Histogram &other);
+    void reset();
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const;
+    uint64_t max() const;
+    double mean() const;
+    double stddev() const;
+
+    /** The value at or below which the given percentile, 0 to 100, of the recorded values fall */
+    uint64_t value_at(double percentile) const;
+
+    /**
+     * @brief Print the percentile distribution in the text format of HdrHistogram, which its plotters read.
+     *
+     * @param[in] out             The output
+     * @param[in] scale           The values are divided by it, e.g. 1000 to print ns as us
+     * @param[in] ticks_per_half  The lines per halving of the distance to 100%
+     */
+    void print_percentiles(FILE *out, double scale = 1.0, uint32_t ticks_per_half = 5) const;
+
+private:
+    size_t index_of(uint64_t value) const;
+    uint64_t value_of(size_t index) const;
+    uint64_t lowest_equivalent(uint64_t value) const;
+    uint64_t highest_equivalent(uint64_t value) const;
+    uint64_t median_equivalent(uint64_t value) const;
+
+    uint64_t highest_;
+    uint32_t sub_bucket_count_;                 /*!< The linear sub-buckets per bucket, a power of 2 */
+    uint32_t sub_bucket_half_count_;
+    uint32_t sub_bucket_half_magnitude_;
+    uint64_t sub_bucket_mask_;
+    uint32_t bucket_count_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+} // namespace esp_ncp
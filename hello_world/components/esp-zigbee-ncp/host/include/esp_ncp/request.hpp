@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "esp_ncp/frame_id.hpp"
+
+namespace esp_ncp {
+
+using IeeeAddr = std::array<uint8_t, 8>;        /*!< The long address, little endian as on air */
+using Key = std::array<uint8_t, 16>;            /*!< A network or link key */
+using Bytes = std::vector<uint8_t>;
+
+/**
+ * @brief A request frame ready to be sent, the sn is allocated by the client.
+ *
+ */
+struct Request {
+    uint16_t id = 0;                            /*!< The frame ID, refer to frame_id.hpp */
+    Bytes payload;                              /*!< The payload as the NCP parses it */
+};
+
+/**
+ * @brief The APS addressing modes, same values as esp_zb_aps_address_mode_t.
+ *
+ */
+enum class AddrMode : uint8_t {
+    None = 0x00,                                /*!< Neither the address nor the endpoint is present, the binding table is used */
+    Group = 0x01,                               /*!< A 16-bit group address, no endpoint */
+    Short = 0x02,                               /*!< A 16-bit short address and an endpoint */
+    Ieee = 0x03,                                /*!< A 64-bit long address and an endpoint */
+};
+
+/**
+ * @brief The destination of a ZCL or APS request, the esp_zb_zcl_basic_cmd_t and address mode on the NCP.
+ *
+ */
+struct Destination {
+    AddrMode mode = AddrMode::Short;            /*!< The addressing mode */
+    uint16_t short_addr = 0;                    /*!< The short or group address, if the mode is not Ieee */
+    IeeeAddr ieee_addr{};                       /*!< The long address, if the mode is Ieee */
+    uint8_t dst_endpoint = 1;                   /*!< The destination endpoint */
+    uint8_t src_endpoint = 1;                   /*!< The source endpoint on the NCP */
+
+    static Destination device(uint16_t short_addr, uint8_t dst_endpoint, uint8_t src_endpoint = 1)
+    {
+        Destination dst;
+        dst.short_addr = short_addr;
+        dst.dst_endpoint = dst_endpoint;
+        dst.src_endpoint = src_endpoint;
+        return dst;
+    }
+
+    static Destination group(uint16_t group_id, uint8_t src_endpoint = 1)
+    {
+        Destination dst;
+        dst.mode = AddrMode::Group;
+        dst.short_addr = group_id;
+        dst.dst_endpoint = 0xFF;
+        dst.src_endpoint = src_endpoint;
+        return dst;
+    }
+};
+
+/**
+ * @brief An attribute value of a ZCL write.
+ *
+ */
+struct AttrValue {
+    uint16_t id = 0;                            /*!< The attribute ID */
+    uint8_t type = 0;                           /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+    Bytes value;                                /*!< The value, little endian */
+};
+
+/**
+ * @brief A reporting record of a ZCL report configuration.
+ *
+ */
+struct ReportRecord {
+    uint16_t attr_id = 0;                       /*!< The attribute ID */
+    uint8_t attr_type = 0;                      /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+    uint16_t min_interval = 0;                  /*!< The minimum reporting interval in seconds */
+    uint16_t max_interval = 0;                  /*!< The maximum reporting interval in seconds */
+    std::array<uint8_t, 8> reportable_change{}; /*!< The minimum change which triggers a report, little endian */
+};
+
+/**
+ * @brief The batch options of the bulk ZCL requests.
+ *
+ */
+struct BulkOptions {
+    uint8_t concurrency = 0;                    /*!< The number of devices requested at the same time, 0 for the NCP default */
+    uint8_t retries = 0;                        /*!< The number of retries after a timeout */
+    uint16_t timeout_ms = 0;                    /*!< The time to wait for one device, 0 for the NCP default */
+};
+
+/**
+ * @brief A destination of a bulk APS data request.
+ *
+ */
+struct ApsBulkDestination {
+    AddrMode mode = AddrMode::Short;            /*!< The addressing mode */
+    uint16_t short_addr = 0;                    /*!< The short or group address, if the mode is not Ieee */
+    IeeeAddr ieee_addr{};                       /*!< The long address, if the mode is Ieee */
+    uint8_t dst_endpoint = 1;                   /*!< The destination endpoint */
+    uint8_t tx_options = 0;                     /*!< The transmission options, refer to esp_zb_apsde_tx_opt_t */
+};
+
+/**
+ * @brief The options of an APS data request.
+ *
+ */
+struct ApsOptions {
+    uint8_t tx_options = 0;                     /*!< The transmission options, refer to esp_zb_apsde_tx_opt_t */
+    bool use_alias = false;                     /*!< Send with the alias source address */
+    uint16_t alias_src_addr = 0;                /*!< The alias source address */
+    uint8_t alias_seq_num = 0;                  /*!< The alias sequence number */
+    uint8_t radius = 0;                         /*!< The maximum number of hops, 0 for the stack default */
+};
+
+/**
+ * @brief An install code of a device.
+ *
+ */
+struct InstallCode {
+    IeeeAddr ieee_addr{};                       /*!< The long address of the device */
+    uint8_t type = 0;                           /*!< The install code type, refer to esp_zb_secur_ic_type_t */
+    Bytes code;                                 /*!< The install code with its CRC, 8, 10, 14 or 18 bytes by type */
+};
+
+/**
+ * @brief The binding of a ZDO bind or unbind request, the esp_zb_zdo_bind_req_param_t on the NCP.
+ *
+ */
+struct Binding {
+    IeeeAddr src_address{};                     /*!< The long address of the source */
+    uint8_t src_endpoint = 1;                   /*!< The source endpoint */
+    uint16_t cluster_id = 0;                    /*!< The bound cluster on the source */
+    uint8_t dst_addr_mode = 0x03;               /*!< The destination address mode, refer to esp_zb_zdo_bind_dst_addr_mode_t */
+    uint16_t dst_short_addr = 0;                /*!< The destination group, if dst_addr_mode is a group */
+    IeeeAddr dst_ieee_addr{};                   /*!< The destination long address, if dst_addr_mode is 64 bit */
+    uint8_t dst_endpoint = 1;                   /*!< The destination endpoint */
+    uint16_t req_dst_addr = 0;                  /*!< The short address of the device the request is sent to */
+};
+
+/**
+ * @brief The typed builders of the requests, one per frame ID handled by the NCP.
+ *
+ * @note The frame IDs which are only notified by the NCP, such as ESP_NCP_APS_DATA_INDICATION as a notification, have no builder.
+ *       The reserved IDs which the NCP rejects (PERMIT_JOINING, JOINNETWORK, LEAVENETWORK) are sent with raw().
+ */
+namespace request {
+
+Request raw(uint16_t id, Bytes payload = {});
+
+/* Network */
+Request network_init();
+Request network_start(bool autostart);
+Request network_state();
+Request network_stack_status();
+Request network_form_coordinator(uint8_t max_children, bool install_code_policy = false);
+Request network_form_router(uint8_t max_children, bool install_code_policy = false);
+Request network_form_end_device(uint8_t ed_timeout, uint32_t keep_alive_ms, bool install_code_policy = false);
+Request network_start_scan(uint32_t channel_mask, uint8_t scan_duration, bool streaming = false);
+Request network_stop_scan();
+Request network_pan_id_get();
+Request network_pan_id_set(uint16_t pan_id);
+Request network_extended_pan_id_get();
+Request network_extended_pan_id_set(const IeeeAddr &extended_pan_id);
+Request network_primary_channel_get();
+Request network_primary_channel_set(uint32_t channel_mask);
+Request network_secondary_channel_set(uint32_t channel_mask);
+Request network_channel_get();
+Request network_channel_set(uint32_t channel_mask);
+Request network_channel_masks_set(uint32_t channel_mask);
+Request network_txpower_set(int8_t power);
+Request network_primary_key_get();
+Request network_primary_key_set(const Key &key);
+Request network_frame_count_get();
+Request network_frame_count_set(uint32_t frame_count);
+Request network_role_get();
+Request network_role_set(uint8_t role);
+Request network_short_address_get();
+Request network_short_address_set(uint16_t short_addr);
+Request network_long_address_get();
+Request network_long_address_set(const IeeeAddr &ieee_addr);
+Request network_update_id_get();
+Request network_update_id_set(uint8_t update_id);
+Request network_trust_center_addr_get();
+Request network_trust_center_addr_set(const IeeeAddr &ieee_addr);
+Request network_link_key_get();
+Request network_link_key_set(const Key &key);
+Request network_secure_mode_get();
+Request network_secure_mode_set(uint8_t mode);
+Request network_predefined_panid(bool enable);
+Request network_short_to_ieee(uint16_t short_addr);
+Request network_ieee_to_short(const IeeeAddr &ieee_addr);
+Request network_neighbor_table_get(uint32_t known_generation = 0);
+Request network_route_table_get(uint32_t known_generation = 0);
+Request network_route_record_table_get(uint32_t known_generation = 0);
+Request network_signal_subscribe(uint64_t signal_mask);
+Request network_join_batch_config(bool enable, uint8_t max_records = 0, uint16_t flush_ms = 0);
+Request network_ic_add_bulk(const std::vector<InstallCode> &codes);
+Request network_ic_remove_bulk(const std::vector<IeeeAddr> &devices);
+
+/* ZCL */
+Request zcl_endpoint_add(uint8_t endpoint, uint16_t profile_id, uint16_t device_id, const std::vector<uint16_t> &in_clusters,
+                         const std::vector<uint16_t> &out_clusters, uint8_t app_flags = 0);
+Request zcl_endpoint_del(uint8_t endpoint);
+Request zcl_attr_read(const Destination &dst, uint16_t cluster_id, const std::vector<uint16_t> &attr_ids);
+Request zcl_attr_write(const Destination &dst, uint16_t cluster_id, const std::vector<AttrValue> &attrs);
+Request zcl_attr_report(const Destination &dst, uint16_t cluster_id, uint16_t attr_id, uint8_t direction = 0, uint16_t manuf_code = 0);
+Request zcl_attr_disc(const Destination &dst, uint16_t cluster_id, uint16_t start_attr_id, uint8_t max_attr_number,
+                      uint8_t direction = 0, uint16_t manuf_code = 0);
+Request zcl_write(const Destination &dst, uint16_t profile_id, uint16_t cluster_id, uint16_t cmd_id, uint8_t direction,
+                  uint8_t type, const Bytes &value);
+Request zcl_report_config(const Destination &dst, uint16_t cluster_id, const std::vector<ReportRecord> &records,
+                          const std::vector<uint16_t> &devices = {}, const BulkOptions &bulk = {});
+Request zcl_attr_read_bulk(uint8_t src_endpoint, uint8_t dst_endpoint, uint16_t cluster_id, const std::vector<uint16_t> &attr_ids,
+                           const std::vector<uint16_t> &devices, const BulkOptions &bulk = {});
+Request zcl_sched_config(bool enable, uint16_t rate = 0, uint16_t burst = 0, uint16_t dst_gap_ms = 0, uint16_t hop_gap_ms = 0);
+Request zcl_sched_stats(bool reset = false);
+Request zcl_write_multi(uint8_t src_endpoint, uint8_t dst_endpoint, uint16_t profile_id, uint16_t cluster_id, uint16_t cmd_id,
+                        uint8_t direction, uint8_t type, const Bytes &value, const std::vector<uint16_t> &devices);
+Request zcl_groupcast_stats();
+Request zcl_rule_add(uint8_t rule_id, uint8_t flags, uint8_t trigger, uint16_t src_addr, uint8_t src_endpoint, uint16_t cluster_id,
+                     uint16_t attr_id, const Bytes &code, const Bytes &action);
+Request zcl_rule_del(uint8_t rule_id);
+Request zcl_rule_stats(uint8_t rule_id, bool reset = false);
+Request zcl_timer_add(bool absolute, uint32_t deadline, uint32_t utc_now, uint32_t period_ms, const Bytes &action);
+Request zcl_timer_cancel(uint32_t timer_id);
+Request zcl_timer_list(uint16_t start = 0);
+Request zcl_timer_stats(bool reset = false);
+
+/* ZDO */
+Request zdo_bind_set(const Binding &binding, uint32_t user_cb = 0, uint32_t user_ctx = 0);
+Request zdo_unbind_set(const Binding &binding, uint32_t user_cb = 0, uint32_t user_ctx = 0);
+Request zdo_find_match(uint16_t dst_nwk_addr, uint16_t addr_of_interest, uint16_t profile_id, const std::vector<uint16_t> &in_clusters,
+                       const std::vector<uint16_t> &out_clusters, uint32_t user_cb = 0, uint32_t user_ctx = 0);
+Request zdo_interrogate_config(bool auto_enable, uint8_t concurrency = 0, uint8_t retries = 0);
+Request zdo_interrogate(const std::vector<uint16_t> &devices);
+
+/* APS */
+Request aps_data_request(const Destination &dst, uint16_t profile_id, uint16_t cluster_id, const Bytes &asdu, const ApsOptions &options = {});
+Request aps_data_indication_poll();
+Request aps_data_confirm_poll();
+Request aps_data_request_bulk(uint8_t src_endpoint, uint16_t profile_id, uint16_t cluster_id, const std::vector<ApsBulkDestination> &dsts,
+                              const Bytes &asdu, uint8_t radius = 0, uint16_t pacing_ms = 0);
+
+/* esp_ncp_muxd, answered by the daemon */
+Request mux_filter_set(bool forward_all, const std::vector<uint16_t> &except = {});
+Request mux_stats();
+
+} // namespace request
+
+} // namespace esp_ncp
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <sys/types.h>
+
+namespace esp_ncp {
+
+/**
+ * @brief A non-blocking byte stream to the NCP.
+ *
+ * @note The serial port, the PTY of the Linux NCP and its Unix socket are all file descriptors,
+ *       read() and write() return -1 with errno EAGAIN when they would block.
+ */
+class Transport {
+public:
+    virtual ~Transport();
+
+    Transport(const Transport &) = delete;
+    Transport &operator=(const Transport &) = delete;
+
+    /**
+     * @brief Open a serial port, the PTY of the Linux NCP included.
+     *
+     * @param[in] path The device path
+     * @param[in] baud The baud rate, 0 leaves the port settings as they are
+     *
+     * @return The transport, throws std::system_error on failure
+     */
+    static std::unique_ptr<Transport> open_serial(const std::string &path, uint32_t baud);
+
+    /**
+     * @brief Connect to the Unix stream socket of the Linux NCP.
+     *
+     */
+    static std::unique_ptr<Transport> open_socket(const std::string &path);
+
+    /**
+     * @brief Open the path as a socket if it is one, otherwise as a serial port.
+     *
+     */
+    static std::unique_ptr<Transport> open(const std::string &path, uint32_t baud = 0);
+
+    int fd() const { return fd_; }
+
+    /** The baud rate, 0 if the link is not a UART */
+    uint32_t baud() const { return baud_; }
+
+    const std::string &path() const { return path_; }
+
+    virtual ssize_t read(uint8_t *data, size_t len);
+    virtual ssize_t write(const uint8_t *data, size_t len);
+
+protected:
+    Transport(int fd, std::string path, uint32_t baud);
+
+private:
+    int fd_;
+    std::string path_;
+    uint32_t baud_;
+};
+
+} // namespace esp_ncp
@@ -0,0 +1,2485 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by wire/esp_ncp_wire_gen.py from wire/esp_ncp_wire.json, do not edit */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/frame_id.hpp"
+#include "esp_ncp/request.hpp"
+
+namespace esp_ncp {
+namespace wire {
+
+/**
+ * @brief A short or long address, esp_zb_addr_u on the wire.
+ *
+ */
+struct Addr {
+    std::array<uint8_t, 8> bytes{};                 /*!< The long address, or the short address in the first 2 bytes */
+
+    static constexpr size_t fixed_size = 8;
+
+    static constexpr Addr from_short(uint16_t short_addr)
+    {
+        Addr addr;
+        addr.bytes[0] = static_cast<uint8_t>(short_addr);
+        addr.bytes[1] = static_cast<uint8_t>(short_addr >> 8);
+        return addr;
+    }
+
+    static constexpr Addr from_long(const IeeeAddr &ieee_addr)
+    {
+        Addr addr;
+        addr.bytes = ieee_addr;
+        return addr;
+    }
+
+    constexpr uint16_t short_addr() const { return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8)); }
+
+    void decode(Reader &r)
+    {
+        const uint8_t *data = r.bytes(bytes.size());
+        for (size_t i = 0; data && i < bytes.size(); i ++) {
+            bytes[i] = data[i];
+        }
+    }
+
+    void encode(Writer &w) const { w.bytes(bytes.data(), bytes.size()); }
+
+    void get(const uint8_t *buf)
+    {
+        for (size_t i = 0; i < bytes.size(); i ++) {
+            bytes[i] = buf[i];
+        }
+    }
+};
+
+/* The count of a list or byte field, which must fit its field on the wire */
+template <typename T>
+T wire_count(size_t size)
+{
+    if (size > std::numeric_limits<T>::max()) {
+        throw std::length_error("esp_ncp::wire: too many elements for the count field");
+    }
+    return static_cast<T>(size);
+}
+
+/* A little endian load of the views, the length is checked before */
+template <typename T>
+inline T load(const uint8_t *buf)
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i ++) {
+        value |= static_cast<T>(static_cast<uint64_t>(buf[i]) << (8 * i));
+    }
+    return value;
+}
+
+/**
+ * @brief The bytes of a field in the decoded buffer.
+ *
+ */
+struct ByteView {
+    const uint8_t *data = nullptr;                  /*!< The first byte, in the decoded buffer */
+    size_t len = 0;                                 /*!< The number of bytes */
+
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const uint8_t *begin() const { return data; }
+    const uint8_t *end() const { return data + len; }
+    uint8_t operator[](size_t i) const { return data[i]; }
+    Bytes bytes() const { return Bytes(begin(), end()); }
+};
+
+/**
+ * @brief A list of little endian values in the decoded buffer.
+ *
+ */
+template <typename T>
+struct ValueView {
+    class iterator {
+    public:
+        explicit iterator(const uint8_t *data) : data_(data) {}
+        T operator*() const { return load<T>(data_); }
+        iterator &operator++() { data_ += sizeof(T); return *this; }
+        bool operator!=(const iterator &other) const { return data_ != other.data_; }
+
+    private:
+        const uint8_t *data_;
+    };
+
+    const uint8_t *data = nullptr;                  /*!< The first value, in the decoded buffer */
+    size_t count = 0;                               /*!< The number of values */
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T operator[](size_t i) const { return load<T>(data + i * sizeof(T)); }
+    iterator begin() const { return iterator(data); }
+    iterator end() const { return iterator(data + count * sizeof(T)); }
+};
+
+/**
+ * @brief A list of records in the decoded buffer, each one decoded as the iteration reaches it.
+ *
+ * @note The records were checked when the payload was decoded.
+ */
+template <typename T>
+struct RecordView {
+    class iterator {
+    public:
+        iterator(const uint8_t *data, size_t len, size_t left) : data_(data), len_(len), left_(left) { next(); }
+        const T &operator*() const { return record_; }
+        const T *operator->() const { return &record_; }
+        iterator &operator++()
+        {
+            data_ += used_;
+            len_ -= used_;
+            left_ --;
+            next();
+            return *this;
+        }
+        bool operator!=(const iterator &other) const { return left_ != other.left_; }
+
+    private:
+        void next() { used_ = left_ ? record_.get(data_, len_) : 0; }
+
+        const uint8_t *data_;
+        size_t len_;
+        size_t left_;
+        size_t used_ = 0;
+        T record_;
+    };
+
+    const uint8_t *data = nullptr;                  /*!< The first record, in the decoded buffer */
+    size_t len = 0;                                 /*!< The bytes of the records */
+    size_t count = 0;                               /*!< The number of records */
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    iterator begin() const { return iterator(data, len, count); }
+    iterator end() const { return iterator(nullptr, 0, 0); }
+};
+
+/**
+ * @brief The status response of most requests.
+ * @note The response of frame_id::NETWORK_SIGNAL_SUBSCRIBE.
+ * @note The response of frame_id::NETWORK_JOIN_BATCH_CONFIG.
+ * @note The response of frame_id::ZCL_ATTR_READ_BULK.
+ * @note The response of frame_id::ZCL_SCHED_CONFIG.
+ * @note The response of frame_id::ZCL_RULE_ADD.
+ * @note The response of frame_id::ZCL_RULE_DEL.
+ * @note The response of frame_id::ZCL_TIMER_CANCEL.
+ * @note The response of frame_id::ZDO_INTERROGATE_CONFIG.
+ * @note The response of frame_id::ZDO_INTERROGATE.
+ * @note The response of frame_id::APS_DATA_REQUEST.
+ * @note The response of frame_id::APS_DATA_REQUEST_BULK.
+ *
+ */
+struct Status {
+    static constexpr size_t fixed_size = 1;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t status = 0;
+    };
+
+    uint8_t status = 0;                                 /*!< The status, refer to esp_ncp_status_t */
+
+    bool decode(Reader &r)
+    {
+        status = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(status);
+    }
+
+    using View = Status;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 1) {
+            return 0;
+        }
+        status = buf[pos];
+        pos += 1;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief The status response of the ZCL requests.
+ * @note The response of frame_id::ZCL_ATTR_READ.
+ * @note The response of frame_id::ZCL_ATTR_WRITE.
+ * @note The response of frame_id::ZCL_WRITE.
+ * @note The response of frame_id::ZCL_REPORT_CONFIG.
+ *
+ */
+struct StatusTsn {
+    static constexpr size_t fixed_size = 2;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t status = 0;
+        static constexpr size_t tsn = 1;
+    };
+
+    uint8_t status = 0;                                 /*!< The status, refer to esp_ncp_status_t */
+    uint8_t tsn = 0;                                    /*!< The ZCL transaction sequence number of the command */
+
+    bool decode(Reader &r)
+    {
+        status = r.get<uint8_t>();
+        tsn = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(status);
+        w.put<uint8_t>(tsn);
+    }
+
+    using View = StatusTsn;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 2) {
+            return 0;
+        }
+        status = buf[pos];
+        tsn = buf[pos + 1];
+        pos += 2;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief esp_zb_zcl_basic_cmd_t.
+ *
+ */
+struct ZclBasicCmd {
+    static constexpr size_t fixed_size = 10;            /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t dst_addr = 0;
+        static constexpr size_t dst_endpoint = 8;
+        static constexpr size_t src_endpoint = 9;
+    };
+
+    Addr dst_addr;                                      /*!< The short or long address of the destination */
+    uint8_t dst_endpoint = 0;                           /*!< The destination endpoint */
+    uint8_t src_endpoint = 0;                           /*!< The source endpoint */
+
+    bool decode(Reader &r)
+    {
+        dst_addr.decode(r);
+        dst_endpoint = r.get<uint8_t>();
+        src_endpoint = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        dst_addr.encode(w);
+        w.put<uint8_t>(dst_endpoint);
+        w.put<uint8_t>(src_endpoint);
+    }
+
+    using View = ZclBasicCmd;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 10) {
+            return 0;
+        }
+        dst_addr.get(&buf[pos]);
+        dst_endpoint = buf[pos + 8];
+        src_endpoint = buf[pos + 9];
+        pos += 10;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief One attribute of a ZCL write.
+ *
+ */
+struct ZclAttrData {
+    static constexpr size_t fixed_size = 4;             /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t id = 0;
+        static constexpr size_t type = 2;
+        static constexpr size_t size = 3;
+    };
+
+    uint16_t id = 0;                                    /*!< The attribute ID */
+    uint8_t type = 0;                                   /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+    Bytes value;                                        /*!< The value, the size on the wire */
+
+    bool decode(Reader &r)
+    {
+        id = r.get<uint16_t>();
+        type = r.get<uint8_t>();
+        uint8_t size = r.get<uint8_t>();
+        if (const uint8_t *data = r.bytes(size)) {
+            value.assign(data, data + size);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint16_t>(id);
+        w.put<uint8_t>(type);
+        w.put<uint8_t>(wire_count<uint8_t>(value.size()));
+        w.bytes(value.data(), value.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint16_t id = 0;                                /*!< The attribute ID */
+        uint8_t type = 0;                               /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+        ByteView value;                                 /*!< The value */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t size = 0;
+
+            if (len - pos < 4) {
+                return 0;
+            }
+            id = load<uint16_t>(&buf[pos]);
+            type = buf[pos + 2];
+            size = buf[pos + 3];
+            pos += 4;
+            if (len - pos < size) {
+                return 0;
+            }
+            value.data = &buf[pos];
+            value.len = size;
+            pos += size;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Read attributes of a remote device.
+ * @note The request of frame_id::ZCL_ATTR_READ.
+ *
+ */
+struct ZclAttrRead {
+    static constexpr size_t fixed_size = 14;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t zcl_basic_cmd = 0;
+        static constexpr size_t address_mode = 10;
+        static constexpr size_t cluster_id = 11;
+        static constexpr size_t attr_number = 13;
+    };
+
+    ZclBasicCmd zcl_basic_cmd;                          /*!< Basic command info */
+    uint8_t address_mode = 0;                           /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id = 0;                            /*!< Cluster ID to read */
+    std::vector<uint16_t> attr_field;                   /*!< The attribute IDs, the attr_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        zcl_basic_cmd.decode(r);
+        address_mode = r.get<uint8_t>();
+        cluster_id = r.get<uint16_t>();
+        uint8_t attr_number = r.get<uint8_t>();
+        attr_field.clear();
+        attr_field.reserve(std::min<size_t>(attr_number, r.remaining()));
+        for (size_t i = 0; i < attr_number && r.ok(); i ++) {
+            attr_field.push_back(r.get<uint16_t>());
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        zcl_basic_cmd.encode(w);
+        w.put<uint8_t>(address_mode);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(wire_count<uint8_t>(attr_field.size()));
+        for (uint16_t value : attr_field) {
+            w.put<uint16_t>(value);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ZclBasicCmd zcl_basic_cmd;                      /*!< Basic command info */
+        uint8_t address_mode = 0;                       /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+        uint16_t cluster_id = 0;                        /*!< Cluster ID to read */
+        ValueView<uint16_t> attr_field;                 /*!< The attribute IDs */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t attr_number = 0;
+
+            if (len - pos < 14) {
+                return 0;
+            }
+            zcl_basic_cmd.get(&buf[pos], ZclBasicCmd::fixed_size);
+            address_mode = buf[pos + 10];
+            cluster_id = load<uint16_t>(&buf[pos + 11]);
+            attr_number = buf[pos + 13];
+            pos += 14;
+            if (len - pos < static_cast<size_t>(attr_number) * 2) {
+                return 0;
+            }
+            attr_field.data = &buf[pos];
+            attr_field.count = attr_number;
+            pos += static_cast<size_t>(attr_number) * 2;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Write attributes of a remote device.
+ * @note The request of frame_id::ZCL_ATTR_WRITE.
+ *
+ */
+struct ZclAttrWrite {
+    static constexpr size_t fixed_size = 14;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t zcl_basic_cmd = 0;
+        static constexpr size_t address_mode = 10;
+        static constexpr size_t cluster_id = 11;
+        static constexpr size_t attr_number = 13;
+    };
+
+    ZclBasicCmd zcl_basic_cmd;                          /*!< Basic command info */
+    uint8_t address_mode = 0;                           /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id = 0;                            /*!< Cluster ID to write */
+    std::vector<ZclAttrData> attr_field;                /*!< The attributes, the attr_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        zcl_basic_cmd.decode(r);
+        address_mode = r.get<uint8_t>();
+        cluster_id = r.get<uint16_t>();
+        uint8_t attr_number = r.get<uint8_t>();
+        attr_field.clear();
+        attr_field.reserve(std::min<size_t>(attr_number, r.remaining()));
+        for (size_t i = 0; i < attr_number && r.ok(); i ++) {
+            ZclAttrData record;
+            if (record.decode(r)) {
+                attr_field.push_back(std::move(record));
+            }
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        zcl_basic_cmd.encode(w);
+        w.put<uint8_t>(address_mode);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(wire_count<uint8_t>(attr_field.size()));
+        for (const auto &record : attr_field) {
+            record.encode(w);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ZclBasicCmd zcl_basic_cmd;                      /*!< Basic command info */
+        uint8_t address_mode = 0;                       /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+        uint16_t cluster_id = 0;                        /*!< Cluster ID to write */
+        RecordView<ZclAttrData::View> attr_field;       /*!< The attributes */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t attr_number = 0;
+
+            if (len - pos < 14) {
+                return 0;
+            }
+            zcl_basic_cmd.get(&buf[pos], ZclBasicCmd::fixed_size);
+            address_mode = buf[pos + 10];
+            cluster_id = load<uint16_t>(&buf[pos + 11]);
+            attr_number = buf[pos + 13];
+            pos += 14;
+            attr_field.data = &buf[pos];
+            attr_field.count = attr_number;
+            for (size_t i = 0; i < attr_number; i ++) {
+                ZclAttrData::View record;
+                size_t used = record.get(&buf[pos], len - pos);
+
+                if (!used) {
+                    return 0;
+                }
+                pos += used;
+            }
+            attr_field.len = static_cast<size_t>(&buf[pos] - attr_field.data);
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Send an APS data frame.
+ * @note The request of frame_id::APS_DATA_REQUEST.
+ *
+ */
+struct ApsDataRequest {
+    static constexpr size_t fixed_size = 31;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t basic_cmd = 0;
+        static constexpr size_t dst_addr_mode = 10;
+        static constexpr size_t profile_id = 11;
+        static constexpr size_t cluster_id = 13;
+        static constexpr size_t tx_options = 15;
+        static constexpr size_t use_alias = 16;
+        static constexpr size_t alias_src_addr = 17;
+        static constexpr size_t alias_seq_num = 25;
+        static constexpr size_t radius = 26;
+        static constexpr size_t asdu_length = 27;
+    };
+
+    ZclBasicCmd basic_cmd;                              /*!< Basic command info */
+    uint8_t dst_addr_mode = 0;                          /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t profile_id = 0;                            /*!< Profile id */
+    uint16_t cluster_id = 0;                            /*!< Cluster id */
+    uint8_t tx_options = 0;                             /*!< The transmission options for the ASDU to be transferred, refer to esp_zb_apsde_tx_opt_t */
+    bool use_alias = false;                             /*!< Request alias usage by NWK layer for the current frame */
+    Addr alias_src_addr;                                /*!< The source address to be used for this NSDU, if the use_alias is true */
+    uint8_t alias_seq_num = 0;                          /*!< The sequence number to be used for this NSDU, if the use_alias is true */
+    uint8_t radius = 0;                                 /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+    Bytes asdu;                                         /*!< The ASDU, the asdu_length on the wire */
+
+    bool decode(Reader &r)
+    {
+        basic_cmd.decode(r);
+        dst_addr_mode = r.get<uint8_t>();
+        profile_id = r.get<uint16_t>();
+        cluster_id = r.get<uint16_t>();
+        tx_options = r.get<uint8_t>();
+        use_alias = r.get<uint8_t>() != 0;
+        alias_src_addr.decode(r);
+        alias_seq_num = r.get<uint8_t>();
+        radius = r.get<uint8_t>();
+        uint32_t asdu_length = r.get<uint32_t>();
+        if (const uint8_t *data = r.bytes(asdu_length)) {
+            asdu.assign(data, data + asdu_length);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        basic_cmd.encode(w);
+        w.put<uint8_t>(dst_addr_mode);
+        w.put<uint16_t>(profile_id);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(tx_options);
+        w.put<uint8_t>(use_alias ? 1 : 0);
+        alias_src_addr.encode(w);
+        w.put<uint8_t>(alias_seq_num);
+        w.put<uint8_t>(radius);
+        w.put<uint32_t>(wire_count<uint32_t>(asdu.size()));
+        w.bytes(asdu.data(), asdu.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ZclBasicCmd basic_cmd;                          /*!< Basic command info */
+        uint8_t dst_addr_mode = 0;                      /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+        uint16_t profile_id = 0;                        /*!< Profile id */
+        uint16_t cluster_id = 0;                        /*!< Cluster id */
+        uint8_t tx_options = 0;                         /*!< The transmission options for the ASDU to be transferred, refer to esp_zb_apsde_tx_opt_t */
+        bool use_alias = false;                         /*!< Request alias usage by NWK layer for the current frame */
+        Addr alias_src_addr;                            /*!< The source address to be used for this NSDU, if the use_alias is true */
+        uint8_t alias_seq_num = 0;                      /*!< The sequence number to be used for this NSDU, if the use_alias is true */
+        uint8_t radius = 0;                             /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+        ByteView asdu;                                  /*!< The ASDU */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint32_t asdu_length = 0;
+
+            if (len - pos < 31) {
+                return 0;
+            }
+            basic_cmd.get(&buf[pos], ZclBasicCmd::fixed_size);
+            dst_addr_mode = buf[pos + 10];
+            profile_id = load<uint16_t>(&buf[pos + 11]);
+            cluster_id = load<uint16_t>(&buf[pos + 13]);
+            tx_options = buf[pos + 15];
+            use_alias = buf[pos + 16] != 0;
+            alias_src_addr.get(&buf[pos + 17]);
+            alias_seq_num = buf[pos + 25];
+            radius = buf[pos + 26];
+            asdu_length = load<uint32_t>(&buf[pos + 27]);
+            pos += 31;
+            if (len - pos < asdu_length) {
+                return 0;
+            }
+            asdu.data = &buf[pos];
+            asdu.len = asdu_length;
+            pos += asdu_length;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Send a cluster command to a remote device.
+ * @note The request of frame_id::ZCL_WRITE.
+ *
+ */
+struct ZclWrite {
+    static constexpr size_t fixed_size = 21;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t zcl_basic_cmd = 0;
+        static constexpr size_t address_mode = 10;
+        static constexpr size_t profile_id = 11;
+        static constexpr size_t cluster_id = 13;
+        static constexpr size_t custom_cmd_id = 15;
+        static constexpr size_t direction = 17;
+        static constexpr size_t type = 18;
+        static constexpr size_t size = 19;
+    };
+
+    ZclBasicCmd zcl_basic_cmd;                          /*!< Basic command info */
+    uint8_t address_mode = 0;                           /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t profile_id = 0;                            /*!< Profile id */
+    uint16_t cluster_id = 0;                            /*!< Cluster id */
+    uint16_t custom_cmd_id = 0;                         /*!< Custom command id */
+    uint8_t direction = 0;                              /*!< Direction of command */
+    uint8_t type = 0;                                   /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+    Bytes value;                                        /*!< The value, the size on the wire */
+
+    bool decode(Reader &r)
+    {
+        zcl_basic_cmd.decode(r);
+        address_mode = r.get<uint8_t>();
+        profile_id = r.get<uint16_t>();
+        cluster_id = r.get<uint16_t>();
+        custom_cmd_id = r.get<uint16_t>();
+        direction = r.get<uint8_t>();
+        type = r.get<uint8_t>();
+        uint16_t size = r.get<uint16_t>();
+        if (const uint8_t *data = r.bytes(size)) {
+            value.assign(data, data + size);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        zcl_basic_cmd.encode(w);
+        w.put<uint8_t>(address_mode);
+        w.put<uint16_t>(profile_id);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint16_t>(custom_cmd_id);
+        w.put<uint8_t>(direction);
+        w.put<uint8_t>(type);
+        w.put<uint16_t>(wire_count<uint16_t>(value.size()));
+        w.bytes(value.data(), value.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ZclBasicCmd zcl_basic_cmd;                      /*!< Basic command info */
+        uint8_t address_mode = 0;                       /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+        uint16_t profile_id = 0;                        /*!< Profile id */
+        uint16_t cluster_id = 0;                        /*!< Cluster id */
+        uint16_t custom_cmd_id = 0;                     /*!< Custom command id */
+        uint8_t direction = 0;                          /*!< Direction of command */
+        uint8_t type = 0;                               /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+        ByteView value;                                 /*!< The value */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint16_t size = 0;
+
+            if (len - pos < 21) {
+                return 0;
+            }
+            zcl_basic_cmd.get(&buf[pos], ZclBasicCmd::fixed_size);
+            address_mode = buf[pos + 10];
+            profile_id = load<uint16_t>(&buf[pos + 11]);
+            cluster_id = load<uint16_t>(&buf[pos + 13]);
+            custom_cmd_id = load<uint16_t>(&buf[pos + 15]);
+            direction = buf[pos + 17];
+            type = buf[pos + 18];
+            size = load<uint16_t>(&buf[pos + 19]);
+            pos += 21;
+            if (len - pos < size) {
+                return 0;
+            }
+            value.data = &buf[pos];
+            value.len = size;
+            pos += size;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Read the same attributes from a list of devices.
+ * @note The request of frame_id::ZCL_ATTR_READ_BULK.
+ *
+ */
+struct ZclAttrReadBulk {
+    static constexpr size_t fixed_size = 11;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t src_endpoint = 0;
+        static constexpr size_t dst_endpoint = 1;
+        static constexpr size_t cluster_id = 2;
+        static constexpr size_t concurrency = 4;
+        static constexpr size_t retries = 5;
+        static constexpr size_t timeout_ms = 6;
+        static constexpr size_t attr_number = 8;
+        static constexpr size_t dev_number = 9;
+    };
+
+    uint8_t src_endpoint = 0;                           /*!< Source endpoint */
+    uint8_t dst_endpoint = 0;                           /*!< Destination endpoint on every device */
+    uint16_t cluster_id = 0;                            /*!< Cluster ID to read */
+    uint8_t concurrency = 0;                            /*!< The number of devices read at the same time, 0 to use the default */
+    uint8_t retries = 0;                                /*!< The number of retries after a timeout */
+    uint16_t timeout_ms = 0;                            /*!< The time to wait for the response of one device, 0 to use the default */
+    std::vector<uint16_t> attr_field;                   /*!< The attribute IDs, the attr_number on the wire */
+    std::vector<uint16_t> dev_field;                    /*!< The short addresses of the devices, the dev_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        src_endpoint = r.get<uint8_t>();
+        dst_endpoint = r.get<uint8_t>();
+        cluster_id = r.get<uint16_t>();
+        concurrency = r.get<uint8_t>();
+        retries = r.get<uint8_t>();
+        timeout_ms = r.get<uint16_t>();
+        uint8_t attr_number = r.get<uint8_t>();
+        uint16_t dev_number = r.get<uint16_t>();
+        attr_field.clear();
+        attr_field.reserve(std::min<size_t>(attr_number, r.remaining()));
+        for (size_t i = 0; i < attr_number && r.ok(); i ++) {
+            attr_field.push_back(r.get<uint16_t>());
+        }
+        dev_field.clear();
+        dev_field.reserve(std::min<size_t>(dev_number, r.remaining()));
+        for (size_t i = 0; i < dev_number && r.ok(); i ++) {
+            dev_field.push_back(r.get<uint16_t>());
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(src_endpoint);
+        w.put<uint8_t>(dst_endpoint);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(concurrency);
+        w.put<uint8_t>(retries);
+        w.put<uint16_t>(timeout_ms);
+        w.put<uint8_t>(wire_count<uint8_t>(attr_field.size()));
+        w.put<uint16_t>(wire_count<uint16_t>(dev_field.size()));
+        for (uint16_t value : attr_field) {
+            w.put<uint16_t>(value);
+        }
+        for (uint16_t value : dev_field) {
+            w.put<uint16_t>(value);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint8_t src_endpoint = 0;                       /*!< Source endpoint */
+        uint8_t dst_endpoint = 0;                       /*!< Destination endpoint on every device */
+        uint16_t cluster_id = 0;                        /*!< Cluster ID to read */
+        uint8_t concurrency = 0;                        /*!< The number of devices read at the same time, 0 to use the default */
+        uint8_t retries = 0;                            /*!< The number of retries after a timeout */
+        uint16_t timeout_ms = 0;                        /*!< The time to wait for the response of one device, 0 to use the default */
+        ValueView<uint16_t> attr_field;                 /*!< The attribute IDs */
+        ValueView<uint16_t> dev_field;                  /*!< The short addresses of the devices */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t attr_number = 0;
+            uint16_t dev_number = 0;
+
+            if (len - pos < 11) {
+                return 0;
+            }
+            src_endpoint = buf[pos];
+            dst_endpoint = buf[pos + 1];
+            cluster_id = load<uint16_t>(&buf[pos + 2]);
+            concurrency = buf[pos + 4];
+            retries = buf[pos + 5];
+            timeout_ms = load<uint16_t>(&buf[pos + 6]);
+            attr_number = buf[pos + 8];
+            dev_number = load<uint16_t>(&buf[pos + 9]);
+            pos += 11;
+            if (len - pos < static_cast<size_t>(attr_number) * 2) {
+                return 0;
+            }
+            attr_field.data = &buf[pos];
+            attr_field.count = attr_number;
+            pos += static_cast<size_t>(attr_number) * 2;
+            if (len - pos < static_cast<size_t>(dev_number) * 2) {
+                return 0;
+            }
+            dev_field.data = &buf[pos];
+            dev_field.count = dev_number;
+            pos += static_cast<size_t>(dev_number) * 2;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Queue a command until a relative or absolute deadline.
+ * @note The request of frame_id::ZCL_TIMER_ADD.
+ *
+ */
+struct ZclTimerAdd {
+    static constexpr size_t fixed_size = 14;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t absolute = 0;
+        static constexpr size_t deadline = 1;
+        static constexpr size_t utc_now = 5;
+        static constexpr size_t period_ms = 9;
+        static constexpr size_t action_len = 13;
+    };
+
+    bool absolute = false;                              /*!< The deadline is a UTC time in seconds, otherwise a delay in milliseconds */
+    uint32_t deadline = 0;                              /*!< The deadline of the command */
+    uint32_t utc_now = 0;                               /*!< The UTC time of the host in seconds, only used with an absolute deadline */
+    uint32_t period_ms = 0;                             /*!< The period to send the command again, 0 to send it once */
+    Bytes action;                                       /*!< The command, encoded as a rule action, the action_len on the wire */
+
+    bool decode(Reader &r)
+    {
+        absolute = r.get<uint8_t>() != 0;
+        deadline = r.get<uint32_t>();
+        utc_now = r.get<uint32_t>();
+        period_ms = r.get<uint32_t>();
+        uint8_t action_len = r.get<uint8_t>();
+        if (const uint8_t *data = r.bytes(action_len)) {
+            action.assign(data, data + action_len);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(absolute ? 1 : 0);
+        w.put<uint32_t>(deadline);
+        w.put<uint32_t>(utc_now);
+        w.put<uint32_t>(period_ms);
+        w.put<uint8_t>(wire_count<uint8_t>(action.size()));
+        w.bytes(action.data(), action.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        bool absolute = false;                          /*!< The deadline is a UTC time in seconds, otherwise a delay in milliseconds */
+        uint32_t deadline = 0;                          /*!< The deadline of the command */
+        uint32_t utc_now = 0;                           /*!< The UTC time of the host in seconds, only used with an absolute deadline */
+        uint32_t period_ms = 0;                         /*!< The period to send the command again, 0 to send it once */
+        ByteView action;                                /*!< The command, encoded as a rule action */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t action_len = 0;
+
+            if (len - pos < 14) {
+                return 0;
+            }
+            absolute = buf[pos] != 0;
+            deadline = load<uint32_t>(&buf[pos + 1]);
+            utc_now = load<uint32_t>(&buf[pos + 5]);
+            period_ms = load<uint32_t>(&buf[pos + 9]);
+            action_len = buf[pos + 13];
+            pos += 14;
+            if (len - pos < action_len) {
+                return 0;
+            }
+            action.data = &buf[pos];
+            action.len = action_len;
+            pos += action_len;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief The status response of the requests which create an object.
+ * @note The response of frame_id::ZCL_TIMER_ADD.
+ *
+ */
+struct StatusId {
+    static constexpr size_t fixed_size = 5;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t status = 0;
+        static constexpr size_t id = 1;
+    };
+
+    uint8_t status = 0;                                 /*!< The status, refer to esp_ncp_status_t */
+    uint32_t id = 0;                                    /*!< The ID of the object */
+
+    bool decode(Reader &r)
+    {
+        status = r.get<uint8_t>();
+        id = r.get<uint32_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(status);
+        w.put<uint32_t>(id);
+    }
+
+    using View = StatusId;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 5) {
+            return 0;
+        }
+        status = buf[pos];
+        id = load<uint32_t>(&buf[pos + 1]);
+        pos += 5;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Subscribe to the stack signals.
+ * @note The request of frame_id::NETWORK_SIGNAL_SUBSCRIBE.
+ *
+ */
+struct NetworkSignalSubscribe {
+    static constexpr size_t fixed_size = 8;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t signal_mask = 0;
+    };
+
+    uint64_t signal_mask = 0;                           /*!< The signals forwarded to the host, bit n for the signal type n */
+
+    bool decode(Reader &r)
+    {
+        signal_mask = r.get<uint64_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint64_t>(signal_mask);
+    }
+
+    using View = NetworkSignalSubscribe;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 8) {
+            return 0;
+        }
+        signal_mask = load<uint64_t>(&buf[pos]);
+        pos += 8;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Configure the batching of the join events.
+ * @note The request of frame_id::NETWORK_JOIN_BATCH_CONFIG.
+ *
+ */
+struct NetworkJoinBatchConfig {
+    static constexpr size_t fixed_size = 4;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t enable = 0;
+        static constexpr size_t max_records = 1;
+        static constexpr size_t flush_ms = 2;
+    };
+
+    bool enable = false;                                /*!< Batch the events, otherwise every device announce is notified on its own */
+    uint8_t max_records = 0;                            /*!< The number of devices which flushes a batch, 0 to keep the current value */
+    uint16_t flush_ms = 0;                              /*!< The time a batch is held after its first event, 0 to keep the current value */
+
+    bool decode(Reader &r)
+    {
+        enable = r.get<uint8_t>() != 0;
+        max_records = r.get<uint8_t>();
+        flush_ms = r.get<uint16_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(enable ? 1 : 0);
+        w.put<uint8_t>(max_records);
+        w.put<uint16_t>(flush_ms);
+    }
+
+    using View = NetworkJoinBatchConfig;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 4) {
+            return 0;
+        }
+        enable = buf[pos] != 0;
+        max_records = buf[pos + 1];
+        flush_ms = load<uint16_t>(&buf[pos + 2]);
+        pos += 4;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief One device of a bulk install code removal.
+ *
+ */
+struct IcRemoveRecord {
+    static constexpr size_t fixed_size = 8;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t ieee_addr = 0;
+    };
+
+    Addr ieee_addr;                                     /*!< The long address of the device */
+
+    bool decode(Reader &r)
+    {
+        ieee_addr.decode(r);
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        ieee_addr.encode(w);
+    }
+
+    using View = IcRemoveRecord;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 8) {
+            return 0;
+        }
+        ieee_addr.get(&buf[pos]);
+        pos += 8;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Remove the install codes of a list of devices.
+ * @note The request of frame_id::NETWORK_IC_REMOVE_BULK.
+ *
+ */
+struct NetworkIcRemoveBulk {
+    static constexpr size_t fixed_size = 2;             /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t count = 0;
+    };
+
+    std::vector<IcRemoveRecord> records;                /*!< The devices, the count on the wire */
+
+    bool decode(Reader &r)
+    {
+        uint16_t count = r.get<uint16_t>();
+        records.clear();
+        records.reserve(std::min<size_t>(count, r.remaining()));
+        for (size_t i = 0; i < count && r.ok(); i ++) {
+            IcRemoveRecord record;
+            if (record.decode(r)) {
+                records.push_back(std::move(record));
+            }
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint16_t>(wire_count<uint16_t>(records.size()));
+        for (const auto &record : records) {
+            record.encode(w);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        RecordView<IcRemoveRecord::View> records;       /*!< The devices */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint16_t count = 0;
+
+            if (len - pos < 2) {
+                return 0;
+            }
+            count = load<uint16_t>(&buf[pos]);
+            pos += 2;
+            records.data = &buf[pos];
+            records.count = count;
+            for (size_t i = 0; i < count; i ++) {
+                IcRemoveRecord::View record;
+                size_t used = record.get(&buf[pos], len - pos);
+
+                if (!used) {
+                    return 0;
+                }
+                pos += used;
+            }
+            records.len = static_cast<size_t>(&buf[pos] - records.data);
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief One reporting record of a report configuration.
+ *
+ */
+struct ZclReportRecord {
+    static constexpr size_t fixed_size = 15;            /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t attr_id = 0;
+        static constexpr size_t attr_type = 2;
+        static constexpr size_t min_interval = 3;
+        static constexpr size_t max_interval = 5;
+        static constexpr size_t reportable_change = 7;
+    };
+
+    uint16_t attr_id = 0;                               /*!< Attribute ID to report */
+    uint8_t attr_type = 0;                              /*!< Attribute type to report, refer to esp_zb_zcl_attr_type_t */
+    uint16_t min_interval = 0;                          /*!< Minimum reporting interval */
+    uint16_t max_interval = 0;                          /*!< Maximum reporting interval */
+    uint64_t reportable_change = 0;                     /*!< Minimum change to attribute will result in report, in the size of the attribute type */
+
+    bool decode(Reader &r)
+    {
+        attr_id = r.get<uint16_t>();
+        attr_type = r.get<uint8_t>();
+        min_interval = r.get<uint16_t>();
+        max_interval = r.get<uint16_t>();
+        reportable_change = r.get<uint64_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint16_t>(attr_id);
+        w.put<uint8_t>(attr_type);
+        w.put<uint16_t>(min_interval);
+        w.put<uint16_t>(max_interval);
+        w.put<uint64_t>(reportable_change);
+    }
+
+    using View = ZclReportRecord;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 15) {
+            return 0;
+        }
+        attr_id = load<uint16_t>(&buf[pos]);
+        attr_type = buf[pos + 2];
+        min_interval = load<uint16_t>(&buf[pos + 3]);
+        max_interval = load<uint16_t>(&buf[pos + 5]);
+        reportable_change = load<uint64_t>(&buf[pos + 7]);
+        pos += 15;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Configure the reporting of a remote device or a list of devices.
+ * @note The request of frame_id::ZCL_REPORT_CONFIG.
+ *
+ */
+struct ZclReportConfig {
+    static constexpr size_t fixed_size = 20;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t zcl_basic_cmd = 0;
+        static constexpr size_t address_mode = 10;
+        static constexpr size_t cluster_id = 11;
+        static constexpr size_t concurrency = 13;
+        static constexpr size_t retries = 14;
+        static constexpr size_t timeout_ms = 15;
+        static constexpr size_t record_number = 17;
+        static constexpr size_t dev_number = 18;
+    };
+
+    ZclBasicCmd zcl_basic_cmd;                          /*!< Basic command info, the destination address is ignored in batch mode */
+    uint8_t address_mode = 0;                           /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id = 0;                            /*!< Cluster ID to configure */
+    uint8_t concurrency = 0;                            /*!< The number of devices configured at the same time in batch mode, 0 to use the default */
+    uint8_t retries = 0;                                /*!< The number of retries after a timeout in batch mode */
+    uint16_t timeout_ms = 0;                            /*!< The time to wait for the response of one device in batch mode, 0 to use the default */
+    std::vector<ZclReportRecord> record_field;          /*!< The reporting records, the record_number on the wire */
+    std::vector<uint16_t> dev_field;                    /*!< The short addresses of the devices, the dev_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        zcl_basic_cmd.decode(r);
+        address_mode = r.get<uint8_t>();
+        cluster_id = r.get<uint16_t>();
+        concurrency = r.get<uint8_t>();
+        retries = r.get<uint8_t>();
+        timeout_ms = r.get<uint16_t>();
+        uint8_t record_number = r.get<uint8_t>();
+        uint16_t dev_number = r.get<uint16_t>();
+        record_field.clear();
+        record_field.reserve(std::min<size_t>(record_number, r.remaining()));
+        for (size_t i = 0; i < record_number && r.ok(); i ++) {
+            ZclReportRecord record;
+            if (record.decode(r)) {
+                record_field.push_back(std::move(record));
+            }
+        }
+        dev_field.clear();
+        dev_field.reserve(std::min<size_t>(dev_number, r.remaining()));
+        for (size_t i = 0; i < dev_number && r.ok(); i ++) {
+            dev_field.push_back(r.get<uint16_t>());
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        zcl_basic_cmd.encode(w);
+        w.put<uint8_t>(address_mode);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(concurrency);
+        w.put<uint8_t>(retries);
+        w.put<uint16_t>(timeout_ms);
+        w.put<uint8_t>(wire_count<uint8_t>(record_field.size()));
+        w.put<uint16_t>(wire_count<uint16_t>(dev_field.size()));
+        for (const auto &record : record_field) {
+            record.encode(w);
+        }
+        for (uint16_t value : dev_field) {
+            w.put<uint16_t>(value);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ZclBasicCmd zcl_basic_cmd;                      /*!< Basic command info, the destination address is ignored in batch mode */
+        uint8_t address_mode = 0;                       /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+        uint16_t cluster_id = 0;                        /*!< Cluster ID to configure */
+        uint8_t concurrency = 0;                        /*!< The number of devices configured at the same time in batch mode, 0 to use the default */
+        uint8_t retries = 0;                            /*!< The number of retries after a timeout in batch mode */
+        uint16_t timeout_ms = 0;                        /*!< The time to wait for the response of one device in batch mode, 0 to use the default */
+        RecordView<ZclReportRecord::View> record_field; /*!< The reporting records */
+        ValueView<uint16_t> dev_field;                  /*!< The short addresses of the devices */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t record_number = 0;
+            uint16_t dev_number = 0;
+
+            if (len - pos < 20) {
+                return 0;
+            }
+            zcl_basic_cmd.get(&buf[pos], ZclBasicCmd::fixed_size);
+            address_mode = buf[pos + 10];
+            cluster_id = load<uint16_t>(&buf[pos + 11]);
+            concurrency = buf[pos + 13];
+            retries = buf[pos + 14];
+            timeout_ms = load<uint16_t>(&buf[pos + 15]);
+            record_number = buf[pos + 17];
+            dev_number = load<uint16_t>(&buf[pos + 18]);
+            pos += 20;
+            record_field.data = &buf[pos];
+            record_field.count = record_number;
+            for (size_t i = 0; i < record_number; i ++) {
+                ZclReportRecord::View record;
+                size_t used = record.get(&buf[pos], len - pos);
+
+                if (!used) {
+                    return 0;
+                }
+                pos += used;
+            }
+            record_field.len = static_cast<size_t>(&buf[pos] - record_field.data);
+            if (len - pos < static_cast<size_t>(dev_number) * 2) {
+                return 0;
+            }
+            dev_field.data = &buf[pos];
+            dev_field.count = dev_number;
+            pos += static_cast<size_t>(dev_number) * 2;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Configure the air-time scheduler.
+ * @note The request of frame_id::ZCL_SCHED_CONFIG.
+ *
+ */
+struct ZclSchedConfig {
+    static constexpr size_t fixed_size = 9;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t enable = 0;
+        static constexpr size_t rate = 1;
+        static constexpr size_t burst = 3;
+        static constexpr size_t dst_gap_ms = 5;
+        static constexpr size_t hop_gap_ms = 7;
+    };
+
+    bool enable = false;                                /*!< Schedule the ZCL requests, otherwise they are sent at once */
+    uint16_t rate = 0;                                  /*!< The air-time budget in bytes per second, 0 to keep the current value */
+    uint16_t burst = 0;                                 /*!< The token bucket depth in bytes, 0 to keep the current value */
+    uint16_t dst_gap_ms = 0;                            /*!< The minimum gap between two frames to the same destination, 0 to keep the current value */
+    uint16_t hop_gap_ms = 0;                            /*!< The minimum gap between two frames through the same next hop, 0 to keep the current value */
+
+    bool decode(Reader &r)
+    {
+        enable = r.get<uint8_t>() != 0;
+        rate = r.get<uint16_t>();
+        burst = r.get<uint16_t>();
+        dst_gap_ms = r.get<uint16_t>();
+        hop_gap_ms = r.get<uint16_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(enable ? 1 : 0);
+        w.put<uint16_t>(rate);
+        w.put<uint16_t>(burst);
+        w.put<uint16_t>(dst_gap_ms);
+        w.put<uint16_t>(hop_gap_ms);
+    }
+
+    using View = ZclSchedConfig;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 9) {
+            return 0;
+        }
+        enable = buf[pos] != 0;
+        rate = load<uint16_t>(&buf[pos + 1]);
+        burst = load<uint16_t>(&buf[pos + 3]);
+        dst_gap_ms = load<uint16_t>(&buf[pos + 5]);
+        hop_gap_ms = load<uint16_t>(&buf[pos + 7]);
+        pos += 9;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Send the same cluster command to a list of devices.
+ * @note The request of frame_id::ZCL_WRITE_MULTI.
+ *
+ */
+struct ZclWriteMulti {
+    static constexpr size_t fixed_size = 14;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t src_endpoint = 0;
+        static constexpr size_t dst_endpoint = 1;
+        static constexpr size_t profile_id = 2;
+        static constexpr size_t cluster_id = 4;
+        static constexpr size_t custom_cmd_id = 6;
+        static constexpr size_t direction = 8;
+        static constexpr size_t type = 9;
+        static constexpr size_t size = 10;
+        static constexpr size_t dev_number = 12;
+    };
+
+    uint8_t src_endpoint = 0;                           /*!< Source endpoint */
+    uint8_t dst_endpoint = 0;                           /*!< Destination endpoint on every device */
+    uint16_t profile_id = 0;                            /*!< Profile id */
+    uint16_t cluster_id = 0;                            /*!< Cluster id */
+    uint16_t custom_cmd_id = 0;                         /*!< Custom command id */
+    uint8_t direction = 0;                              /*!< Direction of command */
+    uint8_t type = 0;                                   /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+    Bytes value;                                        /*!< The value, the size on the wire */
+    std::vector<uint16_t> dev_field;                    /*!< The short addresses of the devices, the dev_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        src_endpoint = r.get<uint8_t>();
+        dst_endpoint = r.get<uint8_t>();
+        profile_id = r.get<uint16_t>();
+        cluster_id = r.get<uint16_t>();
+        custom_cmd_id = r.get<uint16_t>();
+        direction = r.get<uint8_t>();
+        type = r.get<uint8_t>();
+        uint16_t size = r.get<uint16_t>();
+        uint16_t dev_number = r.get<uint16_t>();
+        if (const uint8_t *data = r.bytes(size)) {
+            value.assign(data, data + size);
+        }
+        dev_field.clear();
+        dev_field.reserve(std::min<size_t>(dev_number, r.remaining()));
+        for (size_t i = 0; i < dev_number && r.ok(); i ++) {
+            dev_field.push_back(r.get<uint16_t>());
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(src_endpoint);
+        w.put<uint8_t>(dst_endpoint);
+        w.put<uint16_t>(profile_id);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint16_t>(custom_cmd_id);
+        w.put<uint8_t>(direction);
+        w.put<uint8_t>(type);
+        w.put<uint16_t>(wire_count<uint16_t>(value.size()));
+        w.put<uint16_t>(wire_count<uint16_t>(dev_field.size()));
+        w.bytes(value.data(), value.size());
+        for (uint16_t value : dev_field) {
+            w.put<uint16_t>(value);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint8_t src_endpoint = 0;                       /*!< Source endpoint */
+        uint8_t dst_endpoint = 0;                       /*!< Destination endpoint on every device */
+        uint16_t profile_id = 0;                        /*!< Profile id */
+        uint16_t cluster_id = 0;                        /*!< Cluster id */
+        uint16_t custom_cmd_id = 0;                     /*!< Custom command id */
+        uint8_t direction = 0;                          /*!< Direction of command */
+        uint8_t type = 0;                               /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+        ByteView value;                                 /*!< The value */
+        ValueView<uint16_t> dev_field;                  /*!< The short addresses of the devices */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint16_t size = 0;
+            uint16_t dev_number = 0;
+
+            if (len - pos < 14) {
+                return 0;
+            }
+            src_endpoint = buf[pos];
+            dst_endpoint = buf[pos + 1];
+            profile_id = load<uint16_t>(&buf[pos + 2]);
+            cluster_id = load<uint16_t>(&buf[pos + 4]);
+            custom_cmd_id = load<uint16_t>(&buf[pos + 6]);
+            direction = buf[pos + 8];
+            type = buf[pos + 9];
+            size = load<uint16_t>(&buf[pos + 10]);
+            dev_number = load<uint16_t>(&buf[pos + 12]);
+            pos += 14;
+            if (len - pos < size) {
+                return 0;
+            }
+            value.data = &buf[pos];
+            value.len = size;
+            pos += size;
+            if (len - pos < static_cast<size_t>(dev_number) * 2) {
+                return 0;
+            }
+            dev_field.data = &buf[pos];
+            dev_field.count = dev_number;
+            pos += static_cast<size_t>(dev_number) * 2;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Install a rule which sends a command when a report or indication matches.
+ * @note The request of frame_id::ZCL_RULE_ADD.
+ *
+ */
+struct ZclRuleAdd {
+    static constexpr size_t fixed_size = 12;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t rule_id = 0;
+        static constexpr size_t flags = 1;
+        static constexpr size_t trigger = 2;
+        static constexpr size_t src_addr = 3;
+        static constexpr size_t src_endpoint = 5;
+        static constexpr size_t cluster_id = 6;
+        static constexpr size_t attr_id = 8;
+        static constexpr size_t code_len = 10;
+        static constexpr size_t action_len = 11;
+    };
+
+    uint8_t rule_id = 0;                                /*!< The rule index, an installed rule is replaced */
+    uint8_t flags = 0;                                  /*!< The rule flags, refer to ESP_NCP_ZB_RULE_FLAG_EDGE */
+    uint8_t trigger = 0;                                /*!< The trigger, refer to esp_ncp_zb_rule_trigger_t */
+    uint16_t src_addr = 0;                              /*!< The short address of the source, 0xFFFF for any */
+    uint8_t src_endpoint = 0;                           /*!< The source endpoint, 0xFF for any */
+    uint16_t cluster_id = 0;                            /*!< The cluster of the report or indication */
+    uint16_t attr_id = 0;                               /*!< The reported attribute, 0xFFFF for any */
+    Bytes code;                                         /*!< The condition bytecode, the code_len on the wire */
+    Bytes action;                                       /*!< The command, encoded as a rule action, the action_len on the wire */
+
+    bool decode(Reader &r)
+    {
+        rule_id = r.get<uint8_t>();
+        flags = r.get<uint8_t>();
+        trigger = r.get<uint8_t>();
+        src_addr = r.get<uint16_t>();
+        src_endpoint = r.get<uint8_t>();
+        cluster_id = r.get<uint16_t>();
+        attr_id = r.get<uint16_t>();
+        uint8_t code_len = r.get<uint8_t>();
+        uint8_t action_len = r.get<uint8_t>();
+        if (const uint8_t *data = r.bytes(code_len)) {
+            code.assign(data, data + code_len);
+        }
+        if (const uint8_t *data = r.bytes(action_len)) {
+            action.assign(data, data + action_len);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(rule_id);
+        w.put<uint8_t>(flags);
+        w.put<uint8_t>(trigger);
+        w.put<uint16_t>(src_addr);
+        w.put<uint8_t>(src_endpoint);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint16_t>(attr_id);
+        w.put<uint8_t>(wire_count<uint8_t>(code.size()));
+        w.put<uint8_t>(wire_count<uint8_t>(action.size()));
+        w.bytes(code.data(), code.size());
+        w.bytes(action.data(), action.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint8_t rule_id = 0;                            /*!< The rule index, an installed rule is replaced */
+        uint8_t flags = 0;                              /*!< The rule flags, refer to ESP_NCP_ZB_RULE_FLAG_EDGE */
+        uint8_t trigger = 0;                            /*!< The trigger, refer to esp_ncp_zb_rule_trigger_t */
+        uint16_t src_addr = 0;                          /*!< The short address of the source, 0xFFFF for any */
+        uint8_t src_endpoint = 0;                       /*!< The source endpoint, 0xFF for any */
+        uint16_t cluster_id = 0;                        /*!< The cluster of the report or indication */
+        uint16_t attr_id = 0;                           /*!< The reported attribute, 0xFFFF for any */
+        ByteView code;                                  /*!< The condition bytecode */
+        ByteView action;                                /*!< The command, encoded as a rule action */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t code_len = 0;
+            uint8_t action_len = 0;
+
+            if (len - pos < 12) {
+                return 0;
+            }
+            rule_id = buf[pos];
+            flags = buf[pos + 1];
+            trigger = buf[pos + 2];
+            src_addr = load<uint16_t>(&buf[pos + 3]);
+            src_endpoint = buf[pos + 5];
+            cluster_id = load<uint16_t>(&buf[pos + 6]);
+            attr_id = load<uint16_t>(&buf[pos + 8]);
+            code_len = buf[pos + 10];
+            action_len = buf[pos + 11];
+            pos += 12;
+            if (len - pos < code_len) {
+                return 0;
+            }
+            code.data = &buf[pos];
+            code.len = code_len;
+            pos += code_len;
+            if (len - pos < action_len) {
+                return 0;
+            }
+            action.data = &buf[pos];
+            action.len = action_len;
+            pos += action_len;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief Remove a rule.
+ * @note The request of frame_id::ZCL_RULE_DEL.
+ *
+ */
+struct ZclRuleDel {
+    static constexpr size_t fixed_size = 1;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t rule_id = 0;
+    };
+
+    uint8_t rule_id = 0;                                /*!< The rule index */
+
+    bool decode(Reader &r)
+    {
+        rule_id = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(rule_id);
+    }
+
+    using View = ZclRuleDel;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 1) {
+            return 0;
+        }
+        rule_id = buf[pos];
+        pos += 1;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Read the statistics of a rule.
+ * @note The request of frame_id::ZCL_RULE_STATS.
+ *
+ */
+struct ZclRuleStats {
+    static constexpr size_t fixed_size = 2;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t rule_id = 0;
+        static constexpr size_t reset = 1;
+    };
+
+    uint8_t rule_id = 0;                                /*!< The rule index */
+    bool reset = false;                                 /*!< Reset the statistics once read */
+
+    bool decode(Reader &r)
+    {
+        rule_id = r.get<uint8_t>();
+        reset = r.get<uint8_t>() != 0;
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(rule_id);
+        w.put<uint8_t>(reset ? 1 : 0);
+    }
+
+    using View = ZclRuleStats;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 2) {
+            return 0;
+        }
+        rule_id = buf[pos];
+        reset = buf[pos + 1] != 0;
+        pos += 2;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Cancel a queued command.
+ * @note The request of frame_id::ZCL_TIMER_CANCEL.
+ *
+ */
+struct ZclTimerCancel {
+    static constexpr size_t fixed_size = 4;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t id = 0;
+    };
+
+    uint32_t id = 0;                                    /*!< The ID given when the command was queued */
+
+    bool decode(Reader &r)
+    {
+        id = r.get<uint32_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint32_t>(id);
+    }
+
+    using View = ZclTimerCancel;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 4) {
+            return 0;
+        }
+        id = load<uint32_t>(&buf[pos]);
+        pos += 4;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Configure the interrogation of the devices.
+ * @note The request of frame_id::ZDO_INTERROGATE_CONFIG.
+ *
+ */
+struct ZdoInterrogateConfig {
+    static constexpr size_t fixed_size = 3;             /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t auto_enable = 0;
+        static constexpr size_t concurrency = 1;
+        static constexpr size_t retries = 2;
+    };
+
+    bool auto_enable = false;                           /*!< Interrogate every device which announces itself */
+    uint8_t concurrency = 0;                            /*!< The number of devices interrogated at the same time, 0 to use the default */
+    uint8_t retries = 0;                                /*!< The number of retries of one ZDO request */
+
+    bool decode(Reader &r)
+    {
+        auto_enable = r.get<uint8_t>() != 0;
+        concurrency = r.get<uint8_t>();
+        retries = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(auto_enable ? 1 : 0);
+        w.put<uint8_t>(concurrency);
+        w.put<uint8_t>(retries);
+    }
+
+    using View = ZdoInterrogateConfig;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 3) {
+            return 0;
+        }
+        auto_enable = buf[pos] != 0;
+        concurrency = buf[pos + 1];
+        retries = buf[pos + 2];
+        pos += 3;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Interrogate a list of devices.
+ * @note The request of frame_id::ZDO_INTERROGATE.
+ *
+ */
+struct ZdoInterrogate {
+    static constexpr size_t fixed_size = 2;             /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t dev_number = 0;
+    };
+
+    std::vector<uint16_t> dev_field;                    /*!< The short addresses of the devices, the dev_number on the wire */
+
+    bool decode(Reader &r)
+    {
+        uint16_t dev_number = r.get<uint16_t>();
+        dev_field.clear();
+        dev_field.reserve(std::min<size_t>(dev_number, r.remaining()));
+        for (size_t i = 0; i < dev_number && r.ok(); i ++) {
+            dev_field.push_back(r.get<uint16_t>());
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint16_t>(wire_count<uint16_t>(dev_field.size()));
+        for (uint16_t value : dev_field) {
+            w.put<uint16_t>(value);
+        }
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        ValueView<uint16_t> dev_field;                  /*!< The short addresses of the devices */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint16_t dev_number = 0;
+
+            if (len - pos < 2) {
+                return 0;
+            }
+            dev_number = load<uint16_t>(&buf[pos]);
+            pos += 2;
+            if (len - pos < static_cast<size_t>(dev_number) * 2) {
+                return 0;
+            }
+            dev_field.data = &buf[pos];
+            dev_field.count = dev_number;
+            pos += static_cast<size_t>(dev_number) * 2;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief One destination of a bulk APS data request.
+ *
+ */
+struct ApsBulkDst {
+    static constexpr size_t fixed_size = 11;            /*!< The size of the payload */
+
+    struct offset {
+        static constexpr size_t dst_addr_mode = 0;
+        static constexpr size_t dst_addr = 1;
+        static constexpr size_t dst_endpoint = 9;
+        static constexpr size_t tx_options = 10;
+    };
+
+    uint8_t dst_addr_mode = 0;                          /*!< The addressing mode for the destination address, refer to esp_zb_aps_address_mode_t */
+    Addr dst_addr;                                      /*!< The individual device address or group address of the destination */
+    uint8_t dst_endpoint = 0;                           /*!< The destination endpoint */
+    uint8_t tx_options = 0;                             /*!< The transmission options for the destination, refer to esp_zb_apsde_tx_opt_t */
+
+    bool decode(Reader &r)
+    {
+        dst_addr_mode = r.get<uint8_t>();
+        dst_addr.decode(r);
+        dst_endpoint = r.get<uint8_t>();
+        tx_options = r.get<uint8_t>();
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(dst_addr_mode);
+        dst_addr.encode(w);
+        w.put<uint8_t>(dst_endpoint);
+        w.put<uint8_t>(tx_options);
+    }
+
+    using View = ApsBulkDst;
+
+    size_t get(const uint8_t *buf, size_t len)
+    {
+        size_t pos = 0;
+
+        if (len - pos < 11) {
+            return 0;
+        }
+        dst_addr_mode = buf[pos];
+        dst_addr.get(&buf[pos + 1]);
+        dst_endpoint = buf[pos + 9];
+        tx_options = buf[pos + 10];
+        pos += 11;
+
+        return pos;
+    }
+};
+
+/**
+ * @brief Send the same APS data frame to a list of destinations.
+ * @note The request of frame_id::APS_DATA_REQUEST_BULK.
+ *
+ */
+struct ApsDataRequestBulk {
+    static constexpr size_t fixed_size = 13;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t src_endpoint = 0;
+        static constexpr size_t profile_id = 1;
+        static constexpr size_t cluster_id = 3;
+        static constexpr size_t radius = 5;
+        static constexpr size_t pacing_ms = 6;
+        static constexpr size_t dst_count = 8;
+        static constexpr size_t asdu_length = 9;
+    };
+
+    uint8_t src_endpoint = 0;                           /*!< The source endpoint */
+    uint16_t profile_id = 0;                            /*!< Profile id */
+    uint16_t cluster_id = 0;                            /*!< Cluster id */
+    uint8_t radius = 0;                                 /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+    uint16_t pacing_ms = 0;                             /*!< The delay between two destinations, 0 to use the default pacing */
+    std::vector<ApsBulkDst> dst;                        /*!< The destinations, the dst_count on the wire */
+    Bytes asdu;                                         /*!< The ASDU, the asdu_length on the wire */
+
+    bool decode(Reader &r)
+    {
+        src_endpoint = r.get<uint8_t>();
+        profile_id = r.get<uint16_t>();
+        cluster_id = r.get<uint16_t>();
+        radius = r.get<uint8_t>();
+        pacing_ms = r.get<uint16_t>();
+        uint8_t dst_count = r.get<uint8_t>();
+        uint32_t asdu_length = r.get<uint32_t>();
+        dst.clear();
+        dst.reserve(std::min<size_t>(dst_count, r.remaining()));
+        for (size_t i = 0; i < dst_count && r.ok(); i ++) {
+            ApsBulkDst record;
+            if (record.decode(r)) {
+                dst.push_back(std::move(record));
+            }
+        }
+        if (const uint8_t *data = r.bytes(asdu_length)) {
+            asdu.assign(data, data + asdu_length);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(src_endpoint);
+        w.put<uint16_t>(profile_id);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(radius);
+        w.put<uint16_t>(pacing_ms);
+        w.put<uint8_t>(wire_count<uint8_t>(dst.size()));
+        w.put<uint32_t>(wire_count<uint32_t>(asdu.size()));
+        for (const auto &record : dst) {
+            record.encode(w);
+        }
+        w.bytes(asdu.data(), asdu.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint8_t src_endpoint = 0;                       /*!< The source endpoint */
+        uint16_t profile_id = 0;                        /*!< Profile id */
+        uint16_t cluster_id = 0;                        /*!< Cluster id */
+        uint8_t radius = 0;                             /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+        uint16_t pacing_ms = 0;                         /*!< The delay between two destinations, 0 to use the default pacing */
+        RecordView<ApsBulkDst::View> dst;               /*!< The destinations */
+        ByteView asdu;                                  /*!< The ASDU */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint8_t dst_count = 0;
+            uint32_t asdu_length = 0;
+
+            if (len - pos < 13) {
+                return 0;
+            }
+            src_endpoint = buf[pos];
+            profile_id = load<uint16_t>(&buf[pos + 1]);
+            cluster_id = load<uint16_t>(&buf[pos + 3]);
+            radius = buf[pos + 5];
+            pacing_ms = load<uint16_t>(&buf[pos + 6]);
+            dst_count = buf[pos + 8];
+            asdu_length = load<uint32_t>(&buf[pos + 9]);
+            pos += 13;
+            dst.data = &buf[pos];
+            dst.count = dst_count;
+            for (size_t i = 0; i < dst_count; i ++) {
+                ApsBulkDst::View record;
+                size_t used = record.get(&buf[pos], len - pos);
+
+                if (!used) {
+                    return 0;
+                }
+                pos += used;
+            }
+            dst.len = static_cast<size_t>(&buf[pos] - dst.data);
+            if (len - pos < asdu_length) {
+                return 0;
+            }
+            asdu.data = &buf[pos];
+            asdu.len = asdu_length;
+            pos += asdu_length;
+
+            return pos;
+        }
+    };
+};
+
+/**
+ * @brief An APS data frame received.
+ * @note The response of frame_id::APS_DATA_INDICATION.
+ * @note The notification of frame_id::APS_DATA_INDICATION.
+ *
+ */
+struct ApsDataIndication {
+    static constexpr size_t fixed_size = 36;            /*!< The size up to the first variable field */
+
+    struct offset {
+        static constexpr size_t states = 0;
+        static constexpr size_t dst_addr_mode = 1;
+        static constexpr size_t dst_addr = 2;
+        static constexpr size_t dst_endpoint = 10;
+        static constexpr size_t src_addr_mode = 11;
+        static constexpr size_t src_addr = 12;
+        static constexpr size_t src_endpoint = 20;
+        static constexpr size_t profile_id = 21;
+        static constexpr size_t cluster_id = 23;
+        static constexpr size_t indication_status = 25;
+        static constexpr size_t security_status = 26;
+        static constexpr size_t lqi = 27;
+        static constexpr size_t rx_time = 28;
+        static constexpr size_t asdu_length = 32;
+    };
+
+    uint8_t states = 0;                                 /*!< The states of the device */
+    uint8_t dst_addr_mode = 0;                          /*!< The addressing mode for the destination address */
+    Addr dst_addr;                                      /*!< The individual device address or group address to which the ASDU is directed */
+    uint8_t dst_endpoint = 0;                           /*!< The target endpoint on the local entity to which the ASDU is directed */
+    uint8_t src_addr_mode = 0;                          /*!< The addressing mode for the source address */
+    Addr src_addr;                                      /*!< The individual device address of the entity from which the ASDU has been received */
+    uint8_t src_endpoint = 0;                           /*!< The endpoint of the entity from which the ASDU has been received */
+    uint16_t profile_id = 0;                            /*!< The identifier of the profile from which this frame originated */
+    uint16_t cluster_id = 0;                            /*!< The identifier of the received object */
+    uint8_t indication_status = 0;                      /*!< The status of the incoming frame processing, 0: on success */
+    uint8_t security_status = 0;                        /*!< The security of the received ASDU */
+    uint8_t lqi = 0;                                    /*!< The link quality indication delivered by the NLDE */
+    int32_t rx_time = 0;                                /*!< Reserved, a time indication for the received packet based on the local clock */
+    Bytes asdu;                                         /*!< The ASDU, the asdu_length on the wire */
+
+    bool decode(Reader &r)
+    {
+        states = r.get<uint8_t>();
+        dst_addr_mode = r.get<uint8_t>();
+        dst_addr.decode(r);
+        dst_endpoint = r.get<uint8_t>();
+        src_addr_mode = r.get<uint8_t>();
+        src_addr.decode(r);
+        src_endpoint = r.get<uint8_t>();
+        profile_id = r.get<uint16_t>();
+        cluster_id = r.get<uint16_t>();
+        indication_status = r.get<uint8_t>();
+        security_status = r.get<uint8_t>();
+        lqi = r.get<uint8_t>();
+        rx_time = r.get<int32_t>();
+        uint32_t asdu_length = r.get<uint32_t>();
+        if (const uint8_t *data = r.bytes(asdu_length)) {
+            asdu.assign(data, data + asdu_length);
+        }
+        return r.ok();
+    }
+
+    void encode(Writer &w) const
+    {
+        w.put<uint8_t>(states);
+        w.put<uint8_t>(dst_addr_mode);
+        dst_addr.encode(w);
+        w.put<uint8_t>(dst_endpoint);
+        w.put<uint8_t>(src_addr_mode);
+        src_addr.encode(w);
+        w.put<uint8_t>(src_endpoint);
+        w.put<uint16_t>(profile_id);
+        w.put<uint16_t>(cluster_id);
+        w.put<uint8_t>(indication_status);
+        w.put<uint8_t>(security_status);
+        w.put<uint8_t>(lqi);
+        w.put<int32_t>(rx_time);
+        w.put<uint32_t>(wire_count<uint32_t>(asdu.size()));
+        w.bytes(asdu.data(), asdu.size());
+    }
+
+    /**
+     * @brief The payload decoded in place, the lists and bytes point into the buffer.
+     *
+     */
+    struct View {
+        uint8_t states = 0;                             /*!< The states of the device */
+        uint8_t dst_addr_mode = 0;                      /*!< The addressing mode for the destination address */
+        Addr dst_addr;                                  /*!< The individual device address or group address to which the ASDU is directed */
+        uint8_t dst_endpoint = 0;                       /*!< The target endpoint on the local entity to which the ASDU is directed */
+        uint8_t src_addr_mode = 0;                      /*!< The addressing mode for the source address */
+        Addr src_addr;                                  /*!< The individual device address of the entity from which the ASDU has been received */
+        uint8_t src_endpoint = 0;                       /*!< The endpoint of the entity from which the ASDU has been received */
+        uint16_t profile_id = 0;                        /*!< The identifier of the profile from which this frame originated */
+        uint16_t cluster_id = 0;                        /*!< The identifier of the received object */
+        uint8_t indication_status = 0;                  /*!< The status of the incoming frame processing, 0: on success */
+        uint8_t security_status = 0;                    /*!< The security of the received ASDU */
+        uint8_t lqi = 0;                                /*!< The link quality indication delivered by the NLDE */
+        int32_t rx_time = 0;                            /*!< Reserved, a time indication for the received packet based on the local clock */
+        ByteView asdu;                                  /*!< The ASDU */
+
+        size_t get(const uint8_t *buf, size_t len)
+        {
+            size_t pos = 0;
+            uint32_t asdu_length = 0;
+
+            if (len - pos < 36) {
+                return 0;
+            }
+            states = buf[pos];
+            dst_addr_mode = buf[pos + 1];
+            dst_addr.get(&buf[pos + 2]);
+            dst_endpoint = buf[pos + 10];
+            src_addr_mode = buf[pos + 11];
+            src_addr.get(&buf[pos + 12]);
+            src_endpoint = buf[pos + 20];
+            profile_id = load<uint16_t>(&buf[pos + 21]);
+            cluster_id = load<uint16_t>(&buf[pos + 23]);
+            indication_status = buf[pos + 25];
+            security_status = buf[pos + 26];
+            lqi = buf[pos + 27];
+            rx_time = load<int32_t>(&buf[pos + 28]);
+            asdu_length = load<uint32_t>(&buf[pos + 32]);
+            pos += 36;
+            if (len - pos < asdu_length) {
+                return 0;
+            }
+            asdu.data = &buf[pos];
+            asdu.len = asdu_length;
+            pos += asdu_length;
+
+            return pos;
+        }
+    };
+};
+
+/** Decode a payload, the bytes past it are ignored */
+template <typename T>
+bool decode(const uint8_t *data, size_t len, T &msg)
+{
+    Reader r(data, len);
+    return msg.decode(r);
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclAttrRead::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclAttrWrite::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ApsDataRequest::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclWrite::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclAttrReadBulk::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclTimerAdd::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, NetworkIcRemoveBulk::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclReportConfig::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclWriteMulti::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZclRuleAdd::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ZdoInterrogate::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ApsDataRequestBulk::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+/** Decode a payload in place, the view is valid as long as the buffer */
+inline bool decode(const uint8_t *data, size_t len, ApsDataIndication::View &msg)
+{
+    return data && msg.get(data, len) != 0;
+}
+
+
+template <typename T>
+Bytes encode(const T &msg)
+{
+    Bytes out;
+    Writer w(out);
+    msg.encode(w);
+    return out;
+}
+
+/**
+ * @brief The payload types of a frame ID, as request, response and notification.
+ *
+ */
+template <uint16_t Id>
+struct Frame;
+
+template <>
+struct Frame<frame_id::ZCL_ATTR_READ> {
+    using request = ZclAttrRead;
+    using response = StatusTsn;
+};
+
+template <>
+struct Frame<frame_id::ZCL_ATTR_WRITE> {
+    using request = ZclAttrWrite;
+    using response = StatusTsn;
+};
+
+template <>
+struct Frame<frame_id::ZCL_WRITE> {
+    using request = ZclWrite;
+    using response = StatusTsn;
+};
+
+template <>
+struct Frame<frame_id::NETWORK_SIGNAL_SUBSCRIBE> {
+    using request = NetworkSignalSubscribe;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::NETWORK_JOIN_BATCH_CONFIG> {
+    using request = NetworkJoinBatchConfig;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::NETWORK_IC_REMOVE_BULK> {
+    using request = NetworkIcRemoveBulk;
+};
+
+template <>
+struct Frame<frame_id::ZCL_REPORT_CONFIG> {
+    using request = ZclReportConfig;
+    using response = StatusTsn;
+};
+
+template <>
+struct Frame<frame_id::ZCL_ATTR_READ_BULK> {
+    using request = ZclAttrReadBulk;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZCL_SCHED_CONFIG> {
+    using request = ZclSchedConfig;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZCL_WRITE_MULTI> {
+    using request = ZclWriteMulti;
+};
+
+template <>
+struct Frame<frame_id::ZCL_RULE_ADD> {
+    using request = ZclRuleAdd;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZCL_RULE_DEL> {
+    using request = ZclRuleDel;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZCL_RULE_STATS> {
+    using request = ZclRuleStats;
+};
+
+template <>
+struct Frame<frame_id::ZCL_TIMER_ADD> {
+    using request = ZclTimerAdd;
+    using response = StatusId;
+};
+
+template <>
+struct Frame<frame_id::ZCL_TIMER_CANCEL> {
+    using request = ZclTimerCancel;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZDO_INTERROGATE_CONFIG> {
+    using request = ZdoInterrogateConfig;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::ZDO_INTERROGATE> {
+    using request = ZdoInterrogate;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::APS_DATA_REQUEST> {
+    using request = ApsDataRequest;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::APS_DATA_REQUEST_BULK> {
+    using request = ApsDataRequestBulk;
+    using response = Status;
+};
+
+template <>
+struct Frame<frame_id::APS_DATA_INDICATION> {
+    using response = ApsDataIndication;
+    using notification = ApsDataIndication;
+};
+
+} // namespace wire
+} // namespace esp_ncp
@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include "esp_ncp/capture.hpp"
+#include "esp_ncp/frame.hpp"
+
+namespace esp_ncp {
+
+namespace {
+
+constexpr uint32_t CAPTURE_DIRECTION_BIT = 0x80000000;
+
+bool read_exact(FILE *file, uint8_t *data, size_t len)
+{
+    return fread(data, 1, len, file) == len;
+}
+
+} // namespace
+
+CaptureWriter::CaptureWriter(const std::string &path, CaptureOrigin origin) : start_(std::chrono::steady_clock::now())
+{
+    std::vector<uint8_t> head;
+    uint64_t start_unix_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::system_error(errno, std::generic_category(), "capture " + path);
+    }
+
+    Writer(head).put<uint32_t>(CAPTURE_MAGIC).put<uint16_t>(CAPTURE_VERSION).put<uint16_t>(static_cast<uint16_t>(origin))
+                .put<uint64_t>(start_unix_ns).put<uint64_t>(0);
+    fwrite(head.data(), 1, head.size(), file_);
+    offset_ = head.size();
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    close();
+}
+
+void CaptureWriter::write(CaptureDirection direction, std::chrono::steady_clock::time_point when, const uint8_t *data, size_t len)
+{
+    uint8_t head[CAPTURE_RECORD_HEADER_SIZE];
+    uint64_t time_ns = when > start_ ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(when - start_).count()) : 0;
+    uint32_t len_dir = static_cast<uint32_t>(len & ~CAPTURE_DIRECTION_BIT)
+                       | (direction == CaptureDirection::FromNcp ? CAPTURE_DIRECTION_BIT : 0);
+
+    if (!file_) {
+        return;
+    }
+
+    for (size_t i = 0; i < 4; i ++) {
+        head[i] = static_cast<uint8_t>(len_dir >> (8 * i));
+    }
+    for (size_t i = 0; i < 8; i ++) {
+        head[4 + i] = static_cast<uint8_t>(time_ns >> (8 * i));
+    }
+
+    if (records_ % CAPTURE_INDEX_INTERVAL == 0) {
+        index_.push_back(CaptureIndexEntry{records_, offset_, time_ns});
+    }
+    fwrite(head, 1, sizeof(head), file_);
+    fwrite(data, 1, len, file_);
+    offset_ += sizeof(head) + len;
+    records_ ++;
+}
+
+void CaptureWriter::close()
+{
+    std::vector<uint8_t> index;
+    Writer w(index);
+
+    if (!file_) {
+        return;
+    }
+
+    w.put<uint32_t>(CAPTURE_INDEX_MAGIC).put<uint32_t>(static_cast<uint32_t>(index_.size()));
+    for (const CaptureIndexEntry &entry : index_) {
+        w.put<uint64_t>(entry.number).put<uint64_t>(entry.offset).put<uint64_t>(entry.time_ns);
+    }
+    fwrite(index.data(), 1, index.size(), file_);
+
+    /* The index offset in the file header tells the readers the capture is complete */
+    std::vector<uint8_t> offset;
+    Writer(offset).put<uint64_t>(offset_);
+    fseek(file_, CAPTURE_HEADER_SIZE - sizeof(uint64_t), SEEK_SET);
+    fwrite(offset.data(), 1, offset.size(), file_);
+
+    fclose(file_);
+    file_ = nullptr;
+}
+
+CaptureReader::CaptureReader(const std::string &path)
+{
+    uint8_t head[CAPTURE_HEADER_SIZE];
+    uint64_t index_offset;
+
+    file_ = fopen(path.c_str(), "rb");
+    if (!file_) {
+        throw std::system_error(errno, std::generic_category(), "capture " + path);
+    }
+    if (!read_exact(file_, head, sizeof(head))) {
+        fclose(file_);
+        throw std::runtime_error(path + ": not a capture");
+    }
+
+    Reader r(head, sizeof(head));
+    uint32_t magic = r.get<uint32_t>();
+    uint16_t version = r.get<uint16_t>();
+    origin_ = static_cast<CaptureOrigin>(r.get<uint16_t>());
+    start_unix_ns_ = r.get<uint64_t>();
+    index_offset = r.get<uint64_t>();
+    if (magic != CAPTURE_MAGIC || version != CAPTURE_VERSION) {
+        fclose(file_);
+        throw std::runtime_error(path + ": not a capture of version " + std::to_string(CAPTURE_VERSION));
+    }
+
+    fseek(file_, 0, SEEK_END);
+    end_ = static_cast<uint64_t>(ftell(file_));
+
+    if (index_offset >= CAPTURE_HEADER_SIZE && index_offset < end_) {
+        uint8_t index_head[8];
+        fseek(file_, static_cast<long>(index_offset), SEEK_SET);
+        if (read_exact(file_, index_head, sizeof(index_head))) {
+            Reader ir(index_head, sizeof(index_head));
+            uint32_t index_magic = ir.get<uint32_t>();
+            uint32_t count = ir.get<uint32_t>();
+            std::vector<uint8_t> entries(static_cast<size_t>(count) * 24);
+
+            if (index_magic == CAPTURE_INDEX_MAGIC && read_exact(file_, entries.data(), entries.size())) {
+                Reader er(entries.data(), entries.size());
+                for (uint32_t i = 0; i < count; i ++) {
+                    CaptureIndexEntry entry;
+                    entry.number = er.get<uint64_t>();
+                    entry.offset = er.get<uint64_t>();
+                    entry.time_ns = er.get<uint64_t>();
+                    index_.push_back(entry);
+                }
+                end_ = index_offset;
+            }
+        }
+    }
+
+    fseek(file_, CAPTURE_HEADER_SIZE, SEEK_SET);
+}
+
+CaptureReader::~CaptureReader()
+{
+    fclose(file_);
+}
+
+bool CaptureReader::next(CaptureRecord &record)
+{
+    uint8_t head[CAPTURE_RECORD_HEADER_SIZE];
+
+    if (offset_ + sizeof(head) > end_ || !read_exact(file_, head, sizeof(head))) {
+        return false;
+    }
+
+    Reader r(head, sizeof(head));
+    uint32_t len_dir = r.get<uint32_t>();
+    size_t len = len_dir & ~CAPTURE_DIRECTION_BIT;
+
+    if (offset_ + sizeof(head) + len > end_) {
+        return false;
+    }
+
+    record.number = number_;
+    record.direction = (len_dir & CAPTURE_DIRECTION_BIT) ? CaptureDirection::FromNcp : CaptureDirection::ToNcp;
+    record.time_ns = r.get<uint64_t>();
+    record.data.resize(len);
+    if (!read_exact(file_, record.data.data(), len)) {
+        return false;
+    }
+    offset_ += sizeof(head) + len;
+    number_ ++;
+
+    return true;
+}
+
+void CaptureReader::seek_entry(const CaptureIndexEntry &entry)
+{
+    offset_ = entry.offset;
+    number_ = entry.number;
+    fseek(file_, static_cast<long>(offset_), SEEK_SET);
+}
+
+void CaptureReader::seek_time(uint64_t time_ns)
+{
+    auto it = std::upper_bound(index_.begin(), index_.end(), time_ns,
+                               [](uint64_t t, const CaptureIndexEntry &entry) { return t < entry.time_ns; });
+
+    seek_entry(it == index_.begin() ? CaptureIndexEntry{0, CAPTURE_HEADER_SIZE, 0} : *(it - 1));
+
+    /* Skip the records before the time, reading only their headers */
+    while (offset_ + CAPTURE_RECORD_HEADER_SIZE <= end_) {
+        uint8_t head[CAPTURE_RECORD_HEADER_SIZE];
+        if (!read_exact(file_, head, sizeof(head))) {
+            break;
+        }
+        Reader r(head, sizeof(head));
+        size_t len = r.get<uint32_t>() & ~CAPTURE_DIRECTION_BIT;
+        if (r.get<uint64_t>() >= time_ns) {
+            break;
+        }
+        offset_ += sizeof(head) + len;
+        number_ ++;
+        fseek(file_, static_cast<long>(offset_), SEEK_SET);
+    }
+    fseek(file_, static_cast<long>(offset_), SEEK_SET);
+}
+
+void CaptureReader::seek_record(uint64_t number)
+{
+    auto it = std::upper_bound(index_.begin(), index_.end(), number,
+                               [](uint64_t n, const CaptureIndexEntry &entry) { return n < entry.number; });
+
+    seek_entry(it == index_.begin() ? CaptureIndexEntry{0, CAPTURE_HEADER_SIZE, 0} : *(it - 1));
+
+    while (number_ < number && offset_ + CAPTURE_RECORD_HEADER_SIZE <= end_) {
+        uint8_t head[CAPTURE_RECORD_HEADER_SIZE];
+        if (!read_exact(file_, head, sizeof(head))) {
+            break;
+        }
+        Reader r(head, sizeof(head));
+        offset_ += sizeof(head) + (r.get<uint32_t>() & ~CAPTURE_DIRECTION_BIT);
+        number_ ++;
+        fseek(file_, static_cast<long>(offset_), SEEK_SET);
+    }
+    fseek(file_, static_cast<long>(offset_), SEEK_SET);
+}
+
+} // namespace esp_ncp
@@ -0,0 +1,439 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <system_error>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "esp_ncp/client.hpp"
+
+namespace esp_ncp {
+
+namespace {
+
+constexpr size_t CLIENT_SLOTS = 256;            /*!< One slot per sn */
+constexpr int CLIENT_READ_BURST = 16;           /*!< The reads per wakeup before the writes get their turn */
+
+} // namespace
+
+const char *error_name(Error error)
+{
+    switch (error) {
+    case Error::None: return "none";
+    case Error::Timeout: return "timeout";
+    case Error::Disconnected: return "disconnected";
+    default: return "unknown";
+    }
+}
+
+Client::Client(std::unique_ptr<Transport> transport, const ClientOptions &options)
+    : transport_(std::move(transport)), options_(options), subscribers_(std::make_shared<Subscribers>())
+{
+    struct epoll_event event = {};
+
+    if (options_.window == 0 || options_.window > CLIENT_SLOTS) {
+        options_.window = CLIENT_SLOTS;
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || event_fd_ < 0) {
+        int err = errno;
+        if (epoll_fd_ >= 0) {
+            ::close(epoll_fd_);
+        }
+        if (event_fd_ >= 0) {
+            ::close(event_fd_);
+        }
+        throw std::system_error(err, std::generic_category(), "epoll");
+    }
+
+    event.events = EPOLLIN;
+    event.data.fd = event_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &event);
+    event.events = EPOLLIN;
+    event.data.fd = transport_->fd();
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, transport_->fd(), &event);
+
+    thread_ = std::thread(&Client::run, this);
+}
+
+Client::~Client()
+{
+    close();
+    ::close(epoll_fd_);
+    ::close(event_fd_);
+}
+
+void Client::close()
+{
+    stop_.store(true);
+    wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Client::request(Request req, ResponseCallback callback, std::chrono::milliseconds timeout)
+{
+    if (timeout.count() <= 0) {
+        timeout = options_.timeout;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(submit_lock_);
+        if (!closed_.load()) {
+            submitted_.push_back(Pending{std::move(req), std::move(callback), timeout});
+            outstanding_.fetch_add(1, std::memory_order_relaxed);
+            callback = nullptr;
+        }
+    }
+
+    if (callback) {
+        callback(Error::Disconnected, nullptr, Clock::duration::zero());
+    } else {
+        wake();
+    }
+}
+
+std::future<Response> Client::request(Request req, std::chrono::milliseconds timeout)
+{
+    auto promise = std::make_shared<std::promise<Response>>();
+    std::future<Response> future = promise->get_future();
+
+    request(std::move(req), [promise](Error error, const FrameView *frame, Clock::duration latency) {
+        Response rsp;
+        rsp.error = error;
+        rsp.latency = latency;
+        if (frame) {
+            rsp.header = frame->header;
+            rsp.payload.assign(frame->payload, frame->payload + frame->header.len);
+        }
+        promise->set_value(std::move(rsp));
+    }, timeout);
+
+    return future;
+}
+
+Response Client::call(Request req, std::chrono::milliseconds timeout)
+{
+    return request(std::move(req), timeout).get();
+}
+
+int Client::subscribe(uint16_t id, NotifyCallback callback)
+{
+    std::lock_guard<std::mutex> lock(notify_lock_);
+    auto subscribers = std::make_shared<Subscribers>(*subscribers_);
+    int handle = next_handle_ ++;
+
+    subscribers->emplace(id, std::make_pair(handle, std::move(callback)));
+    subscribers_ = std::move(subscribers);
+
+    return handle;
+}
+
+void Client::unsubscribe(int handle)
+{
+    std::lock_guard<std::mutex> lock(notify_lock_);
+    auto subscribers = std::make_shared<Subscribers>(*subscribers_);
+
+    for (auto it = subscribers->begin(); it != subscribers->end(); ++ it) {
+        if (it->second.first == handle) {
+            subscribers->erase(it);
+            break;
+        }
+    }
+    subscribers_ = std::move(subscribers);
+}
+
+Client::Stats Client::stats() const
+{
+    std::lock_guard<std::mutex> lock(stats_lock_);
+    return stats_;
+}
+
+void Client::wake()
+{
+    uint64_t one = 1;
+
+    /* One eventfd write per batch of submissions, the flag is cleared by the client thread before it drains the queue */
+    if (!woken_.exchange(true)) {
+        (void)!::write(event_fd_, &one, sizeof(one));
+    }
+}
+
+void Client::run()
+{
+    struct epoll_event events[4];
+    bool alive = true;
+
+    while (alive && !stop_.load()) {
+        int n = epoll_wait(epoll_fd_, events, 4, wait_ms(Clock::now()));
+
+        if (n < 0 && errno != EINTR) {
+            break;
+        }
+        for (int i = 0; i < n; i ++) {
+            if (events[i].data.fd == event_fd_) {
+                uint64_t count;
+                woken_.store(false);
+                (void)!::read(event_fd_, &count, sizeof(count));
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                alive = receive() && alive;
+            }
+            if (alive && (events[i].events & EPOLLOUT)) {
+                alive = flush();
+            }
+        }
+        if (alive) {
+            send_pending();
+            alive = tx_offset_ == tx_.size() || tx_blocked_ || flush();
+        }
+        expire(Clock::now());
+
+        std::lock_guard<std::mutex> lock(stats_lock_);
+        stats_ = counters_;
+        stats_.rx = decoder_.stats();
+    }
+
+    fail_all();
+}
+
+void Client::send_pending()
+{
+    Clock::time_point now = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(submit_lock_);
+        if (waiting_.empty()) {
+            waiting_.swap(submitted_);
+        } else {
+            for (Pending &pending : submitted_) {
+                waiting_.push_back(std::move(pending));
+            }
+            submitted_.clear();
+        }
+    }
+
+    while (in_flight_ < options_.window && !waiting_.empty()) {
+        Pending pending = std::move(waiting_.front());
+        Header header;
+        uint8_t sn;
+
+        waiting_.pop_front();
+        /* The sn rotates so a late response of a timed out request is unlikely to hit a new one */
+        do {
+            sn = next_sn_ ++;
+        } while (slots_[sn].busy);
+
+        header.version = options_.version;
+        header.type = FrameType::Request;
+        header.id = pending.req.id;
+        header.sn = sn;
+        header.len = static_cast<uint16_t>(pending.req.payload.size());
+        size_t offset = tx_.size();
+        frame_encode(tx_, header, pending.req.payload.data(), pending.req.payload.size());
+        if (options_.capture) {
+            options_.capture->write(CaptureDirection::ToNcp, now, &tx_[offset], tx_.size() - offset);
+        }
+
+        Slot &slot = slots_[sn];
+        slot.busy = true;
+        slot.id = header.id;
+        slot.generation ++;
+        slot.sent = now;
+        slot.callback = std::move(pending.callback);
+        deadlines_.push(Deadline{now + pending.timeout, sn, slot.generation});
+        in_flight_ ++;
+        counters_.requests ++;
+    }
+}
+
+bool Client::flush()
+{
+    while (tx_offset_ < tx_.size()) {
+        ssize_t ret = transport_->write(&tx_[tx_offset_], tx_.size() - tx_offset_);
+
+        if (ret > 0) {
+            tx_offset_ += static_cast<size_t>(ret);
+            counters_.tx_bytes += static_cast<uint64_t>(ret);
+        } else if (ret < 0 && errno == EINTR) {
+            continue;
+        } else if (ret < 0 && errno == EAGAIN) {
+            if (!tx_blocked_) {
+                struct epoll_event event = {};
+                event.events = EPOLLIN | EPOLLOUT;
+                event.data.fd = transport_->fd();
+                epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, transport_->fd(), &event);
+                tx_blocked_ = true;
+            }
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    tx_.clear();
+    tx_offset_ = 0;
+    if (tx_blocked_) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = transport_->fd();
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, transport_->fd(), &event);
+        tx_blocked_ = false;
+    }
+
+    return true;
+}
+
+bool Client::receive()
+{
+    for (int i = 0; i < CLIENT_READ_BURST; i ++) {
+        size_t len;
+        uint8_t *buf = decoder_.prepare(&len);
+        ssize_t ret = transport_->read(buf, len);
+
+        if (ret > 0) {
+            decoder_.commit(static_cast<size_t>(ret), [this](const FrameView &frame) { dispatch(frame); });
+        } else if (ret < 0 && errno == EINTR) {
+            continue;
+        } else if (ret < 0 && errno == EAGAIN) {
+            return true;
+        } else {
+            /* EOF of the socket, EIO of the PTY when the NCP exits */
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Client::dispatch(const FrameView &frame)
+{
+    const Header &header = frame.header;
+
+    /* The NCP encodes SLIP the same way, the frame encoded again is the frame on the wire */
+    if (options_.capture) {
+        capture_buf_.clear();
+        frame_encode(capture_buf_, header, frame.payload, header.len);
+        options_.capture->write(CaptureDirection::FromNcp, Clock::now(), capture_buf_.data(), capture_buf_.size());
+    }
+
+    if (header.type != FrameType::Response || header.id == frame_id::ERROR) {
+        notify(frame);
+        return;
+    }
+
+    Slot &slot = slots_[header.sn];
+    if (!slot.busy || slot.id != header.id) {
+        counters_.unmatched ++;
+        return;
+    }
+
+    ResponseCallback callback = std::move(slot.callback);
+    Clock::duration latency = Clock::now() - slot.sent;
+
+    slot.busy = false;
+    slot.callback = nullptr;
+    in_flight_ --;
+    outstanding_.fetch_sub(1, std::memory_order_relaxed);
+    counters_.responses ++;
+    callback(Error::None, &frame, latency);
+}
+
+void Client::notify(const FrameView &frame)
+{
+    std::shared_ptr<const Subscribers> subscribers;
+
+    counters_.notifications ++;
+    {
+        std::lock_guard<std::mutex> lock(notify_lock_);
+        subscribers = subscribers_;
+    }
+
+    for (uint16_t id : {frame.header.id, ANY_ID}) {
+        auto range = subscribers->equal_range(id);
+        for (auto it = range.first; it != range.second; ++ it) {
+            it->second.second(frame);
+        }
+    }
+}
+
+void Client::expire(Clock::time_point now)
+{
+    while (!deadlines_.empty()) {
+        const Deadline &top = deadlines_.top();
+        Slot &slot = slots_[top.sn];
+        bool stale = !slot.busy || slot.generation != top.generation;
+
+        /* The deadlines of the completed requests are dropped as they surface */
+        if (!stale && top.when > now) {
+            break;
+        }
+        deadlines_.pop();
+        if (stale) {
+            continue;
+        }
+
+        ResponseCallback callback = std::move(slot.callback);
+        Clock::duration latency = now - slot.sent;
+
+        slot.busy = false;
+        slot.callback = nullptr;
+        in_flight_ --;
+        outstanding_.fetch_sub(1, std::memory_order_relaxed);
+        counters_.timeouts ++;
+        callback(Error::Timeout, nullptr, latency);
+    }
+}
+
+int Client::wait_ms(Clock::time_point now) const
+{
+    if (deadlines_.empty()) {
+        return -1;
+    }
+
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadlines_.top().when - now).count() + 1;
+
+    return wait < 0 ? 0 : static_cast<int>(wait);
+}
+
+void Client::fail_all()
+{
+    {
+        std::lock_guard<std::mutex> lock(submit_lock_);
+        closed_.store(true);
+        for (Pending &pending : submitted_) {
+            waiting_.push_back(std::move(pending));
+        }
+        submitted_.clear();
+    }
+
+    for (Slot &slot : slots_) {
+        if (slot.busy) {
+            ResponseCallback callback = std::move(slot.callback);
+            slot.busy = false;
+            slot.callback = nullptr;
+            callback(Error::Disconnected, nullptr, Clock::duration::zero());
+        }
+    }
+    for (Pending &pending : waiting_) {
+        pending.callback(Error::Disconnected, nullptr, Clock::duration::zero());
+    }
+    waiting_.clear();
+    in_flight_ = 0;
+    outstanding_.store(0);
+    while (!deadlines_.empty()) {
+        deadlines_.pop();
+    }
+}
+
+} // namespace esp_ncp
@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <array>
+#include <cstdio>
+
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/frame_id.hpp"
+
+namespace esp_ncp {
+
+namespace {
+
+/* CRC-16/CCITT reflected (0x8408), the table of the ROM crc16_le */
+constexpr std::array<uint16_t, 256> crc16_le_table_make()
+{
+    std::array<uint16_t, 256> table{};
+
+    for (uint32_t i = 0; i < 256; i ++) {
+        uint16_t crc = static_cast<uint16_t>(i);
+        for (int bit = 0; bit < 8; bit ++) {
+            crc = (crc & 1) ? static_cast<uint16_t>((crc >> 1) ^ 0x8408) : static_cast<uint16_t>(crc >> 1);
+        }
+        table[i] = crc;
+    }
+
+    return table;
+}
+
+constexpr std::array<uint16_t, 256> s_crc16_le_table = crc16_le_table_make();
+
+inline void slip_put(std::vector<uint8_t> &out, uint8_t c)
+{
+    if (c == SLIP_END) {
+        out.push_back(SLIP_ESC);
+        out.push_back(SLIP_ESC_END);
+    } else if (c == SLIP_ESC) {
+        out.push_back(SLIP_ESC);
+        out.push_back(SLIP_ESC_ESC);
+    } else {
+        out.push_back(c);
+    }
+}
+
+} // namespace
+
+uint16_t crc16_le(uint16_t crc, const uint8_t *data, size_t len)
+{
+    crc = static_cast<uint16_t>(~crc);
+    for (size_t i = 0; i < len; i ++) {
+        crc = static_cast<uint16_t>(s_crc16_le_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8));
+    }
+
+    return static_cast<uint16_t>(~crc);
+}
+
+void frame_encode(std::vector<uint8_t> &out, const Header &header, const uint8_t *payload, size_t len)
+{
+    uint8_t head[HEADER_SIZE] = {
+        static_cast<uint8_t>((header.version & 0x0F) | (static_cast<uint8_t>(header.type) << 4)),
+        0,
+        static_cast<uint8_t>(header.id),
+        static_cast<uint8_t>(header.id >> 8),
+        header.sn,
+        static_cast<uint8_t>(len),
+        static_cast<uint8_t>(len >> 8),
+    };
+    /* The CRC chains, the result of the header is the initial value of the payload */
+    uint16_t crc = crc16_le(crc16_le(UINT16_MAX, head, sizeof(head)), payload, payload ? len : 0);
+
+    /* Worst case every byte is escaped */
+    out.reserve(out.size() + 2 * (sizeof(head) + len + CRC_SIZE) + 2);
+    out.push_back(SLIP_END);
+    for (uint8_t c : head) {
+        slip_put(out, c);
+    }
+    for (size_t i = 0; payload && i < len; i ++) {
+        slip_put(out, payload[i]);
+    }
+    slip_put(out, static_cast<uint8_t>(crc));
+    slip_put(out, static_cast<uint8_t>(crc >> 8));
+    out.push_back(SLIP_END);
+}
+
+FrameDecoder::FrameDecoder(size_t capacity) : buf_(capacity)
+{
+}
+
+uint8_t *FrameDecoder::prepare(size_t *len)
+{
+    /* A partial frame filling the whole buffer can not be a valid frame */
+    if (tail_ == buf_.size()) {
+        stats_.oversize ++;
+        drop_ = true;
+        esc_ = false;
+        start_ = out_ = tail_ = 0;
+    }
+
+    *len = buf_.size() - tail_;
+
+    return &buf_[tail_];
+}
+
+void FrameDecoder::reset()
+{
+    start_ = out_ = tail_ = 0;
+    esc_ = false;
+    drop_ = false;
+}
+
+bool FrameDecoder::parse(const uint8_t *data, size_t size, FrameView *frame)
+{
+    if (size < HEADER_SIZE + CRC_SIZE) {
+        stats_.format_errors ++;
+        return false;
+    }
+
+    Header &header = frame->header;
+    header.version = data[0] & 0x0F;
+    header.type = static_cast<FrameType>(data[0] >> 4);
+    header.id = static_cast<uint16_t>(data[2] | (data[3] << 8));
+    header.sn = data[4];
+    header.len = static_cast<uint16_t>(data[5] | (data[6] << 8));
+
+    if (HEADER_SIZE + header.len + CRC_SIZE != size) {
+        stats_.format_errors ++;
+        return false;
+    }
+
+    uint16_t crc = static_cast<uint16_t>(data[size - 2] | (data[size - 1] << 8));
+    if (crc16_le(UINT16_MAX, data, size - CRC_SIZE) != crc) {
+        stats_.crc_errors ++;
+        return false;
+    }
+
+    frame->payload = data + HEADER_SIZE;
+    stats_.frames ++;
+
+    return true;
+}
+
+void FrameDecoder::compact()
+{
+    /* Only the unescaped bytes of the partial frame are kept, the raw bytes behind them are consumed */
+    size_t partial = out_ - start_;
+
+    if (start_ && partial) {
+        std::memmove(&buf_[0], &buf_[start_], partial);
+    }
+    start_ = 0;
+    out_ = tail_ = partial;
+}
+
+std::string frame_to_string(const FrameView &frame)
+{
+    static const char *const type_name[] = {"REQ", "RSP", "NTF"};
+    const Header &header = frame.header;
+    uint8_t type = static_cast<uint8_t>(header.type);
+    char line[96];
+    std::string text;
+
+    snprintf(line, sizeof(line), "%s %s(0x%04x) sn %u len %u:", type < 3 ? type_name[type] : "???",
+             frame_id_name(header.id), header.id, header.sn, header.len);
+    text = line;
+    for (uint16_t i = 0; i < header.len; i ++) {
+        snprintf(line, sizeof(line), " %02x", frame.payload[i]);
+        text += line;
+    }
+
+    return text;
+}
+
+} // namespace esp_ncp
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ncp/frame_id.hpp"
+
+namespace esp_ncp {
+
+const char *frame_id_name(uint16_t id)
+{
+    switch (id) {
+    case frame_id::NETWORK_INIT: return "NETWORK_INIT";
+    case frame_id::NETWORK_START: return "NETWORK_START";
+    case frame_id::NETWORK_STATE: return "NETWORK_STATE";
+    case frame_id::NETWORK_STACK_STATUS_HANDLER: return "NETWORK_STACK_STATUS_HANDLER";
+    case frame_id::NETWORK_FORMNETWORK: return "NETWORK_FORMNETWORK";
+    case frame_id::NETWORK_PERMIT_JOINING: return "NETWORK_PERMIT_JOINING";
+    case frame_id::NETWORK_JOINNETWORK: return "NETWORK_JOINNETWORK";
+    case frame_id::NETWORK_LEAVENETWORK: return "NETWORK_LEAVENETWORK";
+    case frame_id::NETWORK_START_SCAN: return "NETWORK_START_SCAN";
+    case frame_id::NETWORK_SCAN_COMPLETE_HANDLER: return "NETWORK_SCAN_COMPLETE_HANDLER";
+    case frame_id::NETWORK_STOP_SCAN: return "NETWORK_STOP_SCAN";
+    case frame_id::NETWORK_PAN_ID_GET: return "NETWORK_PAN_ID_GET";
+    case frame_id::NETWORK_PAN_ID_SET: return "NETWORK_PAN_ID_SET";
+    case frame_id::NETWORK_EXTENDED_PAN_ID_GET: return "NETWORK_EXTENDED_PAN_ID_GET";
+    case frame_id::NETWORK_EXTENDED_PAN_ID_SET: return "NETWORK_EXTENDED_PAN_ID_SET";
+    case frame_id::NETWORK_PRIMARY_CHANNEL_GET: return "NETWORK_PRIMARY_CHANNEL_GET";
+    case frame_id::NETWORK_PRIMARY_CHANNEL_SET: return "NETWORK_PRIMARY_CHANNEL_SET";
+    case frame_id::NETWORK_SECONDARY_CHANNEL_GET: return "NETWORK_SECONDARY_CHANNEL_GET";
+    case frame_id::NETWORK_SECONDARY_CHANNEL_SET: return "NETWORK_SECONDARY_CHANNEL_SET";
+    case frame_id::NETWORK_CHANNEL_GET: return "NETWORK_CHANNEL_GET";
+    case frame_id::NETWORK_CHANNEL_SET: return "NETWORK_CHANNEL_SET";
+    case frame_id::NETWORK_TXPOWER_GET: return "NETWORK_TXPOWER_GET";
+    case frame_id::NETWORK_TXPOWER_SET: return "NETWORK_TXPOWER_SET";
+    case frame_id::NETWORK_PRIMARY_KEY_GET: return "NETWORK_PRIMARY_KEY_GET";
+    case frame_id::NETWORK_PRIMARY_KEY_SET: return "NETWORK_PRIMARY_KEY_SET";
+    case frame_id::NETWORK_FRAME_COUNT_GET: return "NETWORK_FRAME_COUNT_GET";
+    case frame_id::NETWORK_FRAME_COUNT_SET: return "NETWORK_FRAME_COUNT_SET";
+    case frame_id::NETWORK_ROLE_GET: return "NETWORK_ROLE_GET";
+    case frame_id::NETWORK_ROLE_SET: return "NETWORK_ROLE_SET";
+    case frame_id::NETWORK_SHORT_ADDRESS_GET: return "NETWORK_SHORT_ADDRESS_GET";
+    case frame_id::NETWORK_SHORT_ADDRESS_SET: return "NETWORK_SHORT_ADDRESS_SET";
+    case frame_id::NETWORK_LONG_ADDRESS_GET: return "NETWORK_LONG_ADDRESS_GET";
+    case frame_id::NETWORK_LONG_ADDRESS_SET: return "NETWORK_LONG_ADDRESS_SET";
+    case frame_id::NETWORK_CHANNEL_MASKS_GET: return "NETWORK_CHANNEL_MASKS_GET";
+    case frame_id::NETWORK_CHANNEL_MASKS_SET: return "NETWORK_CHANNEL_MASKS_SET";
+    case frame_id::NETWORK_UPDATE_ID_GET: return "NETWORK_UPDATE_ID_GET";
+    case frame_id::NETWORK_UPDATE_ID_SET: return "NETWORK_UPDATE_ID_SET";
+    case frame_id::NETWORK_TRUST_CENTER_ADDR_GET: return "NETWORK_TRUST_CENTER_ADDR_GET";
+    case frame_id::NETWORK_TRUST_CENTER_ADDR_SET: return "NETWORK_TRUST_CENTER_ADDR_SET";
+    case frame_id::NETWORK_LINK_KEY_GET: return "NETWORK_LINK_KEY_GET";
+    case frame_id::NETWORK_LINK_KEY_SET: return "NETWORK_LINK_KEY_SET";
+    case frame_id::NETWORK_SECURE_MODE_GET: return "NETWORK_SECURE_MODE_GET";
+    case frame_id::NETWORK_SECURE_MODE_SET: return "NETWORK_SECURE_MODE_SET";
+    case frame_id::NETWORK_PREDEFINED_PANID: return "NETWORK_PREDEFINED_PANID";
+    case frame_id::NETWORK_SHORT_TO_IEEE: return "NETWORK_SHORT_TO_IEEE";
+    case frame_id::NETWORK_IEEE_TO_SHORT: return "NETWORK_IEEE_TO_SHORT";
+    case frame_id::NETWORK_SCAN_RESULT: return "NETWORK_SCAN_RESULT";
+    case frame_id::NETWORK_NEIGHBOR_TABLE_GET: return "NETWORK_NEIGHBOR_TABLE_GET";
+    case frame_id::NETWORK_ROUTE_TABLE_GET: return "NETWORK_ROUTE_TABLE_GET";
+    case frame_id::NETWORK_ROUTE_RECORD_TABLE_GET: return "NETWORK_ROUTE_RECORD_TABLE_GET";
+    case frame_id::NETWORK_SIGNAL_SUBSCRIBE: return "NETWORK_SIGNAL_SUBSCRIBE";
+    case frame_id::NETWORK_SIGNAL: return "NETWORK_SIGNAL";
+    case frame_id::NETWORK_JOIN_BATCH: return "NETWORK_JOIN_BATCH";
+    case frame_id::NETWORK_JOIN_BATCH_CONFIG: return "NETWORK_JOIN_BATCH_CONFIG";
+    case frame_id::NETWORK_IC_ADD_BULK: return "NETWORK_IC_ADD_BULK";
+    case frame_id::NETWORK_IC_REMOVE_BULK: return "NETWORK_IC_REMOVE_BULK";
+    case frame_id::ZCL_ENDPOINT_ADD: return "ZCL_ENDPOINT_ADD";
+    case frame_id::ZCL_ENDPOINT_DEL: return "ZCL_ENDPOINT_DEL";
+    case frame_id::ZCL_ATTR_READ: return "ZCL_ATTR_READ";
+    case frame_id::ZCL_ATTR_WRITE: return "ZCL_ATTR_WRITE";
+    case frame_id::ZCL_ATTR_REPORT: return "ZCL_ATTR_REPORT";
+    case frame_id::ZCL_ATTR_DISC: return "ZCL_ATTR_DISC";
+    case frame_id::ZCL_READ: return "ZCL_READ";
+    case frame_id::ZCL_WRITE: return "ZCL_WRITE";
+    case frame_id::ZCL_REPORT_CONFIG: return "ZCL_REPORT_CONFIG";
+    case frame_id::ZCL_ATTR_READ_BULK: return "ZCL_ATTR_READ_BULK";
+    case frame_id::ZCL_SCHED_CONFIG: return "ZCL_SCHED_CONFIG";
+    case frame_id::ZCL_SCHED_STATS: return "ZCL_SCHED_STATS";
+    case frame_id::ZCL_WRITE_MULTI: return "ZCL_WRITE_MULTI";
+    case frame_id::ZCL_GROUPCAST_STATS: return "ZCL_GROUPCAST_STATS";
+    case frame_id::ZCL_RULE_ADD: return "ZCL_RULE_ADD";
+    case frame_id::ZCL_RULE_DEL: return "ZCL_RULE_DEL";
+    case frame_id::ZCL_RULE_STATS: return "ZCL_RULE_STATS";
+    case frame_id::ZCL_RULE_FIRED: return "ZCL_RULE_FIRED";
+    case frame_id::ZCL_TIMER_ADD: return "ZCL_TIMER_ADD";
+    case frame_id::ZCL_TIMER_CANCEL: return "ZCL_TIMER_CANCEL";
+    case frame_id::ZCL_TIMER_LIST: return "ZCL_TIMER_LIST";
+    case frame_id::ZCL_TIMER_STATS: return "ZCL_TIMER_STATS";
+    case frame_id::ZDO_BIND_SET: return "ZDO_BIND_SET";
+    case frame_id::ZDO_UNBIND_SET: return "ZDO_UNBIND_SET";
+    case frame_id::ZDO_FIND_MATCH: return "ZDO_FIND_MATCH";
+    case frame_id::ZDO_INTERROGATE_CONFIG: return "ZDO_INTERROGATE_CONFIG";
+    case frame_id::ZDO_INTERROGATE: return "ZDO_INTERROGATE";
+    case frame_id::ZDO_DEVICE_PROFILE: return "ZDO_DEVICE_PROFILE";
+    case frame_id::APS_DATA_REQUEST: return "APS_DATA_REQUEST";
+    case frame_id::APS_DATA_INDICATION: return "APS_DATA_INDICATION";
+    case frame_id::APS_DATA_CONFIRM: return "APS_DATA_CONFIRM";
+    case frame_id::APS_DATA_REQUEST_BULK: return "APS_DATA_REQUEST_BULK";
+    case frame_id::ERROR: return "ERROR";
+    case frame_id::MUX_FILTER_SET: return "MUX_FILTER_SET";
+    case frame_id::MUX_STATS: return "MUX_STATS";
+    case frame_id::MUX_DROPPED: return "MUX_DROPPED";
+    default: return "UNKNOWN";
+    }
+}
+
+} // namespace esp_ncp
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ncp/histogram.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <stdexcept>
+
+namespace esp_ncp {
+
+namespace {
+
+uint32_t bit_length(uint64_t value)
+{
+    return value ? 64 - static_cast<uint32_t>(__builtin_clzll(value)) : 0;
+}
+
+} // namespace
+
+Histogram::Histogram(uint64_t highest, int significant_digits)
+    : highest_(std::max<uint64_t>(highest, 2))
+{
+    if (significant_digits < 1 || significant_digits > 5) {
+        throw std::invalid_argument("histogram: significant digits out of 1..5");
+    }
+
+    /* Enough sub-buckets to tell apart two values one unit of the last digit apart */
+    uint64_t largest_single_unit = 2 * static_cast<uint64_t>(std::pow(10, significant_digits));
+    uint32_t sub_bucket_magnitude = bit_length(largest_single_unit - 1);
+
+    sub_bucket_count_ = 1u << sub_bucket_magnitude;
+    sub_bucket_half_count_ = sub_bucket_count_ / 2;
+    sub_bucket_half_magnitude_ = sub_bucket_magnitude - 1;
+    sub_bucket_mask_ = sub_bucket_count_ - 1;
+
+    uint64_t smallest_untrackable = sub_bucket_count_;
+    bucket_count_ = 1;
+    while (smallest_untrackable <= highest_) {
+        if (smallest_untrackable > (UINT64_MAX >> 1)) {
+            bucket_count_ ++;
+            break;
+        }
+        smallest_untrackable <<= 1;
+        bucket_count_ ++;
+    }
+    counts_.assign((bucket_count_ + 1) * sub_bucket_half_count_, 0);
+}
+
+size_t Histogram::index_of(uint64_t value) const
+{
+    uint32_t bucket = bit_length(value | sub_bucket_mask_) - (sub_bucket_half_magnitude_ + 1);
+    uint64_t sub_bucket = value >> bucket;
+
+    return ((static_cast<size_t>(bucket) + 1) << sub_bucket_half_magnitude_) + (sub_bucket - sub_bucket_half_count_);
+}
+
+uint64_t Histogram::value_of(size_t index) const
+{
+    int64_t bucket = static_cast<int64_t>(index >> sub_bucket_half_magnitude_) - 1;
+    uint64_t sub_bucket = (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+
+    if (bucket < 0) {
+        sub_bucket -= sub_bucket_half_count_;
+        bucket = 0;
+    }
+
+    return sub_bucket << bucket;
+}
+
+uint64_t Histogram::lowest_equivalent(uint64_t value) const
+{
+    return value_of(index_of(value));
+}
+
+uint64_t Histogram::highest_equivalent(uint64_t value) const
+{
+    uint32_t bucket = bit_length(value | sub_bucket_mask_) - (sub_bucket_half_magnitude_ + 1);
+
+    return lowest_equivalent(value) + (1ULL << bucket) - 1;
+}
+
+uint64_t Histogram::median_equivalent(uint64_t value) const
+{
+    uint32_t bucket = bit_length(value | sub_bucket_mask_) - (sub_bucket_half_magnitude_ + 1);
+
+    return lowest_equivalent(value) + ((1ULL << bucket) >> 1);
+}
+
+void Histogram::record(uint64_t value, uint64_t count)
+{
+    value = std::min(value, highest_);
+    counts_[std::min(index_of(value), counts_.size() - 1)] += count;
+    total_ += count;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    if (other.sub_bucket_count_ != sub_bucket_count_) {
+        throw std::invalid_argument("histogram: merge of a different precision");
+    }
+
+    for (size_t i = 0; i < other.counts_.size(); i ++) {
+        if (other.counts_[i]) {
+            record(other.value_of(i), other.counts_[i]);
+        }
+    }
+}
+
+void Histogram::reset()
+{
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+uint64_t Histogram::min() const
+{
+    return total_ ? lowest_equivalent(min_) : 0;
+}
+
+uint64_t Histogram::max() const
+{
+    return total_ ? highest_equivalent(max_) : 0;
+}
+
+double Histogram::mean() const
+{
+    double sum = 0;
+
+    if (!total_) {
+        return 0;
+    }
+    for (size_t i = 0; i < counts_.size(); i ++) {
+        if (counts_[i]) {
+            sum += static_cast<double>(median_equivalent(value_of(i))) * static_cast<double>(counts_[i]);
+        }
+    }
+
+    return sum / static_cast<double>(total_);
+}
+
+double Histogram::stddev() const
+{
+    double average = mean();
+    double sum = 0;
+
+    if (!total_) {
+        return 0;
+    }
+    for (size_t i = 0; i < counts_.size(); i ++) {
+        if (counts_[i]) {
+            double deviation = static_cast<double>(median_equivalent(value_of(i))) - average;
+            sum += deviation * deviation * static_cast<double>(counts_[i]);
+        }
+    }
+
+    return std::sqrt(sum / static_cast<double>(total_));
+}
+
+uint64_t Histogram::value_at(double percentile) const
+{
+    uint64_t target = static_cast<uint64_t>(std::min(percentile, 100.0) / 100.0 * static_cast<double>(total_) + 0.5);
+    uint64_t cumulative = 0;
+
+    target = std::max<uint64_t>(target, 1);
+    for (size_t i = 0; i < counts_.size(); i ++) {
+        cumulative += counts_[i];
+        if (cumulative >= target) {
+            return std::min(highest_equivalent(value_of(i)), max());
+        }
+    }
+
+    return 0;
+}
+
+void Histogram::print_percentiles(FILE *out, double scale, uint32_t ticks_per_half) const
+{
+    double percentile_to = 0;
+    uint64_t cumulative = 0;
+
+    fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    for (size_t i = 0; i < counts_.size() && total_; i ++) {
+        if (!counts_[i]) {
+            continue;
+        }
+        cumulative += counts_[i];
+
+        double reached = 100.0 * static_cast<double>(cumulative) / static_cast<double>(total_);
+        double value = static_cast<double>(std::min(highest_equivalent(value_of(i)), max())) / scale;
+        if (cumulative == total_) {
+            fprintf(out, "%12.3f %2.12f %10" PRIu64 "\n", value, 1.0, cumulative);
+            break;
+        }
+        /* The lines get denser toward 100%, ticks_per_half each time the distance halves */
+        while (reached >= percentile_to) {
+            fprintf(out, "%12.3f %2.12f %10" PRIu64 " %14.2f\n", value, percentile_to / 100.0, cumulative,
+                    1.0 / (1.0 - percentile_to / 100.0));
+            double half_distance = std::pow(2, std::floor(std::log2(100.0 / (100.0 - percentile_to))) + 1);
+            percentile_to += 100.0 / (static_cast<double>(ticks_per_half) * half_distance);
+        }
+    }
+    fprintf(out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / scale, stddev() / scale);
+    fprintf(out, "#[Max     = %12.3f, Total count    = %12" PRIu64 "]\n", static_cast<double>(max()) / scale, total_);
+    fprintf(out, "#[Buckets = %12u, SubBuckets     = %12u]\n", bucket_count_, sub_bucket_count_);
+}
+
+} // namespace esp_ncp
@@ -0,0 +1,563 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/request.hpp"
+#include "esp_ncp/wire.hpp"
+
+namespace esp_ncp {
+namespace request {
+
+namespace {
+
+/* esp_zb_addr_u, the short address or the long address in 8 bytes */
+void put_addr(Writer &w, AddrMode mode, uint16_t short_addr, const IeeeAddr &ieee_addr)
+{
+    if (mode == AddrMode::Ieee) {
+        w.bytes(ieee_addr.data(), ieee_addr.size());
+    } else {
+        w.put<uint16_t>(short_addr).zeros(6);
+    }
+}
+
+/* esp_zb_zcl_basic_cmd_t, 10 bytes */
+void put_basic_cmd(Writer &w, const Destination &dst)
+{
+    put_addr(w, dst.mode, dst.short_addr, dst.ieee_addr);
+    w.put<uint8_t>(dst.dst_endpoint).put<uint8_t>(dst.src_endpoint);
+}
+
+wire::ZclBasicCmd wire_basic_cmd(const Destination &dst)
+{
+    wire::ZclBasicCmd basic_cmd;
+
+    basic_cmd.dst_addr = (dst.mode == AddrMode::Ieee) ? wire::Addr::from_long(dst.ieee_addr) : wire::Addr::from_short(dst.short_addr);
+    basic_cmd.dst_endpoint = dst.dst_endpoint;
+    basic_cmd.src_endpoint = dst.src_endpoint;
+
+    return basic_cmd;
+}
+
+void put_list(Writer &w, const std::vector<uint16_t> &list)
+{
+    for (uint16_t value : list) {
+        w.put<uint16_t>(value);
+    }
+}
+
+template <typename T>
+Request scalar(uint16_t id, T value)
+{
+    Request req{id, {}};
+    Writer(req.payload).put<T>(value);
+    return req;
+}
+
+Request array(uint16_t id, const uint8_t *data, size_t len)
+{
+    return Request{id, Bytes(data, data + len)};
+}
+
+/* esp_zb_cfg_t as laid out by the compiler of the 32-bit NCP: the role is an enum of 4 bytes and the union is aligned to 4 */
+Request form(uint8_t role, bool install_code_policy, uint8_t first, uint32_t keep_alive)
+{
+    Request req{frame_id::NETWORK_FORMNETWORK, {}};
+    Writer(req.payload).put<uint32_t>(role).put<uint8_t>(install_code_policy).zeros(3)
+                       .put<uint8_t>(first).zeros(3).put<uint32_t>(keep_alive);
+    return req;
+}
+
+/* esp_zb_zdo_bind_req_param_t as laid out by the compiler of the 32-bit NCP, followed by esp_ncp_zb_user_cb_t */
+Request bind(uint16_t id, const Binding &b, uint32_t user_cb, uint32_t user_ctx)
+{
+    Request req{id, {}};
+    Writer w(req.payload);
+
+    w.bytes(b.src_address.data(), b.src_address.size());
+    w.put<uint8_t>(b.src_endpoint).zeros(1).put<uint16_t>(b.cluster_id);
+    w.put<uint8_t>(b.dst_addr_mode).zeros(1);
+    if (b.dst_addr_mode == 0x03) {
+        w.bytes(b.dst_ieee_addr.data(), b.dst_ieee_addr.size());
+    } else {
+        w.put<uint16_t>(b.dst_short_addr).zeros(6);
+    }
+    w.put<uint8_t>(b.dst_endpoint).zeros(1).put<uint16_t>(b.req_dst_addr);
+    w.put<uint32_t>(user_cb).put<uint32_t>(user_ctx);
+
+    return req;
+}
+
+/* The ZCL command structs of the report and discover requests as laid out by the compiler of the 32-bit NCP */
+void put_zcl_cmd_head(Writer &w, const Destination &dst, uint16_t cluster_id, uint8_t direction, uint16_t manuf_code)
+{
+    put_basic_cmd(w, dst);
+    w.zeros(2).put<uint32_t>(static_cast<uint8_t>(dst.mode)).put<uint16_t>(cluster_id);
+    w.put<uint8_t>(static_cast<uint8_t>((direction & 0x01) << 2)).zeros(1).put<uint16_t>(manuf_code);
+}
+
+} // namespace
+
+Request raw(uint16_t id, Bytes payload)
+{
+    return Request{id, std::move(payload)};
+}
+
+Request network_init() { return raw(frame_id::NETWORK_INIT); }
+Request network_start(bool autostart) { return scalar<uint8_t>(frame_id::NETWORK_START, autostart); }
+Request network_state() { return raw(frame_id::NETWORK_STATE); }
+Request network_stack_status() { return scalar<uint8_t>(frame_id::NETWORK_STACK_STATUS_HANDLER, 0); }
+
+Request network_form_coordinator(uint8_t max_children, bool install_code_policy)
+{
+    return form(0x00, install_code_policy, max_children, 0);
+}
+
+Request network_form_router(uint8_t max_children, bool install_code_policy)
+{
+    return form(0x01, install_code_policy, max_children, 0);
+}
+
+Request network_form_end_device(uint8_t ed_timeout, uint32_t keep_alive_ms, bool install_code_policy)
+{
+    return form(0x02, install_code_policy, ed_timeout, keep_alive_ms);
+}
+
+Request network_start_scan(uint32_t channel_mask, uint8_t scan_duration, bool streaming)
+{
+    Request req{frame_id::NETWORK_START_SCAN, {}};
+    Writer(req.payload).put<uint32_t>(channel_mask).put<uint8_t>(scan_duration).put<uint8_t>(streaming);
+    return req;
+}
+
+Request network_stop_scan() { return raw(frame_id::NETWORK_STOP_SCAN); }
+Request network_pan_id_get() { return raw(frame_id::NETWORK_PAN_ID_GET); }
+Request network_pan_id_set(uint16_t pan_id) { return scalar<uint16_t>(frame_id::NETWORK_PAN_ID_SET, pan_id); }
+Request network_extended_pan_id_get() { return raw(frame_id::NETWORK_EXTENDED_PAN_ID_GET); }
+
+Request network_extended_pan_id_set(const IeeeAddr &extended_pan_id)
+{
+    return array(frame_id::NETWORK_EXTENDED_PAN_ID_SET, extended_pan_id.data(), extended_pan_id.size());
+}
+
+Request network_primary_channel_get() { return raw(frame_id::NETWORK_PRIMARY_CHANNEL_GET); }
+Request network_primary_channel_set(uint32_t channel_mask) { return scalar<uint32_t>(frame_id::NETWORK_PRIMARY_CHANNEL_SET, channel_mask); }
+Request network_secondary_channel_set(uint32_t channel_mask) { return scalar<uint32_t>(frame_id::NETWORK_SECONDARY_CHANNEL_SET, channel_mask); }
+Request network_channel_get() { return raw(frame_id::NETWORK_CHANNEL_GET); }
+Request network_channel_set(uint32_t channel_mask) { return scalar<uint32_t>(frame_id::NETWORK_CHANNEL_SET, channel_mask); }
+Request network_channel_masks_set(uint32_t channel_mask) { return scalar<uint32_t>(frame_id::NETWORK_CHANNEL_MASKS_SET, channel_mask); }
+Request network_txpower_set(int8_t power) { return scalar<int8_t>(frame_id::NETWORK_TXPOWER_SET, power); }
+Request network_primary_key_get() { return raw(frame_id::NETWORK_PRIMARY_KEY_GET); }
+Request network_primary_key_set(const Key &key) { return array(frame_id::NETWORK_PRIMARY_KEY_SET, key.data(), key.size()); }
+Request network_frame_count_get() { return raw(frame_id::NETWORK_FRAME_COUNT_GET); }
+Request network_frame_count_set(uint32_t frame_count) { return scalar<uint32_t>(frame_id::NETWORK_FRAME_COUNT_SET, frame_count); }
+Request network_role_get() { return raw(frame_id::NETWORK_ROLE_GET); }
+Request network_role_set(uint8_t role) { return scalar<uint8_t>(frame_id::NETWORK_ROLE_SET, role); }
+Request network_short_address_get() { return raw(frame_id::NETWORK_SHORT_ADDRESS_GET); }
+Request network_short_address_set(uint16_t short_addr) { return scalar<uint16_t>(frame_id::NETWORK_SHORT_ADDRESS_SET, short_addr); }
+Request network_long_address_get() { return raw(frame_id::NETWORK_LONG_ADDRESS_GET); }
+
+Request network_long_address_set(const IeeeAddr &ieee_addr)
+{
+    return array(frame_id::NETWORK_LONG_ADDRESS_SET, ieee_addr.data(), ieee_addr.size());
+}
+
+Request network_update_id_get() { return raw(frame_id::NETWORK_UPDATE_ID_GET); }
+Request network_update_id_set(uint8_t update_id) { return scalar<uint8_t>(frame_id::NETWORK_UPDATE_ID_SET, update_id); }
+Request network_trust_center_addr_get() { return raw(frame_id::NETWORK_TRUST_CENTER_ADDR_GET); }
+
+Request network_trust_center_addr_set(const IeeeAddr &ieee_addr)
+{
+    return array(frame_id::NETWORK_TRUST_CENTER_ADDR_SET, ieee_addr.data(), ieee_addr.size());
+}
+
+Request network_link_key_get() { return raw(frame_id::NETWORK_LINK_KEY_GET); }
+Request network_link_key_set(const Key &key) { return array(frame_id::NETWORK_LINK_KEY_SET, key.data(), key.size()); }
+Request network_secure_mode_get() { return raw(frame_id::NETWORK_SECURE_MODE_GET); }
+Request network_secure_mode_set(uint8_t mode) { return scalar<uint8_t>(frame_id::NETWORK_SECURE_MODE_SET, mode); }
+Request network_predefined_panid(bool enable) { return scalar<uint8_t>(frame_id::NETWORK_PREDEFINED_PANID, enable); }
+Request network_short_to_ieee(uint16_t short_addr) { return scalar<uint16_t>(frame_id::NETWORK_SHORT_TO_IEEE, short_addr); }
+
+Request network_ieee_to_short(const IeeeAddr &ieee_addr)
+{
+    return array(frame_id::NETWORK_IEEE_TO_SHORT, ieee_addr.data(), ieee_addr.size());
+}
+
+Request network_neighbor_table_get(uint32_t known_generation)
+{
+    return scalar<uint32_t>(frame_id::NETWORK_NEIGHBOR_TABLE_GET, known_generation);
+}
+
+Request network_route_table_get(uint32_t known_generation)
+{
+    return scalar<uint32_t>(frame_id::NETWORK_ROUTE_TABLE_GET, known_generation);
+}
+
+Request network_route_record_table_get(uint32_t known_generation)
+{
+    return scalar<uint32_t>(frame_id::NETWORK_ROUTE_RECORD_TABLE_GET, known_generation);
+}
+
+Request network_signal_subscribe(uint64_t signal_mask)
+{
+    wire::NetworkSignalSubscribe msg;
+
+    msg.signal_mask = signal_mask;
+
+    return Request{frame_id::NETWORK_SIGNAL_SUBSCRIBE, wire::encode(msg)};
+}
+
+Request network_join_batch_config(bool enable, uint8_t max_records, uint16_t flush_ms)
+{
+    wire::NetworkJoinBatchConfig msg;
+
+    msg.enable = enable;
+    msg.max_records = max_records;
+    msg.flush_ms = flush_ms;
+
+    return Request{frame_id::NETWORK_JOIN_BATCH_CONFIG, wire::encode(msg)};
+}
+
+Request network_ic_add_bulk(const std::vector<InstallCode> &codes)
+{
+    Request req{frame_id::NETWORK_IC_ADD_BULK, {}};
+    Writer w(req.payload);
+
+    w.put<uint16_t>(static_cast<uint16_t>(codes.size()));
+    for (const InstallCode &ic : codes) {
+        w.bytes(ic.ieee_addr.data(), ic.ieee_addr.size()).put<uint8_t>(ic.type).bytes(ic.code.data(), ic.code.size());
+    }
+
+    return req;
+}
+
+Request network_ic_remove_bulk(const std::vector<IeeeAddr> &devices)
+{
+    wire::NetworkIcRemoveBulk msg;
+
+    for (const IeeeAddr &ieee_addr : devices) {
+        msg.records.push_back(wire::IcRemoveRecord{wire::Addr::from_long(ieee_addr)});
+    }
+
+    return Request{frame_id::NETWORK_IC_REMOVE_BULK, wire::encode(msg)};
+}
+
+Request zcl_endpoint_add(uint8_t endpoint, uint16_t profile_id, uint16_t device_id, const std::vector<uint16_t> &in_clusters,
+                         const std::vector<uint16_t> &out_clusters, uint8_t app_flags)
+{
+    Request req{frame_id::ZCL_ENDPOINT_ADD, {}};
+    Writer w(req.payload);
+
+    w.put<uint8_t>(endpoint).put<uint16_t>(profile_id).put<uint16_t>(device_id).put<uint8_t>(app_flags);
+    w.put<uint8_t>(static_cast<uint8_t>(in_clusters.size())).put<uint8_t>(static_cast<uint8_t>(out_clusters.size()));
+    put_list(w, in_clusters);
+    put_list(w, out_clusters);
+
+    return req;
+}
+
+Request zcl_endpoint_del(uint8_t endpoint) { return scalar<uint8_t>(frame_id::ZCL_ENDPOINT_DEL, endpoint); }
+
+Request zcl_attr_read(const Destination &dst, uint16_t cluster_id, const std::vector<uint16_t> &attr_ids)
+{
+    wire::ZclAttrRead msg;
+
+    msg.zcl_basic_cmd = wire_basic_cmd(dst);
+    msg.address_mode = static_cast<uint8_t>(dst.mode);
+    msg.cluster_id = cluster_id;
+    msg.attr_field = attr_ids;
+
+    return Request{frame_id::ZCL_ATTR_READ, wire::encode(msg)};
+}
+
+Request zcl_attr_write(const Destination &dst, uint16_t cluster_id, const std::vector<AttrValue> &attrs)
+{
+    wire::ZclAttrWrite msg;
+
+    msg.zcl_basic_cmd = wire_basic_cmd(dst);
+    msg.address_mode = static_cast<uint8_t>(dst.mode);
+    msg.cluster_id = cluster_id;
+    for (const AttrValue &attr : attrs) {
+        msg.attr_field.push_back(wire::ZclAttrData{attr.id, attr.type, attr.value});
+    }
+
+    return Request{frame_id::ZCL_ATTR_WRITE, wire::encode(msg)};
+}
+
+Request zcl_attr_report(const Destination &dst, uint16_t cluster_id, uint16_t attr_id, uint8_t direction, uint16_t manuf_code)
+{
+    Request req{frame_id::ZCL_ATTR_REPORT, {}};
+    Writer w(req.payload);
+
+    put_zcl_cmd_head(w, dst, cluster_id, direction, manuf_code);
+    w.put<uint16_t>(attr_id);
+
+    return req;
+}
+
+Request zcl_attr_disc(const Destination &dst, uint16_t cluster_id, uint16_t start_attr_id, uint8_t max_attr_number,
+                      uint8_t direction, uint16_t manuf_code)
+{
+    Request req{frame_id::ZCL_ATTR_DISC, {}};
+    Writer w(req.payload);
+
+    put_zcl_cmd_head(w, dst, cluster_id, direction, manuf_code);
+    w.put<uint16_t>(start_attr_id).put<uint8_t>(max_attr_number).zeros(3);
+
+    return req;
+}
+
+Request zcl_write(const Destination &dst, uint16_t profile_id, uint16_t cluster_id, uint16_t cmd_id, uint8_t direction,
+                  uint8_t type, const Bytes &value)
+{
+    wire::ZclWrite msg;
+
+    msg.zcl_basic_cmd = wire_basic_cmd(dst);
+    msg.address_mode = static_cast<uint8_t>(dst.mode);
+    msg.profile_id = profile_id;
+    msg.cluster_id = cluster_id;
+    msg.custom_cmd_id = cmd_id;
+    msg.direction = direction;
+    msg.type = type;
+    msg.value = value;
+
+    return Request{frame_id::ZCL_WRITE, wire::encode(msg)};
+}
+
+Request zcl_report_config(const Destination &dst, uint16_t cluster_id, const std::vector<ReportRecord> &records,
+                          const std::vector<uint16_t> &devices, const BulkOptions &bulk)
+{
+    wire::ZclReportConfig msg;
+
+    msg.zcl_basic_cmd = wire_basic_cmd(dst);
+    msg.address_mode = static_cast<uint8_t>(dst.mode);
+    msg.cluster_id = cluster_id;
+    msg.concurrency = bulk.concurrency;
+    msg.retries = bulk.retries;
+    msg.timeout_ms = bulk.timeout_ms;
+    for (const ReportRecord &record : records) {
+        msg.record_field.push_back(wire::ZclReportRecord{record.attr_id, record.attr_type, record.min_interval, record.max_interval,
+                                                         wire::load<uint64_t>(record.reportable_change.data())});
+    }
+    msg.dev_field = devices;
+
+    return Request{frame_id::ZCL_REPORT_CONFIG, wire::encode(msg)};
+}
+
+Request zcl_attr_read_bulk(uint8_t src_endpoint, uint8_t dst_endpoint, uint16_t cluster_id, const std::vector<uint16_t> &attr_ids,
+                           const std::vector<uint16_t> &devices, const BulkOptions &bulk)
+{
+    wire::ZclAttrReadBulk msg;
+
+    msg.src_endpoint = src_endpoint;
+    msg.dst_endpoint = dst_endpoint;
+    msg.cluster_id = cluster_id;
+    msg.concurrency = bulk.concurrency;
+    msg.retries = bulk.retries;
+    msg.timeout_ms = bulk.timeout_ms;
+    msg.attr_field = attr_ids;
+    msg.dev_field = devices;
+
+    return Request{frame_id::ZCL_ATTR_READ_BULK, wire::encode(msg)};
+}
+
+Request zcl_sched_config(bool enable, uint16_t rate, uint16_t burst, uint16_t dst_gap_ms, uint16_t hop_gap_ms)
+{
+    wire::ZclSchedConfig msg;
+
+    msg.enable = enable;
+    msg.rate = rate;
+    msg.burst = burst;
+    msg.dst_gap_ms = dst_gap_ms;
+    msg.hop_gap_ms = hop_gap_ms;
+
+    return Request{frame_id::ZCL_SCHED_CONFIG, wire::encode(msg)};
+}
+
+Request zcl_sched_stats(bool reset) { return scalar<uint8_t>(frame_id::ZCL_SCHED_STATS, reset); }
+
+Request zcl_write_multi(uint8_t src_endpoint, uint8_t dst_endpoint, uint16_t profile_id, uint16_t cluster_id, uint16_t cmd_id,
+                        uint8_t direction, uint8_t type, const Bytes &value, const std::vector<uint16_t> &devices)
+{
+    wire::ZclWriteMulti msg;
+
+    msg.src_endpoint = src_endpoint;
+    msg.dst_endpoint = dst_endpoint;
+    msg.profile_id = profile_id;
+    msg.cluster_id = cluster_id;
+    msg.custom_cmd_id = cmd_id;
+    msg.direction = direction;
+    msg.type = type;
+    msg.value = value;
+    msg.dev_field = devices;
+
+    return Request{frame_id::ZCL_WRITE_MULTI, wire::encode(msg)};
+}
+
+Request zcl_groupcast_stats() { return raw(frame_id::ZCL_GROUPCAST_STATS); }
+
+Request zcl_rule_add(uint8_t rule_id, uint8_t flags, uint8_t trigger, uint16_t src_addr, uint8_t src_endpoint, uint16_t cluster_id,
+                     uint16_t attr_id, const Bytes &code, const Bytes &action)
+{
+    wire::ZclRuleAdd msg;
+
+    msg.rule_id = rule_id;
+    msg.flags = flags;
+    msg.trigger = trigger;
+    msg.src_addr = src_addr;
+    msg.src_endpoint = src_endpoint;
+    msg.cluster_id = cluster_id;
+    msg.attr_id = attr_id;
+    msg.code = code;
+    msg.action = action;
+
+    return Request{frame_id::ZCL_RULE_ADD, wire::encode(msg)};
+}
+
+Request zcl_rule_del(uint8_t rule_id)
+{
+    wire::ZclRuleDel msg;
+
+    msg.rule_id = rule_id;
+
+    return Request{frame_id::ZCL_RULE_DEL, wire::encode(msg)};
+}
+
+Request zcl_rule_stats(uint8_t rule_id, bool reset)
+{
+    wire::ZclRuleStats msg;
+
+    msg.rule_id = rule_id;
+    msg.reset = reset;
+
+    return Request{frame_id::ZCL_RULE_STATS, wire::encode(msg)};
+}
+
+Request zcl_timer_add(bool absolute, uint32_t deadline, uint32_t utc_now, uint32_t period_ms, const Bytes &action)
+{
+    wire::ZclTimerAdd msg;
+
+    msg.absolute = absolute;
+    msg.deadline = deadline;
+    msg.utc_now = utc_now;
+    msg.period_ms = period_ms;
+    msg.action = action;
+
+    return Request{frame_id::ZCL_TIMER_ADD, wire::encode(msg)};
+}
+
+Request zcl_timer_cancel(uint32_t timer_id)
+{
+    wire::ZclTimerCancel msg;
+
+    msg.id = timer_id;
+
+    return Request{frame_id::ZCL_TIMER_CANCEL, wire::encode(msg)};
+}
+
+Request zcl_timer_list(uint16_t start) { return scalar<uint16_t>(frame_id::ZCL_TIMER_LIST, start); }
+Request zcl_timer_stats(bool reset) { return scalar<uint8_t>(frame_id::ZCL_TIMER_STATS, reset); }
+
+Request zdo_bind_set(const Binding &binding, uint32_t user_cb, uint32_t user_ctx)
+{
+    return bind(frame_id::ZDO_BIND_SET, binding, user_cb, user_ctx);
+}
+
+Request zdo_unbind_set(const Binding &binding, uint32_t user_cb, uint32_t user_ctx)
+{
+    return bind(frame_id::ZDO_UNBIND_SET, binding, user_cb, user_ctx);
+}
+
+Request zdo_find_match(uint16_t dst_nwk_addr, uint16_t addr_of_interest, uint16_t profile_id, const std::vector<uint16_t> &in_clusters,
+                       const std::vector<uint16_t> &out_clusters, uint32_t user_cb, uint32_t user_ctx)
+{
+    Request req{frame_id::ZDO_FIND_MATCH, {}};
+    Writer w(req.payload);
+
+    w.put<uint32_t>(user_cb).put<uint32_t>(user_ctx);
+    w.put<uint16_t>(dst_nwk_addr).put<uint16_t>(addr_of_interest).put<uint16_t>(profile_id);
+    w.put<uint8_t>(static_cast<uint8_t>(in_clusters.size())).put<uint8_t>(static_cast<uint8_t>(out_clusters.size()));
+    put_list(w, in_clusters);
+    put_list(w, out_clusters);
+
+    return req;
+}
+
+Request zdo_interrogate_config(bool auto_enable, uint8_t concurrency, uint8_t retries)
+{
+    wire::ZdoInterrogateConfig msg;
+
+    msg.auto_enable = auto_enable;
+    msg.concurrency = concurrency;
+    msg.retries = retries;
+
+    return Request{frame_id::ZDO_INTERROGATE_CONFIG, wire::encode(msg)};
+}
+
+Request zdo_interrogate(const std::vector<uint16_t> &devices)
+{
+    wire::ZdoInterrogate msg;
+
+    msg.dev_field = devices;
+
+    return Request{frame_id::ZDO_INTERROGATE, wire::encode(msg)};
+}
+
+Request aps_data_request(const Destination &dst, uint16_t profile_id, uint16_t cluster_id, const Bytes &asdu, const ApsOptions &options)
+{
+    wire::ApsDataRequest msg;
+
+    msg.basic_cmd = wire_basic_cmd(dst);
+    msg.dst_addr_mode = static_cast<uint8_t>(dst.mode);
+    msg.profile_id = profile_id;
+    msg.cluster_id = cluster_id;
+    msg.tx_options = options.tx_options;
+    msg.use_alias = options.use_alias;
+    msg.alias_src_addr = wire::Addr::from_short(options.alias_src_addr);
+    msg.alias_seq_num = options.alias_seq_num;
+    msg.radius = options.radius;
+    msg.asdu = asdu;
+
+    return Request{frame_id::APS_DATA_REQUEST, wire::encode(msg)};
+}
+
+Request aps_data_indication_poll() { return raw(frame_id::APS_DATA_INDICATION); }
+Request aps_data_confirm_poll() { return raw(frame_id::APS_DATA_CONFIRM); }
+
+Request aps_data_request_bulk(uint8_t src_endpoint, uint16_t profile_id, uint16_t cluster_id, const std::vector<ApsBulkDestination> &dsts,
+                              const Bytes &asdu, uint8_t radius, uint16_t pacing_ms)
+{
+    wire::ApsDataRequestBulk msg;
+
+    msg.src_endpoint = src_endpoint;
+    msg.profile_id = profile_id;
+    msg.cluster_id = cluster_id;
+    msg.radius = radius;
+    msg.pacing_ms = pacing_ms;
+    for (const ApsBulkDestination &dst : dsts) {
+        wire::Addr dst_addr = (dst.mode == AddrMode::Ieee) ? wire::Addr::from_long(dst.ieee_addr) : wire::Addr::from_short(dst.short_addr);
+
+        msg.dst.push_back(wire::ApsBulkDst{static_cast<uint8_t>(dst.mode), dst_addr, dst.dst_endpoint, dst.tx_options});
+    }
+    msg.asdu = asdu;
+
+    return Request{frame_id::APS_DATA_REQUEST_BULK, wire::encode(msg)};
+}
+
+Request mux_filter_set(bool forward_all, const std::vector<uint16_t> &except)
+{
+    Request req{frame_id::MUX_FILTER_SET, {}};
+    Writer w(req.payload);
+
+    w.put<uint8_t>(forward_all);
+    put_list(w, except);
+
+    return req;
+}
+
+Request mux_stats() { return raw(frame_id::MUX_STATS); }
+
+} // namespace request
+} // namespace esp_ncp
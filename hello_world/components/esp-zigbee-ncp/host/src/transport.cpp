@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "esp_ncp/transport.hpp"
+
+namespace esp_ncp {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string &what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+speed_t baud_to_speed(uint32_t baud)
+{
+    switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    default: return 0;
+    }
+}
+
+} // namespace
+
+Transport::Transport(int fd, std::string path, uint32_t baud) : fd_(fd), path_(std::move(path)), baud_(baud)
+{
+}
+
+Transport::~Transport()
+{
+    ::close(fd_);
+}
+
+ssize_t Transport::read(uint8_t *data, size_t len)
+{
+    return ::read(fd_, data, len);
+}
+
+ssize_t Transport::write(const uint8_t *data, size_t len)
+{
+    return ::write(fd_, data, len);
+}
+
+std::unique_ptr<Transport> Transport::open_serial(const std::string &path, uint32_t baud)
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    struct termios tio;
+
+    if (fd < 0) {
+        throw_errno("open " + path);
+    }
+
+    /* The PTY of the Linux NCP has no line settings worth keeping, a real UART is set raw 8N1 */
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+        if (baud) {
+            speed_t speed = baud_to_speed(baud);
+            if (!speed) {
+                ::close(fd);
+                errno = EINVAL;
+                throw_errno("baud rate " + std::to_string(baud));
+            }
+            cfsetispeed(&tio, speed);
+            cfsetospeed(&tio, speed);
+        }
+        if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            throw_errno("tcsetattr " + path);
+        }
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    return std::unique_ptr<Transport>(new Transport(fd, path, baud));
+}
+
+std::unique_ptr<Transport> Transport::open_socket(const std::string &path)
+{
+    struct sockaddr_un addr = {};
+    int fd;
+
+    if (path.size() >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        throw_errno("socket " + path);
+    }
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw_errno("socket");
+    }
+
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+    if (::connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        int err = errno;
+        ::close(fd);
+        errno = err;
+        throw_errno("connect " + path);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    return std::unique_ptr<Transport>(new Transport(fd, path, 0));
+}
+
+std::unique_ptr<Transport> Transport::open(const std::string &path, uint32_t baud)
+{
+    struct stat st;
+
+    if (::stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        return open_socket(path);
+    }
+
+    return open_serial(path, baud);
+}
+
+} // namespace esp_ncp
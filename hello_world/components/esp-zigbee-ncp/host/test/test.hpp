@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The checks of the host tests. A failed check prints its location and the test goes on, main()
+ * returns test_result() so that ctest reports the test as failed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace esp_ncp_test {
+
+inline int failures = 0;
+
+inline void check(bool ok, const char *expr, const char *file, int line)
+{
+    if (!ok) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        failures ++;
+    }
+}
+
+inline void dump(const char *name, const std::vector<uint8_t> &bytes)
+{
+    fprintf(stderr, "  %s:", name);
+    for (uint8_t c : bytes) {
+        fprintf(stderr, " %02x", c);
+    }
+    fprintf(stderr, "\n");
+}
+
+/* Compares the bytes, printing both on a mismatch */
+inline void check_bytes(const std::vector<uint8_t> &actual, const std::vector<uint8_t> &expected, const char *what,
+                        const char *file, int line)
+{
+    if (actual != expected) {
+        fprintf(stderr, "%s:%d: %s differs\n", file, line, what);
+        dump("actual  ", actual);
+        dump("expected", expected);
+        failures ++;
+    }
+}
+
+inline int test_result(const char *name)
+{
+    if (failures) {
+        fprintf(stderr, "%s: %d checks failed\n", name, failures);
+        return 1;
+    }
+    printf("%s: passed\n", name);
+    return 0;
+}
+
+} // namespace esp_ncp_test
+
+#define CHECK(expr) esp_ncp_test::check((expr), #expr, __FILE__, __LINE__)
+#define CHECK_BYTES(actual, expected, what) esp_ncp_test::check_bytes((actual), (expected), (what), __FILE__, __LINE__)
@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The CRC16, the SLIP encoding and the streaming decoder: every frame encoded is decoded back
+ * whole, byte by byte and in odd chunks, and the damaged frames are counted and dropped.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "esp_ncp/frame.hpp"
+#include "test.hpp"
+
+using namespace esp_ncp;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+struct Decoded {
+    Header header;
+    Bytes payload;
+};
+
+/* Feeds the bytes to the decoder chunk bytes at a time, as the transport reads them */
+std::vector<Decoded> feed(FrameDecoder &decoder, const Bytes &data, size_t chunk)
+{
+    std::vector<Decoded> frames;
+
+    for (size_t offset = 0; offset < data.size();) {
+        size_t room = 0;
+        uint8_t *buf = decoder.prepare(&room);
+        size_t len = std::min({chunk, room, data.size() - offset});
+
+        memcpy(buf, &data[offset], len);
+        decoder.commit(len, [&](const FrameView &frame) {
+            frames.push_back(Decoded{frame.header, Bytes(frame.payload, frame.payload + frame.header.len)});
+        });
+        offset += len;
+    }
+
+    return frames;
+}
+
+Bytes encode_one(FrameType type, uint16_t id, uint8_t sn, const Bytes &payload)
+{
+    Bytes out;
+    Header header;
+
+    header.version = 1;
+    header.type = type;
+    header.id = id;
+    header.sn = sn;
+    frame_encode(out, header, payload.data(), payload.size());
+
+    return out;
+}
+
+void test_crc16()
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    /* The check value of esp_crc16_le(UINT16_MAX, ...) on the NCP */
+    CHECK(crc16_le(UINT16_MAX, check, sizeof(check)) == 0xDE76);
+    CHECK(crc16_le(0, check, sizeof(check)) == 0x906E);
+    CHECK(crc16_le(0x1234, check, 0) == 0x1234);
+
+    /* The CRC chains over split data, as frame_encode() does over the header and the payload */
+    for (size_t split = 0; split <= sizeof(check); split ++) {
+        CHECK(crc16_le(crc16_le(UINT16_MAX, check, split), check + split, sizeof(check) - split) == 0xDE76);
+    }
+}
+
+void test_slip_escape()
+{
+    Bytes payload = {0x01, SLIP_END, 0x02, SLIP_ESC, SLIP_ESC_END, SLIP_ESC_ESC, SLIP_END, SLIP_END};
+    Bytes out = encode_one(FrameType::Request, 0x0104, 7, payload);
+
+    /* Only the delimiters are SLIP_END, every escape is followed by one of the escape codes */
+    CHECK(out.front() == SLIP_END && out.back() == SLIP_END);
+    CHECK(std::count(out.begin(), out.end(), SLIP_END) == 2);
+    for (size_t i = 0; i < out.size(); i ++) {
+        if (out[i] == SLIP_ESC) {
+            CHECK(i + 1 < out.size() && (out[i + 1] == SLIP_ESC_END || out[i + 1] == SLIP_ESC_ESC));
+        }
+    }
+
+    FrameDecoder decoder;
+    std::vector<Decoded> frames = feed(decoder, out, out.size());
+    CHECK(frames.size() == 1);
+    if (frames.size() == 1) {
+        CHECK_BYTES(frames[0].payload, payload, "escaped payload");
+    }
+}
+
+void test_round_trip()
+{
+    const size_t sizes[] = {0, 1, 2, 255, 256, 1000, 4096};
+    const size_t chunks[] = {1, 2, 3, 7, 64, 1 << 20};
+    std::vector<Bytes> payloads;
+    Bytes stream;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i ++) {
+        Bytes payload(sizes[i]);
+        for (size_t j = 0; j < payload.size(); j ++) {
+            payload[j] = static_cast<uint8_t>(j * 7 + i);
+        }
+        Bytes out = encode_one(static_cast<FrameType>(i % 3), static_cast<uint16_t>(0x0100 + i), static_cast<uint8_t>(250 + i), payload);
+        stream.insert(stream.end(), out.begin(), out.end());
+        payloads.push_back(payload);
+    }
+
+    for (size_t chunk : chunks) {
+        FrameDecoder decoder;
+        std::vector<Decoded> frames = feed(decoder, stream, chunk);
+
+        CHECK(frames.size() == payloads.size());
+        for (size_t i = 0; i < frames.size() && i < payloads.size(); i ++) {
+            CHECK(frames[i].header.version == 1);
+            CHECK(frames[i].header.type == static_cast<FrameType>(i % 3));
+            CHECK(frames[i].header.id == 0x0100 + i);
+            CHECK(frames[i].header.sn == static_cast<uint8_t>(250 + i));
+            CHECK(frames[i].header.len == payloads[i].size());
+            CHECK_BYTES(frames[i].payload, payloads[i], "payload");
+        }
+        CHECK(decoder.stats().frames == payloads.size());
+        CHECK(decoder.stats().bytes == stream.size());
+        CHECK(decoder.stats().crc_errors == 0 && decoder.stats().format_errors == 0);
+    }
+}
+
+void test_damaged()
+{
+    Bytes payload = {0x10, 0x20, 0x30, 0x40};
+    Bytes good = encode_one(FrameType::Response, 0x0005, 3, payload);
+
+    /* A flipped payload bit fails the CRC */
+    {
+        Bytes bad = good;
+        bad[HEADER_SIZE + 2] ^= 0x01;
+        FrameDecoder decoder;
+        CHECK(feed(decoder, bad, bad.size()).empty());
+        CHECK(decoder.stats().crc_errors == 1);
+    }
+
+    /* A frame shorter than its length field, and one shorter than a header */
+    {
+        Bytes bad = good;
+        bad.erase(bad.begin() + 1 + HEADER_SIZE);
+        FrameDecoder decoder;
+        CHECK(feed(decoder, bad, bad.size()).empty());
+        CHECK(decoder.stats().format_errors == 1);
+
+        Bytes runt = {SLIP_END, 0x01, 0x02, 0x03, SLIP_END};
+        CHECK(feed(decoder, runt, runt.size()).empty());
+        CHECK(decoder.stats().format_errors == 2);
+    }
+
+    /* The decoder resynchronizes on the next delimiter after garbage and a damaged frame */
+    {
+        Bytes stream = {0x55, 0xAA, SLIP_ESC, 0x00};
+        Bytes bad = good;
+        bad[HEADER_SIZE + 1] ^= 0x80;
+        stream.insert(stream.end(), bad.begin(), bad.end());
+        stream.insert(stream.end(), good.begin(), good.end());
+
+        FrameDecoder decoder;
+        std::vector<Decoded> frames = feed(decoder, stream, 5);
+        CHECK(frames.size() == 1);
+        if (frames.size() == 1) {
+            CHECK(frames[0].header.type == FrameType::Response && frames[0].header.id == 0x0005 && frames[0].header.sn == 3);
+            CHECK_BYTES(frames[0].payload, payload, "payload after resync");
+        }
+    }
+
+    /* A partial frame is dropped by reset(), the next one decodes */
+    {
+        FrameDecoder decoder;
+        Bytes half(good.begin(), good.begin() + good.size() / 2);
+        CHECK(feed(decoder, half, half.size()).empty());
+        decoder.reset();
+        CHECK(feed(decoder, good, good.size()).size() == 1);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test_crc16();
+    test_slip_escape();
+    test_round_trip();
+    test_damaged();
+
+    return esp_ncp_test::test_result("test_frame");
+}
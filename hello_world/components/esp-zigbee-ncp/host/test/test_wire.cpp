@@ -0,0 +1,284 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The golden vectors of the generated codecs. Each payload is written out byte by byte as the NCP
+ * parses it, then:
+ *
+ * - the request builder of the host produces exactly those bytes;
+ * - the owning C++ type and the C codec of the NCP, built as C, decode and encode them unchanged;
+ * - the C++ view and the C codec decode the same fields from them;
+ * - every truncation of them fails to decode on both sides.
+ *
+ * A schema change which moves a byte breaks the vector, update it with the layout on purpose.
+ */
+
+#include "esp_ncp/frame_id.hpp"
+#include "esp_ncp/request.hpp"
+#include "esp_ncp/wire.hpp"
+#include "test.hpp"
+#include "test_wire_c.h"
+
+using namespace esp_ncp;
+
+namespace {
+
+const Bytes s_value = {0x01, 0x02, 0x03, 0x04, 0x05};
+const IeeeAddr s_ieee = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+const Bytes s_zcl_write = {
+    0x34, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     /* dst_addr */
+    0x05, 0x01,                                         /* dst_endpoint, src_endpoint */
+    0x02,                                               /* address_mode */
+    0x04, 0x01, 0x06, 0x00,                             /* profile_id, cluster_id */
+    0x02, 0x00, 0x01, 0x20,                             /* custom_cmd_id, direction, type */
+    0x05, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,           /* size, value */
+};
+
+const Bytes s_zcl_attr_read_bulk = {
+    0x01, 0x02, 0x06, 0x00,                             /* src_endpoint, dst_endpoint, cluster_id */
+    0x03, 0x02, 0x84, 0x03,                             /* concurrency, retries, timeout_ms */
+    0x03, 0x04, 0x00,                                   /* attr_number, dev_number */
+    0x00, 0x00, 0x01, 0x00, 0x02, 0x00,                 /* attr_field */
+    0x0a, 0x00, 0x0b, 0x00, 0x0c, 0x00, 0x0d, 0x00,     /* dev_field */
+};
+
+const Bytes s_zcl_timer_add = {
+    0x01,                                               /* absolute */
+    0x64, 0x00, 0x00, 0x00,                             /* deadline */
+    0x32, 0x00, 0x00, 0x00,                             /* utc_now */
+    0xe8, 0x03, 0x00, 0x00,                             /* period_ms */
+    0x05, 0x01, 0x02, 0x03, 0x04, 0x05,                 /* action_len, action */
+};
+
+const Bytes s_zcl_report_config = {
+    0x34, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     /* dst_addr */
+    0x05, 0x01,                                         /* dst_endpoint, src_endpoint */
+    0x02, 0x02, 0x04,                                   /* address_mode, cluster_id */
+    0x03, 0x02, 0x84, 0x03,                             /* concurrency, retries, timeout_ms */
+    0x01, 0x02, 0x00,                                   /* record_number, dev_number */
+    0x00, 0x00, 0x29, 0x01, 0x00, 0x2c, 0x01,           /* record_field[0]: attr_id, attr_type, min_interval, max_interval */
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,     /* record_field[0]: reportable_change */
+    0x0a, 0x00, 0x0b, 0x00,                             /* dev_field */
+};
+
+const Bytes s_zcl_write_multi = {
+    0x01, 0x02, 0x04, 0x01, 0x06, 0x00,                 /* src_endpoint, dst_endpoint, profile_id, cluster_id */
+    0x02, 0x00, 0x00, 0x20,                             /* custom_cmd_id, direction, type */
+    0x05, 0x00, 0x02, 0x00,                             /* size, dev_number */
+    0x01, 0x02, 0x03, 0x04, 0x05,                       /* value */
+    0x0a, 0x00, 0x0b, 0x00,                             /* dev_field */
+};
+
+const Bytes s_status_id = {
+    0x00, 0x78, 0x56, 0x34, 0x12,                       /* status, id */
+};
+
+const Bytes s_aps_data_request_bulk = {
+    0x01, 0x04, 0x01, 0x06, 0x00,                       /* src_endpoint, profile_id, cluster_id */
+    0x05, 0x14, 0x00,                                   /* radius, pacing_ms */
+    0x02, 0x05, 0x00, 0x00, 0x00,                       /* dst_count, asdu_length */
+    0x02, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04,   /* dst[0] */
+    0x03, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x07, 0x00,   /* dst[1] */
+    0x01, 0x02, 0x03, 0x04, 0x05,                       /* asdu */
+};
+
+/* The C codec decodes and encodes the vector unchanged and reads the same fields */
+void check_c(test_wire_c_type_t type, const Bytes &golden, const char *name)
+{
+    Bytes out(golden.size() + 16);
+    size_t len = test_wire_c_round_trip(type, golden.data(), golden.size(), out.data(), out.size());
+    const char *field = test_wire_c_fields(type, golden.data(), golden.size());
+
+    out.resize(len);
+    CHECK_BYTES(out, golden, name);
+    if (field) {
+        fprintf(stderr, "%s: the C codec decodes a wrong %s\n", name, field);
+        CHECK(field == nullptr);
+    }
+    for (size_t cut = 0; cut < golden.size(); cut ++) {
+        CHECK(test_wire_c_round_trip(type, golden.data(), cut, out.data(), golden.size()) == 0);
+    }
+}
+
+/* The owning C++ type decodes and encodes the vector unchanged, the view decodes none of its truncations */
+template <typename T>
+void check_cpp(const Bytes &golden, const char *name)
+{
+    T msg;
+    CHECK(wire::decode(golden.data(), golden.size(), msg));
+    CHECK_BYTES(wire::encode(msg), golden, name);
+
+    for (size_t cut = 0; cut < golden.size(); cut ++) {
+        typename T::View view;
+        T copy;
+        CHECK(!wire::decode(golden.data(), cut, view));
+        CHECK(!wire::decode(golden.data(), cut, copy));
+    }
+}
+
+void test_zcl_write()
+{
+    Destination dst = Destination::device(0x1234, 5, 1);
+    Request req = request::zcl_write(dst, 0x0104, 0x0006, 2, 1, 0x20, s_value);
+
+    CHECK(req.id == frame_id::ZCL_WRITE);
+    CHECK_BYTES(req.payload, s_zcl_write, "zcl_write request");
+    check_cpp<wire::ZclWrite>(s_zcl_write, "ZclWrite");
+    check_c(TEST_WIRE_C_ZCL_WRITE, s_zcl_write, "zcl_write");
+
+    wire::ZclWrite::View view;
+    CHECK(wire::decode(s_zcl_write.data(), s_zcl_write.size(), view));
+    CHECK(view.zcl_basic_cmd.dst_addr.short_addr() == 0x1234);
+    CHECK(view.zcl_basic_cmd.dst_endpoint == 5 && view.zcl_basic_cmd.src_endpoint == 1);
+    CHECK(view.address_mode == 2 && view.profile_id == 0x0104 && view.cluster_id == 0x0006);
+    CHECK(view.custom_cmd_id == 2 && view.direction == 1 && view.type == 0x20);
+    CHECK(view.value.bytes() == s_value);
+}
+
+void test_zcl_attr_read_bulk()
+{
+    BulkOptions bulk;
+    bulk.concurrency = 3;
+    bulk.retries = 2;
+    bulk.timeout_ms = 900;
+    Request req = request::zcl_attr_read_bulk(1, 2, 0x0006, {0, 1, 2}, {10, 11, 12, 13}, bulk);
+
+    CHECK(req.id == frame_id::ZCL_ATTR_READ_BULK);
+    CHECK_BYTES(req.payload, s_zcl_attr_read_bulk, "zcl_attr_read_bulk request");
+    check_cpp<wire::ZclAttrReadBulk>(s_zcl_attr_read_bulk, "ZclAttrReadBulk");
+    check_c(TEST_WIRE_C_ZCL_ATTR_READ_BULK, s_zcl_attr_read_bulk, "zcl_attr_read_bulk");
+
+    wire::ZclAttrReadBulk::View view;
+    CHECK(wire::decode(s_zcl_attr_read_bulk.data(), s_zcl_attr_read_bulk.size(), view));
+    CHECK(view.src_endpoint == 1 && view.dst_endpoint == 2 && view.cluster_id == 0x0006);
+    CHECK(view.concurrency == 3 && view.retries == 2 && view.timeout_ms == 900);
+    CHECK(view.attr_field.size() == 3 && view.dev_field.size() == 4);
+    for (size_t i = 0; i < view.attr_field.size(); i ++) {
+        CHECK(view.attr_field[i] == i);
+    }
+    for (size_t i = 0; i < view.dev_field.size(); i ++) {
+        CHECK(view.dev_field[i] == 10 + i);
+    }
+}
+
+void test_zcl_report_config()
+{
+    ReportRecord record;
+    record.attr_id = 0x0000;
+    record.attr_type = 0x29;
+    record.min_interval = 1;
+    record.max_interval = 300;
+    record.reportable_change = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    BulkOptions bulk;
+    bulk.concurrency = 3;
+    bulk.retries = 2;
+    bulk.timeout_ms = 900;
+    Request req = request::zcl_report_config(Destination::device(0x1234, 5, 1), 0x0402, {record}, {10, 11}, bulk);
+
+    CHECK(req.id == frame_id::ZCL_REPORT_CONFIG);
+    CHECK_BYTES(req.payload, s_zcl_report_config, "zcl_report_config request");
+    check_cpp<wire::ZclReportConfig>(s_zcl_report_config, "ZclReportConfig");
+    check_c(TEST_WIRE_C_ZCL_REPORT_CONFIG, s_zcl_report_config, "zcl_report_config");
+
+    wire::ZclReportConfig::View view;
+    CHECK(wire::decode(s_zcl_report_config.data(), s_zcl_report_config.size(), view));
+    CHECK(view.zcl_basic_cmd.dst_addr.short_addr() == 0x1234 && view.cluster_id == 0x0402);
+    CHECK(view.concurrency == 3 && view.retries == 2 && view.timeout_ms == 900);
+    CHECK(view.record_field.size() == 1 && view.dev_field.size() == 2);
+    for (const auto &decoded : view.record_field) {
+        CHECK(decoded.attr_id == 0 && decoded.attr_type == 0x29 && decoded.min_interval == 1 && decoded.max_interval == 300);
+        CHECK(decoded.reportable_change == 0x0807060504030201ull);
+    }
+    CHECK(view.dev_field[0] == 10 && view.dev_field[1] == 11);
+}
+
+void test_zcl_write_multi()
+{
+    Request req = request::zcl_write_multi(1, 2, 0x0104, 0x0006, 2, 0, 0x20, s_value, {10, 11});
+
+    CHECK(req.id == frame_id::ZCL_WRITE_MULTI);
+    CHECK_BYTES(req.payload, s_zcl_write_multi, "zcl_write_multi request");
+    check_cpp<wire::ZclWriteMulti>(s_zcl_write_multi, "ZclWriteMulti");
+    check_c(TEST_WIRE_C_ZCL_WRITE_MULTI, s_zcl_write_multi, "zcl_write_multi");
+
+    wire::ZclWriteMulti::View view;
+    CHECK(wire::decode(s_zcl_write_multi.data(), s_zcl_write_multi.size(), view));
+    CHECK(view.src_endpoint == 1 && view.dst_endpoint == 2 && view.profile_id == 0x0104 && view.cluster_id == 0x0006);
+    CHECK(view.custom_cmd_id == 2 && view.direction == 0 && view.type == 0x20);
+    CHECK(view.value.bytes() == s_value);
+    CHECK(view.dev_field.size() == 2 && view.dev_field[0] == 10 && view.dev_field[1] == 11);
+}
+
+void test_zcl_timer_add()
+{
+    Request req = request::zcl_timer_add(true, 100, 50, 1000, s_value);
+
+    CHECK(req.id == frame_id::ZCL_TIMER_ADD);
+    CHECK_BYTES(req.payload, s_zcl_timer_add, "zcl_timer_add request");
+    check_cpp<wire::ZclTimerAdd>(s_zcl_timer_add, "ZclTimerAdd");
+    check_c(TEST_WIRE_C_ZCL_TIMER_ADD, s_zcl_timer_add, "zcl_timer_add");
+
+    wire::ZclTimerAdd::View view;
+    CHECK(wire::decode(s_zcl_timer_add.data(), s_zcl_timer_add.size(), view));
+    CHECK(view.absolute && view.deadline == 100 && view.utc_now == 50 && view.period_ms == 1000);
+    CHECK(view.action.bytes() == s_value);
+
+    /* The response the NCP encodes with esp_ncp_wire_status_id_encode() */
+    wire::StatusId status;
+    CHECK(wire::decode(s_status_id.data(), s_status_id.size(), status));
+    CHECK(status.status == 0 && status.id == 0x12345678);
+    CHECK_BYTES(wire::encode(status), s_status_id, "StatusId");
+    check_c(TEST_WIRE_C_STATUS_ID, s_status_id, "status_id");
+}
+
+void test_aps_data_request_bulk()
+{
+    std::vector<ApsBulkDestination> dsts(2);
+    dsts[0].mode = AddrMode::Short;
+    dsts[0].short_addr = 0x0022;
+    dsts[0].dst_endpoint = 3;
+    dsts[0].tx_options = 4;
+    dsts[1].mode = AddrMode::Ieee;
+    dsts[1].ieee_addr = s_ieee;
+    dsts[1].dst_endpoint = 7;
+    Request req = request::aps_data_request_bulk(1, 0x0104, 0x0006, dsts, s_value, 5, 20);
+
+    CHECK(req.id == frame_id::APS_DATA_REQUEST_BULK);
+    CHECK_BYTES(req.payload, s_aps_data_request_bulk, "aps_data_request_bulk request");
+    check_cpp<wire::ApsDataRequestBulk>(s_aps_data_request_bulk, "ApsDataRequestBulk");
+    check_c(TEST_WIRE_C_APS_DATA_REQUEST_BULK, s_aps_data_request_bulk, "aps_data_request_bulk");
+
+    wire::ApsDataRequestBulk::View view;
+    CHECK(wire::decode(s_aps_data_request_bulk.data(), s_aps_data_request_bulk.size(), view));
+    CHECK(view.src_endpoint == 1 && view.profile_id == 0x0104 && view.cluster_id == 0x0006);
+    CHECK(view.radius == 5 && view.pacing_ms == 20 && view.dst.size() == 2);
+    size_t i = 0;
+    for (const auto &dst : view.dst) {
+        if (i == 0) {
+            CHECK(dst.dst_addr_mode == 2 && dst.dst_addr.short_addr() == 0x0022 && dst.dst_endpoint == 3 && dst.tx_options == 4);
+        } else {
+            CHECK(dst.dst_addr_mode == 3 && dst.dst_addr.bytes == s_ieee && dst.dst_endpoint == 7 && dst.tx_options == 0);
+        }
+        i ++;
+    }
+    CHECK(i == 2);
+    CHECK(view.asdu.bytes() == s_value);
+}
+
+} // namespace
+
+int main()
+{
+    test_zcl_write();
+    test_zcl_attr_read_bulk();
+    test_zcl_report_config();
+    test_zcl_write_multi();
+    test_zcl_timer_add();
+    test_aps_data_request_bulk();
+
+    return esp_ncp_test::test_result("test_wire");
+}
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The C side of the golden vector test, built as C with the codec header the NCP includes.
+ */
+
+#include <string.h>
+
+#include "esp_ncp_wire.h"
+#include "test_wire_c.h"
+
+#define TEST_FIELD(cond, name)  do { if (!(cond)) { return name; } } while (0)
+
+static const uint8_t s_value[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+static const uint8_t s_ieee[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+size_t test_wire_c_round_trip(test_wire_c_type_t type, const uint8_t *in, size_t len, uint8_t *out, size_t size)
+{
+    switch (type) {
+        case TEST_WIRE_C_ZCL_WRITE: {
+            esp_ncp_wire_zcl_write_t msg;
+            return esp_ncp_wire_zcl_write_decode(in, len, &msg) ? esp_ncp_wire_zcl_write_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_ZCL_ATTR_READ_BULK: {
+            esp_ncp_wire_zcl_attr_read_bulk_t msg;
+            return esp_ncp_wire_zcl_attr_read_bulk_decode(in, len, &msg) ? esp_ncp_wire_zcl_attr_read_bulk_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_ZCL_REPORT_CONFIG: {
+            esp_ncp_wire_zcl_report_config_t msg;
+            return esp_ncp_wire_zcl_report_config_decode(in, len, &msg) ? esp_ncp_wire_zcl_report_config_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_ZCL_WRITE_MULTI: {
+            esp_ncp_wire_zcl_write_multi_t msg;
+            return esp_ncp_wire_zcl_write_multi_decode(in, len, &msg) ? esp_ncp_wire_zcl_write_multi_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_ZCL_TIMER_ADD: {
+            esp_ncp_wire_zcl_timer_add_t msg;
+            return esp_ncp_wire_zcl_timer_add_decode(in, len, &msg) ? esp_ncp_wire_zcl_timer_add_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_STATUS_ID: {
+            esp_ncp_wire_status_id_t msg;
+            return esp_ncp_wire_status_id_decode(in, len, &msg) ? esp_ncp_wire_status_id_encode(&msg, out, size) : 0;
+        }
+        case TEST_WIRE_C_APS_DATA_REQUEST_BULK: {
+            esp_ncp_wire_aps_data_request_bulk_t msg;
+            return esp_ncp_wire_aps_data_request_bulk_decode(in, len, &msg) ? esp_ncp_wire_aps_data_request_bulk_encode(&msg, out, size) : 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+const char *test_wire_c_fields(test_wire_c_type_t type, const uint8_t *in, size_t len)
+{
+    switch (type) {
+        case TEST_WIRE_C_ZCL_WRITE: {
+            esp_ncp_wire_zcl_write_t msg;
+            TEST_FIELD(esp_ncp_wire_zcl_write_decode(in, len, &msg), "decode");
+            TEST_FIELD(esp_ncp_wire_addr_short(&msg.zcl_basic_cmd.dst_addr) == 0x1234, "dst_addr");
+            TEST_FIELD(msg.zcl_basic_cmd.dst_endpoint == 5 && msg.zcl_basic_cmd.src_endpoint == 1, "endpoints");
+            TEST_FIELD(msg.address_mode == 2, "address_mode");
+            TEST_FIELD(msg.profile_id == 0x0104 && msg.cluster_id == 0x0006, "profile_id, cluster_id");
+            TEST_FIELD(msg.custom_cmd_id == 2 && msg.direction == 1 && msg.type == 0x20, "custom_cmd_id, direction, type");
+            TEST_FIELD(msg.size == sizeof(s_value) && !memcmp(msg.value, s_value, sizeof(s_value)), "value");
+            return NULL;
+        }
+        case TEST_WIRE_C_ZCL_ATTR_READ_BULK: {
+            esp_ncp_wire_zcl_attr_read_bulk_t msg;
+            TEST_FIELD(esp_ncp_wire_zcl_attr_read_bulk_decode(in, len, &msg), "decode");
+            TEST_FIELD(msg.src_endpoint == 1 && msg.dst_endpoint == 2 && msg.cluster_id == 6, "endpoints, cluster_id");
+            TEST_FIELD(msg.concurrency == 3 && msg.retries == 2 && msg.timeout_ms == 900, "bulk options");
+            TEST_FIELD(msg.attr_number == 3 && msg.dev_number == 4, "attr_number, dev_number");
+            for (uint16_t i = 0; i < msg.attr_number; i ++) {
+                TEST_FIELD(esp_ncp_wire_get_u16(msg.attr_field, i) == i, "attr_field");
+            }
+            for (uint16_t i = 0; i < msg.dev_number; i ++) {
+                TEST_FIELD(esp_ncp_wire_get_u16(msg.dev_field, i) == 10 + i, "dev_field");
+            }
+            return NULL;
+        }
+        case TEST_WIRE_C_ZCL_REPORT_CONFIG: {
+            esp_ncp_wire_zcl_report_config_t msg;
+            esp_ncp_wire_zcl_report_record_t record;
+            size_t offset = 0;
+            TEST_FIELD(esp_ncp_wire_zcl_report_config_decode(in, len, &msg), "decode");
+            TEST_FIELD(esp_ncp_wire_addr_short(&msg.zcl_basic_cmd.dst_addr) == 0x1234, "dst_addr");
+            TEST_FIELD(msg.address_mode == 2 && msg.cluster_id == 0x0402, "address_mode, cluster_id");
+            TEST_FIELD(msg.concurrency == 3 && msg.retries == 2 && msg.timeout_ms == 900, "bulk options");
+            TEST_FIELD(msg.record_number == 1 && msg.dev_number == 2, "record_number, dev_number");
+            TEST_FIELD(esp_ncp_wire_zcl_report_record_next(msg.record_field, msg.record_field_len, &offset, &record), "record_field[0]");
+            TEST_FIELD(record.attr_id == 0 && record.attr_type == 0x29, "attr_id, attr_type");
+            TEST_FIELD(record.min_interval == 1 && record.max_interval == 300, "intervals");
+            TEST_FIELD(record.reportable_change == 0x0807060504030201ull, "reportable_change");
+            TEST_FIELD(offset == msg.record_field_len, "record_field_len");
+            TEST_FIELD(esp_ncp_wire_get_u16(msg.dev_field, 0) == 10 && esp_ncp_wire_get_u16(msg.dev_field, 1) == 11, "dev_field");
+            return NULL;
+        }
+        case TEST_WIRE_C_ZCL_WRITE_MULTI: {
+            esp_ncp_wire_zcl_write_multi_t msg;
+            TEST_FIELD(esp_ncp_wire_zcl_write_multi_decode(in, len, &msg), "decode");
+            TEST_FIELD(msg.src_endpoint == 1 && msg.dst_endpoint == 2, "endpoints");
+            TEST_FIELD(msg.profile_id == 0x0104 && msg.cluster_id == 0x0006, "profile_id, cluster_id");
+            TEST_FIELD(msg.custom_cmd_id == 2 && msg.direction == 0 && msg.type == 0x20, "custom_cmd_id, direction, type");
+            TEST_FIELD(msg.size == sizeof(s_value) && !memcmp(msg.value, s_value, sizeof(s_value)), "value");
+            TEST_FIELD(msg.dev_number == 2 && esp_ncp_wire_get_u16(msg.dev_field, 1) == 11, "dev_field");
+            return NULL;
+        }
+        case TEST_WIRE_C_ZCL_TIMER_ADD: {
+            esp_ncp_wire_zcl_timer_add_t msg;
+            TEST_FIELD(esp_ncp_wire_zcl_timer_add_decode(in, len, &msg), "decode");
+            TEST_FIELD(msg.absolute && msg.deadline == 100 && msg.utc_now == 50 && msg.period_ms == 1000, "deadline");
+            TEST_FIELD(msg.action_len == sizeof(s_value) && !memcmp(msg.action, s_value, sizeof(s_value)), "action");
+            return NULL;
+        }
+        case TEST_WIRE_C_STATUS_ID: {
+            esp_ncp_wire_status_id_t msg;
+            TEST_FIELD(esp_ncp_wire_status_id_decode(in, len, &msg), "decode");
+            TEST_FIELD(msg.status == 0 && msg.id == 0x12345678, "status, id");
+            return NULL;
+        }
+        case TEST_WIRE_C_APS_DATA_REQUEST_BULK: {
+            esp_ncp_wire_aps_data_request_bulk_t msg;
+            esp_ncp_wire_aps_bulk_dst_t dst;
+            size_t offset = 0;
+            TEST_FIELD(esp_ncp_wire_aps_data_request_bulk_decode(in, len, &msg), "decode");
+            TEST_FIELD(msg.src_endpoint == 1 && msg.profile_id == 0x0104 && msg.cluster_id == 6, "src_endpoint, profile_id, cluster_id");
+            TEST_FIELD(msg.radius == 5 && msg.pacing_ms == 20 && msg.dst_count == 2, "radius, pacing_ms, dst_count");
+            TEST_FIELD(esp_ncp_wire_aps_bulk_dst_next(msg.dst, msg.dst_len, &offset, &dst), "dst[0]");
+            TEST_FIELD(dst.dst_addr_mode == 2 && esp_ncp_wire_addr_short(&dst.dst_addr) == 0x0022, "dst[0].dst_addr");
+            TEST_FIELD(dst.dst_endpoint == 3 && dst.tx_options == 4, "dst[0].dst_endpoint, tx_options");
+            TEST_FIELD(esp_ncp_wire_aps_bulk_dst_next(msg.dst, msg.dst_len, &offset, &dst), "dst[1]");
+            TEST_FIELD(dst.dst_addr_mode == 3 && !memcmp(dst.dst_addr.bytes, s_ieee, sizeof(s_ieee)), "dst[1].dst_addr");
+            TEST_FIELD(dst.dst_endpoint == 7 && dst.tx_options == 0, "dst[1].dst_endpoint, tx_options");
+            TEST_FIELD(offset == msg.dst_len, "dst_len");
+            TEST_FIELD(msg.asdu_length == sizeof(s_value) && !memcmp(msg.asdu, s_value, sizeof(s_value)), "asdu");
+            return NULL;
+        }
+        default:
+            return "type";
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The payloads of the golden vectors, decoded by the C codecs of the NCP.
+ *
+ */
+typedef enum {
+    TEST_WIRE_C_ZCL_WRITE,                      /*!< esp_ncp_wire_zcl_write_t */
+    TEST_WIRE_C_ZCL_ATTR_READ_BULK,             /*!< esp_ncp_wire_zcl_attr_read_bulk_t */
+    TEST_WIRE_C_ZCL_REPORT_CONFIG,              /*!< esp_ncp_wire_zcl_report_config_t */
+    TEST_WIRE_C_ZCL_WRITE_MULTI,                /*!< esp_ncp_wire_zcl_write_multi_t */
+    TEST_WIRE_C_ZCL_TIMER_ADD,                  /*!< esp_ncp_wire_zcl_timer_add_t */
+    TEST_WIRE_C_STATUS_ID,                      /*!< esp_ncp_wire_status_id_t */
+    TEST_WIRE_C_APS_DATA_REQUEST_BULK,          /*!< esp_ncp_wire_aps_data_request_bulk_t */
+} test_wire_c_type_t;
+
+/**
+ * @brief Decode the payload with the C codec of the type and encode it again.
+ *
+ * @param[in]  type The payload type
+ * @param[in]  in   The payload
+ * @param[in]  len  The payload length
+ * @param[out] out  The encoded payload
+ * @param[in]  size The size of the output buffer
+ *
+ * @return The bytes encoded, 0 if the payload does not decode
+ */
+size_t test_wire_c_round_trip(test_wire_c_type_t type, const uint8_t *in, size_t len, uint8_t *out, size_t size);
+
+/**
+ * @brief Check the fields the C codec decodes from the golden vector of the type.
+ *
+ * @param[in] type The payload type
+ * @param[in] in   The golden vector
+ * @param[in] len  The length of the golden vector
+ *
+ * @return The name of the first field which differs, NULL if all match
+ */
+const char *test_wire_c_fields(test_wire_c_type_t type, const uint8_t *in, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Throughput and latency of back to back requests, e.g. against the Linux NCP:
+ *
+ *   esp_ncp_bench --port /tmp/esp-ncp.sock --count 10000 --window 1
+ *   esp_ncp_bench --port /tmp/esp-ncp.sock --count 10000 --window 32
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "esp_ncp/client.hpp"
+
+using namespace esp_ncp;
+
+namespace {
+
+struct BenchFrame {
+    const char *name;
+    Request (*make)();
+};
+
+const BenchFrame s_frames[] = {
+    {"state", [] { return request::network_state(); }},
+    {"pan_id", [] { return request::network_pan_id_get(); }},
+    {"channel", [] { return request::network_channel_get(); }},
+    {"short_address", [] { return request::network_short_address_get(); }},
+    {"long_address", [] { return request::network_long_address_get(); }},
+    {"primary_key", [] { return request::network_primary_key_get(); }},
+    {"neighbor_table", [] { return request::network_neighbor_table_get(); }},
+};
+
+void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s --port PATH [--baud N] [--count N] [--window N] [--timeout MS] [--frame NAME] [--capture FILE]\n", prog);
+    fprintf(stderr, "  PATH is the Unix socket, the PTY link or the serial port of the NCP\n");
+    fprintf(stderr, "  frames:");
+    for (const BenchFrame &frame : s_frames) {
+        fprintf(stderr, " %s", frame.name);
+    }
+    fprintf(stderr, "\n");
+}
+
+double percentile_us(const std::vector<Clock::duration> &sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+
+    return std::chrono::duration<double, std::micro>(sorted[index]).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string port;
+    uint32_t baud = 0;
+    uint32_t count = 10000;
+    ClientOptions options;
+    const BenchFrame *frame = &s_frames[0];
+
+    for (int i = 1; i < argc; i ++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (!value) {
+            usage(argv[0]);
+            return 1;
+        }
+        i ++;
+        if (!strcmp(arg, "--port")) {
+            port = value;
+        } else if (!strcmp(arg, "--baud")) {
+            baud = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--count")) {
+            count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--window")) {
+            options.window = strtoul(value, nullptr, 0);
+        } else if (!strcmp(arg, "--timeout")) {
+            options.timeout = std::chrono::milliseconds(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--capture")) {
+            try {
+                options.capture = std::make_shared<CaptureWriter>(value);
+            } catch (const std::exception &e) {
+                fprintf(stderr, "%s\n", e.what());
+                return 1;
+            }
+        } else if (!strcmp(arg, "--frame")) {
+            frame = nullptr;
+            for (const BenchFrame &candidate : s_frames) {
+                if (!strcmp(candidate.name, value)) {
+                    frame = &candidate;
+                }
+            }
+            if (!frame) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (port.empty() || count == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::unique_ptr<Transport> transport;
+    try {
+        transport = Transport::open(port, baud);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    Client client(std::move(transport), options);
+    std::vector<Clock::duration> latency;
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    std::promise<void> done;
+
+    latency.reserve(count);
+    /* The callbacks all run on the client thread, the counters need no lock */
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < count; i ++) {
+        client.request(frame->make(), [&](Error error, const FrameView *, Clock::duration elapsed) {
+            if (error == Error::None) {
+                latency.push_back(elapsed);
+            } else {
+                failed ++;
+            }
+            if (++ completed == count) {
+                done.set_value();
+            }
+        });
+    }
+    done.get_future().wait();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Client::Stats stats = client.stats();
+    client.close();
+    std::sort(latency.begin(), latency.end());
+
+    printf("frame %s, window %zu, %" PRIu32 " requests, %" PRIu32 " failed\n", frame->name, options.window, count, failed);
+    printf("%.3f s, %.0f frames/s, tx %.0f B/s, rx %.0f B/s\n", seconds, completed / seconds,
+           static_cast<double>(stats.tx_bytes) / seconds, static_cast<double>(stats.rx.bytes) / seconds);
+    printf("latency us: p50 %.1f, p99 %.1f, max %.1f\n", percentile_us(latency, 0.50), percentile_us(latency, 0.99),
+           percentile_us(latency, 1.0));
+    printf("rx: %" PRIu64 " frames, %" PRIu64 " crc errors, %" PRIu64 " format errors, %" PRIu64 " unmatched\n",
+           stats.rx.frames, stats.rx.crc_errors, stats.rx.format_errors, stats.unmatched);
+
+    return failed ? 2 : 0;
+}
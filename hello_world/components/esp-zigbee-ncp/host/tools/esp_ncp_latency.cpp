@@ -0,0 +1,391 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Request to response latency, one request at a time, split into the link and the NCP, e.g.:
+ *
+ *   esp_ncp_latency --port /tmp/esp-ncp-pty --baud 115200,460800,921600 --sizes 8,32,100
+ *   esp_ncp_latency --port /dev/ttyUSB0 --baud 460800 --frames pan_id,read,aps --count 5000
+ *
+ * The link time of an exchange is its bytes on the wire, the SLIP encoded request and response,
+ * times 10 bits of 8N1 over the baud rate. On a UART the NCP time is the measured latency less the
+ * link time, so the firmware must run at the given baud. The PTY and the socket of the Linux NCP
+ * are not paced, there the NCP time is measured and the total is projected for a UART at each baud.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#include "esp_ncp/client.hpp"
+#include "esp_ncp/histogram.hpp"
+
+using namespace esp_ncp;
+
+namespace {
+
+constexpr uint8_t SIM_ENDPOINT = 1;                 /*!< The endpoint of the devices of the simulated network */
+constexpr size_t NEIGHBOR_RECORD_LEN = 22;          /*!< esp_ncp_zb_nwk_neighbor_record_t */
+constexpr size_t NEIGHBOR_SHORT_ADDR_OFFSET = 8;
+constexpr uint32_t UART_BITS_PER_BYTE = 10;         /*!< 8N1, a start and a stop bit around every byte */
+constexpr unsigned PTY_SLAVE_MAJOR_FIRST = 136;     /*!< The device majors of the Unix98 PTY slaves on Linux */
+constexpr unsigned PTY_SLAVE_MAJOR_LAST = 143;
+
+struct LatencyFrame {
+    const char *name;
+    bool addressed;                                 /*!< The request is sent to a device */
+    bool sized;                                     /*!< The payload grows with --sizes */
+    Request (*make)(uint16_t dst, size_t size, uint8_t seq);
+};
+
+const LatencyFrame s_frames[] = {
+    {"pan_id", false, false, [](uint16_t, size_t, uint8_t) { return request::network_pan_id_get(); }},
+    {"read", true, true, [](uint16_t dst, size_t size, uint8_t) {
+        /* size / 2 attributes of the basic cluster, the IDs are 2 bytes each */
+        std::vector<uint16_t> attr_ids(std::max<size_t>(1, size / 2));
+        for (size_t i = 0; i < attr_ids.size(); i ++) {
+            attr_ids[i] = static_cast<uint16_t>(i);
+        }
+        return request::zcl_attr_read(Destination::device(dst, SIM_ENDPOINT), 0x0000, attr_ids);
+    }},
+    {"aps", true, true, [](uint16_t dst, size_t size, uint8_t seq) {
+        /* A manufacturer specific command of the basic cluster padded to the size */
+        Bytes asdu(std::max<size_t>(3, size), 0x5A);
+        asdu[0] = 0x05;
+        asdu[1] = seq;
+        asdu[2] = 0x00;
+        return request::aps_data_request(Destination::device(dst, SIM_ENDPOINT), 0x0104, 0x0000, asdu);
+    }},
+};
+
+struct Options {
+    std::string port;
+    std::vector<uint32_t> bauds;
+    std::vector<const LatencyFrame *> frames;
+    std::vector<size_t> sizes;
+    uint16_t dst = 0;
+    bool dst_set = false;
+    uint32_t count = 2000;                          /*!< The measured requests of a frame and size */
+    uint32_t warmup = 100;                          /*!< The requests sent before the measurement of a frame and size */
+    std::chrono::microseconds interval{0};          /*!< The pause between two requests */
+    std::chrono::milliseconds timeout{3000};
+    std::string hdr;
+};
+
+void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s --port PATH [--baud N,...] [--frames NAME,...] [--sizes N,...] [--dst ADDR] [--count N] [--warmup N]\n"
+                    "          [--interval US] [--timeout MS] [--hdr PREFIX]\n", prog);
+    fprintf(stderr, "  frames:");
+    for (const LatencyFrame &frame : s_frames) {
+        fprintf(stderr, " %s", frame.name);
+    }
+    fprintf(stderr, "\n  the device defaults to the first of the neighbor table of the NCP\n");
+}
+
+template <typename T>
+bool parse_list(const char *text, std::vector<T> *list)
+{
+    char *end = nullptr;
+
+    list->clear();
+    for (const char *p = text; *p; p = (*end == ',') ? end + 1 : end) {
+        unsigned long value = strtoul(p, &end, 0);
+        if (end == p || (*end && *end != ',')) {
+            return false;
+        }
+        list->push_back(static_cast<T>(value));
+    }
+
+    return !list->empty();
+}
+
+bool parse_frames(const char *text, std::vector<const LatencyFrame *> *frames)
+{
+    std::string spec(text);
+    size_t pos = 0;
+
+    frames->clear();
+    while (pos <= spec.size()) {
+        size_t end = spec.find(',', pos);
+        std::string name = spec.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        const LatencyFrame *frame = nullptr;
+
+        for (const LatencyFrame &candidate : s_frames) {
+            if (name == candidate.name) {
+                frame = &candidate;
+            }
+        }
+        if (!frame) {
+            return false;
+        }
+        frames->push_back(frame);
+        if (end == std::string::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+
+    return !frames->empty();
+}
+
+/* The first short address of the neighbor table, streamed as notifications before the response */
+bool discover_device(Client &client, uint16_t *dst)
+{
+    std::vector<uint16_t> devices;
+    int handle = client.subscribe(frame_id::NETWORK_NEIGHBOR_TABLE_GET, [&devices](const FrameView &frame) {
+        Reader reader(frame.payload, frame.header.len);
+        reader.get<uint8_t>();
+        uint8_t number = reader.get<uint8_t>();
+
+        for (uint8_t i = 0; i < number && reader.remaining() >= NEIGHBOR_RECORD_LEN; i ++) {
+            const uint8_t *record = reader.bytes(NEIGHBOR_RECORD_LEN);
+            devices.push_back(static_cast<uint16_t>(record[NEIGHBOR_SHORT_ADDR_OFFSET] | (record[NEIGHBOR_SHORT_ADDR_OFFSET + 1] << 8)));
+        }
+    });
+
+    Response response = client.call(request::network_neighbor_table_get());
+    client.unsubscribe(handle);
+    if (!response.ok() || response.status() != status::SUCCESS || devices.empty()) {
+        return false;
+    }
+    *dst = devices.front();
+
+    return true;
+}
+
+/* A UART paces the bytes at its baud, the PTY and the socket of the Linux NCP move them at memory speed */
+bool link_paced(const Transport &transport)
+{
+    struct stat st;
+
+    if (!transport.baud() || fstat(transport.fd(), &st) != 0 || !S_ISCHR(st.st_mode)) {
+        return false;
+    }
+
+    return major(st.st_rdev) < PTY_SLAVE_MAJOR_FIRST || major(st.st_rdev) > PTY_SLAVE_MAJOR_LAST;
+}
+
+size_t wire_size(const Header &header, const Bytes &payload)
+{
+    std::vector<uint8_t> out;
+
+    frame_encode(out, header, payload.data(), payload.size());
+
+    return out.size();
+}
+
+uint64_t link_ns(size_t bytes, uint32_t baud)
+{
+    return baud ? static_cast<uint64_t>(bytes) * UART_BITS_PER_BYTE * 1000000000ULL / baud : 0;
+}
+
+struct CellResult {
+    uint64_t sent = 0;
+    uint64_t failed = 0;
+    uint64_t wire_bytes = 0;                        /*!< The request and response bytes of all the measured exchanges */
+    size_t request_bytes = 0;
+    size_t response_bytes = 0;                      /*!< Of the last response */
+    std::vector<uint64_t> measured;                 /*!< The latency of every measured exchange in ns */
+    std::vector<size_t> bytes;                      /*!< The wire bytes of every measured exchange */
+};
+
+/* One frame and size: warmup + count requests, each sent once the previous one completed */
+CellResult run_cell(Client &client, const Options &options, const LatencyFrame &frame, size_t size)
+{
+    CellResult result;
+    uint8_t seq = 0;
+
+    for (uint32_t i = 0; i < options.warmup + options.count; i ++) {
+        Request req = frame.make(options.dst, size, seq ++);
+        Header header;
+
+        header.id = req.id;
+        size_t request_bytes = wire_size(header, req.payload);
+        Response response = client.call(std::move(req), options.timeout);
+        if (i < options.warmup) {
+            continue;
+        }
+
+        result.sent ++;
+        result.request_bytes = request_bytes;
+        if (!response.ok()) {
+            result.failed ++;
+        } else {
+            size_t response_bytes = wire_size(response.header, response.payload);
+            result.response_bytes = response_bytes;
+            result.wire_bytes += request_bytes + response_bytes;
+            result.measured.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(response.latency).count()));
+            result.bytes.push_back(request_bytes + response_bytes);
+        }
+        if (options.interval.count()) {
+            std::this_thread::sleep_for(options.interval);
+        }
+    }
+
+    return result;
+}
+
+void write_hdr(const Options &options, const char *name, size_t size, uint32_t baud, const char *part, const Histogram &h)
+{
+    std::string path = options.hdr + "-" + name + "-" + std::to_string(size) + "-" + std::to_string(baud) + "-" + part + ".hgrm";
+    FILE *file = fopen(path.c_str(), "w");
+
+    if (!file) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+        return;
+    }
+    h.print_percentiles(file, 1000.0);
+    fclose(file);
+}
+
+void print_percentiles(const Histogram &h)
+{
+    printf(" %9.1f %9.1f %9.1f %9.1f %9.1f", static_cast<double>(h.value_at(50)) / 1000, static_cast<double>(h.value_at(90)) / 1000,
+           static_cast<double>(h.value_at(99)) / 1000, static_cast<double>(h.value_at(99.9)) / 1000, static_cast<double>(h.max()) / 1000);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    parse_frames("pan_id,read,aps", &options.frames);
+    options.sizes = {8, 32, 100};
+    options.bauds = {0};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *arg = argv[i];
+        const char *value = argv[i + 1];
+        bool ok = true;
+
+        if (!strcmp(arg, "--port")) {
+            options.port = value;
+        } else if (!strcmp(arg, "--baud")) {
+            ok = parse_list(value, &options.bauds);
+        } else if (!strcmp(arg, "--frames")) {
+            ok = parse_frames(value, &options.frames);
+        } else if (!strcmp(arg, "--sizes")) {
+            ok = parse_list(value, &options.sizes);
+        } else if (!strcmp(arg, "--dst")) {
+            unsigned long addr = strtoul(value, nullptr, 0);
+            ok = addr <= 0xFFFF;
+            options.dst = static_cast<uint16_t>(addr);
+            options.dst_set = true;
+        } else if (!strcmp(arg, "--count")) {
+            options.count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--warmup")) {
+            options.warmup = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--interval")) {
+            options.interval = std::chrono::microseconds(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--timeout")) {
+            options.timeout = std::chrono::milliseconds(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--hdr")) {
+            options.hdr = value;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || options.port.empty() || !options.count) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::unique_ptr<Transport> transport;
+    try {
+        transport = Transport::open(options.port, options.bauds.front());
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    bool paced = link_paced(*transport);
+    if (paced && options.bauds.size() > 1) {
+        fprintf(stderr, "a UART runs at the baud of the NCP firmware, give that one with --baud\n");
+        return 1;
+    }
+
+    ClientOptions client_options;
+    client_options.window = 1;
+    client_options.timeout = options.timeout;
+    Client client(std::move(transport), client_options);
+
+    bool addressed = std::any_of(options.frames.begin(), options.frames.end(), [](const LatencyFrame *frame) { return frame->addressed; });
+    if (addressed && !options.dst_set && !discover_device(client, &options.dst)) {
+        fprintf(stderr, "no device in the neighbor table of the NCP, give one with --dst\n");
+        return 1;
+    }
+
+    printf("%s link, one request at a time, %" PRIu32 " requests per row, latencies in us\n",
+           paced ? "UART" : "unpaced", options.count);
+    if (!paced) {
+        printf("the NCP time is measured, the total adds the link time of a UART at the baud\n");
+    }
+    printf("%-8s %5s %8s %6s %6s %8s %6s | %9s %9s %9s %9s %9s | %9s %9s %9s %9s %9s\n", "frame", "size", "baud",
+           "req B", "rsp B", "link us", "failed", "total p50", "p90", "p99", "p99.9", "max", "ncp p50", "p90", "p99", "p99.9", "max");
+
+    uint64_t failed = 0;
+    for (const LatencyFrame *frame : options.frames) {
+        std::vector<size_t> sizes = frame->sized ? options.sizes : std::vector<size_t>{0};
+
+        for (size_t size : sizes) {
+            CellResult cell = run_cell(client, options, *frame, size);
+            failed += cell.failed;
+
+            for (uint32_t baud : options.bauds) {
+                Histogram total;
+                Histogram ncp;
+                uint64_t completed = cell.measured.size();
+                double mean_link_us = completed ? static_cast<double>(link_ns(cell.wire_bytes, baud)) / completed / 1000 : 0;
+
+                for (size_t i = 0; i < cell.measured.size(); i ++) {
+                    uint64_t link = link_ns(cell.bytes[i], baud);
+                    uint64_t measured = cell.measured[i];
+
+                    if (paced) {
+                        total.record(measured);
+                        ncp.record(measured > link ? measured - link : 0);
+                    } else {
+                        total.record(measured + link);
+                        ncp.record(measured);
+                    }
+                }
+
+                printf("%-8s %5zu %8" PRIu32 " %6zu %6zu %8.1f %6" PRIu64 " |", frame->name, size, baud, cell.request_bytes,
+                       cell.response_bytes, mean_link_us, cell.failed);
+                print_percentiles(total);
+                printf(" |");
+                print_percentiles(ncp);
+                printf("\n");
+                fflush(stdout);
+                if (!options.hdr.empty()) {
+                    write_hdr(options, frame->name, size, baud, "total", total);
+                    write_hdr(options, frame->name, size, baud, "ncp", ncp);
+                }
+            }
+        }
+    }
+
+    Client::Stats stats = client.stats();
+    client.close();
+    printf("rx: %" PRIu64 " frames, %" PRIu64 " crc errors, %" PRIu64 " format errors, %" PRIu64 " unmatched, %" PRIu64 " timeouts\n",
+           stats.rx.frames, stats.rx.crc_errors, stats.rx.format_errors, stats.unmatched, stats.timeouts);
+
+    return failed ? 2 : 0;
+}
@@ -0,0 +1,523 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Open loop load of a mix of requests at a fixed or swept rate, e.g. against the Linux NCP:
+ *
+ *   esp_ncp_loadgen --port /tmp/esp-ncp.sock --mix read=80,write=15,aps=5 --rate 2000 --duration 10
+ *   esp_ncp_loadgen --port /tmp/esp-ncp.sock --mix read=80,write=15,aps=5 --sweep 500:20000:500 --arrival poisson
+ *   esp_ncp_loadgen --port /tmp/esp-ncp.sock --timers 200:500 --sweep 500:5000:500
+ *
+ * The requests are sent on a schedule which does not wait for the responses. The latency of a
+ * request runs from the time the schedule meant to send it, so a stalled NCP is charged for the
+ * requests held back behind it and the percentiles do not suffer from coordinated omission.
+ *
+ * With --timers the NCP also fires periodic timer commands during the load, and each step reports
+ * how late they fired from the ZCL_TIMER_STATS of the NCP.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "esp_ncp/client.hpp"
+#include "esp_ncp/histogram.hpp"
+
+using namespace esp_ncp;
+
+namespace {
+
+constexpr uint8_t SIM_ENDPOINT = 1;                 /*!< The endpoint of the devices of the simulated network */
+constexpr size_t NEIGHBOR_RECORD_LEN = 22;          /*!< esp_ncp_zb_nwk_neighbor_record_t */
+constexpr size_t NEIGHBOR_SHORT_ADDR_OFFSET = 8;
+constexpr size_t TIMER_HIST_BUCKETS = 8;            /*!< ESP_NCP_ZB_TIMER_HIST_BUCKETS */
+constexpr uint8_t RULE_ACTION_APS = 1;              /*!< ESP_NCP_ZB_RULE_ACTION_APS */
+constexpr uint8_t APS_ADDR_MODE_16_ENDP_PRESENT = 0x02;
+
+struct Context {
+    std::vector<uint16_t> devices;                  /*!< The short addresses the ZCL and APS requests go to */
+    uint8_t seq = 0;
+};
+
+uint16_t pick_device(Context &ctx, std::mt19937_64 &rng)
+{
+    return ctx.devices[rng() % ctx.devices.size()];
+}
+
+struct LoadFrame {
+    const char *name;
+    bool addressed;                                 /*!< The request is sent to a device */
+    Request (*make)(Context &ctx, std::mt19937_64 &rng);
+};
+
+const LoadFrame s_frames[] = {
+    {"read", true, [](Context &ctx, std::mt19937_64 &rng) {
+        return request::zcl_attr_read(Destination::device(pick_device(ctx, rng), SIM_ENDPOINT), 0x0006, {0x0000});
+    }},
+    {"write", true, [](Context &ctx, std::mt19937_64 &rng) {
+        AttrValue level{0x0000, 0x20, {static_cast<uint8_t>(rng())}};
+        return request::zcl_attr_write(Destination::device(pick_device(ctx, rng), SIM_ENDPOINT), 0x0008, {level});
+    }},
+    {"aps", true, [](Context &ctx, std::mt19937_64 &rng) {
+        /* A cluster specific ZCL toggle of the on/off cluster */
+        Bytes asdu = {0x01, ctx.seq ++, 0x02};
+        return request::aps_data_request(Destination::device(pick_device(ctx, rng), SIM_ENDPOINT), 0x0104, 0x0006, asdu);
+    }},
+    {"state", false, [](Context &, std::mt19937_64 &) { return request::network_state(); }},
+    {"pan_id", false, [](Context &, std::mt19937_64 &) { return request::network_pan_id_get(); }},
+    {"channel", false, [](Context &, std::mt19937_64 &) { return request::network_channel_get(); }},
+    {"short_address", false, [](Context &, std::mt19937_64 &) { return request::network_short_address_get(); }},
+};
+
+struct MixEntry {
+    const LoadFrame *frame;
+    uint32_t weight;
+};
+
+struct Options {
+    std::string port;
+    uint32_t baud = 0;
+    std::vector<MixEntry> mix;
+    std::vector<uint16_t> devices;
+    double rate_start = 1000;
+    double rate_stop = 1000;
+    double rate_step = 0;
+    double duration = 10;                           /*!< The measured seconds of a step */
+    double warmup = 1;                              /*!< The seconds sent before the measurement of a step */
+    bool poisson = false;
+    uint64_t seed = 1;
+    size_t window = 256;
+    std::chrono::milliseconds timeout{3000};
+    double saturation = 0.95;                       /*!< The fraction of the offered rate under which the NCP is saturated */
+    std::string hdr;
+    uint32_t timers = 0;                            /*!< The periodic timers the NCP fires during the load */
+    uint32_t timer_period_ms = 1000;
+};
+
+void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s --port PATH [--baud N] [--mix NAME=WEIGHT,...] [--dst ADDR,...] [--rate R | --sweep START:STOP:STEP]\n"
+                    "          [--duration S] [--warmup S] [--arrival constant|poisson] [--seed N] [--window N] [--timeout MS]\n"
+                    "          [--saturation F] [--hdr PREFIX] [--timers N:PERIOD_MS]\n", prog);
+    fprintf(stderr, "  frames:");
+    for (const LoadFrame &frame : s_frames) {
+        fprintf(stderr, " %s", frame.name);
+    }
+    fprintf(stderr, "\n  the devices default to the neighbor table of the NCP\n");
+}
+
+bool parse_mix(const char *text, std::vector<MixEntry> *mix)
+{
+    std::string spec(text);
+    size_t pos = 0;
+
+    mix->clear();
+    while (pos <= spec.size()) {
+        size_t end = spec.find(',', pos);
+        std::string item = spec.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        size_t eq = item.find('=');
+        std::string name = item.substr(0, eq);
+        uint32_t weight = (eq == std::string::npos) ? 1 : static_cast<uint32_t>(strtoul(item.c_str() + eq + 1, nullptr, 0));
+        const LoadFrame *frame = nullptr;
+
+        for (const LoadFrame &candidate : s_frames) {
+            if (name == candidate.name) {
+                frame = &candidate;
+            }
+        }
+        if (!frame) {
+            return false;
+        }
+        if (weight) {
+            mix->push_back(MixEntry{frame, weight});
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+
+    return !mix->empty();
+}
+
+bool parse_devices(const char *text, std::vector<uint16_t> *devices)
+{
+    char *end = nullptr;
+
+    for (const char *p = text; *p; p = (*end == ',') ? end + 1 : end) {
+        unsigned long addr = strtoul(p, &end, 0);
+        if (end == p || addr > 0xFFFF) {
+            return false;
+        }
+        devices->push_back(static_cast<uint16_t>(addr));
+    }
+
+    return !devices->empty();
+}
+
+/* The short addresses of the neighbor table, streamed as notifications before the response */
+std::vector<uint16_t> discover_devices(Client &client)
+{
+    std::vector<uint16_t> devices;
+    int handle = client.subscribe(frame_id::NETWORK_NEIGHBOR_TABLE_GET, [&devices](const FrameView &frame) {
+        Reader reader(frame.payload, frame.header.len);
+        reader.get<uint8_t>();
+        uint8_t number = reader.get<uint8_t>();
+
+        for (uint8_t i = 0; i < number && reader.remaining() >= NEIGHBOR_RECORD_LEN; i ++) {
+            const uint8_t *record = reader.bytes(NEIGHBOR_RECORD_LEN);
+            devices.push_back(static_cast<uint16_t>(record[NEIGHBOR_SHORT_ADDR_OFFSET] | (record[NEIGHBOR_SHORT_ADDR_OFFSET + 1] << 8)));
+        }
+    });
+
+    Response response = client.call(request::network_neighbor_table_get());
+    client.unsubscribe(handle);
+    if (!response.ok() || response.status() != status::SUCCESS) {
+        devices.clear();
+    }
+
+    return devices;
+}
+
+/* An APS toggle of the on/off cluster of a device, encoded as a timer command */
+Bytes timer_action(Context &ctx, std::mt19937_64 &rng)
+{
+    Bytes action;
+    Writer w(action);
+    uint16_t dst = pick_device(ctx, rng);
+
+    w.put<uint8_t>(RULE_ACTION_APS).put<uint8_t>(APS_ADDR_MODE_16_ENDP_PRESENT).put<uint16_t>(dst).put<uint8_t>(SIM_ENDPOINT);
+    w.put<uint8_t>(SIM_ENDPOINT).put<uint16_t>(0x0104).put<uint16_t>(0x0006).put<uint8_t>(0).put<uint8_t>(0);
+    w.put<uint8_t>(3).put<uint8_t>(0x01).put<uint8_t>(0x00).put<uint8_t>(0x02);
+
+    return action;
+}
+
+/* The timers start spread evenly over one period so that they do not all fire in the same tick */
+std::vector<uint32_t> arm_timers(Client &client, const Options &options, Context &ctx, std::mt19937_64 &rng)
+{
+    std::vector<uint32_t> ids;
+
+    for (uint32_t i = 0; i < options.timers; i ++) {
+        uint32_t delay_ms = static_cast<uint32_t>(static_cast<uint64_t>(options.timer_period_ms) * i / options.timers);
+        Response response = client.call(request::zcl_timer_add(false, delay_ms, 0, options.timer_period_ms, timer_action(ctx, rng)));
+
+        if (!response.ok() || response.status() != status::SUCCESS || response.payload.size() < 1 + sizeof(uint32_t)) {
+            fprintf(stderr, "timer %" PRIu32 " refused, status %u\n", i, response.status());
+            break;
+        }
+        Reader reader = response.reader();
+        reader.get<uint8_t>();
+        ids.push_back(reader.get<uint32_t>());
+    }
+
+    return ids;
+}
+
+struct TimerResult {
+    bool valid = false;
+    uint32_t fired = 0;
+    uint32_t errors = 0;
+    uint32_t jitter_avg_us = 0;
+    uint32_t jitter_max_us = 0;
+    uint32_t hist[TIMER_HIST_BUCKETS] = {};
+};
+
+TimerResult timer_stats(Client &client, bool reset)
+{
+    TimerResult result;
+    Response response = client.call(request::zcl_timer_stats(reset));
+
+    if (response.ok() && response.status() == status::SUCCESS
+            && response.payload.size() >= 1 + 2 * sizeof(uint16_t) + (4 + TIMER_HIST_BUCKETS) * sizeof(uint32_t)) {
+        Reader reader = response.reader();
+        reader.get<uint8_t>();
+        reader.get<uint16_t>();
+        reader.get<uint16_t>();
+        result.fired = reader.get<uint32_t>();
+        result.errors = reader.get<uint32_t>();
+        result.jitter_avg_us = reader.get<uint32_t>();
+        result.jitter_max_us = reader.get<uint32_t>();
+        for (uint32_t &bucket : result.hist) {
+            bucket = reader.get<uint32_t>();
+        }
+        result.valid = true;
+    }
+
+    return result;
+}
+
+void print_timers(const TimerResult &timers)
+{
+    if (!timers.valid) {
+        printf("%10s timer statistics unavailable\n", "");
+        return;
+    }
+    printf("%10s timers: %" PRIu32 " fired, %" PRIu32 " errors, late avg %" PRIu32 " us, max %" PRIu32 " us, <20/40/80/160/320/640/1280/more ms:",
+           "", timers.fired, timers.errors, timers.jitter_avg_us, timers.jitter_max_us);
+    for (uint32_t bucket : timers.hist) {
+        printf(" %" PRIu32, bucket);
+    }
+    printf("\n");
+}
+
+struct StepResult {
+    double offered = 0;
+    double achieved = 0;
+    uint64_t sent = 0;                              /*!< The requests of the measurement */
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    Histogram latency;
+};
+
+/**
+ * One step of the sweep: send at the rate for warmup + duration seconds, then wait for all the
+ * responses. Only the requests scheduled after the warmup are measured.
+ */
+StepResult run_step(Client &client, const Options &options, Context &ctx, double rate, std::mt19937_64 &rng)
+{
+    struct Shared {
+        std::mutex lock;
+        std::condition_variable cond;
+        uint64_t outstanding = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        Clock::time_point last{};
+        Histogram latency;
+    } shared;
+    StepResult result;
+    std::exponential_distribution<double> exponential(rate);
+    std::uniform_int_distribution<uint32_t> pick(0, 0);
+    uint32_t total_weight = 0;
+
+    for (const MixEntry &entry : options.mix) {
+        total_weight += entry.weight;
+    }
+    pick = std::uniform_int_distribution<uint32_t>(0, total_weight - 1);
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point measure = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.warmup));
+    Clock::time_point stop = measure + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+    Clock::time_point intended = start;
+    double interval = 1.0 / rate;
+
+    while (intended < stop) {
+        uint32_t slot = pick(rng);
+        const MixEntry *entry = &options.mix.front();
+        for (const MixEntry &candidate : options.mix) {
+            if (slot < candidate.weight) {
+                entry = &candidate;
+                break;
+            }
+            slot -= candidate.weight;
+        }
+
+        /* Behind the schedule the requests go out back to back until it is caught up */
+        std::this_thread::sleep_until(intended);
+        bool measured = intended >= measure;
+        if (measured) {
+            result.sent ++;
+            std::lock_guard<std::mutex> guard(shared.lock);
+            shared.outstanding ++;
+        }
+        client.request(entry->frame->make(ctx, rng), [&shared, intended, measured](Error error, const FrameView *, Clock::duration) {
+            Clock::time_point now = Clock::now();
+
+            if (!measured) {
+                return;
+            }
+            std::lock_guard<std::mutex> guard(shared.lock);
+            if (error == Error::None) {
+                shared.latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - intended).count()));
+                shared.completed ++;
+                shared.last = now;
+            } else {
+                shared.failed ++;
+            }
+            if (-- shared.outstanding == 0) {
+                shared.cond.notify_all();
+            }
+        }, options.timeout);
+
+        double gap = options.poisson ? exponential(rng) : interval;
+        intended += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(gap));
+    }
+
+    std::unique_lock<std::mutex> guard(shared.lock);
+    shared.cond.wait(guard, [&shared] { return shared.outstanding == 0; });
+
+    /* The achieved rate counts the responses until the last one of the measurement */
+    double seconds = std::chrono::duration<double>(std::max(shared.last, stop) - measure).count();
+    result.offered = rate;
+    result.achieved = seconds > 0 ? static_cast<double>(shared.completed) / seconds : 0;
+    result.completed = shared.completed;
+    result.failed = shared.failed;
+    result.latency = shared.latency;
+
+    return result;
+}
+
+void write_hdr(const Options &options, const StepResult &result)
+{
+    std::string path = options.hdr + "-" + std::to_string(static_cast<uint64_t>(result.offered)) + ".hgrm";
+    FILE *file = fopen(path.c_str(), "w");
+
+    if (!file) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+        return;
+    }
+    result.latency.print_percentiles(file, 1000.0);
+    fclose(file);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    parse_mix("read=80,write=15,aps=5", &options.mix);
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *arg = argv[i];
+        const char *value = argv[i + 1];
+        bool ok = true;
+
+        if (!strcmp(arg, "--port")) {
+            options.port = value;
+        } else if (!strcmp(arg, "--baud")) {
+            options.baud = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--mix")) {
+            ok = parse_mix(value, &options.mix);
+        } else if (!strcmp(arg, "--dst")) {
+            ok = parse_devices(value, &options.devices);
+        } else if (!strcmp(arg, "--rate")) {
+            options.rate_start = options.rate_stop = atof(value);
+            options.rate_step = 0;
+        } else if (!strcmp(arg, "--sweep")) {
+            ok = sscanf(value, "%lf:%lf:%lf", &options.rate_start, &options.rate_stop, &options.rate_step) == 3 &&
+                 options.rate_step > 0;
+        } else if (!strcmp(arg, "--duration")) {
+            options.duration = atof(value);
+        } else if (!strcmp(arg, "--warmup")) {
+            options.warmup = std::max(0.0, atof(value));
+        } else if (!strcmp(arg, "--arrival")) {
+            options.poisson = !strcmp(value, "poisson");
+            ok = options.poisson || !strcmp(value, "constant");
+        } else if (!strcmp(arg, "--seed")) {
+            options.seed = strtoull(value, nullptr, 0);
+        } else if (!strcmp(arg, "--window")) {
+            options.window = strtoul(value, nullptr, 0);
+        } else if (!strcmp(arg, "--timeout")) {
+            options.timeout = std::chrono::milliseconds(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--saturation")) {
+            options.saturation = atof(value);
+        } else if (!strcmp(arg, "--hdr")) {
+            options.hdr = value;
+        } else if (!strcmp(arg, "--timers")) {
+            ok = sscanf(value, "%" SCNu32 ":%" SCNu32, &options.timers, &options.timer_period_ms) == 2 && options.timer_period_ms > 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || options.port.empty() || options.rate_start <= 0 || options.duration <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::unique_ptr<Transport> transport;
+    try {
+        transport = Transport::open(options.port, options.baud);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    ClientOptions client_options;
+    client_options.window = options.window;
+    client_options.timeout = options.timeout;
+    Client client(std::move(transport), client_options);
+    Context ctx;
+    std::mt19937_64 rng(options.seed);
+
+    bool addressed = options.timers ||
+                     std::any_of(options.mix.begin(), options.mix.end(), [](const MixEntry &entry) { return entry.frame->addressed; });
+    ctx.devices = options.devices;
+    if (addressed && ctx.devices.empty()) {
+        ctx.devices = discover_devices(client);
+        if (ctx.devices.empty()) {
+            fprintf(stderr, "no device in the neighbor table of the NCP, give them with --dst\n");
+            return 1;
+        }
+    }
+
+    std::vector<uint32_t> timer_ids = arm_timers(client, options, ctx, rng);
+    if (options.timers) {
+        printf("%zu timers every %" PRIu32 " ms\n", timer_ids.size(), options.timer_period_ms);
+    }
+    printf("mix");
+    for (const MixEntry &entry : options.mix) {
+        printf(" %s=%" PRIu32, entry.frame->name, entry.weight);
+    }
+    printf(", %zu devices, %s arrivals, window %zu, %.1f s per step\n", ctx.devices.size(),
+           options.poisson ? "poisson" : "constant", options.window, options.duration);
+    printf("%10s %10s %10s %8s %10s %10s %10s %10s %10s\n", "offered/s", "achieved/s", "requests", "failed",
+           "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+
+    int saturated = 0;
+    for (double rate = options.rate_start; rate <= options.rate_stop + 1e-9; rate += options.rate_step) {
+        if (!timer_ids.empty()) {
+            timer_stats(client, true);
+        }
+        StepResult result = run_step(client, options, ctx, rate, rng);
+        const Histogram &h = result.latency;
+
+        printf("%10.0f %10.0f %10" PRIu64 " %8" PRIu64 " %10.1f %10.1f %10.1f %10.1f %10.1f\n", result.offered, result.achieved,
+               result.sent, result.failed, static_cast<double>(h.value_at(50)) / 1000, static_cast<double>(h.value_at(90)) / 1000,
+               static_cast<double>(h.value_at(99)) / 1000, static_cast<double>(h.value_at(99.9)) / 1000,
+               static_cast<double>(h.max()) / 1000);
+        if (!timer_ids.empty()) {
+            print_timers(timer_stats(client, false));
+        }
+        fflush(stdout);
+        if (!options.hdr.empty()) {
+            write_hdr(options, result);
+        }
+
+        /* Past the knee the latency only grows with the queue, the sweep stops there */
+        if (result.failed || result.achieved < options.saturation * result.offered) {
+            printf("saturated at %.0f requests/s offered, %.0f achieved\n", result.offered, result.achieved);
+            saturated = 1;
+            break;
+        }
+        if (options.rate_step <= 0) {
+            break;
+        }
+    }
+
+    for (uint32_t id : timer_ids) {
+        client.call(request::zcl_timer_cancel(id));
+    }
+
+    Client::Stats stats = client.stats();
+    client.close();
+    printf("rx: %" PRIu64 " frames, %" PRIu64 " crc errors, %" PRIu64 " format errors, %" PRIu64 " unmatched, %" PRIu64 " timeouts\n",
+           stats.rx.frames, stats.rx.crc_errors, stats.rx.format_errors, stats.unmatched, stats.timeouts);
+
+    return saturated ? 2 : 0;
+}
@@ -0,0 +1,765 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Shares one NCP between many host processes:
+ *
+ *   esp_ncp_muxd --port /dev/ttyUSB0 --baud 460800 --listen /tmp/esp-ncp-mux.sock
+ *
+ * The clients speak the NCP protocol to the listening socket as they would to the NCP, so
+ * esp_ncp::Transport::open_socket() connects them unchanged. The daemon gives every request
+ * an sn of its own on the NCP and maps the response back to the client and its sn. The
+ * notifications are never routed by sn, each one goes to every client whose filter lets it
+ * through. The notifications queued to a client are bounded, a slow client loses its
+ * own notifications by the overflow policy and never holds the NCP back.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "esp_ncp/capture.hpp"
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/frame_id.hpp"
+#include "esp_ncp/request.hpp"
+#include "esp_ncp/transport.hpp"
+
+using namespace esp_ncp;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint64_t MUXD_TAG_NCP = 0;            /*!< The epoll tag of the NCP transport */
+constexpr uint64_t MUXD_TAG_LISTEN = 1;         /*!< The epoll tag of the listening socket, the clients count from 2 */
+constexpr size_t MUXD_ROUTES = 256;             /*!< One route per sn on the NCP */
+constexpr int MUXD_READ_BURST = 16;             /*!< The reads per wakeup and fd */
+constexpr int MUXD_WRITE_IOV = 64;              /*!< The frames per writev() to a client */
+
+enum class Overflow {
+    DropOldest,                                 /*!< Drop the oldest queued notification to make room */
+    DropNewest,                                 /*!< Drop the notification which does not fit */
+    Disconnect,                                 /*!< Close the client */
+};
+
+struct Options {
+    std::string port;
+    uint32_t baud = 0;
+    std::string listen = "/tmp/esp-ncp-mux.sock";
+    size_t queue = 1024;                        /*!< The notifications queued per client */
+    Overflow overflow = Overflow::DropOldest;
+    size_t client_requests = 64;                /*!< The requests of one client waiting for an sn before its socket is no longer read */
+    std::chrono::milliseconds timeout{10000};   /*!< How long a request may wait for its response before its sn is reused */
+    std::string capture;                        /*!< The capture file of the NCP traffic, none if empty */
+    bool verbose = false;
+};
+
+struct Outgoing {
+    std::shared_ptr<const Bytes> data;          /*!< The SLIP encoded frame, shared by the clients of a notification */
+    bool droppable;                             /*!< A notification, responses are never dropped */
+};
+
+struct Queued {
+    uint8_t sn;                                 /*!< The sn of the client */
+    uint8_t version;
+    Request req;
+};
+
+struct Conn {
+    uint32_t id = 0;
+    int fd = -1;
+    FrameDecoder decoder;
+    std::deque<Outgoing> out;
+    size_t out_offset = 0;                      /*!< The bytes of out.front() written */
+    size_t notify_queued = 0;
+    std::deque<Queued> waiting;                 /*!< The requests waiting for an sn on the NCP */
+    bool reading = true;
+    bool write_wait = false;
+    bool forward_all = true;                    /*!< The filter, forward all but except or none but except */
+    std::unordered_set<uint16_t> except;
+    uint64_t requests = 0;
+    uint64_t responses = 0;
+    uint64_t notifications = 0;
+    uint64_t dropped = 0;
+    uint32_t dropped_pending = 0;               /*!< Dropped since the last MUX_DROPPED */
+
+    bool wants(uint16_t frame_id) const { return forward_all != (except.count(frame_id) != 0); }
+};
+
+struct Route {
+    enum State : uint8_t { Free, InFlight };
+
+    State state = Free;
+    uint32_t client = 0;
+    uint8_t client_sn = 0;
+    uint16_t id = 0;
+    Clock::time_point since;                    /*!< When the request was sent */
+};
+
+volatile sig_atomic_t s_stop = 0;
+
+void on_signal(int)
+{
+    s_stop = 1;
+}
+
+std::shared_ptr<const Bytes> encode(FrameType type, uint16_t id, uint8_t sn, uint8_t version, const uint8_t *payload, size_t len)
+{
+    auto data = std::make_shared<Bytes>();
+    Header header;
+
+    header.version = version;
+    header.type = type;
+    header.id = id;
+    header.sn = sn;
+    header.len = static_cast<uint16_t>(len);
+    frame_encode(*data, header, payload, len);
+
+    return data;
+}
+
+class Mux {
+public:
+    explicit Mux(const Options &options) : options_(options) {}
+
+    int run();
+
+private:
+    bool listen_open();
+    void accept_clients();
+    void close_client(uint32_t id, const char *reason);
+    void update_events(Conn &conn);
+
+    bool ncp_receive();
+    bool ncp_flush();
+    void on_ncp_frame(const FrameView &frame);
+
+    void client_receive(Conn &conn);
+    void client_flush(Conn &conn);
+    void on_client_frame(Conn &conn, const FrameView &frame);
+    void respond(Conn &conn, const FrameView &request, const Bytes &payload);
+    void enqueue(Conn &conn, std::shared_ptr<const Bytes> data, bool droppable);
+
+    int route_alloc();
+    void dispatch(Clock::time_point now);
+    void expire(Clock::time_point now);
+
+    Options options_;
+    std::unique_ptr<CaptureWriter> capture_;
+    Bytes capture_buf_;
+    std::unique_ptr<Transport> ncp_;
+    FrameDecoder ncp_decoder_;
+    Bytes ncp_tx_;
+    size_t ncp_tx_offset_ = 0;
+    bool ncp_write_wait_ = false;
+    int epoll_fd_ = -1;
+    int listen_fd_ = -1;
+    std::map<uint32_t, std::unique_ptr<Conn>> clients_;
+    uint32_t next_client_ = 2;
+    uint32_t rr_next_ = 0;                      /*!< The client served first by the next dispatch */
+    Route routes_[MUXD_ROUTES];
+    size_t in_flight_ = 0;
+    uint8_t next_sn_ = 0;
+    uint64_t unmatched_ = 0;
+    uint64_t timeouts_ = 0;
+};
+
+int Mux::run()
+{
+    struct epoll_event event = {};
+
+    try {
+        ncp_ = Transport::open(options_.port, options_.baud);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    if (!options_.capture.empty()) {
+        try {
+            capture_ = std::make_unique<CaptureWriter>(options_.capture);
+        } catch (const std::exception &e) {
+            fprintf(stderr, "%s\n", e.what());
+            return 1;
+        }
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0 || !listen_open()) {
+        return 1;
+    }
+    event.events = EPOLLIN;
+    event.data.u64 = MUXD_TAG_NCP;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, ncp_->fd(), &event);
+    event.data.u64 = MUXD_TAG_LISTEN;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+    fprintf(stderr, "esp_ncp_muxd: %s shared on %s\n", options_.port.c_str(), options_.listen.c_str());
+
+    int ret = 0;
+    while (!s_stop) {
+        struct epoll_event events[64];
+        int n = epoll_wait(epoll_fd_, events, 64, 1000);
+
+        if (n < 0 && errno != EINTR) {
+            ret = 1;
+            break;
+        }
+        for (int i = 0; i < n; i ++) {
+            uint64_t tag = events[i].data.u64;
+
+            if (tag == MUXD_TAG_NCP) {
+                if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !ncp_receive()) {
+                    fprintf(stderr, "esp_ncp_muxd: the NCP closed the link\n");
+                    s_stop = 1;
+                    ret = 1;
+                } else if ((events[i].events & EPOLLOUT) && !ncp_flush()) {
+                    s_stop = 1;
+                    ret = 1;
+                }
+            } else if (tag == MUXD_TAG_LISTEN) {
+                accept_clients();
+            } else {
+                auto it = clients_.find(static_cast<uint32_t>(tag));
+                if (it == clients_.end()) {
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    it->second->write_wait = false;
+                    update_events(*it->second);
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    client_receive(*it->second);
+                }
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        expire(now);
+        dispatch(now);
+        if (!ncp_write_wait_ && ncp_tx_offset_ < ncp_tx_.size() && !ncp_flush()) {
+            ret = 1;
+            break;
+        }
+
+        /* Collect the ids first, a failed write closes the client */
+        std::vector<uint32_t> ids;
+        for (auto &it : clients_) {
+            if (!it.second->out.empty() && !it.second->write_wait) {
+                ids.push_back(it.first);
+            }
+        }
+        for (uint32_t id : ids) {
+            auto it = clients_.find(id);
+            if (it != clients_.end()) {
+                client_flush(*it->second);
+            }
+        }
+    }
+
+    while (!clients_.empty()) {
+        close_client(clients_.begin()->first, "shutdown");
+    }
+    ::close(listen_fd_);
+    unlink(options_.listen.c_str());
+    ::close(epoll_fd_);
+
+    return ret;
+}
+
+bool Mux::listen_open()
+{
+    struct sockaddr_un addr = {};
+
+    if (options_.listen.size() >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "listen path too long\n");
+        return false;
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, options_.listen.c_str(), options_.listen.size());
+    unlink(options_.listen.c_str());
+    if (listen_fd_ < 0 || bind(listen_fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0
+        || listen(listen_fd_, 16) != 0) {
+        fprintf(stderr, "listen %s: %s\n", options_.listen.c_str(), strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+void Mux::accept_clients()
+{
+    int fd;
+
+    while ((fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        auto conn = std::make_unique<Conn>();
+        struct epoll_event event = {};
+
+        conn->id = next_client_ ++;
+        conn->fd = fd;
+        event.events = EPOLLIN;
+        event.data.u64 = conn->id;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+        if (options_.verbose) {
+            fprintf(stderr, "esp_ncp_muxd: client %u connected\n", conn->id);
+        }
+        clients_.emplace(conn->id, std::move(conn));
+    }
+}
+
+void Mux::close_client(uint32_t id, const char *reason)
+{
+    auto it = clients_.find(id);
+
+    if (it == clients_.end()) {
+        return;
+    }
+    if (options_.verbose) {
+        fprintf(stderr, "esp_ncp_muxd: client %u closed, %s\n", id, reason);
+    }
+    /* The routes of its requests stay until the responses arrive, they are dropped then */
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    ::close(it->second->fd);
+    clients_.erase(it);
+}
+
+void Mux::update_events(Conn &conn)
+{
+    struct epoll_event event = {};
+
+    event.events = (conn.reading ? EPOLLIN : 0u) | (conn.write_wait ? EPOLLOUT : 0u);
+    event.data.u64 = conn.id;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, conn.fd, &event);
+}
+
+bool Mux::ncp_receive()
+{
+    for (int i = 0; i < MUXD_READ_BURST; i ++) {
+        size_t len;
+        uint8_t *buf = ncp_decoder_.prepare(&len);
+        ssize_t ret = ncp_->read(buf, len);
+
+        if (ret > 0) {
+            ncp_decoder_.commit(static_cast<size_t>(ret), [this](const FrameView &frame) { on_ncp_frame(frame); });
+        } else if (ret < 0 && errno == EINTR) {
+            continue;
+        } else {
+            return ret < 0 && errno == EAGAIN;
+        }
+    }
+
+    return true;
+}
+
+bool Mux::ncp_flush()
+{
+    while (ncp_tx_offset_ < ncp_tx_.size()) {
+        ssize_t ret = ncp_->write(&ncp_tx_[ncp_tx_offset_], ncp_tx_.size() - ncp_tx_offset_);
+
+        if (ret > 0) {
+            ncp_tx_offset_ += static_cast<size_t>(ret);
+        } else if (ret < 0 && errno == EINTR) {
+            continue;
+        } else if (ret < 0 && errno == EAGAIN) {
+            break;
+        } else {
+            fprintf(stderr, "esp_ncp_muxd: write to the NCP: %s\n", strerror(errno));
+            return false;
+        }
+    }
+
+    bool blocked = ncp_tx_offset_ < ncp_tx_.size();
+    if (!blocked) {
+        ncp_tx_.clear();
+        ncp_tx_offset_ = 0;
+    }
+    if (blocked != ncp_write_wait_) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN | (blocked ? EPOLLOUT : 0u);
+        event.data.u64 = MUXD_TAG_NCP;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, ncp_->fd(), &event);
+        ncp_write_wait_ = blocked;
+    }
+
+    return true;
+}
+
+void Mux::on_ncp_frame(const FrameView &frame)
+{
+    const Header &header = frame.header;
+    Route &route = routes_[header.sn];
+    Clock::time_point now = Clock::now();
+
+    if (capture_) {
+        capture_buf_.clear();
+        frame_encode(capture_buf_, header, frame.payload, header.len);
+        capture_->write(CaptureDirection::FromNcp, now, capture_buf_.data(), capture_buf_.size());
+    }
+
+    if (header.type == FrameType::Response && header.id != frame_id::ERROR) {
+        if (route.state != Route::InFlight || route.id != header.id) {
+            unmatched_ ++;
+            return;
+        }
+        route.state = Route::Free;
+        in_flight_ --;
+
+        auto it = clients_.find(route.client);
+        if (it != clients_.end()) {
+            it->second->responses ++;
+            enqueue(*it->second, encode(header.type, header.id, route.client_sn, header.version, frame.payload, header.len), false);
+        }
+        return;
+    }
+
+    /* Only the responses are routed by sn, every notification goes to all the clients which want it */
+    std::shared_ptr<const Bytes> data;
+    for (auto &it : clients_) {
+        Conn &conn = *it.second;
+        if (!conn.wants(header.id)) {
+            continue;
+        }
+        if (!data) {
+            data = encode(header.type, header.id, header.sn, header.version, frame.payload, header.len);
+        }
+        conn.notifications ++;
+        enqueue(conn, data, true);
+    }
+}
+
+void Mux::enqueue(Conn &conn, std::shared_ptr<const Bytes> data, bool droppable)
+{
+    if (droppable && conn.notify_queued >= options_.queue) {
+        if (options_.overflow == Overflow::Disconnect) {
+            conn.reading = false;
+            conn.out.clear();
+            conn.out_offset = 0;
+            conn.notify_queued = 0;
+            conn.dropped ++;
+            /* Closed by client_flush(), the client may be iterated by the caller */
+            conn.out.push_back(Outgoing{nullptr, false});
+            return;
+        }
+
+        conn.dropped ++;
+        conn.dropped_pending ++;
+        if (options_.overflow == Overflow::DropNewest) {
+            return;
+        }
+
+        /* The front frame may be partly written already, it stays */
+        auto it = std::find_if(conn.out.begin() + (conn.out_offset ? 1 : 0), conn.out.end(),
+                               [](const Outgoing &out) { return out.droppable; });
+        if (it == conn.out.end()) {
+            return;
+        }
+        conn.out.erase(it);
+        conn.notify_queued --;
+    }
+
+    conn.out.push_back(Outgoing{std::move(data), droppable});
+    conn.notify_queued += droppable;
+}
+
+void Mux::client_receive(Conn &conn)
+{
+    uint32_t id = conn.id;
+
+    for (int i = 0; i < MUXD_READ_BURST && conn.reading; i ++) {
+        size_t len;
+        uint8_t *buf = conn.decoder.prepare(&len);
+        ssize_t ret = ::read(conn.fd, buf, len);
+
+        if (ret > 0) {
+            conn.decoder.commit(static_cast<size_t>(ret), [&](const FrameView &frame) { on_client_frame(conn, frame); });
+        } else if (ret < 0 && errno == EINTR) {
+            continue;
+        } else if (ret < 0 && errno == EAGAIN) {
+            break;
+        } else {
+            close_client(id, ret == 0 ? "hung up" : strerror(errno));
+            return;
+        }
+    }
+
+    /* A client flooding requests is no longer read until the NCP catches up */
+    if (conn.reading && conn.waiting.size() >= options_.client_requests) {
+        conn.reading = false;
+        update_events(conn);
+    }
+}
+
+void Mux::respond(Conn &conn, const FrameView &request, const Bytes &payload)
+{
+    enqueue(conn, encode(FrameType::Response, request.header.id, request.header.sn, request.header.version,
+                         payload.data(), payload.size()), false);
+}
+
+void Mux::on_client_frame(Conn &conn, const FrameView &frame)
+{
+    const Header &header = frame.header;
+    Bytes payload;
+    Writer w(payload);
+
+    if (header.type != FrameType::Request) {
+        return;
+    }
+
+    if (header.id == frame_id::MUX_FILTER_SET) {
+        Reader r = frame.reader();
+        bool forward_all = r.get<uint8_t>();
+        std::unordered_set<uint16_t> except;
+
+        while (r.ok() && r.remaining() >= sizeof(uint16_t)) {
+            except.insert(r.get<uint16_t>());
+        }
+        if (!r.ok() || header.len == 0 || r.remaining()) {
+            w.put<uint8_t>(status::BAD_ARGUMENT);
+        } else {
+            conn.forward_all = forward_all;
+            conn.except = std::move(except);
+            w.put<uint8_t>(status::SUCCESS);
+        }
+        respond(conn, frame, payload);
+        return;
+    }
+
+    if (header.id == frame_id::MUX_STATS) {
+        size_t waiting = 0;
+        for (auto &it : clients_) {
+            waiting += it.second->waiting.size();
+        }
+        w.put<uint8_t>(status::SUCCESS).put<uint16_t>(static_cast<uint16_t>(clients_.size()));
+        w.put<uint16_t>(static_cast<uint16_t>(in_flight_)).put<uint32_t>(static_cast<uint32_t>(waiting));
+        w.put<uint64_t>(unmatched_).put<uint64_t>(timeouts_);
+        w.put<uint64_t>(conn.requests).put<uint64_t>(conn.responses).put<uint64_t>(conn.notifications).put<uint64_t>(conn.dropped);
+        respond(conn, frame, payload);
+        return;
+    }
+
+    conn.requests ++;
+    conn.waiting.push_back(Queued{header.sn, header.version, Request{header.id, Bytes(frame.payload, frame.payload + header.len)}});
+}
+
+void Mux::client_flush(Conn &conn)
+{
+    if (!conn.out.empty() && !conn.out.front().data) {
+        close_client(conn.id, "queue overflow");
+        return;
+    }
+
+    while (!conn.out.empty()) {
+        struct iovec iov[MUXD_WRITE_IOV];
+        int count = 0;
+
+        for (auto it = conn.out.begin(); it != conn.out.end() && count < MUXD_WRITE_IOV; ++ it, count ++) {
+            size_t offset = count ? 0 : conn.out_offset;
+            iov[count].iov_base = const_cast<uint8_t *>(it->data->data() + offset);
+            iov[count].iov_len = it->data->size() - offset;
+        }
+
+        ssize_t ret = writev(conn.fd, iov, count);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 && errno == EAGAIN) {
+            conn.write_wait = true;
+            update_events(conn);
+            return;
+        }
+        if (ret < 0) {
+            close_client(conn.id, strerror(errno));
+            return;
+        }
+
+        size_t written = static_cast<size_t>(ret);
+        while (written) {
+            size_t left = conn.out.front().data->size() - conn.out_offset;
+            if (written < left) {
+                conn.out_offset += written;
+                break;
+            }
+            written -= left;
+            conn.notify_queued -= conn.out.front().droppable;
+            conn.out.pop_front();
+            conn.out_offset = 0;
+        }
+
+        /* The client caught up, tell it what it missed */
+        if (conn.out.empty() && conn.dropped_pending) {
+            Bytes payload;
+            Writer(payload).put<uint32_t>(conn.dropped_pending);
+            conn.dropped_pending = 0;
+            conn.out.push_back(Outgoing{encode(FrameType::Notify, frame_id::MUX_DROPPED, 0, 0, payload.data(), payload.size()), false});
+        }
+    }
+}
+
+int Mux::route_alloc()
+{
+    for (size_t i = 0; i < MUXD_ROUTES; i ++) {
+        uint8_t sn = static_cast<uint8_t>(next_sn_ + i);
+
+        if (routes_[sn].state == Route::Free) {
+            next_sn_ = static_cast<uint8_t>(sn + 1);
+            return sn;
+        }
+    }
+
+    return -1;
+}
+
+void Mux::dispatch(Clock::time_point now)
+{
+    bool progress = true;
+
+    /* Round robin over the clients, one request each per turn */
+    while (progress && in_flight_ < MUXD_ROUTES) {
+        progress = false;
+        auto it = clients_.lower_bound(rr_next_);
+        for (size_t n = 0; n < clients_.size() && in_flight_ < MUXD_ROUTES; n ++, ++ it) {
+            if (it == clients_.end()) {
+                it = clients_.begin();
+            }
+            Conn &conn = *it->second;
+            if (conn.waiting.empty()) {
+                continue;
+            }
+
+            int sn = route_alloc();
+            if (sn < 0) {
+                return;
+            }
+
+            Queued &queued = conn.waiting.front();
+            Route &route = routes_[sn];
+            Header header;
+
+            header.version = queued.version;
+            header.type = FrameType::Request;
+            header.id = queued.req.id;
+            header.sn = static_cast<uint8_t>(sn);
+            header.len = static_cast<uint16_t>(queued.req.payload.size());
+            size_t offset = ncp_tx_.size();
+            frame_encode(ncp_tx_, header, queued.req.payload.data(), queued.req.payload.size());
+            if (capture_) {
+                capture_->write(CaptureDirection::ToNcp, now, &ncp_tx_[offset], ncp_tx_.size() - offset);
+            }
+
+            route.state = Route::InFlight;
+            route.client = conn.id;
+            route.client_sn = queued.sn;
+            route.id = queued.req.id;
+            route.since = now;
+            in_flight_ ++;
+            conn.waiting.pop_front();
+            rr_next_ = it->first + 1;
+            progress = true;
+
+            if (!conn.reading && conn.waiting.size() <= options_.client_requests / 2) {
+                conn.reading = true;
+                update_events(conn);
+            }
+        }
+    }
+}
+
+void Mux::expire(Clock::time_point now)
+{
+    /* The client times the request out on its own, the daemon only takes the sn back */
+    for (Route &route : routes_) {
+        if (route.state == Route::InFlight && now - route.since >= options_.timeout) {
+            route.state = Route::Free;
+            in_flight_ --;
+            timeouts_ ++;
+        }
+    }
+}
+
+void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s --port PATH [--baud N] [--listen PATH] [--queue N] [--overflow drop-oldest|drop-newest|disconnect]\n"
+                    "          [--client-requests N] [--timeout MS] [--capture FILE] [-v]\n", prog);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    for (int i = 1; i < argc; i ++) {
+        const char *arg = argv[i];
+
+        if (!strcmp(arg, "-v")) {
+            options.verbose = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        const char *value = argv[++ i];
+        if (!strcmp(arg, "--port")) {
+            options.port = value;
+        } else if (!strcmp(arg, "--baud")) {
+            options.baud = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--listen")) {
+            options.listen = value;
+        } else if (!strcmp(arg, "--queue")) {
+            options.queue = std::max<size_t>(1, strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--client-requests")) {
+            options.client_requests = std::max<size_t>(1, strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--timeout")) {
+            options.timeout = std::chrono::milliseconds(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--capture")) {
+            options.capture = value;
+        } else if (!strcmp(arg, "--overflow")) {
+            if (!strcmp(value, "drop-oldest")) {
+                options.overflow = Overflow::DropOldest;
+            } else if (!strcmp(value, "drop-newest")) {
+                options.overflow = Overflow::DropNewest;
+            } else if (!strcmp(value, "disconnect")) {
+                options.overflow = Overflow::Disconnect;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.port.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    return Mux(options).run();
+}
@@ -0,0 +1,308 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replays the requests of a capture against an NCP, usually the Linux build, and compares the
+ * responses with the recorded ones:
+ *
+ *   esp_ncp_replay --capture trace.ncpcap --port /tmp/esp-ncp.sock --timing max --window 32
+ *   esp_ncp_replay --capture trace.ncpcap --port /tmp/esp-ncp.sock --timing recorded --speed 2
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "esp_ncp/capture.hpp"
+#include "esp_ncp/client.hpp"
+
+using namespace esp_ncp;
+
+namespace {
+
+struct Recorded {
+    uint64_t time_ns = 0;                       /*!< When the request was captured */
+    Request req;
+    bool answered = false;                      /*!< A response was captured */
+    Bytes response;
+    uint64_t latency_ns = 0;                    /*!< The captured latency */
+};
+
+struct Replayed {
+    Error error = Error::Disconnected;
+    Bytes response;
+    Clock::duration latency{};
+};
+
+struct Options {
+    std::string capture;
+    std::string port;
+    uint32_t baud = 0;
+    bool timed = false;
+    double speed = 1.0;
+    size_t window = 32;
+    uint64_t from_ms = 0;
+    uint64_t count = UINT64_MAX;
+    unsigned show = 5;                          /*!< The diverging responses printed */
+};
+
+void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s --capture FILE --port PATH [--baud N] [--timing recorded|max] [--speed X] [--window N]\n"
+                    "          [--from-ms MS] [--count N] [--show N]\n", prog);
+}
+
+/* Decode the raw SLIP frame of a record */
+bool record_decode(FrameDecoder &decoder, const CaptureRecord &record, Header *header, Bytes *payload)
+{
+    bool found = false;
+    size_t len;
+
+    decoder.reset();
+    uint8_t *buf = decoder.prepare(&len);
+    if (len < record.data.size()) {
+        return false;
+    }
+    std::memcpy(buf, record.data.data(), record.data.size());
+    decoder.commit(record.data.size(), [&](const FrameView &frame) {
+        *header = frame.header;
+        payload->assign(frame.payload, frame.payload + frame.header.len);
+        found = true;
+    });
+
+    return found;
+}
+
+std::string hex(const Bytes &data, size_t max = 24)
+{
+    std::string text;
+    char byte[4];
+
+    for (size_t i = 0; i < data.size() && i < max; i ++) {
+        snprintf(byte, sizeof(byte), "%02x", data[i]);
+        text += byte;
+    }
+    if (data.size() > max) {
+        text += "..";
+    }
+
+    return text.empty() ? "-" : text;
+}
+
+double percentile_us(std::vector<uint64_t> &ns, double p)
+{
+    if (ns.empty()) {
+        return 0;
+    }
+
+    std::sort(ns.begin(), ns.end());
+
+    return static_cast<double>(ns[static_cast<size_t>(p * static_cast<double>(ns.size() - 1) + 0.5)]) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *arg = argv[i];
+        const char *value = argv[i + 1];
+
+        if (!strcmp(arg, "--capture")) {
+            options.capture = value;
+        } else if (!strcmp(arg, "--port")) {
+            options.port = value;
+        } else if (!strcmp(arg, "--baud")) {
+            options.baud = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        } else if (!strcmp(arg, "--timing")) {
+            options.timed = !strcmp(value, "recorded");
+        } else if (!strcmp(arg, "--speed")) {
+            options.speed = std::max(0.001, atof(value));
+        } else if (!strcmp(arg, "--window")) {
+            options.window = strtoul(value, nullptr, 0);
+        } else if (!strcmp(arg, "--from-ms")) {
+            options.from_ms = strtoull(value, nullptr, 0);
+        } else if (!strcmp(arg, "--count")) {
+            options.count = strtoull(value, nullptr, 0);
+        } else if (!strcmp(arg, "--show")) {
+            options.show = static_cast<unsigned>(strtoul(value, nullptr, 0));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || options.capture.empty() || options.port.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* Pair every captured request with the captured response of the same sn and ID */
+    std::vector<Recorded> recorded;
+    std::map<uint16_t, uint64_t> recorded_notify;
+    try {
+        CaptureReader reader(options.capture);
+        CaptureRecord record;
+        FrameDecoder decoder;
+        std::map<uint32_t, size_t> waiting;
+
+        reader.seek_time(options.from_ms * 1000000);
+        while (reader.next(record)) {
+            Header header;
+            Bytes payload;
+
+            if (!record_decode(decoder, record, &header, &payload)) {
+                continue;
+            }
+            uint32_t key = (static_cast<uint32_t>(header.id) << 8) | header.sn;
+            if (record.direction == CaptureDirection::ToNcp && header.type == FrameType::Request) {
+                /* Past the count only the responses of the requests in flight are still read */
+                if (recorded.size() >= options.count) {
+                    if (waiting.empty()) {
+                        break;
+                    }
+                    continue;
+                }
+                waiting[key] = recorded.size();
+                recorded.push_back(Recorded{record.time_ns, Request{header.id, std::move(payload)}, false, {}, 0});
+            } else if (record.direction == CaptureDirection::FromNcp && header.type == FrameType::Response) {
+                auto it = waiting.find(key);
+                if (it != waiting.end()) {
+                    Recorded &req = recorded[it->second];
+                    req.answered = true;
+                    req.response = std::move(payload);
+                    req.latency_ns = record.time_ns - req.time_ns;
+                    waiting.erase(it);
+                }
+            } else if (record.direction == CaptureDirection::FromNcp) {
+                recorded_notify[header.id] ++;
+            }
+        }
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    if (recorded.empty()) {
+        fprintf(stderr, "no request in the capture\n");
+        return 1;
+    }
+
+    std::unique_ptr<Transport> transport;
+    try {
+        transport = Transport::open(options.port, options.baud);
+    } catch (const std::exception &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    ClientOptions client_options;
+    client_options.window = options.timed ? 256 : options.window;
+    Client client(std::move(transport), client_options);
+    std::vector<Replayed> replayed(recorded.size());
+    std::map<uint16_t, uint64_t> replayed_notify;
+    std::atomic<size_t> completed{0};
+    std::promise<void> done;
+
+    /* The callbacks run on the client thread */
+    client.subscribe(Client::ANY_ID, [&](const FrameView &frame) { replayed_notify[frame.header.id] ++; });
+
+    Clock::time_point start = Clock::now();
+    uint64_t base_ns = recorded.front().time_ns;
+    for (size_t i = 0; i < recorded.size(); i ++) {
+        if (options.timed) {
+            auto offset = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(recorded[i].time_ns - base_ns) / options.speed));
+            std::this_thread::sleep_until(start + offset);
+        }
+        client.request(recorded[i].req, [&, i](Error error, const FrameView *frame, Clock::duration latency) {
+            replayed[i].error = error;
+            replayed[i].latency = latency;
+            if (frame) {
+                replayed[i].response.assign(frame->payload, frame->payload + frame->header.len);
+            }
+            if (completed.fetch_add(1) + 1 == recorded.size()) {
+                done.set_value();
+            }
+        });
+    }
+    done.get_future().wait();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    client.close();
+
+    /* Compare */
+    std::vector<uint64_t> replay_ns;
+    std::vector<uint64_t> record_ns;
+    std::map<uint16_t, uint64_t> diverged_by_id;
+    uint64_t failed = 0;
+    uint64_t matched = 0;
+    uint64_t diverged = 0;
+    uint64_t unrecorded = 0;
+    unsigned shown = 0;
+
+    for (size_t i = 0; i < recorded.size(); i ++) {
+        const Recorded &rec = recorded[i];
+        const Replayed &rep = replayed[i];
+
+        if (rep.error != Error::None) {
+            failed ++;
+            continue;
+        }
+        replay_ns.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(rep.latency).count()));
+        if (!rec.answered) {
+            unrecorded ++;
+            continue;
+        }
+        record_ns.push_back(rec.latency_ns);
+        if (rec.response == rep.response) {
+            matched ++;
+            continue;
+        }
+        diverged ++;
+        diverged_by_id[rec.req.id] ++;
+        if (shown < options.show) {
+            shown ++;
+            printf("diverged #%zu %s(0x%04x): recorded %s, replayed %s\n", i, frame_id_name(rec.req.id), rec.req.id,
+                   hex(rec.response).c_str(), hex(rep.response).c_str());
+        }
+    }
+
+    printf("replayed %zu requests, %s timing, %.3f s, %.0f frames/s\n", recorded.size(), options.timed ? "recorded" : "max",
+           seconds, static_cast<double>(recorded.size() - failed) / seconds);
+    printf("latency us   replayed: p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n", percentile_us(replay_ns, 0.50),
+           percentile_us(replay_ns, 0.90), percentile_us(replay_ns, 0.99), percentile_us(replay_ns, 1.0));
+    printf("latency us   recorded: p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n", percentile_us(record_ns, 0.50),
+           percentile_us(record_ns, 0.90), percentile_us(record_ns, 0.99), percentile_us(record_ns, 1.0));
+    printf("responses: %" PRIu64 " matched, %" PRIu64 " diverged, %" PRIu64 " not recorded, %" PRIu64 " failed\n",
+           matched, diverged, unrecorded, failed);
+    for (auto &it : diverged_by_id) {
+        printf("  diverged %-32s %" PRIu64 "\n", frame_id_name(it.first), it.second);
+    }
+
+    std::map<uint16_t, bool> ids;
+    for (auto &it : recorded_notify) {
+        ids[it.first] = true;
+    }
+    for (auto &it : replayed_notify) {
+        ids[it.first] = true;
+    }
+    for (auto &it : ids) {
+        uint64_t before = recorded_notify[it.first];
+        uint64_t after = replayed_notify[it.first];
+        if (before != after) {
+            printf("  notifications %-27s recorded %" PRIu64 ", replayed %" PRIu64 "\n", frame_id_name(it.first), before, after);
+        }
+    }
+
+    return (failed || diverged) ? 2 : 0;
+}
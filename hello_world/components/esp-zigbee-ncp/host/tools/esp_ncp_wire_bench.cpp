@@ -0,0 +1,390 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The generated payload codecs against the packed struct casts they replace in esp_ncp_zb.c:
+ *
+ *   esp_ncp_wire_bench [--iterations N]
+ *
+ * The C codecs are the header the NCP includes, built natively here. The C++ views decode in place
+ * like them, the owning C++ types copy the lists and bytes out of the buffer. Every decoder extracts
+ * the same fields, which are summed so that none of the work is optimized away.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "esp_ncp/request.hpp"
+#include "esp_ncp/wire.hpp"
+#include "esp_ncp_wire.h"
+
+using namespace esp_ncp;
+
+namespace {
+
+/* The layouts of esp_ncp_zb.c before the schema, parsed by casting the input */
+union LegacyAddr {
+    uint16_t addr_short;
+    uint8_t addr_long[8];
+};
+
+struct __attribute__((packed)) LegacyBasicCmd {
+    LegacyAddr dst_addr_u;
+    uint8_t dst_endpoint;
+    uint8_t src_endpoint;
+};
+
+struct __attribute__((packed)) LegacyReadAttr {
+    LegacyBasicCmd zcl_basic_cmd;
+    uint8_t address_mode;
+    uint16_t cluster_id;
+    uint8_t attr_number;
+};
+
+using LegacyWriteAttr = LegacyReadAttr;
+
+struct __attribute__((packed)) LegacyAttrData {
+    uint16_t id;
+    uint8_t type;
+    uint8_t size;
+};
+
+struct __attribute__((packed)) LegacyApsData {
+    LegacyBasicCmd basic_cmd;
+    uint8_t dst_addr_mode;
+    uint16_t profile_id;
+    uint16_t cluster_id;
+    uint8_t tx_options;
+    bool use_alias;
+    LegacyAddr alias_src_addr;
+    uint8_t alias_seq_num;
+    uint8_t radius;
+    uint32_t asdu_length;
+};
+
+struct __attribute__((packed)) LegacyApsDataInd {
+    uint8_t states;
+    uint8_t dst_addr_mode;
+    LegacyAddr dst_addr;
+    uint8_t dst_endpoint;
+    uint8_t src_addr_mode;
+    LegacyAddr src_addr;
+    uint8_t src_endpoint;
+    uint16_t profile_id;
+    uint16_t cluster_id;
+    uint8_t indication_status;
+    uint8_t security_status;
+    uint8_t lqi;
+    int rx_time;
+    uint32_t asdu_length;
+};
+
+template <typename T>
+inline void keep(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/* Read attributes */
+
+uint64_t cast_read(const uint8_t *input, size_t)
+{
+    const LegacyReadAttr *msg = reinterpret_cast<const LegacyReadAttr *>(input);
+    uint16_t attr_field[256];
+    uint64_t sum = msg->zcl_basic_cmd.dst_addr_u.addr_short + msg->zcl_basic_cmd.dst_endpoint + msg->address_mode + msg->cluster_id;
+
+    memcpy(attr_field, input + sizeof(LegacyReadAttr), msg->attr_number * sizeof(uint16_t));
+    for (uint8_t i = 0; i < msg->attr_number; i ++) {
+        sum += attr_field[i];
+    }
+    return sum;
+}
+
+uint64_t c_read(const uint8_t *input, size_t len)
+{
+    esp_ncp_wire_zcl_attr_read_t msg;
+    uint16_t attr_field[256];
+
+    if (!esp_ncp_wire_zcl_attr_read_decode(input, len, &msg)) {
+        return 0;
+    }
+    uint64_t sum = esp_ncp_wire_addr_short(&msg.zcl_basic_cmd.dst_addr) + msg.zcl_basic_cmd.dst_endpoint + msg.address_mode + msg.cluster_id;
+    for (uint8_t i = 0; i < msg.attr_number; i ++) {
+        attr_field[i] = esp_ncp_wire_get_u16(msg.attr_field, i);
+        sum += attr_field[i];
+    }
+    return sum;
+}
+
+uint64_t cpp_read(const uint8_t *input, size_t len)
+{
+    wire::ZclAttrRead::View msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    uint64_t sum = msg.zcl_basic_cmd.dst_addr.short_addr() + msg.zcl_basic_cmd.dst_endpoint + msg.address_mode + msg.cluster_id;
+    for (uint16_t id : msg.attr_field) {
+        sum += id;
+    }
+    return sum;
+}
+
+uint64_t cpp_copy_read(const uint8_t *input, size_t len)
+{
+    wire::ZclAttrRead msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    uint64_t sum = msg.zcl_basic_cmd.dst_addr.short_addr() + msg.zcl_basic_cmd.dst_endpoint + msg.address_mode + msg.cluster_id;
+    for (uint16_t id : msg.attr_field) {
+        sum += id;
+    }
+    return sum;
+}
+
+/* Write attributes */
+
+uint64_t cast_write(const uint8_t *input, size_t)
+{
+    const LegacyWriteAttr *msg = reinterpret_cast<const LegacyWriteAttr *>(input);
+    uint64_t sum = msg->zcl_basic_cmd.dst_addr_u.addr_short + msg->cluster_id;
+    size_t length = sizeof(LegacyWriteAttr);
+
+    for (uint8_t i = 0; i < msg->attr_number; i ++) {
+        const LegacyAttrData *attr = reinterpret_cast<const LegacyAttrData *>(input + length);
+        uint8_t value[256];
+
+        memcpy(value, input + length + sizeof(LegacyAttrData), attr->size);
+        sum += attr->id + attr->type + value[0];
+        length += sizeof(LegacyAttrData) + attr->size;
+    }
+    return sum;
+}
+
+uint64_t c_write(const uint8_t *input, size_t len)
+{
+    esp_ncp_wire_zcl_attr_write_t msg;
+    esp_ncp_wire_zcl_attr_data_t attr;
+    size_t offset = 0;
+
+    if (!esp_ncp_wire_zcl_attr_write_decode(input, len, &msg)) {
+        return 0;
+    }
+    uint64_t sum = esp_ncp_wire_addr_short(&msg.zcl_basic_cmd.dst_addr) + msg.cluster_id;
+    for (uint8_t i = 0; i < msg.attr_number && esp_ncp_wire_zcl_attr_data_next(msg.attr_field, msg.attr_field_len, &offset, &attr); i ++) {
+        uint8_t value[256];
+
+        memcpy(value, attr.value, attr.size);
+        sum += attr.id + attr.type + value[0];
+    }
+    return sum;
+}
+
+uint64_t cpp_write(const uint8_t *input, size_t len)
+{
+    wire::ZclAttrWrite::View msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    uint64_t sum = msg.zcl_basic_cmd.dst_addr.short_addr() + msg.cluster_id;
+    for (const wire::ZclAttrData::View &attr : msg.attr_field) {
+        sum += attr.id + attr.type + attr.value[0];
+    }
+    return sum;
+}
+
+uint64_t cpp_copy_write(const uint8_t *input, size_t len)
+{
+    wire::ZclAttrWrite msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    uint64_t sum = msg.zcl_basic_cmd.dst_addr.short_addr() + msg.cluster_id;
+    for (const wire::ZclAttrData &attr : msg.attr_field) {
+        sum += attr.id + attr.type + attr.value[0];
+    }
+    return sum;
+}
+
+/* APS data request */
+
+uint64_t cast_aps(const uint8_t *input, size_t)
+{
+    const LegacyApsData *msg = reinterpret_cast<const LegacyApsData *>(input);
+    const uint8_t *asdu = msg->asdu_length ? input + sizeof(LegacyApsData) : nullptr;
+
+    return msg->basic_cmd.dst_addr_u.addr_short + msg->profile_id + msg->cluster_id + msg->tx_options + msg->use_alias +
+           msg->alias_src_addr.addr_short + msg->radius + msg->asdu_length + (asdu ? asdu[0] : 0);
+}
+
+uint64_t c_aps(const uint8_t *input, size_t len)
+{
+    esp_ncp_wire_aps_data_request_t msg;
+
+    if (!esp_ncp_wire_aps_data_request_decode(input, len, &msg)) {
+        return 0;
+    }
+    const uint8_t *asdu = msg.asdu_length ? msg.asdu : nullptr;
+    return esp_ncp_wire_addr_short(&msg.basic_cmd.dst_addr) + msg.profile_id + msg.cluster_id + msg.tx_options + msg.use_alias +
+           esp_ncp_wire_addr_short(&msg.alias_src_addr) + msg.radius + msg.asdu_length + (asdu ? asdu[0] : 0);
+}
+
+uint64_t cpp_aps(const uint8_t *input, size_t len)
+{
+    wire::ApsDataRequest::View msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    return msg.basic_cmd.dst_addr.short_addr() + msg.profile_id + msg.cluster_id + msg.tx_options + msg.use_alias +
+           msg.alias_src_addr.short_addr() + msg.radius + msg.asdu.size() + (msg.asdu.empty() ? 0 : msg.asdu[0]);
+}
+
+uint64_t cpp_copy_aps(const uint8_t *input, size_t len)
+{
+    wire::ApsDataRequest msg;
+
+    if (!wire::decode(input, len, msg)) {
+        return 0;
+    }
+    return msg.basic_cmd.dst_addr.short_addr() + msg.profile_id + msg.cluster_id + msg.tx_options + msg.use_alias +
+           msg.alias_src_addr.short_addr() + msg.radius + msg.asdu.size() + (msg.asdu.empty() ? 0 : msg.asdu[0]);
+}
+
+/* APS data indication, encoded by the NCP */
+
+uint8_t s_asdu[32] = {0x18, 0x01, 0x0a};
+uint8_t s_out[256];
+
+uint64_t cast_ind(const uint8_t *, size_t)
+{
+    LegacyApsDataInd *msg = reinterpret_cast<LegacyApsDataInd *>(s_out);
+
+    memset(s_out, 0, sizeof(LegacyApsDataInd));
+    msg->states = 1;
+    msg->dst_addr_mode = 2;
+    msg->dst_addr.addr_short = 0x0000;
+    msg->dst_endpoint = 1;
+    msg->src_addr_mode = 2;
+    msg->src_addr.addr_short = 0x1234;
+    msg->src_endpoint = 1;
+    msg->profile_id = 0x0104;
+    msg->cluster_id = 0x0006;
+    msg->lqi = 200;
+    msg->rx_time = 1000;
+    msg->asdu_length = sizeof(s_asdu);
+    memcpy(s_out + sizeof(LegacyApsDataInd), s_asdu, sizeof(s_asdu));
+    return sizeof(LegacyApsDataInd) + sizeof(s_asdu);
+}
+
+uint64_t c_ind(const uint8_t *, size_t)
+{
+    esp_ncp_wire_aps_data_indication_t msg = {};
+
+    msg.states = 1;
+    msg.dst_addr_mode = 2;
+    esp_ncp_wire_addr_set_short(&msg.dst_addr, 0x0000);
+    msg.dst_endpoint = 1;
+    msg.src_addr_mode = 2;
+    esp_ncp_wire_addr_set_short(&msg.src_addr, 0x1234);
+    msg.src_endpoint = 1;
+    msg.profile_id = 0x0104;
+    msg.cluster_id = 0x0006;
+    msg.lqi = 200;
+    msg.rx_time = 1000;
+    msg.asdu_length = sizeof(s_asdu);
+    msg.asdu = s_asdu;
+    return esp_ncp_wire_aps_data_indication_encode(&msg, s_out, sizeof(s_out));
+}
+
+struct Case {
+    const char *frame;
+    const char *codec;
+    uint64_t (*run)(const uint8_t *input, size_t len);
+    int payload;                                    /*!< The index of the payload, -1 for the encoders */
+};
+
+/* The first case of a payload is the reference the others must agree with */
+const Case s_cases[] = {
+    {"zcl_attr_read", "cast", cast_read, 0},
+    {"zcl_attr_read", "C generated", c_read, 0},
+    {"zcl_attr_read", "C++ view", cpp_read, 0},
+    {"zcl_attr_read", "C++ copy", cpp_copy_read, 0},
+    {"zcl_attr_write", "cast", cast_write, 1},
+    {"zcl_attr_write", "C generated", c_write, 1},
+    {"zcl_attr_write", "C++ view", cpp_write, 1},
+    {"zcl_attr_write", "C++ copy", cpp_copy_write, 1},
+    {"aps_data_request", "cast", cast_aps, 2},
+    {"aps_data_request", "C generated", c_aps, 2},
+    {"aps_data_request", "C++ view", cpp_aps, 2},
+    {"aps_data_request", "C++ copy", cpp_copy_aps, 2},
+    {"aps_data_indication", "cast encode", cast_ind, -1},
+    {"aps_data_indication", "C generated encode", c_ind, -1},
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    uint64_t iterations = 5000000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--iterations")) {
+            iterations = strtoull(argv[i + 1], nullptr, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--iterations N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Destination dst = Destination::device(0x1234, 1);
+    Bytes asdu(32, 0x5a);
+    std::vector<Bytes> payloads = {
+        request::zcl_attr_read(dst, 0x0006, {0x0000, 0x4000, 0x4001, 0x4002}).payload,
+        request::zcl_attr_write(dst, 0x0008, {{0x0000, 0x20, {0x80}}, {0x0010, 0x21, {0x0a, 0x00}}}).payload,
+        request::aps_data_request(dst, 0x0104, 0x0006, asdu).payload,
+    };
+
+    /* The codecs must agree before they are timed */
+    const Case *reference = nullptr;
+    for (const Case &c : s_cases) {
+        if (!reference || reference->payload != c.payload) {
+            reference = &c;
+        }
+        if (c.payload >= 0 && c.run(payloads[c.payload].data(), payloads[c.payload].size()) != reference->run(
+                payloads[c.payload].data(), payloads[c.payload].size())) {
+            fprintf(stderr, "%s %s decodes differently\n", c.frame, c.codec);
+            return 2;
+        }
+    }
+
+    printf("%-20s %-20s %10s %10s\n", "frame", "codec", "ns/op", "Mops/s");
+    for (const Case &c : s_cases) {
+        const uint8_t *input = c.payload >= 0 ? payloads[c.payload].data() : nullptr;
+        size_t len = c.payload >= 0 ? payloads[c.payload].size() : 0;
+        uint64_t sum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i ++) {
+            keep(input);
+            sum += c.run(input, len);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    static_cast<double>(iterations);
+        keep(sum);
+        printf("%-20s %-20s %10.2f %10.1f\n", c.frame, c.codec, ns, 1000.0 / ns);
+    }
+
+    return 0;
+}
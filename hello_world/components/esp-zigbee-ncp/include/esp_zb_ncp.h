@@ -19,6 +19,8 @@ extern "C" {
 typedef enum {
     NCP_HOST_CONNECTION_MODE_UART = 0x01,       /*!< NCP UART connection with the host */
     NCP_HOST_CONNECTION_MODE_SPI = 0x02,        /*!< NCP SPI connection with the host */
+    NCP_HOST_CONNECTION_MODE_PTY = 0x03,        /*!< NCP pseudo terminal connection with the host, Linux target only */
+    NCP_HOST_CONNECTION_MODE_SOCKET = 0x04,     /*!< NCP Unix domain socket connection with the host, Linux target only */
 } esp_ncp_host_connection_mode_t;
 
 /**
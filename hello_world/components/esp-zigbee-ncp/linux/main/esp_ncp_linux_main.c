@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The NCP built for the Linux target against the stack stub and its simulated network. The host connects to the
+ * Unix domain socket or opens the pseudo terminal, as it would open the UART of a chip:
+ *
+ *   idf.py --preview set-target linux build
+ *   ./build/esp_ncp_linux.elf
+ */
+
+#include "sdkconfig.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+#include "esp_zb_ncp.h"
+
+#if !CONFIG_IDF_TARGET_LINUX
+#error "The Linux NCP runs on the linux target, the chips use the UART of the NCP example"
+#endif
+
+#if CONFIG_NCP_LINUX_HOST_CONNECTION_PTY
+#define ESP_NCP_LINUX_HOST_CONNECTION   NCP_HOST_CONNECTION_MODE_PTY
+#else
+#define ESP_NCP_LINUX_HOST_CONNECTION   NCP_HOST_CONNECTION_MODE_SOCKET
+#endif
+
+static const char *TAG = "ESP_NCP_LINUX";
+
+void app_main(void)
+{
+    /* The host initializes, forms and starts the network through its frames, as on a chip */
+    ESP_ERROR_CHECK(esp_ncp_init(ESP_NCP_LINUX_HOST_CONNECTION));
+    ESP_ERROR_CHECK(esp_ncp_start());
+    ESP_LOGI(TAG, "Waiting for the host on %s",
+             (ESP_NCP_LINUX_HOST_CONNECTION == NCP_HOST_CONNECTION_MODE_PTY) ? CONFIG_NCP_BUS_PTY_LINK : CONFIG_NCP_BUS_SOCKET_PATH);
+}
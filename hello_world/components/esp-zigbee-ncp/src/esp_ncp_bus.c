@@ -5,10 +5,6 @@
  */
 
 #include <string.h>
-#include <sys/fcntl.h>
-#include <sys/errno.h>
-#include <sys/unistd.h>
-#include <sys/select.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -16,53 +12,19 @@
 #include "freertos/stream_buffer.h"
 
 #include "esp_log.h"
-#include "driver/uart.h"
 
 #include "esp_ncp_bus.h"
+#include "esp_ncp_capture.h"
 #include "esp_ncp_frame.h"
 #include "esp_ncp_main.h"
+#include "slip.h"
 
 static const char* TAG = "ESP_NCP_BUS";
 
-static QueueHandle_t uart0_queue;
 static esp_ncp_bus_t *s_ncp_bus;
 
-static esp_err_t ncp_bus_read_hdl(void *buffer, uint16_t size)
-{
-    return ESP_FAIL;
-}
-
-static esp_err_t ncp_bus_write_hdl(void *buffer, uint16_t size)
-{
-    return (uart_write_bytes(CONFIG_NCP_BUS_UART_NUM, (const char*) buffer, size) == size) ? ESP_OK : ESP_ERR_INVALID_SIZE;
-}
-
-static esp_err_t ncp_bus_deinit_hdl(void)
-{
-    return uart_driver_delete(CONFIG_NCP_BUS_UART_NUM);
-}
-
-static esp_err_t ncp_bus_init_hdl(uint8_t transport)
-{
-    uart_config_t uart_config = {
-        .baud_rate = CONFIG_NCP_BUS_UART_BAUD_RATE,
-        .data_bits = CONFIG_NCP_BUS_UART_BYTE_SIZE,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = CONFIG_NCP_BUS_UART_STOP_BITS,
-        .flow_ctrl = CONFIG_NCP_BUS_UART_FLOW_CONTROL,
-        .source_clk = UART_SCLK_DEFAULT,
-    };
-
-    uart_driver_install(CONFIG_NCP_BUS_UART_NUM, NCP_BUS_BUF_SIZE * 2, NCP_BUS_BUF_SIZE * 2, 20, &uart0_queue, 0);
-    uart_param_config(CONFIG_NCP_BUS_UART_NUM, &uart_config);
-    uart_set_pin(CONFIG_NCP_BUS_UART_NUM, CONFIG_NCP_BUS_UART_TX_PIN, CONFIG_NCP_BUS_UART_RX_PIN, CONFIG_NCP_BUS_UART_RTS_PIN, CONFIG_NCP_BUS_UART_CTS_PIN);
-
-    return ESP_OK;
-}
-
 static void esp_ncp_bus_task(void *pvParameter)
 {
-    uart_event_t event;
     uint8_t *dtmp = (uint8_t*)malloc(NCP_BUS_BUF_SIZE);
 
     esp_ncp_bus_t *bus = (esp_ncp_bus_t *)pvParameter;
@@ -72,28 +34,17 @@ static void esp_ncp_bus_task(void *pvParameter)
     };
 
     while (bus->state == BUS_INIT_START) {
-        if (xQueueReceive(uart0_queue, (void *)&event, (TickType_t)portMAX_DELAY)) {
-            bzero(dtmp, NCP_BUS_BUF_SIZE);
-            switch(event.type) {
-                case UART_DATA:
-                    ncp_event.size = uart_read_bytes(CONFIG_NCP_BUS_UART_NUM, dtmp, event.size, portMAX_DELAY);
-                    xStreamBufferSend(bus->output_buf, dtmp, ncp_event.size, 0);
-                    esp_ncp_send_event(&ncp_event);
-                    break;
-                case UART_FIFO_OVF:
-                    ESP_LOGI(TAG, "hw fifo overflow");
-                    uart_flush_input(CONFIG_NCP_BUS_UART_NUM);
-                    xQueueReset(uart0_queue);
-                    break;
-                case UART_BUFFER_FULL:
-                    ESP_LOGI(TAG, "ring buffer full");
-                    uart_flush_input(CONFIG_NCP_BUS_UART_NUM);
-                    xQueueReset(uart0_queue);
-                    break;
-                default:
-                    ESP_LOGI(TAG, "uart event type: %d", event.type);
-                    break;
+        uint16_t size = NCP_BUS_BUF_SIZE;
+        esp_err_t ret = bus->read(dtmp, &size);
+
+        if (ret == ESP_OK && size) {
+            ncp_event.size = xStreamBufferSend(bus->output_buf, dtmp, size, 0);
+            if (ncp_event.size != size) {
+                ESP_LOGE(TAG, "output_buf not enough, %d bytes lost", size - ncp_event.size);
             }
+            esp_ncp_send_event(&ncp_event);
+        } else if (ret != ESP_OK && ret != ESP_ERR_TIMEOUT) {
+            ESP_LOGD(TAG, "Bus read error %s", esp_err_to_name(ret));
         }
     }
 
@@ -130,6 +81,10 @@ esp_err_t esp_ncp_bus_input(const void *buffer, uint16_t len)
         return ESP_FAIL;
     }
 
+#if CONFIG_NCP_BUS_CAPTURE
+    esp_ncp_capture_record(ESP_NCP_CAPTURE_FROM_NCP, buffer, len);
+#endif
+
     xSemaphoreTake(bus->input_sem, portMAX_DELAY);
     ret_size = xStreamBufferSend(bus->input_buf, buffer, len, 0);
     xSemaphoreGive(bus->input_sem);
@@ -144,7 +99,67 @@ esp_err_t esp_ncp_bus_input(const void *buffer, uint16_t len)
 
 esp_err_t esp_ncp_bus_output(const void *buffer, uint16_t len)
 {
-    return esp_ncp_frame_output(buffer, len);
+    esp_ncp_bus_t *bus = s_ncp_bus;
+    const uint8_t *data = (const uint8_t *)buffer;
+    esp_err_t ret = ESP_OK;
+
+    if (!bus || !bus->frame) {
+        return ESP_FAIL;
+    }
+
+    for (uint16_t i = 0; i < len; i ++) {
+        if (data[i] != SLIP_END) {
+            if (bus->frame_len < NCP_BUS_FRAME_SIZE - 1) {
+                bus->frame[bus->frame_len ++] = data[i];
+            } else if (!bus->frame_drop) {
+                ESP_LOGE(TAG, "Frame exceeds %d bytes, dropped", NCP_BUS_FRAME_SIZE);
+                bus->frame_drop = true;
+            }
+            continue;
+        }
+
+        /* Back to back frames are separated by two SLIP_END, an empty frame is only a delimiter */
+        if (bus->frame_len > 1 && !bus->frame_drop) {
+            bus->frame[bus->frame_len ++] = SLIP_END;
+#if CONFIG_NCP_BUS_CAPTURE
+            esp_ncp_capture_record(ESP_NCP_CAPTURE_TO_NCP, bus->frame, bus->frame_len);
+#endif
+            /* A bad frame is answered by an error frame and must not drop the frames behind it */
+            esp_err_t err = esp_ncp_frame_output(bus->frame, bus->frame_len);
+            ret = (err != ESP_OK) ? err : ret;
+        }
+        bus->frame_len = 1;
+        bus->frame_drop = false;
+    }
+
+    return ret;
+}
+
+esp_err_t esp_ncp_bus_disconnect(void)
+{
+    esp_ncp_ctx_t ncp_event = {
+        .event = NCP_EVENT_DISCONNECT,
+    };
+
+    /* Queued behind the output events of the old host, the reset happens once its bytes are processed */
+    return esp_ncp_send_event(&ncp_event);
+}
+
+esp_err_t esp_ncp_bus_frame_reset(void)
+{
+    esp_ncp_bus_t *bus = s_ncp_bus;
+
+    if (!bus || !bus->frame) {
+        return ESP_FAIL;
+    }
+
+    if (bus->frame_len > 1) {
+        ESP_LOGW(TAG, "Host disconnected, %d bytes of a frame dropped", bus->frame_len - 1);
+    }
+    bus->frame_len = 1;
+    bus->frame_drop = false;
+
+    return ESP_OK;
 }
 
 esp_err_t esp_ncp_bus_init(esp_ncp_bus_t **bus)
@@ -176,10 +191,24 @@ esp_err_t esp_ncp_bus_init(esp_ncp_bus_t **bus)
         return ESP_ERR_NO_MEM;
     }
 
-    bus_handle->init = ncp_bus_init_hdl;
-    bus_handle->deinit = ncp_bus_deinit_hdl;
-    bus_handle->read = ncp_bus_read_hdl;
-    bus_handle->write = ncp_bus_write_hdl;
+    bus_handle->frame = malloc(NCP_BUS_FRAME_SIZE);
+    if (bus_handle->frame == NULL) {
+        ESP_LOGE(TAG, "Frame buffer create error");
+        esp_ncp_bus_deinit(bus_handle);
+        return ESP_ERR_NO_MEM;
+    }
+    bus_handle->frame[0] = SLIP_END;
+    bus_handle->frame_len = 1;
+
+#if CONFIG_NCP_BUS_CAPTURE
+    esp_ncp_capture_open(CONFIG_NCP_BUS_CAPTURE_PATH);
+#endif
+
+    if (esp_ncp_bus_transport_register(bus_handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Transport register error");
+        esp_ncp_bus_deinit(bus_handle);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
 
     *bus = bus_handle;
     s_ncp_bus = bus_handle;
@@ -242,6 +271,15 @@ esp_err_t esp_ncp_bus_deinit(esp_ncp_bus_t *bus)
         bus->input_sem = NULL;
     }
 
+    if (bus->frame) {
+        free(bus->frame);
+        bus->frame = NULL;
+    }
+
+#if CONFIG_NCP_BUS_CAPTURE
+    esp_ncp_capture_close();
+#endif
+
     free(bus);
     s_ncp_bus = NULL;
 
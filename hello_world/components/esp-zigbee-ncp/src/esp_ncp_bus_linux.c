@@ -0,0 +1,255 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* posix_openpt() and friends are not declared under the strict C standards */
+#define _GNU_SOURCE
+
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+
+#include "esp_zb_ncp.h"
+#include "esp_ncp_bus.h"
+
+static const char* TAG = "ESP_NCP_BUS_LINUX";
+
+typedef struct {
+    int listen_fd;                      /*!< The socket listening for the host, -1 for the PTY */
+    int fd;                             /*!< The descriptor connected to the host, -1 if the host is not connected */
+} esp_ncp_bus_linux_t;
+
+static esp_ncp_bus_linux_t s_bus_linux = {
+    .listen_fd = -1,
+    .fd = -1,
+};
+
+static void ncp_bus_linux_close(void)
+{
+    if (s_bus_linux.fd >= 0) {
+        close(s_bus_linux.fd);
+        s_bus_linux.fd = -1;
+    }
+}
+
+/* Waits for the event on the descriptor, the FreeRTOS POSIX port interrupts system calls with its tick signal */
+static int ncp_bus_linux_poll(int fd, short events, int timeout_ms)
+{
+    struct pollfd pfd = {
+        .fd = fd,
+        .events = events,
+    };
+    int ret = 0;
+
+#if CONFIG_ZB_SIM_VIRTUAL_TIME
+    /* A task blocked in poll() holds the virtual clock back, check without blocking and wait in ticks instead */
+    do {
+        ret = poll(&pfd, 1, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (!ret && timeout_ms) {
+        vTaskDelay(pdMS_TO_TICKS(timeout_ms));
+        do {
+            ret = poll(&pfd, 1, 0);
+        } while (ret < 0 && errno == EINTR);
+    }
+#else
+    do {
+        ret = poll(&pfd, 1, timeout_ms);
+    } while (ret < 0 && errno == EINTR);
+#endif
+
+    return (ret > 0) ? pfd.revents : ret;
+}
+
+static esp_err_t ncp_bus_linux_accept(void)
+{
+    int revents = ncp_bus_linux_poll(s_bus_linux.listen_fd, POLLIN, NCP_BUS_READ_TIMEOUT_MS);
+
+    if (revents <= 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    s_bus_linux.fd = accept(s_bus_linux.listen_fd, NULL, NULL);
+    if (s_bus_linux.fd < 0) {
+        ESP_LOGE(TAG, "Accept the host error: %s", strerror(errno));
+        return ESP_FAIL;
+    }
+    fcntl(s_bus_linux.fd, F_SETFL, fcntl(s_bus_linux.fd, F_GETFL) | O_NONBLOCK);
+    ESP_LOGI(TAG, "Host connected");
+
+    return ESP_ERR_TIMEOUT;
+}
+
+static esp_err_t ncp_bus_read_hdl(void *buffer, uint16_t *size)
+{
+    ssize_t len = 0;
+    int revents = 0;
+
+    if (s_bus_linux.fd < 0) {
+        *size = 0;
+        return (s_bus_linux.listen_fd >= 0) ? ncp_bus_linux_accept() : ESP_ERR_INVALID_STATE;
+    }
+
+    revents = ncp_bus_linux_poll(s_bus_linux.fd, POLLIN, NCP_BUS_READ_TIMEOUT_MS);
+    if (revents <= 0) {
+        *size = 0;
+        return ESP_ERR_TIMEOUT;
+    }
+
+    len = read(s_bus_linux.fd, buffer, *size);
+    if (len > 0) {
+        *size = len;
+        return ESP_OK;
+    }
+
+    *size = 0;
+    if (len < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    if (s_bus_linux.listen_fd >= 0) {
+        ESP_LOGI(TAG, "Host disconnected");
+        ncp_bus_linux_close();
+        esp_ncp_bus_disconnect();
+        return ESP_ERR_TIMEOUT;
+    }
+
+    /* The master side of a PTY reads EIO while no host holds the slave side open */
+    vTaskDelay(pdMS_TO_TICKS(NCP_BUS_READ_TIMEOUT_MS));
+
+    return ESP_ERR_TIMEOUT;
+}
+
+static esp_err_t ncp_bus_write_hdl(void *buffer, uint16_t size)
+{
+    const uint8_t *data = (const uint8_t *)buffer;
+    uint16_t offset = 0;
+
+    if (s_bus_linux.fd < 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    while (offset < size) {
+        ssize_t len = write(s_bus_linux.fd, data + offset, size - offset);
+        if (len > 0) {
+            offset += len;
+        } else if (len < 0 && errno == EINTR) {
+            continue;
+        } else if (len < 0 && errno == EAGAIN) {
+            /* A host that does not drain the link for a whole read timeout loses the frame, as a UART would */
+            if (ncp_bus_linux_poll(s_bus_linux.fd, POLLOUT, NCP_BUS_READ_TIMEOUT_MS) <= 0) {
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    return (offset == size) ? ESP_OK : ESP_ERR_INVALID_SIZE;
+}
+
+static esp_err_t ncp_bus_deinit_hdl(void)
+{
+    ncp_bus_linux_close();
+
+    if (s_bus_linux.listen_fd >= 0) {
+        close(s_bus_linux.listen_fd);
+        s_bus_linux.listen_fd = -1;
+        unlink(CONFIG_NCP_BUS_SOCKET_PATH);
+    } else if (strlen(CONFIG_NCP_BUS_PTY_LINK)) {
+        unlink(CONFIG_NCP_BUS_PTY_LINK);
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t ncp_bus_linux_pty_init(void)
+{
+    struct termios tio;
+    const char *name = NULL;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (fd < 0 || grantpt(fd) || unlockpt(fd) || !(name = ptsname(fd))) {
+        ESP_LOGE(TAG, "Open the pseudo terminal error: %s", strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return ESP_FAIL;
+    }
+
+    /* The frames are binary, no line discipline may touch them */
+    if (!tcgetattr(fd, &tio)) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    if (strlen(CONFIG_NCP_BUS_PTY_LINK)) {
+        unlink(CONFIG_NCP_BUS_PTY_LINK);
+        if (symlink(name, CONFIG_NCP_BUS_PTY_LINK)) {
+            ESP_LOGW(TAG, "Link %s to %s error: %s", CONFIG_NCP_BUS_PTY_LINK, name, strerror(errno));
+        }
+    }
+    ESP_LOGI(TAG, "Host connection on %s", name);
+    s_bus_linux.fd = fd;
+
+    return ESP_OK;
+}
+
+static esp_err_t ncp_bus_linux_socket_init(void)
+{
+    struct sockaddr_un addr = {
+        .sun_family = AF_UNIX,
+    };
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0) {
+        ESP_LOGE(TAG, "Create the socket error: %s", strerror(errno));
+        return ESP_FAIL;
+    }
+
+    strncpy(addr.sun_path, CONFIG_NCP_BUS_SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    unlink(addr.sun_path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, 1)) {
+        ESP_LOGE(TAG, "Listen on %s error: %s", addr.sun_path, strerror(errno));
+        close(fd);
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Host connection on %s", addr.sun_path);
+    s_bus_linux.listen_fd = fd;
+
+    return ESP_OK;
+}
+
+static esp_err_t ncp_bus_init_hdl(uint8_t transport)
+{
+    return (transport == NCP_HOST_CONNECTION_MODE_SOCKET) ? ncp_bus_linux_socket_init() : ncp_bus_linux_pty_init();
+}
+
+esp_err_t esp_ncp_bus_transport_register(esp_ncp_bus_t *bus)
+{
+    bus->init = ncp_bus_init_hdl;
+    bus->deinit = ncp_bus_deinit_hdl;
+    bus->read = ncp_bus_read_hdl;
+    bus->write = ncp_bus_write_hdl;
+
+    return ESP_OK;
+}
+
+#endif
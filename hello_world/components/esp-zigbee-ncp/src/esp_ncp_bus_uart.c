@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+/* The SPI and USB modes are not implemented yet, the chip talks to the host over UART in every mode */
+#if !CONFIG_IDF_TARGET_LINUX
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include "esp_log.h"
+#include "driver/uart.h"
+
+#include "esp_ncp_bus.h"
+
+static const char* TAG = "ESP_NCP_BUS_UART";
+
+static QueueHandle_t uart0_queue;
+
+static esp_err_t ncp_bus_read_hdl(void *buffer, uint16_t *size)
+{
+    uart_event_t event;
+    size_t len = 0;
+    int ret = 0;
+
+    /* Data left by a previous read is not announced by another event */
+    uart_get_buffered_data_len(CONFIG_NCP_BUS_UART_NUM, &len);
+    if (!len) {
+        if (xQueueReceive(uart0_queue, (void *)&event, pdMS_TO_TICKS(NCP_BUS_READ_TIMEOUT_MS)) != pdTRUE) {
+            *size = 0;
+            return ESP_ERR_TIMEOUT;
+        }
+
+        switch(event.type) {
+            case UART_DATA:
+                uart_get_buffered_data_len(CONFIG_NCP_BUS_UART_NUM, &len);
+                break;
+            case UART_FIFO_OVF:
+                ESP_LOGI(TAG, "hw fifo overflow");
+                uart_flush_input(CONFIG_NCP_BUS_UART_NUM);
+                xQueueReset(uart0_queue);
+                break;
+            case UART_BUFFER_FULL:
+                ESP_LOGI(TAG, "ring buffer full");
+                uart_flush_input(CONFIG_NCP_BUS_UART_NUM);
+                xQueueReset(uart0_queue);
+                break;
+            default:
+                ESP_LOGI(TAG, "uart event type: %d", event.type);
+                break;
+        }
+    }
+
+    if (!len) {
+        *size = 0;
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ret = uart_read_bytes(CONFIG_NCP_BUS_UART_NUM, buffer, (len < *size) ? len : *size, 0);
+    *size = (ret > 0) ? ret : 0;
+
+    return (ret >= 0) ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t ncp_bus_write_hdl(void *buffer, uint16_t size)
+{
+    return (uart_write_bytes(CONFIG_NCP_BUS_UART_NUM, (const char*) buffer, size) == size) ? ESP_OK : ESP_ERR_INVALID_SIZE;
+}
+
+static esp_err_t ncp_bus_deinit_hdl(void)
+{
+    return uart_driver_delete(CONFIG_NCP_BUS_UART_NUM);
+}
+
+static esp_err_t ncp_bus_init_hdl(uint8_t transport)
+{
+    uart_config_t uart_config = {
+        .baud_rate = CONFIG_NCP_BUS_UART_BAUD_RATE,
+        .data_bits = CONFIG_NCP_BUS_UART_BYTE_SIZE,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = CONFIG_NCP_BUS_UART_STOP_BITS,
+        .flow_ctrl = CONFIG_NCP_BUS_UART_FLOW_CONTROL,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    uart_driver_install(CONFIG_NCP_BUS_UART_NUM, NCP_BUS_BUF_SIZE * 2, NCP_BUS_BUF_SIZE * 2, 20, &uart0_queue, 0);
+    uart_param_config(CONFIG_NCP_BUS_UART_NUM, &uart_config);
+    uart_set_pin(CONFIG_NCP_BUS_UART_NUM, CONFIG_NCP_BUS_UART_TX_PIN, CONFIG_NCP_BUS_UART_RX_PIN, CONFIG_NCP_BUS_UART_RTS_PIN, CONFIG_NCP_BUS_UART_CTS_PIN);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ncp_bus_transport_register(esp_ncp_bus_t *bus)
+{
+    bus->init = ncp_bus_init_hdl;
+    bus->deinit = ncp_bus_deinit_hdl;
+    bus->read = ncp_bus_read_hdl;
+    bus->write = ncp_bus_write_hdl;
+
+    return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if CONFIG_NCP_BUS_CAPTURE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+
+#include "esp_ncp_capture.h"
+#include "esp_ncp_time.h"
+
+static const char* TAG = "ESP_NCP_CAPTURE";
+
+typedef struct {
+    uint64_t    number;                     /*!< The record number */
+    uint64_t    offset;                     /*!< The file offset of the record */
+    uint64_t    time_ns;                    /*!< The time of the record */
+} esp_ncp_capture_index_t;
+
+typedef struct {
+    FILE                    *file;          /*!< The capture file, NULL if closed */
+    SemaphoreHandle_t       lock;           /*!< Serializes the records of the tasks */
+    int64_t                 start_us;       /*!< The time of the file header */
+    uint64_t                records;        /*!< The records written */
+    uint64_t                offset;         /*!< The file offset of the next record */
+    esp_ncp_capture_index_t *index;         /*!< The index entries */
+    uint32_t                index_count;    /*!< The number of index entries */
+    uint32_t                index_size;     /*!< The capacity of the index */
+} esp_ncp_capture_t;
+
+static esp_ncp_capture_t s_capture;
+
+static void esp_ncp_capture_put(uint8_t *buf, uint64_t value, size_t len)
+{
+    for (size_t i = 0; i < len; i ++) {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+esp_err_t esp_ncp_capture_open(const char *path)
+{
+    uint8_t head[24];
+    struct timespec now;
+
+    if (s_capture.file) {
+        return ESP_OK;
+    }
+
+    s_capture.lock = xSemaphoreCreateMutex();
+    s_capture.file = fopen(path, "wb");
+    if (!s_capture.lock || !s_capture.file) {
+        ESP_LOGE(TAG, "Capture %s create error", path);
+        esp_ncp_capture_close();
+        return ESP_FAIL;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    s_capture.start_us = esp_ncp_time_us();
+    esp_ncp_capture_put(&head[0], ESP_NCP_CAPTURE_MAGIC, 4);
+    esp_ncp_capture_put(&head[4], ESP_NCP_CAPTURE_VERSION, 2);
+    esp_ncp_capture_put(&head[6], ESP_NCP_CAPTURE_ORIGIN_NCP, 2);
+    esp_ncp_capture_put(&head[8], (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec, 8);
+    esp_ncp_capture_put(&head[16], 0, 8);
+    fwrite(head, 1, sizeof(head), s_capture.file);
+    s_capture.offset = sizeof(head);
+    ESP_LOGI(TAG, "Capture the host traffic to %s", path);
+
+    return ESP_OK;
+}
+
+void esp_ncp_capture_record(esp_ncp_capture_dir_t dir, const void *data, size_t len)
+{
+    uint8_t head[12];
+    uint64_t time_ns;
+
+    if (!s_capture.file) {
+        return;
+    }
+
+    xSemaphoreTake(s_capture.lock, portMAX_DELAY);
+    time_ns = (uint64_t)(esp_ncp_time_us() - s_capture.start_us) * 1000;
+    esp_ncp_capture_put(&head[0], (len & ~ESP_NCP_CAPTURE_DIRECTION_BIT) | (dir == ESP_NCP_CAPTURE_FROM_NCP ? ESP_NCP_CAPTURE_DIRECTION_BIT : 0), 4);
+    esp_ncp_capture_put(&head[4], time_ns, 8);
+
+    if (s_capture.records % ESP_NCP_CAPTURE_INDEX_INTERVAL == 0) {
+        if (s_capture.index_count == s_capture.index_size) {
+            uint32_t size = s_capture.index_size ? s_capture.index_size * 2 : 64;
+            esp_ncp_capture_index_t *index = realloc(s_capture.index, size * sizeof(esp_ncp_capture_index_t));
+            if (index) {
+                s_capture.index = index;
+                s_capture.index_size = size;
+            }
+        }
+        if (s_capture.index_count < s_capture.index_size) {
+            s_capture.index[s_capture.index_count ++] = (esp_ncp_capture_index_t) {
+                .number = s_capture.records,
+                .offset = s_capture.offset,
+                .time_ns = time_ns,
+            };
+        }
+        /* A capture cut short by a crash loses at most the records since the last entry */
+        fflush(s_capture.file);
+    }
+
+    fwrite(head, 1, sizeof(head), s_capture.file);
+    fwrite(data, 1, len, s_capture.file);
+    s_capture.offset += sizeof(head) + len;
+    s_capture.records ++;
+    xSemaphoreGive(s_capture.lock);
+}
+
+void esp_ncp_capture_close(void)
+{
+    uint8_t buf[24];
+
+    if (s_capture.file) {
+        if (s_capture.lock) {
+            xSemaphoreTake(s_capture.lock, portMAX_DELAY);
+        }
+        esp_ncp_capture_put(&buf[0], ESP_NCP_CAPTURE_INDEX_MAGIC, 4);
+        esp_ncp_capture_put(&buf[4], s_capture.index_count, 4);
+        fwrite(buf, 1, 8, s_capture.file);
+        for (uint32_t i = 0; i < s_capture.index_count; i ++) {
+            esp_ncp_capture_put(&buf[0], s_capture.index[i].number, 8);
+            esp_ncp_capture_put(&buf[8], s_capture.index[i].offset, 8);
+            esp_ncp_capture_put(&buf[16], s_capture.index[i].time_ns, 8);
+            fwrite(buf, 1, 24, s_capture.file);
+        }
+
+        /* The index offset in the file header tells the readers the capture is complete */
+        esp_ncp_capture_put(buf, s_capture.offset, 8);
+        fseek(s_capture.file, 16, SEEK_SET);
+        fwrite(buf, 1, 8, s_capture.file);
+        fclose(s_capture.file);
+        s_capture.file = NULL;
+        if (s_capture.lock) {
+            xSemaphoreGive(s_capture.lock);
+        }
+    }
+
+    if (s_capture.lock) {
+        vSemaphoreDelete(s_capture.lock);
+    }
+    free(s_capture.index);
+    memset(&s_capture, 0, sizeof(s_capture));
+}
+
+#endif /* CONFIG_NCP_BUS_CAPTURE */
@@ -55,6 +55,10 @@ static esp_err_t esp_ncp_process_event(esp_ncp_dev_t *dev, esp_ncp_ctx_t *ctx)
         return ESP_FAIL;
     }
 
+    if (ctx->event == NCP_EVENT_DISCONNECT) {
+        return esp_ncp_bus_frame_reset();
+    }
+
     buffer = calloc(1, ctx->size);
     if (buffer == NULL) {
         ESP_LOGE(TAG, "Process event out of memory");
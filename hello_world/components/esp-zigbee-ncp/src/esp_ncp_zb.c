@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include "nvs_flash.h"
@@ -13,6 +14,7 @@
 #include "esp_check.h"
 #include "esp_system.h"
 #include "esp_random.h"
+#include "esp_crc.h"
 
 #include "esp_zigbee_core.h"
 #include "zdo/esp_zigbee_zdo_command.h"
@@ -23,6 +25,14 @@
 #include "esp_ncp_frame.h"
 #include "esp_ncp_main.h"
 #include "esp_ncp_zb.h"
+#include "esp_ncp_zb_groupcast.h"
+#include "esp_ncp_zb_interrogate.h"
+#include "esp_ncp_zb_join.h"
+#include "esp_ncp_zb_mailbox.h"
+#include "esp_ncp_zb_rule.h"
+#include "esp_ncp_zb_sched.h"
+#include "esp_ncp_zb_timer.h"
+#include "esp_ncp_wire.h"
 #include "esp_zb_ncp.h"
 
 static const char *TAG = "ESP_NCP_ZB";
@@ -32,6 +42,10 @@ static bool s_start_flag = false;
 static uint32_t s_primary_channel = 0;
 static QueueHandle_t s_aps_data_confirm;    /*!< The queue handler for sync between the host and NCP */
 static QueueHandle_t s_aps_data_indication; /*!< The queue handler for sync between the host and NCP */
+static bool s_aps_handler_registered = false;
+static bool s_aps_forward = false;          /*!< The APS indications and confirms go to the host, once it sent APS data */
+static esp_ncp_header_t s_request_header;   /*!< The header of the request frame being processed */
+static uint64_t s_signal_mask;              /*!< The bitmap of the stack signals forwarded to the host, by esp_zb_app_signal_type_t */
 
 #define ESP_NCP_ZB_STATUS()                 \
 {                                           \
@@ -44,6 +58,18 @@ static QueueHandle_t s_aps_data_indication; /*!< The queue handler for sync betw
     }                                       \
 }                                           \
 
+#define ESP_NCP_ZB_STATUS_TSN()                 \
+{                                               \
+    *output = calloc(1, 2 * sizeof(uint8_t));   \
+    if (*output) {                              \
+        *outlen = 2 * sizeof(uint8_t);          \
+        (*output)[0] = status;                  \
+        (*output)[1] = tsn;                     \
+    } else {                                    \
+        ret = ESP_ERR_NO_MEM;                   \
+    }                                           \
+}                                               \
+
 typedef struct {
     uint16_t  cluster_id;
     esp_err_t (*add_cluster_fn)(esp_zb_cluster_list_t *cluster_list, esp_zb_attribute_list_t *attr_list, uint8_t role_mask);
@@ -56,6 +82,122 @@ typedef struct {
     void            *data;                  /*!< Data on the event */
 } esp_ncp_zb_ctx_t;
 
+typedef struct {
+    uint8_t         dst_addr_mode;          /*!< The addressing mode for the destination address, refer to esp_zb_aps_address_mode_t */
+    esp_zb_addr_u   dst_addr;               /*!< The individual device address or group address of the destination */
+    uint8_t         dst_endpoint;           /*!< The destination endpoint */
+    uint8_t         tx_options;             /*!< The transmission options for the destination, refer to esp_zb_apsde_tx_opt_t */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_aps_bulk_dst_t;
+
+typedef struct {
+    uint8_t                     sn;         /*!< The sequence number of the bulk request, reused by the aggregated confirm */
+    uint8_t                     count;      /*!< The number of destinations */
+    uint8_t                     queued;     /*!< The number of destinations handed to the air-time scheduler */
+    uint8_t                     sent;       /*!< The number of destinations the scheduler sent or dropped */
+    uint8_t                     confirmed;  /*!< The number of destinations with a final status */
+    uint16_t                    pacing_ms;  /*!< The delay between two destinations */
+    esp_zb_user_cb_handle_t     timeout;    /*!< The alarm handle waiting for the outstanding confirms */
+    esp_zb_apsde_data_req_t     data_req;   /*!< The shared APSDE-DATA.request, destination fields are filled per send */
+    esp_ncp_zb_aps_bulk_dst_t   *dst;       /*!< The destination list */
+    uint32_t                    *handle;    /*!< The send handle of each destination, 0 until it is handed to the stack */
+    uint8_t                     *result;    /*!< The aggregated confirm, the count followed by one status per destination */
+} esp_ncp_zb_aps_bulk_t;
+
+static esp_ncp_zb_aps_bulk_t *s_aps_bulk;  /*!< The bulk APS data request in progress */
+
+typedef struct {
+    uint32_t        handle;                 /*!< The send handle of the request, 0 if the entry is free */
+    uint8_t         dst_addr_mode;          /*!< The addressing mode of the request */
+    esp_zb_addr_u   dst_addr;               /*!< The destination address of the request */
+    uint8_t         dst_endpoint;           /*!< The destination endpoint of the request */
+    uint8_t         src_endpoint;           /*!< The source endpoint of the request */
+    bool            host;                   /*!< The host sent the request, the confirm of a rule or timer send is not forwarded */
+} esp_ncp_zb_aps_sent_t;
+
+/* The confirm of the stack carries no handle, the NCP numbers its sends and gives a confirm to the oldest matching one */
+static esp_ncp_zb_aps_sent_t s_aps_sent[ESP_NCP_ZB_APS_SENT_MAX];
+static uint32_t s_aps_handle;               /*!< The handle of the last APS data request handed to the stack */
+
+typedef struct {
+    bool            used;                   /*!< The entry is waiting for a response */
+    uint8_t         tsn;                    /*!< The ZCL transaction sequence number returned by the stack */
+    uint8_t         sn;                     /*!< The sequence number of the host request */
+    uint16_t        id;                     /*!< The frame ID of the host request */
+    uint16_t        cluster_id;             /*!< The cluster ID of the request */
+    uint16_t        dst_addr;               /*!< The short address the request was sent to */
+    TickType_t      sent;                   /*!< The tick count at which the request was sent */
+} esp_ncp_zb_zcl_inflight_t;
+
+static esp_ncp_zb_zcl_inflight_t s_zcl_inflight[ESP_NCP_ZB_ZCL_INFLIGHT_MAX];
+static portMUX_TYPE s_zcl_inflight_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool esp_ncp_zb_zcl_inflight_expired(const esp_ncp_zb_zcl_inflight_t *entry, TickType_t now)
+{
+    return (now - entry->sent) >= pdMS_TO_TICKS(ESP_NCP_ZB_ZCL_INFLIGHT_TIMEOUT_MS);
+}
+
+static void esp_ncp_zb_zcl_inflight_add(uint8_t address_mode, uint16_t dst_addr, uint16_t cluster_id, uint8_t tsn)
+{
+    if (address_mode != ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT) {
+        return;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    esp_ncp_zb_zcl_inflight_t *entry = NULL;
+
+    portENTER_CRITICAL(&s_zcl_inflight_lock);
+    /* A free or expired entry is taken first, when every entry waits the one sent the longest ago is evicted */
+    for (int i = 0; i < ESP_NCP_ZB_ZCL_INFLIGHT_MAX; i ++) {
+        esp_ncp_zb_zcl_inflight_t *slot = &s_zcl_inflight[i];
+
+        if (!slot->used || esp_ncp_zb_zcl_inflight_expired(slot, now)) {
+            entry = slot;
+            break;
+        }
+        if (!entry || (now - slot->sent) > (now - entry->sent)) {
+            entry = slot;
+        }
+    }
+    if (entry->used && !esp_ncp_zb_zcl_inflight_expired(entry, now)) {
+        ESP_LOGW(TAG, "ZCL request(0x%04hx) sn %d evicted before its response", entry->id, entry->sn);
+    }
+
+    entry->used = true;
+    entry->tsn = tsn;
+    entry->sn = s_request_header.sn;
+    entry->id = s_request_header.id;
+    entry->cluster_id = cluster_id;
+    entry->dst_addr = dst_addr;
+    entry->sent = now;
+    portEXIT_CRITICAL(&s_zcl_inflight_lock);
+}
+
+static bool esp_ncp_zb_zcl_inflight_take(const esp_zb_zcl_cmd_info_t *info, esp_ncp_header_t *ncp_header)
+{
+    TickType_t now = xTaskGetTickCount();
+    bool found = false;
+
+    portENTER_CRITICAL(&s_zcl_inflight_lock);
+    for (int i = 0; i < ESP_NCP_ZB_ZCL_INFLIGHT_MAX; i ++) {
+        esp_ncp_zb_zcl_inflight_t *entry = &s_zcl_inflight[i];
+        if (entry->used && esp_ncp_zb_zcl_inflight_expired(entry, now)) {
+            entry->used = false;
+            continue;
+        }
+        if (entry->used && entry->tsn == info->header.tsn && entry->cluster_id == info->cluster
+            && entry->dst_addr == info->src_address.u.short_addr) {
+            ncp_header->sn = entry->sn;
+            ncp_header->id = entry->id;
+            entry->used = false;
+            found = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_zcl_inflight_lock);
+
+    return found;
+}
+
 static esp_err_t esp_ncp_zb_aps_data_handle(uint16_t id, const void *buffer, uint16_t len)
 {
     QueueHandle_t event_queue = (id == ESP_NCP_APS_DATA_CONFIRM) ? s_aps_data_confirm : s_aps_data_indication;
@@ -88,70 +230,185 @@ static esp_err_t esp_ncp_zb_aps_data_handle(uint16_t id, const void *buffer, uin
 
 static bool esp_ncp_zb_aps_data_indication_handler(esp_zb_apsde_data_ind_t ind)
 {
-    typedef struct {
-        uint8_t states;                     /*!< The states of the device */
-        uint8_t dst_addr_mode;              /*!< Reserved, the addressing mode for the destination address used in this primitive and of the APDU that has been received.*/
-        esp_zb_addr_u dst_addr;             /*!< The individual device address or group address to which the ASDU is directed.*/
-        uint8_t dst_endpoint;               /*!< The target endpoint on the local entity to which the ASDU is directed.*/
-        uint8_t src_addr_mode;              /*!< Reserved, The addressing mode for the source address used in this primitive and of the APDU that has been received.*/
-        esp_zb_addr_u src_addr;             /*!< The individual device address of the entity from which the ASDU has been received.*/
-        uint8_t src_endpoint;               /*!< The number of the individual endpoint of the entity from which the ASDU has been received.*/
-        uint16_t profile_id;                /*!< The identifier of the profile from which this frame originated.*/
-        uint16_t cluster_id;                /*!< The identifier of the received object.*/
-        uint8_t indication_status;          /*!< The status of the incoming frame processing, 0: on success */
-        uint8_t security_status;            /*!< UNSECURED if the ASDU was received without any security. SECURED_NWK_KEY if the received ASDU was secured with the NWK key.*/
-        uint8_t lqi;                        /*!< The link quality indication delivered by the NLDE.*/
-        int rx_time;                        /*!< Reserved, a time indication for the received packet based on the local clock */
-        uint32_t asdu_length;               /*!< The number of octets comprising the ASDU being indicated by the APSDE.*/
-    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_aps_data_ind_t;
-
-    uint16_t outlen = sizeof(esp_ncp_zb_aps_data_ind_t) + ind.asdu_length;
+    esp_ncp_wire_aps_data_indication_t aps_data = {
+        .states = ESP_NCP_INDICATION,
+        .dst_addr_mode = ind.dst_addr_mode,
+        .dst_endpoint = ind.dst_endpoint,
+        .src_addr_mode = ind.src_addr_mode,
+        .src_endpoint = ind.src_endpoint,
+        .profile_id = ind.profile_id,
+        .cluster_id = ind.cluster_id,
+        .indication_status = ind.status,
+        .security_status = ind.security_status,
+        .lqi = ind.lqi,
+        .rx_time = ind.rx_time,
+        .asdu_length = ind.asdu ? ind.asdu_length : 0,
+        .asdu = ind.asdu,
+    };
+
+    esp_ncp_zb_rule_aps_indication(&ind);
+
+    /* Registered for the rules only, the stack handles the indication as if there were no handler */
+    if (!s_aps_forward) {
+        return false;
+    }
+
+    /* The indication only carries the short addresses, whatever the addressing mode */
+    esp_ncp_wire_addr_set_short(&aps_data.dst_addr, ind.dst_short_addr);
+    esp_ncp_wire_addr_set_short(&aps_data.src_addr, ind.src_short_addr);
+
+    uint16_t outlen = esp_ncp_wire_aps_data_indication_size(&aps_data);
     uint8_t *output = calloc(1, outlen);
     if (!output) {
         return false;
     }
+    esp_ncp_wire_aps_data_indication_encode(&aps_data, output, outlen);
 
-    esp_ncp_zb_aps_data_ind_t *aps_data = (esp_ncp_zb_aps_data_ind_t *)output;
-    aps_data->dst_addr_mode = ind.dst_addr_mode;
-    if (ind.dst_addr_mode == ESP_ZB_APS_ADDR_MODE_64_ENDP_PRESENT) {
-        memcpy(aps_data->dst_addr.addr_long, &ind.dst_short_addr, sizeof(esp_zb_ieee_addr_t));
-    } else {
-        aps_data->dst_addr.addr_short = ind.dst_short_addr;
+    esp_ncp_zb_aps_data_handle(ESP_NCP_APS_DATA_INDICATION, output, outlen);
+    free(output);
+    output = NULL;
+
+    ESP_LOGD(TAG, "%s %d", __func__, __LINE__);
+    return s_aps_data_indication ? true : false;
+}
+
+static void esp_ncp_zb_aps_bulk_finish(esp_ncp_zb_aps_bulk_t *bulk)
+{
+    esp_ncp_header_t ncp_header = {
+        .sn = bulk->sn,
+        .id = ESP_NCP_APS_DATA_REQUEST_BULK,
+    };
+
+    esp_ncp_noti_input(&ncp_header, bulk->result, bulk->count + 1);
+
+    s_aps_bulk = NULL;
+    free(bulk);
+}
+
+static uint32_t esp_ncp_zb_aps_handle_next(void)
+{
+    if (++ s_aps_handle == 0) {
+        s_aps_handle = 1;
     }
-    aps_data->dst_endpoint = ind.dst_endpoint;
 
-    aps_data->src_addr_mode = ind.src_addr_mode;
-    if (ind.src_addr_mode == ESP_ZB_APS_ADDR_MODE_64_ENDP_PRESENT) {
-        memcpy(aps_data->src_addr.addr_long, &ind.src_short_addr, sizeof(esp_zb_ieee_addr_t));
-    } else {
-        aps_data->src_addr.addr_short = ind.src_short_addr;
+    return s_aps_handle;
+}
+
+/* The number of sends since the handle, the larger the older, safe across the wrap of the handles */
+static uint32_t esp_ncp_zb_aps_handle_age(uint32_t handle)
+{
+    return s_aps_handle - handle;
+}
+
+static bool esp_ncp_zb_aps_dst_match(uint8_t dst_addr_mode, const esp_zb_addr_u *dst_addr, uint8_t dst_endpoint,
+                                     const esp_zb_apsde_data_confirm_t *confirm)
+{
+    if (dst_addr_mode != confirm->dst_addr_mode || dst_endpoint != confirm->dst_endpoint) {
+        return false;
+    }
+
+    if (dst_addr_mode == ESP_ZB_APS_ADDR_MODE_64_ENDP_PRESENT) {
+        return !memcmp(dst_addr->addr_long, confirm->dst_addr.addr_long, sizeof(esp_zb_ieee_addr_t));
     }
-    aps_data->src_endpoint = ind.src_endpoint;
 
-    aps_data->states = ESP_NCP_INDICATION;
-    aps_data->profile_id = ind.profile_id;
-    aps_data->cluster_id = ind.cluster_id;
+    return dst_addr->addr_short == confirm->dst_addr.addr_short;
+}
 
-    aps_data->indication_status = ind.status;
-    aps_data->security_status   = ind.security_status;
-    aps_data->lqi = ind.lqi;
-    aps_data->rx_time = ind.rx_time;
+/* Records a single APS data request before it is handed to the stack, the oldest entry gives way when the table is full */
+static esp_ncp_zb_aps_sent_t *esp_ncp_zb_aps_sent_add(const esp_zb_apsde_data_req_t *req, bool host)
+{
+    esp_ncp_zb_aps_sent_t *entry = &s_aps_sent[0];
 
-    aps_data->asdu_length = ind.asdu_length;
-    if (ind.asdu && ind.asdu_length) {
-        memcpy(output + sizeof(esp_ncp_zb_aps_data_ind_t), ind.asdu, ind.asdu_length);
+    for (int i = 0; i < ESP_NCP_ZB_APS_SENT_MAX; i ++) {
+        if (!s_aps_sent[i].handle) {
+            entry = &s_aps_sent[i];
+            break;
+        }
+        if (esp_ncp_zb_aps_handle_age(s_aps_sent[i].handle) > esp_ncp_zb_aps_handle_age(entry->handle)) {
+            entry = &s_aps_sent[i];
+        }
     }
 
-    esp_ncp_zb_aps_data_handle(ESP_NCP_APS_DATA_INDICATION, output, outlen);
-    free(output);
-    output = NULL;
+    entry->handle = esp_ncp_zb_aps_handle_next();
+    entry->dst_addr_mode = req->dst_addr_mode;
+    memcpy(&entry->dst_addr, &req->dst_addr, sizeof(esp_zb_addr_u));
+    entry->dst_endpoint = req->dst_endpoint;
+    entry->src_endpoint = req->src_endpoint;
+    entry->host = host;
 
-    ESP_LOGI(TAG, "%s %d", __func__, __LINE__);
-    return s_aps_data_indication ? true : false;
+    return entry;
+}
+
+static esp_ncp_zb_aps_sent_t *esp_ncp_zb_aps_sent_find(const esp_zb_apsde_data_confirm_t *confirm)
+{
+    esp_ncp_zb_aps_sent_t *found = NULL;
+
+    for (int i = 0; i < ESP_NCP_ZB_APS_SENT_MAX; i ++) {
+        esp_ncp_zb_aps_sent_t *entry = &s_aps_sent[i];
+
+        if (!entry->handle || entry->src_endpoint != confirm->src_endpoint
+            || !esp_ncp_zb_aps_dst_match(entry->dst_addr_mode, &entry->dst_addr, entry->dst_endpoint, confirm)) {
+            continue;
+        }
+        if (!found || esp_ncp_zb_aps_handle_age(entry->handle) > esp_ncp_zb_aps_handle_age(found->handle)) {
+            found = entry;
+        }
+    }
+
+    return found;
+}
+
+/* Claims the confirm for the bulk request or for a rule or timer send if its oldest matching send is one, false leaves it to the host */
+static bool esp_ncp_zb_aps_bulk_confirm(const esp_zb_apsde_data_confirm_t *confirm)
+{
+    esp_ncp_zb_aps_bulk_t *bulk = s_aps_bulk;
+    esp_ncp_zb_aps_sent_t *sent = esp_ncp_zb_aps_sent_find(confirm);
+    int index = -1;
+
+    if (bulk && confirm->src_endpoint == bulk->data_req.src_endpoint && confirm->asdu_length == bulk->data_req.asdu_length
+        && (!confirm->asdu || !confirm->asdu_length || !memcmp(confirm->asdu, bulk->data_req.asdu, confirm->asdu_length))) {
+        /* The scheduler may send the destinations out of order, the handle tells the ones already sent */
+        for (int i = 0; i < bulk->queued; i ++) {
+            esp_ncp_zb_aps_bulk_dst_t *dst = &bulk->dst[i];
+            esp_zb_addr_u dst_addr;
+
+            memcpy(&dst_addr, &dst->dst_addr, sizeof(esp_zb_addr_u));
+            if (!bulk->handle[i] || bulk->result[i + 1] != ESP_NCP_ZB_APS_BULK_NO_CONFIRM
+                || !esp_ncp_zb_aps_dst_match(dst->dst_addr_mode, &dst_addr, dst->dst_endpoint, confirm)) {
+                continue;
+            }
+            if (index < 0 || esp_ncp_zb_aps_handle_age(bulk->handle[i]) > esp_ncp_zb_aps_handle_age(bulk->handle[index])) {
+                index = i;
+            }
+        }
+    }
+
+    if (sent && (index < 0 || esp_ncp_zb_aps_handle_age(sent->handle) > esp_ncp_zb_aps_handle_age(bulk->handle[index]))) {
+        sent->handle = 0;
+        return !sent->host;
+    }
+
+    if (index < 0) {
+        return false;
+    }
+
+    bulk->result[index + 1] = confirm->status;
+    bulk->confirmed ++;
+
+    if (bulk->sent == bulk->count && bulk->confirmed == bulk->count) {
+        esp_zb_scheduler_user_alarm_cancel(bulk->timeout);
+        esp_ncp_zb_aps_bulk_finish(bulk);
+    }
+
+    return true;
 }
 
 static void esp_ncp_zb_aps_data_confirm_handler(esp_zb_apsde_data_confirm_t confirm)
 {
+    if (esp_ncp_zb_aps_bulk_confirm(&confirm) || !s_aps_forward) {
+        return;
+    }
+
     typedef struct {
         uint8_t states;                     /*!< The states of the device */
         uint8_t dst_addr_mode;              /*!< The addressing mode for the destination address used in this primitive and of the APDU to be transferred.*/
@@ -186,7 +443,7 @@ static void esp_ncp_zb_aps_data_confirm_handler(esp_zb_apsde_data_confirm_t conf
     free(output);
     output = NULL;
 
-    ESP_LOGI(TAG, "%s %d", __func__, __LINE__);
+    ESP_LOGD(TAG, "%s %d", __func__, __LINE__);
 }
 
 static void esp_ncp_zb_bdb_start_top_level_commissioning_cb(uint8_t mode_mask)
@@ -270,6 +527,27 @@ static void esp_ncp_zb_find_match_cb(esp_zb_zdp_status_t zdo_status, uint16_t ad
     esp_ncp_noti_input(&ncp_header, &parameters, sizeof(esp_ncp_zb_find_parameters_t));
 }
 
+typedef struct {
+    bool        streaming;                      /*!< The scan is split into one scan per channel */
+    bool        stop;                           /*!< The host asked to stop the streamed scan */
+    uint8_t     sn;                             /*!< The sequence number of the scan request, reused by every notification */
+    uint8_t     channel;                        /*!< The channel scanned at the moment */
+    uint8_t     duration;                       /*!< The scan duration of every channel */
+    uint8_t     total;                          /*!< The number of networks streamed so far */
+    uint32_t    channel_mask;                   /*!< The channels left to scan */
+} esp_ncp_zb_scan_t;
+
+static esp_ncp_zb_scan_t s_scan;               /*!< The streamed scan in progress */
+
+static void esp_ncp_zb_zdo_scan_complete_handler(esp_zb_zdp_status_t zdo_status, uint8_t count, esp_zb_network_descriptor_t *nwk_descriptor);
+
+static void esp_ncp_zb_scan_next_channel(void)
+{
+    s_scan.channel = __builtin_ctz(s_scan.channel_mask);
+    s_scan.channel_mask &= ~(1UL << s_scan.channel);
+    esp_zb_zdo_active_scan_request(1UL << s_scan.channel, s_scan.duration, esp_ncp_zb_zdo_scan_complete_handler);
+}
+
 static void esp_ncp_zb_zdo_scan_complete_handler(esp_zb_zdp_status_t zdo_status, uint8_t count, esp_zb_network_descriptor_t *nwk_descriptor)
 {
     esp_ncp_header_t ncp_header = {
@@ -282,22 +560,58 @@ static void esp_ncp_zb_zdo_scan_complete_handler(esp_zb_zdp_status_t zdo_status,
         uint8_t                count;
     } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_scan_parameters_t;
 
-    uint16_t outlen = sizeof(esp_ncp_zb_scan_parameters_t) + (count * sizeof(esp_zb_network_descriptor_t));
+    typedef struct {
+        esp_zb_zdp_status_t    zdo_status;
+        uint8_t                channel;
+        uint8_t                count;
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_scan_result_t;
+
+    uint16_t head_len = s_scan.streaming ? sizeof(esp_ncp_zb_scan_result_t) : sizeof(esp_ncp_zb_scan_parameters_t);
+    uint16_t outlen = head_len + (count * sizeof(esp_zb_network_descriptor_t));
     uint8_t *output = calloc(1, outlen);
 
     if (output) {
-        esp_ncp_zb_scan_parameters_t *scan_data = (esp_ncp_zb_scan_parameters_t *)output;
-        scan_data->zdo_status = zdo_status;
-        scan_data->count = count;
+        if (s_scan.streaming) {
+            esp_ncp_zb_scan_result_t *scan_result = (esp_ncp_zb_scan_result_t *)output;
+            scan_result->zdo_status = zdo_status;
+            scan_result->channel = s_scan.channel;
+            scan_result->count = count;
+            ncp_header.sn = s_scan.sn;
+            ncp_header.id = ESP_NCP_NETWORK_SCAN_RESULT;
+        } else {
+            esp_ncp_zb_scan_parameters_t *scan_data = (esp_ncp_zb_scan_parameters_t *)output;
+            scan_data->zdo_status = zdo_status;
+            scan_data->count = count;
+        }
 
         if (nwk_descriptor && count) {
-            memcpy(scan_data + sizeof(esp_ncp_zb_scan_parameters_t), nwk_descriptor, (count * sizeof(esp_zb_network_descriptor_t)));
+            memcpy(output + head_len, nwk_descriptor, (count * sizeof(esp_zb_network_descriptor_t)));
         }
 
         esp_ncp_noti_input(&ncp_header, output, outlen);
         free(output);
         output = NULL;
     }
+
+    if (!s_scan.streaming) {
+        return;
+    }
+
+    s_scan.total += count;
+    if (s_scan.channel_mask && !s_scan.stop) {
+        esp_ncp_zb_scan_next_channel();
+    } else {
+        /* The summary record keeps the scan complete layout, the count is the number of networks already streamed */
+        esp_ncp_zb_scan_parameters_t summary = {
+            .zdo_status = zdo_status,
+            .count = s_scan.total,
+        };
+
+        ncp_header.sn = s_scan.sn;
+        ncp_header.id = ESP_NCP_NETWORK_SCAN_COMPLETE_HANDLER;
+        memset(&s_scan, 0, sizeof(esp_ncp_zb_scan_t));
+        esp_ncp_noti_input(&ncp_header, &summary, sizeof(esp_ncp_zb_scan_parameters_t));
+    }
 }
 
 static esp_err_t esp_ncp_zb_read_attr_resp_handler(const esp_zb_zcl_cmd_read_attr_resp_message_t *message, uint8_t **output, uint16_t *outlen)
@@ -489,272 +803,1396 @@ static esp_err_t esp_ncp_zb_report_attr_handler(const esp_zb_zcl_report_attr_mes
     return ESP_OK;
 }
 
-static esp_err_t esp_ncp_zb_action_handler(esp_zb_core_action_callback_id_t callback_id, const void *message)
-{
-    esp_err_t ret = ESP_OK;
-    esp_ncp_header_t ncp_header = { 
-        .sn = esp_random() % 0xFF,
-    };
-    uint8_t *output = NULL;
-    uint16_t outlen = 0;
+typedef enum {
+    ESP_NCP_ZB_ZCL_BULK_IDLE,                   /*!< The device is waiting for the request */
+    ESP_NCP_ZB_ZCL_BULK_QUEUED,                 /*!< The request waits for the air-time scheduler */
+    ESP_NCP_ZB_ZCL_BULK_INFLIGHT,               /*!< The request is sent to the device */
+    ESP_NCP_ZB_ZCL_BULK_DONE,                   /*!< The device record is ready */
+} esp_ncp_zb_zcl_bulk_state_t;
 
-    switch (callback_id) {
-        case ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID:
-            ncp_header.id = ESP_NCP_ZCL_ATTR_READ;
-            ret = esp_ncp_zb_read_attr_resp_handler((esp_zb_zcl_cmd_read_attr_resp_message_t *)message, &output, &outlen);
-            break;
-        case ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID:
-            ncp_header.id = ESP_NCP_ZCL_ATTR_WRITE;
-            ret = esp_ncp_zb_write_attr_resp_handler((esp_zb_zcl_cmd_write_attr_resp_message_t *)message, &output, &outlen);
-            break;
-        case ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID:
-            ncp_header.id = ESP_NCP_ZCL_REPORT_CONFIG;
-            ret = esp_ncp_zb_report_configure_resp_handler((esp_zb_zcl_cmd_config_report_resp_message_t *)message, &output, &outlen);
-            break;
-        case ESP_ZB_CORE_CMD_DISC_ATTR_RESP_CB_ID:
-            ncp_header.id = ESP_NCP_ZCL_ATTR_DISC;
-            ret = esp_ncp_zb_disc_attr_resp_handler((esp_zb_zcl_cmd_discover_attributes_resp_message_t *)message, &output, &outlen);
-            break;
-        case ESP_ZB_CORE_REPORT_ATTR_CB_ID:
-            ncp_header.id = ESP_NCP_ZCL_ATTR_REPORT;
-            ret = esp_ncp_zb_report_attr_handler((esp_zb_zcl_report_attr_message_t *)message, &output, &outlen);
-            break;
-        default:
-            ESP_LOGW(TAG, "Receive Zigbee action(0x%x) callback", callback_id);
-            break;
-    }
+typedef struct {
+    uint16_t        addr;                       /*!< The short address of the device */
+    uint8_t         state;                      /*!< The request state of the device, refer to esp_ncp_zb_zcl_bulk_state_t */
+    uint8_t         retries;                    /*!< The remaining retries after a timeout */
+    uint8_t         tsn;                        /*!< The ZCL transaction sequence number of the request in flight */
+    TickType_t      deadline;                   /*!< The tick count at which the request in flight times out */
+    uint16_t        record_len;                 /*!< The length of the device record */
+    uint8_t         *record;                    /*!< The device record reported to the host */
+} esp_ncp_zb_zcl_bulk_dev_t;
+
+/**
+ * @brief Send the bulk ZCL command to one device.
+ *
+ * @param[in] cmd  The ZCL command shared by every device of the bulk request
+ * @param[in] addr The short address of the device
+ *
+ * @return The transaction sequence number
+ */
+typedef uint8_t (*esp_ncp_zb_zcl_bulk_issue_t)(void *cmd, uint16_t addr);
 
-    if (output) {
-        esp_ncp_noti_input(&ncp_header, output, outlen);
-        free(output);
-        output = NULL;
+typedef struct {
+    uint16_t                    id;             /*!< The frame ID of the bulk request */
+    uint8_t                     sn;             /*!< The sequence number of the bulk request, reused by every partial response */
+    uint8_t                     concurrency;    /*!< The maximum number of devices requested at the same time */
+    uint16_t                    inflight;       /*!< The number of devices queued for air-time or requested at the moment */
+    uint16_t                    cluster_id;     /*!< The cluster ID of the ZCL command */
+    uint16_t                    timeout_ms;     /*!< The time to wait for the response of one device */
+    uint16_t                    frame_len;      /*!< The ZCL payload length of the command, charged to the air-time budget */
+    uint16_t                    count;          /*!< The number of devices */
+    uint16_t                    next;           /*!< The index of the next device to request */
+    uint16_t                    flushed;        /*!< The number of device records handed to the host */
+    esp_zb_user_cb_handle_t     tick;           /*!< The alarm handle checking timeouts */
+    esp_ncp_zb_zcl_bulk_issue_t issue;          /*!< The function sending the ZCL command to one device */
+    void                        *cmd;           /*!< The ZCL command shared by every device, the destination is filled per device */
+    uint16_t                    chunk_len;      /*!< The length of the pending partial response */
+    uint8_t                     chunk[ESP_NCP_ZB_ZCL_BULK_CHUNK_SIZE]; /*!< The pending partial response */
+    esp_ncp_zb_zcl_bulk_dev_t   dev[];          /*!< The device list */
+} esp_ncp_zb_zcl_bulk_t;
+
+static esp_ncp_zb_zcl_bulk_t *s_zcl_bulk;      /*!< The bulk ZCL request in progress */
+
+static void esp_ncp_zb_zcl_bulk_complete(esp_ncp_zb_zcl_bulk_t *bulk, esp_ncp_zb_zcl_bulk_dev_t *dev, uint8_t status,
+                                         esp_zb_core_action_callback_id_t callback_id, const void *message);
+
+/* The timeout of a device runs from the command sent, not from the time it waited for air-time */
+static void esp_ncp_zb_zcl_bulk_send_cb(void *arg, bool drop)
+{
+    esp_ncp_zb_zcl_bulk_t *bulk = s_zcl_bulk;
+    esp_ncp_zb_zcl_bulk_dev_t *dev = (esp_ncp_zb_zcl_bulk_dev_t *)arg;
+
+    /* The record of a dropped device is handed to the host by the next pump of the timeout tick */
+    if (drop) {
+        esp_ncp_zb_zcl_bulk_complete(bulk, dev, ESP_ZB_ZCL_STATUS_INSUFF_SPACE, 0, NULL);
+        return;
     }
 
-    return ret;
+    dev->tsn = bulk->issue(bulk->cmd, dev->addr);
+    dev->deadline = xTaskGetTickCount() + pdMS_TO_TICKS(bulk->timeout_ms);
+    dev->state = ESP_NCP_ZB_ZCL_BULK_INFLIGHT;
 }
 
-static void esp_ncp_zb_task(void *pvParameters)
+static void esp_ncp_zb_zcl_bulk_issue(esp_ncp_zb_zcl_bulk_t *bulk, esp_ncp_zb_zcl_bulk_dev_t *dev)
 {
-    esp_zb_core_action_handler_register(esp_ncp_zb_action_handler);
-    esp_zb_stack_main_loop();
-    vTaskDelete(NULL);
+    dev->state = ESP_NCP_ZB_ZCL_BULK_QUEUED;
+    esp_ncp_zb_sched_submit(ESP_NCP_ZB_SCHED_CLASS_ATTRIBUTE, dev->addr, true, bulk->frame_len, esp_ncp_zb_zcl_bulk_send_cb, dev);
 }
 
-void esp_zb_app_signal_handler(esp_zb_app_signal_t *signal_struct)
+static void esp_ncp_zb_zcl_bulk_complete(esp_ncp_zb_zcl_bulk_t *bulk, esp_ncp_zb_zcl_bulk_dev_t *dev, uint8_t status,
+                                         esp_zb_core_action_callback_id_t callback_id, const void *message)
 {
-    uint32_t *p_sg_p       = signal_struct->p_app_signal;
-    esp_err_t err_status = signal_struct->esp_err_status;
-    esp_zb_app_signal_type_t sig_type = *p_sg_p;
-    esp_zb_zdo_signal_device_annce_params_t *dev_annce_params = NULL;
-    esp_zb_zdo_signal_leave_indication_params_t *dev_leave_params = NULL;
-    esp_ncp_header_t ncp_header = { 
-        .sn = esp_random() % 0xFF,
-    };
-    switch (sig_type) {
-        case ESP_ZB_ZDO_SIGNAL_DEFAULT_START:
-            break;
-        case ESP_ZB_ZDO_SIGNAL_SKIP_STARTUP:
-            ESP_LOGI(TAG, "Initialize Zigbee stack");
-            esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_INITIALIZATION);
-            break;
-        case ESP_ZB_ZDO_SIGNAL_DEVICE_ANNCE:
-            dev_annce_params = (esp_zb_zdo_signal_device_annce_params_t *)esp_zb_app_signal_get_params(p_sg_p);
-            ESP_LOGI(TAG, "New device commissioned or rejoined (short: 0x%04hx)", dev_annce_params->device_short_addr);
-            ncp_header.id = ESP_NCP_NETWORK_JOINNETWORK;
-            esp_ncp_noti_input(&ncp_header, dev_annce_params, sizeof(esp_zb_zdo_signal_device_annce_params_t));
-            break;
-        case ESP_ZB_ZDO_SIGNAL_LEAVE:
-            dev_leave_params = (esp_zb_zdo_signal_leave_indication_params_t *)esp_zb_app_signal_get_params(p_sg_p);
-            ESP_LOGI(TAG, "Leave Indication parameters (short: 0x%04hx)", dev_leave_params->short_addr);
-            ncp_header.id = ESP_NCP_NETWORK_LEAVENETWORK;
-            esp_ncp_noti_input(&ncp_header, dev_leave_params, sizeof(esp_zb_zdo_signal_leave_indication_params_t));
-            break;
-        case ESP_ZB_ZDO_SIGNAL_ERROR:
-            break;
-        case ESP_ZB_BDB_SIGNAL_DEVICE_FIRST_START:
-        case ESP_ZB_BDB_SIGNAL_DEVICE_REBOOT:
-            if (err_status == ESP_OK) {
-                ESP_LOGI(TAG, "Start network formation");
-                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_NETWORK_FORMATION);
-            } else {
-                ESP_LOGW(TAG, "%s failed with status: %s, retrying", esp_zb_zdo_signal_to_string(sig_type),
-                         esp_err_to_name(err_status));
-                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_INITIALIZATION);
-            }
-            break;
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK_STARTED:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK_JOINED_ROUTER:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK:
-            break;
-        case ESP_ZB_BDB_SIGNAL_STEERING:
-            if (err_status == ESP_OK) {
-                ESP_LOGI(TAG, "Network steering started");
-            }
-            break;
-        case ESP_ZB_BDB_SIGNAL_FORMATION:
-            if (err_status == ESP_OK) {
-                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_NETWORK_STEERING);
+    typedef struct {
+        uint16_t addr;                                  /*!< The short address of the device */
+        uint8_t  status;                                /*!< The status of the command, refer to esp_zb_zcl_status_t */
+        uint16_t attr_number;                           /*!< The number of attribute records which follow */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_zcl_bulk_record_t;
 
-                typedef struct {
-                    esp_zb_ieee_addr_t  extendedPanId;                      /*!< The network's extended PAN identifier */
-                    uint16_t            panId;                              /*!< The network's PAN identifier */
-                    uint8_t             radioChannel;                       /*!< A radio channel */
-                } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_formnetwork_parameters_t;
+    typedef struct {
+        uint16_t id;                                    /*!< The identify of attribute */
+        uint8_t  status;                                /*!< The status of the read operation on this attribute */
+        uint8_t  type;                                  /*!< The type of attribute, which can refer to esp_zb_zcl_attr_type_t */
+        uint8_t  size;                                  /*!< The value size of attribute */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_zcl_bulk_read_attr_t;
 
-                esp_ncp_zb_formnetwork_parameters_t parameters = { 
-                    .panId = esp_zb_get_pan_id(),
-                    .radioChannel = esp_zb_get_current_channel(),
-                };
-                esp_zb_get_extended_pan_id(parameters.extendedPanId);
+    typedef struct {
+        uint16_t id;                                    /*!< The identify of attribute */
+        uint8_t  status;                                /*!< The status of the configure reporting operation on this attribute */
+        uint8_t  direction;                             /*!< The direction of the reporting configuration */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_zcl_bulk_report_attr_t;
+
+    const esp_zb_zcl_read_attr_resp_variable_t *read_variables = NULL;
+    const esp_zb_zcl_config_report_resp_variable_t *report_variables = NULL;
+    size_t length = sizeof(esp_ncp_zb_zcl_bulk_record_t);
+
+    if (callback_id == ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID) {
+        read_variables = ((const esp_zb_zcl_cmd_read_attr_resp_message_t *)message)->variables;
+    } else if (callback_id == ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID) {
+        report_variables = ((const esp_zb_zcl_cmd_config_report_resp_message_t *)message)->variables;
+    }
 
-                ESP_LOGI(TAG, "Formed network successfully (Extended PAN ID: %02x:%02x:%02x:%02x:%02x:%02x:%02x:%02x, PAN ID: 0x%04hx, Channel:%d)",
-                        parameters.extendedPanId[7], parameters.extendedPanId[6], parameters.extendedPanId[5], parameters.extendedPanId[4],
-                        parameters.extendedPanId[3], parameters.extendedPanId[2], parameters.extendedPanId[1], parameters.extendedPanId[0],
-                        parameters.panId, parameters.radioChannel);
-                ncp_header.id = ESP_NCP_NETWORK_FORMNETWORK;
-                esp_ncp_noti_input(&ncp_header, &parameters, sizeof(esp_ncp_zb_formnetwork_parameters_t));
-            } else {
-                ESP_LOGI(TAG, "Restart network formation (status: %s)", esp_err_to_name(err_status));
-                esp_zb_scheduler_alarm((esp_zb_callback_t)esp_ncp_zb_bdb_start_top_level_commissioning_cb, ESP_ZB_BDB_MODE_NETWORK_FORMATION, 1000);
+    for (const esp_zb_zcl_read_attr_resp_variable_t *variable = read_variables; variable; variable = variable->next) {
+        length += sizeof(esp_ncp_zb_zcl_bulk_read_attr_t) + variable->attribute.data.size;
+    }
+    for (const esp_zb_zcl_config_report_resp_variable_t *variable = report_variables; variable; variable = variable->next) {
+        length += sizeof(esp_ncp_zb_zcl_bulk_report_attr_t);
+    }
+
+    /* A record which can not fit a chunk is not built, the pump reports the device with INSUFF_SPACE */
+    dev->record = (length <= ESP_NCP_ZB_ZCL_BULK_CHUNK_SIZE - 2) ? calloc(1, length) : NULL;
+    if (dev->record) {
+        esp_ncp_zb_zcl_bulk_record_t *record = (esp_ncp_zb_zcl_bulk_record_t *)dev->record;
+        uint8_t *data = dev->record + sizeof(esp_ncp_zb_zcl_bulk_record_t);
+
+        record->addr = dev->addr;
+        record->status = status;
+        for (const esp_zb_zcl_read_attr_resp_variable_t *variable = read_variables; variable; variable = variable->next) {
+            esp_ncp_zb_zcl_bulk_read_attr_t *attr = (esp_ncp_zb_zcl_bulk_read_attr_t *)data;
+            attr->id = variable->attribute.id;
+            attr->status = variable->status;
+            attr->type = variable->attribute.data.type;
+            attr->size = variable->attribute.data.size;
+            data += sizeof(esp_ncp_zb_zcl_bulk_read_attr_t);
+            if (variable->attribute.data.value && variable->attribute.data.size) {
+                memcpy(data, variable->attribute.data.value, variable->attribute.data.size);
             }
+            data += variable->attribute.data.size;
+            record->attr_number ++;
+        }
+        for (const esp_zb_zcl_config_report_resp_variable_t *variable = report_variables; variable; variable = variable->next) {
+            esp_ncp_zb_zcl_bulk_report_attr_t *attr = (esp_ncp_zb_zcl_bulk_report_attr_t *)data;
+            attr->id = variable->attribute_id;
+            attr->status = variable->status;
+            attr->direction = variable->direction;
+            data += sizeof(esp_ncp_zb_zcl_bulk_report_attr_t);
+            record->attr_number ++;
+        }
+        dev->record_len = length;
+    } else {
+        ESP_LOGE(TAG, "Bulk request: no record for device(0x%04hx) of %d bytes", dev->addr, (int)length);
+        dev->record_len = 0;
+    }
+
+    if (dev->state == ESP_NCP_ZB_ZCL_BULK_QUEUED || dev->state == ESP_NCP_ZB_ZCL_BULK_INFLIGHT) {
+        bulk->inflight --;
+    }
+    dev->state = ESP_NCP_ZB_ZCL_BULK_DONE;
+}
+
+static void esp_ncp_zb_zcl_bulk_flush(esp_ncp_zb_zcl_bulk_t *bulk, bool last)
+{
+    esp_ncp_header_t ncp_header = {
+        .sn = bulk->sn,
+        .id = bulk->id,
+    };
+
+    /* The chunk starts with the last flag and the number of device records */
+    bulk->chunk[0] = last;
+    esp_ncp_noti_input(&ncp_header, bulk->chunk, bulk->chunk_len);
+    bulk->chunk_len = 2;
+    bulk->chunk[1] = 0;
+}
+
+/* Issues requests up to the concurrency limit and hands finished records to the host in device order.
+ * Returns true once every record is sent and the bulk request is released.
+ */
+static bool esp_ncp_zb_zcl_bulk_pump(esp_ncp_zb_zcl_bulk_t *bulk)
+{
+    /* Counted before the submit, a device the scheduler drops at once is completed and uncounted within it */
+    while (bulk->inflight < bulk->concurrency && bulk->next < bulk->count) {
+        bulk->inflight ++;
+        esp_ncp_zb_zcl_bulk_issue(bulk, &bulk->dev[bulk->next ++]);
+    }
+
+    while (bulk->flushed < bulk->count && bulk->dev[bulk->flushed].state == ESP_NCP_ZB_ZCL_BULK_DONE) {
+        esp_ncp_zb_zcl_bulk_dev_t *dev = &bulk->dev[bulk->flushed];
+        const uint8_t *record = dev->record;
+        uint16_t record_len = dev->record_len;
+        uint8_t error_record[5];
+
+        /* A record lost for lack of memory or larger than a chunk is replaced by the address, an INSUFF_SPACE
+         * status and no attribute, so that every device of the request appears in the result */
+        if (!record || record_len > ESP_NCP_ZB_ZCL_BULK_CHUNK_SIZE - 2) {
+            ESP_LOGW(TAG, "Bulk request: device(0x%04hx) record of %d bytes not sent", dev->addr, record_len);
+            memcpy(error_record, &dev->addr, sizeof(uint16_t));
+            error_record[2] = ESP_ZB_ZCL_STATUS_INSUFF_SPACE;
+            error_record[3] = 0;
+            error_record[4] = 0;
+            record = error_record;
+            record_len = sizeof(error_record);
+        }
+
+        /* The chunk is not empty here, a record which fits an empty chunk never triggers the flush */
+        if (bulk->chunk_len + record_len > ESP_NCP_ZB_ZCL_BULK_CHUNK_SIZE) {
+            esp_ncp_zb_zcl_bulk_flush(bulk, false);
+        }
+        memcpy(&bulk->chunk[bulk->chunk_len], record, record_len);
+        bulk->chunk_len += record_len;
+        bulk->chunk[1] ++;
+        free(dev->record);
+        dev->record = NULL;
+        bulk->flushed ++;
+    }
+
+    if (bulk->flushed < bulk->count) {
+        return false;
+    }
+
+    esp_ncp_zb_zcl_bulk_flush(bulk, true);
+    if (bulk->tick != ESP_ZB_USER_CB_HANDLE_INVALID) {
+        esp_zb_scheduler_user_alarm_cancel(bulk->tick);
+    }
+    s_zcl_bulk = NULL;
+    free(bulk);
+
+    return true;
+}
+
+static void esp_ncp_zb_zcl_bulk_tick_cb(void *param)
+{
+    esp_ncp_zb_zcl_bulk_t *bulk = (esp_ncp_zb_zcl_bulk_t *)param;
+    TickType_t now = xTaskGetTickCount();
+
+    bulk->tick = ESP_ZB_USER_CB_HANDLE_INVALID;
+    for (int i = 0; i < bulk->next; i ++) {
+        esp_ncp_zb_zcl_bulk_dev_t *dev = &bulk->dev[i];
+
+        if (dev->state != ESP_NCP_ZB_ZCL_BULK_INFLIGHT || (int32_t)(now - dev->deadline) < 0) {
+            continue;
+        }
+
+        if (dev->retries) {
+            dev->retries --;
+            esp_ncp_zb_zcl_bulk_issue(bulk, dev);
+        } else {
+            esp_ncp_zb_zcl_bulk_complete(bulk, dev, ESP_ZB_ZCL_STATUS_TIMEOUT, 0, NULL);
+        }
+    }
+
+    if (!esp_ncp_zb_zcl_bulk_pump(bulk)) {
+        bulk->tick = esp_zb_scheduler_user_alarm(esp_ncp_zb_zcl_bulk_tick_cb, bulk, ESP_NCP_ZB_ZCL_BULK_TICK_MS);
+    }
+}
+
+static void esp_ncp_zb_zcl_bulk_start_cb(void *param)
+{
+    esp_ncp_zb_zcl_bulk_t *bulk = (esp_ncp_zb_zcl_bulk_t *)param;
+
+    if (!esp_ncp_zb_zcl_bulk_pump(bulk)) {
+        bulk->tick = esp_zb_scheduler_user_alarm(esp_ncp_zb_zcl_bulk_tick_cb, bulk, ESP_NCP_ZB_ZCL_BULK_TICK_MS);
+    }
+}
+
+static bool esp_ncp_zb_zcl_bulk_handle(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    esp_ncp_zb_zcl_bulk_t *bulk = s_zcl_bulk;
+    const esp_zb_zcl_cmd_info_t *info = (const esp_zb_zcl_cmd_info_t *)message;
+
+    if (!bulk || !message || info->cluster != bulk->cluster_id) {
+        return false;
+    }
+
+    if (callback_id != ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID && callback_id != ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID
+        && callback_id != ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID) {
+        return false;
+    }
+
+    for (int i = 0; i < bulk->next; i ++) {
+        esp_ncp_zb_zcl_bulk_dev_t *dev = &bulk->dev[i];
+
+        if (dev->state != ESP_NCP_ZB_ZCL_BULK_INFLIGHT || dev->tsn != info->header.tsn || dev->addr != info->src_address.u.short_addr) {
+            continue;
+        }
+
+        if (callback_id == ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID) {
+            const esp_zb_zcl_cmd_default_resp_message_t *resp = (const esp_zb_zcl_cmd_default_resp_message_t *)message;
+            esp_ncp_zb_zcl_bulk_complete(bulk, dev, resp->status_code, callback_id, NULL);
+        } else {
+            esp_ncp_zb_zcl_bulk_complete(bulk, dev, info->status, callback_id, message);
+        }
+        esp_ncp_zb_zcl_bulk_pump(bulk);
+        return true;
+    }
+
+    return false;
+}
+
+/* Allocates the bulk request with the device list, followed by cmd_size bytes for the shared ZCL command.
+ * Returns NULL when a bulk request is already in progress or there is no memory.
+ */
+static esp_ncp_zb_zcl_bulk_t *esp_ncp_zb_zcl_bulk_create(uint16_t id, uint16_t cluster_id, const uint8_t *addr_field, uint16_t count,
+                                                         uint8_t concurrency, uint8_t retries, uint16_t timeout_ms, uint16_t cmd_size)
+{
+    esp_ncp_zb_zcl_bulk_t *bulk = NULL;
+
+    if (s_zcl_bulk) {
+        ESP_LOGW(TAG, "Bulk request(0x%04hx) already in progress", s_zcl_bulk->id);
+        return NULL;
+    }
+
+    bulk = calloc(1, sizeof(esp_ncp_zb_zcl_bulk_t) + count * sizeof(esp_ncp_zb_zcl_bulk_dev_t) + cmd_size);
+    if (bulk) {
+        bulk->id = id;
+        bulk->sn = s_request_header.sn;
+        bulk->cluster_id = cluster_id;
+        bulk->concurrency = concurrency ? concurrency : ESP_NCP_ZB_ZCL_BULK_CONCURRENCY;
+        bulk->timeout_ms = timeout_ms ? timeout_ms : ESP_NCP_ZB_ZCL_BULK_TIMEOUT_MS;
+        bulk->count = count;
+        bulk->tick = ESP_ZB_USER_CB_HANDLE_INVALID;
+        bulk->chunk_len = 2;
+        bulk->cmd = &bulk->dev[count];
+
+        for (int i = 0; i < count; i ++) {
+            memcpy(&bulk->dev[i].addr, &addr_field[i * sizeof(uint16_t)], sizeof(uint16_t));
+            bulk->dev[i].retries = retries;
+        }
+    }
+
+    return bulk;
+}
+
+static void esp_ncp_zb_zcl_bulk_start(esp_ncp_zb_zcl_bulk_t *bulk)
+{
+    s_zcl_bulk = bulk;
+    esp_zb_scheduler_user_alarm(esp_ncp_zb_zcl_bulk_start_cb, bulk, 0);
+}
+
+static esp_err_t esp_ncp_zb_default_resp_handler(const esp_zb_zcl_cmd_default_resp_message_t *message, uint8_t **output, uint16_t *outlen)
+{
+    ESP_RETURN_ON_FALSE(message, ESP_FAIL, TAG, "Empty message");
+    ESP_LOGD(TAG, "Default response: status(0x%x), cluster(0x%x), command(0x%x)", message->status_code, message->info.cluster, message->resp_to_cmd);
+
+    uint16_t data_head_len = sizeof(esp_zb_zcl_cmd_info_t);
+    uint16_t length = data_head_len + sizeof(uint8_t) + sizeof(uint8_t);
+    uint8_t *outbuf = calloc(1, length);
+
+    if (outbuf) {
+        memcpy(outbuf, &message->info, data_head_len);
+        outbuf[data_head_len] = message->resp_to_cmd;
+        outbuf[data_head_len + 1] = message->status_code;
+    }
+
+    *output = outbuf;
+    *outlen = length;
+
+    return ESP_OK;
+}
+
+static esp_err_t esp_ncp_zb_action_handler(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ncp_header_t ncp_header = { 
+        .sn = esp_random() % 0xFF,
+    };
+    const esp_zb_zcl_cmd_info_t *info = message ? (const esp_zb_zcl_cmd_info_t *)message : NULL;
+    uint8_t *output = NULL;
+    uint16_t outlen = 0;
+
+    if (esp_ncp_zb_zcl_bulk_handle(callback_id, message) || esp_ncp_zb_groupcast_handle(callback_id, message)) {
+        return ESP_OK;
+    }
+
+    switch (callback_id) {
+        case ESP_ZB_CORE_CMD_READ_ATTR_RESP_CB_ID:
+            ncp_header.id = ESP_NCP_ZCL_ATTR_READ;
+            ret = esp_ncp_zb_read_attr_resp_handler((esp_zb_zcl_cmd_read_attr_resp_message_t *)message, &output, &outlen);
             break;
-        case ESP_ZB_BDB_SIGNAL_FINDING_AND_BINDING_TARGET_FINISHED:
-        case ESP_ZB_BDB_SIGNAL_FINDING_AND_BINDING_INITIATOR_FINISHED:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_TARGET:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_TARGET_FINISHED:
-        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_ADD_DEVICE_TO_NWK:
-        case ESP_ZB_NWK_SIGNAL_DEVICE_ASSOCIATED:
-        case ESP_ZB_ZDO_SIGNAL_LEAVE_INDICATION:
-        case ESP_ZB_BDB_SIGNAL_WWAH_REJOIN_STARTED:
-        case ESP_ZB_ZGP_SIGNAL_COMMISSIONING:
-        case ESP_ZB_COMMON_SIGNAL_CAN_SLEEP:
-        case ESP_ZB_ZDO_SIGNAL_PRODUCTION_CONFIG_READY:
-        case ESP_ZB_NWK_SIGNAL_NO_ACTIVE_LINKS_LEFT:
-        case ESP_ZB_SE_SIGNAL_SKIP_JOIN:
-        case ESP_ZB_SE_SIGNAL_REJOIN:
-        case ESP_ZB_SE_SIGNAL_CHILD_REJOIN:
-        case ESP_ZB_SE_TC_SIGNAL_CHILD_JOIN_CBKE:
-        case ESP_ZB_SE_TC_SIGNAL_CHILD_JOIN_NON_CBKE:
-        case ESP_ZB_SE_SIGNAL_CBKE_FAILED:
-        case ESP_ZB_SE_SIGNAL_CBKE_OK:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_START:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_DO_BIND:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_OK:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_FAILED:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_INDICATION:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_OK:
-        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_FAILED:
-        case ESP_ZB_SE_SIGNAL_APS_KEY_READY:
-        case ESP_ZB_SE_SIGNAL_APS_KEY_FAIL:
-        case ESP_ZB_SIGNAL_SUBGHZ_SUSPEND:
-        case ESP_ZB_SIGNAL_SUBGHZ_RESUME:
-        case ESP_ZB_MACSPLIT_DEVICE_BOOT:
-        case ESP_ZB_MACSPLIT_DEVICE_READY_FOR_UPGRADE:
-        case ESP_ZB_MACSPLIT_DEVICE_FW_UPGRADE_EVENT:
-        case ESP_ZB_SIGNAL_NWK_INIT_DONE:
-        case ESP_ZB_ZDO_SIGNAL_DEVICE_AUTHORIZED:
-        case ESP_ZB_ZDO_SIGNAL_DEVICE_UPDATE:
-        case ESP_ZB_NWK_SIGNAL_PANID_CONFLICT_DETECTED:
-        case ESP_ZB_NLME_STATUS_INDICATION:
-        case ESP_ZB_TCSWAP_DB_BACKUP_REQUIRED_SIGNAL:
-        case ESP_ZB_TC_SWAPPED_SIGNAL:
-        case ESP_ZB_BDB_SIGNAL_TC_REJOIN_DONE:
+        case ESP_ZB_CORE_CMD_WRITE_ATTR_RESP_CB_ID:
+            ncp_header.id = ESP_NCP_ZCL_ATTR_WRITE;
+            ret = esp_ncp_zb_write_attr_resp_handler((esp_zb_zcl_cmd_write_attr_resp_message_t *)message, &output, &outlen);
             break;
-        case ESP_ZB_NWK_SIGNAL_PERMIT_JOIN_STATUS:
-            if (err_status == ESP_OK) {
-                uint8_t *parameters = esp_zb_app_signal_get_params(p_sg_p);
-                if (*parameters) {
-                    ESP_LOGI(TAG, "Network(0x%04hx) is open for %d seconds", esp_zb_get_pan_id(), *parameters);
-                } else {
-                    ESP_LOGW(TAG, "Network(0x%04hx) closed, devices joining not allowed.", esp_zb_get_pan_id());
-                }
-                ncp_header.id = ESP_NCP_NETWORK_PERMIT_JOINING;
-                esp_ncp_noti_input(&ncp_header, parameters, sizeof(uint8_t));
+        case ESP_ZB_CORE_CMD_REPORT_CONFIG_RESP_CB_ID:
+            ncp_header.id = ESP_NCP_ZCL_REPORT_CONFIG;
+            ret = esp_ncp_zb_report_configure_resp_handler((esp_zb_zcl_cmd_config_report_resp_message_t *)message, &output, &outlen);
+            break;
+        case ESP_ZB_CORE_CMD_DISC_ATTR_RESP_CB_ID:
+            ncp_header.id = ESP_NCP_ZCL_ATTR_DISC;
+            ret = esp_ncp_zb_disc_attr_resp_handler((esp_zb_zcl_cmd_discover_attributes_resp_message_t *)message, &output, &outlen);
+            break;
+        case ESP_ZB_CORE_CMD_DEFAULT_RESP_CB_ID:
+            /* Only the default responses to a request of the host are forwarded, under the frame ID of that request */
+            if (info && esp_ncp_zb_zcl_inflight_take(info, &ncp_header)) {
+                ret = esp_ncp_zb_default_resp_handler((esp_zb_zcl_cmd_default_resp_message_t *)message, &output, &outlen);
             }
+            info = NULL;
             break;
-        case ESP_ZB_BDB_SIGNAL_STEERING_CANCELLED:
-        case ESP_ZB_BDB_SIGNAL_FORMATION_CANCELLED:
-        case ESP_ZB_SIGNAL_READY_TO_SHUT:
-        case ESP_ZB_SIGNAL_INTERPAN_PREINIT:
-        case ESP_ZB_ZGP_SIGNAL_MODE_CHANGE:
-        case ESP_ZB_ZDO_DEVICE_UNAVAILABLE:
-        case ESP_ZB_ZGP_SIGNAL_APPROVE_COMMISSIONING:
-        case ESP_ZB_SIGNAL_END:
+        case ESP_ZB_CORE_REPORT_ATTR_CB_ID:
+            esp_ncp_zb_rule_report((esp_zb_zcl_report_attr_message_t *)message);
+            ncp_header.id = ESP_NCP_ZCL_ATTR_REPORT;
+            ret = esp_ncp_zb_report_attr_handler((esp_zb_zcl_report_attr_message_t *)message, &output, &outlen);
+            info = NULL;
             break;
         default:
-            ESP_LOGI(TAG, "ZDO signal: %s (0x%x), status: %s", esp_zb_zdo_signal_to_string(sig_type), sig_type, esp_err_to_name(err_status));
+            ESP_LOGW(TAG, "Receive Zigbee action(0x%x) callback", callback_id);
+            info = NULL;
             break;
     }
+
+    /* Responses to a request sent by the host carry the sn and frame ID of that request */
+    if (output && info) {
+        esp_ncp_zb_zcl_inflight_take(info, &ncp_header);
+    }
+
+    if (output) {
+        esp_ncp_noti_input(&ncp_header, output, outlen);
+        free(output);
+        output = NULL;
+    }
+
+    return ret;
 }
 
+esp_err_t esp_ncp_zb_action(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    return esp_ncp_zb_action_handler(callback_id, message);
+}
 
-static esp_err_t esp_ncp_zb_network_init_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static void esp_ncp_zb_task(void *pvParameters)
 {
-    esp_err_t ret = ESP_OK;
-    esp_ncp_status_t status = ESP_NCP_ERR_FATAL;
+    esp_zb_core_action_handler_register(esp_ncp_zb_action_handler);
+    esp_zb_stack_main_loop();
+    vTaskDelete(NULL);
+}
 
-    if (!s_init_flag) {
-        esp_zb_platform_config_t config = {
-            .radio_config = {
-                .radio_mode = ZB_RADIO_MODE_NATIVE,
-            },
-            .host_config = {
-                .host_connection_mode = ZB_HOST_CONNECTION_MODE_NONE,
+/* The parameter size of every signal, the stack does not pass it along with the parameters */
+static uint16_t esp_ncp_zb_signal_params_len(esp_zb_app_signal_type_t sig_type)
+{
+    switch (sig_type) {
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_ANNCE:
+            return sizeof(esp_zb_zdo_signal_device_annce_params_t);
+        case ESP_ZB_ZDO_SIGNAL_LEAVE:
+            return sizeof(esp_zb_zdo_signal_leave_params_t);
+        case ESP_ZB_ZDO_SIGNAL_LEAVE_INDICATION:
+            return sizeof(esp_zb_zdo_signal_leave_indication_params_t);
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_UPDATE:
+            return sizeof(esp_zb_zdo_signal_device_update_params_t);
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_AUTHORIZED:
+            return sizeof(esp_zb_zdo_signal_device_authorized_params_t);
+        case ESP_ZB_MACSPLIT_DEVICE_BOOT:
+            return sizeof(esp_zb_zdo_signal_macsplit_dev_boot_params_t);
+        case ESP_ZB_NWK_SIGNAL_DEVICE_ASSOCIATED:
+            return sizeof(esp_zb_ieee_addr_t);                      /* The long address of the associated device */
+        case ESP_ZB_ZDO_DEVICE_UNAVAILABLE:
+            return sizeof(esp_zb_ieee_addr_t) + sizeof(uint16_t);   /* The long and short address of the device */
+        case ESP_ZB_NLME_STATUS_INDICATION:
+            return sizeof(esp_zb_zdo_signal_nwk_status_indication_params_t);
+        case ESP_ZB_NWK_SIGNAL_PANID_CONFLICT_DETECTED:
+            return sizeof(esp_zb_nwk_signal_panid_conflict_detected_params_t);
+        case ESP_ZB_NWK_SIGNAL_PERMIT_JOIN_STATUS:
+            return sizeof(uint8_t);                                 /* The permit join duration */
+        default:
+            return 0;
+    }
+}
+
+static void esp_ncp_zb_signal_notify(esp_zb_app_signal_type_t sig_type, esp_err_t err_status, uint32_t *p_sg_p)
+{
+    typedef struct {
+        uint16_t    signal;                         /*!< The signal type, refer to esp_zb_app_signal_type_t */
+        int32_t     status;                         /*!< The status of the signal, refer to esp_err_t */
+        uint16_t    len;                            /*!< The length of the raw parameters following the signal */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_signal_t;
+
+    esp_ncp_header_t ncp_header = {
+        .sn = esp_random() % 0xFF,
+        .id = ESP_NCP_NETWORK_SIGNAL,
+    };
+    void *params = esp_zb_app_signal_get_params(p_sg_p);
+    uint16_t len = params ? esp_ncp_zb_signal_params_len(sig_type) : 0;
+    uint16_t outlen = sizeof(esp_ncp_zb_signal_t) + len;
+    uint8_t *output = calloc(1, outlen);
+
+    if (output) {
+        esp_ncp_zb_signal_t *signal = (esp_ncp_zb_signal_t *)output;
+        signal->signal = sig_type;
+        signal->status = err_status;
+        signal->len = len;
+        if (len) {
+            memcpy(output + sizeof(esp_ncp_zb_signal_t), params, len);
+        }
+        esp_ncp_noti_input(&ncp_header, output, outlen);
+        free(output);
+    }
+}
+
+void esp_zb_app_signal_handler(esp_zb_app_signal_t *signal_struct)
+{
+    uint32_t *p_sg_p       = signal_struct->p_app_signal;
+    esp_err_t err_status = signal_struct->esp_err_status;
+    esp_zb_app_signal_type_t sig_type = *p_sg_p;
+    esp_zb_zdo_signal_device_annce_params_t *dev_annce_params = NULL;
+    esp_zb_zdo_signal_leave_indication_params_t *dev_leave_params = NULL;
+    esp_ncp_header_t ncp_header = { 
+        .sn = esp_random() % 0xFF,
+    };
+
+    if (sig_type < 64 && (s_signal_mask & (1ULL << sig_type))) {
+        esp_ncp_zb_signal_notify(sig_type, err_status, p_sg_p);
+    }
+
+    switch (sig_type) {
+        case ESP_ZB_ZDO_SIGNAL_DEFAULT_START:
+            break;
+        case ESP_ZB_ZDO_SIGNAL_SKIP_STARTUP:
+            ESP_LOGI(TAG, "Initialize Zigbee stack");
+            esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_INITIALIZATION);
+            break;
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_ANNCE:
+            dev_annce_params = (esp_zb_zdo_signal_device_annce_params_t *)esp_zb_app_signal_get_params(p_sg_p);
+            ESP_LOGI(TAG, "New device commissioned or rejoined (short: 0x%04hx)", dev_annce_params->device_short_addr);
+            if (!esp_ncp_zb_join_device_annce(dev_annce_params)) {
+                ncp_header.id = ESP_NCP_NETWORK_JOINNETWORK;
+                esp_ncp_noti_input(&ncp_header, dev_annce_params, sizeof(esp_zb_zdo_signal_device_annce_params_t));
+            }
+            esp_ncp_zb_interrogate_device_annce(dev_annce_params->device_short_addr);
+            break;
+        case ESP_ZB_ZDO_SIGNAL_LEAVE:
+            dev_leave_params = (esp_zb_zdo_signal_leave_indication_params_t *)esp_zb_app_signal_get_params(p_sg_p);
+            ESP_LOGI(TAG, "Leave Indication parameters (short: 0x%04hx)", dev_leave_params->short_addr);
+            ncp_header.id = ESP_NCP_NETWORK_LEAVENETWORK;
+            esp_ncp_noti_input(&ncp_header, dev_leave_params, sizeof(esp_zb_zdo_signal_leave_indication_params_t));
+            break;
+        case ESP_ZB_ZDO_SIGNAL_ERROR:
+            break;
+        case ESP_ZB_BDB_SIGNAL_DEVICE_FIRST_START:
+        case ESP_ZB_BDB_SIGNAL_DEVICE_REBOOT:
+            if (err_status == ESP_OK) {
+                ESP_LOGI(TAG, "Start network formation");
+                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_NETWORK_FORMATION);
+            } else {
+                ESP_LOGW(TAG, "%s failed with status: %s, retrying", esp_zb_zdo_signal_to_string(sig_type),
+                         esp_err_to_name(err_status));
+                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_INITIALIZATION);
+            }
+            break;
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK_STARTED:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK_JOINED_ROUTER:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK:
+            break;
+        case ESP_ZB_BDB_SIGNAL_STEERING:
+            if (err_status == ESP_OK) {
+                ESP_LOGI(TAG, "Network steering started");
+            }
+            break;
+        case ESP_ZB_BDB_SIGNAL_FORMATION:
+            if (err_status == ESP_OK) {
+                esp_zb_bdb_start_top_level_commissioning(ESP_ZB_BDB_MODE_NETWORK_STEERING);
+
+                typedef struct {
+                    esp_zb_ieee_addr_t  extendedPanId;                      /*!< The network's extended PAN identifier */
+                    uint16_t            panId;                              /*!< The network's PAN identifier */
+                    uint8_t             radioChannel;                       /*!< A radio channel */
+                } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_formnetwork_parameters_t;
+
+                esp_ncp_zb_formnetwork_parameters_t parameters = { 
+                    .panId = esp_zb_get_pan_id(),
+                    .radioChannel = esp_zb_get_current_channel(),
+                };
+                esp_zb_get_extended_pan_id(parameters.extendedPanId);
+
+                ESP_LOGI(TAG, "Formed network successfully (Extended PAN ID: %02x:%02x:%02x:%02x:%02x:%02x:%02x:%02x, PAN ID: 0x%04hx, Channel:%d)",
+                        parameters.extendedPanId[7], parameters.extendedPanId[6], parameters.extendedPanId[5], parameters.extendedPanId[4],
+                        parameters.extendedPanId[3], parameters.extendedPanId[2], parameters.extendedPanId[1], parameters.extendedPanId[0],
+                        parameters.panId, parameters.radioChannel);
+                ncp_header.id = ESP_NCP_NETWORK_FORMNETWORK;
+                esp_ncp_noti_input(&ncp_header, &parameters, sizeof(esp_ncp_zb_formnetwork_parameters_t));
+            } else {
+                ESP_LOGI(TAG, "Restart network formation (status: %s)", esp_err_to_name(err_status));
+                esp_zb_scheduler_alarm((esp_zb_callback_t)esp_ncp_zb_bdb_start_top_level_commissioning_cb, ESP_ZB_BDB_MODE_NETWORK_FORMATION, 1000);
+            }
+            break;
+        case ESP_ZB_BDB_SIGNAL_FINDING_AND_BINDING_TARGET_FINISHED:
+        case ESP_ZB_BDB_SIGNAL_FINDING_AND_BINDING_INITIATOR_FINISHED:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_TARGET:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_NWK:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_TARGET_FINISHED:
+        case ESP_ZB_BDB_SIGNAL_TOUCHLINK_ADD_DEVICE_TO_NWK:
+        case ESP_ZB_NWK_SIGNAL_DEVICE_ASSOCIATED:
+            break;
+        case ESP_ZB_ZDO_SIGNAL_LEAVE_INDICATION:
+            esp_ncp_zb_join_leave((esp_zb_zdo_signal_leave_indication_params_t *)esp_zb_app_signal_get_params(p_sg_p));
+            break;
+        case ESP_ZB_BDB_SIGNAL_WWAH_REJOIN_STARTED:
+        case ESP_ZB_ZGP_SIGNAL_COMMISSIONING:
+        case ESP_ZB_COMMON_SIGNAL_CAN_SLEEP:
+        case ESP_ZB_ZDO_SIGNAL_PRODUCTION_CONFIG_READY:
+        case ESP_ZB_NWK_SIGNAL_NO_ACTIVE_LINKS_LEFT:
+        case ESP_ZB_SE_SIGNAL_SKIP_JOIN:
+        case ESP_ZB_SE_SIGNAL_REJOIN:
+        case ESP_ZB_SE_SIGNAL_CHILD_REJOIN:
+        case ESP_ZB_SE_TC_SIGNAL_CHILD_JOIN_CBKE:
+        case ESP_ZB_SE_TC_SIGNAL_CHILD_JOIN_NON_CBKE:
+        case ESP_ZB_SE_SIGNAL_CBKE_FAILED:
+        case ESP_ZB_SE_SIGNAL_CBKE_OK:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_START:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_DO_BIND:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_OK:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_FAILED:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_BIND_INDICATION:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_OK:
+        case ESP_ZB_SE_SIGNAL_SERVICE_DISCOVERY_FAILED:
+        case ESP_ZB_SE_SIGNAL_APS_KEY_READY:
+        case ESP_ZB_SE_SIGNAL_APS_KEY_FAIL:
+        case ESP_ZB_SIGNAL_SUBGHZ_SUSPEND:
+        case ESP_ZB_SIGNAL_SUBGHZ_RESUME:
+        case ESP_ZB_MACSPLIT_DEVICE_BOOT:
+        case ESP_ZB_MACSPLIT_DEVICE_READY_FOR_UPGRADE:
+        case ESP_ZB_MACSPLIT_DEVICE_FW_UPGRADE_EVENT:
+        case ESP_ZB_SIGNAL_NWK_INIT_DONE:
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_AUTHORIZED:
+        case ESP_ZB_ZDO_SIGNAL_DEVICE_UPDATE:
+        case ESP_ZB_NWK_SIGNAL_PANID_CONFLICT_DETECTED:
+        case ESP_ZB_NLME_STATUS_INDICATION:
+        case ESP_ZB_TCSWAP_DB_BACKUP_REQUIRED_SIGNAL:
+        case ESP_ZB_TC_SWAPPED_SIGNAL:
+        case ESP_ZB_BDB_SIGNAL_TC_REJOIN_DONE:
+            break;
+        case ESP_ZB_NWK_SIGNAL_PERMIT_JOIN_STATUS:
+            if (err_status == ESP_OK) {
+                uint8_t *parameters = esp_zb_app_signal_get_params(p_sg_p);
+                if (*parameters) {
+                    ESP_LOGI(TAG, "Network(0x%04hx) is open for %d seconds", esp_zb_get_pan_id(), *parameters);
+                } else {
+                    ESP_LOGW(TAG, "Network(0x%04hx) closed, devices joining not allowed.", esp_zb_get_pan_id());
+                }
+                ncp_header.id = ESP_NCP_NETWORK_PERMIT_JOINING;
+                esp_ncp_noti_input(&ncp_header, parameters, sizeof(uint8_t));
+            }
+            break;
+        case ESP_ZB_BDB_SIGNAL_STEERING_CANCELLED:
+        case ESP_ZB_BDB_SIGNAL_FORMATION_CANCELLED:
+        case ESP_ZB_SIGNAL_READY_TO_SHUT:
+        case ESP_ZB_SIGNAL_INTERPAN_PREINIT:
+        case ESP_ZB_ZGP_SIGNAL_MODE_CHANGE:
+        case ESP_ZB_ZDO_DEVICE_UNAVAILABLE:
+        case ESP_ZB_ZGP_SIGNAL_APPROVE_COMMISSIONING:
+        case ESP_ZB_SIGNAL_END:
+            break;
+        default:
+            ESP_LOGI(TAG, "ZDO signal: %s (0x%x), status: %s", esp_zb_zdo_signal_to_string(sig_type), sig_type, esp_err_to_name(err_status));
+            break;
+    }
+}
+
+
+static esp_err_t esp_ncp_zb_network_init_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = ESP_OK;
+    esp_ncp_status_t status = ESP_NCP_ERR_FATAL;
+
+    if (!s_init_flag) {
+        esp_zb_platform_config_t config = {
+            .radio_config = {
+                .radio_mode = ZB_RADIO_MODE_NATIVE,
+            },
+            .host_config = {
+                .host_connection_mode = ZB_HOST_CONNECTION_MODE_NONE,
+            }
+        };
+
+        ret = esp_zb_platform_config(&config);
+        if (ret == ESP_OK) {
+            s_init_flag = true;
+            status = ESP_NCP_SUCCESS;
+        }
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_network_primary_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? esp_zb_set_primary_network_channel_set(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    s_primary_channel = input ? (*(uint32_t *)input) : s_primary_channel;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_network_secondary_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? esp_zb_set_secondary_network_channel_set(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? esp_zb_set_channel_mask(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_tx_power_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    
+    if (input) {
+        esp_zb_set_tx_power(*input);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_extended_pan_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (input) {
+        esp_zb_set_extended_pan_id(input);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_extended_pan_id_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(esp_zb_ieee_addr_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        esp_zb_get_extended_pan_id(*output);
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_pan_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (input) {
+        esp_zb_set_pan_id(*(uint16_t *)input);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_pan_id_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint16_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        uint16_t pan_id = esp_zb_get_pan_id();
+        memcpy(*output, &pan_id, *outlen);
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_form_network_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (input) {
+        esp_zb_init((esp_zb_cfg_t *)input);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_start_scan_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    typedef struct {
+        uint32_t    channel_mask;                   /*!< The channels to scan */
+        uint8_t     scan_duration;                  /*!< The scan duration of every channel */
+        uint8_t     streaming;                      /*!< Optional, stream the networks of every channel as ESP_NCP_NETWORK_SCAN_RESULT */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_start_scan_t;
+
+    esp_err_t ret = (input && inlen >= sizeof(uint32_t) + sizeof(uint8_t)) ? ESP_OK : ESP_ERR_INVALID_ARG;
+
+    if (ret == ESP_OK) {
+        esp_ncp_zb_start_scan_t *scan = (esp_ncp_zb_start_scan_t *)input;
+        bool streaming = (inlen >= sizeof(esp_ncp_zb_start_scan_t)) && scan->streaming;
+
+        /* The streamed scan walks the mask bit by bit, only the channels 11 to 26 exist */
+        if (!scan->channel_mask || (scan->channel_mask & ~ESP_ZB_TRANSCEIVER_ALL_CHANNELS_MASK)) {
+            ret = ESP_ERR_INVALID_ARG;
+        } else if (s_scan.streaming) {
+            ret = ESP_ERR_INVALID_STATE;
+        } else if (streaming) {
+            s_scan.streaming = true;
+            s_scan.sn = s_request_header.sn;
+            s_scan.duration = scan->scan_duration;
+            s_scan.channel_mask = scan->channel_mask;
+            esp_ncp_zb_scan_next_channel();
+        } else {
+            esp_zb_zdo_active_scan_request(scan->channel_mask, scan->scan_duration, esp_ncp_zb_zdo_scan_complete_handler);
+        }
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_scan_complete_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    return ESP_OK;
+}
+
+static esp_err_t esp_ncp_zb_stop_scan_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = ESP_OK;
+
+    /* The channel scanned at the moment completes, then the summary record is sent.
+     * Without a streamed scan there is nothing to stop, the request succeeds as it always did */
+    if (s_scan.streaming) {
+        s_scan.stop = true;
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_start_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? esp_zb_start(*(bool *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (!s_start_flag && esp_ncp_zb_mailbox_init() == ESP_OK) {
+        s_start_flag = true;
+        xTaskCreate(esp_ncp_zb_task, "esp_ncp_zb_task", 4096, NULL, 5, NULL);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_set_bind_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (input) {
+        uint32_t *bind_req = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
+        if (bind_req) {
+            memcpy(bind_req, input + (inlen - sizeof(esp_ncp_zb_user_cb_t)), sizeof(esp_ncp_zb_user_cb_t));
+        }
+        esp_zb_zdo_device_bind_req((esp_zb_zdo_bind_req_param_t *)input, esp_ncp_zb_bind_cb, (void *)bind_req);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_set_unbind_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    if (input) {
+        uint32_t *bind_req = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
+        if (bind_req) {
+            memcpy(bind_req, input + (inlen - sizeof(esp_ncp_zb_user_cb_t)), sizeof(esp_ncp_zb_user_cb_t));
+        }
+        esp_zb_zdo_device_unbind_req((esp_zb_zdo_bind_req_param_t *)input, esp_ncp_zb_unbind_cb, (void *)bind_req);
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_network_state_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint8_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        *(*output) = ESP_NCP_CONNECTED;
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_stack_status_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_ncp_zb_cluster_fn_t cluster_list_fn_table[] = {
+    { ESP_ZB_ZCL_CLUSTER_ID_BASIC                      , esp_zb_cluster_list_add_basic_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_POWER_CONFIG               , esp_zb_cluster_list_add_power_config_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_DEVICE_TEMP_CONFIG         , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_IDENTIFY                   , esp_zb_cluster_list_add_identify_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_GROUPS                     , esp_zb_cluster_list_add_groups_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_SCENES                     , esp_zb_cluster_list_add_scenes_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ON_OFF                     , esp_zb_cluster_list_add_on_off_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ON_OFF_SWITCH_CONFIG       , esp_zb_cluster_list_add_on_off_switch_config_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL              , esp_zb_cluster_list_add_level_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ALARMS                     , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_TIME                       , esp_zb_cluster_list_add_time_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_RSSI_LOCATION              , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_INPUT               , esp_zb_cluster_list_add_analog_input_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_OUTPUT              , esp_zb_cluster_list_add_analog_output_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_VALUE               , esp_zb_cluster_list_add_analog_value_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_INPUT               , esp_zb_cluster_list_add_binary_input_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_OUTPUT              , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_VALUE               , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_INPUT                , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_OUTPUT               , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_VALUE                , esp_zb_cluster_list_add_multistate_value_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_COMMISSIONING              , esp_zb_cluster_list_add_touchlink_commissioning_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_OTA_UPGRADE                , esp_zb_cluster_list_add_ota_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_POLL_CONTROL               , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_GREEN_POWER                , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_KEEP_ALIVE                 , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_SHADE_CONFIG               , esp_zb_cluster_list_add_shade_config_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_DOOR_LOCK                  , esp_zb_cluster_list_add_door_lock_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_WINDOW_COVERING            , esp_zb_cluster_list_add_window_covering_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_PUMP_CONFIG_CONTROL        , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_THERMOSTAT                 , esp_zb_cluster_list_add_thermostat_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_FAN_CONTROL                , esp_zb_cluster_list_add_fan_control_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_DEHUMIDIFICATION_CONTROL   , esp_zb_cluster_list_add_dehumidification_control_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_THERMOSTAT_UI_CONFIG       , esp_zb_cluster_list_add_thermostat_ui_config_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_COLOR_CONTROL              , esp_zb_cluster_list_add_color_control_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_BALLAST_CONFIG             , esp_zb_cluster_list_add_custom_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ILLUMINANCE_MEASUREMENT    , esp_zb_cluster_list_add_illuminance_meas_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT           , esp_zb_cluster_list_add_temperature_meas_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_PRESSURE_MEASUREMENT       , esp_zb_cluster_list_add_pressure_meas_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_REL_HUMIDITY_MEASUREMENT   , esp_zb_cluster_list_add_humidity_meas_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_OCCUPANCY_SENSING          , esp_zb_cluster_list_add_occupancy_sensing_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_CARBON_DIOXIDE_MEASUREMENT , esp_zb_cluster_list_add_carbon_dioxide_measurement_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_PM2_5_MEASUREMENT          , esp_zb_cluster_list_add_pm2_5_measurement_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_IAS_ZONE                   , esp_zb_cluster_list_add_ias_zone_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_ELECTRICAL_MEASUREMENT     , esp_zb_cluster_list_add_electrical_meas_cluster , NULL },
+    { ESP_ZB_ZCL_CLUSTER_ID_METERING                   , esp_zb_cluster_list_add_metering_cluster , NULL },
+};
+
+static esp_err_t esp_ncp_zb_add_endpoint_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    uint16_t data_head_len = sizeof(esp_ncp_zb_endpoint_t);
+    esp_ncp_zb_endpoint_t *ncp_endpoint = (esp_ncp_zb_endpoint_t *)input;
+    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_LOGI(TAG, "endpoint %0x, profileId %02x, deviceId %02x, appFlags %0x, inputClusterCount %0x, outputClusterCount %0x", 
+                    ncp_endpoint->endpoint, ncp_endpoint->profileId, ncp_endpoint->deviceId,
+                    ncp_endpoint->appFlags, ncp_endpoint->inputClusterCount, ncp_endpoint->outputClusterCount);
+
+    if (inlen < data_head_len) {
+        ret = ESP_FAIL;
+    }
+
+    if (s_start_flag && (ncp_endpoint->inputClusterCount || ncp_endpoint->outputClusterCount)) {
+        uint16_t inputClusterLength = ncp_endpoint->inputClusterCount * sizeof(uint16_t);
+        uint16_t outputClusterLength = ncp_endpoint->outputClusterCount * sizeof(uint16_t);
+        uint16_t *inputClusterList = inputClusterLength ? calloc(1, inputClusterLength) : NULL;
+        uint16_t *outputClusterList = outputClusterLength ? calloc(1, outputClusterLength) : NULL;
+
+        esp_zb_cluster_list_t *esp_zb_cluster_list = esp_zb_zcl_cluster_list_create();
+
+        if (inputClusterList) {
+            memcpy(inputClusterList, input + data_head_len, inputClusterLength);
+        }
+
+        if (outputClusterList) {
+            memcpy(outputClusterList, input + data_head_len + inputClusterLength, outputClusterLength);
+        }
+
+        for (int i = 0; i < ncp_endpoint->inputClusterCount; i ++) {
+            esp_zb_attribute_list_t *esp_zb_cluster = esp_zb_zcl_attr_list_create(inputClusterList[i]);
+            ESP_LOGI(TAG, "inputClusterList %02x", inputClusterList[i]);
+            for (int j = 0; j < sizeof(cluster_list_fn_table) / sizeof(cluster_list_fn_table[0]); j ++) {
+                if (inputClusterList[i] == cluster_list_fn_table[j].cluster_id) {
+                    cluster_list_fn_table[j].add_cluster_fn(esp_zb_cluster_list, esp_zb_cluster, ESP_ZB_ZCL_CLUSTER_SERVER_ROLE);
+                    break;
+                }
+            }
+        }
+
+        for (int i = 0; i < ncp_endpoint->outputClusterCount; i ++) {
+            esp_zb_attribute_list_t *esp_zb_cluster = esp_zb_zcl_attr_list_create(outputClusterList[i]);
+            ESP_LOGI(TAG, "outputClusterList %02x", outputClusterList[i]);
+            for (int j = 0; j < sizeof(cluster_list_fn_table) / sizeof(cluster_list_fn_table[0]); j ++) {
+                if (outputClusterList[i] == cluster_list_fn_table[j].cluster_id) {
+                    cluster_list_fn_table[j].add_cluster_fn(esp_zb_cluster_list, esp_zb_cluster, ESP_ZB_ZCL_CLUSTER_CLIENT_ROLE);
+                    break;
+                }
+            }
+        }
+
+        esp_zb_ep_list_t *esp_zb_ep_list = esp_zb_ep_list_create();
+        esp_zb_endpoint_config_t endpoint_config = {
+            .endpoint = ncp_endpoint->endpoint,
+            .app_profile_id = ncp_endpoint->profileId,
+            .app_device_id = ncp_endpoint->deviceId,
+            .app_device_version = 0
+        };
+        esp_zb_ep_list_add_ep(esp_zb_ep_list, esp_zb_cluster_list, endpoint_config);
+        esp_zb_device_register(esp_zb_ep_list);
+
+        if (inputClusterList) {
+            free(inputClusterList);
+            inputClusterList = NULL;
+        }
+
+        if (outputClusterList) {
+            free(outputClusterList);
+            outputClusterList = NULL;
+        }
+    }
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_del_endpoint_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    return ESP_OK;
+}
+
+/* The destination of a decoded payload, the long address only in the 64-bit addressing mode */
+static void esp_ncp_zb_wire_addr(const esp_ncp_wire_addr_t *wire, uint8_t address_mode, esp_zb_addr_u *addr)
+{
+    if (address_mode == ESP_ZB_APS_ADDR_MODE_64_ENDP_PRESENT) {
+        memcpy(addr->addr_long, wire->bytes, sizeof(esp_zb_ieee_addr_t));
+    } else {
+        addr->addr_short = esp_ncp_wire_addr_short(wire);
+    }
+}
+
+static esp_zb_zcl_basic_cmd_t esp_ncp_zb_wire_basic_cmd(const esp_ncp_wire_zcl_basic_cmd_t *wire, uint8_t address_mode)
+{
+    esp_zb_zcl_basic_cmd_t zcl_basic_cmd = {
+        .dst_endpoint = wire->dst_endpoint,
+        .src_endpoint = wire->src_endpoint,
+    };
+
+    esp_ncp_zb_wire_addr(&wire->dst_addr, address_mode, &zcl_basic_cmd.dst_addr_u);
+
+    return zcl_basic_cmd;
+}
+
+static esp_err_t esp_ncp_zb_read_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_ncp_wire_zcl_attr_read_t zb_read_attr;
+    esp_err_t ret = esp_ncp_wire_zcl_attr_read_decode(input, inlen, &zb_read_attr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    uint8_t tsn = 0;
+
+    if (ret == ESP_OK) {
+        uint16_t *attr_field = calloc(1, zb_read_attr.attr_number * sizeof(uint16_t));
+
+        ESP_LOGI(TAG, "Read attr addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, cluster_id %02x",
+                        esp_ncp_wire_addr_short(&zb_read_attr.zcl_basic_cmd.dst_addr), zb_read_attr.zcl_basic_cmd.dst_endpoint,
+                        zb_read_attr.zcl_basic_cmd.src_endpoint, zb_read_attr.address_mode, zb_read_attr.cluster_id);
+
+        if (attr_field) {
+            for (uint8_t i = 0; i < zb_read_attr.attr_number; i ++) {
+                attr_field[i] = esp_ncp_wire_get_u16(zb_read_attr.attr_field, i);
+            }
+
+            esp_zb_zcl_read_attr_cmd_t read_req = {
+                .zcl_basic_cmd = esp_ncp_zb_wire_basic_cmd(&zb_read_attr.zcl_basic_cmd, zb_read_attr.address_mode),
+                .address_mode = zb_read_attr.address_mode,
+                .clusterID = zb_read_attr.cluster_id,
+                .attr_number = zb_read_attr.attr_number,
+                .attr_field = attr_field,
+            };
+            
+            tsn = esp_zb_zcl_read_attr_cmd_req(&read_req);
+            esp_ncp_zb_zcl_inflight_add(read_req.address_mode, read_req.zcl_basic_cmd.dst_addr_u.addr_short, read_req.clusterID, tsn);
+            free(attr_field);
+        } else {
+            ret = ESP_ERR_NO_MEM;
+            status = ESP_NCP_ERR_FATAL;
+        }
+    }
+
+    ESP_NCP_ZB_STATUS_TSN();
+
+    return ret;
+}
+
+static uint8_t esp_ncp_zb_report_config_bulk_issue(void *cmd, uint16_t addr)
+{
+    esp_zb_zcl_config_report_cmd_t *report_cmd = (esp_zb_zcl_config_report_cmd_t *)cmd;
+
+    report_cmd->zcl_basic_cmd.dst_addr_u.addr_short = addr;
+
+    return esp_zb_zcl_config_report_cmd_req(report_cmd);
+}
+
+static esp_err_t esp_ncp_zb_report_config_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_ncp_wire_zcl_report_config_t report_config;
+    esp_err_t ret = esp_ncp_wire_zcl_report_config_decode(input, inlen, &report_config) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_zb_zcl_bulk_t *bulk = NULL;
+    uint8_t *cmd_buf = NULL;
+    uint8_t tsn = 0;
+
+    if (ret == ESP_OK) {
+        uint16_t cmd_size = sizeof(esp_zb_zcl_config_report_cmd_t)
+                            + report_config.record_number * (sizeof(esp_zb_zcl_config_report_record_t) + ESP_NCP_ZB_ZCL_REPORT_CHANGE_SIZE);
+
+        if (!report_config.record_number || report_config.record_number > ESP_NCP_ZB_ZCL_BULK_MAX_ATTR
+            || report_config.dev_number > ESP_NCP_ZB_ZCL_BULK_MAX_DEV) {
+            ret = ESP_ERR_INVALID_SIZE;
+        } else if (report_config.dev_number) {
+            bulk = esp_ncp_zb_zcl_bulk_create(ESP_NCP_ZCL_REPORT_CONFIG, report_config.cluster_id, report_config.dev_field, report_config.dev_number,
+                                              report_config.concurrency, report_config.retries, report_config.timeout_ms, cmd_size);
+            ret = bulk ? ESP_OK : (s_zcl_bulk ? ESP_ERR_INVALID_STATE : ESP_ERR_NO_MEM);
+            cmd_buf = bulk ? bulk->cmd : NULL;
+        } else {
+            cmd_buf = calloc(1, cmd_size);
+            ret = cmd_buf ? ESP_OK : ESP_ERR_NO_MEM;
+        }
+
+        if (cmd_buf) {
+            esp_zb_zcl_config_report_cmd_t *report_cmd = (esp_zb_zcl_config_report_cmd_t *)cmd_buf;
+            esp_zb_zcl_config_report_record_t *record_field = (esp_zb_zcl_config_report_record_t *)(cmd_buf + sizeof(esp_zb_zcl_config_report_cmd_t));
+            uint8_t *change_field = (uint8_t *)&record_field[report_config.record_number];
+            esp_ncp_wire_zcl_report_record_t record;
+            size_t offset = 0;
+
+            report_cmd->zcl_basic_cmd = esp_ncp_zb_wire_basic_cmd(&report_config.zcl_basic_cmd, report_config.address_mode);
+            report_cmd->address_mode = report_config.address_mode;
+            report_cmd->clusterID = report_config.cluster_id;
+            report_cmd->record_number = report_config.record_number;
+            report_cmd->record_field = record_field;
+
+            for (int i = 0; i < report_config.record_number
+                            && esp_ncp_wire_zcl_report_record_next(report_config.record_field, report_config.record_field_len, &offset, &record); i ++) {
+                /* The change is kept in the little endian layout of the attribute value */
+                for (int j = 0; j < ESP_NCP_ZB_ZCL_REPORT_CHANGE_SIZE; j ++) {
+                    change_field[i * ESP_NCP_ZB_ZCL_REPORT_CHANGE_SIZE + j] = (uint8_t)(record.reportable_change >> (8 * j));
+                }
+                record_field[i].direction = ESP_ZB_ZCL_REPORT_DIRECTION_SEND;
+                record_field[i].attributeID = record.attr_id;
+                record_field[i].attrType = record.attr_type;
+                record_field[i].min_interval = record.min_interval;
+                record_field[i].max_interval = record.max_interval;
+                record_field[i].reportable_change = &change_field[i * ESP_NCP_ZB_ZCL_REPORT_CHANGE_SIZE];
+            }
+
+            ESP_LOGD(TAG, "Configure report: cluster_id %02x, records %d, devices %d", report_config.cluster_id,
+                            report_config.record_number, report_config.dev_number);
+
+            if (bulk) {
+                bulk->issue = esp_ncp_zb_report_config_bulk_issue;
+                bulk->frame_len = report_config.record_field_len;
+                report_cmd->address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
+                esp_ncp_zb_zcl_bulk_start(bulk);
+            } else {
+                /* The request was held back by the air-time scheduler before the handler ran, see esp_ncp_zb_request_sched_class() */
+                tsn = esp_zb_zcl_config_report_cmd_req(report_cmd);
+                esp_ncp_zb_zcl_inflight_add(report_cmd->address_mode, report_cmd->zcl_basic_cmd.dst_addr_u.addr_short, report_cmd->clusterID, tsn);
+                free(cmd_buf);
+            }
+        }
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS_TSN();
+
+    return ret;
+}
+
+static uint8_t esp_ncp_zb_read_attr_bulk_issue(void *cmd, uint16_t addr)
+{
+    esp_zb_zcl_read_attr_cmd_t *read_cmd = (esp_zb_zcl_read_attr_cmd_t *)cmd;
+
+    read_cmd->zcl_basic_cmd.dst_addr_u.addr_short = addr;
+
+    return esp_zb_zcl_read_attr_cmd_req(read_cmd);
+}
+
+static esp_err_t esp_ncp_zb_read_attr_bulk_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_ncp_wire_zcl_attr_read_bulk_t bulk_req;
+    esp_err_t ret = esp_ncp_wire_zcl_attr_read_bulk_decode(input, inlen, &bulk_req) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_zb_zcl_bulk_t *bulk = NULL;
+
+    if (ret == ESP_OK) {
+        uint16_t attr_len = bulk_req.attr_number * sizeof(uint16_t);
+
+        if (!bulk_req.attr_number || bulk_req.attr_number > ESP_NCP_ZB_ZCL_BULK_MAX_ATTR
+            || !bulk_req.dev_number || bulk_req.dev_number > ESP_NCP_ZB_ZCL_BULK_MAX_DEV) {
+            ret = ESP_ERR_INVALID_SIZE;
+        } else {
+            bulk = esp_ncp_zb_zcl_bulk_create(ESP_NCP_ZCL_ATTR_READ_BULK, bulk_req.cluster_id, bulk_req.dev_field, bulk_req.dev_number,
+                                              bulk_req.concurrency, bulk_req.retries, bulk_req.timeout_ms,
+                                              sizeof(esp_zb_zcl_read_attr_cmd_t) + attr_len);
+            ret = bulk ? ESP_OK : (s_zcl_bulk ? ESP_ERR_INVALID_STATE : ESP_ERR_NO_MEM);
+        }
+
+        if (bulk) {
+            esp_zb_zcl_read_attr_cmd_t *read_cmd = (esp_zb_zcl_read_attr_cmd_t *)bulk->cmd;
+
+            read_cmd->zcl_basic_cmd.src_endpoint = bulk_req.src_endpoint;
+            read_cmd->zcl_basic_cmd.dst_endpoint = bulk_req.dst_endpoint;
+            read_cmd->address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
+            read_cmd->clusterID = bulk_req.cluster_id;
+            read_cmd->attr_number = bulk_req.attr_number;
+            read_cmd->attr_field = (uint16_t *)((uint8_t *)bulk->cmd + sizeof(esp_zb_zcl_read_attr_cmd_t));
+            for (uint8_t i = 0; i < bulk_req.attr_number; i ++) {
+                read_cmd->attr_field[i] = esp_ncp_wire_get_u16(bulk_req.attr_field, i);
             }
-        };
 
-        ret = esp_zb_platform_config(&config);
-        if (ret == ESP_OK) {
-            s_init_flag = true;
-            status = ESP_NCP_SUCCESS;
+            ESP_LOGD(TAG, "Bulk attribute read: cluster_id %02x, attributes %d, devices %d, concurrency %d",
+                            bulk_req.cluster_id, bulk_req.attr_number, bulk->count, bulk->concurrency);
+
+            bulk->issue = esp_ncp_zb_read_attr_bulk_issue;
+            bulk->frame_len = attr_len;
+            esp_ncp_zb_zcl_bulk_start(bulk);
         }
     }
 
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_network_primary_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_sched_config_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? esp_zb_set_primary_network_channel_set(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_ncp_wire_zcl_sched_config_t config_req;
+    esp_err_t ret = esp_ncp_wire_zcl_sched_config_decode(input, inlen, &config_req) ? ESP_OK : ESP_ERR_INVALID_ARG;
 
-    s_primary_channel = input ? (*(uint32_t *)input) : s_primary_channel;
+    if (ret == ESP_OK) {
+        esp_ncp_zb_sched_config_t config = {
+            .enable = config_req.enable,
+            .rate = config_req.rate,
+            .burst = config_req.burst,
+            .dst_gap_ms = config_req.dst_gap_ms,
+            .hop_gap_ms = config_req.hop_gap_ms,
+        };
+
+        ret = esp_ncp_zb_sched_config(&config);
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_network_secondary_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_sched_stats_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? esp_zb_set_secondary_network_channel_set(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint16_t    queued[ESP_NCP_ZB_SCHED_CLASS_MAX]; /*!< The number of frames queued in every class */
+        uint16_t    max_queued;                     /*!< The highest number of frames queued at once */
+        uint16_t    tokens;                         /*!< The bytes left in the token bucket */
+        uint32_t    sent;                           /*!< The number of frames handed to the stack */
+        uint32_t    deferred;                       /*!< The number of frames which waited for tokens or pacing */
+        uint32_t    dropped;                        /*!< The number of frames dropped because a queue was full */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_sched_stats_resp_t;
 
-    ESP_NCP_ZB_STATUS();
+    esp_ncp_zb_sched_stats_t stats;
+    esp_ncp_zb_sched_stats_resp_t *resp = NULL;
 
-    return ret;
+    esp_ncp_zb_sched_stats_get(&stats, input && inlen && input[0]);
+
+    *outlen = sizeof(esp_ncp_zb_sched_stats_resp_t);
+    *output = calloc(1, *outlen);
+    if (*output) {
+        resp = (esp_ncp_zb_sched_stats_resp_t *)*output;
+        resp->status = ESP_NCP_SUCCESS;
+        memcpy(resp->queued, stats.queued, sizeof(resp->queued));
+        resp->max_queued = stats.max_queued;
+        resp->tokens = stats.tokens;
+        resp->sent = stats.sent;
+        resp->deferred = stats.deferred;
+        resp->dropped = stats.dropped;
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_channel_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_write_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? esp_zb_set_channel_mask(*(uint32_t *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_zcl_attr_write_t zb_write_attr;
+    esp_err_t ret = esp_ncp_wire_zcl_attr_write_decode(input, inlen, &zb_write_attr) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    uint8_t tsn = 0;
 
-    ESP_NCP_ZB_STATUS();
+    if (ret == ESP_OK) {
+        esp_zb_zcl_attribute_t *attr_field = zb_write_attr.attr_number ? calloc(1, (zb_write_attr.attr_number * sizeof(esp_zb_zcl_attribute_t))) : NULL;
+        esp_ncp_wire_zcl_attr_data_t attr_data;
+        size_t offset = 0;
+
+        ESP_LOGI(TAG, "Write attr addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, cluster_id %02x",
+                        esp_ncp_wire_addr_short(&zb_write_attr.zcl_basic_cmd.dst_addr), zb_write_attr.zcl_basic_cmd.dst_endpoint,
+                        zb_write_attr.zcl_basic_cmd.src_endpoint, zb_write_attr.address_mode, zb_write_attr.cluster_id);
+
+        if (attr_field) {
+            /* The decode checked all the records are whole */
+            for (int i = 0; i < zb_write_attr.attr_number && esp_ncp_wire_zcl_attr_data_next(zb_write_attr.attr_field, zb_write_attr.attr_field_len, &offset, &attr_data); i ++) {
+                ESP_LOGI(TAG, "attributeId %0x, dataType %02x, dataLength %0x", attr_data.id, attr_data.type, attr_data.size);
+
+                attr_field[i].id = attr_data.id;
+                attr_field[i].data.type = attr_data.type;
+                attr_field[i].data.size = attr_data.size;
+                attr_field[i].data.value = calloc(1, attr_data.size);
+                if (attr_field[i].data.value) {
+                    memcpy(attr_field[i].data.value, attr_data.value, attr_data.size);
+                } else {
+                    ret = ESP_ERR_NO_MEM;
+                    status = ESP_NCP_ERR_FATAL;
+                    break;
+                }
+            }
+
+            if (ret == ESP_OK) {
+                esp_zb_zcl_write_attr_cmd_t write_req = {
+                    .zcl_basic_cmd = esp_ncp_zb_wire_basic_cmd(&zb_write_attr.zcl_basic_cmd, zb_write_attr.address_mode),
+                    .address_mode = zb_write_attr.address_mode,
+                    .clusterID = zb_write_attr.cluster_id,
+                    .attr_number = zb_write_attr.attr_number,
+                    .attr_field = attr_field,
+                };
+
+                tsn = esp_zb_zcl_write_attr_cmd_req(&write_req);
+                esp_ncp_zb_zcl_inflight_add(write_req.address_mode, write_req.zcl_basic_cmd.dst_addr_u.addr_short, write_req.clusterID, tsn);
+            }
+
+            for (int i = 0; i < zb_write_attr.attr_number; i ++) {
+                if (attr_field[i].data.value) {
+                    free(attr_field[i].data.value);
+                    attr_field[i].data.value = NULL;
+                }
+            }
+            free(attr_field);
+            attr_field = NULL;
+        } else {
+            ret = ESP_ERR_NO_MEM;
+            status = ESP_NCP_ERR_FATAL;
+        }
+    }
+
+    ESP_NCP_ZB_STATUS_TSN();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_tx_power_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_report_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
     esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
-    
+
     if (input) {
-        esp_zb_set_tx_power(*input);
+        esp_zb_zcl_report_attr_cmd_req((esp_zb_zcl_report_attr_cmd_t *)input);
     }
 
     ESP_NCP_ZB_STATUS();
@@ -762,13 +2200,13 @@ static esp_err_t esp_ncp_zb_tx_power_set_fn(const uint8_t *input, uint16_t inlen
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_extended_pan_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_disc_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
     esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     if (input) {
-        esp_zb_set_extended_pan_id(input);
+        esp_zb_zcl_disc_attr_cmd_req((esp_zb_zcl_disc_attr_cmd_t *)input);
     }
 
     ESP_NCP_ZB_STATUS();
@@ -776,148 +2214,386 @@ static esp_err_t esp_ncp_zb_extended_pan_id_set_fn(const uint8_t *input, uint16_
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_extended_pan_id_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_zcl_read_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    return ESP_OK;
+}
+
+static esp_err_t esp_ncp_zb_zcl_write_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_ncp_wire_zcl_write_t zcl_data;
+    esp_err_t ret = esp_ncp_wire_zcl_write_decode(input, inlen, &zcl_data) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    uint8_t *data_value = NULL;
+    uint8_t tsn = 0;
+    
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, profile_id %02x, cluster_id %02x, cmd_id %02x, direction %02x",
+                        esp_ncp_wire_addr_short(&zcl_data.zcl_basic_cmd.dst_addr), zcl_data.zcl_basic_cmd.dst_endpoint, zcl_data.zcl_basic_cmd.src_endpoint, 
+                        zcl_data.address_mode, zcl_data.profile_id, zcl_data.cluster_id, zcl_data.custom_cmd_id, zcl_data.direction);
+
+        esp_zb_zcl_custom_cluster_cmd_t cmd_req = {
+            .zcl_basic_cmd = esp_ncp_zb_wire_basic_cmd(&zcl_data.zcl_basic_cmd, zcl_data.address_mode),
+            .address_mode = zcl_data.address_mode,
+            .profile_id = zcl_data.profile_id,
+            .cluster_id = zcl_data.cluster_id,
+            .custom_cmd_id = zcl_data.custom_cmd_id,
+            .direction = zcl_data.direction,
+            .data = {
+                .type = zcl_data.type,
+                .value = (void *)zcl_data.value,
+            }
+        };
+
+        switch (zcl_data.type) {
+            case ESP_ZB_ZCL_ATTR_TYPE_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_16BIT_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_32BIT_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_STRUCTURE:
+                data_value = calloc(1, 2 + zcl_data.size);
+                if (data_value) {
+                    memcpy(data_value, &zcl_data.size, 2);
+                    memcpy(data_value + 2, zcl_data.value, zcl_data.size);
+                    cmd_req.data.value = data_value;
+                } else {
+                    ret = ESP_ERR_NO_MEM;
+                    status = ESP_NCP_ERR_NO_MEM;
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (ret == ESP_OK) {
+            tsn = esp_zb_zcl_custom_cluster_cmd_req(&cmd_req);
+            esp_ncp_zb_zcl_inflight_add(cmd_req.address_mode, cmd_req.zcl_basic_cmd.dst_addr_u.addr_short, cmd_req.cluster_id, tsn);
+        }
+        if (data_value) {
+            free(data_value);
+            data_value = NULL;
+        }
+    }
+
+    ESP_NCP_ZB_STATUS_TSN();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_zcl_write_multi_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    typedef struct {
+        uint8_t  status;                                        /*!< The status, refer to esp_ncp_status_t */
+        uint16_t group_id;                                      /*!< The group the command was sent to, 0 when no groupcast was sent */
+        uint16_t unicast;                                       /*!< The number of devices which got the command by unicast */
+        uint16_t saved;                                         /*!< The number of frames saved by the groupcast */
+        uint16_t failed;                                        /*!< The number of devices whose command was dropped */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_zcl_multi_resp_t;
+
+    esp_ncp_wire_zcl_write_multi_t zcl_multi;
+    esp_ncp_zb_groupcast_result_t result = { 0 };
+    esp_ncp_zb_zcl_multi_resp_t *resp = NULL;
+    esp_err_t ret = esp_ncp_wire_zcl_write_multi_decode(input, inlen, &zcl_multi) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    uint16_t *dev = NULL;
+    uint8_t *data_value = NULL;
+    uint8_t *sent = NULL;
+    uint16_t bitmap_len = 0;
+
+    if (ret == ESP_OK) {
+        bitmap_len = (zcl_multi.dev_number + 7) / 8;
+        sent = calloc(1, bitmap_len + 1);
+        ret = sent ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+
+    if (ret == ESP_OK) {
+        uint16_t value_len = zcl_multi.size;
+        esp_zb_zcl_custom_cluster_cmd_t cmd_req = {
+            .zcl_basic_cmd = {
+                .src_endpoint = zcl_multi.src_endpoint,
+                .dst_endpoint = zcl_multi.dst_endpoint,
+            },
+            .address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+            .profile_id = zcl_multi.profile_id,
+            .cluster_id = zcl_multi.cluster_id,
+            .custom_cmd_id = zcl_multi.custom_cmd_id,
+            .direction = zcl_multi.direction,
+            .data = {
+                .type = zcl_multi.type,
+                .value = (void *)zcl_multi.value,
+            }
+        };
+
+        switch (zcl_multi.type) {
+            case ESP_ZB_ZCL_ATTR_TYPE_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_16BIT_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_32BIT_ARRAY:
+            case ESP_ZB_ZCL_ATTR_TYPE_STRUCTURE:
+                value_len = 2 + zcl_multi.size;
+                data_value = calloc(1, value_len);
+                if (data_value) {
+                    memcpy(data_value, &zcl_multi.size, 2);
+                    memcpy(data_value + 2, zcl_multi.value, zcl_multi.size);
+                }
+                cmd_req.data.value = data_value;
+                break;
+            default:
+                break;
+        }
+
+        /* The device list is not aligned in the frame */
+        dev = calloc(zcl_multi.dev_number ? zcl_multi.dev_number : 1, sizeof(uint16_t));
+        if (dev && cmd_req.data.value) {
+            for (uint16_t i = 0; i < zcl_multi.dev_number; i ++) {
+                dev[i] = esp_ncp_wire_get_u16(zcl_multi.dev_field, i);
+            }
+            ret = esp_ncp_zb_groupcast_send(&cmd_req, value_len, dev, zcl_multi.dev_number, &result, sent);
+        } else {
+            ret = ESP_ERR_NO_MEM;
+        }
+
+        if (dev) {
+            free(dev);
+            dev = NULL;
+        }
+        if (data_value) {
+            free(data_value);
+            data_value = NULL;
+        }
+    }
+
+    /* The response is followed by a bitmap of the devices in the order of the request, a set bit for every device
+     * which got the command by groupcast or unicast */
+    *outlen = sizeof(esp_ncp_zb_zcl_multi_resp_t) + (sent ? bitmap_len : 0);
+    *output = calloc(1, *outlen);
+    if (*output) {
+        resp = (esp_ncp_zb_zcl_multi_resp_t *)*output;
+        resp->status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM : ESP_NCP_ERR_FATAL;
+        resp->group_id = result.group_id;
+        resp->unicast = result.unicast;
+        resp->saved = result.saved;
+        resp->failed = result.failed;
+        if (sent && bitmap_len) {
+            memcpy(*output + sizeof(esp_ncp_zb_zcl_multi_resp_t), sent, bitmap_len);
+        }
+    }
+    free(sent);
+
+    /* The status travels in the response, the bitmap tells the host which devices got the command even when some did not */
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_groupcast_stats_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint32_t    groupcast;                      /*!< The number of groupcasts sent */
+        uint32_t    unicast;                        /*!< The number of unicasts sent */
+        uint32_t    frames_saved;                   /*!< The number of frames saved */
+        int32_t     bytes_saved;                    /*!< The estimated air-time saved in bytes, the groupcast cost included */
+        uint8_t     sets;                           /*!< The number of device sets tracked */
+        uint8_t     groups;                         /*!< The number of device sets with a group */
+        uint32_t    remove_failed;                  /*!< The number of remove group commands dropped after all retries */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_groupcast_stats_resp_t;
+
+    esp_ncp_zb_groupcast_stats_t stats;
+    esp_ncp_zb_groupcast_stats_resp_t *resp = NULL;
+
+    esp_ncp_zb_groupcast_stats_get(&stats);
+
+    *outlen = sizeof(esp_ncp_zb_groupcast_stats_resp_t);
+    *output = calloc(1, *outlen);
+    if (*output) {
+        resp = (esp_ncp_zb_groupcast_stats_resp_t *)*output;
+        resp->status = ESP_NCP_SUCCESS;
+        resp->groupcast = stats.groupcast;
+        resp->unicast = stats.unicast;
+        resp->frames_saved = stats.frames_saved;
+        resp->bytes_saved = stats.bytes_saved;
+        resp->sets = stats.sets;
+        resp->groups = stats.groups;
+        resp->remove_failed = stats.remove_failed;
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_short_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint16_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        uint16_t short_addr = esp_zb_get_short_address();
+        memcpy(*output, &short_addr, *outlen);
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_long_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
     *outlen = sizeof(esp_zb_ieee_addr_t);
     *output = calloc(1, *outlen);
     
     if (*output) {
-        esp_zb_get_extended_pan_id(*output);
+        esp_zb_get_long_address(*output);
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_pan_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_current_channel_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    *outlen = sizeof(uint8_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        *(*output) = esp_zb_get_current_channel();
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_primary_channel_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint32_t);
+    *output = calloc(1, *outlen);
+    
+    if (*output) {
+        uint32_t primary_channel = s_primary_channel;
+        memcpy(*output, &primary_channel, *outlen);
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_primary_key_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = ESP_OK;
+    *outlen = 16;
+    *output = calloc(1, *outlen);
+
+    if (*output) {
+        ret = esp_zb_secur_primary_network_key_get(*output);
+    } else {
+        ret = ESP_ERR_NO_MEM;
+    }
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_primary_key_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = (input && inlen == 16 ) ? esp_zb_secur_network_key_set((uint8_t *)input) : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (input) {
-        esp_zb_set_pan_id(*(uint16_t *)input);
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
+}
+
+static esp_err_t esp_ncp_zb_nwk_frame_counter_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint32_t);
+    *output = calloc(1, *outlen);
+
+    if (*output) {
+        uint32_t counter = 0x00001388;
+        memcpy(*output, &counter, *outlen);
     }
 
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t esp_ncp_zb_nwk_frame_counter_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = (input && inlen == sizeof(uint32_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_pan_id_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_role_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint16_t);
+    *outlen = sizeof(uint8_t);
     *output = calloc(1, *outlen);
-    
+
     if (*output) {
-        uint16_t pan_id = esp_zb_get_pan_id();
-        memcpy(*output, &pan_id, *outlen);
+        *(*output) = ESP_ZB_DEVICE_TYPE_COORDINATOR;
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_form_network_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_role_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (input) {
-        esp_zb_init((esp_zb_cfg_t *)input);
-    }
-
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_start_scan_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_short_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = ESP_OK;
-    esp_ncp_status_t status = ESP_NCP_ERR_FATAL;
-    
-    void esp_zb_zdo_active_scan_request(uint32_t channel_mask, uint8_t scan_duration, esp_zb_zdo_scan_complete_callback_t user_cb);
-    esp_zb_zdo_active_scan_request(*(uint32_t *)(input), *(uint8_t *)(input + sizeof(uint32_t)), esp_ncp_zb_zdo_scan_complete_handler);
+    esp_err_t ret = (input && inlen == sizeof(uint16_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_scan_complete_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
-{
-    return ESP_OK;
-}
-
-static esp_err_t esp_ncp_zb_stop_scan_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
-{
-    return ESP_OK;
-}
-
-static esp_err_t esp_ncp_zb_start_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_long_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? esp_zb_start(*(bool *)input) : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t) ) ? esp_zb_set_long_address((uint8_t *)input) : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (!s_start_flag) {
-        s_start_flag = true;
-        xTaskCreate(esp_ncp_zb_task, "esp_ncp_zb_task", 4096, NULL, 5, NULL);
-    }
-
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_set_bind_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_update_id_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    *outlen = sizeof(uint8_t);
+    *output = calloc(1, *outlen);
 
-    if (input) {
-        uint32_t *bind_req = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
-        if (bind_req) {
-            memcpy(bind_req, input + (inlen - sizeof(esp_ncp_zb_user_cb_t)), sizeof(esp_ncp_zb_user_cb_t));
-        }
-        esp_zb_zdo_device_bind_req((esp_zb_zdo_bind_req_param_t *)input, esp_ncp_zb_bind_cb, (void *)bind_req);
+    if (*output) {
+        *(*output) = 1;
     }
 
-    ESP_NCP_ZB_STATUS();
-
-    return ret;
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_set_unbind_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_update_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (input) {
-        uint32_t *bind_req = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
-        if (bind_req) {
-            memcpy(bind_req, input + (inlen - sizeof(esp_ncp_zb_user_cb_t)), sizeof(esp_ncp_zb_user_cb_t));
-        }
-        esp_zb_zdo_device_unbind_req((esp_zb_zdo_bind_req_param_t *)input, esp_ncp_zb_unbind_cb, (void *)bind_req);
-    }
-
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_network_state_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_trust_center_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint8_t);
+    *outlen = sizeof(esp_zb_ieee_addr_t);
     *output = calloc(1, *outlen);
-    
+
     if (*output) {
-        *(*output) = ESP_NCP_CONNECTED;
+        esp_zb_ieee_addr_t addr = {0xab, 0x98, 0x09, 0xff, 0xff, 0x2e, 0x21, 0x00};
+        memcpy(*output, addr, *outlen);
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_stack_status_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_trust_center_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -925,428 +2601,349 @@ static esp_err_t esp_ncp_zb_stack_status_fn(const uint8_t *input, uint16_t inlen
     return ret;
 }
 
-static esp_ncp_zb_cluster_fn_t cluster_list_fn_table[] = {
-    { ESP_ZB_ZCL_CLUSTER_ID_BASIC                      , esp_zb_cluster_list_add_basic_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_POWER_CONFIG               , esp_zb_cluster_list_add_power_config_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_DEVICE_TEMP_CONFIG         , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_IDENTIFY                   , esp_zb_cluster_list_add_identify_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_GROUPS                     , esp_zb_cluster_list_add_groups_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_SCENES                     , esp_zb_cluster_list_add_scenes_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ON_OFF                     , esp_zb_cluster_list_add_on_off_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ON_OFF_SWITCH_CONFIG       , esp_zb_cluster_list_add_on_off_switch_config_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_LEVEL_CONTROL              , esp_zb_cluster_list_add_level_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ALARMS                     , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_TIME                       , esp_zb_cluster_list_add_time_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_RSSI_LOCATION              , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_INPUT               , esp_zb_cluster_list_add_analog_input_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_OUTPUT              , esp_zb_cluster_list_add_analog_output_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ANALOG_VALUE               , esp_zb_cluster_list_add_analog_value_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_INPUT               , esp_zb_cluster_list_add_binary_input_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_OUTPUT              , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_BINARY_VALUE               , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_INPUT                , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_OUTPUT               , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_MULTI_VALUE                , esp_zb_cluster_list_add_multistate_value_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_COMMISSIONING              , esp_zb_cluster_list_add_touchlink_commissioning_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_OTA_UPGRADE                , esp_zb_cluster_list_add_ota_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_POLL_CONTROL               , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_GREEN_POWER                , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_KEEP_ALIVE                 , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_SHADE_CONFIG               , esp_zb_cluster_list_add_shade_config_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_DOOR_LOCK                  , esp_zb_cluster_list_add_door_lock_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_WINDOW_COVERING            , esp_zb_cluster_list_add_window_covering_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_PUMP_CONFIG_CONTROL        , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_THERMOSTAT                 , esp_zb_cluster_list_add_thermostat_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_FAN_CONTROL                , esp_zb_cluster_list_add_fan_control_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_DEHUMIDIFICATION_CONTROL   , esp_zb_cluster_list_add_dehumidification_control_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_THERMOSTAT_UI_CONFIG       , esp_zb_cluster_list_add_thermostat_ui_config_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_COLOR_CONTROL              , esp_zb_cluster_list_add_color_control_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_BALLAST_CONFIG             , esp_zb_cluster_list_add_custom_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ILLUMINANCE_MEASUREMENT    , esp_zb_cluster_list_add_illuminance_meas_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_TEMP_MEASUREMENT           , esp_zb_cluster_list_add_temperature_meas_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_PRESSURE_MEASUREMENT       , esp_zb_cluster_list_add_pressure_meas_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_REL_HUMIDITY_MEASUREMENT   , esp_zb_cluster_list_add_humidity_meas_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_OCCUPANCY_SENSING          , esp_zb_cluster_list_add_occupancy_sensing_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_CARBON_DIOXIDE_MEASUREMENT , esp_zb_cluster_list_add_carbon_dioxide_measurement_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_PM2_5_MEASUREMENT          , esp_zb_cluster_list_add_pm2_5_measurement_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_IAS_ZONE                   , esp_zb_cluster_list_add_ias_zone_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_ELECTRICAL_MEASUREMENT     , esp_zb_cluster_list_add_electrical_meas_cluster , NULL },
-    { ESP_ZB_ZCL_CLUSTER_ID_METERING                   , esp_zb_cluster_list_add_metering_cluster , NULL },
-};
-
-static esp_err_t esp_ncp_zb_add_endpoint_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_nwk_link_key_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    uint16_t data_head_len = sizeof(esp_ncp_zb_endpoint_t);
-    esp_ncp_zb_endpoint_t *ncp_endpoint = (esp_ncp_zb_endpoint_t *)input;
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
-
-    ESP_LOGI(TAG, "endpoint %0x, profileId %02x, deviceId %02x, appFlags %0x, inputClusterCount %0x, outputClusterCount %0x", 
-                    ncp_endpoint->endpoint, ncp_endpoint->profileId, ncp_endpoint->deviceId,
-                    ncp_endpoint->appFlags, ncp_endpoint->inputClusterCount, ncp_endpoint->outputClusterCount);
+    *outlen = sizeof(esp_zb_ieee_addr_t) + 16;
+    *output = calloc(1, *outlen);
 
-    if (inlen < data_head_len) {
-        ret = ESP_FAIL;
+    if (*output) {
+        esp_zb_ieee_addr_t addr;
+        uint8_t key[16] = {0x5a, 0x69, 0x67, 0x42, 0x65, 0x65, 0x41, 0x6c, 0x6c, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x30, 0x39};
+        esp_zb_get_long_address(addr);
+        memcpy(*output, addr, sizeof(esp_zb_ieee_addr_t));
+        memcpy((*output) + sizeof(esp_zb_ieee_addr_t), key, 16);
     }
 
-    if (s_start_flag && (ncp_endpoint->inputClusterCount || ncp_endpoint->outputClusterCount)) {
-        uint16_t inputClusterLength = ncp_endpoint->inputClusterCount * sizeof(uint16_t);
-        uint16_t outputClusterLength = ncp_endpoint->outputClusterCount * sizeof(uint16_t);
-        uint16_t *inputClusterList = inputClusterLength ? calloc(1, inputClusterLength) : NULL;
-        uint16_t *outputClusterList = outputClusterLength ? calloc(1, outputClusterLength) : NULL;
-
-        esp_zb_cluster_list_t *esp_zb_cluster_list = esp_zb_zcl_cluster_list_create();
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
 
-        if (inputClusterList) {
-            memcpy(inputClusterList, input + data_head_len, inputClusterLength);
-        }
+static esp_err_t esp_ncp_zb_nwk_link_key_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = (input && inlen == 16 ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-        if (outputClusterList) {
-            memcpy(outputClusterList, input + data_head_len + inputClusterLength, outputClusterLength);
-        }
+    ESP_NCP_ZB_STATUS();
 
-        for (int i = 0; i < ncp_endpoint->inputClusterCount; i ++) {
-            esp_zb_attribute_list_t *esp_zb_cluster = esp_zb_zcl_attr_list_create(inputClusterList[i]);
-            ESP_LOGI(TAG, "inputClusterList %02x", inputClusterList[i]);
-            for (int j = 0; j < sizeof(cluster_list_fn_table) / sizeof(cluster_list_fn_table[0]); j ++) {
-                if (inputClusterList[i] == cluster_list_fn_table[j].cluster_id) {
-                    cluster_list_fn_table[j].add_cluster_fn(esp_zb_cluster_list, esp_zb_cluster, ESP_ZB_ZCL_CLUSTER_SERVER_ROLE);
-                    break;
-                }
-            }
-        }
+    return ret;
+}
 
-        for (int i = 0; i < ncp_endpoint->outputClusterCount; i ++) {
-            esp_zb_attribute_list_t *esp_zb_cluster = esp_zb_zcl_attr_list_create(outputClusterList[i]);
-            ESP_LOGI(TAG, "outputClusterList %02x", outputClusterList[i]);
-            for (int j = 0; j < sizeof(cluster_list_fn_table) / sizeof(cluster_list_fn_table[0]); j ++) {
-                if (outputClusterList[i] == cluster_list_fn_table[j].cluster_id) {
-                    cluster_list_fn_table[j].add_cluster_fn(esp_zb_cluster_list, esp_zb_cluster, ESP_ZB_ZCL_CLUSTER_CLIENT_ROLE);
-                    break;
-                }
-            }
-        }
+static esp_err_t esp_ncp_zb_nwk_security_mode_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    *outlen = sizeof(uint8_t);
+    *output = calloc(1, *outlen);
 
-        esp_zb_ep_list_t *esp_zb_ep_list = esp_zb_ep_list_create();
-        esp_zb_endpoint_config_t endpoint_config = {
-            .endpoint = ncp_endpoint->endpoint,
-            .app_profile_id = ncp_endpoint->profileId,
-            .app_device_id = ncp_endpoint->deviceId,
-            .app_device_version = 0
-        };
-        esp_zb_ep_list_add_ep(esp_zb_ep_list, esp_zb_cluster_list, endpoint_config);
-        esp_zb_device_register(esp_zb_ep_list);
+    if (*output) {
+        *(*output) = ESP_NCP_NO_SECURITY;
+    }
 
-        if (inputClusterList) {
-            free(inputClusterList);
-            inputClusterList = NULL;
-        }
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
 
-        if (outputClusterList) {
-            free(outputClusterList);
-            outputClusterList = NULL;
-        }
-    }
+static esp_err_t esp_ncp_zb_nwk_security_mode_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+{
+    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_del_endpoint_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_use_predefined_nwk_panid_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    return ESP_OK;
+    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
 }
 
-static esp_err_t esp_ncp_zb_read_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_address_short_by_ieee_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    typedef struct {
-        esp_zb_zcl_basic_cmd_t  zcl_basic_cmd;      /*!< Basic command info */
-        uint8_t                 address_mode;       /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
-        uint16_t                cluster_id;         /*!< Cluster ID to read */
-        uint8_t                 attr_number;        /*!< Number of attribute in the attr_field */
-    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_read_attr_t;
-
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t)) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (input) {
-        esp_ncp_zb_read_attr_t *zb_read_attr = (esp_ncp_zb_read_attr_t *)input;
-        uint16_t *attr_field = calloc(1, zb_read_attr->attr_number * sizeof(uint16_t));
-
-        ESP_LOGI(TAG, "Read attr addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, cluster_id %02x",
-                        zb_read_attr->zcl_basic_cmd.dst_addr_u.addr_short, zb_read_attr->zcl_basic_cmd.dst_endpoint, 
-                        zb_read_attr->zcl_basic_cmd.src_endpoint, zb_read_attr->address_mode, zb_read_attr->cluster_id);
+    if (status == ESP_NCP_SUCCESS) {
+        uint16_t shotr_addr = esp_zb_address_short_by_ieee((uint8_t *)input);
 
-        if (attr_field) {
-            memcpy(attr_field, input + sizeof(esp_ncp_zb_read_attr_t), zb_read_attr->attr_number * sizeof(uint16_t));
+        *outlen = sizeof(uint16_t);
+        *output = calloc(1, *outlen);
 
-            esp_zb_zcl_read_attr_cmd_t read_req = {
-                .zcl_basic_cmd = zb_read_attr->zcl_basic_cmd,
-                .address_mode = zb_read_attr->address_mode,
-                .clusterID = zb_read_attr->cluster_id,
-                .attr_number = zb_read_attr->attr_number,
-                .attr_field = attr_field,
-            };
-            
-            esp_zb_zcl_read_attr_cmd_req(&read_req);
-        } else {
-            ret = ESP_ERR_NO_MEM;
-            status = ESP_NCP_ERR_FATAL;
+        if (*output) {
+            memcpy(*output, &shotr_addr, *outlen);
         }
     }
 
-    ESP_NCP_ZB_STATUS();
-
-    return ret;
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_write_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_ieee_address_by_short_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    typedef struct {
-        esp_zb_zcl_basic_cmd_t  zcl_basic_cmd;          /*!< Basic command info */
-        uint8_t                 address_mode;           /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
-        uint16_t                cluster_id;             /*!< Cluster ID to write */
-        uint8_t                 attr_number;            /*!< Number of attribute in the attr_field  */
-    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_write_attr_t;
-
-    typedef struct {
-        uint16_t id;                                    /*!< The identify of attribute */
-        uint8_t  type;                                  /*!< The type of attribute, which can refer to esp_zb_zcl_attr_type_t */
-        uint8_t  size;                                  /*!< The value size of attribute  */
-    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_attr_data_t;
-
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = (input && inlen == sizeof(uint16_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
-    if (input) {
-        esp_ncp_zb_write_attr_t *zb_write_attr = (esp_ncp_zb_write_attr_t *)input;
-        esp_zb_zcl_attribute_t *attr_field = zb_write_attr->attr_number ? calloc(1, (zb_write_attr->attr_number * sizeof(esp_zb_zcl_attribute_t))) : NULL;
-        esp_ncp_zb_attr_data_t *attr_data = NULL;
-        uint8_t data_head_len = sizeof(esp_ncp_zb_write_attr_t);
-        uint8_t attr_head_len = sizeof(esp_ncp_zb_attr_data_t);
-        uint16_t length = data_head_len;
+    if (status == ESP_NCP_SUCCESS) {
+        uint16_t shotr_addr = 0;
+        esp_zb_ieee_addr_t ieee_addr;
+        memcpy(&shotr_addr, input, inlen);
 
-        ESP_LOGI(TAG, "Write attr addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, cluster_id %02x",
-                        zb_write_attr->zcl_basic_cmd.dst_addr_u.addr_short, zb_write_attr->zcl_basic_cmd.dst_endpoint, 
-                        zb_write_attr->zcl_basic_cmd.src_endpoint, zb_write_attr->address_mode, zb_write_attr->cluster_id);
-        
-        if (attr_field) {
-            for (int i = 0; i < zb_write_attr->attr_number; i ++) {
-                attr_data = (esp_ncp_zb_attr_data_t *)(input + length);
+        esp_zb_ieee_address_by_short(shotr_addr, ieee_addr);
 
-                ESP_LOGI(TAG, "attributeId %0x, dataType %02x, dataLength %0x", attr_data->id, attr_data->type, attr_data->size);
+        *outlen = sizeof(esp_zb_ieee_addr_t);
+        *output = calloc(1, *outlen);
 
-                attr_field[i].id = attr_data->id;
-                attr_field[i].data.type = attr_data->type;
-                attr_field[i].data.size = attr_data->size;
-                attr_field[i].data.value = calloc(1, attr_data->size);
-                if (attr_field[i].data.value) {
-                    memcpy(attr_field[i].data.value, attr_data + attr_head_len, attr_data->size);
-                } else {
-                    ret = ESP_ERR_NO_MEM;
-                    status = ESP_NCP_ERR_FATAL;
-                    break;
-                }
+        if (*output) {
+            memcpy(*output, ieee_addr, *outlen);
+        }
+    }
 
-                length += (attr_head_len + attr_data->size);
-            }
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+}
 
-            if (ret == ESP_OK) {
-                esp_zb_zcl_write_attr_cmd_t write_req = {
-                    .zcl_basic_cmd = zb_write_attr->zcl_basic_cmd,
-                    .address_mode = zb_write_attr->address_mode,
-                    .clusterID = zb_write_attr->cluster_id,
-                    .attr_number = zb_write_attr->attr_number,
-                    .attr_field = attr_field,
-                };
+typedef struct {
+    esp_zb_ieee_addr_t  ieee_addr;              /*!< Long address (EUI64) of the device */
+    uint16_t            short_addr;             /*!< Short address (network address) of the device */
+    uint8_t             device_type;            /*!< Neighbor device type, refer to esp_zb_nwk_device_type_t */
+    uint8_t             relationship;           /*!< The relationship between the neighbour and current device, refer to esp_zb_nwk_relationship_t */
+    uint8_t             rx_on_when_idle;        /*!< Indicates if neighbour receiver enabled during idle periods */
+    uint8_t             depth;                  /*!< The network depth of this device */
+    uint8_t             lqi;                    /*!< Link quality */
+    int8_t              rssi;                   /*!< Received signal strength indicator */
+    uint8_t             outgoing_cost;          /*!< The cost of an outgoing link */
+    uint8_t             age;                    /*!< The number of nwkLinkStatusPeriod intervals since a link status command was received */
+    uint32_t            device_timeout;         /*!< Configured end device timeout, in seconds */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_nwk_neighbor_record_t;
 
-                esp_zb_zcl_write_attr_cmd_req(&write_req);
-            }
+typedef struct {
+    uint16_t            dest_addr;              /*!< 16-bit network address of the destination */
+    uint16_t            next_hop_addr;          /*!< 16-bit network address of the next hop */
+    uint8_t             flags;                  /*!< Flags in the routing table entry, the status is in bit 0 - 2 */
+    uint8_t             expiry;                 /*!< Expiration time */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_nwk_route_record_t;
 
-            for (int i = 0; i < zb_write_attr->attr_number; i ++) {
-                if (attr_field[i].data.value) {
-                    free(attr_field[i].data.value);
-                    attr_field[i].data.value = NULL;
-                }
-            }
-            free(attr_field);
-            attr_field = NULL;
-        } else {
-            ret = ESP_ERR_NO_MEM;
-            status = ESP_NCP_ERR_FATAL;
-        }
-    }
+typedef struct {
+    uint16_t            dest_address;           /*!< Destination network address of this route record */
+    uint8_t             relay_count;            /*!< The count of relay nodes from concentrator to the destination */
+    uint16_t            path[ESP_ZB_NWK_MAX_SOURCE_ROUTE]; /*!< The relay nodes from the concentrator to the destination */
+    uint8_t             expiry;                 /*!< Expiration time */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_nwk_source_route_record_t;
 
-    ESP_NCP_ZB_STATUS();
+typedef struct {
+    uint32_t            digest;                 /*!< The CRC of the topology fields at the last export */
+    uint32_t            generation;             /*!< Increased every time the topology fields change */
+} esp_ncp_zb_nwk_table_t;
 
-    return ret;
-}
+static esp_ncp_zb_nwk_table_t s_nwk_table[ESP_NCP_ZB_NWK_TABLE_MAX];
 
-static esp_err_t esp_ncp_zb_report_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+/* Reads the next entry of the table into record, only the leading topology_len bytes of the record take part in the digest */
+static esp_err_t esp_ncp_zb_nwk_table_next(uint8_t table, esp_zb_nwk_info_iterator_t *iterator, uint8_t *record, uint16_t *topology_len)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
 
-    if (input) {
-        esp_zb_zcl_report_attr_cmd_req((esp_zb_zcl_report_attr_cmd_t *)input);
-    }
+    if (table == ESP_NCP_ZB_NWK_TABLE_NEIGHBOR) {
+        esp_zb_nwk_neighbor_info_t info;
+        esp_ncp_zb_nwk_neighbor_record_t *neighbor = (esp_ncp_zb_nwk_neighbor_record_t *)record;
 
-    ESP_NCP_ZB_STATUS();
+        ret = esp_zb_nwk_get_next_neighbor(iterator, &info);
+        if (ret == ESP_OK) {
+            memcpy(neighbor->ieee_addr, info.ieee_addr, sizeof(esp_zb_ieee_addr_t));
+            neighbor->short_addr = info.short_addr;
+            neighbor->device_type = info.device_type;
+            neighbor->relationship = info.relationship;
+            neighbor->rx_on_when_idle = info.rx_on_when_idle;
+            neighbor->depth = info.depth;
+            neighbor->lqi = info.lqi;
+            neighbor->rssi = info.rssi;
+            neighbor->outgoing_cost = info.outgoing_cost;
+            neighbor->age = info.age;
+            neighbor->device_timeout = info.device_timeout;
+            *topology_len = offsetof(esp_ncp_zb_nwk_neighbor_record_t, lqi);
+        }
+    } else if (table == ESP_NCP_ZB_NWK_TABLE_ROUTE) {
+        esp_zb_nwk_route_info_t info;
+        esp_ncp_zb_nwk_route_record_t *route = (esp_ncp_zb_nwk_route_record_t *)record;
+
+        ret = esp_zb_nwk_get_next_route(iterator, &info);
+        if (ret == ESP_OK) {
+            route->dest_addr = info.dest_addr;
+            route->next_hop_addr = info.next_hop_addr;
+            memcpy(&route->flags, &info.flags, sizeof(uint8_t));
+            route->expiry = info.expiry;
+            *topology_len = offsetof(esp_ncp_zb_nwk_route_record_t, expiry);
+        }
+    } else if (table == ESP_NCP_ZB_NWK_TABLE_ROUTE_RECORD) {
+        esp_zb_nwk_route_record_info_t info;
+        esp_ncp_zb_nwk_source_route_record_t *route_record = (esp_ncp_zb_nwk_source_route_record_t *)record;
+
+        ret = esp_zb_nwk_get_next_route_record(iterator, &info);
+        if (ret == ESP_OK) {
+            route_record->dest_address = info.dest_address;
+            route_record->relay_count = info.relay_count;
+            memcpy(route_record->path, info.path, sizeof(route_record->path));
+            route_record->expiry = info.expiry;
+            *topology_len = offsetof(esp_ncp_zb_nwk_source_route_record_t, expiry);
+        }
+    }
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_disc_attr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+typedef struct {
+    uint16_t            id;                     /*!< The frame ID of the export request */
+    uint8_t             sn;                     /*!< The sn of the export request */
+    uint16_t            record_len;             /*!< The size of one record */
+    uint16_t            count;                  /*!< The number of records to stream */
+    uint8_t             records[];              /*!< The snapshot of the records */
+} esp_ncp_zb_nwk_table_stream_t;
+
+/* Streams the snapshot once the handler has returned, so that the response goes out before the first chunk */
+static void esp_ncp_zb_nwk_table_stream_cb(void *param)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_ncp_zb_nwk_table_stream_t *stream = (esp_ncp_zb_nwk_table_stream_t *)param;
+    esp_ncp_header_t ncp_header = {
+        .sn = stream->sn,
+        .id = stream->id,
+    };
+    uint16_t per_chunk = (ESP_NCP_ZB_NWK_TABLE_CHUNK_SIZE - 2) / stream->record_len;
+    uint8_t *chunk = calloc(1, 2 + per_chunk * stream->record_len);
 
-    if (input) {
-        esp_zb_zcl_disc_attr_cmd_req((esp_zb_zcl_disc_attr_cmd_t *)input);
+    if (!chunk) {
+        ESP_LOGE(TAG, "Table(0x%04hx) export of %d records lost", stream->id, stream->count);
+        free(stream);
+        return;
     }
 
-    ESP_NCP_ZB_STATUS();
-
-    return ret;
-}
+    for (uint16_t index = 0; index < stream->count; index += per_chunk) {
+        uint16_t number = (stream->count - index) < per_chunk ? (stream->count - index) : per_chunk;
 
-static esp_err_t esp_ncp_zb_zcl_read_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
-{
-    return ESP_OK;
+        /* The chunk starts with the last flag and the number of records */
+        chunk[0] = (index + number) >= stream->count;
+        chunk[1] = number;
+        memcpy(&chunk[2], &stream->records[index * stream->record_len], number * stream->record_len);
+        esp_ncp_noti_input(&ncp_header, chunk, 2 + number * stream->record_len);
+    }
+    free(chunk);
+    free(stream);
 }
 
-static esp_err_t esp_ncp_zb_zcl_write_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+/* Walks one network table and streams its records as notifications reusing the request sn.
+ * The response carries the table generation and the number of records, nothing is streamed
+ * when the host already holds the current generation. The chunks follow the response.
+ */
+static esp_err_t esp_ncp_zb_nwk_table_export(uint8_t table, uint16_t record_len, const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
     typedef struct {
-        esp_zb_zcl_basic_cmd_t zcl_basic_cmd;                   /*!< Basic command info */
-        uint8_t  address_mode;                                  /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
-        uint16_t profile_id;                                    /*!< Profile id */
-        uint16_t cluster_id;                                    /*!< Cluster id */
-        uint16_t custom_cmd_id;                                 /*!< Custom command id */
-        uint8_t  direction;                                     /*!< Direction of command */
-        uint8_t  type;                                          /*!< The type of attribute, which can refer to esp_zb_zcl_attr_type_t */
-        uint16_t size;                                          /*!< The value size of attribute  */
-    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_zcl_data_t;
-
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
-    uint8_t *data_value = NULL;
-    
-    if (input) {
-        esp_ncp_zb_zcl_data_t *zcl_data = (esp_ncp_zb_zcl_data_t *)input;
-        ESP_LOGI(TAG, "addr %02x, dst_endpoint %0x, src_endpoint %0x, address_mode %0x, profile_id %02x, cluster_id %02x, cmd_id %02x, direction %02x",
-                        zcl_data->zcl_basic_cmd.dst_addr_u.addr_short, zcl_data->zcl_basic_cmd.dst_endpoint, zcl_data->zcl_basic_cmd.src_endpoint, 
-                        zcl_data->address_mode, zcl_data->profile_id, zcl_data->cluster_id, zcl_data->custom_cmd_id,  zcl_data->direction);
-
-        esp_zb_zcl_custom_cluster_cmd_t cmd_req = {
-            .zcl_basic_cmd = zcl_data->zcl_basic_cmd,
-            .address_mode = zcl_data->address_mode,
-            .profile_id = zcl_data->profile_id,
-            .cluster_id = zcl_data->cluster_id,
-            .custom_cmd_id = zcl_data->custom_cmd_id,
-            .direction = zcl_data->direction,
-            .data = {
-                .type = zcl_data->type,
-                .value = (void *)(input + sizeof(esp_ncp_zb_zcl_data_t)),
-            }
-        };
+        uint8_t             status;             /*!< The status of the export, refer to esp_ncp_status_t */
+        uint32_t            generation;         /*!< The current generation of the table */
+        uint16_t            count;              /*!< The number of records streamed, 0 when the table is unchanged */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_nwk_table_resp_t;
+
+    esp_err_t ret = (!input || inlen == sizeof(uint32_t)) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_zb_nwk_table_resp_t resp = { 0 };
+    esp_ncp_zb_nwk_table_stream_t *stream = NULL;
+    uint16_t count = 0;
+
+    if (ret == ESP_OK) {
+        esp_zb_nwk_info_iterator_t iterator = ESP_ZB_NWK_INFO_ITERATOR_INIT;
+        uint16_t topology_len = 0;
+        uint32_t digest = 0;
+        uint32_t known = 0;
+
+        if (input) {
+            memcpy(&known, input, sizeof(uint32_t));
+        }
 
-        switch (zcl_data->type) {
-            case ESP_ZB_ZCL_ATTR_TYPE_ARRAY:
-            case ESP_ZB_ZCL_ATTR_TYPE_16BIT_ARRAY:
-            case ESP_ZB_ZCL_ATTR_TYPE_32BIT_ARRAY:
-            case ESP_ZB_ZCL_ATTR_TYPE_STRUCTURE:
-                data_value = calloc(1, 2 + zcl_data->size);
-                memcpy(data_value, &zcl_data->size, 2);
-                memcpy(data_value + 2, input + sizeof(esp_ncp_zb_zcl_data_t), zcl_data->size);
-                cmd_req.data.value = data_value;
+        for (;;) {
+            esp_ncp_zb_nwk_table_stream_t *buffer = realloc(stream, sizeof(esp_ncp_zb_nwk_table_stream_t) + (count + 1) * record_len);
+            if (!buffer) {
+                ret = ESP_ERR_NO_MEM;
                 break;
-            default:
-                cmd_req.data.value = (void *)(input + sizeof(esp_ncp_zb_zcl_data_t));
+            }
+            stream = buffer;
+            if (esp_ncp_zb_nwk_table_next(table, &iterator, &stream->records[count * record_len], &topology_len) != ESP_OK) {
                 break;
+            }
+            digest = esp_crc32_le(digest, &stream->records[count * record_len], topology_len);
+            count ++;
         }
 
-        esp_zb_zcl_custom_cluster_cmd_req(&cmd_req);
-        if (data_value) {
-            free(data_value);
-            data_value = NULL;
+        if (!s_nwk_table[table].generation || digest != s_nwk_table[table].digest) {
+            s_nwk_table[table].digest = digest;
+            s_nwk_table[table].generation ++;
+        }
+        resp.generation = s_nwk_table[table].generation;
+        if (known == resp.generation) {
+            count = 0;
         }
     }
 
-    ESP_NCP_ZB_STATUS();
+    if (ret == ESP_OK && count) {
+        stream->id = s_request_header.id;
+        stream->sn = s_request_header.sn;
+        stream->record_len = record_len;
+        stream->count = count;
+        if (esp_zb_scheduler_user_alarm(esp_ncp_zb_nwk_table_stream_cb, stream, 0) != ESP_ZB_USER_CB_HANDLE_INVALID) {
+            stream = NULL;
+        } else {
+            ret = ESP_FAIL;
+        }
+    }
+    free(stream);
 
-    return ret;
-}
+    resp.status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM
+                  : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
+    if (ret == ESP_OK) {
+        resp.count = count;
+    }
 
-static esp_err_t esp_ncp_zb_short_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
-{
-    *outlen = sizeof(uint16_t);
-    *output = calloc(1, *outlen);
-    
+    *output = calloc(1, sizeof(esp_ncp_zb_nwk_table_resp_t));
     if (*output) {
-        uint16_t short_addr = esp_zb_get_short_address();
-        memcpy(*output, &short_addr, *outlen);
+        *outlen = sizeof(esp_ncp_zb_nwk_table_resp_t);
+        memcpy(*output, &resp, *outlen);
     }
 
+    /* The error travels in the status of the response, the host gets it on the sn of its request */
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_long_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_neighbor_table_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(esp_zb_ieee_addr_t);
-    *output = calloc(1, *outlen);
-    
-    if (*output) {
-        esp_zb_get_long_address(*output);
-    }
-
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    return esp_ncp_zb_nwk_table_export(ESP_NCP_ZB_NWK_TABLE_NEIGHBOR, sizeof(esp_ncp_zb_nwk_neighbor_record_t), input, inlen, output, outlen);
 }
 
-static esp_err_t esp_ncp_zb_current_channel_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_route_table_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint8_t);
-    *output = calloc(1, *outlen);
-    
-    if (*output) {
-        *(*output) = esp_zb_get_current_channel();
-    }
-
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    return esp_ncp_zb_nwk_table_export(ESP_NCP_ZB_NWK_TABLE_ROUTE, sizeof(esp_ncp_zb_nwk_route_record_t), input, inlen, output, outlen);
 }
 
-static esp_err_t esp_ncp_zb_primary_channel_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_route_record_table_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint32_t);
-    *output = calloc(1, *outlen);
-    
-    if (*output) {
-        uint32_t primary_channel = s_primary_channel;
-        memcpy(*output, &primary_channel, *outlen);
-    }
-
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    return esp_ncp_zb_nwk_table_export(ESP_NCP_ZB_NWK_TABLE_ROUTE_RECORD, sizeof(esp_ncp_zb_nwk_source_route_record_t), input, inlen, output, outlen);
 }
 
-static esp_err_t esp_ncp_zb_primary_key_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_signal_subscribe_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = ESP_OK;
-    *outlen = 16;
-    *output = calloc(1, *outlen);
+    esp_ncp_wire_network_signal_subscribe_t subscribe;
+    esp_err_t ret = esp_ncp_wire_network_signal_subscribe_decode(input, inlen, &subscribe) ? ESP_OK : ESP_ERR_INVALID_ARG;
 
-    if (*output) {
-        ret = esp_zb_secur_primary_network_key_get(*output);
-    } else {
-        ret = ESP_ERR_NO_MEM;
+    /* The dedicated notifications, such as ESP_NCP_NETWORK_JOINNETWORK, are sent whatever the mask */
+    if (ret == ESP_OK) {
+        s_signal_mask = subscribe.signal_mask;
     }
 
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_primary_key_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_join_batch_config_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == 16 ) ? esp_zb_secur_network_key_set((uint8_t *)input) : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_network_join_batch_config_t config;
+    esp_err_t ret = esp_ncp_wire_network_join_batch_config_decode(input, inlen, &config) ? esp_ncp_zb_join_config(config.enable, config.max_records, config.flush_ms)
+                                                                                       : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -1354,44 +2951,150 @@ static esp_err_t esp_ncp_zb_primary_key_set_fn(const uint8_t *input, uint16_t in
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_frame_counter_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+/* The install code length of every esp_zb_secur_ic_type_t, the CRC included */
+static const uint8_t s_ic_len[ESP_ZB_IC_TYPE_MAX] = {8, 10, 14, 18};
+
+/* The response of a bulk install code request is followed by a bitmap of the records, a set bit for every record applied.
+ * It is sent whatever the records gave, the error of the request goes in its status. */
+static esp_err_t esp_ncp_zb_ic_bulk_resp(esp_err_t ret, uint16_t count, uint16_t applied, uint8_t *bitmap, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint32_t);
-    *output = calloc(1, *outlen);
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint16_t    count;                          /*!< The number of records in the request */
+        uint16_t    applied;                        /*!< The number of records applied */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_ic_bulk_resp_t;
+
+    uint16_t bitmap_len = (count + 7) / 8;
+    esp_ncp_zb_ic_bulk_resp_t *resp = NULL;
 
+    *outlen = sizeof(esp_ncp_zb_ic_bulk_resp_t) + bitmap_len;
+    *output = calloc(1, *outlen);
     if (*output) {
-        uint32_t counter = 0x00001388;
-        memcpy(*output, &counter, *outlen);
+        resp = (esp_ncp_zb_ic_bulk_resp_t *)*output;
+        resp->status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM
+                       : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
+        resp->count = count;
+        resp->applied = applied;
+        if (bitmap && bitmap_len) {
+            memcpy(*output + sizeof(esp_ncp_zb_ic_bulk_resp_t), bitmap, bitmap_len);
+        }
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_nwk_frame_counter_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_ic_add_bulk_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint32_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    typedef struct {
+        esp_zb_ieee_addr_t  ieee_addr;              /*!< The long address of the device */
+        uint8_t             ic_type;                /*!< The install code type, refer to esp_zb_secur_ic_type_t */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_ic_record_t;
 
-    ESP_NCP_ZB_STATUS();
+    esp_err_t ret = ESP_OK;
+    uint16_t count = 0;
+    uint16_t applied = 0;
+    uint8_t *bitmap = NULL;
+
+    /* Only a frame too short for the record count gets no response of its own */
+    ESP_RETURN_ON_FALSE(input && inlen >= sizeof(uint16_t), ESP_ERR_INVALID_ARG, TAG, "Invalid bulk install code header");
+
+    memcpy(&count, input, sizeof(uint16_t));
+    bitmap = calloc(1, (count + 7) / 8 + 1);
+    ret = bitmap ? ESP_OK : ESP_ERR_NO_MEM;
+
+    /* The records are packed, every install code takes the length of its type. A malformed record stops the parsing,
+     * the records before it stay applied and it and the ones after it are reported as not applied. */
+    for (uint16_t i = 0, offset = sizeof(uint16_t); ret == ESP_OK && i < count; i ++) {
+        const esp_ncp_zb_ic_record_t *record = (const esp_ncp_zb_ic_record_t *)(input + offset);
+        esp_zb_ieee_addr_t ieee_addr;
+
+        if (offset + sizeof(esp_ncp_zb_ic_record_t) > inlen || record->ic_type >= ESP_ZB_IC_TYPE_MAX
+            || offset + sizeof(esp_ncp_zb_ic_record_t) + s_ic_len[record->ic_type] > inlen) {
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+        }
+
+        memcpy(ieee_addr, record->ieee_addr, sizeof(esp_zb_ieee_addr_t));
+        if (esp_zb_secur_ic_add(ieee_addr, record->ic_type, (uint8_t *)(input + offset + sizeof(esp_ncp_zb_ic_record_t))) == ESP_OK) {
+            bitmap[i / 8] |= 1 << (i % 8);
+            applied ++;
+        }
+        offset += sizeof(esp_ncp_zb_ic_record_t) + s_ic_len[record->ic_type];
+    }
+
+    ret = esp_ncp_zb_ic_bulk_resp(ret, count, applied, bitmap, output, outlen);
+    free(bitmap);
 
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_role_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_ic_remove_bulk_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(uint8_t);
-    *output = calloc(1, *outlen);
+    esp_ncp_wire_network_ic_remove_bulk_t remove_req;
+    esp_ncp_wire_ic_remove_record_t record;
+    size_t offset = 0;
+    uint16_t applied = 0;
+    uint8_t *bitmap = NULL;
+    esp_err_t ret = ESP_OK;
 
-    if (*output) {
-        *(*output) = ESP_ZB_DEVICE_TYPE_COORDINATOR;
+    /* The records have a fixed size, a count which does not match the frame is a malformed header */
+    ESP_RETURN_ON_FALSE(esp_ncp_wire_network_ic_remove_bulk_decode(input, inlen, &remove_req), ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid bulk install code header");
+
+    bitmap = calloc(1, (remove_req.count + 7) / 8 + 1);
+    ret = bitmap ? ESP_OK : ESP_ERR_NO_MEM;
+
+    for (uint16_t i = 0; ret == ESP_OK && i < remove_req.count
+                         && esp_ncp_wire_ic_remove_record_next(remove_req.records, remove_req.records_len, &offset, &record); i ++) {
+        esp_zb_ieee_addr_t ieee_addr;
+
+        memcpy(ieee_addr, record.ieee_addr.bytes, sizeof(esp_zb_ieee_addr_t));
+        if (esp_zb_secur_ic_remove_req(ieee_addr) == ESP_OK) {
+            bitmap[i / 8] |= 1 << (i % 8);
+            applied ++;
+        }
     }
 
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    ret = esp_ncp_zb_ic_bulk_resp(ret, remove_req.count, applied, bitmap, output, outlen);
+    free(bitmap);
+
+    return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_role_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_find_match_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_err_t ret = ESP_OK;
+
+    typedef struct {
+        esp_ncp_zb_user_cb_t user_ctx;      /*!< A ZDO match desc request callback */
+        uint16_t dst_nwk_addr;              /*!< NWK address that request sent to */
+        uint16_t addr_of_interest;          /*!< NWK address of interest */
+        uint16_t profile_id;                /*!< Profile ID to be match at the destination which refers to esp_zb_af_profile_id_t */
+        uint8_t num_in_clusters;            /*!< The number of input clusters provided for matching cluster server */
+        uint8_t num_out_clusters;           /*!< The number of output clusters provided for matching cluster client */
+    } __attribute__ ((packed)) esp_zb_zdo_match_desc_t;
+
+    if (input) {
+        esp_zb_zdo_match_desc_t *zdo_data = (esp_zb_zdo_match_desc_t *)input;
+        esp_zb_zdo_match_desc_req_param_t desc_req = {
+            .dst_nwk_addr = zdo_data->dst_nwk_addr,
+            .addr_of_interest = zdo_data->addr_of_interest,
+            .profile_id = zdo_data->profile_id,
+            .num_in_clusters = zdo_data->num_in_clusters,
+            .num_out_clusters = zdo_data->num_out_clusters,
+            .cluster_list = (inlen != sizeof(esp_zb_zdo_match_desc_t)) ? (uint16_t *)(input + sizeof(esp_zb_zdo_match_desc_t)) : NULL,
+        };
+
+        uint32_t *user_ctx = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
+        if (user_ctx) {
+            memcpy(user_ctx, input, sizeof(esp_ncp_zb_user_cb_t));
+        }
+
+        ret = esp_zb_zdo_match_cluster(&desc_req, esp_ncp_zb_find_match_cb, user_ctx);
+    } else {
+        ret = ESP_ERR_INVALID_ARG;
+    }
+
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -1399,9 +3102,15 @@ static esp_err_t esp_ncp_zb_nwk_role_set_fn(const uint8_t *input, uint16_t inlen
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_short_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_interrogate_config_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint16_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_zdo_interrogate_config_t config;
+    esp_err_t ret = esp_ncp_wire_zdo_interrogate_config_decode(input, inlen, &config) ? ESP_OK : ESP_ERR_INVALID_ARG;
+
+    if (ret == ESP_OK) {
+        ret = esp_ncp_zb_interrogate_config(config.auto_enable, config.concurrency, config.retries);
+    }
+
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -1409,54 +3118,118 @@ static esp_err_t esp_ncp_zb_short_addr_set_fn(const uint8_t *input, uint16_t inl
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_long_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_interrogate_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t) ) ? esp_zb_set_long_address((uint8_t *)input) : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_ncp_wire_zdo_interrogate_t interrogate;
+    esp_err_t ret = (esp_ncp_wire_zdo_interrogate_decode(input, inlen, &interrogate) && interrogate.dev_number) ? ESP_OK : ESP_ERR_INVALID_ARG;
+
+    /* The room is checked for the whole list first, so that a refused request queues none of its devices */
+    if (ret == ESP_OK && interrogate.dev_number > esp_ncp_zb_interrogate_room()) {
+        ret = ESP_ERR_NO_MEM;
+    }
+
+    for (uint16_t i = 0; ret == ESP_OK && i < interrogate.dev_number; i ++) {
+        ret = esp_ncp_zb_interrogate_add(esp_ncp_wire_get_u16(interrogate.dev_field, i));
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM
+                              : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
 
-    return ret;
+    /* The status tells the host why no device was queued */
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_nwk_update_id_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+/* The rules see the APS indications without them being forwarded, the APS requests of the host forward them */
+static void esp_ncp_zb_aps_data_handler_register(bool forward)
 {
-    *outlen = sizeof(uint8_t);
-    *output = calloc(1, *outlen);
+    s_aps_forward |= forward;
+    if (!s_aps_handler_registered) {
+        esp_zb_aps_data_indication_handler_register(esp_ncp_zb_aps_data_indication_handler);
+        esp_zb_aps_data_confirm_handler_register(esp_ncp_zb_aps_data_confirm_handler);
+        s_aps_handler_registered = true;
+    }
+}
 
-    if (*output) {
-        *(*output) = 1;
+esp_err_t esp_ncp_zb_aps_data_request(esp_zb_apsde_data_req_t *req, bool host)
+{
+    esp_ncp_zb_aps_data_handler_register(host);
+
+    esp_ncp_zb_aps_sent_t *sent = esp_ncp_zb_aps_sent_add(req, host);
+    esp_err_t ret = esp_zb_aps_data_request(req);
+
+    if (ret != ESP_OK) {
+        sent->handle = 0;
     }
 
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_update_id_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static void esp_ncp_zb_rule_notify(uint8_t rule_id, int32_t value, esp_err_t result, uint8_t tsn)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    typedef struct {
+        uint8_t     rule_id;                        /*!< The rule index */
+        int32_t     value;                          /*!< The trigger value */
+        uint8_t     status;                         /*!< The status of the action, refer to esp_ncp_status_t */
+        uint8_t     tsn;                            /*!< The ZCL transaction sequence number of a ZCL action, 0 otherwise */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_rule_fired_t;
 
-    ESP_NCP_ZB_STATUS();
+    esp_ncp_header_t ncp_header = {
+        .sn = esp_random() % 0xFF,
+        .id = ESP_NCP_ZCL_RULE_FIRED,
+    };
+    esp_ncp_zb_rule_fired_t fired = {
+        .rule_id = rule_id,
+        .value = value,
+        .status = (result == ESP_OK) ? ESP_NCP_SUCCESS : (result == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM : ESP_NCP_ERR_FATAL,
+        .tsn = tsn,
+    };
 
-    return ret;
+    esp_ncp_noti_input(&ncp_header, &fired, sizeof(fired));
 }
 
-static esp_err_t esp_ncp_zb_nwk_trust_center_addr_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_rule_add_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(esp_zb_ieee_addr_t);
-    *output = calloc(1, *outlen);
+    esp_ncp_wire_zcl_rule_add_t rule_req;
+    esp_err_t ret = (esp_ncp_wire_zcl_rule_add_decode(input, inlen, &rule_req) && rule_req.code_len <= ESP_NCP_ZB_RULE_CODE_MAX
+                     && rule_req.action_len <= ESP_NCP_ZB_RULE_ACTION_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
 
-    if (*output) {
-        esp_zb_ieee_addr_t addr = {0xab, 0x98, 0x09, 0xff, 0xff, 0x2e, 0x21, 0x00};
-        memcpy(*output, addr, *outlen);
+    if (ret == ESP_OK) {
+        esp_ncp_zb_rule_t rule = {
+            .flags = rule_req.flags,
+            .trigger = rule_req.trigger,
+            .src_addr = rule_req.src_addr,
+            .src_endpoint = rule_req.src_endpoint,
+            .cluster_id = rule_req.cluster_id,
+            .attr_id = rule_req.attr_id,
+            .code_len = rule_req.code_len,
+            .action_len = rule_req.action_len,
+        };
+
+        memcpy(rule.code, rule_req.code, rule.code_len);
+        memcpy(rule.action, rule_req.action, rule.action_len);
+        ret = esp_ncp_zb_rule_set(rule_req.rule_id, &rule);
     }
 
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    if (ret == ESP_OK) {
+        esp_ncp_zb_rule_notify_register(esp_ncp_zb_rule_notify);
+        if (rule_req.trigger == ESP_NCP_ZB_RULE_TRIGGER_APS) {
+            esp_ncp_zb_aps_data_handler_register(false);
+        }
+    }
+
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_trust_center_addr_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_rule_del_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_zcl_rule_del_t del_req;
+    esp_err_t ret = esp_ncp_wire_zcl_rule_del_decode(input, inlen, &del_req) ? esp_ncp_zb_rule_set(del_req.rule_id, NULL) : ESP_ERR_INVALID_ARG;
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -1464,47 +3237,75 @@ static esp_err_t esp_ncp_zb_nwk_trust_center_addr_set_fn(const uint8_t *input, u
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_nwk_link_key_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_rule_stats_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    *outlen = sizeof(esp_zb_ieee_addr_t) + 16;
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint32_t    hits;                           /*!< The number of times the trigger matched */
+        uint32_t    fired;                          /*!< The number of times the action ran */
+        uint32_t    errors;                         /*!< The number of actions dropped by the air-time scheduler or refused by the stack */
+        uint32_t    hist[ESP_NCP_ZB_RULE_HIST_BUCKETS]; /*!< The latency from the trigger to the stack, the first bucket ends at 50 us and every next one doubles */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_rule_stats_resp_t;
+
+    esp_ncp_wire_zcl_rule_stats_t stats_req;
+    esp_ncp_zb_rule_stats_t stats = { 0 };
+    esp_ncp_zb_rule_stats_resp_t *resp = NULL;
+    esp_err_t ret = esp_ncp_wire_zcl_rule_stats_decode(input, inlen, &stats_req) ? esp_ncp_zb_rule_stats_get(stats_req.rule_id, &stats, stats_req.reset)
+                                                                                  : ESP_ERR_INVALID_ARG;
+
+    *outlen = sizeof(esp_ncp_zb_rule_stats_resp_t);
     *output = calloc(1, *outlen);
-
     if (*output) {
-        esp_zb_ieee_addr_t addr;
-        uint8_t key[16] = {0x5a, 0x69, 0x67, 0x42, 0x65, 0x65, 0x41, 0x6c, 0x6c, 0x69, 0x61, 0x6e, 0x63, 0x65, 0x30, 0x39};
-        esp_zb_get_long_address(addr);
-        memcpy(*output, addr, sizeof(esp_zb_ieee_addr_t));
-        memcpy((*output) + sizeof(esp_zb_ieee_addr_t), key, 16);
+        resp = (esp_ncp_zb_rule_stats_resp_t *)*output;
+        resp->status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM
+                       : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
+        resp->hits = stats.hits;
+        resp->fired = stats.fired;
+        resp->errors = stats.errors;
+        memcpy(resp->hist, stats.hist, sizeof(resp->hist));
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_nwk_link_key_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_timer_add_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == 16 ) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_ncp_wire_zcl_timer_add_t add_req;
+    esp_ncp_wire_status_id_t resp = {
+        .id = ESP_NCP_ZB_TIMER_INVALID_ID,
+    };
+    esp_err_t ret = esp_ncp_wire_zcl_timer_add_decode(input, inlen, &add_req) ? ESP_OK : ESP_ERR_INVALID_ARG;
 
-    ESP_NCP_ZB_STATUS();
+    if (ret == ESP_OK) {
+        uint64_t delay_ms = add_req.deadline;
 
-    return ret;
-}
+        /* The NCP has no wall clock, an absolute deadline is turned into a delay with the clock of the host.
+         * A deadline already past is refused rather than fired at once, the wheel refuses the ones beyond its range. */
+        if (add_req.absolute) {
+            ret = (add_req.deadline >= add_req.utc_now) ? ESP_OK : ESP_ERR_INVALID_ARG;
+            delay_ms = (ret == ESP_OK) ? (uint64_t)(add_req.deadline - add_req.utc_now) * 1000 : 0;
+        }
+        if (ret == ESP_OK) {
+            ret = esp_ncp_zb_timer_add(delay_ms, add_req.period_ms, add_req.action, add_req.action_len, &resp.id);
+        }
+    }
 
-static esp_err_t esp_ncp_zb_nwk_security_mode_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
-{
-    *outlen = sizeof(uint8_t);
+    resp.status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : (ret == ESP_ERR_NO_MEM) ? ESP_NCP_ERR_NO_MEM
+                  : (ret == ESP_ERR_INVALID_ARG) ? ESP_NCP_BAD_ARGUMENT : ESP_NCP_ERR_FATAL;
+    *outlen = esp_ncp_wire_status_id_size(&resp);
     *output = calloc(1, *outlen);
-
     if (*output) {
-        *(*output) = ESP_NCP_NO_SECURITY;
+        esp_ncp_wire_status_id_encode(&resp, *output, *outlen);
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_nwk_security_mode_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_timer_cancel_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_zcl_timer_cancel_t cancel_req;
+    esp_err_t ret = esp_ncp_wire_zcl_timer_cancel_decode(input, inlen, &cancel_req) ? esp_ncp_zb_timer_cancel(cancel_req.id) : ESP_ERR_INVALID_ARG;
+
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
 
     ESP_NCP_ZB_STATUS();
@@ -1512,145 +3313,241 @@ static esp_err_t esp_ncp_zb_nwk_security_mode_set_fn(const uint8_t *input, uint1
     return ret;
 }
 
-static esp_err_t esp_ncp_zb_use_predefined_nwk_panid_set_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_timer_list_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint8_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint16_t    next;                           /*!< The table index to continue the list from, 0 when the list is done */
+        uint8_t     count;                          /*!< The number of timers following the response */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_timer_list_resp_t;
 
-    ESP_NCP_ZB_STATUS();
+    typedef struct {
+        uint32_t    id;                             /*!< The timer ID */
+        uint32_t    remaining_ms;                   /*!< The time left before the command is sent */
+        uint32_t    period_ms;                      /*!< The period of the command, 0 for a single shot */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_timer_record_t;
+
+    esp_ncp_zb_timer_info_t info[ESP_NCP_ZB_TIMER_LIST_MAX];
+    esp_ncp_zb_timer_list_resp_t *resp = NULL;
+    uint16_t start = 0;
+    uint16_t next = 0;
+    uint16_t count = 0;
+
+    if (input && inlen >= sizeof(uint16_t)) {
+        memcpy(&start, input, sizeof(uint16_t));
+    }
+    count = esp_ncp_zb_timer_list(start, info, ESP_NCP_ZB_TIMER_LIST_MAX, &next);
 
-    return ret;
+    *outlen = sizeof(esp_ncp_zb_timer_list_resp_t) + count * sizeof(esp_ncp_zb_timer_record_t);
+    *output = calloc(1, *outlen);
+    if (*output) {
+        esp_ncp_zb_timer_record_t *record = (esp_ncp_zb_timer_record_t *)(*output + sizeof(esp_ncp_zb_timer_list_resp_t));
+
+        resp = (esp_ncp_zb_timer_list_resp_t *)*output;
+        resp->status = ESP_NCP_SUCCESS;
+        resp->next = next;
+        resp->count = count;
+        for (int i = 0; i < count; i ++) {
+            record[i].id = info[i].id;
+            record[i].remaining_ms = info[i].remaining_ms;
+            record[i].period_ms = info[i].period_ms;
+        }
+    }
+
+    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_address_short_by_ieee_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_timer_stats_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(esp_zb_ieee_addr_t)) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
-
-    if (status == ESP_NCP_SUCCESS) {
-        uint16_t shotr_addr = esp_zb_address_short_by_ieee((uint8_t *)input);
-
-        *outlen = sizeof(uint16_t);
-        *output = calloc(1, *outlen);
-
-        if (*output) {
-            memcpy(*output, &shotr_addr, *outlen);
-        }
+    typedef struct {
+        uint8_t     status;                         /*!< The status, refer to esp_ncp_status_t */
+        uint16_t    pending;                        /*!< The number of commands waiting */
+        uint16_t    max_pending;                    /*!< The highest number of commands waiting at once */
+        uint32_t    fired;                          /*!< The number of commands sent */
+        uint32_t    errors;                         /*!< The number of commands dropped before the air-time scheduler */
+        uint32_t    jitter_avg_us;                  /*!< The average delay between the deadline and the firing */
+        uint32_t    jitter_max_us;                  /*!< The longest delay between the deadline and the firing */
+        uint32_t    hist[ESP_NCP_ZB_TIMER_HIST_BUCKETS]; /*!< The firing delay histogram, the first bucket ends at 20 ms and every next one doubles */
+    } ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_timer_stats_resp_t;
+
+    esp_ncp_zb_timer_stats_t stats;
+    esp_ncp_zb_timer_stats_resp_t *resp = NULL;
+
+    esp_ncp_zb_timer_stats_get(&stats, input && inlen && input[0]);
+
+    *outlen = sizeof(esp_ncp_zb_timer_stats_resp_t);
+    *output = calloc(1, *outlen);
+    if (*output) {
+        resp = (esp_ncp_zb_timer_stats_resp_t *)*output;
+        resp->status = ESP_NCP_SUCCESS;
+        resp->pending = stats.pending;
+        resp->max_pending = stats.max_pending;
+        resp->fired = stats.fired;
+        resp->errors = stats.errors;
+        resp->jitter_avg_us = stats.jitter_avg_us;
+        resp->jitter_max_us = stats.jitter_max_us;
+        memcpy(resp->hist, stats.hist, sizeof(resp->hist));
     }
 
     return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
 }
 
-static esp_err_t esp_ncp_zb_ieee_address_by_short_get_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_aps_data_request_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = (input && inlen == sizeof(uint16_t) ) ? ESP_OK : ESP_ERR_INVALID_ARG;
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+    esp_ncp_wire_aps_data_request_t aps_data;
+    esp_err_t ret = esp_ncp_wire_aps_data_request_decode(input, inlen, &aps_data) ? ESP_OK : ESP_ERR_INVALID_ARG;
 
-    if (status == ESP_NCP_SUCCESS) {
-        uint16_t shotr_addr = 0;
-        esp_zb_ieee_addr_t ieee_addr;
-        memcpy(&shotr_addr, input, inlen);
+    if (ret == ESP_OK) {
+        esp_zb_apsde_data_req_t data_req = {
+            .dst_addr_mode       = aps_data.dst_addr_mode,
+            .dst_endpoint        = aps_data.basic_cmd.dst_endpoint,
+            .src_endpoint        = aps_data.basic_cmd.src_endpoint,
+            .profile_id          = aps_data.profile_id,
+            .cluster_id          = aps_data.cluster_id,
+            .tx_options          = aps_data.tx_options,
+            .use_alias           = aps_data.use_alias,
+            .alias_src_addr      = esp_ncp_wire_addr_short(&aps_data.alias_src_addr),
+            .alias_seq_num       = aps_data.alias_seq_num,
+            .radius              = aps_data.radius,
+            .asdu_length         = aps_data.asdu_length,
+            .asdu                = aps_data.asdu_length ? (uint8_t *)aps_data.asdu : NULL,
+        };
 
-        esp_zb_ieee_address_by_short(shotr_addr, ieee_addr);
+        esp_ncp_zb_wire_addr(&aps_data.basic_cmd.dst_addr, aps_data.dst_addr_mode, &data_req.dst_addr);
 
-        *outlen = sizeof(esp_zb_ieee_addr_t);
-        *output = calloc(1, *outlen);
+        ESP_LOGD(TAG, "dst_addr_mode %0x, dst_short_addr %02x, dst_endpoint %0x, src_endpoint %0x, profile_id %02x, cluster_id %02x, tx_options %02x, use_alias %02x, radius %0x",
+                        data_req.dst_addr_mode, data_req.dst_addr.addr_short, data_req.dst_endpoint, data_req.src_endpoint, data_req.profile_id, data_req.cluster_id,
+                        data_req.tx_options, data_req.use_alias, data_req.radius);
 
-        if (*output) {
-            memcpy(*output, ieee_addr, *outlen);
+        if (data_req.asdu && data_req.asdu_length) {
+            ESP_LOG_BUFFER_HEX_LEVEL(TAG, data_req.asdu, data_req.asdu_length, ESP_LOG_DEBUG);
         }
+
+        ret = esp_ncp_zb_aps_data_request(&data_req, true);
     }
 
-    return (*output) ? ESP_OK : ESP_ERR_NO_MEM;
+    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+
+    ESP_NCP_ZB_STATUS();
+
+    return ret;
 }
 
-static esp_err_t esp_ncp_zb_find_match_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static void esp_ncp_zb_aps_bulk_timeout_cb(void *param)
 {
-    esp_err_t ret = ESP_OK;
+    esp_ncp_zb_aps_bulk_t *bulk = (esp_ncp_zb_aps_bulk_t *)param;
 
-    typedef struct {
-        esp_ncp_zb_user_cb_t user_ctx;      /*!< A ZDO match desc request callback */
-        uint16_t dst_nwk_addr;              /*!< NWK address that request sent to */
-        uint16_t addr_of_interest;          /*!< NWK address of interest */
-        uint16_t profile_id;                /*!< Profile ID to be match at the destination which refers to esp_zb_af_profile_id_t */
-        uint8_t num_in_clusters;            /*!< The number of input clusters provided for matching cluster server */
-        uint8_t num_out_clusters;           /*!< The number of output clusters provided for matching cluster client */
-    } __attribute__ ((packed)) esp_zb_zdo_match_desc_t;
+    ESP_LOGW(TAG, "Bulk APS data request: %d of %d destinations not confirmed", bulk->count - bulk->confirmed, bulk->count);
+    esp_ncp_zb_aps_bulk_finish(bulk);
+}
 
-    if (input) {
-        esp_zb_zdo_match_desc_t *zdo_data = (esp_zb_zdo_match_desc_t *)input;
-        esp_zb_zdo_match_desc_req_param_t desc_req = {
-            .dst_nwk_addr = zdo_data->dst_nwk_addr,
-            .addr_of_interest = zdo_data->addr_of_interest,
-            .profile_id = zdo_data->profile_id,
-            .num_in_clusters = zdo_data->num_in_clusters,
-            .num_out_clusters = zdo_data->num_out_clusters,
-            .cluster_list = (inlen != sizeof(esp_zb_zdo_match_desc_t)) ? (uint16_t *)(input + sizeof(esp_zb_zdo_match_desc_t)) : NULL,
-        };
+static void esp_ncp_zb_aps_bulk_dst_send_cb(void *arg, bool drop)
+{
+    esp_ncp_zb_aps_bulk_t *bulk = s_aps_bulk;
+    esp_ncp_zb_aps_bulk_dst_t *dst = (esp_ncp_zb_aps_bulk_dst_t *)arg;
+    int index = dst - bulk->dst;
 
-        uint32_t *user_ctx = calloc(1, sizeof(esp_ncp_zb_user_cb_t));
-        if (user_ctx) {
-            memcpy(user_ctx, input, sizeof(esp_ncp_zb_user_cb_t));
-        }
+    bulk->data_req.dst_addr_mode = dst->dst_addr_mode;
+    memcpy(&bulk->data_req.dst_addr, &dst->dst_addr, sizeof(esp_zb_addr_u));
+    bulk->data_req.dst_endpoint = dst->dst_endpoint;
+    bulk->data_req.tx_options = dst->tx_options;
 
-        ret = esp_zb_zdo_match_cluster(&desc_req, esp_ncp_zb_find_match_cb, user_ctx);
+    if (!drop) {
+        bulk->handle[index] = esp_ncp_zb_aps_handle_next();
+    }
+    if (drop || esp_zb_aps_data_request(&bulk->data_req) != ESP_OK) {
+        bulk->handle[index] = 0;
+        bulk->result[index + 1] = ESP_NCP_ZB_APS_BULK_REJECTED;
+        bulk->confirmed ++;
+    }
+    bulk->sent ++;
+
+    /* The bulk request stays alive until the scheduler is done with all its destinations */
+    if (bulk->sent < bulk->count) {
+        return;
+    } else if (bulk->confirmed == bulk->count) {
+        esp_ncp_zb_aps_bulk_finish(bulk);
     } else {
-        ret = ESP_ERR_INVALID_ARG;
+        bulk->timeout = esp_zb_scheduler_user_alarm(esp_ncp_zb_aps_bulk_timeout_cb, bulk, ESP_NCP_ZB_APS_BULK_TIMEOUT_MS);
     }
+}
 
-    esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
+static void esp_ncp_zb_aps_bulk_send_cb(void *param)
+{
+    esp_ncp_zb_aps_bulk_t *bulk = (esp_ncp_zb_aps_bulk_t *)param;
+    esp_ncp_zb_aps_bulk_dst_t *dst = &bulk->dst[bulk->queued ++];
+    bool more = bulk->queued < bulk->count;
 
-    ESP_NCP_ZB_STATUS();
+    /* A dropped destination is completed before the submit returns, the last one may free the request */
+    esp_ncp_zb_sched_submit(ESP_NCP_ZB_SCHED_CLASS_COMMAND, dst->dst_addr.addr_short,
+                            dst->dst_addr_mode == ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT || dst->dst_addr_mode == ESP_ZB_APS_ADDR_MODE_64_ENDP_PRESENT,
+                            (uint16_t)bulk->data_req.asdu_length, esp_ncp_zb_aps_bulk_dst_send_cb, dst);
 
-    return ret;
+    if (more) {
+        esp_zb_scheduler_user_alarm(esp_ncp_zb_aps_bulk_send_cb, bulk, bulk->pacing_ms);
+    }
 }
 
-static esp_err_t esp_ncp_zb_aps_data_request_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
+static esp_err_t esp_ncp_zb_aps_data_request_bulk_fn(const uint8_t *input, uint16_t inlen, uint8_t **output, uint16_t *outlen)
 {
-    esp_err_t ret = input ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_wire_aps_data_request_bulk_t bulk_req;
+    esp_err_t ret = esp_ncp_wire_aps_data_request_bulk_decode(input, inlen, &bulk_req) ? ESP_OK : ESP_ERR_INVALID_ARG;
+    esp_ncp_zb_aps_bulk_t *bulk = NULL;
 
-    typedef struct {
-        esp_zb_zcl_basic_cmd_t basic_cmd;                       /*!< Basic command info */
-        uint8_t  dst_addr_mode;                                 /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
-        uint16_t profile_id;                                    /*!< Profile id */
-        uint16_t cluster_id;                                    /*!< Cluster id */
-        uint8_t tx_options;                                     /*!< The transmission options for the ASDU to be transferred, refer to esp_zb_apsde_tx_opt_t */
-        bool use_alias;                                         /*!< The next higher layer may use the UseAlias parameter to request alias usage by NWK layer for the current frame.*/
-        esp_zb_addr_u alias_src_addr;                           /*!< The source address to be used for this NSDU. If the use_alias is true */
-        uint8_t alias_seq_num;                                  /*!< The sequence number to be used for this NSDU. If the use_alias is true */
-        uint8_t radius;                                         /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network.*/
-        uint32_t asdu_length;                                   /*!< The number of octets comprising the ASDU to be transferred */
-    } ESP_NCP_ZB_PACKED_STRUCT esp_zb_aps_data_t;
+    if (ret == ESP_OK) {
+        size_t dst_len = (size_t)bulk_req.dst_count * sizeof(esp_ncp_zb_aps_bulk_dst_t);
+        size_t handle_len = (size_t)bulk_req.dst_count * sizeof(uint32_t);
 
-    if (input) {
-        esp_zb_aps_data_t *aps_data = (esp_zb_aps_data_t *)input;
-        esp_zb_apsde_data_req_t data_req = {
-            .dst_addr_mode       = aps_data->dst_addr_mode,
-            .dst_addr.addr_short = aps_data->basic_cmd.dst_addr_u.addr_short,
-            .dst_endpoint        = aps_data->basic_cmd.dst_endpoint,
-            .src_endpoint        = aps_data->basic_cmd.src_endpoint,
-            .profile_id          = aps_data->profile_id,
-            .cluster_id          = aps_data->cluster_id,
-            .tx_options          = aps_data->tx_options,
-            .use_alias           = aps_data->use_alias,
-            .alias_src_addr      = aps_data->alias_src_addr.addr_short,
-            .alias_seq_num       = aps_data->alias_seq_num,
-            .radius              = aps_data->radius,
-            .asdu_length         = aps_data->asdu_length,
-            .asdu                = aps_data->asdu_length ? (uint8_t *)(input + sizeof(esp_zb_aps_data_t)) : NULL,
-        };
+        /* The decode checked the ASDU length against what is left of the frame */
+        if (!bulk_req.dst_count || bulk_req.dst_count > ESP_NCP_ZB_APS_BULK_MAX_DST) {
+            ret = ESP_ERR_INVALID_SIZE;
+        } else if (s_aps_bulk) {
+            ESP_LOGW(TAG, "Bulk APS data request already in progress");
+            ret = ESP_ERR_INVALID_STATE;
+        } else {
+            bulk = calloc(1, sizeof(esp_ncp_zb_aps_bulk_t) + handle_len + dst_len + ((size_t)bulk_req.dst_count + 1)
+                             + (size_t)bulk_req.asdu_length);
+            ret = bulk ? ESP_OK : ESP_ERR_NO_MEM;
+        }
 
-        ESP_LOGI(TAG, "dst_addr_mode %0x, dst_short_addr %02x, dst_endpoint %0x, src_endpoint %0x, profile_id %02x, cluster_id %02x, tx_options %02x, use_alias %02x, radius %0x",
-                        data_req.dst_addr_mode, data_req.dst_addr.addr_short, data_req.dst_endpoint, data_req.src_endpoint, data_req.profile_id, data_req.cluster_id,
-                        data_req.tx_options, data_req.use_alias, data_req.radius);
+        if (bulk) {
+            esp_ncp_wire_aps_bulk_dst_t dst;
+            size_t offset = 0;
+
+            bulk->handle = (uint32_t *)(bulk + 1);
+            bulk->dst = (esp_ncp_zb_aps_bulk_dst_t *)(bulk->handle + bulk_req.dst_count);
+            bulk->result = (uint8_t *)bulk->dst + dst_len;
+            bulk->sn = s_request_header.sn;
+            bulk->count = bulk_req.dst_count;
+            bulk->pacing_ms = bulk_req.pacing_ms ? bulk_req.pacing_ms : ESP_NCP_ZB_APS_BULK_PACING_MS;
+            bulk->timeout = ESP_ZB_USER_CB_HANDLE_INVALID;
+            /* The decode checked all the records are whole */
+            for (int i = 0; i < bulk->count && esp_ncp_wire_aps_bulk_dst_next(bulk_req.dst, bulk_req.dst_len, &offset, &dst); i ++) {
+                bulk->dst[i].dst_addr_mode = dst.dst_addr_mode;
+                memcpy(&bulk->dst[i].dst_addr, dst.dst_addr.bytes, sizeof(esp_zb_addr_u));
+                bulk->dst[i].dst_endpoint = dst.dst_endpoint;
+                bulk->dst[i].tx_options = dst.tx_options;
+            }
+            bulk->result[0] = bulk->count;
+            memset(&bulk->result[1], ESP_NCP_ZB_APS_BULK_NO_CONFIRM, bulk->count);
+
+            bulk->data_req.src_endpoint = bulk_req.src_endpoint;
+            bulk->data_req.profile_id = bulk_req.profile_id;
+            bulk->data_req.cluster_id = bulk_req.cluster_id;
+            bulk->data_req.radius = bulk_req.radius;
+            bulk->data_req.asdu_length = bulk_req.asdu_length;
+            if (bulk_req.asdu_length) {
+                bulk->data_req.asdu = &bulk->result[bulk->count + 1];
+                memcpy(bulk->data_req.asdu, bulk_req.asdu, bulk_req.asdu_length);
+            }
 
-        if (data_req.asdu && data_req.asdu_length) {
-            ESP_LOG_BUFFER_HEX_LEVEL(TAG, data_req.asdu, data_req.asdu_length, ESP_LOG_DEBUG);
-        }
+            ESP_LOGD(TAG, "Bulk APS data request: count %d, profile_id %02x, cluster_id %02x, pacing %d ms",
+                            bulk->count, bulk->data_req.profile_id, bulk->data_req.cluster_id, bulk->pacing_ms);
 
-        esp_zb_aps_data_indication_handler_register(esp_ncp_zb_aps_data_indication_handler);
-        esp_zb_aps_data_confirm_handler_register(esp_ncp_zb_aps_data_confirm_handler);
-        ret = esp_zb_aps_data_request(&data_req);
+            esp_ncp_zb_aps_data_handler_register(true);
+            s_aps_bulk = bulk;
+            esp_zb_scheduler_user_alarm(esp_ncp_zb_aps_bulk_send_cb, bulk, 0);
+        }
     }
 
     esp_ncp_status_t status = (ret == ESP_OK) ? ESP_NCP_SUCCESS : ESP_NCP_ERR_FATAL;
@@ -1748,6 +3645,13 @@ static const esp_ncp_zb_func_t ncp_zb_func_table[] = {
     {ESP_NCP_NETWORK_PREDEFINED_PANID, esp_ncp_zb_use_predefined_nwk_panid_set_fn},
     {ESP_NCP_NETWORK_SHORT_TO_IEEE, esp_ncp_zb_ieee_address_by_short_get_fn},
     {ESP_NCP_NETWORK_IEEE_TO_SHORT, esp_ncp_zb_address_short_by_ieee_get_fn},
+    {ESP_NCP_NETWORK_NEIGHBOR_TABLE_GET, esp_ncp_zb_neighbor_table_get_fn},
+    {ESP_NCP_NETWORK_ROUTE_TABLE_GET, esp_ncp_zb_route_table_get_fn},
+    {ESP_NCP_NETWORK_ROUTE_RECORD_TABLE_GET, esp_ncp_zb_route_record_table_get_fn},
+    {ESP_NCP_NETWORK_SIGNAL_SUBSCRIBE, esp_ncp_zb_signal_subscribe_fn},
+    {ESP_NCP_NETWORK_JOIN_BATCH_CONFIG, esp_ncp_zb_join_batch_config_fn},
+    {ESP_NCP_NETWORK_IC_ADD_BULK, esp_ncp_zb_ic_add_bulk_fn},
+    {ESP_NCP_NETWORK_IC_REMOVE_BULK, esp_ncp_zb_ic_remove_bulk_fn},
     {ESP_NCP_ZCL_ENDPOINT_ADD, esp_ncp_zb_add_endpoint_fn},
     {ESP_NCP_ZCL_ENDPOINT_DEL, esp_ncp_zb_del_endpoint_fn},
     {ESP_NCP_ZCL_ATTR_READ, esp_ncp_zb_read_attr_fn},
@@ -1756,41 +3660,159 @@ static const esp_ncp_zb_func_t ncp_zb_func_table[] = {
     {ESP_NCP_ZCL_ATTR_DISC, esp_ncp_zb_disc_attr_fn},
     {ESP_NCP_ZCL_READ, esp_ncp_zb_zcl_read_fn},
     {ESP_NCP_ZCL_WRITE, esp_ncp_zb_zcl_write_fn},
-    {ESP_NCP_ZCL_REPORT_CONFIG, NULL},
+    {ESP_NCP_ZCL_REPORT_CONFIG, esp_ncp_zb_report_config_fn},
+    {ESP_NCP_ZCL_ATTR_READ_BULK, esp_ncp_zb_read_attr_bulk_fn},
+    {ESP_NCP_ZCL_SCHED_CONFIG, esp_ncp_zb_sched_config_fn},
+    {ESP_NCP_ZCL_SCHED_STATS, esp_ncp_zb_sched_stats_fn},
+    {ESP_NCP_ZCL_WRITE_MULTI, esp_ncp_zb_zcl_write_multi_fn},
+    {ESP_NCP_ZCL_GROUPCAST_STATS, esp_ncp_zb_groupcast_stats_fn},
+    {ESP_NCP_ZCL_RULE_ADD, esp_ncp_zb_rule_add_fn},
+    {ESP_NCP_ZCL_RULE_DEL, esp_ncp_zb_rule_del_fn},
+    {ESP_NCP_ZCL_RULE_STATS, esp_ncp_zb_rule_stats_fn},
+    {ESP_NCP_ZCL_TIMER_ADD, esp_ncp_zb_timer_add_fn},
+    {ESP_NCP_ZCL_TIMER_CANCEL, esp_ncp_zb_timer_cancel_fn},
+    {ESP_NCP_ZCL_TIMER_LIST, esp_ncp_zb_timer_list_fn},
+    {ESP_NCP_ZCL_TIMER_STATS, esp_ncp_zb_timer_stats_fn},
     {ESP_NCP_ZDO_BIND_SET, esp_ncp_zb_set_bind_fn},
     {ESP_NCP_ZDO_UNBIND_SET, esp_ncp_zb_set_unbind_fn},
     {ESP_NCP_ZDO_FIND_MATCH, esp_ncp_zb_find_match_fn},
+    {ESP_NCP_ZDO_INTERROGATE_CONFIG, esp_ncp_zb_interrogate_config_fn},
+    {ESP_NCP_ZDO_INTERROGATE, esp_ncp_zb_interrogate_fn},
     {ESP_NCP_APS_DATA_REQUEST, esp_ncp_zb_aps_data_request_fn},
     {ESP_NCP_APS_DATA_INDICATION, esp_ncp_zb_aps_data_indication_fn},
     {ESP_NCP_APS_DATA_CONFIRM, esp_ncp_zb_aps_data_confirm_fn},
+    {ESP_NCP_APS_DATA_REQUEST_BULK, esp_ncp_zb_aps_data_request_bulk_fn},
 };
 
-esp_err_t esp_ncp_zb_output(esp_ncp_header_t *ncp_header, const void *buffer, uint16_t len)
+typedef struct {
+    esp_ncp_header_t    header;                 /*!< The header of the request frame */
+    ncp_zb_fn           set_func;               /*!< The function processing the request */
+    uint16_t            len;                    /*!< The payload length of the request */
+    uint8_t             data[];                 /*!< The payload of the request */
+} esp_ncp_zb_request_t;
+
+static esp_err_t esp_ncp_zb_call(ncp_zb_fn set_func, esp_ncp_header_t *ncp_header, const void *buffer, uint16_t len)
 {
     uint8_t *output = NULL;
     uint16_t outlen = 0;
     esp_err_t ret = ESP_OK;
 
-    for (int i = 0; i <= sizeof(ncp_zb_func_table) / sizeof(ncp_zb_func_table[0]); i ++) {
+    memcpy(&s_request_header, ncp_header, sizeof(esp_ncp_header_t));
+
+    ret = set_func(buffer, len, &output, &outlen);
+    if (ret == ESP_OK) {
+        esp_ncp_resp_input(ncp_header, output, outlen);
+    }
+
+    if (output) {
+        free(output);
+        output = NULL;
+    }
+
+    return ret;
+}
+
+static void esp_ncp_zb_request_send_cb(void *arg, bool drop)
+{
+    esp_ncp_zb_request_t *request = (esp_ncp_zb_request_t *)arg;
+    esp_err_t ret = ESP_OK;
+
+    if (drop) {
+        uint8_t status = ESP_NCP_ERR_NO_MEM;
+        esp_ncp_resp_input(&request->header, &status, sizeof(uint8_t));
+    } else {
+        ret = esp_ncp_zb_call(request->set_func, &request->header, request->len ? request->data : NULL, request->len);
+    }
+
+    /* Same error response as the frame layer sends for a request processed in the NCP task */
+    if (ret != ESP_OK) {
+        esp_ncp_resp_input(NULL, &ret, 1);
+    }
+
+    free(request);
+}
+
+/* The ZCL requests which go on air wait for the air-time scheduler, their payload starts with the basic command and the address mode */
+static bool esp_ncp_zb_request_sched_class(const esp_ncp_zb_request_t *request, uint8_t *sched_class)
+{
+    switch (request->header.id) {
+        case ESP_NCP_ZCL_WRITE:
+            *sched_class = ESP_NCP_ZB_SCHED_CLASS_COMMAND;
+            return true;
+        case ESP_NCP_ZCL_ATTR_READ:
+        case ESP_NCP_ZCL_ATTR_WRITE:
+            *sched_class = ESP_NCP_ZB_SCHED_CLASS_ATTRIBUTE;
+            return true;
+        case ESP_NCP_ZCL_REPORT_CONFIG: {
+            /* A request with a device list goes through the bulk engine, which submits every device itself */
+            esp_ncp_wire_zcl_report_config_t report_config;
+
+            *sched_class = ESP_NCP_ZB_SCHED_CLASS_ATTRIBUTE;
+            return esp_ncp_wire_zcl_report_config_decode(request->data, request->len, &report_config) && !report_config.dev_number;
+        }
+        default:
+            return false;
+    }
+}
+
+static void esp_ncp_zb_request_cb(void *arg)
+{
+    esp_ncp_zb_request_t *request = (esp_ncp_zb_request_t *)arg;
+    uint8_t sched_class = ESP_NCP_ZB_SCHED_CLASS_MAX;
+
+    if (esp_ncp_zb_request_sched_class(request, &sched_class)
+        && request->len > sizeof(esp_zb_zcl_basic_cmd_t)) {
+        esp_zb_zcl_basic_cmd_t zcl_basic_cmd;
+        uint8_t address_mode = request->data[sizeof(esp_zb_zcl_basic_cmd_t)];
+
+        memcpy(&zcl_basic_cmd, request->data, sizeof(esp_zb_zcl_basic_cmd_t));
+        esp_ncp_zb_sched_submit(sched_class, zcl_basic_cmd.dst_addr_u.addr_short, address_mode == ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+                                request->len, esp_ncp_zb_request_send_cb, request);
+    } else {
+        esp_ncp_zb_request_send_cb(request, false);
+    }
+}
+
+/* The APS data polling requests only wait on the NCP queues, blocking the Zigbee task on them would stall the confirms they wait for */
+static bool esp_ncp_zb_in_ncp_task(uint16_t id)
+{
+    return (id == ESP_NCP_APS_DATA_INDICATION || id == ESP_NCP_APS_DATA_CONFIRM);
+}
+
+esp_err_t esp_ncp_zb_output(esp_ncp_header_t *ncp_header, const void *buffer, uint16_t len)
+{
+    esp_err_t ret = ESP_OK;
+
+    for (int i = 0; i < sizeof(ncp_zb_func_table) / sizeof(ncp_zb_func_table[0]); i ++) {
         if (ncp_header->id != ncp_zb_func_table[i].id) {
             continue;
         }
 
-        if (ncp_zb_func_table[i].set_func) {
-            ret = ncp_zb_func_table[i].set_func(buffer, len, &output, &outlen);
-            if (ret == ESP_OK) {
-                esp_ncp_resp_input(ncp_header, output, outlen);
+        if (!ncp_zb_func_table[i].set_func) {
+            ret = ESP_ERR_INVALID_ARG;
+        } else if (s_start_flag && !esp_ncp_zb_in_ncp_task(ncp_header->id)) {
+            /* Once the stack loop runs, the request is processed in the Zigbee task which answers it */
+            esp_ncp_zb_request_t *request = calloc(1, sizeof(esp_ncp_zb_request_t) + len);
+
+            if (request) {
+                memcpy(&request->header, ncp_header, sizeof(esp_ncp_header_t));
+                request->set_func = ncp_zb_func_table[i].set_func;
+                request->len = buffer ? len : 0;
+                if (request->len) {
+                    memcpy(request->data, buffer, len);
+                }
+                ret = esp_ncp_zb_mailbox_post(esp_ncp_zb_request_cb, request);
+                if (ret != ESP_OK) {
+                    free(request);
+                }
+            } else {
+                ret = ESP_ERR_NO_MEM;
             }
         } else {
-            ret = ESP_ERR_INVALID_ARG;
+            ret = esp_ncp_zb_call(ncp_zb_func_table[i].set_func, ncp_header, buffer, len);
         }
         break;
     }
 
-    if (output) {
-        free(output);
-        output = NULL;
-    }
-
     return ret;
 }
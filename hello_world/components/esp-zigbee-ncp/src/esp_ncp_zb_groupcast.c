@@ -0,0 +1,544 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_zb_groupcast.h"
+#include "esp_ncp_zb_sched.h"
+
+static const char *TAG = "ESP_NCP_ZB_GROUPCAST";
+
+typedef enum {
+    ESP_NCP_ZB_GROUPCAST_UNKNOWN,               /*!< The device is not asked to join the group yet */
+    ESP_NCP_ZB_GROUPCAST_PENDING,               /*!< The add group command is sent, waiting for the response */
+    ESP_NCP_ZB_GROUPCAST_MEMBER,                /*!< The device confirmed the group membership */
+    ESP_NCP_ZB_GROUPCAST_FAILED,                /*!< The device refused the group, it keeps getting unicasts */
+} esp_ncp_zb_groupcast_state_t;
+
+typedef enum {
+    ESP_NCP_ZB_GROUPCAST_FRAME_COMMAND,         /*!< The cluster command, unicast or groupcast */
+    ESP_NCP_ZB_GROUPCAST_FRAME_ADD,             /*!< The add group command of the membership maintenance */
+    ESP_NCP_ZB_GROUPCAST_FRAME_REMOVE,          /*!< The remove group command of an evicted set */
+    ESP_NCP_ZB_GROUPCAST_FRAME_PURGE,           /*!< The groupcast remove group command clearing a group ID before its use */
+} esp_ncp_zb_groupcast_frame_kind_t;
+
+typedef struct {
+    uint16_t                addr;               /*!< The short address of the device */
+    uint8_t                 state;              /*!< The membership state, refer to esp_ncp_zb_groupcast_state_t */
+    uint8_t                 tsn;                /*!< The transaction sequence number of the pending add group command */
+} esp_ncp_zb_groupcast_dev_t;
+
+typedef struct {
+    bool                    used;               /*!< The set is tracked */
+    bool                    purging;            /*!< The group ID is being purged, the members are added afterwards */
+    uint8_t                 endpoint;           /*!< The destination endpoint of the devices */
+    uint8_t                 src_endpoint;       /*!< The source endpoint of the membership commands */
+    uint16_t                group_id;           /*!< The group of the set, 0 before the promotion */
+    uint16_t                uses;               /*!< The number of commands sent to the set */
+    uint16_t                token;              /*!< Tells the frames of an evicted set from those of its successor */
+    uint16_t                dev_count;          /*!< The number of devices in the set */
+    TickType_t              last_use;           /*!< The tick count of the last command sent to the set */
+    esp_ncp_zb_groupcast_dev_t dev[ESP_NCP_ZB_GROUPCAST_MAX_DEV]; /*!< The devices, sorted by short address */
+} esp_ncp_zb_groupcast_set_t;
+
+typedef struct {
+    uint8_t                 kind;               /*!< The frame kind, refer to esp_ncp_zb_groupcast_frame_kind_t */
+    uint8_t                 set;                /*!< The index of the set the frame belongs to */
+    uint16_t                token;              /*!< The token of the set when the frame was queued */
+    uint16_t                dev;                /*!< The index of the device in the set */
+    uint8_t                 retry;              /*!< The number of times the dropped frame was queued again */
+    uint16_t                value_len;          /*!< The length of the encoded command payload */
+    esp_zb_zcl_custom_cluster_cmd_t cmd;        /*!< The command, the value points to the payload below */
+    uint8_t                 value[];            /*!< The encoded command payload */
+} esp_ncp_zb_groupcast_frame_t;
+
+typedef struct {
+    bool                    used;               /*!< The remove group command is waiting for its response */
+    uint8_t                 tsn;                /*!< The transaction sequence number of the command */
+    uint16_t                addr;               /*!< The short address of the device */
+    uint16_t                group_id;           /*!< The group the device is removed from */
+} esp_ncp_zb_groupcast_remove_t;
+
+static esp_ncp_zb_groupcast_set_t s_groupcast_set[ESP_NCP_ZB_GROUPCAST_SET_MAX];
+static esp_ncp_zb_groupcast_stats_t s_groupcast_stats;
+static uint16_t s_groupcast_token;
+static uint16_t s_groupcast_group;
+static uint8_t s_groupcast_clean[ESP_NCP_ZB_GROUPCAST_GROUP_RANGE / 8]; /*!< The group IDs purged for the set holding them, none after a reboot */
+static uint8_t s_groupcast_removing[ESP_NCP_ZB_GROUPCAST_GROUP_RANGE]; /*!< The remove group commands of evicted sets not sent yet, per group ID */
+static esp_ncp_zb_groupcast_remove_t s_groupcast_remove[ESP_NCP_ZB_GROUPCAST_REMOVE_TSN_MAX]; /*!< The remove group commands sent, oldest overwritten */
+static uint8_t s_groupcast_remove_next;
+
+static void esp_ncp_zb_groupcast_frame_send(void *arg, bool drop);
+static void esp_ncp_zb_groupcast_purge_done(void *arg);
+
+static bool esp_ncp_zb_groupcast_clean_get(uint16_t group_id)
+{
+    uint16_t offset = group_id - ESP_NCP_ZB_GROUPCAST_GROUP_BASE;
+
+    return s_groupcast_clean[offset / 8] & (1 << (offset % 8));
+}
+
+static void esp_ncp_zb_groupcast_clean_set(uint16_t group_id, bool clean)
+{
+    uint16_t offset = group_id - ESP_NCP_ZB_GROUPCAST_GROUP_BASE;
+
+    if (clean) {
+        s_groupcast_clean[offset / 8] |= (1 << (offset % 8));
+    } else {
+        s_groupcast_clean[offset / 8] &= ~(1 << (offset % 8));
+    }
+}
+
+static esp_ncp_zb_groupcast_frame_t *esp_ncp_zb_groupcast_frame_new(uint8_t kind, uint8_t set_index, uint16_t dev_index,
+                                                                    const esp_zb_zcl_custom_cluster_cmd_t *cmd, const void *value,
+                                                                    uint16_t value_len)
+{
+    esp_ncp_zb_groupcast_frame_t *frame = calloc(1, sizeof(esp_ncp_zb_groupcast_frame_t) + value_len);
+
+    ESP_RETURN_ON_FALSE(frame, NULL, TAG, "No memory for the groupcast frame");
+
+    /* The group ID stays reserved until the command is sent or given up */
+    if (kind == ESP_NCP_ZB_GROUPCAST_FRAME_REMOVE) {
+        s_groupcast_removing[cmd->custom_cmd_id - ESP_NCP_ZB_GROUPCAST_GROUP_BASE] ++;
+    }
+
+    frame->kind = kind;
+    frame->set = set_index;
+    frame->token = s_groupcast_set[set_index].token;
+    frame->dev = dev_index;
+    frame->value_len = value_len;
+    frame->cmd = *cmd;
+    if (value && value_len) {
+        memcpy(frame->value, value, value_len);
+        frame->cmd.data.value = frame->value;
+    }
+
+    return frame;
+}
+
+static esp_err_t esp_ncp_zb_groupcast_frame_queue(esp_ncp_zb_groupcast_frame_t *frame)
+{
+    uint8_t sched_class = (frame->kind == ESP_NCP_ZB_GROUPCAST_FRAME_COMMAND) ? ESP_NCP_ZB_SCHED_CLASS_COMMAND : ESP_NCP_ZB_SCHED_CLASS_BACKGROUND;
+    bool unicast = frame->cmd.address_mode != ESP_ZB_APS_ADDR_MODE_16_GROUP_ENDP_NOT_PRESENT;
+
+    return esp_ncp_zb_sched_submit(sched_class, frame->cmd.zcl_basic_cmd.dst_addr_u.addr_short, unicast, frame->value_len,
+                                   esp_ncp_zb_groupcast_frame_send, frame);
+}
+
+static void esp_ncp_zb_groupcast_frame_requeue(void *arg)
+{
+    esp_ncp_zb_groupcast_frame_queue((esp_ncp_zb_groupcast_frame_t *)arg);
+}
+
+/* Queues a dropped membership command again after a backoff doubling every time, false once the retries are used up */
+static bool esp_ncp_zb_groupcast_frame_retry(esp_ncp_zb_groupcast_frame_t *frame)
+{
+    if (frame->retry >= ESP_NCP_ZB_GROUPCAST_RETRY
+        || esp_zb_scheduler_user_alarm(esp_ncp_zb_groupcast_frame_requeue, frame, ESP_NCP_ZB_GROUPCAST_RETRY_MS << frame->retry)
+           == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        return false;
+    }
+    frame->retry ++;
+
+    return true;
+}
+
+static void esp_ncp_zb_groupcast_frame_send(void *arg, bool drop)
+{
+    esp_ncp_zb_groupcast_frame_t *frame = (esp_ncp_zb_groupcast_frame_t *)arg;
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[frame->set];
+    bool current = set->used && set->token == frame->token;
+    esp_zb_zcl_groups_add_group_cmd_t group_req = {
+        .zcl_basic_cmd = frame->cmd.zcl_basic_cmd,
+        .address_mode = frame->cmd.address_mode,
+        .group_id = frame->cmd.custom_cmd_id,
+    };
+    uint8_t tsn = 0;
+
+    switch (frame->kind) {
+        case ESP_NCP_ZB_GROUPCAST_FRAME_COMMAND:
+            if (!drop) {
+                esp_zb_zcl_custom_cluster_cmd_req(&frame->cmd);
+            }
+            break;
+        case ESP_NCP_ZB_GROUPCAST_FRAME_ADD:
+            /* A dropped or stale add leaves the device to unicasts, the next use of the set asks it again */
+            if (!current || set->dev[frame->dev].state != ESP_NCP_ZB_GROUPCAST_PENDING) {
+                break;
+            }
+            if (drop) {
+                set->dev[frame->dev].state = ESP_NCP_ZB_GROUPCAST_UNKNOWN;
+            } else {
+                tsn = esp_zb_zcl_groups_add_group_cmd_req(&group_req);
+                set->dev[frame->dev].tsn = tsn;
+            }
+            break;
+        case ESP_NCP_ZB_GROUPCAST_FRAME_REMOVE:
+            if (!drop) {
+                tsn = esp_zb_zcl_groups_remove_group_cmd_req(&group_req);
+                s_groupcast_remove[s_groupcast_remove_next] = (esp_ncp_zb_groupcast_remove_t) {
+                    .used = true,
+                    .tsn = tsn,
+                    .addr = group_req.zcl_basic_cmd.dst_addr_u.addr_short,
+                    .group_id = group_req.group_id,
+                };
+                s_groupcast_remove_next = (s_groupcast_remove_next + 1) % ESP_NCP_ZB_GROUPCAST_REMOVE_TSN_MAX;
+            } else if (esp_ncp_zb_groupcast_frame_retry(frame)) {
+                return;
+            } else {
+                /* The ID stays unpurged, it is purged again before any set uses it */
+                s_groupcast_stats.remove_failed ++;
+                ESP_LOGW(TAG, "Remove device 0x%04x from group 0x%04x dropped", group_req.zcl_basic_cmd.dst_addr_u.addr_short,
+                         group_req.group_id);
+            }
+            s_groupcast_removing[group_req.group_id - ESP_NCP_ZB_GROUPCAST_GROUP_BASE] --;
+            break;
+        case ESP_NCP_ZB_GROUPCAST_FRAME_PURGE:
+            if (drop) {
+                if (esp_ncp_zb_groupcast_frame_retry(frame)) {
+                    return;
+                }
+                /* The next use of the set tries again */
+                if (current) {
+                    set->purging = false;
+                }
+                ESP_LOGW(TAG, "Purge of group 0x%04x dropped", group_req.group_id);
+                break;
+            }
+            esp_zb_zcl_groups_remove_group_cmd_req(&group_req);
+            if (current) {
+                esp_ncp_zb_groupcast_clean_set(group_req.group_id, true);
+                esp_zb_scheduler_user_alarm(esp_ncp_zb_groupcast_purge_done, (void *)(uintptr_t)((frame->token << 8) | frame->set),
+                                            ESP_NCP_ZB_GROUPCAST_PURGE_MS);
+            }
+            break;
+        default:
+            break;
+    }
+
+    free(frame);
+}
+
+static esp_err_t esp_ncp_zb_groupcast_frame_submit(uint8_t kind, uint8_t set_index, uint16_t dev_index, const esp_zb_zcl_custom_cluster_cmd_t *cmd,
+                                                   const void *value, uint16_t value_len)
+{
+    esp_ncp_zb_groupcast_frame_t *frame = esp_ncp_zb_groupcast_frame_new(kind, set_index, dev_index, cmd, value, value_len);
+
+    return frame ? esp_ncp_zb_groupcast_frame_queue(frame) : ESP_ERR_NO_MEM;
+}
+
+/* Group commands reuse the frame layout, the group ID travels in custom_cmd_id */
+static void esp_ncp_zb_groupcast_group_submit(uint8_t kind, uint8_t set_index, uint16_t dev_index, uint8_t src_endpoint)
+{
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[set_index];
+    esp_zb_zcl_custom_cluster_cmd_t cmd = {
+        .zcl_basic_cmd = {
+            .dst_addr_u.addr_short = set->dev[dev_index].addr,
+            .dst_endpoint = set->endpoint,
+            .src_endpoint = src_endpoint,
+        },
+        .address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT,
+        .custom_cmd_id = set->group_id,
+    };
+
+    esp_ncp_zb_groupcast_frame_submit(kind, set_index, dev_index, &cmd, NULL, sizeof(uint16_t));
+}
+
+static void esp_ncp_zb_groupcast_release(uint8_t set_index, uint8_t src_endpoint)
+{
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[set_index];
+
+    if (set->group_id) {
+        for (int i = 0; i < set->dev_count; i ++) {
+            if (set->dev[i].state == ESP_NCP_ZB_GROUPCAST_MEMBER || set->dev[i].state == ESP_NCP_ZB_GROUPCAST_PENDING) {
+                esp_ncp_zb_groupcast_group_submit(ESP_NCP_ZB_GROUPCAST_FRAME_REMOVE, set_index, i, src_endpoint);
+            }
+        }
+        esp_ncp_zb_groupcast_clean_set(set->group_id, false);
+        s_groupcast_stats.groups --;
+    }
+
+    set->used = false;
+    s_groupcast_stats.sets --;
+}
+
+/* Finds the set holding exactly these sorted devices, or claims a free or the least recently used one */
+static int esp_ncp_zb_groupcast_find(uint8_t endpoint, const uint16_t *sorted, uint16_t dev_count, uint8_t src_endpoint)
+{
+    int victim = -1;
+
+    for (int i = 0; i < ESP_NCP_ZB_GROUPCAST_SET_MAX; i ++) {
+        esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[i];
+
+        if (!set->used) {
+            victim = (victim < 0 || s_groupcast_set[victim].used) ? i : victim;
+            continue;
+        }
+
+        if (set->endpoint == endpoint && set->dev_count == dev_count) {
+            int j = 0;
+            while (j < dev_count && set->dev[j].addr == sorted[j]) {
+                j ++;
+            }
+            if (j == dev_count) {
+                return i;
+            }
+        }
+
+        if (victim < 0 || (s_groupcast_set[victim].used && (int32_t)(set->last_use - s_groupcast_set[victim].last_use) < 0)) {
+            victim = i;
+        }
+    }
+
+    if (s_groupcast_set[victim].used) {
+        esp_ncp_zb_groupcast_release(victim, src_endpoint);
+    }
+
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[victim];
+    memset(set, 0, sizeof(esp_ncp_zb_groupcast_set_t));
+    set->used = true;
+    set->endpoint = endpoint;
+    set->token = ++ s_groupcast_token;
+    set->dev_count = dev_count;
+    for (int i = 0; i < dev_count; i ++) {
+        set->dev[i].addr = sorted[i];
+    }
+    s_groupcast_stats.sets ++;
+
+    return victim;
+}
+
+/* Picks the next group ID no set holds and no evicted set is still leaving, going round the range */
+static uint16_t esp_ncp_zb_groupcast_group_alloc(void)
+{
+    for (int n = 0; n < ESP_NCP_ZB_GROUPCAST_GROUP_RANGE; n ++) {
+        uint16_t group_id = ESP_NCP_ZB_GROUPCAST_GROUP_BASE + (s_groupcast_group ++ % ESP_NCP_ZB_GROUPCAST_GROUP_RANGE);
+        bool held = s_groupcast_removing[group_id - ESP_NCP_ZB_GROUPCAST_GROUP_BASE] > 0;
+
+        for (int i = 0; i < ESP_NCP_ZB_GROUPCAST_SET_MAX && !held; i ++) {
+            held = s_groupcast_set[i].used && s_groupcast_set[i].group_id == group_id;
+        }
+        if (!held) {
+            return group_id;
+        }
+    }
+
+    return 0;
+}
+
+static void esp_ncp_zb_groupcast_promote(uint8_t set_index, uint8_t src_endpoint)
+{
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[set_index];
+
+    set->src_endpoint = src_endpoint;
+    if (!set->group_id) {
+        set->group_id = esp_ncp_zb_groupcast_group_alloc();
+        if (!set->group_id) {
+            /* Every ID is held or still leaving, the set keeps its unicasts until the next use */
+            return;
+        }
+        s_groupcast_stats.groups ++;
+        ESP_LOGI(TAG, "Promote %d devices on endpoint %d to group 0x%04x", set->dev_count, set->endpoint, set->group_id);
+    }
+
+    if (set->purging) {
+        return;
+    }
+
+    /* Devices left in the group by an evicted set or by a reboot leave it before the members are added */
+    if (!esp_ncp_zb_groupcast_clean_get(set->group_id)) {
+        esp_zb_zcl_custom_cluster_cmd_t cmd = {
+            .zcl_basic_cmd = {
+                .dst_addr_u.addr_short = set->group_id,
+                .src_endpoint = src_endpoint,
+            },
+            .address_mode = ESP_ZB_APS_ADDR_MODE_16_GROUP_ENDP_NOT_PRESENT,
+            .custom_cmd_id = set->group_id,
+        };
+        esp_ncp_zb_groupcast_frame_t *frame = esp_ncp_zb_groupcast_frame_new(ESP_NCP_ZB_GROUPCAST_FRAME_PURGE, set_index, 0, &cmd,
+                                                                            NULL, sizeof(uint16_t));
+
+        if (frame) {
+            set->purging = true;
+            esp_ncp_zb_groupcast_frame_queue(frame);
+        }
+        return;
+    }
+
+    for (int i = 0; i < set->dev_count; i ++) {
+        if (set->dev[i].state == ESP_NCP_ZB_GROUPCAST_UNKNOWN) {
+            set->dev[i].state = ESP_NCP_ZB_GROUPCAST_PENDING;
+            esp_ncp_zb_groupcast_group_submit(ESP_NCP_ZB_GROUPCAST_FRAME_ADD, set_index, i, src_endpoint);
+        }
+    }
+}
+
+static void esp_ncp_zb_groupcast_purge_done(void *arg)
+{
+    uintptr_t tag = (uintptr_t)arg;
+    uint8_t set_index = tag & 0xFF;
+    esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[set_index];
+
+    if (set->used && set->token == (uint16_t)(tag >> 8) && set->purging) {
+        set->purging = false;
+        esp_ncp_zb_groupcast_promote(set_index, set->src_endpoint);
+    }
+}
+
+/* Sets the bit of every entry of dev with this address, a device listed twice got the command once */
+static void esp_ncp_zb_groupcast_sent_set(const uint16_t *dev, uint16_t dev_count, uint16_t addr, uint8_t *sent)
+{
+    for (int i = 0; i < dev_count; i ++) {
+        if (dev[i] == addr) {
+            sent[i / 8] |= (1 << (i % 8));
+        }
+    }
+}
+
+esp_err_t esp_ncp_zb_groupcast_send(const esp_zb_zcl_custom_cluster_cmd_t *cmd, uint16_t value_len, const uint16_t *dev, uint16_t dev_count,
+                                    esp_ncp_zb_groupcast_result_t *result, uint8_t *sent)
+{
+    ESP_RETURN_ON_FALSE(cmd && dev && dev_count && result && sent, ESP_ERR_INVALID_ARG, TAG, "Invalid groupcast argument");
+
+    esp_zb_zcl_custom_cluster_cmd_t cmd_req = *cmd;
+    uint16_t frame_cost = ESP_NCP_ZB_SCHED_FRAME_OVERHEAD + value_len;
+    uint16_t sorted[ESP_NCP_ZB_GROUPCAST_MAX_DEV];
+    esp_ncp_zb_groupcast_set_t *set = NULL;
+    uint16_t members = 0;
+    int set_index = -1;
+
+    memset(result, 0, sizeof(esp_ncp_zb_groupcast_result_t));
+    cmd_req.address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
+
+    /* Larger lists are not consolidated, every device gets a unicast */
+    if (dev_count <= ESP_NCP_ZB_GROUPCAST_MAX_DEV) {
+        uint16_t count = 0;
+
+        for (int i = 0; i < dev_count; i ++) {
+            int j = count;
+            while (j > 0 && sorted[j - 1] > dev[i]) {
+                sorted[j] = sorted[j - 1];
+                j --;
+            }
+            if (j > 0 && sorted[j - 1] == dev[i]) {
+                memmove(&sorted[j], &sorted[j + 1], (count - j) * sizeof(uint16_t));
+                continue;
+            }
+            sorted[j] = dev[i];
+            count ++;
+        }
+
+        set_index = esp_ncp_zb_groupcast_find(cmd->zcl_basic_cmd.dst_endpoint, sorted, count, cmd->zcl_basic_cmd.src_endpoint);
+        set = &s_groupcast_set[set_index];
+        set->uses ++;
+        set->last_use = xTaskGetTickCount();
+
+        for (int i = 0; i < set->dev_count; i ++) {
+            members += (set->dev[i].state == ESP_NCP_ZB_GROUPCAST_MEMBER) ? 1 : 0;
+        }
+    }
+
+    /* A groupcast only pays off when it replaces more unicasts than its own broadcast cost */
+    if (members > ESP_NCP_ZB_SCHED_BROADCAST_FACTOR) {
+        cmd_req.address_mode = ESP_ZB_APS_ADDR_MODE_16_GROUP_ENDP_NOT_PRESENT;
+        cmd_req.zcl_basic_cmd.dst_addr_u.addr_short = set->group_id;
+        if (esp_ncp_zb_groupcast_frame_submit(ESP_NCP_ZB_GROUPCAST_FRAME_COMMAND, set_index, 0, &cmd_req, cmd->data.value, value_len) == ESP_OK) {
+            result->group_id = set->group_id;
+            result->saved = members - 1;
+            s_groupcast_stats.groupcast ++;
+            s_groupcast_stats.frames_saved += result->saved;
+            s_groupcast_stats.bytes_saved += (int32_t)frame_cost * (members - ESP_NCP_ZB_SCHED_BROADCAST_FACTOR);
+        } else {
+            ESP_LOGW(TAG, "Groupcast to 0x%04x dropped, the members get unicasts", set->group_id);
+        }
+        cmd_req.address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
+    }
+
+    for (int i = 0; i < (set ? set->dev_count : dev_count); i ++) {
+        cmd_req.zcl_basic_cmd.dst_addr_u.addr_short = set ? set->dev[i].addr : dev[i];
+        if (result->group_id && set->dev[i].state == ESP_NCP_ZB_GROUPCAST_MEMBER) {
+            esp_ncp_zb_groupcast_sent_set(dev, dev_count, cmd_req.zcl_basic_cmd.dst_addr_u.addr_short, sent);
+            continue;
+        }
+        /* The commands are of the highest class, a frame queued is never evicted afterwards */
+        if (esp_ncp_zb_groupcast_frame_submit(ESP_NCP_ZB_GROUPCAST_FRAME_COMMAND, (set_index < 0) ? 0 : set_index, i, &cmd_req,
+                                              cmd->data.value, value_len) == ESP_OK) {
+            result->unicast ++;
+            esp_ncp_zb_groupcast_sent_set(dev, dev_count, cmd_req.zcl_basic_cmd.dst_addr_u.addr_short, sent);
+        } else {
+            result->failed ++;
+        }
+    }
+    s_groupcast_stats.unicast += result->unicast;
+
+    if (set && set->uses >= ESP_NCP_ZB_GROUPCAST_PROMOTE) {
+        esp_ncp_zb_groupcast_promote(set_index, cmd->zcl_basic_cmd.src_endpoint);
+    }
+
+    return result->failed ? ESP_ERR_NO_MEM : ESP_OK;
+}
+
+bool esp_ncp_zb_groupcast_handle(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    const esp_zb_zcl_groups_operate_group_resp_message_t *resp = (const esp_zb_zcl_groups_operate_group_resp_message_t *)message;
+
+    if (callback_id != ESP_ZB_CORE_CMD_OPERATE_GROUP_RESP_CB_ID || !message) {
+        return false;
+    }
+
+    for (int i = 0; i < ESP_NCP_ZB_GROUPCAST_SET_MAX; i ++) {
+        esp_ncp_zb_groupcast_set_t *set = &s_groupcast_set[i];
+
+        if (!set->used || set->group_id != resp->group_id) {
+            continue;
+        }
+
+        for (int j = 0; j < set->dev_count; j ++) {
+            esp_ncp_zb_groupcast_dev_t *dev = &set->dev[j];
+
+            if (dev->state != ESP_NCP_ZB_GROUPCAST_PENDING || dev->addr != resp->info.src_address.u.short_addr
+                || dev->tsn != resp->info.header.tsn) {
+                continue;
+            }
+
+            /* A device whose purge was lost on the air is still in the group and answers duplicate */
+            if (resp->info.status == ESP_ZB_ZCL_STATUS_SUCCESS || resp->info.status == ESP_ZB_ZCL_STATUS_DUPE_EXISTS) {
+                dev->state = ESP_NCP_ZB_GROUPCAST_MEMBER;
+            } else {
+                dev->state = ESP_NCP_ZB_GROUPCAST_FAILED;
+                ESP_LOGW(TAG, "Device 0x%04x refused group 0x%04x, status 0x%x", dev->addr, set->group_id, resp->info.status);
+            }
+            return true;
+        }
+    }
+
+    /* Responses to the remove group commands of evicted sets are consumed too, the host gets those of its own commands */
+    for (int i = 0; i < ESP_NCP_ZB_GROUPCAST_REMOVE_TSN_MAX; i ++) {
+        esp_ncp_zb_groupcast_remove_t *remove = &s_groupcast_remove[i];
+
+        if (remove->used && remove->tsn == resp->info.header.tsn && remove->addr == resp->info.src_address.u.short_addr
+            && remove->group_id == resp->group_id) {
+            remove->used = false;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void esp_ncp_zb_groupcast_stats_get(esp_ncp_zb_groupcast_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &s_groupcast_stats, sizeof(esp_ncp_zb_groupcast_stats_t));
+    }
+}
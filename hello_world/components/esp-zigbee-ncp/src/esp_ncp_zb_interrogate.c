@@ -0,0 +1,398 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_random.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_frame.h"
+#include "esp_ncp_zb.h"
+#include "esp_ncp_zb_interrogate.h"
+
+static const char *TAG = "ESP_NCP_ZB_INTERROGATE";
+
+typedef enum {
+    ESP_NCP_ZB_INTERROGATE_NODE_DESC,           /*!< Waiting for the node descriptor */
+    ESP_NCP_ZB_INTERROGATE_ACTIVE_EP,           /*!< Waiting for the active endpoint list */
+    ESP_NCP_ZB_INTERROGATE_SIMPLE_DESC,         /*!< Waiting for the simple descriptor of one endpoint */
+} esp_ncp_zb_interrogate_stage_t;
+
+typedef struct {
+    uint16_t                short_addr;         /*!< The short address of the device */
+    uint8_t                 status;             /*!< The ZDP status of the interrogation, refer to esp_zb_zdp_status_t */
+    uint8_t                 ep_count;           /*!< The number of endpoint records which follow */
+    esp_zb_af_node_desc_t   node_desc;          /*!< The node descriptor of the device */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_device_profile_t;
+
+typedef struct {
+    uint8_t                 endpoint;           /*!< Endpoint */
+    uint16_t                profile_id;         /*!< Application profile identifier */
+    uint16_t                device_id;          /*!< Application device identifier */
+    uint8_t                 device_version;     /*!< Application device version */
+    uint8_t                 input_count;        /*!< Application input cluster count */
+    uint8_t                 output_count;       /*!< Application output cluster count, the input and output cluster IDs follow */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_device_profile_ep_t;
+
+typedef struct {
+    bool        used;                           /*!< The slot interrogates a device */
+    uint8_t     token;                          /*!< Changed with every request so that a stale callback is dropped */
+    uint8_t     stage;                          /*!< The stage of the interrogation, refer to esp_ncp_zb_interrogate_stage_t */
+    uint8_t     retries;                        /*!< The remaining retries of the request in flight */
+    uint8_t     ep_count;                       /*!< The number of active endpoints */
+    uint8_t     ep_index;                       /*!< The index of the endpoint whose simple descriptor is requested */
+    bool        partial;                        /*!< Some endpoints are missing from the profile */
+    esp_zb_user_cb_handle_t deadline;           /*!< The alarm which gives up the request in flight when no answer comes */
+    uint8_t     ep_list[ESP_NCP_ZB_INTERROGATE_MAX_EP]; /*!< The active endpoints */
+    uint16_t    profile_len;                    /*!< The length of the device profile */
+    uint8_t     *profile;                       /*!< The device profile reported to the host */
+} esp_ncp_zb_interrogate_slot_t;
+
+typedef struct {
+    bool        auto_enable;                    /*!< Interrogate every device which announces itself */
+    uint8_t     concurrency;                    /*!< The number of devices interrogated at the same time */
+    uint8_t     retries;                        /*!< The number of retries of one ZDO request */
+    uint8_t     active;                         /*!< The number of devices interrogated at the moment */
+    uint16_t    head;                           /*!< The index of the first queued device */
+    uint16_t    count;                          /*!< The number of queued devices */
+    uint16_t    queue[ESP_NCP_ZB_INTERROGATE_QUEUE_LEN]; /*!< The queued devices */
+    esp_ncp_zb_interrogate_slot_t slot[ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE]; /*!< The devices interrogated at the moment */
+} esp_ncp_zb_interrogate_t;
+
+static esp_ncp_zb_interrogate_t s_interrogate = {
+    .concurrency = ESP_NCP_ZB_INTERROGATE_CONCURRENCY,
+    .retries = ESP_NCP_ZB_INTERROGATE_RETRIES,
+};
+
+static void esp_ncp_zb_interrogate_issue(uint8_t index);
+
+static uint16_t esp_ncp_zb_interrogate_addr(const esp_ncp_zb_interrogate_slot_t *slot)
+{
+    return ((const esp_ncp_zb_device_profile_t *)slot->profile)->short_addr;
+}
+
+/* The user context of a ZDO request carries the slot index and the token of the request */
+static esp_ncp_zb_interrogate_slot_t *esp_ncp_zb_interrogate_slot(void *user_ctx, uint8_t *index)
+{
+    uintptr_t ctx = (uintptr_t)user_ctx;
+    esp_ncp_zb_interrogate_slot_t *slot = NULL;
+
+    *index = (ctx >> 8) & 0xFF;
+    if (*index < ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE) {
+        slot = &s_interrogate.slot[*index];
+        if (!slot->used || slot->token != (ctx & 0xFF)) {
+            slot = NULL;
+        }
+    }
+
+    return slot;
+}
+
+static void esp_ncp_zb_interrogate_pump(void)
+{
+    for (uint8_t index = 0; index < ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE && s_interrogate.count
+                            && s_interrogate.active < s_interrogate.concurrency; index ++) {
+        esp_ncp_zb_interrogate_slot_t *slot = &s_interrogate.slot[index];
+        esp_ncp_zb_device_profile_t *profile = NULL;
+
+        if (slot->used) {
+            continue;
+        }
+
+        slot->profile = calloc(1, sizeof(esp_ncp_zb_device_profile_t));
+        if (!slot->profile) {
+            ESP_LOGE(TAG, "No memory for the device profile");
+            break;
+        }
+
+        profile = (esp_ncp_zb_device_profile_t *)slot->profile;
+        profile->short_addr = s_interrogate.queue[s_interrogate.head];
+        s_interrogate.head = (s_interrogate.head + 1) % ESP_NCP_ZB_INTERROGATE_QUEUE_LEN;
+        s_interrogate.count --;
+
+        slot->used = true;
+        slot->stage = ESP_NCP_ZB_INTERROGATE_NODE_DESC;
+        slot->retries = s_interrogate.retries;
+        slot->ep_count = 0;
+        slot->ep_index = 0;
+        slot->partial = false;
+        slot->profile_len = sizeof(esp_ncp_zb_device_profile_t);
+        s_interrogate.active ++;
+
+        esp_ncp_zb_interrogate_issue(index);
+    }
+}
+
+static void esp_ncp_zb_interrogate_deadline_stop(esp_ncp_zb_interrogate_slot_t *slot)
+{
+    if (slot->deadline != ESP_ZB_USER_CB_HANDLE_INVALID) {
+        esp_zb_scheduler_user_alarm_cancel(slot->deadline);
+        slot->deadline = ESP_ZB_USER_CB_HANDLE_INVALID;
+    }
+}
+
+static void esp_ncp_zb_interrogate_finish(esp_ncp_zb_interrogate_slot_t *slot, uint8_t status)
+{
+    esp_ncp_header_t ncp_header = {
+        .sn = esp_random() % 0xFF,
+        .id = ESP_NCP_ZDO_DEVICE_PROFILE,
+    };
+    esp_ncp_zb_device_profile_t *profile = (esp_ncp_zb_device_profile_t *)slot->profile;
+
+    esp_ncp_zb_interrogate_deadline_stop(slot);
+    profile->status = status;
+    ESP_LOGD(TAG, "Device(0x%04hx) interrogated: status(0x%x), endpoints(%d)", profile->short_addr, status, profile->ep_count);
+    esp_ncp_noti_input(&ncp_header, slot->profile, slot->profile_len);
+
+    free(slot->profile);
+    slot->profile = NULL;
+    slot->used = false;
+    s_interrogate.active --;
+
+    esp_ncp_zb_interrogate_pump();
+}
+
+static void esp_ncp_zb_interrogate_retry_cb(void *user_ctx)
+{
+    uint8_t index = 0;
+
+    if (esp_ncp_zb_interrogate_slot(user_ctx, &index)) {
+        esp_ncp_zb_interrogate_issue(index);
+    }
+}
+
+/* Retries the request in flight after a backoff, or completes the device with the failure status when no retry is left */
+static void esp_ncp_zb_interrogate_fail(esp_ncp_zb_interrogate_slot_t *slot, uint8_t index, uint8_t status)
+{
+    if (slot->retries) {
+        uint8_t attempt = s_interrogate.retries - slot->retries;
+        uint32_t delay = ESP_NCP_ZB_INTERROGATE_BACKOFF_MS << (attempt < 4 ? attempt : 4);
+
+        /* A new token, so that a late answer to the failed request is dropped while waiting */
+        slot->retries --;
+        slot->token ++;
+        if (esp_zb_scheduler_user_alarm(esp_ncp_zb_interrogate_retry_cb, (void *)(uintptr_t)((index << 8) | slot->token), delay)
+            == ESP_ZB_USER_CB_HANDLE_INVALID) {
+            esp_ncp_zb_interrogate_issue(index);
+        }
+    } else {
+        esp_ncp_zb_interrogate_finish(slot, status);
+    }
+}
+
+/* The stack does not always call back a ZDO request whose device is gone, the deadline fails it as a timeout */
+static void esp_ncp_zb_interrogate_deadline_cb(void *user_ctx)
+{
+    uint8_t index = 0;
+    esp_ncp_zb_interrogate_slot_t *slot = esp_ncp_zb_interrogate_slot(user_ctx, &index);
+
+    if (slot) {
+        slot->deadline = ESP_ZB_USER_CB_HANDLE_INVALID;
+        ESP_LOGD(TAG, "Device(0x%04hx) did not answer stage %d", esp_ncp_zb_interrogate_addr(slot), slot->stage);
+        esp_ncp_zb_interrogate_fail(slot, index, ESP_ZB_ZDP_STATUS_TIMEOUT);
+    }
+}
+
+static void esp_ncp_zb_interrogate_next_ep(esp_ncp_zb_interrogate_slot_t *slot, uint8_t index)
+{
+    if (slot->ep_index < slot->ep_count) {
+        slot->stage = ESP_NCP_ZB_INTERROGATE_SIMPLE_DESC;
+        slot->retries = s_interrogate.retries;
+        esp_ncp_zb_interrogate_issue(index);
+    } else {
+        esp_ncp_zb_interrogate_finish(slot, slot->partial ? ESP_ZB_ZDP_STATUS_INSUFFICIENT_SPACE : ESP_ZB_ZDP_STATUS_SUCCESS);
+    }
+}
+
+static void esp_ncp_zb_interrogate_node_desc_cb(esp_zb_zdp_status_t zdo_status, uint16_t addr, esp_zb_af_node_desc_t *node_desc, void *user_ctx)
+{
+    uint8_t index = 0;
+    esp_ncp_zb_interrogate_slot_t *slot = esp_ncp_zb_interrogate_slot(user_ctx, &index);
+
+    if (!slot) {
+        return;
+    }
+    esp_ncp_zb_interrogate_deadline_stop(slot);
+
+    if (zdo_status != ESP_ZB_ZDP_STATUS_SUCCESS || !node_desc) {
+        esp_ncp_zb_interrogate_fail(slot, index, zdo_status);
+        return;
+    }
+
+    memcpy(&((esp_ncp_zb_device_profile_t *)slot->profile)->node_desc, node_desc, sizeof(esp_zb_af_node_desc_t));
+    slot->stage = ESP_NCP_ZB_INTERROGATE_ACTIVE_EP;
+    slot->retries = s_interrogate.retries;
+    esp_ncp_zb_interrogate_issue(index);
+}
+
+static void esp_ncp_zb_interrogate_active_ep_cb(esp_zb_zdp_status_t zdo_status, uint8_t ep_count, uint8_t *ep_id_list, void *user_ctx)
+{
+    uint8_t index = 0;
+    esp_ncp_zb_interrogate_slot_t *slot = esp_ncp_zb_interrogate_slot(user_ctx, &index);
+
+    if (!slot) {
+        return;
+    }
+    esp_ncp_zb_interrogate_deadline_stop(slot);
+
+    if (zdo_status != ESP_ZB_ZDP_STATUS_SUCCESS) {
+        esp_ncp_zb_interrogate_fail(slot, index, zdo_status);
+        return;
+    }
+
+    if (ep_count > ESP_NCP_ZB_INTERROGATE_MAX_EP) {
+        ESP_LOGW(TAG, "Device(0x%04hx) has %d endpoints, only %d are described", esp_ncp_zb_interrogate_addr(slot), ep_count,
+                        ESP_NCP_ZB_INTERROGATE_MAX_EP);
+        ep_count = ESP_NCP_ZB_INTERROGATE_MAX_EP;
+        slot->partial = true;
+    }
+
+    slot->ep_count = ep_id_list ? ep_count : 0;
+    if (slot->ep_count) {
+        memcpy(slot->ep_list, ep_id_list, slot->ep_count);
+    }
+    esp_ncp_zb_interrogate_next_ep(slot, index);
+}
+
+static void esp_ncp_zb_interrogate_simple_desc_cb(esp_zb_zdp_status_t zdo_status, esp_zb_af_simple_desc_1_1_t *simple_desc, void *user_ctx)
+{
+    uint8_t index = 0;
+    esp_ncp_zb_interrogate_slot_t *slot = esp_ncp_zb_interrogate_slot(user_ctx, &index);
+
+    if (!slot) {
+        return;
+    }
+    esp_ncp_zb_interrogate_deadline_stop(slot);
+
+    if (zdo_status != ESP_ZB_ZDP_STATUS_SUCCESS || !simple_desc) {
+        esp_ncp_zb_interrogate_fail(slot, index, zdo_status);
+        return;
+    }
+
+    uint16_t cluster_len = (simple_desc->app_input_cluster_count + simple_desc->app_output_cluster_count) * sizeof(uint16_t);
+    uint16_t length = slot->profile_len + sizeof(esp_ncp_zb_device_profile_ep_t) + cluster_len;
+    uint8_t *profile = realloc(slot->profile, length);
+
+    if (profile) {
+        esp_ncp_zb_device_profile_ep_t *ep = (esp_ncp_zb_device_profile_ep_t *)&profile[slot->profile_len];
+
+        ep->endpoint = simple_desc->endpoint;
+        ep->profile_id = simple_desc->app_profile_id;
+        ep->device_id = simple_desc->app_device_id;
+        ep->device_version = simple_desc->app_device_version;
+        ep->input_count = simple_desc->app_input_cluster_count;
+        ep->output_count = simple_desc->app_output_cluster_count;
+        memcpy(&profile[slot->profile_len + sizeof(esp_ncp_zb_device_profile_ep_t)], simple_desc->app_cluster_list, cluster_len);
+
+        ((esp_ncp_zb_device_profile_t *)profile)->ep_count ++;
+        slot->profile = profile;
+        slot->profile_len = length;
+    } else {
+        ESP_LOGE(TAG, "No memory for the simple descriptor of device(0x%04hx)", esp_ncp_zb_interrogate_addr(slot));
+        slot->partial = true;
+    }
+
+    slot->ep_index ++;
+    esp_ncp_zb_interrogate_next_ep(slot, index);
+}
+
+static void esp_ncp_zb_interrogate_issue(uint8_t index)
+{
+    esp_ncp_zb_interrogate_slot_t *slot = &s_interrogate.slot[index];
+    uint16_t short_addr = esp_ncp_zb_interrogate_addr(slot);
+    void *user_ctx = NULL;
+
+    slot->token ++;
+    user_ctx = (void *)(uintptr_t)((index << 8) | slot->token);
+    slot->deadline = esp_zb_scheduler_user_alarm(esp_ncp_zb_interrogate_deadline_cb, user_ctx, ESP_NCP_ZB_INTERROGATE_TIMEOUT_MS);
+    if (slot->deadline == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        ESP_LOGW(TAG, "No deadline for device(0x%04hx), it waits for the stack to answer", short_addr);
+    }
+
+    switch (slot->stage) {
+        case ESP_NCP_ZB_INTERROGATE_NODE_DESC: {
+            esp_zb_zdo_node_desc_req_param_t node_desc_req = {
+                .dst_nwk_addr = short_addr,
+            };
+            esp_zb_zdo_node_desc_req(&node_desc_req, esp_ncp_zb_interrogate_node_desc_cb, user_ctx);
+            break;
+        }
+        case ESP_NCP_ZB_INTERROGATE_ACTIVE_EP: {
+            esp_zb_zdo_active_ep_req_param_t active_ep_req = {
+                .addr_of_interest = short_addr,
+            };
+            esp_zb_zdo_active_ep_req(&active_ep_req, esp_ncp_zb_interrogate_active_ep_cb, user_ctx);
+            break;
+        }
+        case ESP_NCP_ZB_INTERROGATE_SIMPLE_DESC: {
+            esp_zb_zdo_simple_desc_req_param_t simple_desc_req = {
+                .addr_of_interest = short_addr,
+                .endpoint = slot->ep_list[slot->ep_index],
+            };
+            esp_zb_zdo_simple_desc_req(&simple_desc_req, esp_ncp_zb_interrogate_simple_desc_cb, user_ctx);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+esp_err_t esp_ncp_zb_interrogate_config(bool auto_enable, uint8_t concurrency, uint8_t retries)
+{
+    if (!concurrency) {
+        concurrency = ESP_NCP_ZB_INTERROGATE_CONCURRENCY;
+    }
+    ESP_RETURN_ON_FALSE(concurrency <= ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE, ESP_ERR_INVALID_ARG, TAG, "Invalid concurrency(%d)", concurrency);
+
+    s_interrogate.auto_enable = auto_enable;
+    s_interrogate.concurrency = concurrency;
+    s_interrogate.retries = retries;
+
+    esp_ncp_zb_interrogate_pump();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ncp_zb_interrogate_add(uint16_t short_addr)
+{
+    /* A device announcing several times while waiting is interrogated once */
+    for (uint8_t index = 0; index < ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE; index ++) {
+        if (s_interrogate.slot[index].used && esp_ncp_zb_interrogate_addr(&s_interrogate.slot[index]) == short_addr) {
+            return ESP_OK;
+        }
+    }
+
+    for (uint16_t i = 0; i < s_interrogate.count; i ++) {
+        if (s_interrogate.queue[(s_interrogate.head + i) % ESP_NCP_ZB_INTERROGATE_QUEUE_LEN] == short_addr) {
+            return ESP_OK;
+        }
+    }
+
+    ESP_RETURN_ON_FALSE(s_interrogate.count < ESP_NCP_ZB_INTERROGATE_QUEUE_LEN, ESP_ERR_NO_MEM, TAG, "Interrogation queue is full");
+
+    s_interrogate.queue[(s_interrogate.head + s_interrogate.count) % ESP_NCP_ZB_INTERROGATE_QUEUE_LEN] = short_addr;
+    s_interrogate.count ++;
+
+    esp_ncp_zb_interrogate_pump();
+
+    return ESP_OK;
+}
+
+uint16_t esp_ncp_zb_interrogate_room(void)
+{
+    return ESP_NCP_ZB_INTERROGATE_QUEUE_LEN - s_interrogate.count;
+}
+
+void esp_ncp_zb_interrogate_device_annce(uint16_t short_addr)
+{
+    if (s_interrogate.auto_enable) {
+        esp_ncp_zb_interrogate_add(short_addr);
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_random.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_frame.h"
+#include "esp_ncp_zb.h"
+#include "esp_ncp_zb_join.h"
+
+static const char *TAG = "ESP_NCP_ZB_JOIN";
+
+typedef struct {
+    uint16_t                seq;                /*!< The batch sequence number, the host detects a lost batch by a gap */
+    uint8_t                 count;              /*!< The number of device records following the batch */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_join_batch_t;
+
+typedef struct {
+    esp_zb_ieee_addr_t      ieee_addr;          /*!< The long address of the device */
+    uint16_t                short_addr;         /*!< The short address of the device */
+    uint8_t                 event;              /*!< The last event of the device, refer to esp_ncp_zb_join_event_t */
+    uint8_t                 info;               /*!< The capability of an announce, or 1 for a leave with rejoin */
+    uint8_t                 repeats;            /*!< The number of events of the device merged into this record */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_join_record_t;
+
+typedef struct {
+    bool                    enable;             /*!< Batch the join and leave events */
+    uint8_t                 max_records;        /*!< The number of devices which flushes a batch */
+    uint16_t                flush_ms;           /*!< The time a batch is held after its first event */
+    uint16_t                seq;                /*!< The sequence number of the next batch */
+    esp_zb_user_cb_handle_t alarm;              /*!< The alarm flushing the batch on time */
+    uint8_t                 count;              /*!< The number of devices in the batch */
+    esp_ncp_zb_join_record_t record[ESP_NCP_ZB_JOIN_BATCH_MAX]; /*!< The devices of the batch */
+} esp_ncp_zb_join_t;
+
+static esp_ncp_zb_join_t s_join = {
+    .max_records = ESP_NCP_ZB_JOIN_BATCH_MAX,
+    .flush_ms = ESP_NCP_ZB_JOIN_FLUSH_MS,
+    .alarm = ESP_ZB_USER_CB_HANDLE_INVALID,
+};
+
+static void esp_ncp_zb_join_flush_cb(void *param)
+{
+    s_join.alarm = ESP_ZB_USER_CB_HANDLE_INVALID;
+    esp_ncp_zb_join_flush();
+}
+
+void esp_ncp_zb_join_flush(void)
+{
+    esp_ncp_header_t ncp_header = {
+        .sn = esp_random() % 0xFF,
+        .id = ESP_NCP_NETWORK_JOIN_BATCH,
+    };
+    uint16_t outlen = sizeof(esp_ncp_zb_join_batch_t) + s_join.count * sizeof(esp_ncp_zb_join_record_t);
+    uint8_t *output = NULL;
+
+    if (s_join.alarm != ESP_ZB_USER_CB_HANDLE_INVALID) {
+        esp_zb_scheduler_user_alarm_cancel(s_join.alarm);
+        s_join.alarm = ESP_ZB_USER_CB_HANDLE_INVALID;
+    }
+
+    if (!s_join.count) {
+        return;
+    }
+
+    output = calloc(1, outlen);
+    if (output) {
+        esp_ncp_zb_join_batch_t *batch = (esp_ncp_zb_join_batch_t *)output;
+        batch->seq = s_join.seq;
+        batch->count = s_join.count;
+        memcpy(output + sizeof(esp_ncp_zb_join_batch_t), s_join.record, s_join.count * sizeof(esp_ncp_zb_join_record_t));
+        esp_ncp_noti_input(&ncp_header, output, outlen);
+        free(output);
+    } else {
+        ESP_LOGE(TAG, "No memory for the join batch %d, %d devices lost", s_join.seq, s_join.count);
+    }
+
+    /* A batch lost for lack of memory still takes its sequence number, so the host sees the gap */
+    s_join.seq ++;
+    s_join.count = 0;
+}
+
+/* Merges the event into the record of the same device, so the batch holds the last state of every device */
+static void esp_ncp_zb_join_add(const esp_zb_ieee_addr_t ieee_addr, uint16_t short_addr, uint8_t event, uint8_t info)
+{
+    esp_ncp_zb_join_record_t *record = NULL;
+
+    for (int i = 0; i < s_join.count; i ++) {
+        if (!memcmp(s_join.record[i].ieee_addr, ieee_addr, sizeof(esp_zb_ieee_addr_t))) {
+            record = &s_join.record[i];
+            record->repeats += (record->repeats < UINT8_MAX) ? 1 : 0;
+            break;
+        }
+    }
+
+    if (!record) {
+        record = &s_join.record[s_join.count ++];
+        memcpy(record->ieee_addr, ieee_addr, sizeof(esp_zb_ieee_addr_t));
+        record->repeats = 0;
+    }
+    record->short_addr = short_addr;
+    record->event = event;
+    record->info = info;
+
+    if (s_join.count >= s_join.max_records) {
+        esp_ncp_zb_join_flush();
+    } else if (s_join.alarm == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        s_join.alarm = esp_zb_scheduler_user_alarm(esp_ncp_zb_join_flush_cb, NULL, s_join.flush_ms);
+    }
+}
+
+esp_err_t esp_ncp_zb_join_config(bool enable, uint8_t max_records, uint16_t flush_ms)
+{
+    ESP_RETURN_ON_FALSE(max_records <= ESP_NCP_ZB_JOIN_BATCH_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid batch size %d", max_records);
+
+    esp_ncp_zb_join_flush();
+    s_join.enable = enable;
+    s_join.max_records = max_records ? max_records : s_join.max_records;
+    s_join.flush_ms = flush_ms ? flush_ms : s_join.flush_ms;
+
+    return ESP_OK;
+}
+
+bool esp_ncp_zb_join_device_annce(const esp_zb_zdo_signal_device_annce_params_t *params)
+{
+    if (s_join.enable && params) {
+        esp_ncp_zb_join_add(params->ieee_addr, params->device_short_addr, ESP_NCP_ZB_JOIN_EVENT_ANNCE, params->capability);
+    }
+
+    return s_join.enable;
+}
+
+bool esp_ncp_zb_join_leave(const esp_zb_zdo_signal_leave_indication_params_t *params)
+{
+    if (s_join.enable && params) {
+        esp_ncp_zb_join_add(params->device_addr, params->short_addr, ESP_NCP_ZB_JOIN_EVENT_LEAVE, params->rejoin);
+    }
+
+    return s_join.enable;
+}
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_zb_mailbox.h"
+
+static const char *TAG = "ESP_NCP_ZB_MAILBOX";
+
+typedef struct {
+    esp_ncp_zb_mailbox_fn_t fn;                 /*!< The closure */
+    void                    *arg;               /*!< The argument of the closure */
+} esp_ncp_zb_mailbox_item_t;
+
+static QueueHandle_t s_mailbox;                 /*!< The closures waiting for the Zigbee task */
+static atomic_bool s_mailbox_kicked;            /*!< A drain is scheduled in the Zigbee task */
+
+static void esp_ncp_zb_mailbox_drain_cb(void *param)
+{
+    esp_ncp_zb_mailbox_item_t item;
+
+    /* Cleared before draining, so a closure posted meanwhile schedules another drain rather than being missed */
+    atomic_store(&s_mailbox_kicked, false);
+
+    for (int i = 0; i < ESP_NCP_ZB_MAILBOX_BATCH && xQueueReceive(s_mailbox, &item, 0) == pdTRUE; i ++) {
+        item.fn(item.arg);
+    }
+
+    /* Leave the rest to the next iteration so the stack keeps serving the radio */
+    if (uxQueueMessagesWaiting(s_mailbox) && !atomic_exchange(&s_mailbox_kicked, true)) {
+        if (esp_zb_scheduler_user_alarm(esp_ncp_zb_mailbox_drain_cb, NULL, 0) == ESP_ZB_USER_CB_HANDLE_INVALID) {
+            /* No alarm is left to come back with, drain the rest now rather than strand it */
+            ESP_LOGW(TAG, "Drain alarm unavailable, draining %d closures at once", (int)uxQueueMessagesWaiting(s_mailbox));
+            atomic_store(&s_mailbox_kicked, false);
+            while (xQueueReceive(s_mailbox, &item, 0) == pdTRUE) {
+                item.fn(item.arg);
+            }
+        }
+    }
+}
+
+/* Schedules a drain from outside the Zigbee task, retried while the user callbacks of the stack are all in use */
+static void esp_ncp_zb_mailbox_kick(void)
+{
+    esp_zb_user_cb_handle_t handle = ESP_ZB_USER_CB_HANDLE_INVALID;
+
+    for (int i = 0; i < ESP_NCP_ZB_MAILBOX_KICK_RETRIES && handle == ESP_ZB_USER_CB_HANDLE_INVALID; i ++) {
+        if (i) {
+            vTaskDelay(1);
+        }
+        /* The scheduler alarms of the stack are not thread safe, setting one from the NCP task needs the lock */
+        esp_zb_lock_acquire(portMAX_DELAY);
+        handle = esp_zb_scheduler_user_alarm(esp_ncp_zb_mailbox_drain_cb, NULL, 0);
+        esp_zb_lock_release();
+    }
+
+    if (handle == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        /* The next post kicks again, the closures queued so far run with it */
+        ESP_LOGE(TAG, "Drain alarm unavailable, %d closures wait for the next post", (int)uxQueueMessagesWaiting(s_mailbox));
+        atomic_store(&s_mailbox_kicked, false);
+    }
+}
+
+esp_err_t esp_ncp_zb_mailbox_init(void)
+{
+    if (!s_mailbox) {
+        s_mailbox = xQueueCreate(ESP_NCP_ZB_MAILBOX_LEN, sizeof(esp_ncp_zb_mailbox_item_t));
+        atomic_store(&s_mailbox_kicked, false);
+    }
+
+    return s_mailbox ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_ncp_zb_mailbox_post(esp_ncp_zb_mailbox_fn_t fn, void *arg)
+{
+    esp_ncp_zb_mailbox_item_t item = {
+        .fn = fn,
+        .arg = arg,
+    };
+
+    ESP_RETURN_ON_FALSE(fn, ESP_ERR_INVALID_ARG, TAG, "Invalid closure");
+    ESP_RETURN_ON_FALSE(s_mailbox, ESP_ERR_INVALID_STATE, TAG, "Mailbox is not created");
+    ESP_RETURN_ON_FALSE(xQueueSend(s_mailbox, &item, 0) == pdTRUE, ESP_ERR_NO_MEM, TAG, "Mailbox is full");
+
+    if (!atomic_exchange(&s_mailbox_kicked, true)) {
+        esp_ncp_zb_mailbox_kick();
+    }
+
+    return ESP_OK;
+}
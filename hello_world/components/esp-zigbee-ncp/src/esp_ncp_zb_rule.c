@@ -0,0 +1,456 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_frame.h"
+#include "esp_ncp_zb.h"
+#include "esp_ncp_zb_rule.h"
+#include "esp_ncp_zb_sched.h"
+#include "esp_ncp_time.h"
+
+static const char *TAG = "ESP_NCP_ZB_RULE";
+
+/* The action encodings, the cluster command value is sent as encoded by the host */
+typedef struct {
+    uint8_t     type;                           /*!< ESP_NCP_ZB_RULE_ACTION_ZCL */
+    uint8_t     src_endpoint;                   /*!< The source endpoint */
+    uint8_t     dst_endpoint;                   /*!< The destination endpoint */
+    uint8_t     address_mode;                   /*!< The APS addressing mode, refer to esp_zb_zcl_address_mode_t */
+    uint16_t    dst_addr;                       /*!< The short address or group of the destination */
+    uint16_t    profile_id;                     /*!< The profile id */
+    uint16_t    cluster_id;                     /*!< The cluster id */
+    uint16_t    cmd_id;                         /*!< The command id */
+    uint8_t     direction;                      /*!< The direction of the command */
+    uint8_t     attr_type;                      /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+    uint8_t     size;                           /*!< The length of the value following the action */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_rule_zcl_t;
+
+typedef struct {
+    uint8_t     type;                           /*!< ESP_NCP_ZB_RULE_ACTION_APS */
+    uint8_t     dst_addr_mode;                  /*!< The APS addressing mode, refer to esp_zb_aps_address_mode_t */
+    uint16_t    dst_addr;                       /*!< The short address or group of the destination */
+    uint8_t     dst_endpoint;                   /*!< The destination endpoint */
+    uint8_t     src_endpoint;                   /*!< The source endpoint */
+    uint16_t    profile_id;                     /*!< The profile id */
+    uint16_t    cluster_id;                     /*!< The cluster id */
+    uint8_t     tx_options;                     /*!< The transmission options, refer to esp_zb_apsde_tx_opt_t */
+    uint8_t     radius;                         /*!< The maximum number of hops */
+    uint8_t     asdu_length;                    /*!< The length of the ASDU following the action */
+} ESP_NCP_ZB_PACKED_STRUCT esp_ncp_zb_rule_aps_t;
+
+typedef struct {
+    bool                    used;               /*!< The rule is installed */
+    uint8_t                 seq;                /*!< Changed whenever the rule is replaced or removed, so that a late send is not counted */
+    bool                    last_result;        /*!< The condition result of the previous run */
+    int32_t                 prev;               /*!< The trigger value of the previous run */
+    esp_ncp_zb_rule_t       rule;               /*!< The rule */
+    esp_ncp_zb_rule_stats_t stats;              /*!< The execution statistics */
+} esp_ncp_zb_rule_entry_t;
+
+typedef struct {
+    int64_t                 start;              /*!< The time the trigger entered the NCP, in microseconds */
+    uint16_t                src_addr;           /*!< The short address of the source */
+    uint8_t                 src_endpoint;       /*!< The source endpoint */
+    uint16_t                cluster_id;         /*!< The cluster of the report or indication */
+    uint16_t                attr_id;            /*!< The reported attribute */
+    int32_t                 value;              /*!< The trigger value */
+    const uint8_t           *payload;           /*!< The raw attribute value or ASDU */
+    uint32_t                length;             /*!< The length of the payload */
+} esp_ncp_zb_rule_event_t;
+
+/* An action waiting in the air-time scheduler, with the rule which fired it */
+typedef struct {
+    uint8_t                 rule_id;            /*!< The rule which fired, ESP_NCP_ZB_RULE_MAX for a command of the host */
+    uint8_t                 seq;                /*!< The seq of the rule when it fired */
+    int32_t                 value;              /*!< The trigger value */
+    int64_t                 start;              /*!< The time the trigger entered the NCP, in microseconds */
+    uint8_t                 action[];           /*!< The encoded action */
+} esp_ncp_zb_rule_pending_t;
+
+static esp_ncp_zb_rule_entry_t s_rule[ESP_NCP_ZB_RULE_MAX];
+static esp_ncp_zb_rule_notify_fn_t s_rule_notify;
+
+static uint8_t esp_ncp_zb_rule_operand_len(uint8_t op)
+{
+    return (op == ESP_NCP_ZB_RULE_OP_CONST) ? sizeof(int32_t) : (op == ESP_NCP_ZB_RULE_OP_BYTE) ? sizeof(uint8_t) : 0;
+}
+
+/* Rejects unknown opcodes, truncated operands and stack overflow or underflow, so the evaluation needs no checks */
+static bool esp_ncp_zb_rule_verify_code(const uint8_t *code, uint8_t code_len)
+{
+    int depth = 0;
+
+    for (int pc = 0; pc < code_len; ) {
+        uint8_t op = code[pc ++];
+
+        switch (op) {
+            case ESP_NCP_ZB_RULE_OP_RET:
+                return depth >= 1;
+            case ESP_NCP_ZB_RULE_OP_CONST:
+            case ESP_NCP_ZB_RULE_OP_VALUE:
+            case ESP_NCP_ZB_RULE_OP_PREV:
+            case ESP_NCP_ZB_RULE_OP_BYTE:
+                depth ++;
+                break;
+            case ESP_NCP_ZB_RULE_OP_NOT:
+                if (depth < 1) {
+                    return false;
+                }
+                break;
+            case ESP_NCP_ZB_RULE_OP_EQ ... ESP_NCP_ZB_RULE_OP_OR:
+            case ESP_NCP_ZB_RULE_OP_BAND:
+                if (depth < 2) {
+                    return false;
+                }
+                depth --;
+                break;
+            default:
+                return false;
+        }
+
+        pc += esp_ncp_zb_rule_operand_len(op);
+        if (pc > code_len || depth > ESP_NCP_ZB_RULE_STACK_DEPTH) {
+            return false;
+        }
+    }
+
+    return code_len == 0 || depth >= 1;
+}
+
+bool esp_ncp_zb_rule_action_verify(const uint8_t *action, uint8_t action_len)
+{
+    if (action_len < 1) {
+        return false;
+    }
+
+    switch (action[0]) {
+        case ESP_NCP_ZB_RULE_ACTION_ZCL:
+            return action_len >= sizeof(esp_ncp_zb_rule_zcl_t)
+                   && action_len == sizeof(esp_ncp_zb_rule_zcl_t) + ((const esp_ncp_zb_rule_zcl_t *)action)->size;
+        case ESP_NCP_ZB_RULE_ACTION_APS:
+            return action_len >= sizeof(esp_ncp_zb_rule_aps_t)
+                   && action_len == sizeof(esp_ncp_zb_rule_aps_t) + ((const esp_ncp_zb_rule_aps_t *)action)->asdu_length;
+        default:
+            return false;
+    }
+}
+
+static int32_t esp_ncp_zb_rule_eval(const esp_ncp_zb_rule_entry_t *entry, const esp_ncp_zb_rule_event_t *event)
+{
+    const uint8_t *code = entry->rule.code;
+    int32_t stack[ESP_NCP_ZB_RULE_STACK_DEPTH];
+    int sp = 0;
+
+    if (entry->rule.code_len == 0) {
+        return 1;
+    }
+
+    for (int pc = 0; pc < entry->rule.code_len; ) {
+        uint8_t op = code[pc ++];
+        int32_t a, b = 0;
+
+        if (op == ESP_NCP_ZB_RULE_OP_RET) {
+            break;
+        }
+
+        switch (op) {
+            case ESP_NCP_ZB_RULE_OP_CONST:
+                memcpy(&stack[sp ++], &code[pc], sizeof(int32_t));
+                break;
+            case ESP_NCP_ZB_RULE_OP_VALUE:
+                stack[sp ++] = event->value;
+                break;
+            case ESP_NCP_ZB_RULE_OP_PREV:
+                stack[sp ++] = entry->prev;
+                break;
+            case ESP_NCP_ZB_RULE_OP_BYTE:
+                stack[sp ++] = (code[pc] < event->length) ? event->payload[code[pc]] : 0;
+                break;
+            case ESP_NCP_ZB_RULE_OP_NOT:
+                stack[sp - 1] = !stack[sp - 1];
+                break;
+            default:
+                b = stack[-- sp];
+                a = stack[sp - 1];
+                switch (op) {
+                    case ESP_NCP_ZB_RULE_OP_EQ:   a = (a == b); break;
+                    case ESP_NCP_ZB_RULE_OP_NE:   a = (a != b); break;
+                    case ESP_NCP_ZB_RULE_OP_LT:   a = (a < b);  break;
+                    case ESP_NCP_ZB_RULE_OP_LE:   a = (a <= b); break;
+                    case ESP_NCP_ZB_RULE_OP_GT:   a = (a > b);  break;
+                    case ESP_NCP_ZB_RULE_OP_GE:   a = (a >= b); break;
+                    case ESP_NCP_ZB_RULE_OP_AND:  a = (a && b); break;
+                    case ESP_NCP_ZB_RULE_OP_OR:   a = (a || b); break;
+                    case ESP_NCP_ZB_RULE_OP_BAND: a = (a & b);  break;
+                    default: break;
+                }
+                stack[sp - 1] = a;
+                break;
+        }
+        pc += esp_ncp_zb_rule_operand_len(op);
+    }
+
+    return stack[sp - 1];
+}
+
+static uint8_t esp_ncp_zb_rule_action_len(const uint8_t *action)
+{
+    if (action[0] == ESP_NCP_ZB_RULE_ACTION_ZCL) {
+        return sizeof(esp_ncp_zb_rule_zcl_t) + ((const esp_ncp_zb_rule_zcl_t *)action)->size;
+    } else {
+        return sizeof(esp_ncp_zb_rule_aps_t) + ((const esp_ncp_zb_rule_aps_t *)action)->asdu_length;
+    }
+}
+
+static esp_err_t esp_ncp_zb_rule_action_issue(const uint8_t *action, uint8_t *tsn)
+{
+    if (action[0] == ESP_NCP_ZB_RULE_ACTION_ZCL) {
+        const esp_ncp_zb_rule_zcl_t *zcl = (const esp_ncp_zb_rule_zcl_t *)action;
+        esp_zb_zcl_custom_cluster_cmd_t cmd_req = {
+            .zcl_basic_cmd = {
+                .dst_addr_u.addr_short = zcl->dst_addr,
+                .dst_endpoint = zcl->dst_endpoint,
+                .src_endpoint = zcl->src_endpoint,
+            },
+            .address_mode = zcl->address_mode,
+            .profile_id = zcl->profile_id,
+            .cluster_id = zcl->cluster_id,
+            .custom_cmd_id = zcl->cmd_id,
+            .direction = zcl->direction,
+            .data = {
+                .type = zcl->attr_type,
+                .value = zcl->size ? (void *)(action + sizeof(esp_ncp_zb_rule_zcl_t)) : NULL,
+            }
+        };
+
+        *tsn = esp_zb_zcl_custom_cluster_cmd_req(&cmd_req);
+        return ESP_OK;
+    } else {
+        const esp_ncp_zb_rule_aps_t *aps = (const esp_ncp_zb_rule_aps_t *)action;
+        esp_zb_apsde_data_req_t data_req = {
+            .dst_addr_mode = aps->dst_addr_mode,
+            .dst_addr.addr_short = aps->dst_addr,
+            .dst_endpoint = aps->dst_endpoint,
+            .src_endpoint = aps->src_endpoint,
+            .profile_id = aps->profile_id,
+            .cluster_id = aps->cluster_id,
+            .tx_options = aps->tx_options,
+            .radius = aps->radius,
+            .asdu_length = aps->asdu_length,
+            .asdu = aps->asdu_length ? (uint8_t *)(action + sizeof(esp_ncp_zb_rule_aps_t)) : NULL,
+        };
+
+        /* Recorded as a send of the NCP, so that its confirm neither reaches the host nor counts for a bulk request */
+        return esp_ncp_zb_aps_data_request(&data_req, false);
+    }
+}
+
+/* Accounts the action of a rule once the stack has it, so the latency covers the wait for air-time */
+static void esp_ncp_zb_rule_action_done(const esp_ncp_zb_rule_pending_t *pending, esp_err_t ret, uint8_t tsn)
+{
+    esp_ncp_zb_rule_entry_t *entry = (pending->rule_id < ESP_NCP_ZB_RULE_MAX) ? &s_rule[pending->rule_id] : NULL;
+
+    if (!entry || !entry->used || entry->seq != pending->seq) {
+        return;
+    }
+
+    if (ret == ESP_OK) {
+        uint32_t latency = (uint32_t)(esp_ncp_time_us() - pending->start);
+        uint8_t bucket = 0;
+
+        while (bucket < ESP_NCP_ZB_RULE_HIST_BUCKETS - 1 && latency >= (ESP_NCP_ZB_RULE_HIST_BASE_US << bucket)) {
+            bucket ++;
+        }
+        entry->stats.hist[bucket] ++;
+    } else {
+        entry->stats.errors ++;
+    }
+
+    if ((entry->rule.flags & ESP_NCP_ZB_RULE_FLAG_NOTIFY) && s_rule_notify) {
+        s_rule_notify(pending->rule_id, pending->value, ret, tsn);
+    }
+}
+
+static void esp_ncp_zb_rule_action_send_cb(void *arg, bool drop)
+{
+    esp_ncp_zb_rule_pending_t *pending = (esp_ncp_zb_rule_pending_t *)arg;
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    uint8_t tsn = 0;
+
+    if (!drop) {
+        ret = esp_ncp_zb_rule_action_issue(pending->action, &tsn);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Action type %d refused by the stack", pending->action[0]);
+        }
+    }
+    esp_ncp_zb_rule_action_done(pending, ret, tsn);
+    free(pending);
+}
+
+static esp_err_t esp_ncp_zb_rule_action_submit(const uint8_t *action, uint8_t rule_id, const esp_ncp_zb_rule_event_t *event)
+{
+    uint8_t action_len = esp_ncp_zb_rule_action_len(action);
+    esp_ncp_zb_rule_pending_t *pending = malloc(sizeof(esp_ncp_zb_rule_pending_t) + action_len);
+    uint16_t dst_addr = 0;
+    bool unicast = false;
+
+    if (!pending) {
+        esp_ncp_zb_rule_pending_t lost = {
+            .rule_id = rule_id,
+            .seq = (rule_id < ESP_NCP_ZB_RULE_MAX) ? s_rule[rule_id].seq : 0,
+            .value = event ? event->value : 0,
+        };
+
+        ESP_LOGW(TAG, "No memory for the action");
+        esp_ncp_zb_rule_action_done(&lost, ESP_ERR_NO_MEM, 0);
+        return ESP_ERR_NO_MEM;
+    }
+
+    pending->rule_id = rule_id;
+    pending->seq = (rule_id < ESP_NCP_ZB_RULE_MAX) ? s_rule[rule_id].seq : 0;
+    pending->value = event ? event->value : 0;
+    pending->start = event ? event->start : esp_ncp_time_us();
+    memcpy(pending->action, action, action_len);
+
+    if (action[0] == ESP_NCP_ZB_RULE_ACTION_ZCL) {
+        const esp_ncp_zb_rule_zcl_t *zcl = (const esp_ncp_zb_rule_zcl_t *)action;
+        dst_addr = zcl->dst_addr;
+        unicast = (zcl->address_mode == ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT);
+    } else {
+        const esp_ncp_zb_rule_aps_t *aps = (const esp_ncp_zb_rule_aps_t *)action;
+        dst_addr = aps->dst_addr;
+        unicast = (aps->dst_addr_mode == ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT);
+    }
+
+    /* The actions share the air-time budget with the host commands, the scheduler callback frees the copy */
+    return esp_ncp_zb_sched_submit(ESP_NCP_ZB_SCHED_CLASS_COMMAND, dst_addr, unicast, action_len, esp_ncp_zb_rule_action_send_cb, pending);
+}
+
+esp_err_t esp_ncp_zb_rule_action_send(const uint8_t *action)
+{
+    return esp_ncp_zb_rule_action_submit(action, ESP_NCP_ZB_RULE_MAX, NULL);
+}
+
+static void esp_ncp_zb_rule_run(uint8_t trigger, const esp_ncp_zb_rule_event_t *event)
+{
+    for (int i = 0; i < ESP_NCP_ZB_RULE_MAX; i ++) {
+        esp_ncp_zb_rule_entry_t *entry = &s_rule[i];
+        const esp_ncp_zb_rule_t *rule = &entry->rule;
+
+        if (!entry->used || rule->trigger != trigger || rule->cluster_id != event->cluster_id
+            || (rule->src_addr != ESP_NCP_ZB_RULE_ANY_ADDR && rule->src_addr != event->src_addr)
+            || (rule->src_endpoint != ESP_NCP_ZB_RULE_ANY_ENDPOINT && rule->src_endpoint != event->src_endpoint)
+            || (trigger == ESP_NCP_ZB_RULE_TRIGGER_REPORT && rule->attr_id != ESP_NCP_ZB_RULE_ANY_ATTR && rule->attr_id != event->attr_id)) {
+            continue;
+        }
+
+        bool result = esp_ncp_zb_rule_eval(entry, event) != 0;
+        bool fire = result && !((rule->flags & ESP_NCP_ZB_RULE_FLAG_EDGE) && entry->last_result);
+
+        entry->stats.hits ++;
+        entry->last_result = result;
+        entry->prev = event->value;
+
+        /* The latency, the errors and the notification are accounted when the scheduler sends or drops the action */
+        if (fire) {
+            entry->stats.fired ++;
+            esp_ncp_zb_rule_action_submit(rule->action, i, event);
+        }
+    }
+}
+
+esp_err_t esp_ncp_zb_rule_set(uint8_t rule_id, const esp_ncp_zb_rule_t *rule)
+{
+    ESP_RETURN_ON_FALSE(rule_id < ESP_NCP_ZB_RULE_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid rule %d", rule_id);
+
+    if (!rule) {
+        s_rule[rule_id].used = false;
+        s_rule[rule_id].seq ++;
+        return ESP_OK;
+    }
+
+    ESP_RETURN_ON_FALSE(rule->trigger == ESP_NCP_ZB_RULE_TRIGGER_REPORT || rule->trigger == ESP_NCP_ZB_RULE_TRIGGER_APS,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid trigger %d", rule->trigger);
+    ESP_RETURN_ON_FALSE(rule->code_len <= ESP_NCP_ZB_RULE_CODE_MAX && esp_ncp_zb_rule_verify_code(rule->code, rule->code_len),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid condition of rule %d", rule_id);
+    ESP_RETURN_ON_FALSE(rule->action_len <= ESP_NCP_ZB_RULE_ACTION_MAX && esp_ncp_zb_rule_action_verify(rule->action, rule->action_len),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid action of rule %d", rule_id);
+
+    uint8_t seq = s_rule[rule_id].seq + 1;
+
+    memset(&s_rule[rule_id], 0, sizeof(esp_ncp_zb_rule_entry_t));
+    s_rule[rule_id].rule = *rule;
+    s_rule[rule_id].used = true;
+    s_rule[rule_id].seq = seq;
+
+    return ESP_OK;
+}
+
+void esp_ncp_zb_rule_notify_register(esp_ncp_zb_rule_notify_fn_t fn)
+{
+    s_rule_notify = fn;
+}
+
+void esp_ncp_zb_rule_report(const esp_zb_zcl_report_attr_message_t *message)
+{
+    const esp_zb_zcl_attribute_data_t *data = &message->attribute.data;
+    esp_ncp_zb_rule_event_t event = {
+        .start = esp_ncp_time_us(),
+        .src_addr = message->src_address.u.short_addr,
+        .src_endpoint = message->src_endpoint,
+        .cluster_id = message->cluster,
+        .attr_id = message->attribute.id,
+        .payload = data->value,
+        .length = data->value ? data->size : 0,
+    };
+    uint32_t raw = 0;
+    uint8_t size = (event.length < sizeof(raw)) ? event.length : sizeof(raw);
+
+    /* Values wider than 32 bits are truncated, the signed types are sign extended */
+    memcpy(&raw, event.payload, size);
+    event.value = (int32_t)raw;
+    if (data->type >= ESP_ZB_ZCL_ATTR_TYPE_S8 && data->type <= ESP_ZB_ZCL_ATTR_TYPE_S32 && size && size < sizeof(raw)) {
+        event.value = (int32_t)(raw << (32 - 8 * size)) >> (32 - 8 * size);
+    }
+
+    esp_ncp_zb_rule_run(ESP_NCP_ZB_RULE_TRIGGER_REPORT, &event);
+}
+
+void esp_ncp_zb_rule_aps_indication(const esp_zb_apsde_data_ind_t *ind)
+{
+    esp_ncp_zb_rule_event_t event = {
+        .start = esp_ncp_time_us(),
+        .src_addr = ind->src_short_addr,
+        .src_endpoint = ind->src_endpoint,
+        .cluster_id = ind->cluster_id,
+        .value = ind->asdu_length,
+        .payload = ind->asdu,
+        .length = ind->asdu ? ind->asdu_length : 0,
+    };
+
+    esp_ncp_zb_rule_run(ESP_NCP_ZB_RULE_TRIGGER_APS, &event);
+}
+
+esp_err_t esp_ncp_zb_rule_stats_get(uint8_t rule_id, esp_ncp_zb_rule_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(rule_id < ESP_NCP_ZB_RULE_MAX && s_rule[rule_id].used, ESP_ERR_NOT_FOUND, TAG, "No rule %d", rule_id);
+
+    if (stats) {
+        memcpy(stats, &s_rule[rule_id].stats, sizeof(esp_ncp_zb_rule_stats_t));
+    }
+    if (reset) {
+        memset(&s_rule[rule_id].stats, 0, sizeof(esp_ncp_zb_rule_stats_t));
+    }
+
+    return ESP_OK;
+}
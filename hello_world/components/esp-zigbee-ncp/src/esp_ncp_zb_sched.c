@@ -0,0 +1,392 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_zb_sched.h"
+
+#define ESP_NCP_ZB_SCHED_NONE   0xFF            /*!< The end of a frame list */
+
+static const char *TAG = "ESP_NCP_ZB_SCHED";
+
+typedef struct {
+    bool                    used;               /*!< The entry holds a queued frame */
+    bool                    deferred;           /*!< The frame already waited once */
+    uint8_t                 sched_class;        /*!< The frame class, refer to esp_ncp_zb_sched_class_t */
+    uint8_t                 next;               /*!< The index of the next frame of the same class */
+    uint16_t                dst_addr;           /*!< The short address of the destination */
+    uint16_t                hop_addr;           /*!< The short address of the next hop to the destination */
+    uint16_t                cost;               /*!< The air-time cost of the frame, in bytes */
+    esp_ncp_zb_sched_fn_t   fn;                 /*!< The function sending or dropping the frame */
+    void                    *arg;               /*!< The argument of the function */
+} esp_ncp_zb_sched_entry_t;
+
+typedef struct {
+    uint16_t                addr;               /*!< The short address of the destination or next hop */
+    TickType_t              ready;              /*!< The tick count from which the next frame may be sent */
+} esp_ncp_zb_sched_peer_t;
+
+typedef struct {
+    bool                    used;               /*!< The entry holds a route */
+    uint16_t                dst_addr;           /*!< The short address of the destination */
+    uint16_t                hop_addr;           /*!< The short address of the next hop to the destination */
+    TickType_t              expire;             /*!< The tick count from which the routing table is walked again */
+} esp_ncp_zb_sched_route_t;
+
+typedef struct {
+    esp_ncp_zb_sched_config_t   config;         /*!< The scheduler configuration */
+    esp_ncp_zb_sched_stats_t    stats;          /*!< The scheduler statistics */
+    uint32_t                    tokens;         /*!< The bytes left in the token bucket */
+    TickType_t                  refill;         /*!< The tick count of the last refill */
+    esp_zb_user_cb_handle_t     alarm;          /*!< The alarm handle retrying the waiting frames */
+    uint8_t                     head[ESP_NCP_ZB_SCHED_CLASS_MAX]; /*!< The oldest frame of every class */
+    uint8_t                     tail[ESP_NCP_ZB_SCHED_CLASS_MAX]; /*!< The newest frame of every class */
+    esp_ncp_zb_sched_entry_t    entry[ESP_NCP_ZB_SCHED_QUEUE_LEN]; /*!< The queued frames */
+    esp_ncp_zb_sched_peer_t     peer[ESP_NCP_ZB_SCHED_PEER_MAX];   /*!< The pacing of the recent destinations and next hops */
+    esp_ncp_zb_sched_route_t    route[ESP_NCP_ZB_SCHED_PEER_MAX];  /*!< The next hops of the recent destinations */
+} esp_ncp_zb_sched_t;
+
+static esp_ncp_zb_sched_t s_sched = {
+    .config = {
+        .enable = true,
+        .rate = ESP_NCP_ZB_SCHED_RATE,
+        .burst = ESP_NCP_ZB_SCHED_BURST,
+        .dst_gap_ms = ESP_NCP_ZB_SCHED_DST_GAP_MS,
+        .hop_gap_ms = ESP_NCP_ZB_SCHED_HOP_GAP_MS,
+    },
+    .tokens = ESP_NCP_ZB_SCHED_BURST,
+    .alarm = ESP_ZB_USER_CB_HANDLE_INVALID,
+    .head = {ESP_NCP_ZB_SCHED_NONE, ESP_NCP_ZB_SCHED_NONE, ESP_NCP_ZB_SCHED_NONE},
+    .tail = {ESP_NCP_ZB_SCHED_NONE, ESP_NCP_ZB_SCHED_NONE, ESP_NCP_ZB_SCHED_NONE},
+};
+
+static uint16_t esp_ncp_zb_sched_queued(void)
+{
+    uint16_t queued = 0;
+
+    for (int i = 0; i < ESP_NCP_ZB_SCHED_CLASS_MAX; i ++) {
+        queued += s_sched.stats.queued[i];
+    }
+
+    return queued;
+}
+
+/* The next hop of a routed destination, or the destination itself for a neighbor. The routing table is walked once
+ * per destination and ESP_NCP_ZB_SCHED_ROUTE_TTL_MS, a burst to the same devices reads the cache. */
+static uint16_t esp_ncp_zb_sched_next_hop(uint16_t dst_addr)
+{
+    esp_zb_nwk_info_iterator_t iterator = ESP_ZB_NWK_INFO_ITERATOR_INIT;
+    esp_zb_nwk_route_info_t route_info;
+    esp_ncp_zb_sched_route_t *route = &s_sched.route[0];
+    TickType_t now = xTaskGetTickCount();
+
+    for (int i = 0; i < ESP_NCP_ZB_SCHED_PEER_MAX; i ++) {
+        esp_ncp_zb_sched_route_t *cached = &s_sched.route[i];
+
+        if (cached->used && cached->dst_addr == dst_addr) {
+            if ((int32_t)(now - cached->expire) < 0) {
+                return cached->hop_addr;
+            }
+            route = cached;
+            break;
+        }
+        if (!cached->used || (route->used && (int32_t)(cached->expire - route->expire) < 0)) {
+            route = cached;
+        }
+    }
+
+    route->used = true;
+    route->dst_addr = dst_addr;
+    route->hop_addr = dst_addr;
+    route->expire = now + pdMS_TO_TICKS(ESP_NCP_ZB_SCHED_ROUTE_TTL_MS);
+    while (esp_zb_nwk_get_next_route(&iterator, &route_info) == ESP_OK) {
+        if (route_info.dest_addr == dst_addr && route_info.flags.status == ESP_ZB_NWK_ROUTE_STATE_ACTIVE) {
+            route->hop_addr = route_info.next_hop_addr;
+            break;
+        }
+    }
+
+    return route->hop_addr;
+}
+
+/* Returns the pacing of the address, the entry which is ready for the longest time is recycled for a new address */
+static esp_ncp_zb_sched_peer_t *esp_ncp_zb_sched_peer(uint16_t addr, bool create)
+{
+    esp_ncp_zb_sched_peer_t *oldest = &s_sched.peer[0];
+
+    for (int i = 0; i < ESP_NCP_ZB_SCHED_PEER_MAX; i ++) {
+        if (s_sched.peer[i].addr == addr) {
+            return &s_sched.peer[i];
+        }
+        if ((int32_t)(s_sched.peer[i].ready - oldest->ready) < 0) {
+            oldest = &s_sched.peer[i];
+        }
+    }
+
+    if (!create) {
+        return NULL;
+    }
+
+    oldest->addr = addr;
+    oldest->ready = xTaskGetTickCount();
+
+    return oldest;
+}
+
+static bool esp_ncp_zb_sched_ready(uint16_t addr, TickType_t now)
+{
+    esp_ncp_zb_sched_peer_t *peer = esp_ncp_zb_sched_peer(addr, false);
+
+    return !peer || (int32_t)(now - peer->ready) >= 0;
+}
+
+static void esp_ncp_zb_sched_pace(uint16_t addr, TickType_t ready)
+{
+    esp_ncp_zb_sched_peer_t *peer = esp_ncp_zb_sched_peer(addr, true);
+
+    if ((int32_t)(ready - peer->ready) > 0) {
+        peer->ready = ready;
+    }
+}
+
+static void esp_ncp_zb_sched_unlink(uint8_t sched_class, uint8_t prev, uint8_t index)
+{
+    esp_ncp_zb_sched_entry_t *entry = &s_sched.entry[index];
+
+    if (prev == ESP_NCP_ZB_SCHED_NONE) {
+        s_sched.head[sched_class] = entry->next;
+    } else {
+        s_sched.entry[prev].next = entry->next;
+    }
+    if (s_sched.tail[sched_class] == index) {
+        s_sched.tail[sched_class] = prev;
+    }
+
+    entry->used = false;
+    s_sched.stats.queued[sched_class] --;
+}
+
+static void esp_ncp_zb_sched_refill(TickType_t now)
+{
+    uint32_t elapsed_ms = pdTICKS_TO_MS(now - s_sched.refill);
+    /* 64-bit so that a long idle time cannot wrap the bucket below its depth */
+    uint64_t tokens = s_sched.tokens + (uint64_t)elapsed_ms * s_sched.config.rate / 1000;
+
+    /* Keep the remainder of a partial token for the next refill */
+    if (tokens != s_sched.tokens) {
+        s_sched.refill = now;
+    }
+    s_sched.tokens = (tokens > s_sched.config.burst) ? s_sched.config.burst : (uint32_t)tokens;
+}
+
+static void esp_ncp_zb_sched_alarm_cb(void *param);
+
+static void esp_ncp_zb_sched_run(void)
+{
+    for (;;) {
+        TickType_t now = xTaskGetTickCount();
+        uint8_t sched_class = ESP_NCP_ZB_SCHED_CLASS_MAX;
+        uint8_t prev = ESP_NCP_ZB_SCHED_NONE;
+        uint8_t index = ESP_NCP_ZB_SCHED_NONE;
+
+        esp_ncp_zb_sched_refill(now);
+
+        /* The oldest frame of the highest class whose destination and next hop are not paced */
+        for (uint8_t c = 0; c < ESP_NCP_ZB_SCHED_CLASS_MAX && index == ESP_NCP_ZB_SCHED_NONE; c ++) {
+            prev = ESP_NCP_ZB_SCHED_NONE;
+            for (uint8_t i = s_sched.head[c]; i != ESP_NCP_ZB_SCHED_NONE; prev = i, i = s_sched.entry[i].next) {
+                if (s_sched.config.enable && (!esp_ncp_zb_sched_ready(s_sched.entry[i].dst_addr, now)
+                                              || !esp_ncp_zb_sched_ready(s_sched.entry[i].hop_addr, now))) {
+                    continue;
+                }
+                sched_class = c;
+                index = i;
+                break;
+            }
+        }
+
+        if (index == ESP_NCP_ZB_SCHED_NONE || (s_sched.config.enable && s_sched.tokens < s_sched.entry[index].cost)) {
+            break;
+        }
+
+        esp_ncp_zb_sched_entry_t entry = s_sched.entry[index];
+
+        esp_ncp_zb_sched_unlink(sched_class, prev, index);
+        if (s_sched.config.enable) {
+            s_sched.tokens -= entry.cost;
+            esp_ncp_zb_sched_pace(entry.dst_addr, now + pdMS_TO_TICKS(s_sched.config.dst_gap_ms));
+            esp_ncp_zb_sched_pace(entry.hop_addr, now + pdMS_TO_TICKS(s_sched.config.hop_gap_ms));
+        }
+        s_sched.stats.sent ++;
+        entry.fn(entry.arg, false);
+    }
+
+    for (int i = 0; i < ESP_NCP_ZB_SCHED_QUEUE_LEN; i ++) {
+        if (s_sched.entry[i].used && !s_sched.entry[i].deferred) {
+            s_sched.entry[i].deferred = true;
+            s_sched.stats.deferred ++;
+        }
+    }
+
+    if (esp_ncp_zb_sched_queued() && s_sched.alarm == ESP_ZB_USER_CB_HANDLE_INVALID) {
+        s_sched.alarm = esp_zb_scheduler_user_alarm(esp_ncp_zb_sched_alarm_cb, NULL, ESP_NCP_ZB_SCHED_TICK_MS);
+    }
+}
+
+static void esp_ncp_zb_sched_alarm_cb(void *param)
+{
+    s_sched.alarm = ESP_ZB_USER_CB_HANDLE_INVALID;
+    esp_ncp_zb_sched_run();
+}
+
+/* Frees an entry, dropping the newest frame of a lower class when the queue is full. The dropped frame is handed back
+ * in victim, its function is called by the caller once the queue is consistent again. */
+static uint8_t esp_ncp_zb_sched_alloc(uint8_t sched_class, esp_ncp_zb_sched_entry_t *victim)
+{
+    for (uint8_t i = 0; i < ESP_NCP_ZB_SCHED_QUEUE_LEN; i ++) {
+        if (!s_sched.entry[i].used) {
+            return i;
+        }
+    }
+
+    for (uint8_t c = ESP_NCP_ZB_SCHED_CLASS_MAX - 1; c > sched_class; c --) {
+        uint8_t index = s_sched.tail[c];
+        uint8_t prev = ESP_NCP_ZB_SCHED_NONE;
+
+        if (index == ESP_NCP_ZB_SCHED_NONE) {
+            continue;
+        }
+
+        for (uint8_t i = s_sched.head[c]; i != index; i = s_sched.entry[i].next) {
+            prev = i;
+        }
+
+        *victim = s_sched.entry[index];
+        esp_ncp_zb_sched_unlink(c, prev, index);
+        s_sched.stats.dropped ++;
+
+        return index;
+    }
+
+    return ESP_NCP_ZB_SCHED_NONE;
+}
+
+esp_err_t esp_ncp_zb_sched_config(const esp_ncp_zb_sched_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "Invalid configuration");
+
+    s_sched.config.enable = config->enable;
+    if (config->rate) {
+        s_sched.config.rate = config->rate;
+    }
+    if (config->burst) {
+        s_sched.config.burst = config->burst;
+    }
+    if (config->dst_gap_ms) {
+        s_sched.config.dst_gap_ms = config->dst_gap_ms;
+    }
+    if (config->hop_gap_ms) {
+        s_sched.config.hop_gap_ms = config->hop_gap_ms;
+    }
+
+    /* A disabled scheduler sends what is still queued */
+    esp_ncp_zb_sched_run();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ncp_zb_sched_submit(uint8_t sched_class, uint16_t dst_addr, bool unicast, uint16_t length, esp_ncp_zb_sched_fn_t fn, void *arg)
+{
+    esp_ncp_zb_sched_entry_t victim = {
+        .used = false,
+    };
+    uint8_t index = ESP_NCP_ZB_SCHED_NONE;
+    uint16_t depth = 0;
+
+    ESP_RETURN_ON_FALSE(fn && sched_class < ESP_NCP_ZB_SCHED_CLASS_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid frame");
+
+    if (!s_sched.config.enable) {
+        s_sched.stats.sent ++;
+        fn(arg, false);
+        return ESP_OK;
+    }
+
+    for (int i = 0; unicast && i < ESP_NCP_ZB_SCHED_QUEUE_LEN; i ++) {
+        if (s_sched.entry[i].used && s_sched.entry[i].dst_addr == dst_addr) {
+            depth ++;
+        }
+    }
+
+    if (depth < ESP_NCP_ZB_SCHED_DST_DEPTH) {
+        index = esp_ncp_zb_sched_alloc(sched_class, &victim);
+    }
+
+    if (index == ESP_NCP_ZB_SCHED_NONE) {
+        ESP_LOGW(TAG, "Drop frame to 0x%04hx, class %d", dst_addr, sched_class);
+        s_sched.stats.dropped ++;
+        fn(arg, true);
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t cost = (ESP_NCP_ZB_SCHED_FRAME_OVERHEAD + length) * (unicast ? 1 : ESP_NCP_ZB_SCHED_BROADCAST_FACTOR);
+    esp_ncp_zb_sched_entry_t *entry = &s_sched.entry[index];
+
+    entry->used = true;
+    entry->deferred = false;
+    entry->sched_class = sched_class;
+    entry->next = ESP_NCP_ZB_SCHED_NONE;
+    entry->dst_addr = dst_addr;
+    entry->hop_addr = unicast ? esp_ncp_zb_sched_next_hop(dst_addr) : dst_addr;
+    entry->cost = (cost > s_sched.config.burst) ? s_sched.config.burst : cost;
+    entry->fn = fn;
+    entry->arg = arg;
+
+    if (s_sched.tail[sched_class] == ESP_NCP_ZB_SCHED_NONE) {
+        s_sched.head[sched_class] = index;
+    } else {
+        s_sched.entry[s_sched.tail[sched_class]].next = index;
+    }
+    s_sched.tail[sched_class] = index;
+    s_sched.stats.queued[sched_class] ++;
+
+    uint16_t queued = esp_ncp_zb_sched_queued();
+    if (queued > s_sched.stats.max_queued) {
+        s_sched.stats.max_queued = queued;
+    }
+
+    /* The new frame is linked, the function of the dropped one may submit again */
+    if (victim.fn) {
+        victim.fn(victim.arg, true);
+    }
+
+    esp_ncp_zb_sched_run();
+
+    return ESP_OK;
+}
+
+void esp_ncp_zb_sched_stats_get(esp_ncp_zb_sched_stats_t *stats, bool reset)
+{
+    esp_ncp_zb_sched_refill(xTaskGetTickCount());
+    s_sched.stats.tokens = s_sched.tokens;
+
+    if (stats) {
+        memcpy(stats, &s_sched.stats, sizeof(esp_ncp_zb_sched_stats_t));
+    }
+
+    if (reset) {
+        s_sched.stats.max_queued = esp_ncp_zb_sched_queued();
+        s_sched.stats.sent = 0;
+        s_sched.stats.deferred = 0;
+        s_sched.stats.dropped = 0;
+    }
+}
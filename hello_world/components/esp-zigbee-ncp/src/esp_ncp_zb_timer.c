@@ -0,0 +1,329 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "esp_zigbee_core.h"
+
+#include "esp_ncp_zb_rule.h"
+#include "esp_ncp_time.h"
+#include "esp_ncp_zb_timer.h"
+
+#define ESP_NCP_ZB_TIMER_NONE       0xFFFF      /*!< The end of a timer list, or a timer in no slot */
+#define ESP_NCP_ZB_TIMER_ROOT_SIZE  (1 << ESP_NCP_ZB_TIMER_ROOT_BITS)
+#define ESP_NCP_ZB_TIMER_ROOT_MASK  (ESP_NCP_ZB_TIMER_ROOT_SIZE - 1)
+#define ESP_NCP_ZB_TIMER_LEVEL_SIZE (1 << ESP_NCP_ZB_TIMER_LEVEL_BITS)
+#define ESP_NCP_ZB_TIMER_LEVEL_MASK (ESP_NCP_ZB_TIMER_LEVEL_SIZE - 1)
+#define ESP_NCP_ZB_TIMER_SLOTS      (ESP_NCP_ZB_TIMER_ROOT_SIZE + (ESP_NCP_ZB_TIMER_LEVELS - 1) * ESP_NCP_ZB_TIMER_LEVEL_SIZE)
+#define ESP_NCP_ZB_TIMER_TICK_US    (ESP_NCP_ZB_TIMER_TICK_MS * 1000LL)
+
+static const char *TAG = "ESP_NCP_ZB_TIMER";
+
+typedef struct {
+    uint16_t                prev;               /*!< The previous timer in the slot */
+    uint16_t                next;               /*!< The next timer in the slot, or in the free list */
+    uint16_t                slot;               /*!< The wheel slot holding the timer, ESP_NCP_ZB_TIMER_NONE when free */
+    uint16_t                gen;                /*!< Tells the ID of a fired timer from that of its successor */
+    uint32_t                expires;            /*!< The tick the timer fires at */
+    uint32_t                period_ms;          /*!< The period of the timer, 0 for a single shot */
+    uint8_t                 action_len;         /*!< The length of the command */
+    uint8_t                 *action;            /*!< The command, encoded as a rule action */
+} esp_ncp_zb_timer_entry_t;
+
+typedef struct {
+    esp_ncp_zb_timer_entry_t    *entry;         /*!< The timer table, allocated on first use */
+    uint16_t                    head[ESP_NCP_ZB_TIMER_SLOTS]; /*!< The first timer of every wheel slot */
+    uint16_t                    free;           /*!< The first free timer */
+    uint16_t                    gen;            /*!< The generation given to the next timer */
+    uint32_t                    now;            /*!< The next tick to run */
+    int64_t                     base_us;        /*!< The time of tick 0 */
+    bool                        armed;          /*!< The tick alarm is pending */
+    uint64_t                    jitter_sum;     /*!< The sum of the firing delays, in microseconds */
+    esp_ncp_zb_timer_stats_t    stats;          /*!< The timer statistics */
+} esp_ncp_zb_timer_t;
+
+static esp_ncp_zb_timer_t s_timer;
+
+static uint32_t esp_ncp_zb_timer_tick_now(void)
+{
+    return (uint32_t)((esp_ncp_time_us() - s_timer.base_us) / ESP_NCP_ZB_TIMER_TICK_US);
+}
+
+/* The root level holds the next ROOT_SIZE ticks, every other level holds LEVEL_SIZE times the span of the one below */
+static uint16_t esp_ncp_zb_timer_slot(uint32_t expires)
+{
+    uint32_t delta = expires - s_timer.now;
+
+    if ((int32_t)delta < 0) {
+        return s_timer.now & ESP_NCP_ZB_TIMER_ROOT_MASK;
+    }
+    if (delta < ESP_NCP_ZB_TIMER_ROOT_SIZE) {
+        return expires & ESP_NCP_ZB_TIMER_ROOT_MASK;
+    }
+
+    for (int level = 1; level < ESP_NCP_ZB_TIMER_LEVELS; level ++) {
+        int shift = ESP_NCP_ZB_TIMER_ROOT_BITS + level * ESP_NCP_ZB_TIMER_LEVEL_BITS;
+
+        if (level == ESP_NCP_ZB_TIMER_LEVELS - 1 || shift >= 32 || delta < (1UL << shift)) {
+            return ESP_NCP_ZB_TIMER_ROOT_SIZE + (level - 1) * ESP_NCP_ZB_TIMER_LEVEL_SIZE
+                   + ((expires >> (shift - ESP_NCP_ZB_TIMER_LEVEL_BITS)) & ESP_NCP_ZB_TIMER_LEVEL_MASK);
+        }
+    }
+
+    return ESP_NCP_ZB_TIMER_NONE;
+}
+
+static void esp_ncp_zb_timer_link(uint16_t index)
+{
+    esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+    uint16_t slot = esp_ncp_zb_timer_slot(entry->expires);
+
+    entry->slot = slot;
+    entry->prev = ESP_NCP_ZB_TIMER_NONE;
+    entry->next = s_timer.head[slot];
+    if (entry->next != ESP_NCP_ZB_TIMER_NONE) {
+        s_timer.entry[entry->next].prev = index;
+    }
+    s_timer.head[slot] = index;
+}
+
+static void esp_ncp_zb_timer_unlink(uint16_t index)
+{
+    esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+
+    if (entry->prev != ESP_NCP_ZB_TIMER_NONE) {
+        s_timer.entry[entry->prev].next = entry->next;
+    } else {
+        s_timer.head[entry->slot] = entry->next;
+    }
+    if (entry->next != ESP_NCP_ZB_TIMER_NONE) {
+        s_timer.entry[entry->next].prev = entry->prev;
+    }
+}
+
+static void esp_ncp_zb_timer_release(uint16_t index)
+{
+    esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+
+    free(entry->action);
+    entry->action = NULL;
+    entry->slot = ESP_NCP_ZB_TIMER_NONE;
+    entry->next = s_timer.free;
+    s_timer.free = index;
+    s_timer.stats.pending --;
+}
+
+/* Moves the timers of a higher level slot down, now that their ticks are in reach of the level below */
+static void esp_ncp_zb_timer_cascade(uint16_t slot)
+{
+    uint16_t index = s_timer.head[slot];
+
+    s_timer.head[slot] = ESP_NCP_ZB_TIMER_NONE;
+    while (index != ESP_NCP_ZB_TIMER_NONE) {
+        uint16_t next = s_timer.entry[index].next;
+        esp_ncp_zb_timer_link(index);
+        index = next;
+    }
+}
+
+static void esp_ncp_zb_timer_fire(uint16_t index)
+{
+    esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+    int64_t late = esp_ncp_time_us() - (s_timer.base_us + (int64_t)entry->expires * ESP_NCP_ZB_TIMER_TICK_US);
+    uint32_t late_us = (late > 0) ? (uint32_t)late : 0;
+    uint8_t bucket = 0;
+
+    if (esp_ncp_zb_rule_action_send(entry->action) != ESP_OK) {
+        s_timer.stats.errors ++;
+    }
+
+    while (bucket < ESP_NCP_ZB_TIMER_HIST_BUCKETS - 1 && late_us >= (ESP_NCP_ZB_TIMER_HIST_BASE_US << bucket)) {
+        bucket ++;
+    }
+    s_timer.stats.hist[bucket] ++;
+    s_timer.stats.fired ++;
+    s_timer.jitter_sum += late_us;
+    s_timer.stats.jitter_max_us = (late_us > s_timer.stats.jitter_max_us) ? late_us : s_timer.stats.jitter_max_us;
+
+    if (entry->period_ms) {
+        entry->expires += (uint32_t)(((uint64_t)entry->period_ms + ESP_NCP_ZB_TIMER_TICK_MS - 1) / ESP_NCP_ZB_TIMER_TICK_MS);
+        esp_ncp_zb_timer_link(index);
+    } else {
+        esp_ncp_zb_timer_release(index);
+    }
+}
+
+static void esp_ncp_zb_timer_arm(void);
+
+static void esp_ncp_zb_timer_tick_cb(void *param)
+{
+    uint32_t until = esp_ncp_zb_timer_tick_now();
+
+    s_timer.armed = false;
+
+    /* A late alarm runs every missed tick, so no timer is skipped */
+    while ((int32_t)(until - s_timer.now) >= 0 && s_timer.stats.pending) {
+        uint32_t root = s_timer.now & ESP_NCP_ZB_TIMER_ROOT_MASK;
+
+        for (int level = 1; root == 0 && level < ESP_NCP_ZB_TIMER_LEVELS; level ++) {
+            int shift = ESP_NCP_ZB_TIMER_ROOT_BITS + (level - 1) * ESP_NCP_ZB_TIMER_LEVEL_BITS;
+            uint32_t index = (s_timer.now >> shift) & ESP_NCP_ZB_TIMER_LEVEL_MASK;
+
+            esp_ncp_zb_timer_cascade(ESP_NCP_ZB_TIMER_ROOT_SIZE + (level - 1) * ESP_NCP_ZB_TIMER_LEVEL_SIZE + index);
+            if (index) {
+                break;
+            }
+        }
+
+        s_timer.now ++;
+
+        uint16_t index = s_timer.head[root];
+        s_timer.head[root] = ESP_NCP_ZB_TIMER_NONE;
+        while (index != ESP_NCP_ZB_TIMER_NONE) {
+            uint16_t next = s_timer.entry[index].next;
+            esp_ncp_zb_timer_fire(index);
+            index = next;
+        }
+    }
+
+    esp_ncp_zb_timer_arm();
+}
+
+static void esp_ncp_zb_timer_arm(void)
+{
+    if (s_timer.stats.pending && !s_timer.armed) {
+        int64_t wait = s_timer.base_us + (int64_t)s_timer.now * ESP_NCP_ZB_TIMER_TICK_US - esp_ncp_time_us();
+        uint32_t wait_ms = (wait > 0) ? (uint32_t)((wait + 999) / 1000) : 0;
+
+        esp_zb_scheduler_user_alarm(esp_ncp_zb_timer_tick_cb, NULL, wait_ms);
+        s_timer.armed = true;
+    }
+}
+
+static esp_err_t esp_ncp_zb_timer_init(void)
+{
+    if (s_timer.entry) {
+        return ESP_OK;
+    }
+
+    s_timer.entry = calloc(ESP_NCP_ZB_TIMER_MAX, sizeof(esp_ncp_zb_timer_entry_t));
+    ESP_RETURN_ON_FALSE(s_timer.entry, ESP_ERR_NO_MEM, TAG, "No memory for the timer table");
+
+    for (int i = 0; i < ESP_NCP_ZB_TIMER_MAX; i ++) {
+        s_timer.entry[i].slot = ESP_NCP_ZB_TIMER_NONE;
+        s_timer.entry[i].next = (i + 1 < ESP_NCP_ZB_TIMER_MAX) ? i + 1 : ESP_NCP_ZB_TIMER_NONE;
+    }
+    for (int i = 0; i < ESP_NCP_ZB_TIMER_SLOTS; i ++) {
+        s_timer.head[i] = ESP_NCP_ZB_TIMER_NONE;
+    }
+    s_timer.free = 0;
+    s_timer.base_us = esp_ncp_time_us();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ncp_zb_timer_add(uint64_t delay_ms, uint32_t period_ms, const uint8_t *action, uint8_t action_len, uint32_t *id)
+{
+    ESP_RETURN_ON_FALSE(delay_ms <= ESP_NCP_ZB_TIMER_MAX_DELAY_MS, ESP_ERR_INVALID_ARG, TAG, "Timer deadline out of range");
+    ESP_RETURN_ON_FALSE(action && esp_ncp_zb_rule_action_verify(action, action_len), ESP_ERR_INVALID_ARG, TAG, "Invalid timer command");
+    ESP_RETURN_ON_ERROR(esp_ncp_zb_timer_init(), TAG, "Timer table unavailable");
+    ESP_RETURN_ON_FALSE(s_timer.free != ESP_NCP_ZB_TIMER_NONE, ESP_ERR_NO_MEM, TAG, "Timer table full");
+
+    uint16_t index = s_timer.free;
+    esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+    uint32_t now = esp_ncp_zb_timer_tick_now();
+
+    entry->action = malloc(action_len);
+    ESP_RETURN_ON_FALSE(entry->action, ESP_ERR_NO_MEM, TAG, "No memory for the timer command");
+    memcpy(entry->action, action, action_len);
+
+    /* An empty wheel has nothing to catch up with */
+    if (!s_timer.stats.pending) {
+        s_timer.now = now;
+    }
+
+    s_timer.free = entry->next;
+    s_timer.gen = (s_timer.gen + 1) ? s_timer.gen + 1 : 1;
+    entry->gen = s_timer.gen;
+    entry->action_len = action_len;
+    entry->period_ms = period_ms;
+    entry->expires = now + (uint32_t)((delay_ms + ESP_NCP_ZB_TIMER_TICK_MS - 1) / ESP_NCP_ZB_TIMER_TICK_MS);
+    esp_ncp_zb_timer_link(index);
+
+    s_timer.stats.pending ++;
+    s_timer.stats.max_pending = (s_timer.stats.pending > s_timer.stats.max_pending) ? s_timer.stats.pending : s_timer.stats.max_pending;
+    if (id) {
+        *id = ((uint32_t)entry->gen << 16) | index;
+    }
+
+    esp_ncp_zb_timer_arm();
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ncp_zb_timer_cancel(uint32_t id)
+{
+    uint16_t index = id & 0xFFFF;
+
+    ESP_RETURN_ON_FALSE(s_timer.entry && index < ESP_NCP_ZB_TIMER_MAX && s_timer.entry[index].slot != ESP_NCP_ZB_TIMER_NONE
+                        && s_timer.entry[index].gen == (id >> 16), ESP_ERR_NOT_FOUND, TAG, "No timer 0x%08" PRIx32, id);
+
+    esp_ncp_zb_timer_unlink(index);
+    esp_ncp_zb_timer_release(index);
+
+    return ESP_OK;
+}
+
+uint16_t esp_ncp_zb_timer_list(uint16_t start, esp_ncp_zb_timer_info_t *info, uint16_t max, uint16_t *next)
+{
+    uint32_t now = s_timer.entry ? esp_ncp_zb_timer_tick_now() : 0;
+    uint16_t count = 0;
+    uint16_t index = start;
+
+    for (; s_timer.entry && index < ESP_NCP_ZB_TIMER_MAX && count < max; index ++) {
+        esp_ncp_zb_timer_entry_t *entry = &s_timer.entry[index];
+        int32_t remaining = (int32_t)(entry->expires - now);
+        uint64_t remaining_ms = (remaining > 0) ? (uint64_t)remaining * ESP_NCP_ZB_TIMER_TICK_MS : 0;
+
+        if (entry->slot == ESP_NCP_ZB_TIMER_NONE) {
+            continue;
+        }
+
+        info[count].id = ((uint32_t)entry->gen << 16) | index;
+        info[count].remaining_ms = (remaining_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)remaining_ms;
+        info[count].period_ms = entry->period_ms;
+        count ++;
+    }
+
+    if (next) {
+        *next = (s_timer.entry && index < ESP_NCP_ZB_TIMER_MAX) ? index : 0;
+    }
+
+    return count;
+}
+
+void esp_ncp_zb_timer_stats_get(esp_ncp_zb_timer_stats_t *stats, bool reset)
+{
+    s_timer.stats.jitter_avg_us = s_timer.stats.fired ? (uint32_t)(s_timer.jitter_sum / s_timer.stats.fired) : 0;
+
+    if (stats) {
+        memcpy(stats, &s_timer.stats, sizeof(esp_ncp_zb_timer_stats_t));
+    }
+
+    if (reset) {
+        uint16_t pending = s_timer.stats.pending;
+
+        memset(&s_timer.stats, 0, sizeof(esp_ncp_zb_timer_stats_t));
+        s_timer.stats.pending = pending;
+        s_timer.stats.max_pending = pending;
+        s_timer.jitter_sum = 0;
+    }
+}
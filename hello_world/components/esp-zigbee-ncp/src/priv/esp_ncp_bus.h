@@ -32,6 +32,8 @@ typedef enum {
 #define NCP_BUS_TASK_STACK              4096
 #define NCP_BUS_TASK_PRIORITY           18
 #define NCP_BUS_BUF_SIZE                1024
+#define NCP_BUS_READ_TIMEOUT_MS         100
+#define NCP_BUS_FRAME_SIZE              4096
 
 /**
  * @brief A function for bus initialize.
@@ -57,14 +59,17 @@ typedef esp_err_t (*deinit_fn)(void);
 /**
  * @brief A function for receive data from bus.
  *
+ * @note The function blocks at most NCP_BUS_READ_TIMEOUT_MS, so the bus task is able to stop.
+ *
  * @param[in] buffer The pointer to storage the data from bus
- * @param[in] size   The length to storage the data from bus
+ * @param[in, out] size The length to storage the data from bus, set to the length received on return
  *
  * @return 
  *     - ESP_OK on success
+ *     - ESP_ERR_TIMEOUT if no data is received
  *     - others: refer to esp_err.h
  */
-typedef esp_err_t (*read_fn)(void *buffer, uint16_t size);
+typedef esp_err_t (*read_fn)(void *buffer, uint16_t *size);
 
 /** 
  * @brief A function for send data to bus.
@@ -89,8 +94,24 @@ typedef struct {
     void *input_buf;                    /*!< The pointer to storage the data from NCP */
     void *output_buf;                   /*!< The pointer to storage the data to NCP */
     SemaphoreHandle_t input_sem;        /*!< A semaphore handle for process the data from NCP */
+    uint8_t *frame;                     /*!< The frame from the host being reassembled, starting with SLIP_END */
+    uint16_t frame_len;                 /*!< The length of the frame being reassembled */
+    bool frame_drop;                    /*!< The frame being reassembled exceeds NCP_BUS_FRAME_SIZE and is dropped */
 } esp_ncp_bus_t;
 
+/** 
+ * @brief  Set the transport functions of NCP bus.
+ *
+ * @note Implemented by the transport selected in menuconfig, such as UART on the chip or PTY on the Linux target.
+ * 
+ * @param[in] bus The pointer to the bus handler @ref esp_ncp_bus_t
+ * 
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_bus_transport_register(esp_ncp_bus_t *bus);
+
 /** 
  * @brief  Input from NCP bus.
  * 
@@ -105,6 +126,8 @@ esp_err_t esp_ncp_bus_input(const void *buffer, uint16_t len);
 
 /** 
  * @brief  Output to NCP bus.
+ *
+ * @note The data is split into SLIP frames, a host may pipeline any number of frames and one may span several reads.
  * 
  * @param[in] buffer The output buffer pointer
  * @param[in] len    The output buffer length
@@ -115,6 +138,27 @@ esp_err_t esp_ncp_bus_input(const void *buffer, uint16_t len);
  */
 esp_err_t esp_ncp_bus_output(const void *buffer, uint16_t len);
 
+/**
+ * @brief  Report that the host disconnected from the transport.
+ *
+ * @note Called by the transports with a connection per host, the frame the old host left half sent is dropped once
+ *       the bytes read before the disconnection are processed, so it is not glued onto the first frame of the next host.
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_bus_disconnect(void);
+
+/**
+ * @brief  Drop the frame being reassembled.
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_bus_frame_reset(void);
+
 /** 
  * @brief  Initialize NCP bus.
  * 
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+/**
+ * The capture file, little endian, the same format as esp_ncp/capture.hpp of the host library:
+ *
+ * File header:   magic "NCPC" (4), version (2), origin (2), start time in ns since the Unix epoch (8), index offset (8)
+ * Record:        length and direction (4, bit 31 is the direction), time in ns since the start (8), the raw SLIP frame
+ * Index:         magic "NCPI" (4), count (4), then per entry: record number (8), file offset (8), time (8)
+ */
+#define ESP_NCP_CAPTURE_MAGIC               0x4350434E  /*!< "NCPC" */
+#define ESP_NCP_CAPTURE_INDEX_MAGIC         0x4950434E  /*!< "NCPI" */
+#define ESP_NCP_CAPTURE_VERSION             1
+#define ESP_NCP_CAPTURE_ORIGIN_NCP          1           /*!< The capture is written by the NCP */
+#define ESP_NCP_CAPTURE_INDEX_INTERVAL      256         /*!< The records between two index entries, the file is flushed as often */
+#define ESP_NCP_CAPTURE_DIRECTION_BIT       0x80000000
+
+/**
+ * @brief Enum of the direction of a captured frame.
+ *
+ */
+typedef enum {
+    ESP_NCP_CAPTURE_TO_NCP = 0,             /*!< From the host to the NCP */
+    ESP_NCP_CAPTURE_FROM_NCP = 1,           /*!< From the NCP to the host */
+} esp_ncp_capture_dir_t;
+
+/**
+ * @brief  Create the capture file.
+ *
+ * @param[in] path The file path
+ *
+ * @return
+ *    - ESP_OK on success
+ *    - ESP_FAIL if the file can not be created
+ */
+esp_err_t esp_ncp_capture_open(const char *path);
+
+/**
+ * @brief  Append a frame to the capture, if it is open.
+ *
+ * @note Called from any task, the records are serialized by a mutex.
+ *
+ * @param[in] dir  The direction of the frame
+ * @param[in] data The raw SLIP frame
+ * @param[in] len  The length of the frame
+ */
+void esp_ncp_capture_record(esp_ncp_capture_dir_t dir, const void *data, size_t len);
+
+/**
+ * @brief  Write the index and close the capture file.
+ *
+ */
+void esp_ncp_capture_close(void);
+
+#ifdef __cplusplus
+}
+#endif
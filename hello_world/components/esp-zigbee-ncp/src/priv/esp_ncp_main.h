@@ -29,6 +29,7 @@ typedef enum {
     NCP_EVENT_OUTPUT,               /*!< Output event from host to NCP */
     NCP_EVENT_RESET,                /*!< Reset event from host to NCP */
     NCP_EVENT_LOOP_STOP,            /*!< Stop loop event from host to NCP */
+    NCP_EVENT_DISCONNECT,           /*!< The host disconnected, its partial frame is dropped */
 } esp_ncp_event_t;
 
 /**
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#if CONFIG_ZB_SIM_VIRTUAL_TIME
+#include "esp_zigbee_sim.h"
+#else
+#include "esp_timer.h"
+#endif
+
+/**
+ * @brief Get the time of the NCP, the virtual clock of the simulation when configured, esp_timer otherwise.
+ *
+ * @return The time since the start in microseconds
+ */
+static inline int64_t esp_ncp_time_us(void)
+{
+#if CONFIG_ZB_SIM_VIRTUAL_TIME
+    return esp_zb_sim_time_us();
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,2564 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by wire/esp_ncp_wire_gen.py from wire/esp_ncp_wire.json, do not edit */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief A short or long address, esp_zb_addr_u on the wire.
+ *
+ */
+typedef struct {
+    uint8_t bytes[8];                               /*!< The long address, or the short address in the first 2 bytes */
+} esp_ncp_wire_addr_t;
+
+static inline uint16_t esp_ncp_wire_get_u16(const uint8_t *buf, size_t index)
+{
+    return (uint16_t)(buf[2 * index] | (buf[2 * index + 1] << 8));
+}
+
+static inline uint16_t esp_ncp_wire_addr_short(const esp_ncp_wire_addr_t *addr)
+{
+    return esp_ncp_wire_get_u16(addr->bytes, 0);
+}
+
+static inline void esp_ncp_wire_addr_set_short(esp_ncp_wire_addr_t *addr, uint16_t short_addr)
+{
+    addr->bytes[0] = (uint8_t)short_addr;
+    addr->bytes[1] = (uint8_t)(short_addr >> 8);
+}
+
+#define ESP_NCP_WIRE_STATUS_FIXED_SIZE                  1
+#define ESP_NCP_WIRE_STATUS_TSN_FIXED_SIZE              2
+#define ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE           10
+#define ESP_NCP_WIRE_ZCL_ATTR_DATA_FIXED_SIZE           4
+#define ESP_NCP_WIRE_ZCL_ATTR_READ_FIXED_SIZE           14
+#define ESP_NCP_WIRE_ZCL_ATTR_WRITE_FIXED_SIZE          14
+#define ESP_NCP_WIRE_APS_DATA_REQUEST_FIXED_SIZE        31
+#define ESP_NCP_WIRE_ZCL_WRITE_FIXED_SIZE               21
+#define ESP_NCP_WIRE_ZCL_ATTR_READ_BULK_FIXED_SIZE      11
+#define ESP_NCP_WIRE_ZCL_TIMER_ADD_FIXED_SIZE           14
+#define ESP_NCP_WIRE_STATUS_ID_FIXED_SIZE               5
+#define ESP_NCP_WIRE_NETWORK_SIGNAL_SUBSCRIBE_FIXED_SIZE 8
+#define ESP_NCP_WIRE_NETWORK_JOIN_BATCH_CONFIG_FIXED_SIZE 4
+#define ESP_NCP_WIRE_IC_REMOVE_RECORD_FIXED_SIZE        8
+#define ESP_NCP_WIRE_NETWORK_IC_REMOVE_BULK_FIXED_SIZE  2
+#define ESP_NCP_WIRE_ZCL_REPORT_RECORD_FIXED_SIZE       15
+#define ESP_NCP_WIRE_ZCL_REPORT_CONFIG_FIXED_SIZE       20
+#define ESP_NCP_WIRE_ZCL_SCHED_CONFIG_FIXED_SIZE        9
+#define ESP_NCP_WIRE_ZCL_WRITE_MULTI_FIXED_SIZE         14
+#define ESP_NCP_WIRE_ZCL_RULE_ADD_FIXED_SIZE            12
+#define ESP_NCP_WIRE_ZCL_RULE_DEL_FIXED_SIZE            1
+#define ESP_NCP_WIRE_ZCL_RULE_STATS_FIXED_SIZE          2
+#define ESP_NCP_WIRE_ZCL_TIMER_CANCEL_FIXED_SIZE        4
+#define ESP_NCP_WIRE_ZDO_INTERROGATE_CONFIG_FIXED_SIZE  3
+#define ESP_NCP_WIRE_ZDO_INTERROGATE_FIXED_SIZE         2
+#define ESP_NCP_WIRE_APS_BULK_DST_FIXED_SIZE            11
+#define ESP_NCP_WIRE_APS_DATA_REQUEST_BULK_FIXED_SIZE   13
+#define ESP_NCP_WIRE_APS_DATA_INDICATION_FIXED_SIZE     36
+
+/**
+ * @brief The status response of most requests.
+ * @note The response of ESP_NCP_NETWORK_SIGNAL_SUBSCRIBE.
+ * @note The response of ESP_NCP_NETWORK_JOIN_BATCH_CONFIG.
+ * @note The response of ESP_NCP_ZCL_ATTR_READ_BULK.
+ * @note The response of ESP_NCP_ZCL_SCHED_CONFIG.
+ * @note The response of ESP_NCP_ZCL_RULE_ADD.
+ * @note The response of ESP_NCP_ZCL_RULE_DEL.
+ * @note The response of ESP_NCP_ZCL_TIMER_CANCEL.
+ * @note The response of ESP_NCP_ZDO_INTERROGATE_CONFIG.
+ * @note The response of ESP_NCP_ZDO_INTERROGATE.
+ * @note The response of ESP_NCP_APS_DATA_REQUEST.
+ * @note The response of ESP_NCP_APS_DATA_REQUEST_BULK.
+ *
+ */
+typedef struct {
+    uint8_t status;                                     /*!< The status, refer to esp_ncp_status_t */
+} esp_ncp_wire_status_t;
+
+/**
+ * @brief The status response of the ZCL requests.
+ * @note The response of ESP_NCP_ZCL_ATTR_READ.
+ * @note The response of ESP_NCP_ZCL_ATTR_WRITE.
+ * @note The response of ESP_NCP_ZCL_WRITE.
+ * @note The response of ESP_NCP_ZCL_REPORT_CONFIG.
+ *
+ */
+typedef struct {
+    uint8_t status;                                     /*!< The status, refer to esp_ncp_status_t */
+    uint8_t tsn;                                        /*!< The ZCL transaction sequence number of the command */
+} esp_ncp_wire_status_tsn_t;
+
+/**
+ * @brief esp_zb_zcl_basic_cmd_t.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_addr_t dst_addr;                       /*!< The short or long address of the destination */
+    uint8_t dst_endpoint;                               /*!< The destination endpoint */
+    uint8_t src_endpoint;                               /*!< The source endpoint */
+} esp_ncp_wire_zcl_basic_cmd_t;
+
+/**
+ * @brief One attribute of a ZCL write.
+ *
+ */
+typedef struct {
+    uint16_t id;                                        /*!< The attribute ID */
+    uint8_t type;                                       /*!< The attribute type, refer to esp_zb_zcl_attr_type_t */
+    uint8_t size;                                       /*!< The size of the value */
+    const uint8_t *value;                               /*!< The value, size bytes */
+} esp_ncp_wire_zcl_attr_data_t;
+
+/**
+ * @brief Read attributes of a remote device.
+ * @note The request of ESP_NCP_ZCL_ATTR_READ.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_zcl_basic_cmd_t zcl_basic_cmd;         /*!< Basic command info */
+    uint8_t address_mode;                               /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id;                                /*!< Cluster ID to read */
+    uint8_t attr_number;                                /*!< Number of attribute in the attr_field */
+    const uint8_t *attr_field;                          /*!< The attribute IDs, attr_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+} esp_ncp_wire_zcl_attr_read_t;
+
+/**
+ * @brief Write attributes of a remote device.
+ * @note The request of ESP_NCP_ZCL_ATTR_WRITE.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_zcl_basic_cmd_t zcl_basic_cmd;         /*!< Basic command info */
+    uint8_t address_mode;                               /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id;                                /*!< Cluster ID to write */
+    uint8_t attr_number;                                /*!< Number of attribute in the attr_field */
+    const uint8_t *attr_field;                          /*!< The attributes, attr_number records read with esp_ncp_wire_zcl_attr_data_next() */
+    size_t attr_field_len;                              /*!< The bytes of the attr_field records */
+} esp_ncp_wire_zcl_attr_write_t;
+
+/**
+ * @brief Send an APS data frame.
+ * @note The request of ESP_NCP_APS_DATA_REQUEST.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_zcl_basic_cmd_t basic_cmd;             /*!< Basic command info */
+    uint8_t dst_addr_mode;                              /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t profile_id;                                /*!< Profile id */
+    uint16_t cluster_id;                                /*!< Cluster id */
+    uint8_t tx_options;                                 /*!< The transmission options for the ASDU to be transferred, refer to esp_zb_apsde_tx_opt_t */
+    bool use_alias;                                     /*!< Request alias usage by NWK layer for the current frame */
+    esp_ncp_wire_addr_t alias_src_addr;                 /*!< The source address to be used for this NSDU, if the use_alias is true */
+    uint8_t alias_seq_num;                              /*!< The sequence number to be used for this NSDU, if the use_alias is true */
+    uint8_t radius;                                     /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+    uint32_t asdu_length;                               /*!< The number of octets comprising the ASDU to be transferred */
+    const uint8_t *asdu;                                /*!< The ASDU, asdu_length bytes */
+} esp_ncp_wire_aps_data_request_t;
+
+/**
+ * @brief Send a cluster command to a remote device.
+ * @note The request of ESP_NCP_ZCL_WRITE.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_zcl_basic_cmd_t zcl_basic_cmd;         /*!< Basic command info */
+    uint8_t address_mode;                               /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t profile_id;                                /*!< Profile id */
+    uint16_t cluster_id;                                /*!< Cluster id */
+    uint16_t custom_cmd_id;                             /*!< Custom command id */
+    uint8_t direction;                                  /*!< Direction of command */
+    uint8_t type;                                       /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+    uint16_t size;                                      /*!< The size of the value */
+    const uint8_t *value;                               /*!< The value, size bytes */
+} esp_ncp_wire_zcl_write_t;
+
+/**
+ * @brief Read the same attributes from a list of devices.
+ * @note The request of ESP_NCP_ZCL_ATTR_READ_BULK.
+ *
+ */
+typedef struct {
+    uint8_t src_endpoint;                               /*!< Source endpoint */
+    uint8_t dst_endpoint;                               /*!< Destination endpoint on every device */
+    uint16_t cluster_id;                                /*!< Cluster ID to read */
+    uint8_t concurrency;                                /*!< The number of devices read at the same time, 0 to use the default */
+    uint8_t retries;                                    /*!< The number of retries after a timeout */
+    uint16_t timeout_ms;                                /*!< The time to wait for the response of one device, 0 to use the default */
+    uint8_t attr_number;                                /*!< Number of attribute IDs */
+    uint16_t dev_number;                                /*!< Number of device short addresses */
+    const uint8_t *attr_field;                          /*!< The attribute IDs, attr_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+    const uint8_t *dev_field;                           /*!< The short addresses of the devices, dev_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+} esp_ncp_wire_zcl_attr_read_bulk_t;
+
+/**
+ * @brief Queue a command until a relative or absolute deadline.
+ * @note The request of ESP_NCP_ZCL_TIMER_ADD.
+ *
+ */
+typedef struct {
+    bool absolute;                                      /*!< The deadline is a UTC time in seconds, otherwise a delay in milliseconds */
+    uint32_t deadline;                                  /*!< The deadline of the command */
+    uint32_t utc_now;                                   /*!< The UTC time of the host in seconds, only used with an absolute deadline */
+    uint32_t period_ms;                                 /*!< The period to send the command again, 0 to send it once */
+    uint8_t action_len;                                 /*!< The length of the command */
+    const uint8_t *action;                              /*!< The command, encoded as a rule action, action_len bytes */
+} esp_ncp_wire_zcl_timer_add_t;
+
+/**
+ * @brief The status response of the requests which create an object.
+ * @note The response of ESP_NCP_ZCL_TIMER_ADD.
+ *
+ */
+typedef struct {
+    uint8_t status;                                     /*!< The status, refer to esp_ncp_status_t */
+    uint32_t id;                                        /*!< The ID of the object */
+} esp_ncp_wire_status_id_t;
+
+/**
+ * @brief Subscribe to the stack signals.
+ * @note The request of ESP_NCP_NETWORK_SIGNAL_SUBSCRIBE.
+ *
+ */
+typedef struct {
+    uint64_t signal_mask;                               /*!< The signals forwarded to the host, bit n for the signal type n */
+} esp_ncp_wire_network_signal_subscribe_t;
+
+/**
+ * @brief Configure the batching of the join events.
+ * @note The request of ESP_NCP_NETWORK_JOIN_BATCH_CONFIG.
+ *
+ */
+typedef struct {
+    bool enable;                                        /*!< Batch the events, otherwise every device announce is notified on its own */
+    uint8_t max_records;                                /*!< The number of devices which flushes a batch, 0 to keep the current value */
+    uint16_t flush_ms;                                  /*!< The time a batch is held after its first event, 0 to keep the current value */
+} esp_ncp_wire_network_join_batch_config_t;
+
+/**
+ * @brief One device of a bulk install code removal.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_addr_t ieee_addr;                      /*!< The long address of the device */
+} esp_ncp_wire_ic_remove_record_t;
+
+/**
+ * @brief Remove the install codes of a list of devices.
+ * @note The request of ESP_NCP_NETWORK_IC_REMOVE_BULK.
+ *
+ */
+typedef struct {
+    uint16_t count;                                     /*!< The number of devices */
+    const uint8_t *records;                             /*!< The devices, count records read with esp_ncp_wire_ic_remove_record_next() */
+    size_t records_len;                                 /*!< The bytes of the records records */
+} esp_ncp_wire_network_ic_remove_bulk_t;
+
+/**
+ * @brief One reporting record of a report configuration.
+ *
+ */
+typedef struct {
+    uint16_t attr_id;                                   /*!< Attribute ID to report */
+    uint8_t attr_type;                                  /*!< Attribute type to report, refer to esp_zb_zcl_attr_type_t */
+    uint16_t min_interval;                              /*!< Minimum reporting interval */
+    uint16_t max_interval;                              /*!< Maximum reporting interval */
+    uint64_t reportable_change;                         /*!< Minimum change to attribute will result in report, in the size of the attribute type */
+} esp_ncp_wire_zcl_report_record_t;
+
+/**
+ * @brief Configure the reporting of a remote device or a list of devices.
+ * @note The request of ESP_NCP_ZCL_REPORT_CONFIG.
+ *
+ */
+typedef struct {
+    esp_ncp_wire_zcl_basic_cmd_t zcl_basic_cmd;         /*!< Basic command info, the destination address is ignored in batch mode */
+    uint8_t address_mode;                               /*!< APS addressing mode constants refer to esp_zb_zcl_address_mode_t */
+    uint16_t cluster_id;                                /*!< Cluster ID to configure */
+    uint8_t concurrency;                                /*!< The number of devices configured at the same time in batch mode, 0 to use the default */
+    uint8_t retries;                                    /*!< The number of retries after a timeout in batch mode */
+    uint16_t timeout_ms;                                /*!< The time to wait for the response of one device in batch mode, 0 to use the default */
+    uint8_t record_number;                              /*!< Number of reporting records */
+    uint16_t dev_number;                                /*!< Number of device short addresses, 0 to send to the destination address */
+    const uint8_t *record_field;                        /*!< The reporting records, record_number records read with esp_ncp_wire_zcl_report_record_next() */
+    size_t record_field_len;                            /*!< The bytes of the record_field records */
+    const uint8_t *dev_field;                           /*!< The short addresses of the devices, dev_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+} esp_ncp_wire_zcl_report_config_t;
+
+/**
+ * @brief Configure the air-time scheduler.
+ * @note The request of ESP_NCP_ZCL_SCHED_CONFIG.
+ *
+ */
+typedef struct {
+    bool enable;                                        /*!< Schedule the ZCL requests, otherwise they are sent at once */
+    uint16_t rate;                                      /*!< The air-time budget in bytes per second, 0 to keep the current value */
+    uint16_t burst;                                     /*!< The token bucket depth in bytes, 0 to keep the current value */
+    uint16_t dst_gap_ms;                                /*!< The minimum gap between two frames to the same destination, 0 to keep the current value */
+    uint16_t hop_gap_ms;                                /*!< The minimum gap between two frames through the same next hop, 0 to keep the current value */
+} esp_ncp_wire_zcl_sched_config_t;
+
+/**
+ * @brief Send the same cluster command to a list of devices.
+ * @note The request of ESP_NCP_ZCL_WRITE_MULTI.
+ *
+ */
+typedef struct {
+    uint8_t src_endpoint;                               /*!< Source endpoint */
+    uint8_t dst_endpoint;                               /*!< Destination endpoint on every device */
+    uint16_t profile_id;                                /*!< Profile id */
+    uint16_t cluster_id;                                /*!< Cluster id */
+    uint16_t custom_cmd_id;                             /*!< Custom command id */
+    uint8_t direction;                                  /*!< Direction of command */
+    uint8_t type;                                       /*!< The type of the value, refer to esp_zb_zcl_attr_type_t */
+    uint16_t size;                                      /*!< The size of the value */
+    uint16_t dev_number;                                /*!< Number of device short addresses */
+    const uint8_t *value;                               /*!< The value, size bytes */
+    const uint8_t *dev_field;                           /*!< The short addresses of the devices, dev_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+} esp_ncp_wire_zcl_write_multi_t;
+
+/**
+ * @brief Install a rule which sends a command when a report or indication matches.
+ * @note The request of ESP_NCP_ZCL_RULE_ADD.
+ *
+ */
+typedef struct {
+    uint8_t rule_id;                                    /*!< The rule index, an installed rule is replaced */
+    uint8_t flags;                                      /*!< The rule flags, refer to ESP_NCP_ZB_RULE_FLAG_EDGE */
+    uint8_t trigger;                                    /*!< The trigger, refer to esp_ncp_zb_rule_trigger_t */
+    uint16_t src_addr;                                  /*!< The short address of the source, 0xFFFF for any */
+    uint8_t src_endpoint;                               /*!< The source endpoint, 0xFF for any */
+    uint16_t cluster_id;                                /*!< The cluster of the report or indication */
+    uint16_t attr_id;                                   /*!< The reported attribute, 0xFFFF for any */
+    uint8_t code_len;                                   /*!< The length of the condition bytecode */
+    uint8_t action_len;                                 /*!< The length of the encoded action */
+    const uint8_t *code;                                /*!< The condition bytecode, code_len bytes */
+    const uint8_t *action;                              /*!< The command, encoded as a rule action, action_len bytes */
+} esp_ncp_wire_zcl_rule_add_t;
+
+/**
+ * @brief Remove a rule.
+ * @note The request of ESP_NCP_ZCL_RULE_DEL.
+ *
+ */
+typedef struct {
+    uint8_t rule_id;                                    /*!< The rule index */
+} esp_ncp_wire_zcl_rule_del_t;
+
+/**
+ * @brief Read the statistics of a rule.
+ * @note The request of ESP_NCP_ZCL_RULE_STATS.
+ *
+ */
+typedef struct {
+    uint8_t rule_id;                                    /*!< The rule index */
+    bool reset;                                         /*!< Reset the statistics once read */
+} esp_ncp_wire_zcl_rule_stats_t;
+
+/**
+ * @brief Cancel a queued command.
+ * @note The request of ESP_NCP_ZCL_TIMER_CANCEL.
+ *
+ */
+typedef struct {
+    uint32_t id;                                        /*!< The ID given when the command was queued */
+} esp_ncp_wire_zcl_timer_cancel_t;
+
+/**
+ * @brief Configure the interrogation of the devices.
+ * @note The request of ESP_NCP_ZDO_INTERROGATE_CONFIG.
+ *
+ */
+typedef struct {
+    bool auto_enable;                                   /*!< Interrogate every device which announces itself */
+    uint8_t concurrency;                                /*!< The number of devices interrogated at the same time, 0 to use the default */
+    uint8_t retries;                                    /*!< The number of retries of one ZDO request */
+} esp_ncp_wire_zdo_interrogate_config_t;
+
+/**
+ * @brief Interrogate a list of devices.
+ * @note The request of ESP_NCP_ZDO_INTERROGATE.
+ *
+ */
+typedef struct {
+    uint16_t dev_number;                                /*!< Number of device short addresses */
+    const uint8_t *dev_field;                           /*!< The short addresses of the devices, dev_number little endian uint16_t read with esp_ncp_wire_get_u16() */
+} esp_ncp_wire_zdo_interrogate_t;
+
+/**
+ * @brief One destination of a bulk APS data request.
+ *
+ */
+typedef struct {
+    uint8_t dst_addr_mode;                              /*!< The addressing mode for the destination address, refer to esp_zb_aps_address_mode_t */
+    esp_ncp_wire_addr_t dst_addr;                       /*!< The individual device address or group address of the destination */
+    uint8_t dst_endpoint;                               /*!< The destination endpoint */
+    uint8_t tx_options;                                 /*!< The transmission options for the destination, refer to esp_zb_apsde_tx_opt_t */
+} esp_ncp_wire_aps_bulk_dst_t;
+
+/**
+ * @brief Send the same APS data frame to a list of destinations.
+ * @note The request of ESP_NCP_APS_DATA_REQUEST_BULK.
+ *
+ */
+typedef struct {
+    uint8_t src_endpoint;                               /*!< The source endpoint */
+    uint16_t profile_id;                                /*!< Profile id */
+    uint16_t cluster_id;                                /*!< Cluster id */
+    uint8_t radius;                                     /*!< The distance, in hops, that a transmitted frame will be allowed to travel through the network */
+    uint16_t pacing_ms;                                 /*!< The delay between two destinations, 0 to use the default pacing */
+    uint8_t dst_count;                                  /*!< The number of destinations */
+    uint32_t asdu_length;                               /*!< The number of octets comprising the ASDU */
+    const uint8_t *dst;                                 /*!< The destinations, dst_count records read with esp_ncp_wire_aps_bulk_dst_next() */
+    size_t dst_len;                                     /*!< The bytes of the dst records */
+    const uint8_t *asdu;                                /*!< The ASDU, asdu_length bytes */
+} esp_ncp_wire_aps_data_request_bulk_t;
+
+/**
+ * @brief An APS data frame received.
+ * @note The response of ESP_NCP_APS_DATA_INDICATION.
+ * @note The notification of ESP_NCP_APS_DATA_INDICATION.
+ *
+ */
+typedef struct {
+    uint8_t states;                                     /*!< The states of the device */
+    uint8_t dst_addr_mode;                              /*!< The addressing mode for the destination address */
+    esp_ncp_wire_addr_t dst_addr;                       /*!< The individual device address or group address to which the ASDU is directed */
+    uint8_t dst_endpoint;                               /*!< The target endpoint on the local entity to which the ASDU is directed */
+    uint8_t src_addr_mode;                              /*!< The addressing mode for the source address */
+    esp_ncp_wire_addr_t src_addr;                       /*!< The individual device address of the entity from which the ASDU has been received */
+    uint8_t src_endpoint;                               /*!< The endpoint of the entity from which the ASDU has been received */
+    uint16_t profile_id;                                /*!< The identifier of the profile from which this frame originated */
+    uint16_t cluster_id;                                /*!< The identifier of the received object */
+    uint8_t indication_status;                          /*!< The status of the incoming frame processing, 0: on success */
+    uint8_t security_status;                            /*!< The security of the received ASDU */
+    uint8_t lqi;                                        /*!< The link quality indication delivered by the NLDE */
+    int32_t rx_time;                                    /*!< Reserved, a time indication for the received packet based on the local clock */
+    uint32_t asdu_length;                               /*!< The number of octets comprising the ASDU being indicated by the APSDE */
+    const uint8_t *asdu;                                /*!< The ASDU, asdu_length bytes */
+} esp_ncp_wire_aps_data_indication_t;
+
+static inline uint16_t esp_ncp_wire_le16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static inline uint32_t esp_ncp_wire_le32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static inline uint64_t esp_ncp_wire_le64(const uint8_t *buf)
+{
+    return (uint64_t)esp_ncp_wire_le32(buf) | ((uint64_t)esp_ncp_wire_le32(&buf[4]) << 32);
+}
+
+static inline void esp_ncp_wire_put16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static inline void esp_ncp_wire_put32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static inline void esp_ncp_wire_put64(uint8_t *buf, uint64_t value)
+{
+    esp_ncp_wire_put32(buf, (uint32_t)value);
+    esp_ncp_wire_put32(&buf[4], (uint32_t)(value >> 32));
+}
+
+static inline size_t esp_ncp_wire_status_get(const uint8_t *buf, size_t len, esp_ncp_wire_status_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 1) {
+        return 0;
+    }
+    msg->status = buf[pos];
+    pos += 1;
+
+    return pos;
+}
+
+/** The encoded size of the status payload */
+static inline size_t esp_ncp_wire_status_size(const esp_ncp_wire_status_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_STATUS_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_status_put(const esp_ncp_wire_status_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->status;
+    pos += 1;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the status payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_status_decode(const uint8_t *buf, size_t len, esp_ncp_wire_status_t *msg)
+{
+    return buf && msg && esp_ncp_wire_status_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the status payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_status_encode(const esp_ncp_wire_status_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_status_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_status_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_status_tsn_get(const uint8_t *buf, size_t len, esp_ncp_wire_status_tsn_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 2) {
+        return 0;
+    }
+    msg->status = buf[pos];
+    msg->tsn = buf[pos + 1];
+    pos += 2;
+
+    return pos;
+}
+
+/** The encoded size of the status_tsn payload */
+static inline size_t esp_ncp_wire_status_tsn_size(const esp_ncp_wire_status_tsn_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_STATUS_TSN_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_status_tsn_put(const esp_ncp_wire_status_tsn_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->status;
+    buf[pos + 1] = msg->tsn;
+    pos += 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the status_tsn payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_status_tsn_decode(const uint8_t *buf, size_t len, esp_ncp_wire_status_tsn_t *msg)
+{
+    return buf && msg && esp_ncp_wire_status_tsn_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the status_tsn payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_status_tsn_encode(const esp_ncp_wire_status_tsn_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_status_tsn_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_status_tsn_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_basic_cmd_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_basic_cmd_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 10) {
+        return 0;
+    }
+    memcpy(msg->dst_addr.bytes, &buf[pos], sizeof(msg->dst_addr.bytes));
+    msg->dst_endpoint = buf[pos + 8];
+    msg->src_endpoint = buf[pos + 9];
+    pos += 10;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_basic_cmd payload */
+static inline size_t esp_ncp_wire_zcl_basic_cmd_size(const esp_ncp_wire_zcl_basic_cmd_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_basic_cmd_put(const esp_ncp_wire_zcl_basic_cmd_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    memcpy(&buf[pos], msg->dst_addr.bytes, sizeof(msg->dst_addr.bytes));
+    buf[pos + 8] = msg->dst_endpoint;
+    buf[pos + 9] = msg->src_endpoint;
+    pos += 10;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_basic_cmd payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_basic_cmd_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_basic_cmd_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_basic_cmd_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_basic_cmd payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_basic_cmd_encode(const esp_ncp_wire_zcl_basic_cmd_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_basic_cmd_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_basic_cmd_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_data_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_data_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 4) {
+        return 0;
+    }
+    msg->id = esp_ncp_wire_le16(&buf[pos]);
+    msg->type = buf[pos + 2];
+    msg->size = buf[pos + 3];
+    pos += 4;
+    if (len - pos < msg->size) {
+        return 0;
+    }
+    msg->value = &buf[pos];
+    pos += msg->size;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_attr_data payload */
+static inline size_t esp_ncp_wire_zcl_attr_data_size(const esp_ncp_wire_zcl_attr_data_t *msg)
+{
+    size_t size = 4;
+
+    size += msg->size;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_data_put(const esp_ncp_wire_zcl_attr_data_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put16(&buf[pos], msg->id);
+    buf[pos + 2] = msg->type;
+    buf[pos + 3] = msg->size;
+    pos += 4;
+    if (msg->size) {
+        memcpy(&buf[pos], msg->value, msg->size);
+    }
+    pos += msg->size;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_attr_data payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_attr_data_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_data_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_attr_data_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_attr_data payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_attr_data_encode(const esp_ncp_wire_zcl_attr_data_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_attr_data_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_attr_data_put(msg, buf);
+}
+
+/**
+ * @brief  Decode the zcl_attr_data record at the offset of a list and move the offset past it.
+ *
+ * @return false at the end of the list or on a truncated record
+ */
+static inline bool esp_ncp_wire_zcl_attr_data_next(const uint8_t *buf, size_t len, size_t *offset, esp_ncp_wire_zcl_attr_data_t *msg)
+{
+    size_t used = (*offset < len) ? esp_ncp_wire_zcl_attr_data_get(&buf[*offset], len - *offset, msg) : 0;
+
+    *offset += used;
+
+    return used != 0;
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_read_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_read_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 14) {
+        return 0;
+    }
+    esp_ncp_wire_zcl_basic_cmd_get(&buf[pos], ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE, &msg->zcl_basic_cmd);
+    msg->address_mode = buf[pos + 10];
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 11]);
+    msg->attr_number = buf[pos + 13];
+    pos += 14;
+    if (len - pos < (size_t)msg->attr_number * 2) {
+        return 0;
+    }
+    msg->attr_field = &buf[pos];
+    pos += (size_t)msg->attr_number * 2;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_attr_read payload */
+static inline size_t esp_ncp_wire_zcl_attr_read_size(const esp_ncp_wire_zcl_attr_read_t *msg)
+{
+    size_t size = 14;
+
+    size += (size_t)msg->attr_number * 2;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_read_put(const esp_ncp_wire_zcl_attr_read_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_zcl_basic_cmd_put(&msg->zcl_basic_cmd, &buf[pos]);
+    buf[pos + 10] = msg->address_mode;
+    esp_ncp_wire_put16(&buf[pos + 11], msg->cluster_id);
+    buf[pos + 13] = msg->attr_number;
+    pos += 14;
+    if (msg->attr_number) {
+        memcpy(&buf[pos], msg->attr_field, (size_t)msg->attr_number * 2);
+    }
+    pos += (size_t)msg->attr_number * 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_attr_read payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_attr_read_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_read_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_attr_read_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_attr_read payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_attr_read_encode(const esp_ncp_wire_zcl_attr_read_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_attr_read_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_attr_read_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_write_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_write_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 14) {
+        return 0;
+    }
+    esp_ncp_wire_zcl_basic_cmd_get(&buf[pos], ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE, &msg->zcl_basic_cmd);
+    msg->address_mode = buf[pos + 10];
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 11]);
+    msg->attr_number = buf[pos + 13];
+    pos += 14;
+    msg->attr_field = &buf[pos];
+    for (size_t i = 0; i < msg->attr_number; i ++) {
+        esp_ncp_wire_zcl_attr_data_t record;
+        size_t used = esp_ncp_wire_zcl_attr_data_get(&buf[pos], len - pos, &record);
+
+        if (!used) {
+            return 0;
+        }
+        pos += used;
+    }
+    msg->attr_field_len = (size_t)(&buf[pos] - msg->attr_field);
+
+    return pos;
+}
+
+/** The encoded size of the zcl_attr_write payload */
+static inline size_t esp_ncp_wire_zcl_attr_write_size(const esp_ncp_wire_zcl_attr_write_t *msg)
+{
+    size_t size = 14;
+
+    size += msg->attr_field_len;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_write_put(const esp_ncp_wire_zcl_attr_write_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_zcl_basic_cmd_put(&msg->zcl_basic_cmd, &buf[pos]);
+    buf[pos + 10] = msg->address_mode;
+    esp_ncp_wire_put16(&buf[pos + 11], msg->cluster_id);
+    buf[pos + 13] = msg->attr_number;
+    pos += 14;
+    if (msg->attr_field_len) {
+        memcpy(&buf[pos], msg->attr_field, msg->attr_field_len);
+    }
+    pos += msg->attr_field_len;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_attr_write payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_attr_write_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_write_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_attr_write_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_attr_write payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_attr_write_encode(const esp_ncp_wire_zcl_attr_write_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_attr_write_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_attr_write_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_aps_data_request_get(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_request_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 31) {
+        return 0;
+    }
+    esp_ncp_wire_zcl_basic_cmd_get(&buf[pos], ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE, &msg->basic_cmd);
+    msg->dst_addr_mode = buf[pos + 10];
+    msg->profile_id = esp_ncp_wire_le16(&buf[pos + 11]);
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 13]);
+    msg->tx_options = buf[pos + 15];
+    msg->use_alias = buf[pos + 16] != 0;
+    memcpy(msg->alias_src_addr.bytes, &buf[pos + 17], sizeof(msg->alias_src_addr.bytes));
+    msg->alias_seq_num = buf[pos + 25];
+    msg->radius = buf[pos + 26];
+    msg->asdu_length = esp_ncp_wire_le32(&buf[pos + 27]);
+    pos += 31;
+    if (len - pos < msg->asdu_length) {
+        return 0;
+    }
+    msg->asdu = &buf[pos];
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/** The encoded size of the aps_data_request payload */
+static inline size_t esp_ncp_wire_aps_data_request_size(const esp_ncp_wire_aps_data_request_t *msg)
+{
+    size_t size = 31;
+
+    size += msg->asdu_length;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_aps_data_request_put(const esp_ncp_wire_aps_data_request_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_zcl_basic_cmd_put(&msg->basic_cmd, &buf[pos]);
+    buf[pos + 10] = msg->dst_addr_mode;
+    esp_ncp_wire_put16(&buf[pos + 11], msg->profile_id);
+    esp_ncp_wire_put16(&buf[pos + 13], msg->cluster_id);
+    buf[pos + 15] = msg->tx_options;
+    buf[pos + 16] = msg->use_alias;
+    memcpy(&buf[pos + 17], msg->alias_src_addr.bytes, sizeof(msg->alias_src_addr.bytes));
+    buf[pos + 25] = msg->alias_seq_num;
+    buf[pos + 26] = msg->radius;
+    esp_ncp_wire_put32(&buf[pos + 27], (uint32_t)msg->asdu_length);
+    pos += 31;
+    if (msg->asdu_length) {
+        memcpy(&buf[pos], msg->asdu, msg->asdu_length);
+    }
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the aps_data_request payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_aps_data_request_decode(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_request_t *msg)
+{
+    return buf && msg && esp_ncp_wire_aps_data_request_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the aps_data_request payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_aps_data_request_encode(const esp_ncp_wire_aps_data_request_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_aps_data_request_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_aps_data_request_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_write_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_write_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 21) {
+        return 0;
+    }
+    esp_ncp_wire_zcl_basic_cmd_get(&buf[pos], ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE, &msg->zcl_basic_cmd);
+    msg->address_mode = buf[pos + 10];
+    msg->profile_id = esp_ncp_wire_le16(&buf[pos + 11]);
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 13]);
+    msg->custom_cmd_id = esp_ncp_wire_le16(&buf[pos + 15]);
+    msg->direction = buf[pos + 17];
+    msg->type = buf[pos + 18];
+    msg->size = esp_ncp_wire_le16(&buf[pos + 19]);
+    pos += 21;
+    if (len - pos < msg->size) {
+        return 0;
+    }
+    msg->value = &buf[pos];
+    pos += msg->size;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_write payload */
+static inline size_t esp_ncp_wire_zcl_write_size(const esp_ncp_wire_zcl_write_t *msg)
+{
+    size_t size = 21;
+
+    size += msg->size;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_write_put(const esp_ncp_wire_zcl_write_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_zcl_basic_cmd_put(&msg->zcl_basic_cmd, &buf[pos]);
+    buf[pos + 10] = msg->address_mode;
+    esp_ncp_wire_put16(&buf[pos + 11], msg->profile_id);
+    esp_ncp_wire_put16(&buf[pos + 13], msg->cluster_id);
+    esp_ncp_wire_put16(&buf[pos + 15], msg->custom_cmd_id);
+    buf[pos + 17] = msg->direction;
+    buf[pos + 18] = msg->type;
+    esp_ncp_wire_put16(&buf[pos + 19], msg->size);
+    pos += 21;
+    if (msg->size) {
+        memcpy(&buf[pos], msg->value, msg->size);
+    }
+    pos += msg->size;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_write payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_write_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_write_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_write_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_write payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_write_encode(const esp_ncp_wire_zcl_write_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_write_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_write_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_read_bulk_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_read_bulk_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 11) {
+        return 0;
+    }
+    msg->src_endpoint = buf[pos];
+    msg->dst_endpoint = buf[pos + 1];
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 2]);
+    msg->concurrency = buf[pos + 4];
+    msg->retries = buf[pos + 5];
+    msg->timeout_ms = esp_ncp_wire_le16(&buf[pos + 6]);
+    msg->attr_number = buf[pos + 8];
+    msg->dev_number = esp_ncp_wire_le16(&buf[pos + 9]);
+    pos += 11;
+    if (len - pos < (size_t)msg->attr_number * 2) {
+        return 0;
+    }
+    msg->attr_field = &buf[pos];
+    pos += (size_t)msg->attr_number * 2;
+    if (len - pos < (size_t)msg->dev_number * 2) {
+        return 0;
+    }
+    msg->dev_field = &buf[pos];
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_attr_read_bulk payload */
+static inline size_t esp_ncp_wire_zcl_attr_read_bulk_size(const esp_ncp_wire_zcl_attr_read_bulk_t *msg)
+{
+    size_t size = 11;
+
+    size += (size_t)msg->attr_number * 2;
+    size += (size_t)msg->dev_number * 2;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_attr_read_bulk_put(const esp_ncp_wire_zcl_attr_read_bulk_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->src_endpoint;
+    buf[pos + 1] = msg->dst_endpoint;
+    esp_ncp_wire_put16(&buf[pos + 2], msg->cluster_id);
+    buf[pos + 4] = msg->concurrency;
+    buf[pos + 5] = msg->retries;
+    esp_ncp_wire_put16(&buf[pos + 6], msg->timeout_ms);
+    buf[pos + 8] = msg->attr_number;
+    esp_ncp_wire_put16(&buf[pos + 9], msg->dev_number);
+    pos += 11;
+    if (msg->attr_number) {
+        memcpy(&buf[pos], msg->attr_field, (size_t)msg->attr_number * 2);
+    }
+    pos += (size_t)msg->attr_number * 2;
+    if (msg->dev_number) {
+        memcpy(&buf[pos], msg->dev_field, (size_t)msg->dev_number * 2);
+    }
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_attr_read_bulk payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_attr_read_bulk_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_attr_read_bulk_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_attr_read_bulk_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_attr_read_bulk payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_attr_read_bulk_encode(const esp_ncp_wire_zcl_attr_read_bulk_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_attr_read_bulk_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_attr_read_bulk_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_timer_add_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_timer_add_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 14) {
+        return 0;
+    }
+    msg->absolute = buf[pos] != 0;
+    msg->deadline = esp_ncp_wire_le32(&buf[pos + 1]);
+    msg->utc_now = esp_ncp_wire_le32(&buf[pos + 5]);
+    msg->period_ms = esp_ncp_wire_le32(&buf[pos + 9]);
+    msg->action_len = buf[pos + 13];
+    pos += 14;
+    if (len - pos < msg->action_len) {
+        return 0;
+    }
+    msg->action = &buf[pos];
+    pos += msg->action_len;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_timer_add payload */
+static inline size_t esp_ncp_wire_zcl_timer_add_size(const esp_ncp_wire_zcl_timer_add_t *msg)
+{
+    size_t size = 14;
+
+    size += msg->action_len;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_timer_add_put(const esp_ncp_wire_zcl_timer_add_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->absolute;
+    esp_ncp_wire_put32(&buf[pos + 1], (uint32_t)msg->deadline);
+    esp_ncp_wire_put32(&buf[pos + 5], (uint32_t)msg->utc_now);
+    esp_ncp_wire_put32(&buf[pos + 9], (uint32_t)msg->period_ms);
+    buf[pos + 13] = msg->action_len;
+    pos += 14;
+    if (msg->action_len) {
+        memcpy(&buf[pos], msg->action, msg->action_len);
+    }
+    pos += msg->action_len;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_timer_add payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_timer_add_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_timer_add_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_timer_add_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_timer_add payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_timer_add_encode(const esp_ncp_wire_zcl_timer_add_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_timer_add_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_timer_add_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_status_id_get(const uint8_t *buf, size_t len, esp_ncp_wire_status_id_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 5) {
+        return 0;
+    }
+    msg->status = buf[pos];
+    msg->id = esp_ncp_wire_le32(&buf[pos + 1]);
+    pos += 5;
+
+    return pos;
+}
+
+/** The encoded size of the status_id payload */
+static inline size_t esp_ncp_wire_status_id_size(const esp_ncp_wire_status_id_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_STATUS_ID_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_status_id_put(const esp_ncp_wire_status_id_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->status;
+    esp_ncp_wire_put32(&buf[pos + 1], (uint32_t)msg->id);
+    pos += 5;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the status_id payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_status_id_decode(const uint8_t *buf, size_t len, esp_ncp_wire_status_id_t *msg)
+{
+    return buf && msg && esp_ncp_wire_status_id_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the status_id payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_status_id_encode(const esp_ncp_wire_status_id_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_status_id_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_status_id_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_network_signal_subscribe_get(const uint8_t *buf, size_t len, esp_ncp_wire_network_signal_subscribe_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 8) {
+        return 0;
+    }
+    msg->signal_mask = esp_ncp_wire_le64(&buf[pos]);
+    pos += 8;
+
+    return pos;
+}
+
+/** The encoded size of the network_signal_subscribe payload */
+static inline size_t esp_ncp_wire_network_signal_subscribe_size(const esp_ncp_wire_network_signal_subscribe_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_NETWORK_SIGNAL_SUBSCRIBE_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_network_signal_subscribe_put(const esp_ncp_wire_network_signal_subscribe_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put64(&buf[pos], msg->signal_mask);
+    pos += 8;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the network_signal_subscribe payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_network_signal_subscribe_decode(const uint8_t *buf, size_t len, esp_ncp_wire_network_signal_subscribe_t *msg)
+{
+    return buf && msg && esp_ncp_wire_network_signal_subscribe_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the network_signal_subscribe payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_network_signal_subscribe_encode(const esp_ncp_wire_network_signal_subscribe_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_network_signal_subscribe_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_network_signal_subscribe_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_network_join_batch_config_get(const uint8_t *buf, size_t len, esp_ncp_wire_network_join_batch_config_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 4) {
+        return 0;
+    }
+    msg->enable = buf[pos] != 0;
+    msg->max_records = buf[pos + 1];
+    msg->flush_ms = esp_ncp_wire_le16(&buf[pos + 2]);
+    pos += 4;
+
+    return pos;
+}
+
+/** The encoded size of the network_join_batch_config payload */
+static inline size_t esp_ncp_wire_network_join_batch_config_size(const esp_ncp_wire_network_join_batch_config_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_NETWORK_JOIN_BATCH_CONFIG_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_network_join_batch_config_put(const esp_ncp_wire_network_join_batch_config_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->enable;
+    buf[pos + 1] = msg->max_records;
+    esp_ncp_wire_put16(&buf[pos + 2], msg->flush_ms);
+    pos += 4;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the network_join_batch_config payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_network_join_batch_config_decode(const uint8_t *buf, size_t len, esp_ncp_wire_network_join_batch_config_t *msg)
+{
+    return buf && msg && esp_ncp_wire_network_join_batch_config_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the network_join_batch_config payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_network_join_batch_config_encode(const esp_ncp_wire_network_join_batch_config_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_network_join_batch_config_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_network_join_batch_config_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_ic_remove_record_get(const uint8_t *buf, size_t len, esp_ncp_wire_ic_remove_record_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 8) {
+        return 0;
+    }
+    memcpy(msg->ieee_addr.bytes, &buf[pos], sizeof(msg->ieee_addr.bytes));
+    pos += 8;
+
+    return pos;
+}
+
+/** The encoded size of the ic_remove_record payload */
+static inline size_t esp_ncp_wire_ic_remove_record_size(const esp_ncp_wire_ic_remove_record_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_IC_REMOVE_RECORD_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_ic_remove_record_put(const esp_ncp_wire_ic_remove_record_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    memcpy(&buf[pos], msg->ieee_addr.bytes, sizeof(msg->ieee_addr.bytes));
+    pos += 8;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the ic_remove_record payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_ic_remove_record_decode(const uint8_t *buf, size_t len, esp_ncp_wire_ic_remove_record_t *msg)
+{
+    return buf && msg && esp_ncp_wire_ic_remove_record_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the ic_remove_record payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_ic_remove_record_encode(const esp_ncp_wire_ic_remove_record_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_ic_remove_record_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_ic_remove_record_put(msg, buf);
+}
+
+/**
+ * @brief  Decode the ic_remove_record record at the offset of a list and move the offset past it.
+ *
+ * @return false at the end of the list or on a truncated record
+ */
+static inline bool esp_ncp_wire_ic_remove_record_next(const uint8_t *buf, size_t len, size_t *offset, esp_ncp_wire_ic_remove_record_t *msg)
+{
+    size_t used = (*offset < len) ? esp_ncp_wire_ic_remove_record_get(&buf[*offset], len - *offset, msg) : 0;
+
+    *offset += used;
+
+    return used != 0;
+}
+
+static inline size_t esp_ncp_wire_network_ic_remove_bulk_get(const uint8_t *buf, size_t len, esp_ncp_wire_network_ic_remove_bulk_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 2) {
+        return 0;
+    }
+    msg->count = esp_ncp_wire_le16(&buf[pos]);
+    pos += 2;
+    msg->records = &buf[pos];
+    for (size_t i = 0; i < msg->count; i ++) {
+        esp_ncp_wire_ic_remove_record_t record;
+        size_t used = esp_ncp_wire_ic_remove_record_get(&buf[pos], len - pos, &record);
+
+        if (!used) {
+            return 0;
+        }
+        pos += used;
+    }
+    msg->records_len = (size_t)(&buf[pos] - msg->records);
+
+    return pos;
+}
+
+/** The encoded size of the network_ic_remove_bulk payload */
+static inline size_t esp_ncp_wire_network_ic_remove_bulk_size(const esp_ncp_wire_network_ic_remove_bulk_t *msg)
+{
+    size_t size = 2;
+
+    size += msg->records_len;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_network_ic_remove_bulk_put(const esp_ncp_wire_network_ic_remove_bulk_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put16(&buf[pos], msg->count);
+    pos += 2;
+    if (msg->records_len) {
+        memcpy(&buf[pos], msg->records, msg->records_len);
+    }
+    pos += msg->records_len;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the network_ic_remove_bulk payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_network_ic_remove_bulk_decode(const uint8_t *buf, size_t len, esp_ncp_wire_network_ic_remove_bulk_t *msg)
+{
+    return buf && msg && esp_ncp_wire_network_ic_remove_bulk_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the network_ic_remove_bulk payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_network_ic_remove_bulk_encode(const esp_ncp_wire_network_ic_remove_bulk_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_network_ic_remove_bulk_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_network_ic_remove_bulk_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_report_record_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_report_record_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 15) {
+        return 0;
+    }
+    msg->attr_id = esp_ncp_wire_le16(&buf[pos]);
+    msg->attr_type = buf[pos + 2];
+    msg->min_interval = esp_ncp_wire_le16(&buf[pos + 3]);
+    msg->max_interval = esp_ncp_wire_le16(&buf[pos + 5]);
+    msg->reportable_change = esp_ncp_wire_le64(&buf[pos + 7]);
+    pos += 15;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_report_record payload */
+static inline size_t esp_ncp_wire_zcl_report_record_size(const esp_ncp_wire_zcl_report_record_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_REPORT_RECORD_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_report_record_put(const esp_ncp_wire_zcl_report_record_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put16(&buf[pos], msg->attr_id);
+    buf[pos + 2] = msg->attr_type;
+    esp_ncp_wire_put16(&buf[pos + 3], msg->min_interval);
+    esp_ncp_wire_put16(&buf[pos + 5], msg->max_interval);
+    esp_ncp_wire_put64(&buf[pos + 7], msg->reportable_change);
+    pos += 15;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_report_record payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_report_record_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_report_record_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_report_record_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_report_record payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_report_record_encode(const esp_ncp_wire_zcl_report_record_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_report_record_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_report_record_put(msg, buf);
+}
+
+/**
+ * @brief  Decode the zcl_report_record record at the offset of a list and move the offset past it.
+ *
+ * @return false at the end of the list or on a truncated record
+ */
+static inline bool esp_ncp_wire_zcl_report_record_next(const uint8_t *buf, size_t len, size_t *offset, esp_ncp_wire_zcl_report_record_t *msg)
+{
+    size_t used = (*offset < len) ? esp_ncp_wire_zcl_report_record_get(&buf[*offset], len - *offset, msg) : 0;
+
+    *offset += used;
+
+    return used != 0;
+}
+
+static inline size_t esp_ncp_wire_zcl_report_config_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_report_config_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 20) {
+        return 0;
+    }
+    esp_ncp_wire_zcl_basic_cmd_get(&buf[pos], ESP_NCP_WIRE_ZCL_BASIC_CMD_FIXED_SIZE, &msg->zcl_basic_cmd);
+    msg->address_mode = buf[pos + 10];
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 11]);
+    msg->concurrency = buf[pos + 13];
+    msg->retries = buf[pos + 14];
+    msg->timeout_ms = esp_ncp_wire_le16(&buf[pos + 15]);
+    msg->record_number = buf[pos + 17];
+    msg->dev_number = esp_ncp_wire_le16(&buf[pos + 18]);
+    pos += 20;
+    msg->record_field = &buf[pos];
+    for (size_t i = 0; i < msg->record_number; i ++) {
+        esp_ncp_wire_zcl_report_record_t record;
+        size_t used = esp_ncp_wire_zcl_report_record_get(&buf[pos], len - pos, &record);
+
+        if (!used) {
+            return 0;
+        }
+        pos += used;
+    }
+    msg->record_field_len = (size_t)(&buf[pos] - msg->record_field);
+    if (len - pos < (size_t)msg->dev_number * 2) {
+        return 0;
+    }
+    msg->dev_field = &buf[pos];
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_report_config payload */
+static inline size_t esp_ncp_wire_zcl_report_config_size(const esp_ncp_wire_zcl_report_config_t *msg)
+{
+    size_t size = 20;
+
+    size += msg->record_field_len;
+    size += (size_t)msg->dev_number * 2;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_report_config_put(const esp_ncp_wire_zcl_report_config_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_zcl_basic_cmd_put(&msg->zcl_basic_cmd, &buf[pos]);
+    buf[pos + 10] = msg->address_mode;
+    esp_ncp_wire_put16(&buf[pos + 11], msg->cluster_id);
+    buf[pos + 13] = msg->concurrency;
+    buf[pos + 14] = msg->retries;
+    esp_ncp_wire_put16(&buf[pos + 15], msg->timeout_ms);
+    buf[pos + 17] = msg->record_number;
+    esp_ncp_wire_put16(&buf[pos + 18], msg->dev_number);
+    pos += 20;
+    if (msg->record_field_len) {
+        memcpy(&buf[pos], msg->record_field, msg->record_field_len);
+    }
+    pos += msg->record_field_len;
+    if (msg->dev_number) {
+        memcpy(&buf[pos], msg->dev_field, (size_t)msg->dev_number * 2);
+    }
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_report_config payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_report_config_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_report_config_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_report_config_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_report_config payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_report_config_encode(const esp_ncp_wire_zcl_report_config_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_report_config_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_report_config_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_sched_config_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_sched_config_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 9) {
+        return 0;
+    }
+    msg->enable = buf[pos] != 0;
+    msg->rate = esp_ncp_wire_le16(&buf[pos + 1]);
+    msg->burst = esp_ncp_wire_le16(&buf[pos + 3]);
+    msg->dst_gap_ms = esp_ncp_wire_le16(&buf[pos + 5]);
+    msg->hop_gap_ms = esp_ncp_wire_le16(&buf[pos + 7]);
+    pos += 9;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_sched_config payload */
+static inline size_t esp_ncp_wire_zcl_sched_config_size(const esp_ncp_wire_zcl_sched_config_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_SCHED_CONFIG_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_sched_config_put(const esp_ncp_wire_zcl_sched_config_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->enable;
+    esp_ncp_wire_put16(&buf[pos + 1], msg->rate);
+    esp_ncp_wire_put16(&buf[pos + 3], msg->burst);
+    esp_ncp_wire_put16(&buf[pos + 5], msg->dst_gap_ms);
+    esp_ncp_wire_put16(&buf[pos + 7], msg->hop_gap_ms);
+    pos += 9;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_sched_config payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_sched_config_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_sched_config_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_sched_config_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_sched_config payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_sched_config_encode(const esp_ncp_wire_zcl_sched_config_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_sched_config_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_sched_config_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_write_multi_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_write_multi_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 14) {
+        return 0;
+    }
+    msg->src_endpoint = buf[pos];
+    msg->dst_endpoint = buf[pos + 1];
+    msg->profile_id = esp_ncp_wire_le16(&buf[pos + 2]);
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 4]);
+    msg->custom_cmd_id = esp_ncp_wire_le16(&buf[pos + 6]);
+    msg->direction = buf[pos + 8];
+    msg->type = buf[pos + 9];
+    msg->size = esp_ncp_wire_le16(&buf[pos + 10]);
+    msg->dev_number = esp_ncp_wire_le16(&buf[pos + 12]);
+    pos += 14;
+    if (len - pos < msg->size) {
+        return 0;
+    }
+    msg->value = &buf[pos];
+    pos += msg->size;
+    if (len - pos < (size_t)msg->dev_number * 2) {
+        return 0;
+    }
+    msg->dev_field = &buf[pos];
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_write_multi payload */
+static inline size_t esp_ncp_wire_zcl_write_multi_size(const esp_ncp_wire_zcl_write_multi_t *msg)
+{
+    size_t size = 14;
+
+    size += msg->size;
+    size += (size_t)msg->dev_number * 2;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_write_multi_put(const esp_ncp_wire_zcl_write_multi_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->src_endpoint;
+    buf[pos + 1] = msg->dst_endpoint;
+    esp_ncp_wire_put16(&buf[pos + 2], msg->profile_id);
+    esp_ncp_wire_put16(&buf[pos + 4], msg->cluster_id);
+    esp_ncp_wire_put16(&buf[pos + 6], msg->custom_cmd_id);
+    buf[pos + 8] = msg->direction;
+    buf[pos + 9] = msg->type;
+    esp_ncp_wire_put16(&buf[pos + 10], msg->size);
+    esp_ncp_wire_put16(&buf[pos + 12], msg->dev_number);
+    pos += 14;
+    if (msg->size) {
+        memcpy(&buf[pos], msg->value, msg->size);
+    }
+    pos += msg->size;
+    if (msg->dev_number) {
+        memcpy(&buf[pos], msg->dev_field, (size_t)msg->dev_number * 2);
+    }
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_write_multi payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_write_multi_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_write_multi_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_write_multi_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_write_multi payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_write_multi_encode(const esp_ncp_wire_zcl_write_multi_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_write_multi_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_write_multi_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_add_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_add_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 12) {
+        return 0;
+    }
+    msg->rule_id = buf[pos];
+    msg->flags = buf[pos + 1];
+    msg->trigger = buf[pos + 2];
+    msg->src_addr = esp_ncp_wire_le16(&buf[pos + 3]);
+    msg->src_endpoint = buf[pos + 5];
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 6]);
+    msg->attr_id = esp_ncp_wire_le16(&buf[pos + 8]);
+    msg->code_len = buf[pos + 10];
+    msg->action_len = buf[pos + 11];
+    pos += 12;
+    if (len - pos < msg->code_len) {
+        return 0;
+    }
+    msg->code = &buf[pos];
+    pos += msg->code_len;
+    if (len - pos < msg->action_len) {
+        return 0;
+    }
+    msg->action = &buf[pos];
+    pos += msg->action_len;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_rule_add payload */
+static inline size_t esp_ncp_wire_zcl_rule_add_size(const esp_ncp_wire_zcl_rule_add_t *msg)
+{
+    size_t size = 12;
+
+    size += msg->code_len;
+    size += msg->action_len;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_add_put(const esp_ncp_wire_zcl_rule_add_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->rule_id;
+    buf[pos + 1] = msg->flags;
+    buf[pos + 2] = msg->trigger;
+    esp_ncp_wire_put16(&buf[pos + 3], msg->src_addr);
+    buf[pos + 5] = msg->src_endpoint;
+    esp_ncp_wire_put16(&buf[pos + 6], msg->cluster_id);
+    esp_ncp_wire_put16(&buf[pos + 8], msg->attr_id);
+    buf[pos + 10] = msg->code_len;
+    buf[pos + 11] = msg->action_len;
+    pos += 12;
+    if (msg->code_len) {
+        memcpy(&buf[pos], msg->code, msg->code_len);
+    }
+    pos += msg->code_len;
+    if (msg->action_len) {
+        memcpy(&buf[pos], msg->action, msg->action_len);
+    }
+    pos += msg->action_len;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_rule_add payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_rule_add_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_add_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_rule_add_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_rule_add payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_rule_add_encode(const esp_ncp_wire_zcl_rule_add_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_rule_add_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_rule_add_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_del_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_del_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 1) {
+        return 0;
+    }
+    msg->rule_id = buf[pos];
+    pos += 1;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_rule_del payload */
+static inline size_t esp_ncp_wire_zcl_rule_del_size(const esp_ncp_wire_zcl_rule_del_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_RULE_DEL_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_del_put(const esp_ncp_wire_zcl_rule_del_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->rule_id;
+    pos += 1;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_rule_del payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_rule_del_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_del_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_rule_del_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_rule_del payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_rule_del_encode(const esp_ncp_wire_zcl_rule_del_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_rule_del_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_rule_del_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_stats_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_stats_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 2) {
+        return 0;
+    }
+    msg->rule_id = buf[pos];
+    msg->reset = buf[pos + 1] != 0;
+    pos += 2;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_rule_stats payload */
+static inline size_t esp_ncp_wire_zcl_rule_stats_size(const esp_ncp_wire_zcl_rule_stats_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_RULE_STATS_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_rule_stats_put(const esp_ncp_wire_zcl_rule_stats_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->rule_id;
+    buf[pos + 1] = msg->reset;
+    pos += 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_rule_stats payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_rule_stats_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_rule_stats_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_rule_stats_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_rule_stats payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_rule_stats_encode(const esp_ncp_wire_zcl_rule_stats_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_rule_stats_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_rule_stats_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zcl_timer_cancel_get(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_timer_cancel_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 4) {
+        return 0;
+    }
+    msg->id = esp_ncp_wire_le32(&buf[pos]);
+    pos += 4;
+
+    return pos;
+}
+
+/** The encoded size of the zcl_timer_cancel payload */
+static inline size_t esp_ncp_wire_zcl_timer_cancel_size(const esp_ncp_wire_zcl_timer_cancel_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZCL_TIMER_CANCEL_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zcl_timer_cancel_put(const esp_ncp_wire_zcl_timer_cancel_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put32(&buf[pos], (uint32_t)msg->id);
+    pos += 4;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zcl_timer_cancel payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zcl_timer_cancel_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zcl_timer_cancel_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zcl_timer_cancel_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zcl_timer_cancel payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zcl_timer_cancel_encode(const esp_ncp_wire_zcl_timer_cancel_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zcl_timer_cancel_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zcl_timer_cancel_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zdo_interrogate_config_get(const uint8_t *buf, size_t len, esp_ncp_wire_zdo_interrogate_config_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 3) {
+        return 0;
+    }
+    msg->auto_enable = buf[pos] != 0;
+    msg->concurrency = buf[pos + 1];
+    msg->retries = buf[pos + 2];
+    pos += 3;
+
+    return pos;
+}
+
+/** The encoded size of the zdo_interrogate_config payload */
+static inline size_t esp_ncp_wire_zdo_interrogate_config_size(const esp_ncp_wire_zdo_interrogate_config_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_ZDO_INTERROGATE_CONFIG_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_zdo_interrogate_config_put(const esp_ncp_wire_zdo_interrogate_config_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->auto_enable;
+    buf[pos + 1] = msg->concurrency;
+    buf[pos + 2] = msg->retries;
+    pos += 3;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zdo_interrogate_config payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zdo_interrogate_config_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zdo_interrogate_config_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zdo_interrogate_config_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zdo_interrogate_config payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zdo_interrogate_config_encode(const esp_ncp_wire_zdo_interrogate_config_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zdo_interrogate_config_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zdo_interrogate_config_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_zdo_interrogate_get(const uint8_t *buf, size_t len, esp_ncp_wire_zdo_interrogate_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 2) {
+        return 0;
+    }
+    msg->dev_number = esp_ncp_wire_le16(&buf[pos]);
+    pos += 2;
+    if (len - pos < (size_t)msg->dev_number * 2) {
+        return 0;
+    }
+    msg->dev_field = &buf[pos];
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/** The encoded size of the zdo_interrogate payload */
+static inline size_t esp_ncp_wire_zdo_interrogate_size(const esp_ncp_wire_zdo_interrogate_t *msg)
+{
+    size_t size = 2;
+
+    size += (size_t)msg->dev_number * 2;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_zdo_interrogate_put(const esp_ncp_wire_zdo_interrogate_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    esp_ncp_wire_put16(&buf[pos], msg->dev_number);
+    pos += 2;
+    if (msg->dev_number) {
+        memcpy(&buf[pos], msg->dev_field, (size_t)msg->dev_number * 2);
+    }
+    pos += (size_t)msg->dev_number * 2;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the zdo_interrogate payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_zdo_interrogate_decode(const uint8_t *buf, size_t len, esp_ncp_wire_zdo_interrogate_t *msg)
+{
+    return buf && msg && esp_ncp_wire_zdo_interrogate_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the zdo_interrogate payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_zdo_interrogate_encode(const esp_ncp_wire_zdo_interrogate_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_zdo_interrogate_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_zdo_interrogate_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_aps_bulk_dst_get(const uint8_t *buf, size_t len, esp_ncp_wire_aps_bulk_dst_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 11) {
+        return 0;
+    }
+    msg->dst_addr_mode = buf[pos];
+    memcpy(msg->dst_addr.bytes, &buf[pos + 1], sizeof(msg->dst_addr.bytes));
+    msg->dst_endpoint = buf[pos + 9];
+    msg->tx_options = buf[pos + 10];
+    pos += 11;
+
+    return pos;
+}
+
+/** The encoded size of the aps_bulk_dst payload */
+static inline size_t esp_ncp_wire_aps_bulk_dst_size(const esp_ncp_wire_aps_bulk_dst_t *msg)
+{
+    (void)msg;
+
+    return ESP_NCP_WIRE_APS_BULK_DST_FIXED_SIZE;
+}
+
+static inline size_t esp_ncp_wire_aps_bulk_dst_put(const esp_ncp_wire_aps_bulk_dst_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->dst_addr_mode;
+    memcpy(&buf[pos + 1], msg->dst_addr.bytes, sizeof(msg->dst_addr.bytes));
+    buf[pos + 9] = msg->dst_endpoint;
+    buf[pos + 10] = msg->tx_options;
+    pos += 11;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the aps_bulk_dst payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_aps_bulk_dst_decode(const uint8_t *buf, size_t len, esp_ncp_wire_aps_bulk_dst_t *msg)
+{
+    return buf && msg && esp_ncp_wire_aps_bulk_dst_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the aps_bulk_dst payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_aps_bulk_dst_encode(const esp_ncp_wire_aps_bulk_dst_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_aps_bulk_dst_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_aps_bulk_dst_put(msg, buf);
+}
+
+/**
+ * @brief  Decode the aps_bulk_dst record at the offset of a list and move the offset past it.
+ *
+ * @return false at the end of the list or on a truncated record
+ */
+static inline bool esp_ncp_wire_aps_bulk_dst_next(const uint8_t *buf, size_t len, size_t *offset, esp_ncp_wire_aps_bulk_dst_t *msg)
+{
+    size_t used = (*offset < len) ? esp_ncp_wire_aps_bulk_dst_get(&buf[*offset], len - *offset, msg) : 0;
+
+    *offset += used;
+
+    return used != 0;
+}
+
+static inline size_t esp_ncp_wire_aps_data_request_bulk_get(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_request_bulk_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 13) {
+        return 0;
+    }
+    msg->src_endpoint = buf[pos];
+    msg->profile_id = esp_ncp_wire_le16(&buf[pos + 1]);
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 3]);
+    msg->radius = buf[pos + 5];
+    msg->pacing_ms = esp_ncp_wire_le16(&buf[pos + 6]);
+    msg->dst_count = buf[pos + 8];
+    msg->asdu_length = esp_ncp_wire_le32(&buf[pos + 9]);
+    pos += 13;
+    msg->dst = &buf[pos];
+    for (size_t i = 0; i < msg->dst_count; i ++) {
+        esp_ncp_wire_aps_bulk_dst_t record;
+        size_t used = esp_ncp_wire_aps_bulk_dst_get(&buf[pos], len - pos, &record);
+
+        if (!used) {
+            return 0;
+        }
+        pos += used;
+    }
+    msg->dst_len = (size_t)(&buf[pos] - msg->dst);
+    if (len - pos < msg->asdu_length) {
+        return 0;
+    }
+    msg->asdu = &buf[pos];
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/** The encoded size of the aps_data_request_bulk payload */
+static inline size_t esp_ncp_wire_aps_data_request_bulk_size(const esp_ncp_wire_aps_data_request_bulk_t *msg)
+{
+    size_t size = 13;
+
+    size += msg->dst_len;
+    size += msg->asdu_length;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_aps_data_request_bulk_put(const esp_ncp_wire_aps_data_request_bulk_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->src_endpoint;
+    esp_ncp_wire_put16(&buf[pos + 1], msg->profile_id);
+    esp_ncp_wire_put16(&buf[pos + 3], msg->cluster_id);
+    buf[pos + 5] = msg->radius;
+    esp_ncp_wire_put16(&buf[pos + 6], msg->pacing_ms);
+    buf[pos + 8] = msg->dst_count;
+    esp_ncp_wire_put32(&buf[pos + 9], (uint32_t)msg->asdu_length);
+    pos += 13;
+    if (msg->dst_len) {
+        memcpy(&buf[pos], msg->dst, msg->dst_len);
+    }
+    pos += msg->dst_len;
+    if (msg->asdu_length) {
+        memcpy(&buf[pos], msg->asdu, msg->asdu_length);
+    }
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the aps_data_request_bulk payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_aps_data_request_bulk_decode(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_request_bulk_t *msg)
+{
+    return buf && msg && esp_ncp_wire_aps_data_request_bulk_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the aps_data_request_bulk payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_aps_data_request_bulk_encode(const esp_ncp_wire_aps_data_request_bulk_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_aps_data_request_bulk_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_aps_data_request_bulk_put(msg, buf);
+}
+
+static inline size_t esp_ncp_wire_aps_data_indication_get(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_indication_t *msg)
+{
+    size_t pos = 0;
+
+    if (len - pos < 36) {
+        return 0;
+    }
+    msg->states = buf[pos];
+    msg->dst_addr_mode = buf[pos + 1];
+    memcpy(msg->dst_addr.bytes, &buf[pos + 2], sizeof(msg->dst_addr.bytes));
+    msg->dst_endpoint = buf[pos + 10];
+    msg->src_addr_mode = buf[pos + 11];
+    memcpy(msg->src_addr.bytes, &buf[pos + 12], sizeof(msg->src_addr.bytes));
+    msg->src_endpoint = buf[pos + 20];
+    msg->profile_id = esp_ncp_wire_le16(&buf[pos + 21]);
+    msg->cluster_id = esp_ncp_wire_le16(&buf[pos + 23]);
+    msg->indication_status = buf[pos + 25];
+    msg->security_status = buf[pos + 26];
+    msg->lqi = buf[pos + 27];
+    msg->rx_time = (int32_t)esp_ncp_wire_le32(&buf[pos + 28]);
+    msg->asdu_length = esp_ncp_wire_le32(&buf[pos + 32]);
+    pos += 36;
+    if (len - pos < msg->asdu_length) {
+        return 0;
+    }
+    msg->asdu = &buf[pos];
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/** The encoded size of the aps_data_indication payload */
+static inline size_t esp_ncp_wire_aps_data_indication_size(const esp_ncp_wire_aps_data_indication_t *msg)
+{
+    size_t size = 36;
+
+    size += msg->asdu_length;
+
+    return size;
+}
+
+static inline size_t esp_ncp_wire_aps_data_indication_put(const esp_ncp_wire_aps_data_indication_t *msg, uint8_t *buf)
+{
+    size_t pos = 0;
+
+    buf[pos] = msg->states;
+    buf[pos + 1] = msg->dst_addr_mode;
+    memcpy(&buf[pos + 2], msg->dst_addr.bytes, sizeof(msg->dst_addr.bytes));
+    buf[pos + 10] = msg->dst_endpoint;
+    buf[pos + 11] = msg->src_addr_mode;
+    memcpy(&buf[pos + 12], msg->src_addr.bytes, sizeof(msg->src_addr.bytes));
+    buf[pos + 20] = msg->src_endpoint;
+    esp_ncp_wire_put16(&buf[pos + 21], msg->profile_id);
+    esp_ncp_wire_put16(&buf[pos + 23], msg->cluster_id);
+    buf[pos + 25] = msg->indication_status;
+    buf[pos + 26] = msg->security_status;
+    buf[pos + 27] = msg->lqi;
+    esp_ncp_wire_put32(&buf[pos + 28], (uint32_t)msg->rx_time);
+    esp_ncp_wire_put32(&buf[pos + 32], (uint32_t)msg->asdu_length);
+    pos += 36;
+    if (msg->asdu_length) {
+        memcpy(&buf[pos], msg->asdu, msg->asdu_length);
+    }
+    pos += msg->asdu_length;
+
+    return pos;
+}
+
+/**
+ * @brief  Decode the aps_data_indication payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool esp_ncp_wire_aps_data_indication_decode(const uint8_t *buf, size_t len, esp_ncp_wire_aps_data_indication_t *msg)
+{
+    return buf && msg && esp_ncp_wire_aps_data_indication_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the aps_data_indication payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t esp_ncp_wire_aps_data_indication_encode(const esp_ncp_wire_aps_data_indication_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < esp_ncp_wire_aps_data_indication_size(msg)) {
+        return 0;
+    }
+
+    return esp_ncp_wire_aps_data_indication_put(msg, buf);
+}
+
+#ifdef __cplusplus
+}
+#endif
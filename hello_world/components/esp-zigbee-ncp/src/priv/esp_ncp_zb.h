@@ -10,10 +10,45 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_zigbee_core.h"
 
 #define ESP_NCP_ZB_PACKED_STRUCT __attribute__ ((packed))
 
+/** Definition of the Zigbee information on the NCP
+ *
+ */
+#define ESP_NCP_ZB_APS_BULK_MAX_DST             64      /*!< The maximum number of destinations in one bulk APS data request */
+#define ESP_NCP_ZB_APS_BULK_PACING_MS           20      /*!< The default delay between two destinations of a bulk APS data request */
+#define ESP_NCP_ZB_APS_BULK_TIMEOUT_MS          10000   /*!< The time to wait for the outstanding confirms after the last destination is sent */
+#define ESP_NCP_ZB_APS_BULK_NO_CONFIRM          0xFF    /*!< The bulk destination status when no confirm arrived before the timeout */
+#define ESP_NCP_ZB_APS_BULK_REJECTED            0xFE    /*!< The bulk destination status when the stack rejected the request */
+#define ESP_NCP_ZB_APS_SENT_MAX                 16      /*!< The number of outstanding single APS data requests of the host, the rules and the timers told apart from the bulk ones */
+#define ESP_NCP_ZB_ZCL_INFLIGHT_MAX             16      /*!< The number of outstanding unicast ZCL requests whose TSN is mapped back to the host sn */
+#define ESP_NCP_ZB_ZCL_INFLIGHT_TIMEOUT_MS      10000   /*!< The time after which an unanswered ZCL request is no longer mapped back to the host sn */
+#define ESP_NCP_ZB_ZCL_BULK_MAX_DEV             128     /*!< The maximum number of devices in one bulk ZCL request */
+#define ESP_NCP_ZB_ZCL_BULK_MAX_ATTR            16      /*!< The maximum number of attributes in one bulk ZCL request */
+#define ESP_NCP_ZB_ZCL_BULK_CONCURRENCY         4       /*!< The default number of devices requested at the same time */
+#define ESP_NCP_ZB_ZCL_BULK_TIMEOUT_MS          3000    /*!< The default time to wait for the response of one device */
+#define ESP_NCP_ZB_ZCL_BULK_TICK_MS             100     /*!< The interval to check the bulk ZCL request timeouts */
+#define ESP_NCP_ZB_ZCL_BULK_CHUNK_SIZE          512     /*!< The payload size which triggers a partial bulk ZCL notification */
+#define ESP_NCP_ZB_ZCL_REPORT_CHANGE_SIZE       8       /*!< The size of the reportable change field in a reporting record */
+#define ESP_NCP_ZB_NWK_TABLE_CHUNK_SIZE         512     /*!< The maximum payload size of one network table notification */
+#define ESP_NCP_ZB_TIMER_LIST_MAX               32      /*!< The maximum number of pending timers in one list response */
+
+/**
+ * @brief Network tables exported to the host.
+ *
+ */
+typedef enum {
+    ESP_NCP_ZB_NWK_TABLE_NEIGHBOR,              /*!< The neighbor table */
+    ESP_NCP_ZB_NWK_TABLE_ROUTE,                 /*!< The routing table */
+    ESP_NCP_ZB_NWK_TABLE_ROUTE_RECORD,          /*!< The route record table */
+    ESP_NCP_ZB_NWK_TABLE_MAX,                   /*!< The number of network tables */
+} esp_ncp_zb_nwk_table_type_t;
+
 /**
  * @brief A function for process Zigbee stack.
  *
@@ -108,6 +143,16 @@ typedef struct {
 #define ESP_NCP_NETWORK_PREDEFINED_PANID        0x002B  /*!< Enable or disable predefined network panid */
 #define ESP_NCP_NETWORK_SHORT_TO_IEEE           0x002C  /*!< Get the network IEEE address by the short address */
 #define ESP_NCP_NETWORK_IEEE_TO_SHORT           0x002D  /*!< Get the network short address by the IEEE address */
+#define ESP_NCP_NETWORK_SCAN_RESULT             0x002E  /*!< The networks found on one channel of a streamed scan */
+#define ESP_NCP_NETWORK_NEIGHBOR_TABLE_GET      0x002F  /*!< Export the network neighbor table */
+#define ESP_NCP_NETWORK_ROUTE_TABLE_GET         0x0030  /*!< Export the network routing table */
+#define ESP_NCP_NETWORK_ROUTE_RECORD_TABLE_GET  0x0031  /*!< Export the network route record table */
+#define ESP_NCP_NETWORK_SIGNAL_SUBSCRIBE        0x0032  /*!< Set the bitmap of the stack signals forwarded to the host */
+#define ESP_NCP_NETWORK_SIGNAL                  0x0033  /*!< Notify the host of a subscribed stack signal with its raw parameters */
+#define ESP_NCP_NETWORK_JOIN_BATCH              0x0034  /*!< Notify the host of a deduplicated batch of device announce and leave events */
+#define ESP_NCP_NETWORK_JOIN_BATCH_CONFIG       0x0035  /*!< Configure the batching of the device announce and leave events */
+#define ESP_NCP_NETWORK_IC_ADD_BULK             0x0036  /*!< Add the install codes of a list of devices */
+#define ESP_NCP_NETWORK_IC_REMOVE_BULK          0x0037  /*!< Remove the install codes of a list of devices */
 #define ESP_NCP_ZCL_ENDPOINT_ADD                0x0100  /*!< Configures endpoint information on the NCP */
 #define ESP_NCP_ZCL_ENDPOINT_DEL                0x0101  /*!< Remove endpoint information on the NCP */
 #define ESP_NCP_ZCL_ATTR_READ                   0x0102  /*!< Read attribute data on NCP endpoints */
@@ -117,12 +162,29 @@ typedef struct {
 #define ESP_NCP_ZCL_READ                        0x0106  /*!< Read APS on NCP endpoints */
 #define ESP_NCP_ZCL_WRITE                       0x0107  /*!< Write APS on NCP endpoints */
 #define ESP_NCP_ZCL_REPORT_CONFIG               0x0108  /*!< Report configure on NCP endpoints */
+#define ESP_NCP_ZCL_ATTR_READ_BULK              0x0109  /*!< Read the same attributes from a list of devices */
+#define ESP_NCP_ZCL_SCHED_CONFIG                0x010A  /*!< Configure the air-time scheduler of the ZCL requests */
+#define ESP_NCP_ZCL_SCHED_STATS                 0x010B  /*!< Get the queue depth and drop statistics of the air-time scheduler */
+#define ESP_NCP_ZCL_WRITE_MULTI                 0x010C  /*!< Send the same cluster command to a list of devices, consolidated into a groupcast */
+#define ESP_NCP_ZCL_GROUPCAST_STATS             0x010D  /*!< Get the air-time saved by the groupcast consolidation */
+#define ESP_NCP_ZCL_RULE_ADD                    0x010E  /*!< Install or replace a local automation rule */
+#define ESP_NCP_ZCL_RULE_DEL                    0x010F  /*!< Remove a local automation rule */
+#define ESP_NCP_ZCL_RULE_STATS                  0x0110  /*!< Get the execution counters and latency histogram of a rule */
+#define ESP_NCP_ZCL_RULE_FIRED                  0x0111  /*!< Notify the host a rule ran its action */
+#define ESP_NCP_ZCL_TIMER_ADD                   0x0112  /*!< Queue a command until a relative or absolute deadline */
+#define ESP_NCP_ZCL_TIMER_CANCEL                0x0113  /*!< Cancel a queued command */
+#define ESP_NCP_ZCL_TIMER_LIST                  0x0114  /*!< List the queued commands */
+#define ESP_NCP_ZCL_TIMER_STATS                 0x0115  /*!< Get the firing jitter statistics of the queued commands */
 #define ESP_NCP_ZDO_BIND_SET                    0x0200  /*!< Create a binding between two endpoints on two nodes */
 #define ESP_NCP_ZDO_UNBIND_SET                  0x0201  /*!< Remove a binding between two endpoints on two nodes */
 #define ESP_NCP_ZDO_FIND_MATCH                  0x0202  /*!< Send match desc request to find matched Zigbee device */
+#define ESP_NCP_ZDO_INTERROGATE_CONFIG          0x0203  /*!< Configure the device interrogation on the NCP */
+#define ESP_NCP_ZDO_INTERROGATE                 0x0204  /*!< Interrogate the node, active endpoint and simple descriptors of a list of devices */
+#define ESP_NCP_ZDO_DEVICE_PROFILE              0x0205  /*!< The consolidated descriptors of one interrogated device */
 #define ESP_NCP_APS_DATA_REQUEST                0x0300  /*!< Request the aps data */
 #define ESP_NCP_APS_DATA_INDICATION             0x0301  /*!< Indication the aps data */
 #define ESP_NCP_APS_DATA_CONFIRM                0x0302  /*!< Confirm the aps data */
+#define ESP_NCP_APS_DATA_REQUEST_BULK           0x0303  /*!< Request the same aps data to a list of destinations and confirm them in one frame */
 
 /**
  * @brief   Process the frame ID on the NCP and response it to the host.
@@ -138,6 +200,36 @@ typedef struct {
  */
 esp_err_t esp_ncp_zb_output(esp_ncp_header_t *ncp_header, const void *buffer, uint16_t len);
 
+/**
+ * @brief   Hand a single APS data request to the stack and record it, so that its confirm is told apart from the bulk ones.
+ *
+ * @note The function must be called from the Zigbee task or with the Zigbee lock held.
+ *
+ * @param[in] req  The APSDE-DATA.request
+ * @param[in] host The host sent the request, the confirm of a request of the NCP itself is not forwarded to the host
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ *
+ */
+esp_err_t esp_ncp_zb_aps_data_request(esp_zb_apsde_data_req_t *req, bool host);
+
+/**
+ * @brief   Pass a ZCL action of the stack to the NCP, as the stack does through the registered action handler.
+ *
+ * @note Lets the benchmarks build the ZCL responses and notifications without running the stack.
+ *
+ * @param[in] callback_id The action type, refer to esp_zb_core_action_callback_id_t
+ * @param[in] message     The message, the type depends on the callback_id
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ *
+ */
+esp_err_t esp_ncp_zb_action(esp_zb_core_action_callback_id_t callback_id, const void *message);
+
 #ifdef __cplusplus
 }
 #endif
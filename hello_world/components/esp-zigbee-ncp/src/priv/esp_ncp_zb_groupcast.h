@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_zigbee_core.h"
+
+#define ESP_NCP_ZB_GROUPCAST_SET_MAX            8       /*!< The number of device sets whose group membership is maintained */
+#define ESP_NCP_ZB_GROUPCAST_MAX_DEV            64      /*!< The maximum number of devices in one consolidated set */
+#define ESP_NCP_ZB_GROUPCAST_PROMOTE            3       /*!< The number of commands to the same set before a group is created for it */
+#define ESP_NCP_ZB_GROUPCAST_GROUP_BASE         0xF000  /*!< The first group ID used by the NCP */
+#define ESP_NCP_ZB_GROUPCAST_GROUP_RANGE        256     /*!< The number of group IDs used by the NCP */
+#define ESP_NCP_ZB_GROUPCAST_RETRY              3       /*!< The number of retries of a dropped group membership command */
+#define ESP_NCP_ZB_GROUPCAST_RETRY_MS           500     /*!< The delay before the first retry, doubled on every retry */
+#define ESP_NCP_ZB_GROUPCAST_PURGE_MS           1000    /*!< The time the purge of a group ID takes to reach the network before its members are added */
+#define ESP_NCP_ZB_GROUPCAST_REMOVE_TSN_MAX     32      /*!< The number of remove group commands whose responses are recognized */
+
+/**
+ * @brief The result of one consolidated command.
+ *
+ */
+typedef struct {
+    uint16_t    group_id;                       /*!< The group the command was sent to, 0 when no groupcast was sent */
+    uint16_t    unicast;                        /*!< The number of devices which got the command by unicast */
+    uint16_t    saved;                          /*!< The number of frames saved by the groupcast */
+    uint16_t    failed;                         /*!< The number of devices whose command was dropped */
+} esp_ncp_zb_groupcast_result_t;
+
+/**
+ * @brief The air-time saved by the consolidation.
+ *
+ */
+typedef struct {
+    uint32_t    groupcast;                      /*!< The number of groupcasts sent */
+    uint32_t    unicast;                        /*!< The number of unicasts sent */
+    uint32_t    frames_saved;                   /*!< The number of frames saved */
+    int32_t     bytes_saved;                    /*!< The estimated air-time saved in bytes, the groupcast cost included */
+    uint8_t     sets;                           /*!< The number of device sets tracked */
+    uint8_t     groups;                         /*!< The number of device sets with a group */
+    uint32_t    remove_failed;                  /*!< The number of remove group commands dropped after all retries */
+} esp_ncp_zb_groupcast_stats_t;
+
+/**
+ * @brief  Send the same cluster command to a set of devices.
+ *
+ * The devices which are members of the group maintained for this set get a single groupcast, the others
+ * get a unicast. A set which is targeted often enough gets a group, its members are added in the background.
+ * A group ID is purged with a groupcast remove group command before its first use and before every reuse,
+ * so the devices left in it by an evicted set or before a reboot never get the commands of another set.
+ * The ID of an evicted set is not reused until the remove group commands of its members are sent or given up.
+ *
+ * @note The function must be called from the Zigbee task.
+ *
+ * @param[in]  cmd       The cluster command, the destination address and address mode are ignored
+ * @param[in]  value_len The length of the encoded command payload cmd->data.value points to
+ * @param[in]  dev       The short addresses of the devices
+ * @param[in]  dev_count The number of devices
+ * @param[out] result    The result of the command
+ * @param[out] sent      A bitmap of (dev_count + 7) / 8 bytes, the bit of every entry of dev which got the command by
+ *                       groupcast or unicast is set, the others are left as they are
+ *
+ * @return
+ *    - ESP_OK: succeed, every device got the command
+ *    - ESP_ERR_NO_MEM: the command to some devices was dropped, refer to result and sent
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_zb_groupcast_send(const esp_zb_zcl_custom_cluster_cmd_t *cmd, uint16_t value_len, const uint16_t *dev, uint16_t dev_count,
+                                    esp_ncp_zb_groupcast_result_t *result, uint8_t *sent);
+
+/**
+ * @brief  Consume the add and remove group responses of the membership maintenance.
+ *
+ * @note The responses are matched by source, group and TSN, those to the group commands of the host pass through.
+ *
+ * @param[in] callback_id The action callback ID
+ * @param[in] message     The action callback message
+ *
+ * @return true when the message belongs to the membership maintenance
+ */
+bool esp_ncp_zb_groupcast_handle(esp_zb_core_action_callback_id_t callback_id, const void *message);
+
+/**
+ * @brief  Get the air-time saved by the consolidation.
+ *
+ * @param[out] stats The consolidation statistics
+ *
+ */
+void esp_ncp_zb_groupcast_stats_get(esp_ncp_zb_groupcast_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
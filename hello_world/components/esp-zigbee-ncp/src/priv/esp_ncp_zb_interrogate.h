@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define ESP_NCP_ZB_INTERROGATE_QUEUE_LEN        256     /*!< The number of devices waiting for the interrogation */
+#define ESP_NCP_ZB_INTERROGATE_MAX_ACTIVE       8       /*!< The maximum number of devices interrogated at the same time */
+#define ESP_NCP_ZB_INTERROGATE_MAX_EP           16      /*!< The maximum number of endpoints described for one device */
+#define ESP_NCP_ZB_INTERROGATE_CONCURRENCY      4       /*!< The default number of devices interrogated at the same time */
+#define ESP_NCP_ZB_INTERROGATE_RETRIES          2       /*!< The default number of retries of one ZDO request */
+#define ESP_NCP_ZB_INTERROGATE_BACKOFF_MS       250     /*!< The delay before the first retry of a ZDO request, doubled for each next one */
+#define ESP_NCP_ZB_INTERROGATE_TIMEOUT_MS       10000   /*!< The time to wait for the answer of one ZDO request before it is retried */
+
+/**
+ * @brief  Configure the interrogation engine.
+ *
+ * @note The function must be called from the Zigbee task or with the Zigbee lock held.
+ *
+ * @param[in] auto_enable Interrogate every device which announces itself
+ * @param[in] concurrency The number of devices interrogated at the same time, 0 to use the default
+ * @param[in] retries     The number of retries of one ZDO request
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_zb_interrogate_config(bool auto_enable, uint8_t concurrency, uint8_t retries);
+
+/**
+ * @brief  Queue a device for the interrogation.
+ *
+ * The engine chains the node descriptor, active endpoint and simple descriptor requests of the device
+ * and sends one ESP_NCP_ZDO_DEVICE_PROFILE notification when it completes. The notification has the status
+ * ESP_ZB_ZDP_STATUS_INSUFFICIENT_SPACE when some endpoints could not be described, the others follow.
+ * A request unanswered for ESP_NCP_ZB_INTERROGATE_TIMEOUT_MS is retried, and the device completes with
+ * ESP_ZB_ZDP_STATUS_TIMEOUT when no retry is left.
+ *
+ * @note The function must be called from the Zigbee task or with the Zigbee lock held.
+ *
+ * @param[in] short_addr The short address of the device
+ *
+ * @return
+ *    - ESP_OK: succeed, or the device is already queued
+ *    - ESP_ERR_NO_MEM: the queue is full
+ */
+esp_err_t esp_ncp_zb_interrogate_add(uint16_t short_addr);
+
+/**
+ * @brief  Get the number of devices the queue still takes.
+ *
+ * @note A device already queued or interrogated takes no room when it is added again.
+ *
+ * @return The number of free queue entries
+ */
+uint16_t esp_ncp_zb_interrogate_room(void);
+
+/**
+ * @brief  Queue an announced device for the interrogation when the automatic mode is enabled.
+ *
+ * @param[in] short_addr The short address of the device
+ *
+ */
+void esp_ncp_zb_interrogate_device_annce(uint16_t short_addr);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_zigbee_core.h"
+
+#define ESP_NCP_ZB_JOIN_BATCH_MAX               32      /*!< The maximum number of devices in one batch */
+#define ESP_NCP_ZB_JOIN_FLUSH_MS                250     /*!< The default time a batch is held after its first event */
+
+/**
+ * @brief The join and leave events of a batch.
+ *
+ */
+typedef enum {
+    ESP_NCP_ZB_JOIN_EVENT_ANNCE,                /*!< The device announced itself after a join or rejoin */
+    ESP_NCP_ZB_JOIN_EVENT_LEAVE,                /*!< The device left the network */
+} esp_ncp_zb_join_event_t;
+
+/**
+ * @brief  Configure the batching of the join and leave events.
+ *
+ * @note The join functions must be called from the Zigbee task.
+ *
+ * @param[in] enable      Batch the events, otherwise every event is notified on its own
+ * @param[in] max_records The number of devices which flushes a batch, 0 keeps the current value
+ * @param[in] flush_ms    The time a batch is held after its first event, 0 keeps the current value
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_ARG: max_records is above ESP_NCP_ZB_JOIN_BATCH_MAX
+ */
+esp_err_t esp_ncp_zb_join_config(bool enable, uint8_t max_records, uint16_t flush_ms);
+
+/**
+ * @brief  Add a device announce to the batch.
+ *
+ * @param[in] params The device announce parameters
+ *
+ * @return true when the event is batched, false when batching is disabled
+ */
+bool esp_ncp_zb_join_device_annce(const esp_zb_zdo_signal_device_annce_params_t *params);
+
+/**
+ * @brief  Add a device leave to the batch.
+ *
+ * @param[in] params The leave indication parameters
+ *
+ * @return true when the event is batched, false when batching is disabled
+ */
+bool esp_ncp_zb_join_leave(const esp_zb_zdo_signal_leave_indication_params_t *params);
+
+/**
+ * @brief  Send the pending batch to the host now.
+ *
+ */
+void esp_ncp_zb_join_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#define ESP_NCP_ZB_MAILBOX_LEN                  32      /*!< The number of closures waiting for the Zigbee task */
+#define ESP_NCP_ZB_MAILBOX_BATCH                8       /*!< The maximum number of closures run in one stack loop iteration */
+#define ESP_NCP_ZB_MAILBOX_KICK_RETRIES         10      /*!< The attempts, one tick apart, to schedule a drain while the stack has no user callback free */
+
+/**
+ * @brief A closure run in the Zigbee task.
+ *
+ * @param[in] arg The argument given to esp_ncp_zb_mailbox_post()
+ *
+ */
+typedef void (*esp_ncp_zb_mailbox_fn_t)(void *arg);
+
+/**
+ * @brief  Create the mailbox carrying closures into the Zigbee task.
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_zb_mailbox_init(void);
+
+/**
+ * @brief  Post a closure to be run in the Zigbee task.
+ *
+ * The closures are run in the order they are posted, in batches of at most ESP_NCP_ZB_MAILBOX_BATCH
+ * per stack loop iteration. The queue itself takes no Zigbee lock, the lock is only taken to wake up an
+ * idle mailbox, because the scheduler alarm of the stack may only be set under it from another task.
+ *
+ * @param[in] fn  The closure
+ * @param[in] arg The argument of the closure, owned by the closure once posted
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_STATE: the mailbox is not created
+ *    - ESP_ERR_NO_MEM: the mailbox is full
+ */
+esp_err_t esp_ncp_zb_mailbox_post(esp_ncp_zb_mailbox_fn_t fn, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_zigbee_core.h"
+
+#define ESP_NCP_ZB_RULE_MAX                     16      /*!< The number of rules in the rule table */
+#define ESP_NCP_ZB_RULE_CODE_MAX                32      /*!< The maximum length of the condition bytecode */
+#define ESP_NCP_ZB_RULE_ACTION_MAX              64      /*!< The maximum length of the encoded action */
+#define ESP_NCP_ZB_RULE_STACK_DEPTH             8       /*!< The depth of the condition evaluation stack */
+#define ESP_NCP_ZB_RULE_HIST_BUCKETS            8       /*!< The number of latency histogram buckets, the first one ends at 50 us and every next one doubles */
+#define ESP_NCP_ZB_RULE_HIST_BASE_US            50      /*!< The upper bound of the first latency histogram bucket */
+
+#define ESP_NCP_ZB_RULE_ANY_ADDR                0xFFFF  /*!< The trigger matches any source address */
+#define ESP_NCP_ZB_RULE_ANY_ENDPOINT            0xFF    /*!< The trigger matches any source endpoint */
+#define ESP_NCP_ZB_RULE_ANY_ATTR                0xFFFF  /*!< The trigger matches any attribute of the cluster */
+
+#define ESP_NCP_ZB_RULE_FLAG_EDGE               0x01    /*!< Run the action only when the condition turns true */
+#define ESP_NCP_ZB_RULE_FLAG_NOTIFY             0x02    /*!< Tell the host every time the action runs */
+
+/**
+ * @brief The events triggering a rule.
+ *
+ */
+typedef enum {
+    ESP_NCP_ZB_RULE_TRIGGER_REPORT,             /*!< An attribute report, the value is the attribute value */
+    ESP_NCP_ZB_RULE_TRIGGER_APS,                /*!< An APS data indication, the value is the ASDU length */
+} esp_ncp_zb_rule_trigger_t;
+
+/**
+ * @brief The actions of a rule.
+ *
+ */
+typedef enum {
+    ESP_NCP_ZB_RULE_ACTION_ZCL,                 /*!< Send a cluster command */
+    ESP_NCP_ZB_RULE_ACTION_APS,                 /*!< Send an APS data request */
+} esp_ncp_zb_rule_action_t;
+
+/**
+ * @brief The condition bytecode, operands follow the opcode in little endian.
+ *
+ * The condition runs on a stack of int32_t values without jumps, so its run time is bounded by its length.
+ * The action runs when the top of the stack is not 0 at RET or at the end of the code, or when the code is empty.
+ */
+typedef enum {
+    ESP_NCP_ZB_RULE_OP_RET      = 0x00,         /*!< End the condition */
+    ESP_NCP_ZB_RULE_OP_CONST    = 0x01,         /*!< Push the int32_t operand */
+    ESP_NCP_ZB_RULE_OP_VALUE    = 0x02,         /*!< Push the trigger value */
+    ESP_NCP_ZB_RULE_OP_PREV     = 0x03,         /*!< Push the trigger value of the previous run of this rule */
+    ESP_NCP_ZB_RULE_OP_BYTE     = 0x04,         /*!< Push the payload byte at the uint8_t operand, 0 beyond the payload */
+    ESP_NCP_ZB_RULE_OP_EQ       = 0x10,         /*!< Pop b and a, push a == b */
+    ESP_NCP_ZB_RULE_OP_NE       = 0x11,         /*!< Pop b and a, push a != b */
+    ESP_NCP_ZB_RULE_OP_LT       = 0x12,         /*!< Pop b and a, push a < b */
+    ESP_NCP_ZB_RULE_OP_LE       = 0x13,         /*!< Pop b and a, push a <= b */
+    ESP_NCP_ZB_RULE_OP_GT       = 0x14,         /*!< Pop b and a, push a > b */
+    ESP_NCP_ZB_RULE_OP_GE       = 0x15,         /*!< Pop b and a, push a >= b */
+    ESP_NCP_ZB_RULE_OP_AND      = 0x16,         /*!< Pop b and a, push a && b */
+    ESP_NCP_ZB_RULE_OP_OR       = 0x17,         /*!< Pop b and a, push a || b */
+    ESP_NCP_ZB_RULE_OP_NOT      = 0x18,         /*!< Pop a, push !a */
+    ESP_NCP_ZB_RULE_OP_BAND     = 0x19,         /*!< Pop b and a, push a & b */
+} esp_ncp_zb_rule_op_t;
+
+/**
+ * @brief A rule as installed by the host.
+ *
+ */
+typedef struct {
+    uint8_t     flags;                          /*!< The rule flags, refer to ESP_NCP_ZB_RULE_FLAG_EDGE */
+    uint8_t     trigger;                        /*!< The trigger, refer to esp_ncp_zb_rule_trigger_t */
+    uint16_t    src_addr;                       /*!< The short address of the source, or ESP_NCP_ZB_RULE_ANY_ADDR */
+    uint8_t     src_endpoint;                   /*!< The source endpoint, or ESP_NCP_ZB_RULE_ANY_ENDPOINT */
+    uint16_t    cluster_id;                     /*!< The cluster of the report or indication */
+    uint16_t    attr_id;                        /*!< The reported attribute, or ESP_NCP_ZB_RULE_ANY_ATTR */
+    uint8_t     code_len;                       /*!< The length of the condition bytecode */
+    uint8_t     action_len;                     /*!< The length of the encoded action */
+    uint8_t     code[ESP_NCP_ZB_RULE_CODE_MAX]; /*!< The condition bytecode, refer to esp_ncp_zb_rule_op_t */
+    uint8_t     action[ESP_NCP_ZB_RULE_ACTION_MAX]; /*!< The encoded action, led by its esp_ncp_zb_rule_action_t */
+} esp_ncp_zb_rule_t;
+
+/**
+ * @brief The execution statistics of a rule.
+ *
+ */
+typedef struct {
+    uint32_t    hits;                           /*!< The number of times the trigger matched */
+    uint32_t    fired;                          /*!< The number of times the action ran */
+    uint32_t    errors;                         /*!< The number of actions dropped by the air-time scheduler or refused by the stack */
+    uint32_t    hist[ESP_NCP_ZB_RULE_HIST_BUCKETS]; /*!< The latency from the trigger to the action handed to the stack */
+} esp_ncp_zb_rule_stats_t;
+
+/**
+ * @brief Tell the host a rule ran its action.
+ *
+ * @note It is called once the air-time scheduler sends or drops the action.
+ *
+ * @param[in] rule_id The rule index
+ * @param[in] value   The trigger value
+ * @param[in] result  The result of the action
+ * @param[in] tsn     The ZCL transaction sequence number of a ZCL action, 0 otherwise
+ *
+ */
+typedef void (*esp_ncp_zb_rule_notify_fn_t)(uint8_t rule_id, int32_t value, esp_err_t result, uint8_t tsn);
+
+/**
+ * @brief  Install, replace or remove a rule.
+ *
+ * @note The rule functions must be called from the Zigbee task.
+ *
+ * @param[in] rule_id The rule index, less than ESP_NCP_ZB_RULE_MAX
+ * @param[in] rule    The rule, NULL removes it
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_ARG: the bytecode or the action is malformed
+ */
+esp_err_t esp_ncp_zb_rule_set(uint8_t rule_id, const esp_ncp_zb_rule_t *rule);
+
+/**
+ * @brief  Set the function telling the host about the rules with ESP_NCP_ZB_RULE_FLAG_NOTIFY.
+ *
+ * @param[in] fn The notify function
+ *
+ */
+void esp_ncp_zb_rule_notify_register(esp_ncp_zb_rule_notify_fn_t fn);
+
+/**
+ * @brief  Run the rules triggered by an attribute report.
+ *
+ * @param[in] message The attribute report
+ *
+ */
+void esp_ncp_zb_rule_report(const esp_zb_zcl_report_attr_message_t *message);
+
+/**
+ * @brief  Run the rules triggered by an APS data indication.
+ *
+ * @param[in] ind The APS data indication
+ *
+ */
+void esp_ncp_zb_rule_aps_indication(const esp_zb_apsde_data_ind_t *ind);
+
+/**
+ * @brief  Check an encoded action, led by its esp_ncp_zb_rule_action_t.
+ *
+ * @param[in] action     The encoded action
+ * @param[in] action_len The length of the encoded action
+ *
+ * @return true when the action can be sent
+ */
+bool esp_ncp_zb_rule_action_verify(const uint8_t *action, uint8_t action_len);
+
+/**
+ * @brief  Queue an encoded action checked by esp_ncp_zb_rule_action_verify() to the air-time scheduler.
+ *
+ * @param[in] action The encoded action, copied
+ *
+ * @return
+ *    - ESP_OK: succeed, the action may already be sent
+ *    - ESP_ERR_NO_MEM: the action is dropped
+ */
+esp_err_t esp_ncp_zb_rule_action_send(const uint8_t *action);
+
+/**
+ * @brief  Get the execution statistics of a rule.
+ *
+ * @param[in]  rule_id The rule index
+ * @param[out] stats   The rule statistics
+ * @param[in]  reset   Reset the statistics after reading them
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_NOT_FOUND: no rule is installed at this index
+ */
+esp_err_t esp_ncp_zb_rule_stats_get(uint8_t rule_id, esp_ncp_zb_rule_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
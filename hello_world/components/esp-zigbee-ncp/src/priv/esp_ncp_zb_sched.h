@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define ESP_NCP_ZB_SCHED_QUEUE_LEN              64      /*!< The number of frames waiting for air-time */
+#define ESP_NCP_ZB_SCHED_PEER_MAX               32      /*!< The number of destinations and next hops whose pacing is tracked */
+#define ESP_NCP_ZB_SCHED_DST_DEPTH              8       /*!< The maximum number of frames queued for one destination */
+#define ESP_NCP_ZB_SCHED_RATE                   3000    /*!< The default air-time budget, in bytes per second */
+#define ESP_NCP_ZB_SCHED_BURST                  600     /*!< The default token bucket depth, in bytes */
+#define ESP_NCP_ZB_SCHED_DST_GAP_MS             40      /*!< The default minimum gap between two frames to the same destination */
+#define ESP_NCP_ZB_SCHED_HOP_GAP_MS             10      /*!< The default minimum gap between two frames through the same next hop */
+#define ESP_NCP_ZB_SCHED_ROUTE_TTL_MS           1000    /*!< The time the next hop of a destination is taken from the cache instead of the routing table */
+#define ESP_NCP_ZB_SCHED_TICK_MS                10      /*!< The interval to retry the frames waiting for tokens or pacing */
+#define ESP_NCP_ZB_SCHED_FRAME_OVERHEAD         40      /*!< The MAC, NWK, APS and ZCL header bytes added to every frame */
+#define ESP_NCP_ZB_SCHED_BROADCAST_FACTOR       4       /*!< The cost multiplier of a frame which is not unicast */
+
+/**
+ * @brief The frame classes of the scheduler, a lower value is served first.
+ *
+ */
+typedef enum {
+    ESP_NCP_ZB_SCHED_CLASS_COMMAND,             /*!< The cluster commands acting on devices */
+    ESP_NCP_ZB_SCHED_CLASS_ATTRIBUTE,           /*!< The attribute reads, writes and reporting configurations */
+    ESP_NCP_ZB_SCHED_CLASS_BACKGROUND,          /*!< The maintenance traffic */
+    ESP_NCP_ZB_SCHED_CLASS_MAX,                 /*!< The number of frame classes */
+} esp_ncp_zb_sched_class_t;
+
+/**
+ * @brief The scheduler configuration.
+ *
+ */
+typedef struct {
+    bool        enable;                         /*!< Schedule the frames, otherwise they are sent at once */
+    uint16_t    rate;                           /*!< The air-time budget, in bytes per second */
+    uint16_t    burst;                          /*!< The token bucket depth, in bytes */
+    uint16_t    dst_gap_ms;                     /*!< The minimum gap between two frames to the same destination */
+    uint16_t    hop_gap_ms;                     /*!< The minimum gap between two frames through the same next hop */
+} esp_ncp_zb_sched_config_t;
+
+/**
+ * @brief The scheduler statistics.
+ *
+ */
+typedef struct {
+    uint16_t    queued[ESP_NCP_ZB_SCHED_CLASS_MAX]; /*!< The number of frames queued in every class */
+    uint16_t    max_queued;                     /*!< The highest number of frames queued at once */
+    uint16_t    tokens;                         /*!< The bytes left in the token bucket */
+    uint32_t    sent;                           /*!< The number of frames handed to the stack */
+    uint32_t    deferred;                       /*!< The number of frames which waited for tokens or pacing */
+    uint32_t    dropped;                        /*!< The number of frames dropped because a queue was full */
+} esp_ncp_zb_sched_stats_t;
+
+/**
+ * @brief Send or drop a scheduled frame.
+ *
+ * @param[in] arg  The argument given to esp_ncp_zb_sched_submit()
+ * @param[in] drop The frame is dropped, the function only releases the argument
+ *
+ */
+typedef void (*esp_ncp_zb_sched_fn_t)(void *arg, bool drop);
+
+/**
+ * @brief  Configure the scheduler.
+ *
+ * @note The scheduler functions must be called from the Zigbee task.
+ *
+ * @param[in] config The scheduler configuration, 0 fields keep the defaults
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - others: refer to esp_err.h
+ */
+esp_err_t esp_ncp_zb_sched_config(const esp_ncp_zb_sched_config_t *config);
+
+/**
+ * @brief  Queue a frame until the air-time budget and the pacing of its destination allow it.
+ *
+ * The frames are paced per destination and per next hop from the routing table, the next hop standing for the
+ * parent the frames share: the NCP is not told which router parents an end device, the route to it ends there.
+ * A frame of a lower class dropped to make room is released once the new frame is queued, so its function
+ * may submit again.
+ *
+ * @param[in] sched_class The frame class, refer to esp_ncp_zb_sched_class_t
+ * @param[in] dst_addr    The short address of the destination
+ * @param[in] unicast     The frame is sent to a single device
+ * @param[in] length      The payload length of the frame
+ * @param[in] fn          The function sending or dropping the frame, called exactly once
+ * @param[in] arg         The argument of the function
+ *
+ * @return
+ *    - ESP_OK: succeed, the frame may already be sent
+ *    - ESP_ERR_NO_MEM: the frame is dropped, fn is called with drop set
+ */
+esp_err_t esp_ncp_zb_sched_submit(uint8_t sched_class, uint16_t dst_addr, bool unicast, uint16_t length, esp_ncp_zb_sched_fn_t fn, void *arg);
+
+/**
+ * @brief  Get the scheduler statistics.
+ *
+ * @param[out] stats The scheduler statistics
+ * @param[in]  reset Reset the counters after reading them
+ *
+ */
+void esp_ncp_zb_sched_stats_get(esp_ncp_zb_sched_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define ESP_NCP_ZB_TIMER_MAX                    2048    /*!< The number of deferred commands the NCP holds */
+#define ESP_NCP_ZB_TIMER_TICK_MS                20      /*!< The resolution of the timer wheel */
+#define ESP_NCP_ZB_TIMER_ROOT_BITS              8       /*!< The slots of the first wheel level, as a power of two */
+#define ESP_NCP_ZB_TIMER_LEVEL_BITS             6       /*!< The slots of every other wheel level, as a power of two */
+#define ESP_NCP_ZB_TIMER_LEVELS                 5       /*!< The number of wheel levels, covering the whole 32-bit tick range */
+#define ESP_NCP_ZB_TIMER_HIST_BUCKETS           8       /*!< The number of jitter histogram buckets, the first one ends at one wheel tick and every next one doubles */
+#define ESP_NCP_ZB_TIMER_HIST_BASE_US           (ESP_NCP_ZB_TIMER_TICK_MS * 1000UL) /*!< The upper bound of the first jitter histogram bucket, finer buckets would only split the tick */
+#define ESP_NCP_ZB_TIMER_INVALID_ID             0       /*!< No timer has this ID */
+#define ESP_NCP_ZB_TIMER_MAX_TICKS              (1UL << 30) /*!< The furthest deadline in ticks, half the signed tick range the wheel compares in */
+#define ESP_NCP_ZB_TIMER_MAX_DELAY_MS           ((uint64_t)ESP_NCP_ZB_TIMER_MAX_TICKS * ESP_NCP_ZB_TIMER_TICK_MS) /*!< The furthest deadline, about 248 days */
+
+/**
+ * @brief The firing statistics of the deferred commands.
+ *
+ * The jitter is measured from the deadline rounded up to the next wheel tick.
+ */
+typedef struct {
+    uint16_t    pending;                        /*!< The number of timers waiting */
+    uint16_t    max_pending;                    /*!< The highest number of timers waiting at once */
+    uint32_t    fired;                          /*!< The number of timers fired */
+    uint32_t    errors;                         /*!< The number of commands dropped before the air-time scheduler */
+    uint32_t    jitter_avg_us;                  /*!< The average delay between the deadline and the firing */
+    uint32_t    jitter_max_us;                  /*!< The longest delay between the deadline and the firing */
+    uint32_t    hist[ESP_NCP_ZB_TIMER_HIST_BUCKETS]; /*!< The delay between the deadline and the firing */
+} esp_ncp_zb_timer_stats_t;
+
+/**
+ * @brief The state of a pending timer.
+ *
+ */
+typedef struct {
+    uint32_t    id;                             /*!< The timer ID */
+    uint32_t    remaining_ms;                   /*!< The time left before the timer fires */
+    uint32_t    period_ms;                      /*!< The period of the timer, 0 for a single shot */
+} esp_ncp_zb_timer_info_t;
+
+/**
+ * @brief  Queue a command until its deadline.
+ *
+ * @note The timer functions must be called from the Zigbee task, the commands are sent from the Zigbee task too.
+ *
+ * @param[in]  delay_ms   The time before the command is sent, up to ESP_NCP_ZB_TIMER_MAX_DELAY_MS
+ * @param[in]  period_ms  The period to send the command again, 0 to send it once
+ * @param[in]  action     The command, encoded as a rule action
+ * @param[in]  action_len The length of the command
+ * @param[out] id         The timer ID
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_INVALID_ARG: the command is malformed or the deadline is beyond the range of the wheel
+ *    - ESP_ERR_NO_MEM: the timer table is full
+ */
+esp_err_t esp_ncp_zb_timer_add(uint64_t delay_ms, uint32_t period_ms, const uint8_t *action, uint8_t action_len, uint32_t *id);
+
+/**
+ * @brief  Cancel a pending timer.
+ *
+ * @param[in] id The timer ID
+ *
+ * @return
+ *    - ESP_OK: succeed
+ *    - ESP_ERR_NOT_FOUND: the timer already fired or does not exist
+ */
+esp_err_t esp_ncp_zb_timer_cancel(uint32_t id);
+
+/**
+ * @brief  List the pending timers from a table index on.
+ *
+ * @param[in]  start The table index to start from
+ * @param[out] info  The pending timers
+ * @param[in]  max   The maximum number of timers to list
+ * @param[out] next  The table index to continue from, 0 when the table is done
+ *
+ * @return The number of timers listed
+ */
+uint16_t esp_ncp_zb_timer_list(uint16_t start, esp_ncp_zb_timer_info_t *info, uint16_t max, uint16_t *next);
+
+/**
+ * @brief  Get the firing statistics of the deferred commands.
+ *
+ * @param[out] stats The timer statistics
+ * @param[in]  reset Reset the counters after reading them
+ *
+ */
+void esp_ncp_zb_timer_stats_get(esp_ncp_zb_timer_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
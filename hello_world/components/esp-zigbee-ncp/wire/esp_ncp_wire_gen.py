@@ -0,0 +1,939 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Generates the payload codecs of esp_ncp_wire.json:
+#
+#   src/priv/esp_ncp_wire.h          C for the NCP, header only so that the codecs inline, decoding in place
+#   host/include/esp_ncp/wire.hpp    C++ for the host library, with constexpr layouts, owning types to build
+#                                    payloads and views decoding in place like the C codecs
+#
+# Both check every length against the buffer and read and write the fields byte by byte in little
+# endian, nothing is cast from the buffer. Run it after editing the schema, --check exits 1 when the
+# generated files are out of date.
+
+import argparse
+import json
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SCHEMA = os.path.join(ROOT, 'wire', 'esp_ncp_wire.json')
+C_HEADER = os.path.join(ROOT, 'src', 'priv', 'esp_ncp_wire.h')
+CPP_HEADER = os.path.join(ROOT, 'host', 'include', 'esp_ncp', 'wire.hpp')
+
+LICENSE = '''/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by wire/esp_ncp_wire_gen.py from wire/esp_ncp_wire.json, do not edit */
+'''
+
+# name: (size, C type, C++ type)
+PRIMITIVES = {
+    'u8': (1, 'uint8_t', 'uint8_t'),
+    'u16': (2, 'uint16_t', 'uint16_t'),
+    'u32': (4, 'uint32_t', 'uint32_t'),
+    'u64': (8, 'uint64_t', 'uint64_t'),
+    's32': (4, 'int32_t', 'int32_t'),
+    'bool': (1, 'bool', 'bool'),
+    'addr': (8, 'esp_ncp_wire_addr_t', 'Addr'),
+}
+
+
+class Field:
+    def __init__(self, spec):
+        self.name = spec['name']
+        self.doc = spec.get('doc', '')
+        kind = spec['type']
+        self.list = None
+        self.bytes = None
+        self.type = None
+        if isinstance(kind, dict):
+            if 'list' in kind:
+                self.list = kind['list']
+                self.count = kind['count']
+            else:
+                self.bytes = kind['bytes']
+                self.count = kind['bytes']
+        else:
+            self.type = kind
+
+    @property
+    def variable(self):
+        return self.list is not None or self.bytes is not None
+
+
+class Type:
+    def __init__(self, name, spec):
+        self.name = name
+        self.doc = spec.get('doc', '')
+        self.fields = [Field(field) for field in spec['fields']]
+        self.frames = []
+        self.element = False
+
+    @property
+    def c_name(self):
+        return 'esp_ncp_wire_%s' % self.name
+
+    @property
+    def c_macro(self):
+        return 'ESP_NCP_WIRE_%s_FIXED_SIZE' % self.name.upper()
+
+    @property
+    def cpp_name(self):
+        return ''.join(part.capitalize() for part in self.name.split('_'))
+
+
+class Schema:
+    def __init__(self, path):
+        with open(path) as file:
+            spec = json.load(file)
+        self.types = {name: Type(name, body) for name, body in spec['types'].items()}
+        self.frames = spec['frames']
+        self.order = []
+        for name in self.types:
+            self._visit(name, [])
+        for type_ in self.types.values():
+            self._check(type_)
+        for frame, roles in self.frames.items():
+            for role, name in roles.items():
+                self.types[name].frames.append((frame, role))
+
+    def _visit(self, name, stack):
+        if name in stack:
+            sys.exit('esp_ncp_wire: %s includes itself' % name)
+        if name in self.order:
+            return
+        for field in self.types[name].fields:
+            ref = field.list if field.list else field.type
+            if ref in self.types:
+                self._visit(ref, stack + [name])
+        self.order.append(name)
+
+    def _check(self, type_):
+        counts = {}
+        seen = {}
+        for field in type_.fields:
+            ref = field.list if field.list else field.type
+            if ref and ref not in PRIMITIVES and ref not in self.types:
+                sys.exit('esp_ncp_wire: %s.%s has the unknown type %s' % (type_.name, field.name, ref))
+            if field.type in self.types and not self.fixed(self.types[field.type]):
+                sys.exit('esp_ncp_wire: %s.%s embeds a variable type, use a list' % (type_.name, field.name))
+            if field.list in self.types:
+                self.types[field.list].element = True
+            if field.variable:
+                count = seen.get(field.count)
+                if not count or count.type not in ('u8', 'u16', 'u32'):
+                    sys.exit('esp_ncp_wire: %s.%s is sized by %s, not an earlier unsigned field' % (type_.name, field.name, field.count))
+                if field.count in counts:
+                    sys.exit('esp_ncp_wire: %s.%s sizes more than one field' % (type_.name, field.count))
+                counts[field.count] = field
+            seen[field.name] = field
+        type_.counts = counts
+
+    def fixed(self, type_):
+        return not any(field.variable for field in type_.fields)
+
+    def size(self, field):
+        if field.type in PRIMITIVES:
+            return PRIMITIVES[field.type][0]
+        return self.fixed_size(self.types[field.type])
+
+    def fixed_size(self, type_):
+        return sum(self.size(field) for field in type_.fields if not field.variable)
+
+    def prefix(self, type_):
+        """The fields before the first variable one, with their offsets"""
+        offset = 0
+        for field in type_.fields:
+            if field.variable:
+                break
+            yield field, offset
+            offset += self.size(field)
+
+    def groups(self, type_):
+        """The runs of fixed fields with their offsets in the run, and the variable fields alone"""
+        run = []
+        offset = 0
+        for field in type_.fields:
+            if field.variable:
+                if run:
+                    yield run, offset
+                yield [(field, 0)], None
+                run, offset = [], 0
+            else:
+                run.append((field, offset))
+                offset += self.size(field)
+        if run:
+            yield run, offset
+
+
+def frame_doc(type_, c):
+    roles = {'request': 'The request', 'response': 'The response', 'notification': 'The notification'}
+    uses = []
+    for frame, role in type_.frames:
+        uses.append('%s of %s' % (roles[role], ('ESP_NCP_' + frame) if c else ('frame_id::' + frame)))
+    return uses
+
+
+def member(decl, doc, width=52):
+    return '    %s%s/*!< %s */' % (decl, ' ' * max(1, width - len(decl)), doc)
+
+
+# C
+
+def c_member_type(schema, field):
+    if field.type in PRIMITIVES:
+        return PRIMITIVES[field.type][1]
+    return schema.types[field.type].c_name + '_t'
+
+
+def c_header(schema):
+    out = [LICENSE]
+    out.append('''#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief A short or long address, esp_zb_addr_u on the wire.
+ *
+ */
+typedef struct {
+    uint8_t bytes[8];                               /*!< The long address, or the short address in the first 2 bytes */
+} esp_ncp_wire_addr_t;
+
+static inline uint16_t esp_ncp_wire_get_u16(const uint8_t *buf, size_t index)
+{
+    return (uint16_t)(buf[2 * index] | (buf[2 * index + 1] << 8));
+}
+
+static inline uint16_t esp_ncp_wire_addr_short(const esp_ncp_wire_addr_t *addr)
+{
+    return esp_ncp_wire_get_u16(addr->bytes, 0);
+}
+
+static inline void esp_ncp_wire_addr_set_short(esp_ncp_wire_addr_t *addr, uint16_t short_addr)
+{
+    addr->bytes[0] = (uint8_t)short_addr;
+    addr->bytes[1] = (uint8_t)(short_addr >> 8);
+}
+''')
+    for name in schema.order:
+        type_ = schema.types[name]
+        out.append('#define %s %d' % (type_.c_macro.ljust(47), schema.fixed_size(type_) if schema.fixed(type_) else
+                                       sum(schema.size(field) for field, _ in schema.prefix(type_))))
+    out.append('')
+
+    for name in schema.order:
+        type_ = schema.types[name]
+        out.append('/**')
+        out.append(' * @brief %s.' % type_.doc)
+        for use in frame_doc(type_, True):
+            out.append(' * @note %s.' % use)
+        out.append(' *')
+        out.append(' */')
+        out.append('typedef struct {')
+        for field in type_.fields:
+            if field.list in schema.types:
+                element = schema.types[field.list]
+                out.append(member('const uint8_t *%s;' % field.name,
+                                  '%s, %s records read with %s_next()' % (field.doc, field.count, element.c_name)))
+                out.append(member('size_t %s_len;' % field.name, 'The bytes of the %s records' % field.name))
+            elif field.list:
+                out.append(member('const uint8_t *%s;' % field.name,
+                                  '%s, %s little endian %s read with esp_ncp_wire_get_%s()' %
+                                  (field.doc, field.count, PRIMITIVES[field.list][1], field.list)))
+            elif field.bytes:
+                out.append(member('const uint8_t *%s;' % field.name, '%s, %s bytes' % (field.doc, field.count)))
+            else:
+                out.append(member('%s %s;' % (c_member_type(schema, field), field.name), field.doc))
+        out.append('} %s_t;' % type_.c_name)
+        out.append('')
+
+    out.append(c_functions(schema))
+    out.append('''#ifdef __cplusplus
+}
+#endif''')
+    return '\n'.join(out) + '\n'
+
+
+def c_get(schema, field, at):
+    if field.type == 'u8':
+        return 'msg->%s = buf[%s];' % (field.name, at)
+    if field.type == 'bool':
+        return 'msg->%s = buf[%s] != 0;' % (field.name, at)
+    if field.type == 'u16':
+        return 'msg->%s = esp_ncp_wire_le16(&buf[%s]);' % (field.name, at)
+    if field.type == 'u32':
+        return 'msg->%s = esp_ncp_wire_le32(&buf[%s]);' % (field.name, at)
+    if field.type == 'u64':
+        return 'msg->%s = esp_ncp_wire_le64(&buf[%s]);' % (field.name, at)
+    if field.type == 's32':
+        return 'msg->%s = (int32_t)esp_ncp_wire_le32(&buf[%s]);' % (field.name, at)
+    if field.type == 'addr':
+        return 'memcpy(msg->%s.bytes, &buf[%s], sizeof(msg->%s.bytes));' % (field.name, at, field.name)
+    type_ = schema.types[field.type]
+    return '%s_get(&buf[%s], %s, &msg->%s);' % (type_.c_name, at, type_.c_macro, field.name)
+
+
+def c_put(schema, field, at):
+    if field.type in ('u8', 'bool'):
+        return 'buf[%s] = msg->%s;' % (at, field.name)
+    if field.type == 'u16':
+        return 'esp_ncp_wire_put16(&buf[%s], msg->%s);' % (at, field.name)
+    if field.type in ('u32', 's32'):
+        return 'esp_ncp_wire_put32(&buf[%s], (uint32_t)msg->%s);' % (at, field.name)
+    if field.type == 'u64':
+        return 'esp_ncp_wire_put64(&buf[%s], msg->%s);' % (at, field.name)
+    if field.type == 'addr':
+        return 'memcpy(&buf[%s], msg->%s.bytes, sizeof(msg->%s.bytes));' % (at, field.name, field.name)
+    type_ = schema.types[field.type]
+    return '%s_put(&msg->%s, &buf[%s]);' % (type_.c_name, field.name, at)
+
+
+def at(offset):
+    return 'pos + %d' % offset if offset else 'pos'
+
+
+def c_functions(schema):
+    out = []
+    out.append('''static inline uint16_t esp_ncp_wire_le16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static inline uint32_t esp_ncp_wire_le32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static inline uint64_t esp_ncp_wire_le64(const uint8_t *buf)
+{
+    return (uint64_t)esp_ncp_wire_le32(buf) | ((uint64_t)esp_ncp_wire_le32(&buf[4]) << 32);
+}
+
+static inline void esp_ncp_wire_put16(uint8_t *buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static inline void esp_ncp_wire_put32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static inline void esp_ncp_wire_put64(uint8_t *buf, uint64_t value)
+{
+    esp_ncp_wire_put32(buf, (uint32_t)value);
+    esp_ncp_wire_put32(&buf[4], (uint32_t)(value >> 32));
+}
+''')
+    for name in schema.order:
+        type_ = schema.types[name]
+        c = type_.c_name
+
+        # get: the decoded length, 0 if the buffer is short
+        out.append('static inline size_t %s_get(const uint8_t *buf, size_t len, %s_t *msg)' % (c, c))
+        out.append('{')
+        out.append('    size_t pos = 0;')
+        out.append('')
+        for run, size in schema.groups(type_):
+            field = run[0][0]
+            if size is not None:
+                out.append('    if (len - pos < %d) {' % size)
+                out.append('        return 0;')
+                out.append('    }')
+                for field, offset in run:
+                    out.append('    ' + c_get(schema, field, at(offset)))
+                out.append('    pos += %d;' % size)
+            elif field.list in schema.types:
+                element = schema.types[field.list]
+                out.append('    msg->%s = &buf[pos];' % field.name)
+                out.append('    for (size_t i = 0; i < msg->%s; i ++) {' % field.count)
+                out.append('        %s_t record;' % element.c_name)
+                out.append('        size_t used = %s_get(&buf[pos], len - pos, &record);' % element.c_name)
+                out.append('')
+                out.append('        if (!used) {')
+                out.append('            return 0;')
+                out.append('        }')
+                out.append('        pos += used;')
+                out.append('    }')
+                out.append('    msg->%s_len = (size_t)(&buf[pos] - msg->%s);' % (field.name, field.name))
+            else:
+                width = PRIMITIVES[field.list][0] if field.list else 1
+                need = ('(size_t)msg->%s * %d' % (field.count, width)) if width > 1 else 'msg->%s' % field.count
+                out.append('    if (len - pos < %s) {' % need)
+                out.append('        return 0;')
+                out.append('    }')
+                out.append('    msg->%s = &buf[pos];' % field.name)
+                out.append('    pos += %s;' % need)
+        out.append('')
+        out.append('    return pos;')
+        out.append('}')
+        out.append('')
+
+        # size
+        out.append('/** The encoded size of the %s payload */' % type_.name)
+        out.append('static inline size_t %s_size(const %s_t *msg)' % (c, c))
+        out.append('{')
+        variable = [field for field in type_.fields if field.variable]
+        if not variable:
+            out.append('    (void)msg;')
+            out.append('')
+            out.append('    return %s;' % type_.c_macro)
+        else:
+            out.append('    size_t size = %d;' % schema.fixed_size(type_))
+            out.append('')
+            for field in variable:
+                if field.list in schema.types:
+                    out.append('    size += msg->%s_len;' % field.name)
+                elif field.list:
+                    out.append('    size += (size_t)msg->%s * %d;' % (field.count, PRIMITIVES[field.list][0]))
+                else:
+                    out.append('    size += msg->%s;' % field.count)
+            out.append('')
+            out.append('    return size;')
+        out.append('}')
+        out.append('')
+
+        # put: the buffer holds the size of the payload
+        out.append('static inline size_t %s_put(const %s_t *msg, uint8_t *buf)' % (c, c))
+        out.append('{')
+        out.append('    size_t pos = 0;')
+        out.append('')
+        for run, size in schema.groups(type_):
+            field = run[0][0]
+            if size is not None:
+                for field, offset in run:
+                    out.append('    ' + c_put(schema, field, at(offset)))
+                out.append('    pos += %d;' % size)
+            else:
+                if field.list in schema.types:
+                    length = 'msg->%s_len' % field.name
+                elif field.list:
+                    length = '(size_t)msg->%s * %d' % (field.count, PRIMITIVES[field.list][0])
+                else:
+                    length = 'msg->%s' % field.count
+                present = ('msg->%s_len' % field.name) if field.list in schema.types else 'msg->%s' % field.count
+                out.append('    if (%s) {' % present)
+                out.append('        memcpy(&buf[pos], msg->%s, %s);' % (field.name, length))
+                out.append('    }')
+                out.append('    pos += %s;' % length)
+        out.append('')
+        out.append('    return pos;')
+        out.append('}')
+        out.append('')
+
+        out.append('''/**
+ * @brief  Decode the %(name)s payload, the pointer fields point into the buffer.
+ *
+ * @note The bytes past the payload are ignored, newer hosts may append fields.
+ *
+ * @return true if the buffer holds the whole payload
+ */
+static inline bool %(c)s_decode(const uint8_t *buf, size_t len, %(c)s_t *msg)
+{
+    return buf && msg && %(c)s_get(buf, len, msg) != 0;
+}
+
+/**
+ * @brief  Encode the %(name)s payload.
+ *
+ * @return The bytes written, 0 if the buffer is too small
+ */
+static inline size_t %(c)s_encode(const %(c)s_t *msg, uint8_t *buf, size_t size)
+{
+    if (!msg || !buf || size < %(c)s_size(msg)) {
+        return 0;
+    }
+
+    return %(c)s_put(msg, buf);
+}
+''' % {'c': c, 'name': type_.name})
+        if type_.element:
+            out.append('''/**
+ * @brief  Decode the %(name)s record at the offset of a list and move the offset past it.
+ *
+ * @return false at the end of the list or on a truncated record
+ */
+static inline bool %(c)s_next(const uint8_t *buf, size_t len, size_t *offset, %(c)s_t *msg)
+{
+    size_t used = (*offset < len) ? %(c)s_get(&buf[*offset], len - *offset, msg) : 0;
+
+    *offset += used;
+
+    return used != 0;
+}
+''' % {'c': c, 'name': type_.name})
+    return '\n'.join(out)
+
+
+# C++
+
+def cpp_member_type(schema, field):
+    if field.list:
+        element = PRIMITIVES[field.list][2] if field.list in PRIMITIVES else schema.types[field.list].cpp_name
+        return 'std::vector<%s>' % element
+    if field.bytes:
+        return 'Bytes'
+    if field.type in PRIMITIVES:
+        return PRIMITIVES[field.type][2]
+    return schema.types[field.type].cpp_name
+
+
+def cpp_view_type(schema, field):
+    if field.list in PRIMITIVES:
+        return 'ValueView<%s>' % PRIMITIVES[field.list][2]
+    if field.list:
+        return 'RecordView<%s::View>' % schema.types[field.list].cpp_name
+    if field.bytes:
+        return 'ByteView'
+    return cpp_member_type(schema, field)
+
+
+def cpp_load(schema, field, at, indent):
+    if field.type == 'bool':
+        return '%s%s = buf[%s] != 0;' % (indent, field.name, at)
+    if field.type == 'u8':
+        return '%s%s = buf[%s];' % (indent, field.name, at)
+    if field.type == 'addr':
+        return '%s%s.get(&buf[%s]);' % (indent, field.name, at)
+    if field.type in PRIMITIVES:
+        return '%s%s = load<%s>(&buf[%s]);' % (indent, field.name, PRIMITIVES[field.type][2], at)
+    return '%s%s.get(&buf[%s], %s::fixed_size);' % (indent, field.name, at, schema.types[field.type].cpp_name)
+
+
+def cpp_get(schema, type_, indent):
+    """The in place decoder, the decoded length or 0 if the buffer is short"""
+    out = []
+    out.append('%ssize_t get(const uint8_t *buf, size_t len)' % indent)
+    out.append('%s{' % indent)
+    out.append('%s    size_t pos = 0;' % indent)
+    for name in type_.counts:
+        count = next(field for field in type_.fields if field.name == name)
+        out.append('%s    %s %s = 0;' % (indent, PRIMITIVES[count.type][2], name))
+    out.append('')
+    for run, size in schema.groups(type_):
+        field = run[0][0]
+        if size is not None:
+            out.append('%s    if (len - pos < %d) {' % (indent, size))
+            out.append('%s        return 0;' % indent)
+            out.append('%s    }' % indent)
+            for field, offset in run:
+                out.append(cpp_load(schema, field, at(offset), indent + '    '))
+            out.append('%s    pos += %d;' % (indent, size))
+        elif field.list in schema.types:
+            element = schema.types[field.list].cpp_name
+            out.append('%s    %s.data = &buf[pos];' % (indent, field.name))
+            out.append('%s    %s.count = %s;' % (indent, field.name, field.count))
+            out.append('%s    for (size_t i = 0; i < %s; i ++) {' % (indent, field.count))
+            out.append('%s        %s::View record;' % (indent, element))
+            out.append('%s        size_t used = record.get(&buf[pos], len - pos);' % indent)
+            out.append('')
+            out.append('%s        if (!used) {' % indent)
+            out.append('%s            return 0;' % indent)
+            out.append('%s        }' % indent)
+            out.append('%s        pos += used;' % indent)
+            out.append('%s    }' % indent)
+            out.append('%s    %s.len = static_cast<size_t>(&buf[pos] - %s.data);' % (indent, field.name, field.name))
+        else:
+            width = PRIMITIVES[field.list][0] if field.list else 1
+            need = ('static_cast<size_t>(%s) * %d' % (field.count, width)) if width > 1 else field.count
+            out.append('%s    if (len - pos < %s) {' % (indent, need))
+            out.append('%s        return 0;' % indent)
+            out.append('%s    }' % indent)
+            out.append('%s    %s.data = &buf[pos];' % (indent, field.name))
+            out.append('%s    %s.%s = %s;' % (indent, field.name, 'count' if field.list else 'len', field.count))
+            out.append('%s    pos += %s;' % (indent, need))
+    out.append('')
+    out.append('%s    return pos;' % indent)
+    out.append('%s}' % indent)
+    return out
+
+
+def cpp_header(schema):
+    out = [LICENSE]
+    out.append('''#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "esp_ncp/frame.hpp"
+#include "esp_ncp/frame_id.hpp"
+#include "esp_ncp/request.hpp"
+
+namespace esp_ncp {
+namespace wire {
+
+/**
+ * @brief A short or long address, esp_zb_addr_u on the wire.
+ *
+ */
+struct Addr {
+    std::array<uint8_t, 8> bytes{};                 /*!< The long address, or the short address in the first 2 bytes */
+
+    static constexpr size_t fixed_size = 8;
+
+    static constexpr Addr from_short(uint16_t short_addr)
+    {
+        Addr addr;
+        addr.bytes[0] = static_cast<uint8_t>(short_addr);
+        addr.bytes[1] = static_cast<uint8_t>(short_addr >> 8);
+        return addr;
+    }
+
+    static constexpr Addr from_long(const IeeeAddr &ieee_addr)
+    {
+        Addr addr;
+        addr.bytes = ieee_addr;
+        return addr;
+    }
+
+    constexpr uint16_t short_addr() const { return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8)); }
+
+    void decode(Reader &r)
+    {
+        const uint8_t *data = r.bytes(bytes.size());
+        for (size_t i = 0; data && i < bytes.size(); i ++) {
+            bytes[i] = data[i];
+        }
+    }
+
+    void encode(Writer &w) const { w.bytes(bytes.data(), bytes.size()); }
+
+    void get(const uint8_t *buf)
+    {
+        for (size_t i = 0; i < bytes.size(); i ++) {
+            bytes[i] = buf[i];
+        }
+    }
+};
+
+/* The count of a list or byte field, which must fit its field on the wire */
+template <typename T>
+T wire_count(size_t size)
+{
+    if (size > std::numeric_limits<T>::max()) {
+        throw std::length_error("esp_ncp::wire: too many elements for the count field");
+    }
+    return static_cast<T>(size);
+}
+
+/* A little endian load of the views, the length is checked before */
+template <typename T>
+inline T load(const uint8_t *buf)
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i ++) {
+        value |= static_cast<T>(static_cast<uint64_t>(buf[i]) << (8 * i));
+    }
+    return value;
+}
+
+/**
+ * @brief The bytes of a field in the decoded buffer.
+ *
+ */
+struct ByteView {
+    const uint8_t *data = nullptr;                  /*!< The first byte, in the decoded buffer */
+    size_t len = 0;                                 /*!< The number of bytes */
+
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const uint8_t *begin() const { return data; }
+    const uint8_t *end() const { return data + len; }
+    uint8_t operator[](size_t i) const { return data[i]; }
+    Bytes bytes() const { return Bytes(begin(), end()); }
+};
+
+/**
+ * @brief A list of little endian values in the decoded buffer.
+ *
+ */
+template <typename T>
+struct ValueView {
+    class iterator {
+    public:
+        explicit iterator(const uint8_t *data) : data_(data) {}
+        T operator*() const { return load<T>(data_); }
+        iterator &operator++() { data_ += sizeof(T); return *this; }
+        bool operator!=(const iterator &other) const { return data_ != other.data_; }
+
+    private:
+        const uint8_t *data_;
+    };
+
+    const uint8_t *data = nullptr;                  /*!< The first value, in the decoded buffer */
+    size_t count = 0;                               /*!< The number of values */
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T operator[](size_t i) const { return load<T>(data + i * sizeof(T)); }
+    iterator begin() const { return iterator(data); }
+    iterator end() const { return iterator(data + count * sizeof(T)); }
+};
+
+/**
+ * @brief A list of records in the decoded buffer, each one decoded as the iteration reaches it.
+ *
+ * @note The records were checked when the payload was decoded.
+ */
+template <typename T>
+struct RecordView {
+    class iterator {
+    public:
+        iterator(const uint8_t *data, size_t len, size_t left) : data_(data), len_(len), left_(left) { next(); }
+        const T &operator*() const { return record_; }
+        const T *operator->() const { return &record_; }
+        iterator &operator++()
+        {
+            data_ += used_;
+            len_ -= used_;
+            left_ --;
+            next();
+            return *this;
+        }
+        bool operator!=(const iterator &other) const { return left_ != other.left_; }
+
+    private:
+        void next() { used_ = left_ ? record_.get(data_, len_) : 0; }
+
+        const uint8_t *data_;
+        size_t len_;
+        size_t left_;
+        size_t used_ = 0;
+        T record_;
+    };
+
+    const uint8_t *data = nullptr;                  /*!< The first record, in the decoded buffer */
+    size_t len = 0;                                 /*!< The bytes of the records */
+    size_t count = 0;                               /*!< The number of records */
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    iterator begin() const { return iterator(data, len, count); }
+    iterator end() const { return iterator(nullptr, 0, 0); }
+};
+''')
+    for name in schema.order:
+        type_ = schema.types[name]
+        cpp = type_.cpp_name
+        out.append('/**')
+        out.append(' * @brief %s.' % type_.doc)
+        for use in frame_doc(type_, False):
+            out.append(' * @note %s.' % use)
+        out.append(' *')
+        out.append(' */')
+        out.append('struct %s {' % cpp)
+        prefix = list(schema.prefix(type_))
+        prefix_size = sum(schema.size(field) for field, _ in prefix)
+        if schema.fixed(type_):
+            out.append(member('static constexpr size_t fixed_size = %d;' % prefix_size, 'The size of the payload', 52))
+        else:
+            out.append(member('static constexpr size_t fixed_size = %d;' % prefix_size, 'The size up to the first variable field', 52))
+        out.append('')
+        out.append('    struct offset {')
+        for field, offset in prefix:
+            out.append('        static constexpr size_t %s = %d;' % (field.name, offset))
+        out.append('    };')
+        out.append('')
+        for field in type_.fields:
+            if field.name in type_.counts:
+                continue
+            decl = '%s %s' % (cpp_member_type(schema, field), field.name)
+            if field.type in PRIMITIVES and field.type != 'addr':
+                decl += ' = %s' % ('false' if field.type == 'bool' else '0')
+            doc = field.doc
+            if field.variable:
+                doc += ', the %s on the wire' % field.count
+            out.append(member(decl + ';', doc))
+        out.append('')
+
+        # decode
+        out.append('    bool decode(Reader &r)')
+        out.append('    {')
+        for field in type_.fields:
+            if field.name in type_.counts:
+                out.append('        %s %s = r.get<%s>();' % (PRIMITIVES[field.type][2], field.name, PRIMITIVES[field.type][2]))
+            elif field.list in schema.types:
+                element = schema.types[field.list].cpp_name
+                out.append('        %s.clear();' % field.name)
+                out.append('        %s.reserve(std::min<size_t>(%s, r.remaining()));' % (field.name, field.count))
+                out.append('        for (size_t i = 0; i < %s && r.ok(); i ++) {' % field.count)
+                out.append('            %s record;' % element)
+                out.append('            if (record.decode(r)) {')
+                out.append('                %s.push_back(std::move(record));' % field.name)
+                out.append('            }')
+                out.append('        }')
+            elif field.list:
+                ctype = PRIMITIVES[field.list][2]
+                out.append('        %s.clear();' % field.name)
+                out.append('        %s.reserve(std::min<size_t>(%s, r.remaining()));' % (field.name, field.count))
+                out.append('        for (size_t i = 0; i < %s && r.ok(); i ++) {' % field.count)
+                out.append('            %s.push_back(r.get<%s>());' % (field.name, ctype))
+                out.append('        }')
+            elif field.bytes:
+                out.append('        if (const uint8_t *data = r.bytes(%s)) {' % field.count)
+                out.append('            %s.assign(data, data + %s);' % (field.name, field.count))
+                out.append('        }')
+            elif field.type == 'bool':
+                out.append('        %s = r.get<uint8_t>() != 0;' % field.name)
+            elif field.type in PRIMITIVES and field.type != 'addr':
+                out.append('        %s = r.get<%s>();' % (field.name, PRIMITIVES[field.type][2]))
+            else:
+                out.append('        %s.decode(r);' % field.name)
+        out.append('        return r.ok();')
+        out.append('    }')
+        out.append('')
+
+        # encode
+        out.append('    void encode(Writer &w) const')
+        out.append('    {')
+        for field in type_.fields:
+            if field.name in type_.counts:
+                sized = type_.counts[field.name]
+                ctype = PRIMITIVES[field.type][2]
+                out.append('        w.put<%s>(wire_count<%s>(%s.size()));' % (ctype, ctype, sized.name))
+            elif field.list in schema.types:
+                out.append('        for (const auto &record : %s) {' % field.name)
+                out.append('            record.encode(w);')
+                out.append('        }')
+            elif field.list:
+                ctype = PRIMITIVES[field.list][2]
+                out.append('        for (%s value : %s) {' % (ctype, field.name))
+                out.append('            w.put<%s>(value);' % ctype)
+                out.append('        }')
+            elif field.bytes:
+                out.append('        w.bytes(%s.data(), %s.size());' % (field.name, field.name))
+            elif field.type == 'bool':
+                out.append('        w.put<uint8_t>(%s ? 1 : 0);' % field.name)
+            elif field.type in PRIMITIVES and field.type != 'addr':
+                out.append('        w.put<%s>(%s);' % (PRIMITIVES[field.type][2], field.name))
+            else:
+                out.append('        %s.encode(w);' % field.name)
+        out.append('    }')
+        out.append('')
+
+        # the in place decoding, the type itself when it has no variable field
+        if schema.fixed(type_):
+            out.append('    using View = %s;' % cpp)
+            out.append('')
+            out.extend(cpp_get(schema, type_, '    '))
+        else:
+            out.append('    /**')
+            out.append('     * @brief The payload decoded in place, the lists and bytes point into the buffer.')
+            out.append('     *')
+            out.append('     */')
+            out.append('    struct View {')
+            for field in type_.fields:
+                if field.name in type_.counts:
+                    continue
+                decl = '%s %s' % (cpp_view_type(schema, field), field.name)
+                if field.type in PRIMITIVES and field.type != 'addr':
+                    decl += ' = %s' % ('false' if field.type == 'bool' else '0')
+                out.append('    ' + member(decl + ';', field.doc, 48))
+            out.append('')
+            out.extend(cpp_get(schema, type_, '        '))
+            out.append('    };')
+        out.append('};')
+        out.append('')
+
+    out.append('''/** Decode a payload, the bytes past it are ignored */
+template <typename T>
+bool decode(const uint8_t *data, size_t len, T &msg)
+{
+    Reader r(data, len);
+    return msg.decode(r);
+}
+''')
+    for name in schema.order:
+        type_ = schema.types[name]
+        if schema.fixed(type_) or not type_.frames:
+            continue
+        out.append('/** Decode a payload in place, the view is valid as long as the buffer */')
+        out.append('inline bool decode(const uint8_t *data, size_t len, %s::View &msg)' % type_.cpp_name)
+        out.append('{')
+        out.append('    return data && msg.get(data, len) != 0;')
+        out.append('}')
+        out.append('')
+    out.append('''
+template <typename T>
+Bytes encode(const T &msg)
+{
+    Bytes out;
+    Writer w(out);
+    msg.encode(w);
+    return out;
+}
+
+/**
+ * @brief The payload types of a frame ID, as request, response and notification.
+ *
+ */
+template <uint16_t Id>
+struct Frame;
+''')
+    for frame, roles in schema.frames.items():
+        out.append('template <>')
+        out.append('struct Frame<frame_id::%s> {' % frame)
+        for role in ('request', 'response', 'notification'):
+            if role in roles:
+                out.append('    using %s = %s;' % (role, schema.types[roles[role]].cpp_name))
+        out.append('};')
+        out.append('')
+
+    out.append('''} // namespace wire
+} // namespace esp_ncp''')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the NCP payload codecs from the schema')
+    parser.add_argument('--check', action='store_true', help='exit 1 if the generated files are out of date')
+    args = parser.parse_args()
+
+    schema = Schema(SCHEMA)
+    outputs = {
+        C_HEADER: c_header(schema),
+        CPP_HEADER: cpp_header(schema),
+    }
+    stale = []
+    for path, text in outputs.items():
+        current = None
+        if os.path.exists(path):
+            with open(path) as file:
+                current = file.read()
+        if current == text:
+            continue
+        stale.append(os.path.relpath(path, ROOT))
+        if not args.check:
+            with open(path, 'w') as file:
+                file.write(text)
+
+    for path in stale:
+        print('%s %s' % ('stale' if args.check else 'wrote', path))
+    return 1 if (args.check and stale) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())